@@ -132,6 +132,14 @@ unsigned num_read_watchpoints = 0;
 bx_watchpoint write_watchpoint[BX_DBG_MAX_WATCHPONTS];
 bx_watchpoint read_watchpoint[BX_DBG_MAX_WATCHPONTS];
 
+// text screen watches (see bx_dbg_text_watch)
+#define BX_DBG_MAX_TEXT_WATCHES 16
+static struct {
+  int id;
+  char *text;
+} text_watch[BX_DBG_MAX_TEXT_WATCHES];
+static unsigned num_text_watches = 0;
+
 #define DBG_PRINTF_BUFFER_LEN 1024
 
 void dbg_printf(const char *fmt, ...)
@@ -1720,6 +1728,9 @@ void bx_dbg_print_watchpoints(void)
       dbg_printf("rd 0x"FMT_PHY_ADDRX" len=%d\t\t(read error)\n",
           write_watchpoint[i].addr, write_watchpoint[i].len);
   }
+  for (i = 0; i < num_text_watches; i++) {
+    dbg_printf("text \"%s\"\n", text_watch[i].text);
+  }
 }
 
 void bx_dbg_watch(int type, bx_phy_address address, Bit32u len)
@@ -1752,9 +1763,72 @@ void bx_dbg_watch(int type, bx_phy_address address, Bit32u len)
 void bx_dbg_unwatch_all()
 {
   num_read_watchpoints = num_write_watchpoints = 0;
+  for (unsigned i = 0; i < num_text_watches; i++) {
+    SIM->unregister_text_watch(text_watch[i].id);
+    free(text_watch[i].text);
+  }
+  num_text_watches = 0;
   dbg_printf("All watchpoints removed\n");
 }
 
+static void bx_dbg_remove_text_watch(unsigned index)
+{
+  free(text_watch[index].text);
+  for (unsigned j=index; j<(num_text_watches-1); j++) {
+    text_watch[j] = text_watch[j+1];
+  }
+  num_text_watches--;
+}
+
+// called by the display adapter when the text appears on the screen
+static void bx_dbg_text_watch_handler(void *this_ptr, int id, unsigned row, unsigned col)
+{
+  for (unsigned i=0; i<num_text_watches; i++) {
+    if (text_watch[i].id == id) {
+      dbg_printf("Caught text watch \"%s\" at row %u, column %u\n", text_watch[i].text, row, col);
+      bx_dbg_remove_text_watch(i);
+      break;
+    }
+  }
+  bx_debug_break();
+}
+
+/*
+ * this implements the watch vga "text" command in the debugger: the simulation
+ * stops as soon as the text appears in a row of the VGA text screen
+ */
+void bx_dbg_text_watch(const char *text)
+{
+  int id;
+
+  if (num_text_watches == BX_DBG_MAX_TEXT_WATCHES) {
+    dbg_printf("Too many text watches (%d)\n", BX_DBG_MAX_TEXT_WATCHES);
+    return;
+  }
+  id = SIM->register_text_watch(text, NULL, bx_dbg_text_watch_handler);
+  if (id < 0) {
+    dbg_printf("Invalid text watch\n");
+    return;
+  }
+  text_watch[num_text_watches].id = id;
+  text_watch[num_text_watches].text = strdup(text);
+  num_text_watches++;
+  dbg_printf("text watch \"%s\" inserted\n", text);
+}
+
+void bx_dbg_unwatch_text(const char *text)
+{
+  for (unsigned i=0; i<num_text_watches; i++) {
+    if (!strcmp(text_watch[i].text, text)) {
+      SIM->unregister_text_watch(text_watch[i].id);
+      bx_dbg_remove_text_watch(i);
+      dbg_printf("text watch \"%s\" removed\n", text);
+      return;
+    }
+  }
+  dbg_printf("text watch \"%s\" not found\n", text);
+}
+
 void bx_dbg_unwatch(bx_phy_address address)
 { unsigned i;
   for (i=0; i<num_read_watchpoints; i++) {
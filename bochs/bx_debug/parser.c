@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.7.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -63,13 +68,12 @@
 #define yyparse         bxparse
 #define yylex           bxlex
 #define yyerror         bxerror
-#define yylval          bxlval
-#define yychar          bxchar
 #define yydebug         bxdebug
 #define yynerrs         bxnerrs
+#define yylval          bxlval
+#define yychar          bxchar
 
-/* Copy the first part of user declarations.  */
-/* Line 371 of yacc.c  */
+/* First part of user prologue.  */
 #line 5 "parser.y"
 
 #include <stdio.h>
@@ -78,30 +82,34 @@
 
 #if BX_DEBUGGER
 
-/* Line 371 of yacc.c  */
-#line 83 "y.tab.c"
+#line 86 "y.tab.c"
 
-# ifndef YY_NULL
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULL nullptr
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
 #  else
-#   define YY_NULL 0
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "y.tab.h".  */
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
 #ifndef YY_BX_Y_TAB_H_INCLUDED
 # define YY_BX_Y_TAB_H_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
@@ -109,119 +117,127 @@
 extern int bxdebug;
 #endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     BX_TOKEN_8BH_REG = 258,
-     BX_TOKEN_8BL_REG = 259,
-     BX_TOKEN_16B_REG = 260,
-     BX_TOKEN_32B_REG = 261,
-     BX_TOKEN_64B_REG = 262,
-     BX_TOKEN_CS = 263,
-     BX_TOKEN_ES = 264,
-     BX_TOKEN_SS = 265,
-     BX_TOKEN_DS = 266,
-     BX_TOKEN_FS = 267,
-     BX_TOKEN_GS = 268,
-     BX_TOKEN_FLAGS = 269,
-     BX_TOKEN_ON = 270,
-     BX_TOKEN_OFF = 271,
-     BX_TOKEN_CONTINUE = 272,
-     BX_TOKEN_STEPN = 273,
-     BX_TOKEN_STEP_OVER = 274,
-     BX_TOKEN_SET = 275,
-     BX_TOKEN_DEBUGGER = 276,
-     BX_TOKEN_LIST_BREAK = 277,
-     BX_TOKEN_VBREAKPOINT = 278,
-     BX_TOKEN_LBREAKPOINT = 279,
-     BX_TOKEN_PBREAKPOINT = 280,
-     BX_TOKEN_DEL_BREAKPOINT = 281,
-     BX_TOKEN_ENABLE_BREAKPOINT = 282,
-     BX_TOKEN_DISABLE_BREAKPOINT = 283,
-     BX_TOKEN_INFO = 284,
-     BX_TOKEN_QUIT = 285,
-     BX_TOKEN_R = 286,
-     BX_TOKEN_REGS = 287,
-     BX_TOKEN_CPU = 288,
-     BX_TOKEN_FPU = 289,
-     BX_TOKEN_MMX = 290,
-     BX_TOKEN_SSE = 291,
-     BX_TOKEN_AVX = 292,
-     BX_TOKEN_IDT = 293,
-     BX_TOKEN_IVT = 294,
-     BX_TOKEN_GDT = 295,
-     BX_TOKEN_LDT = 296,
-     BX_TOKEN_TSS = 297,
-     BX_TOKEN_TAB = 298,
-     BX_TOKEN_ALL = 299,
-     BX_TOKEN_LINUX = 300,
-     BX_TOKEN_DEBUG_REGS = 301,
-     BX_TOKEN_CONTROL_REGS = 302,
-     BX_TOKEN_SEGMENT_REGS = 303,
-     BX_TOKEN_EXAMINE = 304,
-     BX_TOKEN_XFORMAT = 305,
-     BX_TOKEN_DISFORMAT = 306,
-     BX_TOKEN_RESTORE = 307,
-     BX_TOKEN_WRITEMEM = 308,
-     BX_TOKEN_SETPMEM = 309,
-     BX_TOKEN_SYMBOLNAME = 310,
-     BX_TOKEN_QUERY = 311,
-     BX_TOKEN_PENDING = 312,
-     BX_TOKEN_TAKE = 313,
-     BX_TOKEN_DMA = 314,
-     BX_TOKEN_IRQ = 315,
-     BX_TOKEN_TLB = 316,
-     BX_TOKEN_HEX = 317,
-     BX_TOKEN_DISASM = 318,
-     BX_TOKEN_INSTRUMENT = 319,
-     BX_TOKEN_STRING = 320,
-     BX_TOKEN_STOP = 321,
-     BX_TOKEN_DOIT = 322,
-     BX_TOKEN_CRC = 323,
-     BX_TOKEN_TRACE = 324,
-     BX_TOKEN_TRACEREG = 325,
-     BX_TOKEN_TRACEMEM = 326,
-     BX_TOKEN_SWITCH_MODE = 327,
-     BX_TOKEN_SIZE = 328,
-     BX_TOKEN_PTIME = 329,
-     BX_TOKEN_TIMEBP_ABSOLUTE = 330,
-     BX_TOKEN_TIMEBP = 331,
-     BX_TOKEN_MODEBP = 332,
-     BX_TOKEN_VMEXITBP = 333,
-     BX_TOKEN_PRINT_STACK = 334,
-     BX_TOKEN_WATCH = 335,
-     BX_TOKEN_UNWATCH = 336,
-     BX_TOKEN_READ = 337,
-     BX_TOKEN_WRITE = 338,
-     BX_TOKEN_SHOW = 339,
-     BX_TOKEN_LOAD_SYMBOLS = 340,
-     BX_TOKEN_SYMBOLS = 341,
-     BX_TOKEN_LIST_SYMBOLS = 342,
-     BX_TOKEN_GLOBAL = 343,
-     BX_TOKEN_WHERE = 344,
-     BX_TOKEN_PRINT_STRING = 345,
-     BX_TOKEN_NUMERIC = 346,
-     BX_TOKEN_PAGE = 347,
-     BX_TOKEN_HELP = 348,
-     BX_TOKEN_CALC = 349,
-     BX_TOKEN_VGA = 350,
-     BX_TOKEN_DEVICE = 351,
-     BX_TOKEN_COMMAND = 352,
-     BX_TOKEN_GENERIC = 353,
-     BX_TOKEN_RSHIFT = 354,
-     BX_TOKEN_LSHIFT = 355,
-     BX_TOKEN_REG_IP = 356,
-     BX_TOKEN_REG_EIP = 357,
-     BX_TOKEN_REG_RIP = 358,
-     INDIRECT = 359,
-     NEG = 360,
-     NOT = 361
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    BX_TOKEN_8BH_REG = 258,        /* BX_TOKEN_8BH_REG  */
+    BX_TOKEN_8BL_REG = 259,        /* BX_TOKEN_8BL_REG  */
+    BX_TOKEN_16B_REG = 260,        /* BX_TOKEN_16B_REG  */
+    BX_TOKEN_32B_REG = 261,        /* BX_TOKEN_32B_REG  */
+    BX_TOKEN_64B_REG = 262,        /* BX_TOKEN_64B_REG  */
+    BX_TOKEN_CS = 263,             /* BX_TOKEN_CS  */
+    BX_TOKEN_ES = 264,             /* BX_TOKEN_ES  */
+    BX_TOKEN_SS = 265,             /* BX_TOKEN_SS  */
+    BX_TOKEN_DS = 266,             /* BX_TOKEN_DS  */
+    BX_TOKEN_FS = 267,             /* BX_TOKEN_FS  */
+    BX_TOKEN_GS = 268,             /* BX_TOKEN_GS  */
+    BX_TOKEN_FLAGS = 269,          /* BX_TOKEN_FLAGS  */
+    BX_TOKEN_ON = 270,             /* BX_TOKEN_ON  */
+    BX_TOKEN_OFF = 271,            /* BX_TOKEN_OFF  */
+    BX_TOKEN_CONTINUE = 272,       /* BX_TOKEN_CONTINUE  */
+    BX_TOKEN_STEPN = 273,          /* BX_TOKEN_STEPN  */
+    BX_TOKEN_STEP_OVER = 274,      /* BX_TOKEN_STEP_OVER  */
+    BX_TOKEN_SET = 275,            /* BX_TOKEN_SET  */
+    BX_TOKEN_DEBUGGER = 276,       /* BX_TOKEN_DEBUGGER  */
+    BX_TOKEN_LIST_BREAK = 277,     /* BX_TOKEN_LIST_BREAK  */
+    BX_TOKEN_VBREAKPOINT = 278,    /* BX_TOKEN_VBREAKPOINT  */
+    BX_TOKEN_LBREAKPOINT = 279,    /* BX_TOKEN_LBREAKPOINT  */
+    BX_TOKEN_PBREAKPOINT = 280,    /* BX_TOKEN_PBREAKPOINT  */
+    BX_TOKEN_DEL_BREAKPOINT = 281, /* BX_TOKEN_DEL_BREAKPOINT  */
+    BX_TOKEN_ENABLE_BREAKPOINT = 282, /* BX_TOKEN_ENABLE_BREAKPOINT  */
+    BX_TOKEN_DISABLE_BREAKPOINT = 283, /* BX_TOKEN_DISABLE_BREAKPOINT  */
+    BX_TOKEN_INFO = 284,           /* BX_TOKEN_INFO  */
+    BX_TOKEN_QUIT = 285,           /* BX_TOKEN_QUIT  */
+    BX_TOKEN_R = 286,              /* BX_TOKEN_R  */
+    BX_TOKEN_REGS = 287,           /* BX_TOKEN_REGS  */
+    BX_TOKEN_CPU = 288,            /* BX_TOKEN_CPU  */
+    BX_TOKEN_FPU = 289,            /* BX_TOKEN_FPU  */
+    BX_TOKEN_MMX = 290,            /* BX_TOKEN_MMX  */
+    BX_TOKEN_SSE = 291,            /* BX_TOKEN_SSE  */
+    BX_TOKEN_AVX = 292,            /* BX_TOKEN_AVX  */
+    BX_TOKEN_IDT = 293,            /* BX_TOKEN_IDT  */
+    BX_TOKEN_IVT = 294,            /* BX_TOKEN_IVT  */
+    BX_TOKEN_GDT = 295,            /* BX_TOKEN_GDT  */
+    BX_TOKEN_LDT = 296,            /* BX_TOKEN_LDT  */
+    BX_TOKEN_TSS = 297,            /* BX_TOKEN_TSS  */
+    BX_TOKEN_TAB = 298,            /* BX_TOKEN_TAB  */
+    BX_TOKEN_ALL = 299,            /* BX_TOKEN_ALL  */
+    BX_TOKEN_LINUX = 300,          /* BX_TOKEN_LINUX  */
+    BX_TOKEN_DEBUG_REGS = 301,     /* BX_TOKEN_DEBUG_REGS  */
+    BX_TOKEN_CONTROL_REGS = 302,   /* BX_TOKEN_CONTROL_REGS  */
+    BX_TOKEN_SEGMENT_REGS = 303,   /* BX_TOKEN_SEGMENT_REGS  */
+    BX_TOKEN_EXAMINE = 304,        /* BX_TOKEN_EXAMINE  */
+    BX_TOKEN_XFORMAT = 305,        /* BX_TOKEN_XFORMAT  */
+    BX_TOKEN_DISFORMAT = 306,      /* BX_TOKEN_DISFORMAT  */
+    BX_TOKEN_RESTORE = 307,        /* BX_TOKEN_RESTORE  */
+    BX_TOKEN_WRITEMEM = 308,       /* BX_TOKEN_WRITEMEM  */
+    BX_TOKEN_SETPMEM = 309,        /* BX_TOKEN_SETPMEM  */
+    BX_TOKEN_SYMBOLNAME = 310,     /* BX_TOKEN_SYMBOLNAME  */
+    BX_TOKEN_QUERY = 311,          /* BX_TOKEN_QUERY  */
+    BX_TOKEN_PENDING = 312,        /* BX_TOKEN_PENDING  */
+    BX_TOKEN_TAKE = 313,           /* BX_TOKEN_TAKE  */
+    BX_TOKEN_DMA = 314,            /* BX_TOKEN_DMA  */
+    BX_TOKEN_IRQ = 315,            /* BX_TOKEN_IRQ  */
+    BX_TOKEN_TLB = 316,            /* BX_TOKEN_TLB  */
+    BX_TOKEN_HEX = 317,            /* BX_TOKEN_HEX  */
+    BX_TOKEN_DISASM = 318,         /* BX_TOKEN_DISASM  */
+    BX_TOKEN_INSTRUMENT = 319,     /* BX_TOKEN_INSTRUMENT  */
+    BX_TOKEN_STRING = 320,         /* BX_TOKEN_STRING  */
+    BX_TOKEN_STOP = 321,           /* BX_TOKEN_STOP  */
+    BX_TOKEN_DOIT = 322,           /* BX_TOKEN_DOIT  */
+    BX_TOKEN_CRC = 323,            /* BX_TOKEN_CRC  */
+    BX_TOKEN_TRACE = 324,          /* BX_TOKEN_TRACE  */
+    BX_TOKEN_TRACEREG = 325,       /* BX_TOKEN_TRACEREG  */
+    BX_TOKEN_TRACEMEM = 326,       /* BX_TOKEN_TRACEMEM  */
+    BX_TOKEN_SWITCH_MODE = 327,    /* BX_TOKEN_SWITCH_MODE  */
+    BX_TOKEN_SIZE = 328,           /* BX_TOKEN_SIZE  */
+    BX_TOKEN_PTIME = 329,          /* BX_TOKEN_PTIME  */
+    BX_TOKEN_TIMEBP_ABSOLUTE = 330, /* BX_TOKEN_TIMEBP_ABSOLUTE  */
+    BX_TOKEN_TIMEBP = 331,         /* BX_TOKEN_TIMEBP  */
+    BX_TOKEN_MODEBP = 332,         /* BX_TOKEN_MODEBP  */
+    BX_TOKEN_VMEXITBP = 333,       /* BX_TOKEN_VMEXITBP  */
+    BX_TOKEN_PRINT_STACK = 334,    /* BX_TOKEN_PRINT_STACK  */
+    BX_TOKEN_WATCH = 335,          /* BX_TOKEN_WATCH  */
+    BX_TOKEN_UNWATCH = 336,        /* BX_TOKEN_UNWATCH  */
+    BX_TOKEN_READ = 337,           /* BX_TOKEN_READ  */
+    BX_TOKEN_WRITE = 338,          /* BX_TOKEN_WRITE  */
+    BX_TOKEN_SHOW = 339,           /* BX_TOKEN_SHOW  */
+    BX_TOKEN_LOAD_SYMBOLS = 340,   /* BX_TOKEN_LOAD_SYMBOLS  */
+    BX_TOKEN_SYMBOLS = 341,        /* BX_TOKEN_SYMBOLS  */
+    BX_TOKEN_LIST_SYMBOLS = 342,   /* BX_TOKEN_LIST_SYMBOLS  */
+    BX_TOKEN_GLOBAL = 343,         /* BX_TOKEN_GLOBAL  */
+    BX_TOKEN_WHERE = 344,          /* BX_TOKEN_WHERE  */
+    BX_TOKEN_PRINT_STRING = 345,   /* BX_TOKEN_PRINT_STRING  */
+    BX_TOKEN_NUMERIC = 346,        /* BX_TOKEN_NUMERIC  */
+    BX_TOKEN_PAGE = 347,           /* BX_TOKEN_PAGE  */
+    BX_TOKEN_HELP = 348,           /* BX_TOKEN_HELP  */
+    BX_TOKEN_CALC = 349,           /* BX_TOKEN_CALC  */
+    BX_TOKEN_VGA = 350,            /* BX_TOKEN_VGA  */
+    BX_TOKEN_DEVICE = 351,         /* BX_TOKEN_DEVICE  */
+    BX_TOKEN_COMMAND = 352,        /* BX_TOKEN_COMMAND  */
+    BX_TOKEN_GENERIC = 353,        /* BX_TOKEN_GENERIC  */
+    BX_TOKEN_RSHIFT = 354,         /* BX_TOKEN_RSHIFT  */
+    BX_TOKEN_LSHIFT = 355,         /* BX_TOKEN_LSHIFT  */
+    BX_TOKEN_REG_IP = 356,         /* BX_TOKEN_REG_IP  */
+    BX_TOKEN_REG_EIP = 357,        /* BX_TOKEN_REG_EIP  */
+    BX_TOKEN_REG_RIP = 358,        /* BX_TOKEN_REG_RIP  */
+    NOT = 359,                     /* NOT  */
+    NEG = 360,                     /* NEG  */
+    INDIRECT = 361                 /* INDIRECT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define BX_TOKEN_8BH_REG 258
 #define BX_TOKEN_8BL_REG 259
 #define BX_TOKEN_16B_REG 260
@@ -323,83 +339,308 @@ extern int bxdebug;
 #define BX_TOKEN_REG_IP 356
 #define BX_TOKEN_REG_EIP 357
 #define BX_TOKEN_REG_RIP 358
-#define INDIRECT 359
+#define NOT 359
 #define NEG 360
-#define NOT 361
-
-
+#define INDIRECT 361
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-/* Line 387 of yacc.c  */
 #line 13 "parser.y"
 
   char    *sval;
   Bit64u   uval;
   bx_bool  bval;
 
+#line 357 "y.tab.c"
 
-/* Line 387 of yacc.c  */
-#line 345 "y.tab.c"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
+
 extern YYSTYPE bxlval;
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int bxparse (void *YYPARSE_PARAM);
-#else
-int bxparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
+
 int bxparse (void);
-#else
-int bxparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+
 
 #endif /* !YY_BX_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_BX_TOKEN_8BH_REG = 3,           /* BX_TOKEN_8BH_REG  */
+  YYSYMBOL_BX_TOKEN_8BL_REG = 4,           /* BX_TOKEN_8BL_REG  */
+  YYSYMBOL_BX_TOKEN_16B_REG = 5,           /* BX_TOKEN_16B_REG  */
+  YYSYMBOL_BX_TOKEN_32B_REG = 6,           /* BX_TOKEN_32B_REG  */
+  YYSYMBOL_BX_TOKEN_64B_REG = 7,           /* BX_TOKEN_64B_REG  */
+  YYSYMBOL_BX_TOKEN_CS = 8,                /* BX_TOKEN_CS  */
+  YYSYMBOL_BX_TOKEN_ES = 9,                /* BX_TOKEN_ES  */
+  YYSYMBOL_BX_TOKEN_SS = 10,               /* BX_TOKEN_SS  */
+  YYSYMBOL_BX_TOKEN_DS = 11,               /* BX_TOKEN_DS  */
+  YYSYMBOL_BX_TOKEN_FS = 12,               /* BX_TOKEN_FS  */
+  YYSYMBOL_BX_TOKEN_GS = 13,               /* BX_TOKEN_GS  */
+  YYSYMBOL_BX_TOKEN_FLAGS = 14,            /* BX_TOKEN_FLAGS  */
+  YYSYMBOL_BX_TOKEN_ON = 15,               /* BX_TOKEN_ON  */
+  YYSYMBOL_BX_TOKEN_OFF = 16,              /* BX_TOKEN_OFF  */
+  YYSYMBOL_BX_TOKEN_CONTINUE = 17,         /* BX_TOKEN_CONTINUE  */
+  YYSYMBOL_BX_TOKEN_STEPN = 18,            /* BX_TOKEN_STEPN  */
+  YYSYMBOL_BX_TOKEN_STEP_OVER = 19,        /* BX_TOKEN_STEP_OVER  */
+  YYSYMBOL_BX_TOKEN_SET = 20,              /* BX_TOKEN_SET  */
+  YYSYMBOL_BX_TOKEN_DEBUGGER = 21,         /* BX_TOKEN_DEBUGGER  */
+  YYSYMBOL_BX_TOKEN_LIST_BREAK = 22,       /* BX_TOKEN_LIST_BREAK  */
+  YYSYMBOL_BX_TOKEN_VBREAKPOINT = 23,      /* BX_TOKEN_VBREAKPOINT  */
+  YYSYMBOL_BX_TOKEN_LBREAKPOINT = 24,      /* BX_TOKEN_LBREAKPOINT  */
+  YYSYMBOL_BX_TOKEN_PBREAKPOINT = 25,      /* BX_TOKEN_PBREAKPOINT  */
+  YYSYMBOL_BX_TOKEN_DEL_BREAKPOINT = 26,   /* BX_TOKEN_DEL_BREAKPOINT  */
+  YYSYMBOL_BX_TOKEN_ENABLE_BREAKPOINT = 27, /* BX_TOKEN_ENABLE_BREAKPOINT  */
+  YYSYMBOL_BX_TOKEN_DISABLE_BREAKPOINT = 28, /* BX_TOKEN_DISABLE_BREAKPOINT  */
+  YYSYMBOL_BX_TOKEN_INFO = 29,             /* BX_TOKEN_INFO  */
+  YYSYMBOL_BX_TOKEN_QUIT = 30,             /* BX_TOKEN_QUIT  */
+  YYSYMBOL_BX_TOKEN_R = 31,                /* BX_TOKEN_R  */
+  YYSYMBOL_BX_TOKEN_REGS = 32,             /* BX_TOKEN_REGS  */
+  YYSYMBOL_BX_TOKEN_CPU = 33,              /* BX_TOKEN_CPU  */
+  YYSYMBOL_BX_TOKEN_FPU = 34,              /* BX_TOKEN_FPU  */
+  YYSYMBOL_BX_TOKEN_MMX = 35,              /* BX_TOKEN_MMX  */
+  YYSYMBOL_BX_TOKEN_SSE = 36,              /* BX_TOKEN_SSE  */
+  YYSYMBOL_BX_TOKEN_AVX = 37,              /* BX_TOKEN_AVX  */
+  YYSYMBOL_BX_TOKEN_IDT = 38,              /* BX_TOKEN_IDT  */
+  YYSYMBOL_BX_TOKEN_IVT = 39,              /* BX_TOKEN_IVT  */
+  YYSYMBOL_BX_TOKEN_GDT = 40,              /* BX_TOKEN_GDT  */
+  YYSYMBOL_BX_TOKEN_LDT = 41,              /* BX_TOKEN_LDT  */
+  YYSYMBOL_BX_TOKEN_TSS = 42,              /* BX_TOKEN_TSS  */
+  YYSYMBOL_BX_TOKEN_TAB = 43,              /* BX_TOKEN_TAB  */
+  YYSYMBOL_BX_TOKEN_ALL = 44,              /* BX_TOKEN_ALL  */
+  YYSYMBOL_BX_TOKEN_LINUX = 45,            /* BX_TOKEN_LINUX  */
+  YYSYMBOL_BX_TOKEN_DEBUG_REGS = 46,       /* BX_TOKEN_DEBUG_REGS  */
+  YYSYMBOL_BX_TOKEN_CONTROL_REGS = 47,     /* BX_TOKEN_CONTROL_REGS  */
+  YYSYMBOL_BX_TOKEN_SEGMENT_REGS = 48,     /* BX_TOKEN_SEGMENT_REGS  */
+  YYSYMBOL_BX_TOKEN_EXAMINE = 49,          /* BX_TOKEN_EXAMINE  */
+  YYSYMBOL_BX_TOKEN_XFORMAT = 50,          /* BX_TOKEN_XFORMAT  */
+  YYSYMBOL_BX_TOKEN_DISFORMAT = 51,        /* BX_TOKEN_DISFORMAT  */
+  YYSYMBOL_BX_TOKEN_RESTORE = 52,          /* BX_TOKEN_RESTORE  */
+  YYSYMBOL_BX_TOKEN_WRITEMEM = 53,         /* BX_TOKEN_WRITEMEM  */
+  YYSYMBOL_BX_TOKEN_SETPMEM = 54,          /* BX_TOKEN_SETPMEM  */
+  YYSYMBOL_BX_TOKEN_SYMBOLNAME = 55,       /* BX_TOKEN_SYMBOLNAME  */
+  YYSYMBOL_BX_TOKEN_QUERY = 56,            /* BX_TOKEN_QUERY  */
+  YYSYMBOL_BX_TOKEN_PENDING = 57,          /* BX_TOKEN_PENDING  */
+  YYSYMBOL_BX_TOKEN_TAKE = 58,             /* BX_TOKEN_TAKE  */
+  YYSYMBOL_BX_TOKEN_DMA = 59,              /* BX_TOKEN_DMA  */
+  YYSYMBOL_BX_TOKEN_IRQ = 60,              /* BX_TOKEN_IRQ  */
+  YYSYMBOL_BX_TOKEN_TLB = 61,              /* BX_TOKEN_TLB  */
+  YYSYMBOL_BX_TOKEN_HEX = 62,              /* BX_TOKEN_HEX  */
+  YYSYMBOL_BX_TOKEN_DISASM = 63,           /* BX_TOKEN_DISASM  */
+  YYSYMBOL_BX_TOKEN_INSTRUMENT = 64,       /* BX_TOKEN_INSTRUMENT  */
+  YYSYMBOL_BX_TOKEN_STRING = 65,           /* BX_TOKEN_STRING  */
+  YYSYMBOL_BX_TOKEN_STOP = 66,             /* BX_TOKEN_STOP  */
+  YYSYMBOL_BX_TOKEN_DOIT = 67,             /* BX_TOKEN_DOIT  */
+  YYSYMBOL_BX_TOKEN_CRC = 68,              /* BX_TOKEN_CRC  */
+  YYSYMBOL_BX_TOKEN_TRACE = 69,            /* BX_TOKEN_TRACE  */
+  YYSYMBOL_BX_TOKEN_TRACEREG = 70,         /* BX_TOKEN_TRACEREG  */
+  YYSYMBOL_BX_TOKEN_TRACEMEM = 71,         /* BX_TOKEN_TRACEMEM  */
+  YYSYMBOL_BX_TOKEN_SWITCH_MODE = 72,      /* BX_TOKEN_SWITCH_MODE  */
+  YYSYMBOL_BX_TOKEN_SIZE = 73,             /* BX_TOKEN_SIZE  */
+  YYSYMBOL_BX_TOKEN_PTIME = 74,            /* BX_TOKEN_PTIME  */
+  YYSYMBOL_BX_TOKEN_TIMEBP_ABSOLUTE = 75,  /* BX_TOKEN_TIMEBP_ABSOLUTE  */
+  YYSYMBOL_BX_TOKEN_TIMEBP = 76,           /* BX_TOKEN_TIMEBP  */
+  YYSYMBOL_BX_TOKEN_MODEBP = 77,           /* BX_TOKEN_MODEBP  */
+  YYSYMBOL_BX_TOKEN_VMEXITBP = 78,         /* BX_TOKEN_VMEXITBP  */
+  YYSYMBOL_BX_TOKEN_PRINT_STACK = 79,      /* BX_TOKEN_PRINT_STACK  */
+  YYSYMBOL_BX_TOKEN_WATCH = 80,            /* BX_TOKEN_WATCH  */
+  YYSYMBOL_BX_TOKEN_UNWATCH = 81,          /* BX_TOKEN_UNWATCH  */
+  YYSYMBOL_BX_TOKEN_READ = 82,             /* BX_TOKEN_READ  */
+  YYSYMBOL_BX_TOKEN_WRITE = 83,            /* BX_TOKEN_WRITE  */
+  YYSYMBOL_BX_TOKEN_SHOW = 84,             /* BX_TOKEN_SHOW  */
+  YYSYMBOL_BX_TOKEN_LOAD_SYMBOLS = 85,     /* BX_TOKEN_LOAD_SYMBOLS  */
+  YYSYMBOL_BX_TOKEN_SYMBOLS = 86,          /* BX_TOKEN_SYMBOLS  */
+  YYSYMBOL_BX_TOKEN_LIST_SYMBOLS = 87,     /* BX_TOKEN_LIST_SYMBOLS  */
+  YYSYMBOL_BX_TOKEN_GLOBAL = 88,           /* BX_TOKEN_GLOBAL  */
+  YYSYMBOL_BX_TOKEN_WHERE = 89,            /* BX_TOKEN_WHERE  */
+  YYSYMBOL_BX_TOKEN_PRINT_STRING = 90,     /* BX_TOKEN_PRINT_STRING  */
+  YYSYMBOL_BX_TOKEN_NUMERIC = 91,          /* BX_TOKEN_NUMERIC  */
+  YYSYMBOL_BX_TOKEN_PAGE = 92,             /* BX_TOKEN_PAGE  */
+  YYSYMBOL_BX_TOKEN_HELP = 93,             /* BX_TOKEN_HELP  */
+  YYSYMBOL_BX_TOKEN_CALC = 94,             /* BX_TOKEN_CALC  */
+  YYSYMBOL_BX_TOKEN_VGA = 95,              /* BX_TOKEN_VGA  */
+  YYSYMBOL_BX_TOKEN_DEVICE = 96,           /* BX_TOKEN_DEVICE  */
+  YYSYMBOL_BX_TOKEN_COMMAND = 97,          /* BX_TOKEN_COMMAND  */
+  YYSYMBOL_BX_TOKEN_GENERIC = 98,          /* BX_TOKEN_GENERIC  */
+  YYSYMBOL_BX_TOKEN_RSHIFT = 99,           /* BX_TOKEN_RSHIFT  */
+  YYSYMBOL_BX_TOKEN_LSHIFT = 100,          /* BX_TOKEN_LSHIFT  */
+  YYSYMBOL_BX_TOKEN_REG_IP = 101,          /* BX_TOKEN_REG_IP  */
+  YYSYMBOL_BX_TOKEN_REG_EIP = 102,         /* BX_TOKEN_REG_EIP  */
+  YYSYMBOL_BX_TOKEN_REG_RIP = 103,         /* BX_TOKEN_REG_RIP  */
+  YYSYMBOL_104_ = 104,                     /* '+'  */
+  YYSYMBOL_105_ = 105,                     /* '-'  */
+  YYSYMBOL_106_ = 106,                     /* '|'  */
+  YYSYMBOL_107_ = 107,                     /* '^'  */
+  YYSYMBOL_108_ = 108,                     /* '*'  */
+  YYSYMBOL_109_ = 109,                     /* '/'  */
+  YYSYMBOL_110_ = 110,                     /* '&'  */
+  YYSYMBOL_NOT = 111,                      /* NOT  */
+  YYSYMBOL_NEG = 112,                      /* NEG  */
+  YYSYMBOL_INDIRECT = 113,                 /* INDIRECT  */
+  YYSYMBOL_114_n_ = 114,                   /* '\n'  */
+  YYSYMBOL_115_ = 115,                     /* '='  */
+  YYSYMBOL_116_ = 116,                     /* ':'  */
+  YYSYMBOL_117_ = 117,                     /* '!'  */
+  YYSYMBOL_118_ = 118,                     /* '('  */
+  YYSYMBOL_119_ = 119,                     /* ')'  */
+  YYSYMBOL_120_ = 120,                     /* '@'  */
+  YYSYMBOL_YYACCEPT = 121,                 /* $accept  */
+  YYSYMBOL_commands = 122,                 /* commands  */
+  YYSYMBOL_command = 123,                  /* command  */
+  YYSYMBOL_BX_TOKEN_TOGGLE_ON_OFF = 124,   /* BX_TOKEN_TOGGLE_ON_OFF  */
+  YYSYMBOL_BX_TOKEN_REGISTERS = 125,       /* BX_TOKEN_REGISTERS  */
+  YYSYMBOL_BX_TOKEN_SEGREG = 126,          /* BX_TOKEN_SEGREG  */
+  YYSYMBOL_timebp_command = 127,           /* timebp_command  */
+  YYSYMBOL_modebp_command = 128,           /* modebp_command  */
+  YYSYMBOL_vmexitbp_command = 129,         /* vmexitbp_command  */
+  YYSYMBOL_show_command = 130,             /* show_command  */
+  YYSYMBOL_page_command = 131,             /* page_command  */
+  YYSYMBOL_tlb_command = 132,              /* tlb_command  */
+  YYSYMBOL_ptime_command = 133,            /* ptime_command  */
+  YYSYMBOL_trace_command = 134,            /* trace_command  */
+  YYSYMBOL_trace_reg_command = 135,        /* trace_reg_command  */
+  YYSYMBOL_trace_mem_command = 136,        /* trace_mem_command  */
+  YYSYMBOL_print_stack_command = 137,      /* print_stack_command  */
+  YYSYMBOL_watch_point_command = 138,      /* watch_point_command  */
+  YYSYMBOL_symbol_command = 139,           /* symbol_command  */
+  YYSYMBOL_where_command = 140,            /* where_command  */
+  YYSYMBOL_print_string_command = 141,     /* print_string_command  */
+  YYSYMBOL_continue_command = 142,         /* continue_command  */
+  YYSYMBOL_stepN_command = 143,            /* stepN_command  */
+  YYSYMBOL_step_over_command = 144,        /* step_over_command  */
+  YYSYMBOL_set_command = 145,              /* set_command  */
+  YYSYMBOL_breakpoint_command = 146,       /* breakpoint_command  */
+  YYSYMBOL_blist_command = 147,            /* blist_command  */
+  YYSYMBOL_slist_command = 148,            /* slist_command  */
+  YYSYMBOL_info_command = 149,             /* info_command  */
+  YYSYMBOL_optional_numeric = 150,         /* optional_numeric  */
+  YYSYMBOL_regs_command = 151,             /* regs_command  */
+  YYSYMBOL_fpu_regs_command = 152,         /* fpu_regs_command  */
+  YYSYMBOL_mmx_regs_command = 153,         /* mmx_regs_command  */
+  YYSYMBOL_sse_regs_command = 154,         /* sse_regs_command  */
+  YYSYMBOL_avx_regs_command = 155,         /* avx_regs_command  */
+  YYSYMBOL_segment_regs_command = 156,     /* segment_regs_command  */
+  YYSYMBOL_control_regs_command = 157,     /* control_regs_command  */
+  YYSYMBOL_debug_regs_command = 158,       /* debug_regs_command  */
+  YYSYMBOL_delete_command = 159,           /* delete_command  */
+  YYSYMBOL_bpe_command = 160,              /* bpe_command  */
+  YYSYMBOL_bpd_command = 161,              /* bpd_command  */
+  YYSYMBOL_quit_command = 162,             /* quit_command  */
+  YYSYMBOL_examine_command = 163,          /* examine_command  */
+  YYSYMBOL_restore_command = 164,          /* restore_command  */
+  YYSYMBOL_writemem_command = 165,         /* writemem_command  */
+  YYSYMBOL_setpmem_command = 166,          /* setpmem_command  */
+  YYSYMBOL_query_command = 167,            /* query_command  */
+  YYSYMBOL_take_command = 168,             /* take_command  */
+  YYSYMBOL_disassemble_command = 169,      /* disassemble_command  */
+  YYSYMBOL_instrument_command = 170,       /* instrument_command  */
+  YYSYMBOL_doit_command = 171,             /* doit_command  */
+  YYSYMBOL_crc_command = 172,              /* crc_command  */
+  YYSYMBOL_help_command = 173,             /* help_command  */
+  YYSYMBOL_calc_command = 174,             /* calc_command  */
+  YYSYMBOL_vexpression = 175,              /* vexpression  */
+  YYSYMBOL_expression = 176                /* expression  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
 
-/* Copy the second part of user declarations.  */
 
-/* Line 390 of yacc.c  */
-#line 373 "y.tab.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -407,16 +648,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -430,41 +683,71 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef __attribute__
-/* This feature is available in gcc versions 2.5 and later.  */
-# if (! defined __GNUC__ || __GNUC__ < 2 \
-      || (__GNUC__ == 2 && __GNUC_MINOR__ < 5))
-#  define __attribute__(Spec) /* empty */
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(N) (N)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
 #endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -481,8 +764,7 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
       /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
 #     ifndef EXIT_SUCCESS
@@ -494,8 +776,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -511,7 +793,7 @@ YYID (yyi)
 #  endif
 #  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
 #   ifndef EXIT_SUCCESS
 #    define EXIT_SUCCESS 0
@@ -519,40 +801,37 @@ YYID (yyi)
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -562,16 +841,16 @@ union yyalloc
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
@@ -581,43 +860,48 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
-      while (YYID (0))
+      while (0)
 #  endif
 # endif
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  285
+#define YYFINAL  287
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   1715
+#define YYLAST   1736
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  121
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  56
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  271
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  529
+#define YYNRULES  273
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  535
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   361
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
      114,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -659,142 +943,8 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
-{
-       0,     0,     3,     6,     8,    10,    12,    14,    16,    18,
-      20,    22,    24,    26,    28,    30,    32,    34,    36,    38,
-      40,    42,    44,    46,    48,    50,    52,    54,    56,    58,
-      60,    62,    64,    66,    68,    70,    72,    74,    76,    78,
-      80,    82,    84,    86,    88,    90,    92,    94,    96,    98,
-     100,   102,   103,   105,   107,   109,   111,   113,   115,   117,
-     119,   121,   123,   125,   129,   133,   136,   139,   143,   147,
-     151,   154,   158,   162,   165,   169,   173,   177,   180,   184,
-     188,   192,   195,   200,   205,   210,   216,   222,   228,   231,
-     235,   239,   244,   249,   255,   258,   262,   265,   268,   272,
-     277,   282,   285,   290,   296,   302,   308,   314,   320,   326,
-     332,   338,   344,   347,   353,   356,   360,   364,   367,   371,
-     376,   379,   382,   386,   390,   394,   400,   406,   412,   418,
-     422,   426,   430,   434,   438,   443,   447,   452,   458,   459,
-     461,   464,   467,   470,   473,   476,   479,   482,   485,   489,
-     493,   497,   500,   505,   509,   513,   516,   521,   527,   533,
-     537,   541,   546,   550,   553,   557,   562,   566,   571,   577,
-     581,   586,   592,   596,   600,   604,   609,   613,   617,   621,
-     625,   629,   633,   637,   641,   645,   649,   653,   657,   661,
-     665,   669,   673,   677,   681,   685,   689,   693,   697,   701,
-     705,   709,   713,   717,   721,   725,   729,   733,   737,   741,
-     745,   749,   753,   757,   761,   765,   769,   773,   777,   781,
-     785,   789,   792,   796,   798,   800,   802,   804,   806,   808,
-     810,   812,   814,   816,   818,   822,   826,   830,   834,   838,
-     842,   846,   850,   854,   857,   860,   864,   866,   868,   870,
-     872,   874,   876,   878,   880,   882,   884,   886,   890,   894,
-     898,   902,   906,   910,   914,   918,   922,   926,   929,   932,
-     935,   938
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int16 yyrhs[] =
-{
-     122,     0,    -1,   122,   123,    -1,   123,    -1,   142,    -1,
-     143,    -1,   144,    -1,   145,    -1,   146,    -1,   149,    -1,
-     151,    -1,   152,    -1,   153,    -1,   154,    -1,   155,    -1,
-     156,    -1,   158,    -1,   157,    -1,   147,    -1,   148,    -1,
-     159,    -1,   160,    -1,   161,    -1,   162,    -1,   163,    -1,
-     164,    -1,   165,    -1,   166,    -1,   167,    -1,   168,    -1,
-     169,    -1,   170,    -1,   171,    -1,   172,    -1,   134,    -1,
-     135,    -1,   136,    -1,   133,    -1,   127,    -1,   128,    -1,
-     129,    -1,   137,    -1,   138,    -1,   131,    -1,   132,    -1,
-     130,    -1,   139,    -1,   140,    -1,   141,    -1,   173,    -1,
-     174,    -1,    -1,   114,    -1,    15,    -1,    16,    -1,    31,
-      -1,    32,    -1,     8,    -1,     9,    -1,    10,    -1,    11,
-      -1,    12,    -1,    13,    -1,    76,   176,   114,    -1,    75,
-     176,   114,    -1,    77,   114,    -1,    78,   114,    -1,    84,
-      97,   114,    -1,    84,    16,   114,    -1,    84,    65,   114,
-      -1,    84,   114,    -1,    92,   176,   114,    -1,    61,   176,
-     114,    -1,    74,   114,    -1,    69,   124,   114,    -1,    70,
-     124,   114,    -1,    71,   124,   114,    -1,    79,   114,    -1,
-      79,    91,   114,    -1,    80,    66,   114,    -1,    80,    17,
-     114,    -1,    80,   114,    -1,    80,    31,   176,   114,    -1,
-      80,    82,   176,   114,    -1,    80,    83,   176,   114,    -1,
-      80,    31,   176,   176,   114,    -1,    80,    82,   176,   176,
-     114,    -1,    80,    83,   176,   176,   114,    -1,    81,   114,
-      -1,    81,   176,   114,    -1,    85,    65,   114,    -1,    85,
-      65,   176,   114,    -1,    85,    88,    65,   114,    -1,    85,
-      88,    65,   176,   114,    -1,    89,   114,    -1,    90,   176,
-     114,    -1,    17,   114,    -1,    18,   114,    -1,    18,    91,
-     114,    -1,    18,    44,    91,   114,    -1,    18,    91,    91,
-     114,    -1,    19,   114,    -1,    20,    63,   124,   114,    -1,
-      20,    55,   115,   176,   114,    -1,    20,     4,   115,   176,
-     114,    -1,    20,     3,   115,   176,   114,    -1,    20,     5,
-     115,   176,   114,    -1,    20,     6,   115,   176,   114,    -1,
-      20,     7,   115,   176,   114,    -1,    20,   102,   115,   176,
-     114,    -1,    20,   103,   115,   176,   114,    -1,    20,   126,
-     115,   176,   114,    -1,    23,   114,    -1,    23,   175,   116,
-     175,   114,    -1,    24,   114,    -1,    24,   176,   114,    -1,
-      24,    65,   114,    -1,    25,   114,    -1,    25,   176,   114,
-      -1,    25,   108,   176,   114,    -1,    22,   114,    -1,    87,
-     114,    -1,    87,    65,   114,    -1,    29,    25,   114,    -1,
-      29,    33,   114,    -1,    29,    38,   150,   150,   114,    -1,
-      29,    39,   150,   150,   114,    -1,    29,    40,   150,   150,
-     114,    -1,    29,    41,   150,   150,   114,    -1,    29,    43,
-     114,    -1,    29,    42,   114,    -1,    29,    14,   114,    -1,
-      29,    45,   114,    -1,    29,    86,   114,    -1,    29,    86,
-      65,   114,    -1,    29,    96,   114,    -1,    29,    96,    65,
-     114,    -1,    29,    96,    65,    65,   114,    -1,    -1,   176,
-      -1,   125,   114,    -1,    34,   114,    -1,    35,   114,    -1,
-      36,   114,    -1,    37,   114,    -1,    48,   114,    -1,    47,
-     114,    -1,    46,   114,    -1,    26,    91,   114,    -1,    27,
-      91,   114,    -1,    28,    91,   114,    -1,    30,   114,    -1,
-      49,    50,   176,   114,    -1,    49,    50,   114,    -1,    49,
-     176,   114,    -1,    49,   114,    -1,    52,    65,    65,   114,
-      -1,    53,    65,   176,   176,   114,    -1,    54,   176,   176,
-     176,   114,    -1,    56,    57,   114,    -1,    58,    59,   114,
-      -1,    58,    59,    91,   114,    -1,    58,    60,   114,    -1,
-      63,   114,    -1,    63,   176,   114,    -1,    63,   176,   176,
-     114,    -1,    63,    51,   114,    -1,    63,    51,   176,   114,
-      -1,    63,    51,   176,   176,   114,    -1,    63,    72,   114,
-      -1,    63,    62,   124,   114,    -1,    63,    73,   115,    91,
-     114,    -1,    64,    66,   114,    -1,    64,    97,   114,    -1,
-      67,   176,   114,    -1,    68,   176,   176,   114,    -1,    93,
-      30,   114,    -1,    93,    17,   114,    -1,    93,    18,   114,
-      -1,    93,    19,   114,    -1,    93,    23,   114,    -1,    93,
-      24,   114,    -1,    93,    25,   114,    -1,    93,    26,   114,
-      -1,    93,    27,   114,    -1,    93,    28,   114,    -1,    93,
-      22,   114,    -1,    93,    77,   114,    -1,    93,    78,   114,
-      -1,    93,    68,   114,    -1,    93,    69,   114,    -1,    93,
-      70,   114,    -1,    93,    71,   114,    -1,    93,    52,   114,
-      -1,    93,    74,   114,    -1,    93,    76,   114,    -1,    93,
-      75,   114,    -1,    93,    79,   114,    -1,    93,    85,   114,
-      -1,    93,    87,   114,    -1,    93,   125,   114,    -1,    93,
-      34,   114,    -1,    93,    35,   114,    -1,    93,    36,   114,
-      -1,    93,    37,   114,    -1,    93,    48,   114,    -1,    93,
-      47,   114,    -1,    93,    46,   114,    -1,    93,    53,   114,
-      -1,    93,    54,   114,    -1,    93,    63,   114,    -1,    93,
-      80,   114,    -1,    93,    81,   114,    -1,    93,    49,   114,
-      -1,    93,    64,   114,    -1,    93,    20,   114,    -1,    93,
-      92,   114,    -1,    93,    29,   114,    -1,    93,    84,   114,
-      -1,    93,    94,   114,    -1,    93,    93,   114,    -1,    93,
-     114,    -1,    94,   176,   114,    -1,    91,    -1,    65,    -1,
-       4,    -1,     3,    -1,     5,    -1,     6,    -1,     7,    -1,
-     126,    -1,   101,    -1,   102,    -1,   103,    -1,   175,   104,
-     175,    -1,   175,   105,   175,    -1,   175,   108,   175,    -1,
-     175,   109,   175,    -1,   175,    99,   175,    -1,   175,   100,
-     175,    -1,   175,   106,   175,    -1,   175,   107,   175,    -1,
-     175,   110,   175,    -1,   117,   175,    -1,   105,   175,    -1,
-     118,   175,   119,    -1,    91,    -1,    65,    -1,     4,    -1,
-       3,    -1,     5,    -1,     6,    -1,     7,    -1,   126,    -1,
-     101,    -1,   102,    -1,   103,    -1,   176,   116,   176,    -1,
-     176,   104,   176,    -1,   176,   105,   176,    -1,   176,   108,
-     176,    -1,   176,   109,   176,    -1,   176,    99,   176,    -1,
-     176,   100,   176,    -1,   176,   106,   176,    -1,   176,   107,
-     176,    -1,   176,   110,   176,    -1,   117,   176,    -1,   105,
-     176,    -1,   108,   176,    -1,   120,   176,    -1,   118,   176,
-     119,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
        0,   138,   138,   139,   143,   144,   145,   146,   147,   148,
      149,   150,   151,   152,   153,   154,   155,   156,   157,   158,
@@ -805,38 +955,45 @@ static const yytype_uint16 yyrline[] =
      212,   213,   214,   219,   224,   232,   240,   248,   253,   258,
      263,   271,   279,   287,   295,   303,   311,   319,   324,   332,
      337,   342,   347,   352,   357,   362,   367,   372,   377,   382,
-     390,   395,   400,   405,   413,   421,   429,   437,   442,   447,
-     452,   460,   468,   473,   478,   482,   486,   490,   494,   498,
-     502,   506,   513,   518,   523,   528,   533,   538,   543,   548,
-     556,   564,   569,   577,   582,   587,   592,   597,   602,   607,
-     612,   617,   622,   627,   632,   637,   642,   647,   655,   656,
-     659,   667,   675,   683,   691,   699,   707,   715,   723,   731,
-     738,   746,   754,   759,   764,   769,   777,   785,   793,   801,
-     809,   814,   819,   827,   832,   837,   842,   847,   852,   857,
-     862,   867,   875,   880,   888,   896,   904,   909,   914,   921,
-     926,   931,   936,   941,   946,   951,   956,   961,   966,   971,
-     976,   982,   988,   994,  1002,  1007,  1012,  1017,  1022,  1027,
+     387,   392,   400,   405,   410,   415,   423,   431,   439,   447,
+     452,   457,   462,   470,   478,   483,   488,   492,   496,   500,
+     504,   508,   512,   516,   523,   528,   533,   538,   543,   548,
+     553,   558,   566,   574,   579,   587,   592,   597,   602,   607,
+     612,   617,   622,   627,   632,   637,   642,   647,   652,   657,
+     665,   666,   669,   677,   685,   693,   701,   709,   717,   725,
+     733,   741,   748,   756,   764,   769,   774,   779,   787,   795,
+     803,   811,   819,   824,   829,   837,   842,   847,   852,   857,
+     862,   867,   872,   877,   885,   890,   898,   906,   914,   919,
+     924,   931,   936,   941,   946,   951,   956,   961,   966,   971,
+     976,   981,   986,   992,   998,  1004,  1012,  1017,  1022,  1027,
     1032,  1037,  1042,  1047,  1052,  1057,  1062,  1067,  1072,  1077,
-    1082,  1092,  1103,  1109,  1122,  1127,  1138,  1143,  1158,  1170,
-    1180,  1185,  1193,  1211,  1212,  1213,  1214,  1215,  1216,  1217,
-    1218,  1219,  1220,  1221,  1222,  1223,  1224,  1225,  1226,  1227,
-    1228,  1229,  1230,  1231,  1232,  1233,  1239,  1240,  1241,  1242,
-    1243,  1244,  1245,  1246,  1247,  1248,  1249,  1250,  1251,  1252,
+    1082,  1087,  1092,  1102,  1114,  1121,  1134,  1139,  1150,  1155,
+    1170,  1182,  1192,  1197,  1205,  1223,  1224,  1225,  1226,  1227,
+    1228,  1229,  1230,  1231,  1232,  1233,  1234,  1235,  1236,  1237,
+    1238,  1239,  1240,  1241,  1242,  1243,  1244,  1245,  1251,  1252,
     1253,  1254,  1255,  1256,  1257,  1258,  1259,  1260,  1261,  1262,
-    1263,  1264
+    1263,  1264,  1265,  1266,  1267,  1268,  1269,  1270,  1271,  1272,
+    1273,  1274,  1275,  1276
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "BX_TOKEN_8BH_REG", "BX_TOKEN_8BL_REG",
-  "BX_TOKEN_16B_REG", "BX_TOKEN_32B_REG", "BX_TOKEN_64B_REG",
-  "BX_TOKEN_CS", "BX_TOKEN_ES", "BX_TOKEN_SS", "BX_TOKEN_DS",
-  "BX_TOKEN_FS", "BX_TOKEN_GS", "BX_TOKEN_FLAGS", "BX_TOKEN_ON",
-  "BX_TOKEN_OFF", "BX_TOKEN_CONTINUE", "BX_TOKEN_STEPN",
+  "\"end of file\"", "error", "\"invalid token\"", "BX_TOKEN_8BH_REG",
+  "BX_TOKEN_8BL_REG", "BX_TOKEN_16B_REG", "BX_TOKEN_32B_REG",
+  "BX_TOKEN_64B_REG", "BX_TOKEN_CS", "BX_TOKEN_ES", "BX_TOKEN_SS",
+  "BX_TOKEN_DS", "BX_TOKEN_FS", "BX_TOKEN_GS", "BX_TOKEN_FLAGS",
+  "BX_TOKEN_ON", "BX_TOKEN_OFF", "BX_TOKEN_CONTINUE", "BX_TOKEN_STEPN",
   "BX_TOKEN_STEP_OVER", "BX_TOKEN_SET", "BX_TOKEN_DEBUGGER",
   "BX_TOKEN_LIST_BREAK", "BX_TOKEN_VBREAKPOINT", "BX_TOKEN_LBREAKPOINT",
   "BX_TOKEN_PBREAKPOINT", "BX_TOKEN_DEL_BREAKPOINT",
@@ -863,7 +1020,7 @@ static const char *const yytname[] =
   "BX_TOKEN_VGA", "BX_TOKEN_DEVICE", "BX_TOKEN_COMMAND",
   "BX_TOKEN_GENERIC", "BX_TOKEN_RSHIFT", "BX_TOKEN_LSHIFT",
   "BX_TOKEN_REG_IP", "BX_TOKEN_REG_EIP", "BX_TOKEN_REG_RIP", "'+'", "'-'",
-  "'|'", "'^'", "'*'", "'/'", "'&'", "INDIRECT", "NEG", "NOT", "'\\n'",
+  "'|'", "'^'", "'*'", "'/'", "'&'", "NOT", "NEG", "INDIRECT", "'\\n'",
   "'='", "':'", "'!'", "'('", "')'", "'@'", "$accept", "commands",
   "command", "BX_TOKEN_TOGGLE_ON_OFF", "BX_TOKEN_REGISTERS",
   "BX_TOKEN_SEGREG", "timebp_command", "modebp_command",
@@ -881,101 +1038,90 @@ static const char *const yytname[] =
   "setpmem_command", "query_command", "take_command",
   "disassemble_command", "instrument_command", "doit_command",
   "crc_command", "help_command", "calc_command", "vexpression",
-  "expression", YY_NULL
+  "expression", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
-     325,   326,   327,   328,   329,   330,   331,   332,   333,   334,
-     335,   336,   337,   338,   339,   340,   341,   342,   343,   344,
-     345,   346,   347,   348,   349,   350,   351,   352,   353,   354,
-     355,   356,   357,   358,    43,    45,   124,    94,    42,    47,
-      38,   359,   360,   361,    10,    61,    58,    33,    40,    41,
-      64
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,   121,   122,   122,   123,   123,   123,   123,   123,   123,
-     123,   123,   123,   123,   123,   123,   123,   123,   123,   123,
-     123,   123,   123,   123,   123,   123,   123,   123,   123,   123,
-     123,   123,   123,   123,   123,   123,   123,   123,   123,   123,
-     123,   123,   123,   123,   123,   123,   123,   123,   123,   123,
-     123,   123,   123,   124,   124,   125,   125,   126,   126,   126,
-     126,   126,   126,   127,   127,   128,   129,   130,   130,   130,
-     130,   131,   132,   133,   134,   135,   136,   137,   137,   138,
-     138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
-     139,   139,   139,   139,   140,   141,   142,   143,   143,   143,
-     143,   144,   145,   145,   145,   145,   145,   145,   145,   145,
-     145,   145,   146,   146,   146,   146,   146,   146,   146,   146,
-     147,   148,   148,   149,   149,   149,   149,   149,   149,   149,
-     149,   149,   149,   149,   149,   149,   149,   149,   150,   150,
-     151,   152,   153,   154,   155,   156,   157,   158,   159,   160,
-     161,   162,   163,   163,   163,   163,   164,   165,   166,   167,
-     168,   168,   168,   169,   169,   169,   169,   169,   169,   169,
-     169,   169,   170,   170,   171,   172,   173,   173,   173,   173,
-     173,   173,   173,   173,   173,   173,   173,   173,   173,   173,
-     173,   173,   173,   173,   173,   173,   173,   173,   173,   173,
-     173,   173,   173,   173,   173,   173,   173,   173,   173,   173,
-     173,   173,   173,   173,   173,   173,   173,   173,   173,   173,
-     173,   173,   174,   175,   175,   175,   175,   175,   175,   175,
-     175,   175,   175,   175,   175,   175,   175,   175,   175,   175,
-     175,   175,   175,   175,   175,   175,   176,   176,   176,   176,
-     176,   176,   176,   176,   176,   176,   176,   176,   176,   176,
-     176,   176,   176,   176,   176,   176,   176,   176,   176,   176,
-     176,   176
-};
+#define YYPACT_NINF (-167)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-271)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-       0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     0,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     3,     3,     2,     2,     3,     3,     3,
-       2,     3,     3,     2,     3,     3,     3,     2,     3,     3,
-       3,     2,     4,     4,     4,     5,     5,     5,     2,     3,
-       3,     4,     4,     5,     2,     3,     2,     2,     3,     4,
-       4,     2,     4,     5,     5,     5,     5,     5,     5,     5,
-       5,     5,     2,     5,     2,     3,     3,     2,     3,     4,
-       2,     2,     3,     3,     3,     5,     5,     5,     5,     3,
-       3,     3,     3,     3,     4,     3,     4,     5,     0,     1,
-       2,     2,     2,     2,     2,     2,     2,     2,     3,     3,
-       3,     2,     4,     3,     3,     2,     4,     5,     5,     3,
-       3,     4,     3,     2,     3,     4,     3,     4,     5,     3,
-       4,     5,     3,     3,     3,     4,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     2,     3,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     3,     3,     3,     3,     3,     3,
-       3,     3,     3,     2,     2,     3,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     3,     3,     3,
-       3,     3,     3,     3,     3,     3,     3,     2,     2,     2,
-       2,     3
+    1335,  -101,   -41,   -96,    80,   -94,  1132,   778,   828,   -52,
+     -45,   -42,   206,   -59,  -167,  -167,   -58,   -57,   -40,   -39,
+     -16,   -15,   -14,   710,    36,    39,  1084,     1,    -8,  1084,
+     639,   -56,  1084,  1084,    38,    38,    38,   -11,  1084,  1084,
+      -5,     3,   -80,    13,   758,     5,   -50,   -38,     4,  1084,
+    1084,  1416,  1084,  -167,  1254,  -167,     9,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,    16,   -74,  -167,  -167,    11,
+      14,    15,    17,    18,  -167,  -167,  -167,  -167,  -167,  -167,
+      23,    38,    24,    25,    26,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  1150,  -167,  1150,  1150,
+    -167,   238,  -167,  -167,  -167,  -167,  -167,    10,  -167,  -167,
+    -167,  -167,  1084,  1084,  -167,  1084,  1084,  1084,  -167,   169,
+    -167,  1084,  -167,   257,    28,    30,    37,    53,    54,    55,
+    1084,  1084,  1084,  1084,    67,    72,    73,   -37,   -36,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,   896,  -167,   302,
+      63,  1084,   576,    74,   -67,    75,   365,   946,    38,    77,
+      78,  -167,    56,    82,    83,   428,   576,  -167,  -167,    84,
+      86,    87,  -167,   491,   554,  -167,  -167,    88,  -167,   100,
+    1084,   103,  1084,  1084,    66,  -167,   127,  -167,   629,   107,
+     108,   111,  -167,   966,   129,   116,  -167,  -167,   700,   818,
+     122,   123,   128,   136,   140,   141,   142,   150,   151,   152,
+     156,   157,   166,   167,   168,   170,   182,   183,   184,   185,
+     186,   187,   189,   200,   210,   225,   226,   227,   235,   241,
+     244,   245,   254,   255,   256,   258,   260,   261,   262,   264,
+     267,   268,   269,   270,  -167,   271,   886,  -167,  -167,  -167,
+     272,   273,  -167,  1084,  1084,  1084,  1084,  1084,  1084,   289,
+    1084,  1084,  1084,  -167,  -167,   153,  1150,  1150,  1150,  1150,
+    1150,  1150,  1150,  1150,  1150,  1150,  -167,   125,   125,   125,
+       6,   125,  1084,  1084,  1084,  1084,  1084,  1084,  1084,  1084,
+    1084,  -167,  1084,  -102,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  1084,  1609,  1084,  1084,  1084,  -167,  -167,  -167,   290,
+    -167,   -17,  -167,  -167,   936,  -167,   291,   576,  1084,  1084,
+     576,  -167,   299,  -167,  -167,  -167,  -167,   323,   301,  -167,
+      29,  -167,  1004,  -167,  -167,  -167,  1074,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,   387,  -167,   450,   513,   303,   305,
+    -167,  -167,  -167,  -167,  -167,  1112,  1014,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  1367,  1407,
+    1427,  1440,  1453,  1466,  -167,  1479,  1492,  1505,  -167,  -167,
+    -167,   -28,   -28,   -28,   -28,  -167,  -167,  -167,  1622,  -167,
+     125,   125,   119,   119,   119,   119,   125,   125,   125,  1609,
+    -167,   306,   307,   320,   321,  -167,   322,  -167,  -167,  -167,
+    1518,   124,   125,  1531,  -167,  -167,  1544,  -167,   324,  -167,
+    -167,  -167,  1557,  -167,  1570,  -167,  1583,  -167,  -167,  -167,
+    -167,  1596,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,  -167,  -167
 };
 
-/* YYDEFACT[STATE-NAME] -- Default reduction number in state STATE-NUM.
-   Performed when YYTABLE doesn't specify something else to do.  Zero
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_uint16 yydefact[] =
+static const yytype_int16 yydefact[] =
 {
       51,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,    55,    56,     0,     0,     0,     0,
@@ -987,126 +1133,56 @@ static const yytype_uint16 yydefact[] =
       47,    48,     4,     5,     6,     7,     8,    18,    19,     9,
       10,    11,    12,    13,    14,    15,    17,    16,    20,    21,
       22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
-      32,    33,    49,    50,    96,     0,     0,    97,   101,     0,
+      32,    33,    49,    50,    98,     0,     0,    99,   103,     0,
        0,     0,     0,     0,    57,    58,    59,    60,    61,    62,
-       0,     0,     0,     0,     0,   120,   226,   225,   227,   228,
-     229,   224,   223,   231,   232,   233,     0,   112,     0,     0,
-     230,     0,   249,   248,   250,   251,   252,   247,   246,   254,
-     255,   256,     0,     0,   114,     0,     0,     0,   253,     0,
-     247,     0,   117,     0,     0,     0,     0,     0,     0,     0,
-     138,   138,   138,   138,     0,     0,     0,     0,     0,   151,
-     141,   142,   143,   144,   147,   146,   145,     0,   155,     0,
+       0,     0,     0,     0,     0,   122,   228,   227,   229,   230,
+     231,   226,   225,   233,   234,   235,     0,   114,     0,     0,
+     232,     0,   251,   250,   252,   253,   254,   249,   248,   256,
+     257,   258,     0,     0,   116,     0,     0,     0,   255,     0,
+     249,     0,   119,     0,     0,     0,     0,     0,     0,     0,
+     140,   140,   140,   140,     0,     0,     0,     0,     0,   153,
+     143,   144,   145,   146,   149,   148,   147,     0,   157,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,   163,     0,     0,     0,     0,     0,    53,    54,     0,
+       0,   165,     0,     0,     0,     0,     0,    53,    54,     0,
        0,     0,    73,     0,     0,    65,    66,     0,    77,     0,
-       0,     0,     0,     0,    81,    88,     0,     0,     0,     0,
-      70,     0,     0,     0,   121,    94,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    81,     0,    89,     0,     0,
+       0,     0,    70,     0,     0,     0,   123,    96,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,   221,     0,     0,     1,     2,   140,     0,     0,
-      98,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,   244,   243,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,   116,   268,   269,   267,     0,   270,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,   115,
-       0,   269,   118,   148,   149,   150,   131,   123,   124,   138,
-     139,   138,   138,   138,   130,   129,   132,     0,   133,     0,
-     135,   153,     0,   154,     0,     0,     0,     0,     0,   159,
-       0,   160,   162,    72,   166,     0,     0,   169,     0,   164,
-       0,   172,   173,   174,     0,    74,    75,    76,    64,    63,
-      78,    80,     0,    79,     0,     0,    89,    68,    69,    67,
-      90,     0,     0,   122,    95,    71,   177,   178,   179,   215,
-     186,   180,   181,   182,   183,   184,   185,   217,   176,   201,
-     202,   203,   204,   207,   206,   205,   213,   193,   208,   209,
-     210,   214,   189,   190,   191,   192,   194,   196,   195,   187,
-     188,   197,   211,   212,   218,   198,   199,   216,   220,   219,
-     200,   222,    99,   100,     0,     0,     0,     0,     0,     0,
-     102,     0,     0,     0,   245,   238,   239,   234,   235,   240,
-     241,   236,   237,   242,     0,   271,   262,   263,   258,   259,
-     264,   265,   260,   261,   266,   257,   119,     0,     0,     0,
-       0,   134,     0,   136,   152,   156,     0,   259,   260,     0,
-     161,   167,     0,   170,     0,   165,   175,    82,     0,    83,
-       0,    84,     0,    91,    92,     0,   105,   104,   106,   107,
-     108,   103,   109,   110,   111,   113,   125,   126,   127,   128,
-     137,   157,   158,   168,   171,    85,    86,    87,    93
-};
-
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
-{
-      -1,    54,    55,   209,    56,   158,    57,    58,    59,    60,
-      61,    62,    63,    64,    65,    66,    67,    68,    69,    70,
-      71,    72,    73,    74,    75,    76,    77,    78,    79,   339,
-      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
-      90,    91,    92,    93,    94,    95,    96,    97,    98,    99,
-     100,   101,   102,   103,   141,   340
-};
-
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -167
-static const yytype_int16 yypact[] =
-{
-    1249,   -90,   -41,   -75,  1158,   -70,  1129,   755,   775,   -17,
-     -11,    -5,   322,   -30,  -167,  -167,   -26,   -25,   -19,   -13,
-     -12,     1,     6,   707,    47,    59,  1081,    68,   -32,  1081,
-     636,   -56,  1081,  1081,    56,    56,    56,    12,  1081,  1081,
-      13,    18,   -80,   100,   825,    14,   -50,   -52,    19,  1081,
-    1081,  1330,  1081,  -167,    29,  -167,    21,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,    50,   -74,  -167,  -167,    27,
-      32,    36,    37,    38,  -167,  -167,  -167,  -167,  -167,  -167,
-      52,    56,    53,    54,    55,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  1147,  -167,  1147,  1147,
-    -167,  1575,  -167,  -167,  -167,  -167,  -167,    58,  -167,  -167,
-    -167,  -167,  1081,  1081,  -167,  1081,  1081,  1081,  -167,   425,
-    -167,  1081,  -167,   488,    60,    64,    65,    67,    72,    73,
-    1081,  1081,  1081,  1081,    74,    75,    77,   -47,   -45,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,   893,  -167,   551,
-      79,  1081,   573,    78,   -23,    80,   626,   943,    56,    82,
-      83,  -167,   152,    86,    97,   697,   573,  -167,  -167,    98,
-     104,   105,  -167,   745,   815,  -167,  -167,   108,  -167,   109,
-    1081,   118,  1081,  1081,  -167,  -167,   883,   119,   120,   122,
-    -167,   963,   128,   124,  -167,  -167,   933,  1001,   125,   127,
-     130,   131,   132,   133,   134,   135,   136,   149,   153,   157,
-     162,   163,   164,   166,   168,   169,   176,   180,   181,   182,
-     183,   184,   185,   186,   187,   198,   208,   221,   223,   224,
-     225,   226,   227,   228,   229,   230,   231,   232,   238,   239,
-     240,   242,  -167,   243,  1119,  -167,  -167,  -167,   245,   252,
-    -167,  1081,  1081,  1081,  1081,  1081,  1081,   254,  1081,  1081,
-    1081,  -167,  -167,   362,  1147,  1147,  1147,  1147,  1147,  1147,
-    1147,  1147,  1147,  1147,  -167,    81,    81,    81,   121,    81,
-    1081,  1081,  1081,  1081,  1081,  1081,  1081,  1081,  1081,  -167,
-    1081,  -102,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  1081,
-    1588,  1081,  1081,  1081,  -167,  -167,  -167,   255,  -167,   -44,
-    -167,  -167,  1281,  -167,   256,   573,  1081,  1081,   573,  -167,
-     257,  -167,  -167,  -167,  -167,   321,   258,  -167,   144,  -167,
-    1321,  -167,  -167,  -167,  1341,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,   384,  -167,   447,   510,  -167,  -167,  -167,  -167,
-    -167,  1354,  1011,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  1367,  1380,  1393,  1406,  1419,  1432,
-    -167,  1445,  1458,  1471,  -167,  -167,  -167,    30,    30,    30,
-      30,  -167,  -167,  -167,  1601,  -167,    81,    81,   165,   165,
-     165,   165,    81,    81,    81,  1588,  -167,   259,   260,   262,
-     265,  -167,   266,  -167,  -167,  -167,  1484,   301,    81,  1497,
-    -167,  -167,  1510,  -167,   267,  -167,  -167,  -167,  1523,  -167,
-    1536,  -167,  1549,  -167,  -167,  1562,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
-    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167
+       0,     0,     0,     0,   223,     0,     0,     1,     2,   142,
+       0,     0,   100,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,   246,   245,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   118,   270,   271,   269,
+       0,   272,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,   117,     0,   271,   120,   150,   151,   152,   133,   125,
+     126,   140,   141,   140,   140,   140,   132,   131,   134,     0,
+     135,     0,   137,   155,     0,   156,     0,     0,     0,     0,
+       0,   161,     0,   162,   164,    72,   168,     0,     0,   171,
+       0,   166,     0,   174,   175,   176,     0,    74,    75,    76,
+      64,    63,    78,    80,     0,    79,     0,     0,     0,     0,
+      90,    68,    69,    67,    92,     0,     0,   124,    97,    71,
+     179,   180,   181,   217,   188,   182,   183,   184,   185,   186,
+     187,   219,   178,   203,   204,   205,   206,   209,   208,   207,
+     215,   195,   210,   211,   212,   216,   191,   192,   193,   194,
+     196,   198,   197,   189,   190,   199,   213,   214,   220,   200,
+     201,   218,   222,   221,   202,   224,   101,   102,     0,     0,
+       0,     0,     0,     0,   104,     0,     0,     0,   247,   240,
+     241,   236,   237,   242,   243,   238,   239,   244,     0,   273,
+     264,   265,   260,   261,   266,   267,   262,   263,   268,   259,
+     121,     0,     0,     0,     0,   136,     0,   138,   154,   158,
+       0,   261,   262,     0,   163,   169,     0,   172,     0,   167,
+     177,    83,     0,    84,     0,    85,     0,    82,    91,    93,
+      94,     0,   107,   106,   108,   109,   110,   105,   111,   112,
+     113,   115,   127,   128,   129,   130,   139,   159,   160,   170,
+     173,    86,    87,    88,    95
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -167,  -167,   188,   -27,   331,    -2,  -167,  -167,  -167,  -167,
+    -167,  -167,    98,   -27,   102,    -2,  -167,  -167,  -167,  -167,
     -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
     -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -166,
     -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
@@ -1114,245 +1190,245 @@ static const yytype_int16 yypgoto[] =
     -167,  -167,  -167,  -167,  -103,    -7
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    54,    55,   209,    56,   158,    57,    58,    59,    60,
+      61,    62,    63,    64,    65,    66,    67,    68,    69,    70,
+      71,    72,    73,    74,    75,    76,    77,    78,    79,   341,
+      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
+      90,    91,    92,    93,    94,    95,    96,    97,    98,    99,
+     100,   101,   102,   103,   141,   342
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -269
 static const yytype_int16 yytable[] =
 {
-     159,   163,   124,   105,   140,   341,   342,   343,   210,   211,
-     203,   217,   476,   233,   330,   231,   189,   289,   347,   192,
-     349,   482,   196,   202,   104,   205,   206,   194,   195,   285,
-     227,   213,   214,   301,   218,   302,   303,   226,   232,   108,
-     290,   204,   236,   237,   125,   284,     1,     2,     3,     4,
-     106,     5,     6,     7,     8,     9,    10,    11,    12,    13,
-      14,    15,   234,    16,    17,    18,    19,   348,   360,   350,
-     483,   207,   208,   107,   164,    20,    21,    22,    23,   228,
-     165,    24,    25,    26,   179,    27,   166,    28,   180,   181,
-      29,   361,    30,    31,   297,   182,    32,    33,    34,    35,
-      36,   183,   184,    37,    38,    39,    40,    41,    42,    43,
-      44,   229,   190,    45,    46,   185,    47,   219,    48,    49,
-     186,    50,    51,    52,   191,   193,   212,   215,   230,   304,
-     305,   220,   216,   235,   140,   287,   140,   140,   310,   311,
-     312,   288,   291,    53,   354,   315,   316,   292,   317,   318,
-     319,   293,   294,   295,   331,   142,   143,   144,   145,   146,
-     114,   115,   116,   117,   118,   119,   221,   296,   298,   299,
-     300,   366,   314,   477,   333,   478,   479,   480,   334,   335,
-     352,   336,   222,   223,   355,   358,   337,   338,   344,   345,
-     365,   346,   359,   392,   362,   370,   367,   330,   368,   374,
-     371,   455,   456,   457,   458,   459,   460,   461,   462,   463,
-     464,   372,   375,   382,   224,   384,   385,   160,   376,   377,
-     320,   321,   380,   381,   391,   322,   323,   324,   325,   326,
-     327,   328,   383,   387,   388,   494,   389,   330,   393,   396,
-     465,   397,   286,   148,   398,   399,   400,   401,   402,   403,
-     404,   320,   321,   149,   150,   151,   322,   356,   324,   325,
-     357,   327,   328,   405,   320,   321,   369,   406,   330,   155,
-     156,   407,   157,   326,   327,   328,   408,   409,   410,     0,
-     411,   330,   412,   413,   444,   445,   446,   447,   448,   449,
-     414,   451,   452,   453,   415,   416,   417,   418,   419,   420,
-     421,   422,   140,   140,   140,   140,   140,   140,   140,   140,
-     140,   140,   423,   466,   467,   468,   469,   470,   471,   472,
-     473,   474,   424,   475,   142,   143,   144,   145,   146,   114,
-     115,   116,   117,   118,   119,   425,   167,   426,   427,   428,
-     429,   430,   431,   432,   433,   434,   435,   168,   486,   487,
-     488,   489,   436,   437,   438,   169,   439,   440,   492,   442,
-     170,   171,   172,   173,   174,   175,   443,   176,   450,   481,
-     485,   490,   493,   516,   517,   498,   518,   500,   502,   519,
-     520,   524,   283,     0,     0,   505,   160,   142,   143,   144,
-     145,   146,   114,   115,   116,   117,   118,   119,     0,     0,
-    -268,  -268,     0,     0,     0,     0,     0,     0,   177,  -268,
-    -268,  -268,   148,     0,     0,     0,     0,   330,   178,     0,
-     320,   321,   149,   150,   151,   322,   356,   324,   325,   357,
-     327,   328,     0,     0,     0,   491,     0,   330,   155,   156,
-       0,   157,     0,     0,     0,     0,     0,     0,     0,   160,
+     159,   163,   124,   105,   140,   343,   344,   345,   210,   211,
+     203,   217,   480,   104,   332,   233,   189,   291,   108,   192,
+     125,   229,   196,   202,   362,   205,   206,   235,   349,   351,
+     219,   213,   214,   303,   218,   304,   305,   228,   234,   164,
+     292,   204,   238,   239,   220,   286,   165,   363,   486,   166,
+     106,   194,   195,   207,   208,   179,   180,   181,   193,   142,
+     143,   144,   145,   146,   114,   115,   116,   117,   118,   119,
+     230,   306,   307,   107,   182,   183,   236,   350,   352,   221,
+     312,   313,   314,   109,   110,   111,   112,   113,   114,   115,
+     116,   117,   118,   119,   299,   222,   223,   487,   184,   185,
+     186,   190,   231,   212,   191,   322,   323,   290,   224,   215,
+     324,   325,   326,   327,   328,   329,   330,   216,   237,   232,
+     498,   160,   332,   289,   316,   469,   293,   225,   356,   294,
+     295,   388,   296,   297,   140,   120,   140,   140,   298,   300,
+     301,   302,   335,   121,   336,   317,   318,   148,   319,   320,
+     321,   337,   288,   285,   333,   322,   323,   149,   150,   151,
+     324,   358,   326,   327,   359,   329,   330,   338,   339,   340,
+     371,   368,   332,   155,   156,   481,   157,   482,   483,   484,
+     354,   346,   122,   123,   357,   360,   347,   348,   361,   364,
+     367,   369,   389,   370,   396,   372,   373,   374,   377,   376,
+     378,   379,   382,   459,   460,   461,   462,   463,   464,   465,
+     466,   467,   468,   384,   383,   386,   387,   385,   322,   323,
+     167,   391,   392,  -270,  -270,   393,   395,   328,   329,   330,
+     397,   168,  -270,  -270,  -270,   332,   400,   401,     0,   169,
+     332,   332,   402,     0,   170,   171,   172,   173,   174,   175,
+     403,   176,   306,   307,   404,   405,   406,   308,   309,   310,
+     311,   312,   313,   314,   407,   408,   409,     0,   322,   323,
+     410,   411,   458,   324,   325,   326,   327,   328,   329,   330,
+     412,   413,   414,   331,   415,   332,   448,   449,   450,   451,
+     452,   453,   177,   455,   456,   457,   416,   417,   418,   419,
+     420,   421,   178,   422,   140,   140,   140,   140,   140,   140,
+     140,   140,   140,   140,   423,   470,   471,   472,   473,   474,
+     475,   476,   477,   478,   424,   479,   142,   143,   144,   145,
+     146,   114,   115,   116,   117,   118,   119,   306,   307,   425,
+     426,   427,   308,   309,   310,   311,   312,   313,   314,   428,
+     490,   491,   492,   493,   315,   429,   322,   323,   430,   431,
+     496,   324,   325,   326,   327,   328,   329,   330,   432,   433,
+     434,   334,   435,   332,   436,   437,   438,   502,   439,   504,
+     506,   440,   441,   442,   443,   444,   446,   447,   160,   511,
      142,   143,   144,   145,   146,   114,   115,   116,   117,   118,
-     119,   304,   305,     0,     0,     0,   306,   307,   308,   309,
-     310,   311,   312,     0,     0,   148,     0,     0,     0,     0,
-       0,   454,     0,   320,   321,   149,   150,   151,   322,   356,
-     324,   325,   357,   327,   328,     0,     0,     0,   497,     0,
-     330,   155,   156,     0,   157,     0,     0,     0,     0,     0,
+     119,   322,   323,   454,   485,   489,   324,   325,   326,   327,
+     328,   329,   330,   494,   148,   497,   355,   507,   332,   508,
+     522,   523,   322,   323,   149,   150,   151,   324,   358,   326,
+     327,   359,   329,   330,   524,   525,   526,   495,   530,   332,
+     155,   156,     0,   157,     0,     0,     0,     0,     0,     0,
        0,     0,   160,   142,   143,   144,   145,   146,   114,   115,
-     116,   117,   118,   119,   320,   321,     0,     0,     0,   322,
-     323,   324,   325,   326,   327,   328,     0,     0,   148,   329,
-       0,   330,     0,     0,     0,     0,   320,   321,   149,   150,
-     151,   322,   356,   324,   325,   357,   327,   328,     0,     0,
-       0,   499,     0,   330,   155,   156,     0,   157,     0,     0,
+     116,   117,   118,   119,   322,   323,     0,     0,     0,   324,
+     325,   326,   327,   328,   329,   330,     0,     0,   148,   365,
+       0,   332,     0,     0,     0,     0,   322,   323,   149,   150,
+     151,   324,   358,   326,   327,   359,   329,   330,     0,     0,
+       0,   501,     0,   332,   155,   156,     0,   157,     0,     0,
        0,     0,     0,     0,     0,   160,   142,   143,   144,   145,
-     146,   114,   115,   116,   117,   118,   119,   320,   321,     0,
-       0,     0,   322,   323,   324,   325,   326,   327,   328,     0,
-       0,   148,   332,     0,   330,     0,     0,     0,     0,   320,
-     321,   149,   150,   151,   322,   356,   324,   325,   357,   327,
-     328,     0,     0,     0,   501,     0,   330,   155,   156,     0,
+     146,   114,   115,   116,   117,   118,   119,   322,   323,     0,
+       0,     0,   324,   325,   326,   327,   328,   329,   330,     0,
+       0,   148,   375,     0,   332,     0,     0,     0,     0,   322,
+     323,   149,   150,   151,   324,   358,   326,   327,   359,   329,
+     330,     0,     0,     0,   503,     0,   332,   155,   156,     0,
      157,     0,     0,     0,     0,     0,     0,     0,   160,   142,
      143,   144,   145,   146,   114,   115,   116,   117,   118,   119,
-     320,   321,     0,     0,     0,   322,   323,   324,   325,   326,
-     327,   328,     0,     0,   148,   353,     0,   330,     0,     0,
-       0,     0,   320,   321,   149,   150,   151,   322,   356,   324,
-     325,   357,   327,   328,     0,     0,     0,   197,     0,   330,
-     155,   156,     0,   157,     0,     0,     0,     0,   198,     0,
-       0,   160,     0,     0,     0,     0,     0,     0,   199,   200,
-     142,   143,   144,   145,   146,   114,   115,   116,   117,   118,
-     119,     0,     0,     0,     0,   320,   321,   148,     0,     0,
-     322,   323,   324,   325,   326,   327,   328,   149,   150,   151,
-     363,   152,   330,     0,   153,     0,     0,     0,     0,     0,
-     201,     0,     0,   155,   156,     0,   157,   187,   142,   143,
-     144,   145,   146,   114,   115,   116,   117,   118,   119,     0,
-       0,     0,   160,     0,     0,     0,     0,     0,   142,   143,
-     144,   145,   146,   114,   115,   116,   117,   118,   119,     0,
-       0,     0,     0,     0,     0,     0,   320,   321,   148,     0,
-       0,   322,   323,   324,   325,   326,   327,   328,   149,   150,
-     151,   373,   152,   330,     0,   153,     0,     0,     0,     0,
-     147,   188,     0,     0,   155,   156,     0,   157,   142,   143,
-     144,   145,   146,   114,   115,   116,   117,   118,   119,     0,
-     160,     0,     0,     0,   320,   321,   148,     0,     0,   322,
-     323,   324,   325,   326,   327,   328,   149,   150,   151,   378,
-     152,   330,     0,   153,     0,     0,   148,     0,     0,   154,
-       0,     0,   155,   156,     0,   157,   149,   150,   151,     0,
-     152,     0,     0,   161,     0,     0,     0,     0,     0,   162,
-     160,     0,   155,   156,     0,   157,   142,   143,   144,   145,
-     146,   114,   115,   116,   117,   118,   119,     0,     0,     0,
-       0,     0,     0,     0,   320,   321,   148,     0,     0,   322,
-     323,   324,   325,   326,   327,   328,   149,   150,   151,   379,
-     152,   330,     0,   153,     0,     0,     0,     0,     0,   225,
-       0,     0,   155,   156,     0,   157,   142,   143,   144,   145,
-     146,   114,   115,   116,   117,   118,   119,     0,   160,     0,
-       0,     0,     0,     0,     0,     0,   142,   143,   144,   145,
-     146,   114,   115,   116,   117,   118,   119,     0,     0,     0,
-       0,     0,   320,   321,   148,     0,     0,   322,   323,   324,
-     325,   326,   327,   328,   149,   150,   151,   386,   152,   330,
-       0,   153,     0,     0,     0,     0,     0,   351,   160,     0,
-     155,   156,     0,   157,   142,   143,   144,   145,   146,   114,
-     115,   116,   117,   118,   119,     0,     0,     0,   160,     0,
-       0,     0,   320,   321,   148,     0,     0,   322,   323,   324,
-     325,   326,   327,   328,   149,   150,   151,   394,   152,   330,
-       0,   153,     0,     0,   148,     0,     0,   364,     0,     0,
-     155,   156,     0,   157,   149,   150,   151,     0,   152,     0,
-       0,   153,     0,     0,     0,     0,   160,   390,     0,     0,
-     155,   156,     0,   157,   142,   143,   144,   145,   146,   114,
-     115,   116,   117,   118,   119,     0,     0,     0,     0,     0,
-     320,   321,   148,     0,     0,   322,   323,   324,   325,   326,
-     327,   328,   149,   150,   151,   395,   152,   330,     0,   153,
-       0,     0,     0,     0,     0,   504,     0,     0,   155,   156,
-       0,   157,   126,   127,   128,   129,   130,   114,   115,   116,
-     117,   118,   119,     0,     0,     0,   160,     0,     0,     0,
-     126,   127,   128,   129,   130,   114,   115,   116,   117,   118,
-     119,   109,   110,   111,   112,   113,   114,   115,   116,   117,
-     118,   119,   148,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,   149,   150,   151,     0,   152,     0,     0,   153,
-       0,     0,     0,     0,   131,     0,     0,     0,   155,   156,
-       0,   157,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,   131,   120,     0,     0,     0,     0,   320,   321,
-     132,   121,     0,   322,   323,   324,   325,   326,   327,   328,
-     133,   134,   135,   441,   136,   330,     0,     0,   132,     0,
-       0,     0,     0,   137,     0,     0,   138,   139,   133,   134,
-     135,     0,   136,     0,     0,     0,     0,     0,     0,     0,
-     122,   123,     0,     0,   138,   139,     1,     2,     3,     4,
-       0,     5,     6,     7,     8,     9,    10,    11,    12,    13,
-      14,    15,     0,    16,    17,    18,    19,     0,     0,     0,
-       0,     0,     0,     0,     0,    20,    21,    22,    23,     0,
-       0,    24,    25,    26,     0,    27,     0,    28,     0,     0,
-      29,     0,    30,    31,     0,     0,    32,    33,    34,    35,
-      36,     0,     0,    37,    38,    39,    40,    41,    42,    43,
-      44,     0,     0,    45,    46,     0,    47,     0,    48,    49,
-       0,    50,    51,    52,     0,     0,     0,   238,   239,   240,
-     241,     0,   242,   243,   244,   245,   246,   247,   248,   249,
-     250,    14,    15,    53,   251,   252,   253,   254,     0,     0,
-       0,     0,     0,     0,     0,     0,   255,   256,   257,   258,
-     320,   321,   259,   260,   261,   322,   323,   324,   325,   326,
-     327,   328,     0,   262,   263,   484,     0,   330,   264,   265,
-     266,   267,     0,     0,   268,   269,   270,   271,   272,   273,
-     274,   275,     0,     0,   276,   277,     0,   278,     0,     0,
-     320,   321,   279,   280,   281,   322,   323,   324,   325,   326,
-     327,   328,     0,     0,     0,   495,     0,   330,     0,     0,
-     320,   321,     0,     0,   282,   322,   323,   324,   325,   326,
-     327,   328,     0,   320,   321,   496,     0,   330,   322,   323,
-     324,   325,   326,   327,   328,     0,   320,   321,   503,     0,
-     330,   322,   323,   324,   325,   326,   327,   328,     0,   320,
-     321,   506,     0,   330,   322,   323,   324,   325,   326,   327,
-     328,     0,   320,   321,   507,     0,   330,   322,   323,   324,
-     325,   326,   327,   328,     0,   320,   321,   508,     0,   330,
-     322,   323,   324,   325,   326,   327,   328,     0,   320,   321,
-     509,     0,   330,   322,   323,   324,   325,   326,   327,   328,
-       0,   320,   321,   510,     0,   330,   322,   323,   324,   325,
-     326,   327,   328,     0,   320,   321,   511,     0,   330,   322,
-     323,   324,   325,   326,   327,   328,     0,   320,   321,   512,
-       0,   330,   322,   323,   324,   325,   326,   327,   328,     0,
-     320,   321,   513,     0,   330,   322,   323,   324,   325,   326,
-     327,   328,     0,   320,   321,   514,     0,   330,   322,   323,
-     324,   325,   326,   327,   328,     0,   320,   321,   521,     0,
-     330,   322,   323,   324,   325,   326,   327,   328,     0,   320,
-     321,   522,     0,   330,   322,   323,   324,   325,   326,   327,
-     328,     0,   320,   321,   523,     0,   330,   322,   323,   324,
-     325,   326,   327,   328,     0,   320,   321,   525,     0,   330,
-     322,   323,   324,   325,   326,   327,   328,     0,   320,   321,
-     526,     0,   330,   322,   323,   324,   325,   326,   327,   328,
-       0,   320,   321,   527,     0,   330,   322,   323,   324,   325,
-     326,   327,   328,     0,   304,   305,   528,     0,   330,   306,
-     307,   308,   309,   310,   311,   312,     0,   320,   321,     0,
-       0,   313,   322,   323,   324,   325,   326,   327,   328,     0,
-     304,   305,     0,     0,   330,   306,   307,   308,   309,   310,
-     311,   312,     0,     0,     0,   515
+     322,   323,     0,     0,     0,   324,   325,   326,   327,   328,
+     329,   330,     0,     0,   148,   380,     0,   332,     0,     0,
+       0,     0,   322,   323,   149,   150,   151,   324,   358,   326,
+     327,   359,   329,   330,     0,     0,     0,   505,     0,   332,
+     155,   156,     0,   157,     0,     0,     0,     0,     0,     0,
+       0,   160,   142,   143,   144,   145,   146,   114,   115,   116,
+     117,   118,   119,   322,   323,     0,     0,     0,   324,   325,
+     326,   327,   328,   329,   330,     0,     0,   148,   381,     0,
+     332,     0,     0,     0,     0,   322,   323,   149,   150,   151,
+     324,   358,   326,   327,   359,   329,   330,     0,     0,     0,
+     197,     0,   332,   155,   156,     0,   157,     0,     0,     0,
+       0,   198,     0,     0,   160,     0,     0,     0,     0,     0,
+       0,   199,   200,   142,   143,   144,   145,   146,   114,   115,
+     116,   117,   118,   119,     0,     0,     0,     0,   322,   323,
+     148,     0,     0,   324,   325,   326,   327,   328,   329,   330,
+     149,   150,   151,   390,   152,   332,     0,   153,     0,     0,
+       0,     0,     0,   201,     0,     0,   155,   156,     0,   157,
+     187,   142,   143,   144,   145,   146,   114,   115,   116,   117,
+     118,   119,     0,     0,     0,   160,     0,     0,     0,     0,
+       0,   142,   143,   144,   145,   146,   114,   115,   116,   117,
+     118,   119,     0,     0,     0,     0,     0,     0,     0,   322,
+     323,   148,     0,     0,   324,   325,   326,   327,   328,   329,
+     330,   149,   150,   151,   398,   152,   332,     0,   153,     0,
+       0,     0,     0,   160,   188,     0,     0,   155,   156,     0,
+     157,   142,   143,   144,   145,   146,   114,   115,   116,   117,
+     118,   119,     0,   147,     0,     0,     0,     0,     0,   148,
+       0,     0,     0,   226,     0,     0,     0,     0,     0,   149,
+     150,   151,     0,   152,     0,     0,   153,     0,     0,   148,
+       0,     0,   227,     0,     0,   155,   156,     0,   157,   149,
+     150,   151,     0,   152,     0,     0,   153,     0,     0,     0,
+       0,     0,   154,   160,     0,   155,   156,     0,   157,   142,
+     143,   144,   145,   146,   114,   115,   116,   117,   118,   119,
+       0,     0,     0,     0,     0,     0,     0,   322,   323,   148,
+       0,     0,   324,   325,   326,   327,   328,   329,   330,   149,
+     150,   151,   399,   152,   332,     0,   161,     0,     0,     0,
+       0,     0,   162,     0,     0,   155,   156,     0,   157,   142,
+     143,   144,   145,   146,   114,   115,   116,   117,   118,   119,
+       0,   160,     0,     0,     0,     0,     0,     0,     0,   142,
+     143,   144,   145,   146,   114,   115,   116,   117,   118,   119,
+       0,     0,     0,     0,     0,   322,   323,   148,     0,     0,
+     324,   325,   326,   327,   328,   329,   330,   149,   150,   151,
+     445,   152,   332,     0,   153,     0,     0,     0,     0,     0,
+     353,   160,     0,   155,   156,     0,   157,   142,   143,   144,
+     145,   146,   114,   115,   116,   117,   118,   119,     0,     0,
+       0,   160,     0,     0,     0,   322,   323,   148,     0,     0,
+     324,   325,   326,   327,   328,   329,   330,   149,   150,   151,
+     488,   152,   332,     0,   153,     0,     0,   148,     0,     0,
+     366,     0,     0,   155,   156,     0,   157,   149,   150,   151,
+       0,   152,     0,     0,   153,     0,     0,     0,     0,   160,
+     394,     0,     0,   155,   156,     0,   157,   142,   143,   144,
+     145,   146,   114,   115,   116,   117,   118,   119,     0,     0,
+       0,     0,     0,   322,   323,   148,     0,     0,   324,   325,
+     326,   327,   328,   329,   330,   149,   150,   151,   499,   152,
+     332,     0,   153,     0,     0,     0,     0,     0,   510,     0,
+       0,   155,   156,     0,   157,   126,   127,   128,   129,   130,
+     114,   115,   116,   117,   118,   119,     0,     0,     0,   160,
+       0,     0,     0,   126,   127,   128,   129,   130,   114,   115,
+     116,   117,   118,   119,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,   322,   323,   148,     0,     0,   324,   325,
+     326,   327,   328,   329,   330,   149,   150,   151,   500,   152,
+     332,     0,   153,     0,     0,     0,     0,   131,     0,     0,
+       0,   155,   156,     0,   157,     0,     0,     0,     0,     0,
+       0,   322,   323,     0,     0,   131,   324,   325,   326,   327,
+     328,   329,   330,   132,     0,     0,   509,     0,   332,     0,
+       0,     0,     0,   133,   134,   135,     0,   136,     0,     0,
+       0,   132,     0,     0,     0,     0,   137,     0,     0,   138,
+     139,   133,   134,   135,   287,   136,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   138,   139,     0,
+       0,     1,     2,     3,     4,     0,     5,     6,     7,     8,
+       9,    10,    11,    12,    13,    14,    15,     0,    16,    17,
+      18,    19,     0,     0,     0,     0,     0,     0,     0,     0,
+      20,    21,    22,    23,     0,     0,    24,    25,    26,     0,
+      27,     0,    28,     0,     0,    29,     0,    30,    31,     0,
+       0,    32,    33,    34,    35,    36,     0,     0,    37,    38,
+      39,    40,    41,    42,    43,    44,     0,     0,    45,    46,
+       0,    47,     0,    48,    49,     0,    50,    51,    52,     0,
+       0,     0,     1,     2,     3,     4,     0,     5,     6,     7,
+       8,     9,    10,    11,    12,    13,    14,    15,    53,    16,
+      17,    18,    19,     0,     0,     0,     0,     0,     0,     0,
+       0,    20,    21,    22,    23,     0,     0,    24,    25,    26,
+       0,    27,     0,    28,     0,     0,    29,     0,    30,    31,
+       0,     0,    32,    33,    34,    35,    36,     0,     0,    37,
+      38,    39,    40,    41,    42,    43,    44,     0,     0,    45,
+      46,     0,    47,     0,    48,    49,     0,    50,    51,    52,
+       0,     0,     0,   240,   241,   242,   243,     0,   244,   245,
+     246,   247,   248,   249,   250,   251,   252,    14,    15,    53,
+     253,   254,   255,   256,     0,     0,     0,     0,     0,     0,
+       0,     0,   257,   258,   259,   260,   322,   323,   261,   262,
+     263,   324,   325,   326,   327,   328,   329,   330,     0,   264,
+     265,   512,     0,   332,   266,   267,   268,   269,     0,     0,
+     270,   271,   272,   273,   274,   275,   276,   277,     0,     0,
+     278,   279,     0,   280,     0,     0,   322,   323,   281,   282,
+     283,   324,   325,   326,   327,   328,   329,   330,     0,     0,
+       0,   513,     0,   332,     0,     0,   322,   323,     0,     0,
+     284,   324,   325,   326,   327,   328,   329,   330,     0,   322,
+     323,   514,     0,   332,   324,   325,   326,   327,   328,   329,
+     330,     0,   322,   323,   515,     0,   332,   324,   325,   326,
+     327,   328,   329,   330,     0,   322,   323,   516,     0,   332,
+     324,   325,   326,   327,   328,   329,   330,     0,   322,   323,
+     517,     0,   332,   324,   325,   326,   327,   328,   329,   330,
+       0,   322,   323,   518,     0,   332,   324,   325,   326,   327,
+     328,   329,   330,     0,   322,   323,   519,     0,   332,   324,
+     325,   326,   327,   328,   329,   330,     0,   322,   323,   520,
+       0,   332,   324,   325,   326,   327,   328,   329,   330,     0,
+     322,   323,   527,     0,   332,   324,   325,   326,   327,   328,
+     329,   330,     0,   322,   323,   528,     0,   332,   324,   325,
+     326,   327,   328,   329,   330,     0,   322,   323,   529,     0,
+     332,   324,   325,   326,   327,   328,   329,   330,     0,   322,
+     323,   531,     0,   332,   324,   325,   326,   327,   328,   329,
+     330,     0,   322,   323,   532,     0,   332,   324,   325,   326,
+     327,   328,   329,   330,     0,   322,   323,   533,     0,   332,
+     324,   325,   326,   327,   328,   329,   330,     0,   322,   323,
+     534,     0,   332,   324,   325,   326,   327,   328,   329,   330,
+       0,   306,   307,     0,     0,   332,   308,   309,   310,   311,
+     312,   313,   314,     0,     0,     0,   521
 };
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-167)))
-
-#define yytable_value_is_error(Yytable_value) \
-  YYID (0)
-
 static const yytype_int16 yycheck[] =
 {
        7,     8,     4,    44,     6,   171,   172,   173,    35,    36,
-      66,    91,   114,    65,   116,    65,    23,    91,    65,    26,
-      65,    65,    29,    30,   114,    32,    33,    59,    60,     0,
-      16,    38,    39,   136,   114,   138,   139,    44,    88,   114,
-     114,    97,    49,    50,   114,    52,    17,    18,    19,    20,
-      91,    22,    23,    24,    25,    26,    27,    28,    29,    30,
-      31,    32,   114,    34,    35,    36,    37,   114,    91,   114,
-     114,    15,    16,   114,    91,    46,    47,    48,    49,    65,
-      91,    52,    53,    54,   114,    56,    91,    58,   114,   114,
-      61,   114,    63,    64,   121,   114,    67,    68,    69,    70,
-      71,   114,   114,    74,    75,    76,    77,    78,    79,    80,
-      81,    97,    65,    84,    85,   114,    87,    17,    89,    90,
-     114,    92,    93,    94,    65,    57,   114,   114,   114,    99,
-     100,    31,   114,   114,   136,   114,   138,   139,   108,   109,
-     110,    91,   115,   114,    65,   152,   153,   115,   155,   156,
-     157,   115,   115,   115,   161,     3,     4,     5,     6,     7,
-       8,     9,    10,    11,    12,    13,    66,   115,   115,   115,
-     115,   198,   114,   339,   114,   341,   342,   343,   114,   114,
-     187,   114,    82,    83,   191,   192,   114,   114,   114,   114,
-     197,   114,   114,    65,   114,   202,   114,   116,   115,   206,
-     114,   304,   305,   306,   307,   308,   309,   310,   311,   312,
-     313,   114,   114,   220,   114,   222,   223,    65,   114,   114,
-      99,   100,   114,   114,   231,   104,   105,   106,   107,   108,
-     109,   110,   114,   114,   114,    91,   114,   116,   114,   114,
-     119,   114,    54,    91,   114,   114,   114,   114,   114,   114,
-     114,    99,   100,   101,   102,   103,   104,   105,   106,   107,
-     108,   109,   110,   114,    99,   100,   114,   114,   116,   117,
-     118,   114,   120,   108,   109,   110,   114,   114,   114,    -1,
-     114,   116,   114,   114,   291,   292,   293,   294,   295,   296,
-     114,   298,   299,   300,   114,   114,   114,   114,   114,   114,
-     114,   114,   304,   305,   306,   307,   308,   309,   310,   311,
-     312,   313,   114,   320,   321,   322,   323,   324,   325,   326,
-     327,   328,   114,   330,     3,     4,     5,     6,     7,     8,
-       9,    10,    11,    12,    13,   114,    14,   114,   114,   114,
-     114,   114,   114,   114,   114,   114,   114,    25,   355,   356,
-     357,   358,   114,   114,   114,    33,   114,   114,   365,   114,
-      38,    39,    40,    41,    42,    43,   114,    45,   114,   114,
-     114,   114,   114,   114,   114,   382,   114,   384,   385,   114,
-     114,   114,    51,    -1,    -1,   392,    65,     3,     4,     5,
-       6,     7,     8,     9,    10,    11,    12,    13,    -1,    -1,
-      99,   100,    -1,    -1,    -1,    -1,    -1,    -1,    86,   108,
-     109,   110,    91,    -1,    -1,    -1,    -1,   116,    96,    -1,
-      99,   100,   101,   102,   103,   104,   105,   106,   107,   108,
-     109,   110,    -1,    -1,    -1,   114,    -1,   116,   117,   118,
-      -1,   120,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    65,
+      66,    91,   114,   114,   116,    65,    23,    91,   114,    26,
+     114,    16,    29,    30,    91,    32,    33,    65,    65,    65,
+      17,    38,    39,   136,   114,   138,   139,    44,    88,    91,
+     114,    97,    49,    50,    31,    52,    91,   114,    65,    91,
+      91,    59,    60,    15,    16,   114,   114,   114,    57,     3,
+       4,     5,     6,     7,     8,     9,    10,    11,    12,    13,
+      65,    99,   100,   114,   114,   114,   114,   114,   114,    66,
+     108,   109,   110,     3,     4,     5,     6,     7,     8,     9,
+      10,    11,    12,    13,   121,    82,    83,   114,   114,   114,
+     114,    65,    97,   114,    65,    99,   100,    91,    95,   114,
+     104,   105,   106,   107,   108,   109,   110,   114,   114,   114,
+      91,    65,   116,   114,   114,   119,   115,   114,    65,   115,
+     115,    65,   115,   115,   136,    55,   138,   139,   115,   115,
+     115,   115,   114,    63,   114,   152,   153,    91,   155,   156,
+     157,   114,    54,    51,   161,    99,   100,   101,   102,   103,
+     104,   105,   106,   107,   108,   109,   110,   114,   114,   114,
+     114,   198,   116,   117,   118,   341,   120,   343,   344,   345,
+     187,   114,   102,   103,   191,   192,   114,   114,   114,   114,
+     197,   114,    65,   115,    65,   202,   114,   114,   114,   206,
+     114,   114,   114,   306,   307,   308,   309,   310,   311,   312,
+     313,   314,   315,   220,   114,   222,   223,   114,    99,   100,
+      14,   114,   114,    99,   100,   114,   233,   108,   109,   110,
+     114,    25,   108,   109,   110,   116,   114,   114,    -1,    33,
+     116,   116,   114,    -1,    38,    39,    40,    41,    42,    43,
+     114,    45,    99,   100,   114,   114,   114,   104,   105,   106,
+     107,   108,   109,   110,   114,   114,   114,    -1,    99,   100,
+     114,   114,   119,   104,   105,   106,   107,   108,   109,   110,
+     114,   114,   114,   114,   114,   116,   293,   294,   295,   296,
+     297,   298,    86,   300,   301,   302,   114,   114,   114,   114,
+     114,   114,    96,   114,   306,   307,   308,   309,   310,   311,
+     312,   313,   314,   315,   114,   322,   323,   324,   325,   326,
+     327,   328,   329,   330,   114,   332,     3,     4,     5,     6,
+       7,     8,     9,    10,    11,    12,    13,    99,   100,   114,
+     114,   114,   104,   105,   106,   107,   108,   109,   110,   114,
+     357,   358,   359,   360,   116,   114,    99,   100,   114,   114,
+     367,   104,   105,   106,   107,   108,   109,   110,   114,   114,
+     114,   114,   114,   116,   114,   114,   114,   384,   114,   386,
+     387,   114,   114,   114,   114,   114,   114,   114,    65,   396,
        3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
-      13,    99,   100,    -1,    -1,    -1,   104,   105,   106,   107,
-     108,   109,   110,    -1,    -1,    91,    -1,    -1,    -1,    -1,
-      -1,   119,    -1,    99,   100,   101,   102,   103,   104,   105,
-     106,   107,   108,   109,   110,    -1,    -1,    -1,   114,    -1,
-     116,   117,   118,    -1,   120,    -1,    -1,    -1,    -1,    -1,
+      13,    99,   100,   114,   114,   114,   104,   105,   106,   107,
+     108,   109,   110,   114,    91,   114,   114,   114,   116,   114,
+     114,   114,    99,   100,   101,   102,   103,   104,   105,   106,
+     107,   108,   109,   110,   114,   114,   114,   114,   114,   116,
+     117,   118,    -1,   120,    -1,    -1,    -1,    -1,    -1,    -1,
       -1,    -1,    65,     3,     4,     5,     6,     7,     8,     9,
       10,    11,    12,    13,    99,   100,    -1,    -1,    -1,   104,
      105,   106,   107,   108,   109,   110,    -1,    -1,    91,   114,
@@ -1370,86 +1446,98 @@ static const yytype_int16 yycheck[] =
       99,   100,    -1,    -1,    -1,   104,   105,   106,   107,   108,
      109,   110,    -1,    -1,    91,   114,    -1,   116,    -1,    -1,
       -1,    -1,    99,   100,   101,   102,   103,   104,   105,   106,
-     107,   108,   109,   110,    -1,    -1,    -1,    51,    -1,   116,
-     117,   118,    -1,   120,    -1,    -1,    -1,    -1,    62,    -1,
-      -1,    65,    -1,    -1,    -1,    -1,    -1,    -1,    72,    73,
-       3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
-      13,    -1,    -1,    -1,    -1,    99,   100,    91,    -1,    -1,
+     107,   108,   109,   110,    -1,    -1,    -1,   114,    -1,   116,
+     117,   118,    -1,   120,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    65,     3,     4,     5,     6,     7,     8,     9,    10,
+      11,    12,    13,    99,   100,    -1,    -1,    -1,   104,   105,
+     106,   107,   108,   109,   110,    -1,    -1,    91,   114,    -1,
+     116,    -1,    -1,    -1,    -1,    99,   100,   101,   102,   103,
+     104,   105,   106,   107,   108,   109,   110,    -1,    -1,    -1,
+      51,    -1,   116,   117,   118,    -1,   120,    -1,    -1,    -1,
+      -1,    62,    -1,    -1,    65,    -1,    -1,    -1,    -1,    -1,
+      -1,    72,    73,     3,     4,     5,     6,     7,     8,     9,
+      10,    11,    12,    13,    -1,    -1,    -1,    -1,    99,   100,
+      91,    -1,    -1,   104,   105,   106,   107,   108,   109,   110,
+     101,   102,   103,   114,   105,   116,    -1,   108,    -1,    -1,
+      -1,    -1,    -1,   114,    -1,    -1,   117,   118,    -1,   120,
+      50,     3,     4,     5,     6,     7,     8,     9,    10,    11,
+      12,    13,    -1,    -1,    -1,    65,    -1,    -1,    -1,    -1,
+      -1,     3,     4,     5,     6,     7,     8,     9,    10,    11,
+      12,    13,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    99,
+     100,    91,    -1,    -1,   104,   105,   106,   107,   108,   109,
+     110,   101,   102,   103,   114,   105,   116,    -1,   108,    -1,
+      -1,    -1,    -1,    65,   114,    -1,    -1,   117,   118,    -1,
+     120,     3,     4,     5,     6,     7,     8,     9,    10,    11,
+      12,    13,    -1,    65,    -1,    -1,    -1,    -1,    -1,    91,
+      -1,    -1,    -1,    95,    -1,    -1,    -1,    -1,    -1,   101,
+     102,   103,    -1,   105,    -1,    -1,   108,    -1,    -1,    91,
+      -1,    -1,   114,    -1,    -1,   117,   118,    -1,   120,   101,
+     102,   103,    -1,   105,    -1,    -1,   108,    -1,    -1,    -1,
+      -1,    -1,   114,    65,    -1,   117,   118,    -1,   120,     3,
+       4,     5,     6,     7,     8,     9,    10,    11,    12,    13,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    99,   100,    91,
+      -1,    -1,   104,   105,   106,   107,   108,   109,   110,   101,
+     102,   103,   114,   105,   116,    -1,   108,    -1,    -1,    -1,
+      -1,    -1,   114,    -1,    -1,   117,   118,    -1,   120,     3,
+       4,     5,     6,     7,     8,     9,    10,    11,    12,    13,
+      -1,    65,    -1,    -1,    -1,    -1,    -1,    -1,    -1,     3,
+       4,     5,     6,     7,     8,     9,    10,    11,    12,    13,
+      -1,    -1,    -1,    -1,    -1,    99,   100,    91,    -1,    -1,
      104,   105,   106,   107,   108,   109,   110,   101,   102,   103,
      114,   105,   116,    -1,   108,    -1,    -1,    -1,    -1,    -1,
-     114,    -1,    -1,   117,   118,    -1,   120,    50,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,    13,    -1,
-      -1,    -1,    65,    -1,    -1,    -1,    -1,    -1,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,    13,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    99,   100,    91,    -1,
-      -1,   104,   105,   106,   107,   108,   109,   110,   101,   102,
-     103,   114,   105,   116,    -1,   108,    -1,    -1,    -1,    -1,
-      65,   114,    -1,    -1,   117,   118,    -1,   120,     3,     4,
-       5,     6,     7,     8,     9,    10,    11,    12,    13,    -1,
-      65,    -1,    -1,    -1,    99,   100,    91,    -1,    -1,   104,
-     105,   106,   107,   108,   109,   110,   101,   102,   103,   114,
-     105,   116,    -1,   108,    -1,    -1,    91,    -1,    -1,   114,
-      -1,    -1,   117,   118,    -1,   120,   101,   102,   103,    -1,
-     105,    -1,    -1,   108,    -1,    -1,    -1,    -1,    -1,   114,
-      65,    -1,   117,   118,    -1,   120,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,    13,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    99,   100,    91,    -1,    -1,   104,
-     105,   106,   107,   108,   109,   110,   101,   102,   103,   114,
-     105,   116,    -1,   108,    -1,    -1,    -1,    -1,    -1,   114,
-      -1,    -1,   117,   118,    -1,   120,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,    13,    -1,    65,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,    13,    -1,    -1,    -1,
-      -1,    -1,    99,   100,    91,    -1,    -1,   104,   105,   106,
-     107,   108,   109,   110,   101,   102,   103,   114,   105,   116,
-      -1,   108,    -1,    -1,    -1,    -1,    -1,   114,    65,    -1,
-     117,   118,    -1,   120,     3,     4,     5,     6,     7,     8,
-       9,    10,    11,    12,    13,    -1,    -1,    -1,    65,    -1,
-      -1,    -1,    99,   100,    91,    -1,    -1,   104,   105,   106,
-     107,   108,   109,   110,   101,   102,   103,   114,   105,   116,
-      -1,   108,    -1,    -1,    91,    -1,    -1,   114,    -1,    -1,
-     117,   118,    -1,   120,   101,   102,   103,    -1,   105,    -1,
-      -1,   108,    -1,    -1,    -1,    -1,    65,   114,    -1,    -1,
-     117,   118,    -1,   120,     3,     4,     5,     6,     7,     8,
-       9,    10,    11,    12,    13,    -1,    -1,    -1,    -1,    -1,
-      99,   100,    91,    -1,    -1,   104,   105,   106,   107,   108,
-     109,   110,   101,   102,   103,   114,   105,   116,    -1,   108,
-      -1,    -1,    -1,    -1,    -1,   114,    -1,    -1,   117,   118,
-      -1,   120,     3,     4,     5,     6,     7,     8,     9,    10,
-      11,    12,    13,    -1,    -1,    -1,    65,    -1,    -1,    -1,
-       3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
-      13,     3,     4,     5,     6,     7,     8,     9,    10,    11,
-      12,    13,    91,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,   101,   102,   103,    -1,   105,    -1,    -1,   108,
-      -1,    -1,    -1,    -1,    65,    -1,    -1,    -1,   117,   118,
-      -1,   120,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    65,    55,    -1,    -1,    -1,    -1,    99,   100,
-      91,    63,    -1,   104,   105,   106,   107,   108,   109,   110,
-     101,   102,   103,   114,   105,   116,    -1,    -1,    91,    -1,
-      -1,    -1,    -1,   114,    -1,    -1,   117,   118,   101,   102,
-     103,    -1,   105,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-     102,   103,    -1,    -1,   117,   118,    17,    18,    19,    20,
-      -1,    22,    23,    24,    25,    26,    27,    28,    29,    30,
-      31,    32,    -1,    34,    35,    36,    37,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    46,    47,    48,    49,    -1,
-      -1,    52,    53,    54,    -1,    56,    -1,    58,    -1,    -1,
-      61,    -1,    63,    64,    -1,    -1,    67,    68,    69,    70,
-      71,    -1,    -1,    74,    75,    76,    77,    78,    79,    80,
-      81,    -1,    -1,    84,    85,    -1,    87,    -1,    89,    90,
-      -1,    92,    93,    94,    -1,    -1,    -1,    17,    18,    19,
-      20,    -1,    22,    23,    24,    25,    26,    27,    28,    29,
-      30,    31,    32,   114,    34,    35,    36,    37,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    46,    47,    48,    49,
-      99,   100,    52,    53,    54,   104,   105,   106,   107,   108,
-     109,   110,    -1,    63,    64,   114,    -1,   116,    68,    69,
-      70,    71,    -1,    -1,    74,    75,    76,    77,    78,    79,
-      80,    81,    -1,    -1,    84,    85,    -1,    87,    -1,    -1,
-      99,   100,    92,    93,    94,   104,   105,   106,   107,   108,
-     109,   110,    -1,    -1,    -1,   114,    -1,   116,    -1,    -1,
-      99,   100,    -1,    -1,   114,   104,   105,   106,   107,   108,
-     109,   110,    -1,    99,   100,   114,    -1,   116,   104,   105,
-     106,   107,   108,   109,   110,    -1,    99,   100,   114,    -1,
-     116,   104,   105,   106,   107,   108,   109,   110,    -1,    99,
+     114,    65,    -1,   117,   118,    -1,   120,     3,     4,     5,
+       6,     7,     8,     9,    10,    11,    12,    13,    -1,    -1,
+      -1,    65,    -1,    -1,    -1,    99,   100,    91,    -1,    -1,
+     104,   105,   106,   107,   108,   109,   110,   101,   102,   103,
+     114,   105,   116,    -1,   108,    -1,    -1,    91,    -1,    -1,
+     114,    -1,    -1,   117,   118,    -1,   120,   101,   102,   103,
+      -1,   105,    -1,    -1,   108,    -1,    -1,    -1,    -1,    65,
+     114,    -1,    -1,   117,   118,    -1,   120,     3,     4,     5,
+       6,     7,     8,     9,    10,    11,    12,    13,    -1,    -1,
+      -1,    -1,    -1,    99,   100,    91,    -1,    -1,   104,   105,
+     106,   107,   108,   109,   110,   101,   102,   103,   114,   105,
+     116,    -1,   108,    -1,    -1,    -1,    -1,    -1,   114,    -1,
+      -1,   117,   118,    -1,   120,     3,     4,     5,     6,     7,
+       8,     9,    10,    11,    12,    13,    -1,    -1,    -1,    65,
+      -1,    -1,    -1,     3,     4,     5,     6,     7,     8,     9,
+      10,    11,    12,    13,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    99,   100,    91,    -1,    -1,   104,   105,
+     106,   107,   108,   109,   110,   101,   102,   103,   114,   105,
+     116,    -1,   108,    -1,    -1,    -1,    -1,    65,    -1,    -1,
+      -1,   117,   118,    -1,   120,    -1,    -1,    -1,    -1,    -1,
+      -1,    99,   100,    -1,    -1,    65,   104,   105,   106,   107,
+     108,   109,   110,    91,    -1,    -1,   114,    -1,   116,    -1,
+      -1,    -1,    -1,   101,   102,   103,    -1,   105,    -1,    -1,
+      -1,    91,    -1,    -1,    -1,    -1,   114,    -1,    -1,   117,
+     118,   101,   102,   103,     0,   105,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,   117,   118,    -1,
+      -1,    17,    18,    19,    20,    -1,    22,    23,    24,    25,
+      26,    27,    28,    29,    30,    31,    32,    -1,    34,    35,
+      36,    37,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      46,    47,    48,    49,    -1,    -1,    52,    53,    54,    -1,
+      56,    -1,    58,    -1,    -1,    61,    -1,    63,    64,    -1,
+      -1,    67,    68,    69,    70,    71,    -1,    -1,    74,    75,
+      76,    77,    78,    79,    80,    81,    -1,    -1,    84,    85,
+      -1,    87,    -1,    89,    90,    -1,    92,    93,    94,    -1,
+      -1,    -1,    17,    18,    19,    20,    -1,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,   114,    34,
+      35,    36,    37,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    46,    47,    48,    49,    -1,    -1,    52,    53,    54,
+      -1,    56,    -1,    58,    -1,    -1,    61,    -1,    63,    64,
+      -1,    -1,    67,    68,    69,    70,    71,    -1,    -1,    74,
+      75,    76,    77,    78,    79,    80,    81,    -1,    -1,    84,
+      85,    -1,    87,    -1,    89,    90,    -1,    92,    93,    94,
+      -1,    -1,    -1,    17,    18,    19,    20,    -1,    22,    23,
+      24,    25,    26,    27,    28,    29,    30,    31,    32,   114,
+      34,    35,    36,    37,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    46,    47,    48,    49,    99,   100,    52,    53,
+      54,   104,   105,   106,   107,   108,   109,   110,    -1,    63,
+      64,   114,    -1,   116,    68,    69,    70,    71,    -1,    -1,
+      74,    75,    76,    77,    78,    79,    80,    81,    -1,    -1,
+      84,    85,    -1,    87,    -1,    -1,    99,   100,    92,    93,
+      94,   104,   105,   106,   107,   108,   109,   110,    -1,    -1,
+      -1,   114,    -1,   116,    -1,    -1,    99,   100,    -1,    -1,
+     114,   104,   105,   106,   107,   108,   109,   110,    -1,    99,
      100,   114,    -1,   116,   104,   105,   106,   107,   108,   109,
      110,    -1,    99,   100,   114,    -1,   116,   104,   105,   106,
      107,   108,   109,   110,    -1,    99,   100,   114,    -1,   116,
@@ -1468,16 +1556,12 @@ static const yytype_int16 yycheck[] =
      107,   108,   109,   110,    -1,    99,   100,   114,    -1,   116,
      104,   105,   106,   107,   108,   109,   110,    -1,    99,   100,
      114,    -1,   116,   104,   105,   106,   107,   108,   109,   110,
-      -1,    99,   100,   114,    -1,   116,   104,   105,   106,   107,
-     108,   109,   110,    -1,    99,   100,   114,    -1,   116,   104,
-     105,   106,   107,   108,   109,   110,    -1,    99,   100,    -1,
-      -1,   116,   104,   105,   106,   107,   108,   109,   110,    -1,
-      99,   100,    -1,    -1,   116,   104,   105,   106,   107,   108,
-     109,   110,    -1,    -1,    -1,   114
+      -1,    99,   100,    -1,    -1,   116,   104,   105,   106,   107,
+     108,   109,   110,    -1,    -1,    -1,   114
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
        0,    17,    18,    19,    20,    22,    23,    24,    25,    26,
@@ -1502,100 +1586,141 @@ static const yytype_uint8 yystos[] =
       65,    65,   176,    57,    59,    60,   176,    51,    62,    72,
       73,   114,   176,    66,    97,   176,   176,    15,    16,   124,
      124,   124,   114,   176,   176,   114,   114,    91,   114,    17,
-      31,    66,    82,    83,   114,   114,   176,    16,    65,    97,
-     114,    65,    88,    65,   114,   114,   176,   176,    17,    18,
-      19,    20,    22,    23,    24,    25,    26,    27,    28,    29,
-      30,    34,    35,    36,    37,    46,    47,    48,    49,    52,
-      53,    54,    63,    64,    68,    69,    70,    71,    74,    75,
-      76,    77,    78,    79,    80,    81,    84,    85,    87,    92,
-      93,    94,   114,   125,   176,     0,   123,   114,    91,    91,
-     114,   115,   115,   115,   115,   115,   115,   124,   115,   115,
-     115,   175,   175,   175,    99,   100,   104,   105,   106,   107,
-     108,   109,   110,   116,   114,   176,   176,   176,   176,   176,
-      99,   100,   104,   105,   106,   107,   108,   109,   110,   114,
-     116,   176,   114,   114,   114,   114,   114,   114,   114,   150,
-     176,   150,   150,   150,   114,   114,   114,    65,   114,    65,
-     114,   114,   176,   114,    65,   176,   105,   108,   176,   114,
-      91,   114,   114,   114,   114,   176,   124,   114,   115,   114,
-     176,   114,   114,   114,   176,   114,   114,   114,   114,   114,
-     114,   114,   176,   114,   176,   176,   114,   114,   114,   114,
-     114,   176,    65,   114,   114,   114,   114,   114,   114,   114,
+      31,    66,    82,    83,    95,   114,    95,   114,   176,    16,
+      65,    97,   114,    65,    88,    65,   114,   114,   176,   176,
+      17,    18,    19,    20,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    34,    35,    36,    37,    46,    47,    48,
+      49,    52,    53,    54,    63,    64,    68,    69,    70,    71,
+      74,    75,    76,    77,    78,    79,    80,    81,    84,    85,
+      87,    92,    93,    94,   114,   125,   176,     0,   123,   114,
+      91,    91,   114,   115,   115,   115,   115,   115,   115,   124,
+     115,   115,   115,   175,   175,   175,    99,   100,   104,   105,
+     106,   107,   108,   109,   110,   116,   114,   176,   176,   176,
+     176,   176,    99,   100,   104,   105,   106,   107,   108,   109,
+     110,   114,   116,   176,   114,   114,   114,   114,   114,   114,
+     114,   150,   176,   150,   150,   150,   114,   114,   114,    65,
+     114,    65,   114,   114,   176,   114,    65,   176,   105,   108,
+     176,   114,    91,   114,   114,   114,   114,   176,   124,   114,
+     115,   114,   176,   114,   114,   114,   176,   114,   114,   114,
+     114,   114,   114,   114,   176,   114,   176,   176,    65,    65,
+     114,   114,   114,   114,   114,   176,    65,   114,   114,   114,
      114,   114,   114,   114,   114,   114,   114,   114,   114,   114,
      114,   114,   114,   114,   114,   114,   114,   114,   114,   114,
      114,   114,   114,   114,   114,   114,   114,   114,   114,   114,
      114,   114,   114,   114,   114,   114,   114,   114,   114,   114,
-     114,   114,   114,   114,   176,   176,   176,   176,   176,   176,
-     114,   176,   176,   176,   119,   175,   175,   175,   175,   175,
-     175,   175,   175,   175,   175,   119,   176,   176,   176,   176,
-     176,   176,   176,   176,   176,   176,   114,   150,   150,   150,
-     150,   114,    65,   114,   114,   114,   176,   176,   176,   176,
-     114,   114,   176,   114,    91,   114,   114,   114,   176,   114,
-     176,   114,   176,   114,   114,   176,   114,   114,   114,   114,
+     114,   114,   114,   114,   114,   114,   114,   114,   176,   176,
+     176,   176,   176,   176,   114,   176,   176,   176,   119,   175,
+     175,   175,   175,   175,   175,   175,   175,   175,   175,   119,
+     176,   176,   176,   176,   176,   176,   176,   176,   176,   176,
+     114,   150,   150,   150,   150,   114,    65,   114,   114,   114,
+     176,   176,   176,   176,   114,   114,   176,   114,    91,   114,
+     114,   114,   176,   114,   176,   114,   176,   114,   114,   114,
+     114,   176,   114,   114,   114,   114,   114,   114,   114,   114,
      114,   114,   114,   114,   114,   114,   114,   114,   114,   114,
-     114,   114,   114,   114,   114,   114,   114,   114,   114
+     114,   114,   114,   114,   114
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  However,
-   YYFAIL appears to be in use.  Nevertheless, it is formally deprecated
-   in Bison 2.4.2's NEWS entry, where a plan to phase it out is
-   discussed.  */
-
-#define YYFAIL		goto yyerrlab
-#if defined YYFAIL
-  /* This is here to suppress warnings from the GCC cpp's
-     -Wunused-macros.  Normally we don't worry about that warning, but
-     some users do, and we want to make it easy for users to remove
-     YYFAIL uses, which will produce warnings from Bison 2.5.  */
-#endif
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,   121,   122,   122,   123,   123,   123,   123,   123,   123,
+     123,   123,   123,   123,   123,   123,   123,   123,   123,   123,
+     123,   123,   123,   123,   123,   123,   123,   123,   123,   123,
+     123,   123,   123,   123,   123,   123,   123,   123,   123,   123,
+     123,   123,   123,   123,   123,   123,   123,   123,   123,   123,
+     123,   123,   123,   124,   124,   125,   125,   126,   126,   126,
+     126,   126,   126,   127,   127,   128,   129,   130,   130,   130,
+     130,   131,   132,   133,   134,   135,   136,   137,   137,   138,
+     138,   138,   138,   138,   138,   138,   138,   138,   138,   138,
+     138,   138,   139,   139,   139,   139,   140,   141,   142,   143,
+     143,   143,   143,   144,   145,   145,   145,   145,   145,   145,
+     145,   145,   145,   145,   146,   146,   146,   146,   146,   146,
+     146,   146,   147,   148,   148,   149,   149,   149,   149,   149,
+     149,   149,   149,   149,   149,   149,   149,   149,   149,   149,
+     150,   150,   151,   152,   153,   154,   155,   156,   157,   158,
+     159,   160,   161,   162,   163,   163,   163,   163,   164,   165,
+     166,   167,   168,   168,   168,   169,   169,   169,   169,   169,
+     169,   169,   169,   169,   170,   170,   171,   172,   173,   173,
+     173,   173,   173,   173,   173,   173,   173,   173,   173,   173,
+     173,   173,   173,   173,   173,   173,   173,   173,   173,   173,
+     173,   173,   173,   173,   173,   173,   173,   173,   173,   173,
+     173,   173,   173,   173,   173,   173,   173,   173,   173,   173,
+     173,   173,   173,   173,   174,   175,   175,   175,   175,   175,
+     175,   175,   175,   175,   175,   175,   175,   175,   175,   175,
+     175,   175,   175,   175,   175,   175,   175,   175,   176,   176,
+     176,   176,   176,   176,   176,   176,   176,   176,   176,   176,
+     176,   176,   176,   176,   176,   176,   176,   176,   176,   176,
+     176,   176,   176,   176
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     0,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     3,     3,     2,     2,     3,     3,     3,
+       2,     3,     3,     2,     3,     3,     3,     2,     3,     3,
+       3,     2,     4,     4,     4,     4,     5,     5,     5,     2,
+       3,     4,     3,     4,     4,     5,     2,     3,     2,     2,
+       3,     4,     4,     2,     4,     5,     5,     5,     5,     5,
+       5,     5,     5,     5,     2,     5,     2,     3,     3,     2,
+       3,     4,     2,     2,     3,     3,     3,     5,     5,     5,
+       5,     3,     3,     3,     3,     3,     4,     3,     4,     5,
+       0,     1,     2,     2,     2,     2,     2,     2,     2,     2,
+       3,     3,     3,     2,     4,     3,     3,     2,     4,     5,
+       5,     3,     3,     4,     3,     2,     3,     4,     3,     4,
+       5,     3,     4,     5,     3,     3,     3,     4,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     2,     3,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     2,     2,     3,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     2,
+       2,     2,     2,     3
+};
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-/* Error token number */
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -1605,78 +1730,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1684,16 +1789,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
 static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1704,63 +1801,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1776,358 +1866,77 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULL, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULL;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - Assume YYFAIL is not used.  It's too flawed to consider.  See
-       <http://lists.gnu.org/archive/html/bison-patches/2009-12/msg00024.html>
-       for details.  YYERROR is fine as it does not invoke this
-       function.
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULL, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
 
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
 
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
 
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
-
-#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END
-#endif
-#ifndef YY_INITIAL_VALUE
-# define YY_INITIAL_VALUE(Value) /* Nothing. */
-#endif
-
 /* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval YY_INITIAL_VALUE(yyval_default);
-
+YYSTYPE yylval;
 /* Number of syntax errors so far.  */
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -2135,102 +1944,107 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -2241,18 +2055,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -2280,15 +2105,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -2303,14 +2126,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -2323,1360 +2146,1377 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 52:
-/* Line 1787 of yacc.c  */
+  case 52: /* command: '\n'  */
 #line 192 "parser.y"
-    {
+      {
       }
+#line 2154 "y.tab.c"
     break;
 
-  case 54:
-/* Line 1787 of yacc.c  */
+  case 54: /* BX_TOKEN_TOGGLE_ON_OFF: BX_TOKEN_OFF  */
 #line 199 "parser.y"
-    { (yyval.bval)=(yyvsp[(1) - (1)].bval); }
+    { (yyval.bval)=(yyvsp[0].bval); }
+#line 2160 "y.tab.c"
     break;
 
-  case 56:
-/* Line 1787 of yacc.c  */
+  case 56: /* BX_TOKEN_REGISTERS: BX_TOKEN_REGS  */
 #line 205 "parser.y"
-    { (yyval.sval)=(yyvsp[(1) - (1)].sval); }
+    { (yyval.sval)=(yyvsp[0].sval); }
+#line 2166 "y.tab.c"
     break;
 
-  case 62:
-/* Line 1787 of yacc.c  */
+  case 62: /* BX_TOKEN_SEGREG: BX_TOKEN_GS  */
 #line 215 "parser.y"
-    { (yyval.uval)=(yyvsp[(1) - (1)].uval); }
+    { (yyval.uval)=(yyvsp[0].uval); }
+#line 2172 "y.tab.c"
     break;
 
-  case 63:
-/* Line 1787 of yacc.c  */
+  case 63: /* timebp_command: BX_TOKEN_TIMEBP expression '\n'  */
 #line 220 "parser.y"
-    {
-          bx_dbg_timebp_command(0, (yyvsp[(2) - (3)].uval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_timebp_command(0, (yyvsp[-1].uval));
+          free((yyvsp[-2].sval));
       }
+#line 2181 "y.tab.c"
     break;
 
-  case 64:
-/* Line 1787 of yacc.c  */
+  case 64: /* timebp_command: BX_TOKEN_TIMEBP_ABSOLUTE expression '\n'  */
 #line 225 "parser.y"
-    {
-          bx_dbg_timebp_command(1, (yyvsp[(2) - (3)].uval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_timebp_command(1, (yyvsp[-1].uval));
+          free((yyvsp[-2].sval));
       }
+#line 2190 "y.tab.c"
     break;
 
-  case 65:
-/* Line 1787 of yacc.c  */
+  case 65: /* modebp_command: BX_TOKEN_MODEBP '\n'  */
 #line 233 "parser.y"
-    {
+      {
           bx_dbg_modebp_command();
-          free((yyvsp[(1) - (2)].sval));
+          free((yyvsp[-1].sval));
       }
+#line 2199 "y.tab.c"
     break;
 
-  case 66:
-/* Line 1787 of yacc.c  */
+  case 66: /* vmexitbp_command: BX_TOKEN_VMEXITBP '\n'  */
 #line 241 "parser.y"
-    {
+      {
           bx_dbg_vmexitbp_command();
-          free((yyvsp[(1) - (2)].sval));
+          free((yyvsp[-1].sval));
       }
+#line 2208 "y.tab.c"
     break;
 
-  case 67:
-/* Line 1787 of yacc.c  */
+  case 67: /* show_command: BX_TOKEN_SHOW BX_TOKEN_COMMAND '\n'  */
 #line 249 "parser.y"
-    {
-          bx_dbg_show_command((yyvsp[(2) - (3)].sval));
-          free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+          bx_dbg_show_command((yyvsp[-1].sval));
+          free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2217 "y.tab.c"
     break;
 
-  case 68:
-/* Line 1787 of yacc.c  */
+  case 68: /* show_command: BX_TOKEN_SHOW BX_TOKEN_OFF '\n'  */
 #line 254 "parser.y"
-    {
+      {
           bx_dbg_show_command("off");
-          free((yyvsp[(1) - (3)].sval));
+          free((yyvsp[-2].sval));
       }
+#line 2226 "y.tab.c"
     break;
 
-  case 69:
-/* Line 1787 of yacc.c  */
+  case 69: /* show_command: BX_TOKEN_SHOW BX_TOKEN_STRING '\n'  */
 #line 259 "parser.y"
-    {
-          bx_dbg_show_param_command((yyvsp[(2) - (3)].sval));
-          free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+          bx_dbg_show_param_command((yyvsp[-1].sval));
+          free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2235 "y.tab.c"
     break;
 
-  case 70:
-/* Line 1787 of yacc.c  */
+  case 70: /* show_command: BX_TOKEN_SHOW '\n'  */
 #line 264 "parser.y"
-    {
+      {
           bx_dbg_show_command(0);
-          free((yyvsp[(1) - (2)].sval));
+          free((yyvsp[-1].sval));
       }
+#line 2244 "y.tab.c"
     break;
 
-  case 71:
-/* Line 1787 of yacc.c  */
+  case 71: /* page_command: BX_TOKEN_PAGE expression '\n'  */
 #line 272 "parser.y"
-    {
-          bx_dbg_xlate_address((yyvsp[(2) - (3)].uval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_xlate_address((yyvsp[-1].uval));
+          free((yyvsp[-2].sval));
       }
+#line 2253 "y.tab.c"
     break;
 
-  case 72:
-/* Line 1787 of yacc.c  */
+  case 72: /* tlb_command: BX_TOKEN_TLB expression '\n'  */
 #line 280 "parser.y"
-    {
-          bx_dbg_tlb_lookup((yyvsp[(2) - (3)].uval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_tlb_lookup((yyvsp[-1].uval));
+          free((yyvsp[-2].sval));
       }
+#line 2262 "y.tab.c"
     break;
 
-  case 73:
-/* Line 1787 of yacc.c  */
+  case 73: /* ptime_command: BX_TOKEN_PTIME '\n'  */
 #line 288 "parser.y"
-    {
+      {
           bx_dbg_ptime_command();
-          free((yyvsp[(1) - (2)].sval));
+          free((yyvsp[-1].sval));
       }
+#line 2271 "y.tab.c"
     break;
 
-  case 74:
-/* Line 1787 of yacc.c  */
+  case 74: /* trace_command: BX_TOKEN_TRACE BX_TOKEN_TOGGLE_ON_OFF '\n'  */
 #line 296 "parser.y"
-    {
-          bx_dbg_trace_command((yyvsp[(2) - (3)].bval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_trace_command((yyvsp[-1].bval));
+          free((yyvsp[-2].sval));
       }
+#line 2280 "y.tab.c"
     break;
 
-  case 75:
-/* Line 1787 of yacc.c  */
+  case 75: /* trace_reg_command: BX_TOKEN_TRACEREG BX_TOKEN_TOGGLE_ON_OFF '\n'  */
 #line 304 "parser.y"
-    {
-          bx_dbg_trace_reg_command((yyvsp[(2) - (3)].bval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_trace_reg_command((yyvsp[-1].bval));
+          free((yyvsp[-2].sval));
       }
+#line 2289 "y.tab.c"
     break;
 
-  case 76:
-/* Line 1787 of yacc.c  */
+  case 76: /* trace_mem_command: BX_TOKEN_TRACEMEM BX_TOKEN_TOGGLE_ON_OFF '\n'  */
 #line 312 "parser.y"
-    {
-          bx_dbg_trace_mem_command((yyvsp[(2) - (3)].bval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_trace_mem_command((yyvsp[-1].bval));
+          free((yyvsp[-2].sval));
       }
+#line 2298 "y.tab.c"
     break;
 
-  case 77:
-/* Line 1787 of yacc.c  */
+  case 77: /* print_stack_command: BX_TOKEN_PRINT_STACK '\n'  */
 #line 320 "parser.y"
-    {
+      {
           bx_dbg_print_stack_command(16);
-          free((yyvsp[(1) - (2)].sval));
+          free((yyvsp[-1].sval));
       }
+#line 2307 "y.tab.c"
     break;
 
-  case 78:
-/* Line 1787 of yacc.c  */
+  case 78: /* print_stack_command: BX_TOKEN_PRINT_STACK BX_TOKEN_NUMERIC '\n'  */
 #line 325 "parser.y"
-    {
-          bx_dbg_print_stack_command((yyvsp[(2) - (3)].uval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_print_stack_command((yyvsp[-1].uval));
+          free((yyvsp[-2].sval));
       }
+#line 2316 "y.tab.c"
     break;
 
-  case 79:
-/* Line 1787 of yacc.c  */
+  case 79: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_STOP '\n'  */
 #line 333 "parser.y"
-    {
+      {
           bx_dbg_watchpoint_continue(0);
-          free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+          free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2325 "y.tab.c"
     break;
 
-  case 80:
-/* Line 1787 of yacc.c  */
+  case 80: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_CONTINUE '\n'  */
 #line 338 "parser.y"
-    {
+      {
           bx_dbg_watchpoint_continue(1);
-          free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+          free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2334 "y.tab.c"
     break;
 
-  case 81:
-/* Line 1787 of yacc.c  */
+  case 81: /* watch_point_command: BX_TOKEN_WATCH '\n'  */
 #line 343 "parser.y"
-    {
+      {
           bx_dbg_print_watchpoints();
-          free((yyvsp[(1) - (2)].sval));
+          free((yyvsp[-1].sval));
       }
+#line 2343 "y.tab.c"
     break;
 
-  case 82:
-/* Line 1787 of yacc.c  */
+  case 82: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_VGA BX_TOKEN_STRING '\n'  */
 #line 348 "parser.y"
-    {
-          bx_dbg_watch(0, (yyvsp[(3) - (4)].uval), 1); /* BX_READ */
-          free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+      {
+          bx_dbg_text_watch((yyvsp[-1].sval));
+          free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2352 "y.tab.c"
     break;
 
-  case 83:
-/* Line 1787 of yacc.c  */
+  case 83: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_R expression '\n'  */
 #line 353 "parser.y"
-    {
-          bx_dbg_watch(0, (yyvsp[(3) - (4)].uval), 1); /* BX_READ */
-          free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+      {
+          bx_dbg_watch(0, (yyvsp[-1].uval), 1); /* BX_READ */
+          free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 2361 "y.tab.c"
     break;
 
-  case 84:
-/* Line 1787 of yacc.c  */
+  case 84: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_READ expression '\n'  */
 #line 358 "parser.y"
-    {
-          bx_dbg_watch(1, (yyvsp[(3) - (4)].uval), 1); /* BX_WRITE */
-          free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+      {
+          bx_dbg_watch(0, (yyvsp[-1].uval), 1); /* BX_READ */
+          free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 2370 "y.tab.c"
     break;
 
-  case 85:
-/* Line 1787 of yacc.c  */
+  case 85: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_WRITE expression '\n'  */
 #line 363 "parser.y"
-    {
-          bx_dbg_watch(0, (yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval)); /* BX_READ */
-          free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+          bx_dbg_watch(1, (yyvsp[-1].uval), 1); /* BX_WRITE */
+          free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 2379 "y.tab.c"
     break;
 
-  case 86:
-/* Line 1787 of yacc.c  */
+  case 86: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_R expression expression '\n'  */
 #line 368 "parser.y"
-    {
-          bx_dbg_watch(0, (yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval)); /* BX_READ */
-          free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+          bx_dbg_watch(0, (yyvsp[-2].uval), (yyvsp[-1].uval)); /* BX_READ */
+          free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 2388 "y.tab.c"
     break;
 
-  case 87:
-/* Line 1787 of yacc.c  */
+  case 87: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_READ expression expression '\n'  */
 #line 373 "parser.y"
-    {
-          bx_dbg_watch(1, (yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval)); /* BX_WRITE */
-          free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+          bx_dbg_watch(0, (yyvsp[-2].uval), (yyvsp[-1].uval)); /* BX_READ */
+          free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 2397 "y.tab.c"
     break;
 
-  case 88:
-/* Line 1787 of yacc.c  */
+  case 88: /* watch_point_command: BX_TOKEN_WATCH BX_TOKEN_WRITE expression expression '\n'  */
 #line 378 "parser.y"
-    {
-          bx_dbg_unwatch_all();
-          free((yyvsp[(1) - (2)].sval));
+      {
+          bx_dbg_watch(1, (yyvsp[-2].uval), (yyvsp[-1].uval)); /* BX_WRITE */
+          free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 2406 "y.tab.c"
     break;
 
-  case 89:
-/* Line 1787 of yacc.c  */
+  case 89: /* watch_point_command: BX_TOKEN_UNWATCH '\n'  */
 #line 383 "parser.y"
-    {
-          bx_dbg_unwatch((yyvsp[(2) - (3)].uval));
-          free((yyvsp[(1) - (3)].sval));
+      {
+          bx_dbg_unwatch_all();
+          free((yyvsp[-1].sval));
       }
+#line 2415 "y.tab.c"
     break;
 
-  case 90:
-/* Line 1787 of yacc.c  */
-#line 391 "parser.y"
-    {
-        bx_dbg_symbol_command((yyvsp[(2) - (3)].sval), 0, 0);
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+  case 90: /* watch_point_command: BX_TOKEN_UNWATCH expression '\n'  */
+#line 388 "parser.y"
+      {
+          bx_dbg_unwatch((yyvsp[-1].uval));
+          free((yyvsp[-2].sval));
       }
+#line 2424 "y.tab.c"
     break;
 
-  case 91:
-/* Line 1787 of yacc.c  */
-#line 396 "parser.y"
-    {
-        bx_dbg_symbol_command((yyvsp[(2) - (4)].sval), 0, (yyvsp[(3) - (4)].uval));
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+  case 91: /* watch_point_command: BX_TOKEN_UNWATCH BX_TOKEN_VGA BX_TOKEN_STRING '\n'  */
+#line 393 "parser.y"
+      {
+          bx_dbg_unwatch_text((yyvsp[-1].sval));
+          free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2433 "y.tab.c"
     break;
 
-  case 92:
-/* Line 1787 of yacc.c  */
+  case 92: /* symbol_command: BX_TOKEN_LOAD_SYMBOLS BX_TOKEN_STRING '\n'  */
 #line 401 "parser.y"
-    {
-        bx_dbg_symbol_command((yyvsp[(3) - (4)].sval), 1, 0);
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval)); free((yyvsp[(3) - (4)].sval));
+      {
+        bx_dbg_symbol_command((yyvsp[-1].sval), 0, 0);
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2442 "y.tab.c"
     break;
 
-  case 93:
-/* Line 1787 of yacc.c  */
+  case 93: /* symbol_command: BX_TOKEN_LOAD_SYMBOLS BX_TOKEN_STRING expression '\n'  */
 #line 406 "parser.y"
-    {
-        bx_dbg_symbol_command((yyvsp[(3) - (5)].sval), 1, (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval)); free((yyvsp[(3) - (5)].sval));
+      {
+        bx_dbg_symbol_command((yyvsp[-2].sval), 0, (yyvsp[-1].uval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 2451 "y.tab.c"
     break;
 
-  case 94:
-/* Line 1787 of yacc.c  */
-#line 414 "parser.y"
-    {
-        bx_dbg_where_command();
-        free((yyvsp[(1) - (2)].sval));
+  case 94: /* symbol_command: BX_TOKEN_LOAD_SYMBOLS BX_TOKEN_GLOBAL BX_TOKEN_STRING '\n'  */
+#line 411 "parser.y"
+      {
+        bx_dbg_symbol_command((yyvsp[-1].sval), 1, 0);
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2460 "y.tab.c"
     break;
 
-  case 95:
-/* Line 1787 of yacc.c  */
-#line 422 "parser.y"
-    {
-        bx_dbg_print_string_command((yyvsp[(2) - (3)].uval));
-        free((yyvsp[(1) - (3)].sval));
+  case 95: /* symbol_command: BX_TOKEN_LOAD_SYMBOLS BX_TOKEN_GLOBAL BX_TOKEN_STRING expression '\n'  */
+#line 416 "parser.y"
+      {
+        bx_dbg_symbol_command((yyvsp[-2].sval), 1, (yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 2469 "y.tab.c"
     break;
 
-  case 96:
-/* Line 1787 of yacc.c  */
-#line 430 "parser.y"
-    {
-        bx_dbg_continue_command();
-        free((yyvsp[(1) - (2)].sval));
+  case 96: /* where_command: BX_TOKEN_WHERE '\n'  */
+#line 424 "parser.y"
+      {
+        bx_dbg_where_command();
+        free((yyvsp[-1].sval));
       }
+#line 2478 "y.tab.c"
     break;
 
-  case 97:
-/* Line 1787 of yacc.c  */
-#line 438 "parser.y"
-    {
-        bx_dbg_stepN_command(dbg_cpu, 1);
-        free((yyvsp[(1) - (2)].sval));
+  case 97: /* print_string_command: BX_TOKEN_PRINT_STRING expression '\n'  */
+#line 432 "parser.y"
+      {
+        bx_dbg_print_string_command((yyvsp[-1].uval));
+        free((yyvsp[-2].sval));
       }
+#line 2487 "y.tab.c"
     break;
 
-  case 98:
-/* Line 1787 of yacc.c  */
-#line 443 "parser.y"
-    {
-        bx_dbg_stepN_command(dbg_cpu, (yyvsp[(2) - (3)].uval));
-        free((yyvsp[(1) - (3)].sval));
+  case 98: /* continue_command: BX_TOKEN_CONTINUE '\n'  */
+#line 440 "parser.y"
+      {
+        bx_dbg_continue_command();
+        free((yyvsp[-1].sval));
       }
+#line 2496 "y.tab.c"
     break;
 
-  case 99:
-/* Line 1787 of yacc.c  */
+  case 99: /* stepN_command: BX_TOKEN_STEPN '\n'  */
 #line 448 "parser.y"
-    {
-        bx_dbg_stepN_command(-1, (yyvsp[(3) - (4)].uval));
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+      {
+        bx_dbg_stepN_command(dbg_cpu, 1);
+        free((yyvsp[-1].sval));
       }
+#line 2505 "y.tab.c"
     break;
 
-  case 100:
-/* Line 1787 of yacc.c  */
+  case 100: /* stepN_command: BX_TOKEN_STEPN BX_TOKEN_NUMERIC '\n'  */
 #line 453 "parser.y"
-    {
-        bx_dbg_stepN_command((yyvsp[(2) - (4)].uval), (yyvsp[(3) - (4)].uval));
-        free((yyvsp[(1) - (4)].sval));
+      {
+        bx_dbg_stepN_command(dbg_cpu, (yyvsp[-1].uval));
+        free((yyvsp[-2].sval));
       }
+#line 2514 "y.tab.c"
     break;
 
-  case 101:
-/* Line 1787 of yacc.c  */
-#line 461 "parser.y"
-    {
-        bx_dbg_step_over_command();
-        free((yyvsp[(1) - (2)].sval));
+  case 101: /* stepN_command: BX_TOKEN_STEPN BX_TOKEN_ALL BX_TOKEN_NUMERIC '\n'  */
+#line 458 "parser.y"
+      {
+        bx_dbg_stepN_command(-1, (yyvsp[-1].uval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 2523 "y.tab.c"
     break;
 
-  case 102:
-/* Line 1787 of yacc.c  */
-#line 469 "parser.y"
-    {
-        bx_dbg_set_auto_disassemble((yyvsp[(3) - (4)].bval));
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+  case 102: /* stepN_command: BX_TOKEN_STEPN BX_TOKEN_NUMERIC BX_TOKEN_NUMERIC '\n'  */
+#line 463 "parser.y"
+      {
+        bx_dbg_stepN_command((yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-3].sval));
       }
+#line 2532 "y.tab.c"
     break;
 
-  case 103:
-/* Line 1787 of yacc.c  */
-#line 474 "parser.y"
-    {
-        bx_dbg_set_symbol_command((yyvsp[(2) - (5)].sval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+  case 103: /* step_over_command: BX_TOKEN_STEP_OVER '\n'  */
+#line 471 "parser.y"
+      {
+        bx_dbg_step_over_command();
+        free((yyvsp[-1].sval));
       }
+#line 2541 "y.tab.c"
     break;
 
-  case 104:
-/* Line 1787 of yacc.c  */
+  case 104: /* set_command: BX_TOKEN_SET BX_TOKEN_DISASM BX_TOKEN_TOGGLE_ON_OFF '\n'  */
 #line 479 "parser.y"
-    { 
-        bx_dbg_set_reg8l_value((yyvsp[(2) - (5)].uval), (yyvsp[(4) - (5)].uval));
+      {
+        bx_dbg_set_auto_disassemble((yyvsp[-1].bval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 2550 "y.tab.c"
     break;
 
-  case 105:
-/* Line 1787 of yacc.c  */
-#line 483 "parser.y"
-    { 
-        bx_dbg_set_reg8h_value((yyvsp[(2) - (5)].uval), (yyvsp[(4) - (5)].uval));
+  case 105: /* set_command: BX_TOKEN_SET BX_TOKEN_SYMBOLNAME '=' expression '\n'  */
+#line 484 "parser.y"
+      {
+        bx_dbg_set_symbol_command((yyvsp[-3].sval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 2559 "y.tab.c"
     break;
 
-  case 106:
-/* Line 1787 of yacc.c  */
-#line 487 "parser.y"
-    { 
-        bx_dbg_set_reg16_value((yyvsp[(2) - (5)].uval), (yyvsp[(4) - (5)].uval));
+  case 106: /* set_command: BX_TOKEN_SET BX_TOKEN_8BL_REG '=' expression '\n'  */
+#line 489 "parser.y"
+      { 
+        bx_dbg_set_reg8l_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
+#line 2567 "y.tab.c"
     break;
 
-  case 107:
-/* Line 1787 of yacc.c  */
-#line 491 "parser.y"
-    { 
-        bx_dbg_set_reg32_value((yyvsp[(2) - (5)].uval), (yyvsp[(4) - (5)].uval));
+  case 107: /* set_command: BX_TOKEN_SET BX_TOKEN_8BH_REG '=' expression '\n'  */
+#line 493 "parser.y"
+      { 
+        bx_dbg_set_reg8h_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
+#line 2575 "y.tab.c"
     break;
 
-  case 108:
-/* Line 1787 of yacc.c  */
-#line 495 "parser.y"
-    { 
-        bx_dbg_set_reg64_value((yyvsp[(2) - (5)].uval), (yyvsp[(4) - (5)].uval));
+  case 108: /* set_command: BX_TOKEN_SET BX_TOKEN_16B_REG '=' expression '\n'  */
+#line 497 "parser.y"
+      { 
+        bx_dbg_set_reg16_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
+#line 2583 "y.tab.c"
     break;
 
-  case 109:
-/* Line 1787 of yacc.c  */
-#line 499 "parser.y"
-    { 
-        bx_dbg_set_rip_value((yyvsp[(4) - (5)].uval));
+  case 109: /* set_command: BX_TOKEN_SET BX_TOKEN_32B_REG '=' expression '\n'  */
+#line 501 "parser.y"
+      { 
+        bx_dbg_set_reg32_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
+#line 2591 "y.tab.c"
     break;
 
-  case 110:
-/* Line 1787 of yacc.c  */
-#line 503 "parser.y"
-    { 
-        bx_dbg_set_rip_value((yyvsp[(4) - (5)].uval));
+  case 110: /* set_command: BX_TOKEN_SET BX_TOKEN_64B_REG '=' expression '\n'  */
+#line 505 "parser.y"
+      { 
+        bx_dbg_set_reg64_value((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
+#line 2599 "y.tab.c"
     break;
 
-  case 111:
-/* Line 1787 of yacc.c  */
-#line 507 "parser.y"
-    { 
-        bx_dbg_load_segreg((yyvsp[(2) - (5)].uval), (yyvsp[(4) - (5)].uval));
+  case 111: /* set_command: BX_TOKEN_SET BX_TOKEN_REG_EIP '=' expression '\n'  */
+#line 509 "parser.y"
+      { 
+        bx_dbg_set_rip_value((yyvsp[-1].uval));
       }
+#line 2607 "y.tab.c"
     break;
 
-  case 112:
-/* Line 1787 of yacc.c  */
-#line 514 "parser.y"
-    {
-        bx_dbg_vbreakpoint_command(bkAtIP, 0, 0);
-        free((yyvsp[(1) - (2)].sval));
+  case 112: /* set_command: BX_TOKEN_SET BX_TOKEN_REG_RIP '=' expression '\n'  */
+#line 513 "parser.y"
+      { 
+        bx_dbg_set_rip_value((yyvsp[-1].uval));
       }
+#line 2615 "y.tab.c"
     break;
 
-  case 113:
-/* Line 1787 of yacc.c  */
-#line 519 "parser.y"
-    {
-        bx_dbg_vbreakpoint_command(bkRegular, (yyvsp[(2) - (5)].uval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval));
+  case 113: /* set_command: BX_TOKEN_SET BX_TOKEN_SEGREG '=' expression '\n'  */
+#line 517 "parser.y"
+      { 
+        bx_dbg_load_segreg((yyvsp[-3].uval), (yyvsp[-1].uval));
       }
+#line 2623 "y.tab.c"
     break;
 
-  case 114:
-/* Line 1787 of yacc.c  */
+  case 114: /* breakpoint_command: BX_TOKEN_VBREAKPOINT '\n'  */
 #line 524 "parser.y"
-    {
-        bx_dbg_lbreakpoint_command(bkAtIP, 0);
-        free((yyvsp[(1) - (2)].sval));
+      {
+        bx_dbg_vbreakpoint_command(bkAtIP, 0, 0);
+        free((yyvsp[-1].sval));
       }
+#line 2632 "y.tab.c"
     break;
 
-  case 115:
-/* Line 1787 of yacc.c  */
+  case 115: /* breakpoint_command: BX_TOKEN_VBREAKPOINT vexpression ':' vexpression '\n'  */
 #line 529 "parser.y"
-    {
-        bx_dbg_lbreakpoint_command(bkRegular, (yyvsp[(2) - (3)].uval));
-        free((yyvsp[(1) - (3)].sval));
+      {
+        bx_dbg_vbreakpoint_command(bkRegular, (yyvsp[-3].uval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval));
       }
+#line 2641 "y.tab.c"
     break;
 
-  case 116:
-/* Line 1787 of yacc.c  */
+  case 116: /* breakpoint_command: BX_TOKEN_LBREAKPOINT '\n'  */
 #line 534 "parser.y"
-    {
-        bx_dbg_lbreakpoint_symbol_command((yyvsp[(2) - (3)].sval));
-        free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_lbreakpoint_command(bkAtIP, 0);
+        free((yyvsp[-1].sval));
       }
+#line 2650 "y.tab.c"
     break;
 
-  case 117:
-/* Line 1787 of yacc.c  */
+  case 117: /* breakpoint_command: BX_TOKEN_LBREAKPOINT expression '\n'  */
 #line 539 "parser.y"
-    {
-        bx_dbg_pbreakpoint_command(bkAtIP, 0);
-        free((yyvsp[(1) - (2)].sval));
+      {
+        bx_dbg_lbreakpoint_command(bkRegular, (yyvsp[-1].uval));
+        free((yyvsp[-2].sval));
       }
+#line 2659 "y.tab.c"
     break;
 
-  case 118:
-/* Line 1787 of yacc.c  */
+  case 118: /* breakpoint_command: BX_TOKEN_LBREAKPOINT BX_TOKEN_STRING '\n'  */
 #line 544 "parser.y"
-    {
-        bx_dbg_pbreakpoint_command(bkRegular, (yyvsp[(2) - (3)].uval));
-        free((yyvsp[(1) - (3)].sval));
+      {
+        bx_dbg_lbreakpoint_symbol_command((yyvsp[-1].sval));
+        free((yyvsp[-2].sval));free((yyvsp[-1].sval));
       }
+#line 2668 "y.tab.c"
     break;
 
-  case 119:
-/* Line 1787 of yacc.c  */
+  case 119: /* breakpoint_command: BX_TOKEN_PBREAKPOINT '\n'  */
 #line 549 "parser.y"
-    {
-        bx_dbg_pbreakpoint_command(bkRegular, (yyvsp[(3) - (4)].uval));
-        free((yyvsp[(1) - (4)].sval));
+      {
+        bx_dbg_pbreakpoint_command(bkAtIP, 0);
+        free((yyvsp[-1].sval));
       }
+#line 2677 "y.tab.c"
     break;
 
-  case 120:
-/* Line 1787 of yacc.c  */
-#line 557 "parser.y"
-    {
-        bx_dbg_info_bpoints_command();
-        free((yyvsp[(1) - (2)].sval));
+  case 120: /* breakpoint_command: BX_TOKEN_PBREAKPOINT expression '\n'  */
+#line 554 "parser.y"
+      {
+        bx_dbg_pbreakpoint_command(bkRegular, (yyvsp[-1].uval));
+        free((yyvsp[-2].sval));
       }
+#line 2686 "y.tab.c"
     break;
 
-  case 121:
-/* Line 1787 of yacc.c  */
-#line 565 "parser.y"
-    {
-        bx_dbg_info_symbols_command(0);
-        free((yyvsp[(1) - (2)].sval));
+  case 121: /* breakpoint_command: BX_TOKEN_PBREAKPOINT '*' expression '\n'  */
+#line 559 "parser.y"
+      {
+        bx_dbg_pbreakpoint_command(bkRegular, (yyvsp[-1].uval));
+        free((yyvsp[-3].sval));
       }
+#line 2695 "y.tab.c"
     break;
 
-  case 122:
-/* Line 1787 of yacc.c  */
-#line 570 "parser.y"
-    {
-        bx_dbg_info_symbols_command((yyvsp[(2) - (3)].sval));
-        free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+  case 122: /* blist_command: BX_TOKEN_LIST_BREAK '\n'  */
+#line 567 "parser.y"
+      {
+        bx_dbg_info_bpoints_command();
+        free((yyvsp[-1].sval));
       }
+#line 2704 "y.tab.c"
     break;
 
-  case 123:
-/* Line 1787 of yacc.c  */
-#line 578 "parser.y"
-    {
-        bx_dbg_info_bpoints_command();
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+  case 123: /* slist_command: BX_TOKEN_LIST_SYMBOLS '\n'  */
+#line 575 "parser.y"
+      {
+        bx_dbg_info_symbols_command(0);
+        free((yyvsp[-1].sval));
       }
+#line 2713 "y.tab.c"
     break;
 
-  case 124:
-/* Line 1787 of yacc.c  */
-#line 583 "parser.y"
-    {
-        bx_dbg_info_registers_command(-1);
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+  case 124: /* slist_command: BX_TOKEN_LIST_SYMBOLS BX_TOKEN_STRING '\n'  */
+#line 580 "parser.y"
+      {
+        bx_dbg_info_symbols_command((yyvsp[-1].sval));
+        free((yyvsp[-2].sval));free((yyvsp[-1].sval));
       }
+#line 2722 "y.tab.c"
     break;
 
-  case 125:
-/* Line 1787 of yacc.c  */
+  case 125: /* info_command: BX_TOKEN_INFO BX_TOKEN_PBREAKPOINT '\n'  */
 #line 588 "parser.y"
-    {
-        bx_dbg_info_idt_command((yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+        bx_dbg_info_bpoints_command();
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2731 "y.tab.c"
     break;
 
-  case 126:
-/* Line 1787 of yacc.c  */
+  case 126: /* info_command: BX_TOKEN_INFO BX_TOKEN_CPU '\n'  */
 #line 593 "parser.y"
-    {
-        bx_dbg_info_ivt_command((yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+        bx_dbg_info_registers_command(-1);
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2740 "y.tab.c"
     break;
 
-  case 127:
-/* Line 1787 of yacc.c  */
+  case 127: /* info_command: BX_TOKEN_INFO BX_TOKEN_IDT optional_numeric optional_numeric '\n'  */
 #line 598 "parser.y"
-    {
-        bx_dbg_info_gdt_command((yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+        bx_dbg_info_idt_command((yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 2749 "y.tab.c"
     break;
 
-  case 128:
-/* Line 1787 of yacc.c  */
+  case 128: /* info_command: BX_TOKEN_INFO BX_TOKEN_IVT optional_numeric optional_numeric '\n'  */
 #line 603 "parser.y"
-    {
-        bx_dbg_info_ldt_command((yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+        bx_dbg_info_ivt_command((yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 2758 "y.tab.c"
     break;
 
-  case 129:
-/* Line 1787 of yacc.c  */
+  case 129: /* info_command: BX_TOKEN_INFO BX_TOKEN_GDT optional_numeric optional_numeric '\n'  */
 #line 608 "parser.y"
-    {
-        bx_dbg_dump_table();
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_info_gdt_command((yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 2767 "y.tab.c"
     break;
 
-  case 130:
-/* Line 1787 of yacc.c  */
+  case 130: /* info_command: BX_TOKEN_INFO BX_TOKEN_LDT optional_numeric optional_numeric '\n'  */
 #line 613 "parser.y"
-    {
-        bx_dbg_info_tss_command();
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_info_ldt_command((yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 2776 "y.tab.c"
     break;
 
-  case 131:
-/* Line 1787 of yacc.c  */
+  case 131: /* info_command: BX_TOKEN_INFO BX_TOKEN_TAB '\n'  */
 #line 618 "parser.y"
-    {
-        bx_dbg_info_flags();
-        free((yyvsp[(1) - (3)].sval));
+      {
+        bx_dbg_dump_table();
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2785 "y.tab.c"
     break;
 
-  case 132:
-/* Line 1787 of yacc.c  */
+  case 132: /* info_command: BX_TOKEN_INFO BX_TOKEN_TSS '\n'  */
 #line 623 "parser.y"
-    {
-        bx_dbg_info_linux_command();
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_info_tss_command();
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2794 "y.tab.c"
     break;
 
-  case 133:
-/* Line 1787 of yacc.c  */
+  case 133: /* info_command: BX_TOKEN_INFO BX_TOKEN_FLAGS '\n'  */
 #line 628 "parser.y"
-    {
-        bx_dbg_info_symbols_command(0);
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_info_flags();
+        free((yyvsp[-2].sval));
       }
+#line 2803 "y.tab.c"
     break;
 
-  case 134:
-/* Line 1787 of yacc.c  */
+  case 134: /* info_command: BX_TOKEN_INFO BX_TOKEN_LINUX '\n'  */
 #line 633 "parser.y"
-    {
-        bx_dbg_info_symbols_command((yyvsp[(3) - (4)].sval));
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval)); free((yyvsp[(3) - (4)].sval));
+      {
+        bx_dbg_info_linux_command();
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2812 "y.tab.c"
     break;
 
-  case 135:
-/* Line 1787 of yacc.c  */
+  case 135: /* info_command: BX_TOKEN_INFO BX_TOKEN_SYMBOLS '\n'  */
 #line 638 "parser.y"
-    {
-        bx_dbg_info_device("", "");
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_info_symbols_command(0);
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2821 "y.tab.c"
     break;
 
-  case 136:
-/* Line 1787 of yacc.c  */
+  case 136: /* info_command: BX_TOKEN_INFO BX_TOKEN_SYMBOLS BX_TOKEN_STRING '\n'  */
 #line 643 "parser.y"
-    {
-        bx_dbg_info_device((yyvsp[(3) - (4)].sval), "");
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+      {
+        bx_dbg_info_symbols_command((yyvsp[-1].sval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2830 "y.tab.c"
     break;
 
-  case 137:
-/* Line 1787 of yacc.c  */
+  case 137: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE '\n'  */
 #line 648 "parser.y"
-    {
-        bx_dbg_info_device((yyvsp[(3) - (5)].sval), (yyvsp[(4) - (5)].sval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+        bx_dbg_info_device("", "");
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2839 "y.tab.c"
     break;
 
-  case 138:
-/* Line 1787 of yacc.c  */
-#line 655 "parser.y"
-    { (yyval.uval) = EMPTY_ARG; }
+  case 138: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_STRING '\n'  */
+#line 653 "parser.y"
+      {
+        bx_dbg_info_device((yyvsp[-1].sval), "");
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
+      }
+#line 2848 "y.tab.c"
     break;
 
-  case 140:
-/* Line 1787 of yacc.c  */
-#line 660 "parser.y"
-    {
+  case 139: /* info_command: BX_TOKEN_INFO BX_TOKEN_DEVICE BX_TOKEN_STRING BX_TOKEN_STRING '\n'  */
+#line 658 "parser.y"
+      {
+        bx_dbg_info_device((yyvsp[-2].sval), (yyvsp[-1].sval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
+      }
+#line 2857 "y.tab.c"
+    break;
+
+  case 140: /* optional_numeric: %empty  */
+#line 665 "parser.y"
+               { (yyval.uval) = EMPTY_ARG; }
+#line 2863 "y.tab.c"
+    break;
+
+  case 142: /* regs_command: BX_TOKEN_REGISTERS '\n'  */
+#line 670 "parser.y"
+      {
         bx_dbg_info_registers_command(BX_INFO_GENERAL_PURPOSE_REGS);
-        free((yyvsp[(1) - (2)].sval));
+        free((yyvsp[-1].sval));
       }
+#line 2872 "y.tab.c"
     break;
 
-  case 141:
-/* Line 1787 of yacc.c  */
-#line 668 "parser.y"
-    {
+  case 143: /* fpu_regs_command: BX_TOKEN_FPU '\n'  */
+#line 678 "parser.y"
+      {
         bx_dbg_info_registers_command(BX_INFO_FPU_REGS);
-        free((yyvsp[(1) - (2)].sval));
+        free((yyvsp[-1].sval));
       }
+#line 2881 "y.tab.c"
     break;
 
-  case 142:
-/* Line 1787 of yacc.c  */
-#line 676 "parser.y"
-    {
+  case 144: /* mmx_regs_command: BX_TOKEN_MMX '\n'  */
+#line 686 "parser.y"
+      {
         bx_dbg_info_registers_command(BX_INFO_MMX_REGS);
-        free((yyvsp[(1) - (2)].sval));
+        free((yyvsp[-1].sval));
       }
+#line 2890 "y.tab.c"
     break;
 
-  case 143:
-/* Line 1787 of yacc.c  */
-#line 684 "parser.y"
-    {
+  case 145: /* sse_regs_command: BX_TOKEN_SSE '\n'  */
+#line 694 "parser.y"
+      {
         bx_dbg_info_registers_command(BX_INFO_SSE_REGS);
-        free((yyvsp[(1) - (2)].sval));
+        free((yyvsp[-1].sval));
       }
+#line 2899 "y.tab.c"
     break;
 
-  case 144:
-/* Line 1787 of yacc.c  */
-#line 692 "parser.y"
-    {
+  case 146: /* avx_regs_command: BX_TOKEN_AVX '\n'  */
+#line 702 "parser.y"
+      {
         bx_dbg_info_registers_command(BX_INFO_AVX_REGS);
-        free((yyvsp[(1) - (2)].sval));
+        free((yyvsp[-1].sval));
       }
+#line 2908 "y.tab.c"
     break;
 
-  case 145:
-/* Line 1787 of yacc.c  */
-#line 700 "parser.y"
-    {
+  case 147: /* segment_regs_command: BX_TOKEN_SEGMENT_REGS '\n'  */
+#line 710 "parser.y"
+      {
         bx_dbg_info_segment_regs_command();
-        free((yyvsp[(1) - (2)].sval));
+        free((yyvsp[-1].sval));
       }
+#line 2917 "y.tab.c"
     break;
 
-  case 146:
-/* Line 1787 of yacc.c  */
-#line 708 "parser.y"
-    {
+  case 148: /* control_regs_command: BX_TOKEN_CONTROL_REGS '\n'  */
+#line 718 "parser.y"
+      {
         bx_dbg_info_control_regs_command();
-        free((yyvsp[(1) - (2)].sval));
+        free((yyvsp[-1].sval));
       }
+#line 2926 "y.tab.c"
     break;
 
-  case 147:
-/* Line 1787 of yacc.c  */
-#line 716 "parser.y"
-    {
+  case 149: /* debug_regs_command: BX_TOKEN_DEBUG_REGS '\n'  */
+#line 726 "parser.y"
+      {
         bx_dbg_info_debug_regs_command();
-        free((yyvsp[(1) - (2)].sval));
-      }
-    break;
-
-  case 148:
-/* Line 1787 of yacc.c  */
-#line 724 "parser.y"
-    {
-        bx_dbg_del_breakpoint_command((yyvsp[(2) - (3)].uval));
-        free((yyvsp[(1) - (3)].sval));
-      }
-    break;
-
-  case 149:
-/* Line 1787 of yacc.c  */
-#line 732 "parser.y"
-    {
-        bx_dbg_en_dis_breakpoint_command((yyvsp[(2) - (3)].uval), 1);
-        free((yyvsp[(1) - (3)].sval));
+        free((yyvsp[-1].sval));
       }
+#line 2935 "y.tab.c"
     break;
 
-  case 150:
-/* Line 1787 of yacc.c  */
-#line 739 "parser.y"
-    {
-        bx_dbg_en_dis_breakpoint_command((yyvsp[(2) - (3)].uval), 0);
-        free((yyvsp[(1) - (3)].sval));
+  case 150: /* delete_command: BX_TOKEN_DEL_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
+#line 734 "parser.y"
+      {
+        bx_dbg_del_breakpoint_command((yyvsp[-1].uval));
+        free((yyvsp[-2].sval));
       }
+#line 2944 "y.tab.c"
     break;
 
-  case 151:
-/* Line 1787 of yacc.c  */
-#line 747 "parser.y"
-    {
-        bx_dbg_quit_command();
-        free((yyvsp[(1) - (2)].sval));
+  case 151: /* bpe_command: BX_TOKEN_ENABLE_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
+#line 742 "parser.y"
+      {
+        bx_dbg_en_dis_breakpoint_command((yyvsp[-1].uval), 1);
+        free((yyvsp[-2].sval));
       }
+#line 2953 "y.tab.c"
     break;
 
-  case 152:
-/* Line 1787 of yacc.c  */
-#line 755 "parser.y"
-    {
-        bx_dbg_examine_command((yyvsp[(1) - (4)].sval), (yyvsp[(2) - (4)].sval),1, (yyvsp[(3) - (4)].uval), 1);
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+  case 152: /* bpd_command: BX_TOKEN_DISABLE_BREAKPOINT BX_TOKEN_NUMERIC '\n'  */
+#line 749 "parser.y"
+      {
+        bx_dbg_en_dis_breakpoint_command((yyvsp[-1].uval), 0);
+        free((yyvsp[-2].sval));
       }
+#line 2962 "y.tab.c"
     break;
 
-  case 153:
-/* Line 1787 of yacc.c  */
-#line 760 "parser.y"
-    {
-        bx_dbg_examine_command((yyvsp[(1) - (3)].sval), (yyvsp[(2) - (3)].sval),1, 0, 0);
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+  case 153: /* quit_command: BX_TOKEN_QUIT '\n'  */
+#line 757 "parser.y"
+      {
+        bx_dbg_quit_command();
+        free((yyvsp[-1].sval));
       }
+#line 2971 "y.tab.c"
     break;
 
-  case 154:
-/* Line 1787 of yacc.c  */
+  case 154: /* examine_command: BX_TOKEN_EXAMINE BX_TOKEN_XFORMAT expression '\n'  */
 #line 765 "parser.y"
-    {
-        bx_dbg_examine_command((yyvsp[(1) - (3)].sval), NULL,0, (yyvsp[(2) - (3)].uval), 1);
-        free((yyvsp[(1) - (3)].sval));
+      {
+        bx_dbg_examine_command((yyvsp[-3].sval), (yyvsp[-2].sval),1, (yyvsp[-1].uval), 1);
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 2980 "y.tab.c"
     break;
 
-  case 155:
-/* Line 1787 of yacc.c  */
+  case 155: /* examine_command: BX_TOKEN_EXAMINE BX_TOKEN_XFORMAT '\n'  */
 #line 770 "parser.y"
-    {
-        bx_dbg_examine_command((yyvsp[(1) - (2)].sval), NULL,0, 0, 0);
-        free((yyvsp[(1) - (2)].sval));
+      {
+        bx_dbg_examine_command((yyvsp[-2].sval), (yyvsp[-1].sval),1, 0, 0);
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 2989 "y.tab.c"
     break;
 
-  case 156:
-/* Line 1787 of yacc.c  */
-#line 778 "parser.y"
-    {
-        bx_dbg_restore_command((yyvsp[(2) - (4)].sval), (yyvsp[(3) - (4)].sval));
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval)); free((yyvsp[(3) - (4)].sval));
+  case 156: /* examine_command: BX_TOKEN_EXAMINE expression '\n'  */
+#line 775 "parser.y"
+      {
+        bx_dbg_examine_command((yyvsp[-2].sval), NULL,0, (yyvsp[-1].uval), 1);
+        free((yyvsp[-2].sval));
       }
+#line 2998 "y.tab.c"
     break;
 
-  case 157:
-/* Line 1787 of yacc.c  */
-#line 786 "parser.y"
-    {
-        bx_dbg_writemem_command((yyvsp[(2) - (5)].sval), (yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+  case 157: /* examine_command: BX_TOKEN_EXAMINE '\n'  */
+#line 780 "parser.y"
+      {
+        bx_dbg_examine_command((yyvsp[-1].sval), NULL,0, 0, 0);
+        free((yyvsp[-1].sval));
       }
+#line 3007 "y.tab.c"
     break;
 
-  case 158:
-/* Line 1787 of yacc.c  */
-#line 794 "parser.y"
-    {
-        bx_dbg_setpmem_command((yyvsp[(2) - (5)].uval), (yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval));
+  case 158: /* restore_command: BX_TOKEN_RESTORE BX_TOKEN_STRING BX_TOKEN_STRING '\n'  */
+#line 788 "parser.y"
+      {
+        bx_dbg_restore_command((yyvsp[-2].sval), (yyvsp[-1].sval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 3016 "y.tab.c"
     break;
 
-  case 159:
-/* Line 1787 of yacc.c  */
-#line 802 "parser.y"
-    {
-        bx_dbg_query_command((yyvsp[(2) - (3)].sval));
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+  case 159: /* writemem_command: BX_TOKEN_WRITEMEM BX_TOKEN_STRING expression expression '\n'  */
+#line 796 "parser.y"
+      {
+        bx_dbg_writemem_command((yyvsp[-3].sval), (yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 3025 "y.tab.c"
     break;
 
-  case 160:
-/* Line 1787 of yacc.c  */
-#line 810 "parser.y"
-    {
-        bx_dbg_take_command((yyvsp[(2) - (3)].sval), 1);
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+  case 160: /* setpmem_command: BX_TOKEN_SETPMEM expression expression expression '\n'  */
+#line 804 "parser.y"
+      {
+        bx_dbg_setpmem_command((yyvsp[-3].uval), (yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval));
       }
+#line 3034 "y.tab.c"
     break;
 
-  case 161:
-/* Line 1787 of yacc.c  */
-#line 815 "parser.y"
-    {
-        bx_dbg_take_command((yyvsp[(2) - (4)].sval), (yyvsp[(3) - (4)].uval));
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+  case 161: /* query_command: BX_TOKEN_QUERY BX_TOKEN_PENDING '\n'  */
+#line 812 "parser.y"
+      {
+        bx_dbg_query_command((yyvsp[-1].sval));
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 3043 "y.tab.c"
     break;
 
-  case 162:
-/* Line 1787 of yacc.c  */
+  case 162: /* take_command: BX_TOKEN_TAKE BX_TOKEN_DMA '\n'  */
 #line 820 "parser.y"
-    {
-        bx_dbg_take_command((yyvsp[(2) - (3)].sval), 1);
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_take_command((yyvsp[-1].sval), 1);
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 3052 "y.tab.c"
     break;
 
-  case 163:
-/* Line 1787 of yacc.c  */
-#line 828 "parser.y"
-    {
-        bx_dbg_disassemble_current(NULL);
-        free((yyvsp[(1) - (2)].sval));
+  case 163: /* take_command: BX_TOKEN_TAKE BX_TOKEN_DMA BX_TOKEN_NUMERIC '\n'  */
+#line 825 "parser.y"
+      {
+        bx_dbg_take_command((yyvsp[-2].sval), (yyvsp[-1].uval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 3061 "y.tab.c"
     break;
 
-  case 164:
-/* Line 1787 of yacc.c  */
-#line 833 "parser.y"
-    {
-        bx_dbg_disassemble_command(NULL, (yyvsp[(2) - (3)].uval), (yyvsp[(2) - (3)].uval));
-        free((yyvsp[(1) - (3)].sval));
+  case 164: /* take_command: BX_TOKEN_TAKE BX_TOKEN_IRQ '\n'  */
+#line 830 "parser.y"
+      {
+        bx_dbg_take_command((yyvsp[-1].sval), 1);
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 3070 "y.tab.c"
     break;
 
-  case 165:
-/* Line 1787 of yacc.c  */
+  case 165: /* disassemble_command: BX_TOKEN_DISASM '\n'  */
 #line 838 "parser.y"
-    {
-        bx_dbg_disassemble_command(NULL, (yyvsp[(2) - (4)].uval), (yyvsp[(3) - (4)].uval));
-        free((yyvsp[(1) - (4)].sval));
+      {
+        bx_dbg_disassemble_current(NULL);
+        free((yyvsp[-1].sval));
       }
+#line 3079 "y.tab.c"
     break;
 
-  case 166:
-/* Line 1787 of yacc.c  */
+  case 166: /* disassemble_command: BX_TOKEN_DISASM expression '\n'  */
 #line 843 "parser.y"
-    {
-        bx_dbg_disassemble_current((yyvsp[(2) - (3)].sval));
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_disassemble_command(NULL, (yyvsp[-1].uval), (yyvsp[-1].uval));
+        free((yyvsp[-2].sval));
       }
+#line 3088 "y.tab.c"
     break;
 
-  case 167:
-/* Line 1787 of yacc.c  */
+  case 167: /* disassemble_command: BX_TOKEN_DISASM expression expression '\n'  */
 #line 848 "parser.y"
-    {
-        bx_dbg_disassemble_command((yyvsp[(2) - (4)].sval), (yyvsp[(3) - (4)].uval), (yyvsp[(3) - (4)].uval));
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+      {
+        bx_dbg_disassemble_command(NULL, (yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-3].sval));
       }
+#line 3097 "y.tab.c"
     break;
 
-  case 168:
-/* Line 1787 of yacc.c  */
+  case 168: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT '\n'  */
 #line 853 "parser.y"
-    {
-        bx_dbg_disassemble_command((yyvsp[(2) - (5)].sval), (yyvsp[(3) - (5)].uval), (yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+        bx_dbg_disassemble_current((yyvsp[-1].sval));
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 3106 "y.tab.c"
     break;
 
-  case 169:
-/* Line 1787 of yacc.c  */
+  case 169: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT expression '\n'  */
 #line 858 "parser.y"
-    {
-        bx_dbg_disassemble_switch_mode();
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+      {
+        bx_dbg_disassemble_command((yyvsp[-2].sval), (yyvsp[-1].uval), (yyvsp[-1].uval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 3115 "y.tab.c"
     break;
 
-  case 170:
-/* Line 1787 of yacc.c  */
+  case 170: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_DISFORMAT expression expression '\n'  */
 #line 863 "parser.y"
-    {
-        bx_dbg_disassemble_hex_mode_switch((yyvsp[(3) - (4)].bval));
-        free((yyvsp[(1) - (4)].sval)); free((yyvsp[(2) - (4)].sval));
+      {
+        bx_dbg_disassemble_command((yyvsp[-3].sval), (yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 3124 "y.tab.c"
     break;
 
-  case 171:
-/* Line 1787 of yacc.c  */
+  case 171: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_SWITCH_MODE '\n'  */
 #line 868 "parser.y"
-    {
-        bx_dbg_set_disassemble_size((yyvsp[(4) - (5)].uval));
-        free((yyvsp[(1) - (5)].sval)); free((yyvsp[(2) - (5)].sval));
+      {
+        bx_dbg_disassemble_switch_mode();
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 3133 "y.tab.c"
     break;
 
-  case 172:
-/* Line 1787 of yacc.c  */
-#line 876 "parser.y"
-    {
-        bx_dbg_instrument_command((yyvsp[(2) - (3)].sval));
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+  case 172: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_HEX BX_TOKEN_TOGGLE_ON_OFF '\n'  */
+#line 873 "parser.y"
+      {
+        bx_dbg_disassemble_hex_mode_switch((yyvsp[-1].bval));
+        free((yyvsp[-3].sval)); free((yyvsp[-2].sval));
       }
+#line 3142 "y.tab.c"
     break;
 
-  case 173:
-/* Line 1787 of yacc.c  */
-#line 881 "parser.y"
-    {
-        bx_dbg_instrument_command((yyvsp[(2) - (3)].sval));
-        free((yyvsp[(1) - (3)].sval)); free((yyvsp[(2) - (3)].sval));
+  case 173: /* disassemble_command: BX_TOKEN_DISASM BX_TOKEN_SIZE '=' BX_TOKEN_NUMERIC '\n'  */
+#line 878 "parser.y"
+      {
+        bx_dbg_set_disassemble_size((yyvsp[-1].uval));
+        free((yyvsp[-4].sval)); free((yyvsp[-3].sval));
       }
+#line 3151 "y.tab.c"
     break;
 
-  case 174:
-/* Line 1787 of yacc.c  */
-#line 889 "parser.y"
-    {
-        bx_dbg_doit_command((yyvsp[(2) - (3)].uval));
-        free((yyvsp[(1) - (3)].sval));
+  case 174: /* instrument_command: BX_TOKEN_INSTRUMENT BX_TOKEN_STOP '\n'  */
+#line 886 "parser.y"
+      {
+        bx_dbg_instrument_command((yyvsp[-1].sval));
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 3160 "y.tab.c"
     break;
 
-  case 175:
-/* Line 1787 of yacc.c  */
-#line 897 "parser.y"
-    {
-        bx_dbg_crc_command((yyvsp[(2) - (4)].uval), (yyvsp[(3) - (4)].uval));
-        free((yyvsp[(1) - (4)].sval));
+  case 175: /* instrument_command: BX_TOKEN_INSTRUMENT BX_TOKEN_COMMAND '\n'  */
+#line 891 "parser.y"
+      {
+        bx_dbg_instrument_command((yyvsp[-1].sval));
+        free((yyvsp[-2].sval)); free((yyvsp[-1].sval));
       }
+#line 3169 "y.tab.c"
     break;
 
-  case 176:
-/* Line 1787 of yacc.c  */
-#line 905 "parser.y"
-    {
+  case 176: /* doit_command: BX_TOKEN_DOIT expression '\n'  */
+#line 899 "parser.y"
+      {
+        bx_dbg_doit_command((yyvsp[-1].uval));
+        free((yyvsp[-2].sval));
+      }
+#line 3178 "y.tab.c"
+    break;
+
+  case 177: /* crc_command: BX_TOKEN_CRC expression expression '\n'  */
+#line 907 "parser.y"
+      {
+        bx_dbg_crc_command((yyvsp[-2].uval), (yyvsp[-1].uval));
+        free((yyvsp[-3].sval));
+      }
+#line 3187 "y.tab.c"
+    break;
+
+  case 178: /* help_command: BX_TOKEN_HELP BX_TOKEN_QUIT '\n'  */
+#line 915 "parser.y"
+       {
          dbg_printf("q|quit|exit - quit debugger and emulator execution\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3196 "y.tab.c"
     break;
 
-  case 177:
-/* Line 1787 of yacc.c  */
-#line 910 "parser.y"
-    {
+  case 179: /* help_command: BX_TOKEN_HELP BX_TOKEN_CONTINUE '\n'  */
+#line 920 "parser.y"
+       {
          dbg_printf("c|cont|continue - continue executing\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3205 "y.tab.c"
     break;
 
-  case 178:
-/* Line 1787 of yacc.c  */
-#line 915 "parser.y"
-    {
+  case 180: /* help_command: BX_TOKEN_HELP BX_TOKEN_STEPN '\n'  */
+#line 925 "parser.y"
+       {
          dbg_printf("s|step [count] - execute #count instructions on current processor (default is one instruction)\n");
          dbg_printf("s|step [cpu] <count> - execute #count instructions on processor #cpu\n");
          dbg_printf("s|step all <count> - execute #count instructions on all the processors\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3216 "y.tab.c"
     break;
 
-  case 179:
-/* Line 1787 of yacc.c  */
-#line 922 "parser.y"
-    {
+  case 181: /* help_command: BX_TOKEN_HELP BX_TOKEN_STEP_OVER '\n'  */
+#line 932 "parser.y"
+       {
          dbg_printf("n|next|p - execute instruction stepping over subroutines\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3225 "y.tab.c"
     break;
 
-  case 180:
-/* Line 1787 of yacc.c  */
-#line 927 "parser.y"
-    {
+  case 182: /* help_command: BX_TOKEN_HELP BX_TOKEN_VBREAKPOINT '\n'  */
+#line 937 "parser.y"
+       {
          dbg_printf("vb|vbreak <seg:offset> - set a virtual address instruction breakpoint\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3234 "y.tab.c"
     break;
 
-  case 181:
-/* Line 1787 of yacc.c  */
-#line 932 "parser.y"
-    {
+  case 183: /* help_command: BX_TOKEN_HELP BX_TOKEN_LBREAKPOINT '\n'  */
+#line 942 "parser.y"
+       {
          dbg_printf("lb|lbreak <addr> - set a linear address instruction breakpoint\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3243 "y.tab.c"
     break;
 
-  case 182:
-/* Line 1787 of yacc.c  */
-#line 937 "parser.y"
-    {
+  case 184: /* help_command: BX_TOKEN_HELP BX_TOKEN_PBREAKPOINT '\n'  */
+#line 947 "parser.y"
+       {
          dbg_printf("p|pb|break|pbreak <addr> - set a physical address instruction breakpoint\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3252 "y.tab.c"
     break;
 
-  case 183:
-/* Line 1787 of yacc.c  */
-#line 942 "parser.y"
-    {
+  case 185: /* help_command: BX_TOKEN_HELP BX_TOKEN_DEL_BREAKPOINT '\n'  */
+#line 952 "parser.y"
+       {
          dbg_printf("d|del|delete <n> - delete a breakpoint\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3261 "y.tab.c"
     break;
 
-  case 184:
-/* Line 1787 of yacc.c  */
-#line 947 "parser.y"
-    {
+  case 186: /* help_command: BX_TOKEN_HELP BX_TOKEN_ENABLE_BREAKPOINT '\n'  */
+#line 957 "parser.y"
+       {
          dbg_printf("bpe <n> - enable a breakpoint\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3270 "y.tab.c"
     break;
 
-  case 185:
-/* Line 1787 of yacc.c  */
-#line 952 "parser.y"
-    {
+  case 187: /* help_command: BX_TOKEN_HELP BX_TOKEN_DISABLE_BREAKPOINT '\n'  */
+#line 962 "parser.y"
+       {
          dbg_printf("bpd <n> - disable a breakpoint\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3279 "y.tab.c"
     break;
 
-  case 186:
-/* Line 1787 of yacc.c  */
-#line 957 "parser.y"
-    {
+  case 188: /* help_command: BX_TOKEN_HELP BX_TOKEN_LIST_BREAK '\n'  */
+#line 967 "parser.y"
+       {
          dbg_printf("blist - list all breakpoints (same as 'info break')\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3288 "y.tab.c"
     break;
 
-  case 187:
-/* Line 1787 of yacc.c  */
-#line 962 "parser.y"
-    {
+  case 189: /* help_command: BX_TOKEN_HELP BX_TOKEN_MODEBP '\n'  */
+#line 972 "parser.y"
+       {
          dbg_printf("modebp - toggles mode switch breakpoint\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3297 "y.tab.c"
     break;
 
-  case 188:
-/* Line 1787 of yacc.c  */
-#line 967 "parser.y"
-    {
+  case 190: /* help_command: BX_TOKEN_HELP BX_TOKEN_VMEXITBP '\n'  */
+#line 977 "parser.y"
+       {
          dbg_printf("vmexitbp - toggles VMEXIT switch breakpoint\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3306 "y.tab.c"
     break;
 
-  case 189:
-/* Line 1787 of yacc.c  */
-#line 972 "parser.y"
-    {
+  case 191: /* help_command: BX_TOKEN_HELP BX_TOKEN_CRC '\n'  */
+#line 982 "parser.y"
+       {
          dbg_printf("crc <addr1> <addr2> - show CRC32 for physical memory range addr1..addr2\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3315 "y.tab.c"
     break;
 
-  case 190:
-/* Line 1787 of yacc.c  */
-#line 977 "parser.y"
-    {
+  case 192: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACE '\n'  */
+#line 987 "parser.y"
+       {
          dbg_printf("trace on  - print disassembly for every executed instruction\n");
          dbg_printf("trace off - disable instruction tracing\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3325 "y.tab.c"
     break;
 
-  case 191:
-/* Line 1787 of yacc.c  */
-#line 983 "parser.y"
-    {
+  case 193: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACEREG '\n'  */
+#line 993 "parser.y"
+       {
          dbg_printf("trace-reg on  - print all registers before every executed instruction\n");
          dbg_printf("trace-reg off - disable registers state tracing\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3335 "y.tab.c"
     break;
 
-  case 192:
-/* Line 1787 of yacc.c  */
-#line 989 "parser.y"
-    {
+  case 194: /* help_command: BX_TOKEN_HELP BX_TOKEN_TRACEMEM '\n'  */
+#line 999 "parser.y"
+       {
          dbg_printf("trace-mem on  - print all memory accesses occured during instruction execution\n");
          dbg_printf("trace-mem off - disable memory accesses tracing\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3345 "y.tab.c"
     break;
 
-  case 193:
-/* Line 1787 of yacc.c  */
-#line 995 "parser.y"
-    {
+  case 195: /* help_command: BX_TOKEN_HELP BX_TOKEN_RESTORE '\n'  */
+#line 1005 "parser.y"
+       {
          dbg_printf("restore <param_name> [path] - restore bochs root param from the file\n");
          dbg_printf("for example:\n");
          dbg_printf("restore \"cpu0\" - restore CPU #0 from file \"cpu0\" in current directory\n");
          dbg_printf("restore \"cpu0\" \"/save\" - restore CPU #0 from file \"cpu0\" located in directory \"/save\"\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3357 "y.tab.c"
     break;
 
-  case 194:
-/* Line 1787 of yacc.c  */
-#line 1003 "parser.y"
-    {
+  case 196: /* help_command: BX_TOKEN_HELP BX_TOKEN_PTIME '\n'  */
+#line 1013 "parser.y"
+       {
          dbg_printf("ptime - print current time (number of ticks since start of simulation)\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3366 "y.tab.c"
     break;
 
-  case 195:
-/* Line 1787 of yacc.c  */
-#line 1008 "parser.y"
-    {
+  case 197: /* help_command: BX_TOKEN_HELP BX_TOKEN_TIMEBP '\n'  */
+#line 1018 "parser.y"
+       {
          dbg_printf("sb <delta> - insert a time breakpoint delta instructions into the future\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3375 "y.tab.c"
     break;
 
-  case 196:
-/* Line 1787 of yacc.c  */
-#line 1013 "parser.y"
-    {
+  case 198: /* help_command: BX_TOKEN_HELP BX_TOKEN_TIMEBP_ABSOLUTE '\n'  */
+#line 1023 "parser.y"
+       {
          dbg_printf("sba <time> - insert breakpoint at specific time\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3384 "y.tab.c"
     break;
 
-  case 197:
-/* Line 1787 of yacc.c  */
-#line 1018 "parser.y"
-    {
+  case 199: /* help_command: BX_TOKEN_HELP BX_TOKEN_PRINT_STACK '\n'  */
+#line 1028 "parser.y"
+       {
          dbg_printf("print-stack [num_words] - print the num_words top 16 bit words on the stack\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3393 "y.tab.c"
     break;
 
-  case 198:
-/* Line 1787 of yacc.c  */
-#line 1023 "parser.y"
-    {
+  case 200: /* help_command: BX_TOKEN_HELP BX_TOKEN_LOAD_SYMBOLS '\n'  */
+#line 1033 "parser.y"
+       {
          dbg_printf("ldsym [global] <filename> [offset] - load symbols from file\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3402 "y.tab.c"
     break;
 
-  case 199:
-/* Line 1787 of yacc.c  */
-#line 1028 "parser.y"
-    {
+  case 201: /* help_command: BX_TOKEN_HELP BX_TOKEN_LIST_SYMBOLS '\n'  */
+#line 1038 "parser.y"
+       {
          dbg_printf("slist [string] - list symbols whose preffix is string (same as 'info symbols')\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3411 "y.tab.c"
     break;
 
-  case 200:
-/* Line 1787 of yacc.c  */
-#line 1033 "parser.y"
-    {
+  case 202: /* help_command: BX_TOKEN_HELP BX_TOKEN_REGISTERS '\n'  */
+#line 1043 "parser.y"
+       {
          dbg_printf("r|reg|regs|registers - list of CPU registers and their contents (same as 'info registers')\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3420 "y.tab.c"
     break;
 
-  case 201:
-/* Line 1787 of yacc.c  */
-#line 1038 "parser.y"
-    {
+  case 203: /* help_command: BX_TOKEN_HELP BX_TOKEN_FPU '\n'  */
+#line 1048 "parser.y"
+       {
          dbg_printf("fp|fpu - print FPU state\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3429 "y.tab.c"
     break;
 
-  case 202:
-/* Line 1787 of yacc.c  */
-#line 1043 "parser.y"
-    {
+  case 204: /* help_command: BX_TOKEN_HELP BX_TOKEN_MMX '\n'  */
+#line 1053 "parser.y"
+       {
          dbg_printf("mmx - print MMX state\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3438 "y.tab.c"
     break;
 
-  case 203:
-/* Line 1787 of yacc.c  */
-#line 1048 "parser.y"
-    {
+  case 205: /* help_command: BX_TOKEN_HELP BX_TOKEN_SSE '\n'  */
+#line 1058 "parser.y"
+       {
          dbg_printf("xmm|sse - print SSE state\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3447 "y.tab.c"
     break;
 
-  case 204:
-/* Line 1787 of yacc.c  */
-#line 1053 "parser.y"
-    {
+  case 206: /* help_command: BX_TOKEN_HELP BX_TOKEN_AVX '\n'  */
+#line 1063 "parser.y"
+       {
          dbg_printf("ymm - print AVX state\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3456 "y.tab.c"
     break;
 
-  case 205:
-/* Line 1787 of yacc.c  */
-#line 1058 "parser.y"
-    {
+  case 207: /* help_command: BX_TOKEN_HELP BX_TOKEN_SEGMENT_REGS '\n'  */
+#line 1068 "parser.y"
+       {
          dbg_printf("sreg - show segment registers\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3465 "y.tab.c"
     break;
 
-  case 206:
-/* Line 1787 of yacc.c  */
-#line 1063 "parser.y"
-    {
+  case 208: /* help_command: BX_TOKEN_HELP BX_TOKEN_CONTROL_REGS '\n'  */
+#line 1073 "parser.y"
+       {
          dbg_printf("creg - show control registers\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3474 "y.tab.c"
     break;
 
-  case 207:
-/* Line 1787 of yacc.c  */
-#line 1068 "parser.y"
-    {
+  case 209: /* help_command: BX_TOKEN_HELP BX_TOKEN_DEBUG_REGS '\n'  */
+#line 1078 "parser.y"
+       {
          dbg_printf("dreg - show debug registers\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3483 "y.tab.c"
     break;
 
-  case 208:
-/* Line 1787 of yacc.c  */
-#line 1073 "parser.y"
-    {
+  case 210: /* help_command: BX_TOKEN_HELP BX_TOKEN_WRITEMEM '\n'  */
+#line 1083 "parser.y"
+       {
          dbg_printf("writemem <filename> <laddr> <len> - dump 'len' bytes of virtual memory starting from the linear address 'laddr' into the file\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3492 "y.tab.c"
     break;
 
-  case 209:
-/* Line 1787 of yacc.c  */
-#line 1078 "parser.y"
-    {
+  case 211: /* help_command: BX_TOKEN_HELP BX_TOKEN_SETPMEM '\n'  */
+#line 1088 "parser.y"
+       {
          dbg_printf("setpmem <addr> <datasize> <val> - set physical memory location of size 'datasize' to value 'val'\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3501 "y.tab.c"
     break;
 
-  case 210:
-/* Line 1787 of yacc.c  */
-#line 1083 "parser.y"
-    {
+  case 212: /* help_command: BX_TOKEN_HELP BX_TOKEN_DISASM '\n'  */
+#line 1093 "parser.y"
+       {
          dbg_printf("u|disasm [/count] <start> <end> - disassemble instructions for given linear address\n");
          dbg_printf("    Optional 'count' is the number of disassembled instructions\n");
          dbg_printf("u|disasm switch-mode - switch between Intel and AT&T disassembler syntax\n");
          dbg_printf("u|disasm hex on/off - control disasm offsets and displacements format\n");
          dbg_printf("u|disasm size = n - tell debugger what segment size [16|32|64] to use\n");
          dbg_printf("       when \"disassemble\" command is used.\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3515 "y.tab.c"
     break;
 
-  case 211:
-/* Line 1787 of yacc.c  */
-#line 1093 "parser.y"
-    {
+  case 213: /* help_command: BX_TOKEN_HELP BX_TOKEN_WATCH '\n'  */
+#line 1103 "parser.y"
+       {
          dbg_printf("watch - print current watch point status\n");
          dbg_printf("watch stop - stop simulation when a watchpoint is encountred\n");
          dbg_printf("watch continue - do not stop the simulation when watch point is encountred\n");
@@ -3684,24 +3524,26 @@ yyreduce:
          dbg_printf("watch w|write addr - insert a write watch point at physical address addr\n");
          dbg_printf("watch r|read addr <len> - insert a read watch point at physical address addr with range <len>\n");
          dbg_printf("watch w|write addr <len> - insert a write watch point at physical address addr with range <len>\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         dbg_printf("watch vga \"text\" - stop simulation when text appears on the VGA text screen\n");
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3531 "y.tab.c"
     break;
 
-  case 212:
-/* Line 1787 of yacc.c  */
-#line 1104 "parser.y"
-    {
+  case 214: /* help_command: BX_TOKEN_HELP BX_TOKEN_UNWATCH '\n'  */
+#line 1115 "parser.y"
+       {
          dbg_printf("unwatch      - remove all watch points\n");
          dbg_printf("unwatch addr - remove a watch point\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         dbg_printf("unwatch vga \"text\" - remove a text watch\n");
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3542 "y.tab.c"
     break;
 
-  case 213:
-/* Line 1787 of yacc.c  */
-#line 1110 "parser.y"
-    {
+  case 215: /* help_command: BX_TOKEN_HELP BX_TOKEN_EXAMINE '\n'  */
+#line 1122 "parser.y"
+       {
          dbg_printf("x  /nuf <addr> - examine memory at linear address\n");
          dbg_printf("xp /nuf <addr> - examine memory at physical address\n");
          dbg_printf("    nuf is a sequence of numbers (how much values to display)\n");
@@ -3711,23 +3553,23 @@ yyreduce:
          dbg_printf("    b,h,w,g select the size of a data element (for byte, half-word,\n");
          dbg_printf("        word and giant word)\n");
          dbg_printf("    m selects an alternative output format (memory dump)\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3559 "y.tab.c"
     break;
 
-  case 214:
-/* Line 1787 of yacc.c  */
-#line 1123 "parser.y"
-    {
+  case 216: /* help_command: BX_TOKEN_HELP BX_TOKEN_INSTRUMENT '\n'  */
+#line 1135 "parser.y"
+       {
          dbg_printf("instrument <command> - calls BX_INSTR_DEBUG_CMD instrumentation callback with <command>\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3568 "y.tab.c"
     break;
 
-  case 215:
-/* Line 1787 of yacc.c  */
-#line 1128 "parser.y"
-    {
+  case 217: /* help_command: BX_TOKEN_HELP BX_TOKEN_SET '\n'  */
+#line 1140 "parser.y"
+       {
          dbg_printf("set <regname> = <expr> - set register value to expression\n");
          dbg_printf("set eflags = <expr> - set eflags value to expression, not all flags can be modified\n");
          dbg_printf("set $cpu = <N> - move debugger control to cpu <N> in SMP simulation\n");
@@ -3735,23 +3577,23 @@ yyreduce:
          dbg_printf("       every time execution stops\n");
          dbg_printf("set u|disasm|disassemble on  - same as 'set $auto_disassemble = 1'\n");
          dbg_printf("set u|disasm|disassemble off - same as 'set $auto_disassemble = 0'\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3583 "y.tab.c"
     break;
 
-  case 216:
-/* Line 1787 of yacc.c  */
-#line 1139 "parser.y"
-    {
+  case 218: /* help_command: BX_TOKEN_HELP BX_TOKEN_PAGE '\n'  */
+#line 1151 "parser.y"
+       {
          dbg_printf("page <laddr> - show linear to physical xlation for linear address laddr\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3592 "y.tab.c"
     break;
 
-  case 217:
-/* Line 1787 of yacc.c  */
-#line 1144 "parser.y"
-    {
+  case 219: /* help_command: BX_TOKEN_HELP BX_TOKEN_INFO '\n'  */
+#line 1156 "parser.y"
+       {
          dbg_printf("info break - show information about current breakpoint status\n");
          dbg_printf("info idt - show interrupt descriptor table\n");
          dbg_printf("info ivt - show interrupt vector table\n");
@@ -3763,14 +3605,14 @@ yyreduce:
          dbg_printf("info device - show list of devices supported by this command\n");
          dbg_printf("info device [string] - show state of device specified in string\n");
          dbg_printf("info device [string] [string] - show state of device with options\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3611 "y.tab.c"
     break;
 
-  case 218:
-/* Line 1787 of yacc.c  */
-#line 1159 "parser.y"
-    {
+  case 220: /* help_command: BX_TOKEN_HELP BX_TOKEN_SHOW '\n'  */
+#line 1171 "parser.y"
+       {
          dbg_printf("show <command> - toggles show symbolic info (calls to begin with)\n");
          dbg_printf("show - shows current show mode\n");
          dbg_printf("show mode - show, when processor switch mode\n");
@@ -3779,348 +3621,349 @@ yyreduce:
          dbg_printf("show off - toggles off symbolic info\n");
          dbg_printf("show dbg-all - turn on all show flags\n");
          dbg_printf("show dbg-none - turn off all show flags\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3627 "y.tab.c"
     break;
 
-  case 219:
-/* Line 1787 of yacc.c  */
-#line 1171 "parser.y"
-    {
+  case 221: /* help_command: BX_TOKEN_HELP BX_TOKEN_CALC '\n'  */
+#line 1183 "parser.y"
+       {
          dbg_printf("calc|? <expr> - calculate a expression and display the result.\n");
          dbg_printf("    'expr' can reference any general-purpose and segment\n");
          dbg_printf("    registers, use any arithmetic and logic operations, and\n");
          dbg_printf("    also the special ':' operator which computes the linear\n");
          dbg_printf("    address for a segment:offset (in real and v86 mode) or\n");
          dbg_printf("    of a selector:offset (in protected mode) pair.\n");
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3641 "y.tab.c"
     break;
 
-  case 220:
-/* Line 1787 of yacc.c  */
-#line 1181 "parser.y"
-    {
+  case 222: /* help_command: BX_TOKEN_HELP BX_TOKEN_HELP '\n'  */
+#line 1193 "parser.y"
+       {
          bx_dbg_print_help();
-         free((yyvsp[(1) - (3)].sval));free((yyvsp[(2) - (3)].sval));
+         free((yyvsp[-2].sval));free((yyvsp[-1].sval));
        }
+#line 3650 "y.tab.c"
     break;
 
-  case 221:
-/* Line 1787 of yacc.c  */
-#line 1186 "parser.y"
-    {
+  case 223: /* help_command: BX_TOKEN_HELP '\n'  */
+#line 1198 "parser.y"
+       {
          bx_dbg_print_help();
-         free((yyvsp[(1) - (2)].sval));
+         free((yyvsp[-1].sval));
        }
+#line 3659 "y.tab.c"
     break;
 
-  case 222:
-/* Line 1787 of yacc.c  */
-#line 1194 "parser.y"
-    {
-     bx_dbg_calc_command((yyvsp[(2) - (3)].uval));
-     free((yyvsp[(1) - (3)].sval));
+  case 224: /* calc_command: BX_TOKEN_CALC expression '\n'  */
+#line 1206 "parser.y"
+   {
+     bx_dbg_calc_command((yyvsp[-1].uval));
+     free((yyvsp[-2].sval));
    }
+#line 3668 "y.tab.c"
     break;
 
-  case 223:
-/* Line 1787 of yacc.c  */
-#line 1211 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (1)].uval); }
-    break;
-
-  case 224:
-/* Line 1787 of yacc.c  */
-#line 1212 "parser.y"
-    { (yyval.uval) = bx_dbg_get_symbol_value((yyvsp[(1) - (1)].sval)); free((yyvsp[(1) - (1)].sval));}
-    break;
-
-  case 225:
-/* Line 1787 of yacc.c  */
-#line 1213 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg8l_value((yyvsp[(1) - (1)].uval)); }
-    break;
-
-  case 226:
-/* Line 1787 of yacc.c  */
-#line 1214 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg8h_value((yyvsp[(1) - (1)].uval)); }
-    break;
-
-  case 227:
-/* Line 1787 of yacc.c  */
-#line 1215 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg16_value((yyvsp[(1) - (1)].uval)); }
-    break;
-
-  case 228:
-/* Line 1787 of yacc.c  */
-#line 1216 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg32_value((yyvsp[(1) - (1)].uval)); }
-    break;
-
-  case 229:
-/* Line 1787 of yacc.c  */
-#line 1217 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg64_value((yyvsp[(1) - (1)].uval)); }
-    break;
-
-  case 230:
-/* Line 1787 of yacc.c  */
-#line 1218 "parser.y"
-    { (yyval.uval) = bx_dbg_get_selector_value((yyvsp[(1) - (1)].uval)); }
-    break;
-
-  case 231:
-/* Line 1787 of yacc.c  */
-#line 1219 "parser.y"
-    { (yyval.uval) = bx_dbg_get_ip (); }
-    break;
-
-  case 232:
-/* Line 1787 of yacc.c  */
-#line 1220 "parser.y"
-    { (yyval.uval) = bx_dbg_get_eip(); }
-    break;
-
-  case 233:
-/* Line 1787 of yacc.c  */
-#line 1221 "parser.y"
-    { (yyval.uval) = bx_dbg_get_instruction_pointer(); }
-    break;
-
-  case 234:
-/* Line 1787 of yacc.c  */
-#line 1222 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) + (yyvsp[(3) - (3)].uval); }
-    break;
-
-  case 235:
-/* Line 1787 of yacc.c  */
+  case 225: /* vexpression: BX_TOKEN_NUMERIC  */
 #line 1223 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) - (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = (yyvsp[0].uval); }
+#line 3674 "y.tab.c"
     break;
 
-  case 236:
-/* Line 1787 of yacc.c  */
+  case 226: /* vexpression: BX_TOKEN_STRING  */
 #line 1224 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) * (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_symbol_value((yyvsp[0].sval)); free((yyvsp[0].sval));}
+#line 3680 "y.tab.c"
     break;
 
-  case 237:
-/* Line 1787 of yacc.c  */
+  case 227: /* vexpression: BX_TOKEN_8BL_REG  */
 #line 1225 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) / (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg8l_value((yyvsp[0].uval)); }
+#line 3686 "y.tab.c"
     break;
 
-  case 238:
-/* Line 1787 of yacc.c  */
+  case 228: /* vexpression: BX_TOKEN_8BH_REG  */
 #line 1226 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) >> (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg8h_value((yyvsp[0].uval)); }
+#line 3692 "y.tab.c"
     break;
 
-  case 239:
-/* Line 1787 of yacc.c  */
+  case 229: /* vexpression: BX_TOKEN_16B_REG  */
 #line 1227 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) << (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg16_value((yyvsp[0].uval)); }
+#line 3698 "y.tab.c"
     break;
 
-  case 240:
-/* Line 1787 of yacc.c  */
+  case 230: /* vexpression: BX_TOKEN_32B_REG  */
 #line 1228 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) | (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg32_value((yyvsp[0].uval)); }
+#line 3704 "y.tab.c"
     break;
 
-  case 241:
-/* Line 1787 of yacc.c  */
+  case 231: /* vexpression: BX_TOKEN_64B_REG  */
 #line 1229 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) ^ (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg64_value((yyvsp[0].uval)); }
+#line 3710 "y.tab.c"
     break;
 
-  case 242:
-/* Line 1787 of yacc.c  */
+  case 232: /* vexpression: BX_TOKEN_SEGREG  */
 #line 1230 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) & (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_selector_value((yyvsp[0].uval)); }
+#line 3716 "y.tab.c"
     break;
 
-  case 243:
-/* Line 1787 of yacc.c  */
+  case 233: /* vexpression: BX_TOKEN_REG_IP  */
 #line 1231 "parser.y"
-    { (yyval.uval) = !(yyvsp[(2) - (2)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_ip (); }
+#line 3722 "y.tab.c"
     break;
 
-  case 244:
-/* Line 1787 of yacc.c  */
+  case 234: /* vexpression: BX_TOKEN_REG_EIP  */
 #line 1232 "parser.y"
-    { (yyval.uval) = -(yyvsp[(2) - (2)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_eip(); }
+#line 3728 "y.tab.c"
     break;
 
-  case 245:
-/* Line 1787 of yacc.c  */
+  case 235: /* vexpression: BX_TOKEN_REG_RIP  */
 #line 1233 "parser.y"
-    { (yyval.uval) = (yyvsp[(2) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_instruction_pointer(); }
+#line 3734 "y.tab.c"
     break;
 
-  case 246:
-/* Line 1787 of yacc.c  */
-#line 1239 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (1)].uval); }
+  case 236: /* vexpression: vexpression '+' vexpression  */
+#line 1234 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) + (yyvsp[0].uval); }
+#line 3740 "y.tab.c"
     break;
 
-  case 247:
-/* Line 1787 of yacc.c  */
-#line 1240 "parser.y"
-    { (yyval.uval) = bx_dbg_get_symbol_value((yyvsp[(1) - (1)].sval)); free((yyvsp[(1) - (1)].sval));}
+  case 237: /* vexpression: vexpression '-' vexpression  */
+#line 1235 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) - (yyvsp[0].uval); }
+#line 3746 "y.tab.c"
     break;
 
-  case 248:
-/* Line 1787 of yacc.c  */
-#line 1241 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg8l_value((yyvsp[(1) - (1)].uval)); }
+  case 238: /* vexpression: vexpression '*' vexpression  */
+#line 1236 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) * (yyvsp[0].uval); }
+#line 3752 "y.tab.c"
     break;
 
-  case 249:
-/* Line 1787 of yacc.c  */
-#line 1242 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg8h_value((yyvsp[(1) - (1)].uval)); }
+  case 239: /* vexpression: vexpression '/' vexpression  */
+#line 1237 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) / (yyvsp[0].uval); }
+#line 3758 "y.tab.c"
     break;
 
-  case 250:
-/* Line 1787 of yacc.c  */
-#line 1243 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg16_value((yyvsp[(1) - (1)].uval)); }
+  case 240: /* vexpression: vexpression BX_TOKEN_RSHIFT vexpression  */
+#line 1238 "parser.y"
+                                             { (yyval.uval) = (yyvsp[-2].uval) >> (yyvsp[0].uval); }
+#line 3764 "y.tab.c"
     break;
 
-  case 251:
-/* Line 1787 of yacc.c  */
-#line 1244 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg32_value((yyvsp[(1) - (1)].uval)); }
+  case 241: /* vexpression: vexpression BX_TOKEN_LSHIFT vexpression  */
+#line 1239 "parser.y"
+                                             { (yyval.uval) = (yyvsp[-2].uval) << (yyvsp[0].uval); }
+#line 3770 "y.tab.c"
     break;
 
-  case 252:
-/* Line 1787 of yacc.c  */
-#line 1245 "parser.y"
-    { (yyval.uval) = bx_dbg_get_reg64_value((yyvsp[(1) - (1)].uval)); }
+  case 242: /* vexpression: vexpression '|' vexpression  */
+#line 1240 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) | (yyvsp[0].uval); }
+#line 3776 "y.tab.c"
     break;
 
-  case 253:
-/* Line 1787 of yacc.c  */
-#line 1246 "parser.y"
-    { (yyval.uval) = bx_dbg_get_selector_value((yyvsp[(1) - (1)].uval)); }
+  case 243: /* vexpression: vexpression '^' vexpression  */
+#line 1241 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) ^ (yyvsp[0].uval); }
+#line 3782 "y.tab.c"
     break;
 
-  case 254:
-/* Line 1787 of yacc.c  */
-#line 1247 "parser.y"
-    { (yyval.uval) = bx_dbg_get_ip (); }
+  case 244: /* vexpression: vexpression '&' vexpression  */
+#line 1242 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) & (yyvsp[0].uval); }
+#line 3788 "y.tab.c"
     break;
 
-  case 255:
-/* Line 1787 of yacc.c  */
-#line 1248 "parser.y"
-    { (yyval.uval) = bx_dbg_get_eip(); }
+  case 245: /* vexpression: '!' vexpression  */
+#line 1243 "parser.y"
+                                     { (yyval.uval) = !(yyvsp[0].uval); }
+#line 3794 "y.tab.c"
     break;
 
-  case 256:
-/* Line 1787 of yacc.c  */
-#line 1249 "parser.y"
-    { (yyval.uval) = bx_dbg_get_instruction_pointer(); }
+  case 246: /* vexpression: '-' vexpression  */
+#line 1244 "parser.y"
+                                     { (yyval.uval) = -(yyvsp[0].uval); }
+#line 3800 "y.tab.c"
     break;
 
-  case 257:
-/* Line 1787 of yacc.c  */
-#line 1250 "parser.y"
-    { (yyval.uval) = bx_dbg_get_laddr ((yyvsp[(1) - (3)].uval), (yyvsp[(3) - (3)].uval)); }
+  case 247: /* vexpression: '(' vexpression ')'  */
+#line 1245 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-1].uval); }
+#line 3806 "y.tab.c"
     break;
 
-  case 258:
-/* Line 1787 of yacc.c  */
+  case 248: /* expression: BX_TOKEN_NUMERIC  */
 #line 1251 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) + (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = (yyvsp[0].uval); }
+#line 3812 "y.tab.c"
     break;
 
-  case 259:
-/* Line 1787 of yacc.c  */
+  case 249: /* expression: BX_TOKEN_STRING  */
 #line 1252 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) - (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_symbol_value((yyvsp[0].sval)); free((yyvsp[0].sval));}
+#line 3818 "y.tab.c"
     break;
 
-  case 260:
-/* Line 1787 of yacc.c  */
+  case 250: /* expression: BX_TOKEN_8BL_REG  */
 #line 1253 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) * (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg8l_value((yyvsp[0].uval)); }
+#line 3824 "y.tab.c"
     break;
 
-  case 261:
-/* Line 1787 of yacc.c  */
+  case 251: /* expression: BX_TOKEN_8BH_REG  */
 #line 1254 "parser.y"
-    { (yyval.uval) = ((yyvsp[(3) - (3)].uval) != 0) ? (yyvsp[(1) - (3)].uval) / (yyvsp[(3) - (3)].uval) : 0; }
+                                     { (yyval.uval) = bx_dbg_get_reg8h_value((yyvsp[0].uval)); }
+#line 3830 "y.tab.c"
     break;
 
-  case 262:
-/* Line 1787 of yacc.c  */
+  case 252: /* expression: BX_TOKEN_16B_REG  */
 #line 1255 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) >> (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg16_value((yyvsp[0].uval)); }
+#line 3836 "y.tab.c"
     break;
 
-  case 263:
-/* Line 1787 of yacc.c  */
+  case 253: /* expression: BX_TOKEN_32B_REG  */
 #line 1256 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) << (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg32_value((yyvsp[0].uval)); }
+#line 3842 "y.tab.c"
     break;
 
-  case 264:
-/* Line 1787 of yacc.c  */
+  case 254: /* expression: BX_TOKEN_64B_REG  */
 #line 1257 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) | (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_reg64_value((yyvsp[0].uval)); }
+#line 3848 "y.tab.c"
     break;
 
-  case 265:
-/* Line 1787 of yacc.c  */
+  case 255: /* expression: BX_TOKEN_SEGREG  */
 #line 1258 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) ^ (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_selector_value((yyvsp[0].uval)); }
+#line 3854 "y.tab.c"
     break;
 
-  case 266:
-/* Line 1787 of yacc.c  */
+  case 256: /* expression: BX_TOKEN_REG_IP  */
 #line 1259 "parser.y"
-    { (yyval.uval) = (yyvsp[(1) - (3)].uval) & (yyvsp[(3) - (3)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_ip (); }
+#line 3860 "y.tab.c"
     break;
 
-  case 267:
-/* Line 1787 of yacc.c  */
+  case 257: /* expression: BX_TOKEN_REG_EIP  */
 #line 1260 "parser.y"
-    { (yyval.uval) = !(yyvsp[(2) - (2)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_eip(); }
+#line 3866 "y.tab.c"
     break;
 
-  case 268:
-/* Line 1787 of yacc.c  */
+  case 258: /* expression: BX_TOKEN_REG_RIP  */
 #line 1261 "parser.y"
-    { (yyval.uval) = -(yyvsp[(2) - (2)].uval); }
+                                     { (yyval.uval) = bx_dbg_get_instruction_pointer(); }
+#line 3872 "y.tab.c"
     break;
 
-  case 269:
-/* Line 1787 of yacc.c  */
+  case 259: /* expression: expression ':' expression  */
 #line 1262 "parser.y"
-    { (yyval.uval) = bx_dbg_lin_indirect((yyvsp[(2) - (2)].uval)); }
+                                     { (yyval.uval) = bx_dbg_get_laddr ((yyvsp[-2].uval), (yyvsp[0].uval)); }
+#line 3878 "y.tab.c"
     break;
 
-  case 270:
-/* Line 1787 of yacc.c  */
+  case 260: /* expression: expression '+' expression  */
 #line 1263 "parser.y"
-    { (yyval.uval) = bx_dbg_phy_indirect((yyvsp[(2) - (2)].uval)); }
+                                     { (yyval.uval) = (yyvsp[-2].uval) + (yyvsp[0].uval); }
+#line 3884 "y.tab.c"
     break;
 
-  case 271:
-/* Line 1787 of yacc.c  */
+  case 261: /* expression: expression '-' expression  */
 #line 1264 "parser.y"
-    { (yyval.uval) = (yyvsp[(2) - (3)].uval); }
+                                     { (yyval.uval) = (yyvsp[-2].uval) - (yyvsp[0].uval); }
+#line 3890 "y.tab.c"
+    break;
+
+  case 262: /* expression: expression '*' expression  */
+#line 1265 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) * (yyvsp[0].uval); }
+#line 3896 "y.tab.c"
+    break;
+
+  case 263: /* expression: expression '/' expression  */
+#line 1266 "parser.y"
+                                     { (yyval.uval) = ((yyvsp[0].uval) != 0) ? (yyvsp[-2].uval) / (yyvsp[0].uval) : 0; }
+#line 3902 "y.tab.c"
+    break;
+
+  case 264: /* expression: expression BX_TOKEN_RSHIFT expression  */
+#line 1267 "parser.y"
+                                           { (yyval.uval) = (yyvsp[-2].uval) >> (yyvsp[0].uval); }
+#line 3908 "y.tab.c"
+    break;
+
+  case 265: /* expression: expression BX_TOKEN_LSHIFT expression  */
+#line 1268 "parser.y"
+                                           { (yyval.uval) = (yyvsp[-2].uval) << (yyvsp[0].uval); }
+#line 3914 "y.tab.c"
+    break;
+
+  case 266: /* expression: expression '|' expression  */
+#line 1269 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) | (yyvsp[0].uval); }
+#line 3920 "y.tab.c"
+    break;
+
+  case 267: /* expression: expression '^' expression  */
+#line 1270 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) ^ (yyvsp[0].uval); }
+#line 3926 "y.tab.c"
+    break;
+
+  case 268: /* expression: expression '&' expression  */
+#line 1271 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-2].uval) & (yyvsp[0].uval); }
+#line 3932 "y.tab.c"
+    break;
+
+  case 269: /* expression: '!' expression  */
+#line 1272 "parser.y"
+                                     { (yyval.uval) = !(yyvsp[0].uval); }
+#line 3938 "y.tab.c"
+    break;
+
+  case 270: /* expression: '-' expression  */
+#line 1273 "parser.y"
+                                     { (yyval.uval) = -(yyvsp[0].uval); }
+#line 3944 "y.tab.c"
+    break;
+
+  case 271: /* expression: '*' expression  */
+#line 1274 "parser.y"
+                                     { (yyval.uval) = bx_dbg_lin_indirect((yyvsp[0].uval)); }
+#line 3950 "y.tab.c"
+    break;
+
+  case 272: /* expression: '@' expression  */
+#line 1275 "parser.y"
+                                     { (yyval.uval) = bx_dbg_phy_indirect((yyvsp[0].uval)); }
+#line 3956 "y.tab.c"
+    break;
+
+  case 273: /* expression: '(' expression ')'  */
+#line 1276 "parser.y"
+                                     { (yyval.uval) = (yyvsp[-1].uval); }
+#line 3962 "y.tab.c"
     break;
 
 
-/* Line 1787 of yacc.c  */
-#line 4124 "y.tab.c"
+#line 3966 "y.tab.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -4134,96 +3977,58 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -4235,14 +4040,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -4255,29 +4059,30 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -4289,7 +4094,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -4300,26 +4105,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -4328,31 +4137,25 @@ yyreturn:
       yydestruct ("Cleanup: discarding lookahead",
                   yytoken, &yylval);
     }
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
 
+  return yyresult;
+}
 
-/* Line 2050 of yacc.c  */
-#line 1267 "parser.y"
+#line 1279 "parser.y"
 
 #endif  /* if BX_DEBUGGER */
 /* The #endif is appended by the makefile after running yacc. */
@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.7.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_BX_Y_TAB_H_INCLUDED
 # define YY_BX_Y_TAB_H_INCLUDED
-/* Enabling traces.  */
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
@@ -40,119 +45,127 @@
 extern int bxdebug;
 #endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     BX_TOKEN_8BH_REG = 258,
-     BX_TOKEN_8BL_REG = 259,
-     BX_TOKEN_16B_REG = 260,
-     BX_TOKEN_32B_REG = 261,
-     BX_TOKEN_64B_REG = 262,
-     BX_TOKEN_CS = 263,
-     BX_TOKEN_ES = 264,
-     BX_TOKEN_SS = 265,
-     BX_TOKEN_DS = 266,
-     BX_TOKEN_FS = 267,
-     BX_TOKEN_GS = 268,
-     BX_TOKEN_FLAGS = 269,
-     BX_TOKEN_ON = 270,
-     BX_TOKEN_OFF = 271,
-     BX_TOKEN_CONTINUE = 272,
-     BX_TOKEN_STEPN = 273,
-     BX_TOKEN_STEP_OVER = 274,
-     BX_TOKEN_SET = 275,
-     BX_TOKEN_DEBUGGER = 276,
-     BX_TOKEN_LIST_BREAK = 277,
-     BX_TOKEN_VBREAKPOINT = 278,
-     BX_TOKEN_LBREAKPOINT = 279,
-     BX_TOKEN_PBREAKPOINT = 280,
-     BX_TOKEN_DEL_BREAKPOINT = 281,
-     BX_TOKEN_ENABLE_BREAKPOINT = 282,
-     BX_TOKEN_DISABLE_BREAKPOINT = 283,
-     BX_TOKEN_INFO = 284,
-     BX_TOKEN_QUIT = 285,
-     BX_TOKEN_R = 286,
-     BX_TOKEN_REGS = 287,
-     BX_TOKEN_CPU = 288,
-     BX_TOKEN_FPU = 289,
-     BX_TOKEN_MMX = 290,
-     BX_TOKEN_SSE = 291,
-     BX_TOKEN_AVX = 292,
-     BX_TOKEN_IDT = 293,
-     BX_TOKEN_IVT = 294,
-     BX_TOKEN_GDT = 295,
-     BX_TOKEN_LDT = 296,
-     BX_TOKEN_TSS = 297,
-     BX_TOKEN_TAB = 298,
-     BX_TOKEN_ALL = 299,
-     BX_TOKEN_LINUX = 300,
-     BX_TOKEN_DEBUG_REGS = 301,
-     BX_TOKEN_CONTROL_REGS = 302,
-     BX_TOKEN_SEGMENT_REGS = 303,
-     BX_TOKEN_EXAMINE = 304,
-     BX_TOKEN_XFORMAT = 305,
-     BX_TOKEN_DISFORMAT = 306,
-     BX_TOKEN_RESTORE = 307,
-     BX_TOKEN_WRITEMEM = 308,
-     BX_TOKEN_SETPMEM = 309,
-     BX_TOKEN_SYMBOLNAME = 310,
-     BX_TOKEN_QUERY = 311,
-     BX_TOKEN_PENDING = 312,
-     BX_TOKEN_TAKE = 313,
-     BX_TOKEN_DMA = 314,
-     BX_TOKEN_IRQ = 315,
-     BX_TOKEN_TLB = 316,
-     BX_TOKEN_HEX = 317,
-     BX_TOKEN_DISASM = 318,
-     BX_TOKEN_INSTRUMENT = 319,
-     BX_TOKEN_STRING = 320,
-     BX_TOKEN_STOP = 321,
-     BX_TOKEN_DOIT = 322,
-     BX_TOKEN_CRC = 323,
-     BX_TOKEN_TRACE = 324,
-     BX_TOKEN_TRACEREG = 325,
-     BX_TOKEN_TRACEMEM = 326,
-     BX_TOKEN_SWITCH_MODE = 327,
-     BX_TOKEN_SIZE = 328,
-     BX_TOKEN_PTIME = 329,
-     BX_TOKEN_TIMEBP_ABSOLUTE = 330,
-     BX_TOKEN_TIMEBP = 331,
-     BX_TOKEN_MODEBP = 332,
-     BX_TOKEN_VMEXITBP = 333,
-     BX_TOKEN_PRINT_STACK = 334,
-     BX_TOKEN_WATCH = 335,
-     BX_TOKEN_UNWATCH = 336,
-     BX_TOKEN_READ = 337,
-     BX_TOKEN_WRITE = 338,
-     BX_TOKEN_SHOW = 339,
-     BX_TOKEN_LOAD_SYMBOLS = 340,
-     BX_TOKEN_SYMBOLS = 341,
-     BX_TOKEN_LIST_SYMBOLS = 342,
-     BX_TOKEN_GLOBAL = 343,
-     BX_TOKEN_WHERE = 344,
-     BX_TOKEN_PRINT_STRING = 345,
-     BX_TOKEN_NUMERIC = 346,
-     BX_TOKEN_PAGE = 347,
-     BX_TOKEN_HELP = 348,
-     BX_TOKEN_CALC = 349,
-     BX_TOKEN_VGA = 350,
-     BX_TOKEN_DEVICE = 351,
-     BX_TOKEN_COMMAND = 352,
-     BX_TOKEN_GENERIC = 353,
-     BX_TOKEN_RSHIFT = 354,
-     BX_TOKEN_LSHIFT = 355,
-     BX_TOKEN_REG_IP = 356,
-     BX_TOKEN_REG_EIP = 357,
-     BX_TOKEN_REG_RIP = 358,
-     INDIRECT = 359,
-     NEG = 360,
-     NOT = 361
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    BX_TOKEN_8BH_REG = 258,        /* BX_TOKEN_8BH_REG  */
+    BX_TOKEN_8BL_REG = 259,        /* BX_TOKEN_8BL_REG  */
+    BX_TOKEN_16B_REG = 260,        /* BX_TOKEN_16B_REG  */
+    BX_TOKEN_32B_REG = 261,        /* BX_TOKEN_32B_REG  */
+    BX_TOKEN_64B_REG = 262,        /* BX_TOKEN_64B_REG  */
+    BX_TOKEN_CS = 263,             /* BX_TOKEN_CS  */
+    BX_TOKEN_ES = 264,             /* BX_TOKEN_ES  */
+    BX_TOKEN_SS = 265,             /* BX_TOKEN_SS  */
+    BX_TOKEN_DS = 266,             /* BX_TOKEN_DS  */
+    BX_TOKEN_FS = 267,             /* BX_TOKEN_FS  */
+    BX_TOKEN_GS = 268,             /* BX_TOKEN_GS  */
+    BX_TOKEN_FLAGS = 269,          /* BX_TOKEN_FLAGS  */
+    BX_TOKEN_ON = 270,             /* BX_TOKEN_ON  */
+    BX_TOKEN_OFF = 271,            /* BX_TOKEN_OFF  */
+    BX_TOKEN_CONTINUE = 272,       /* BX_TOKEN_CONTINUE  */
+    BX_TOKEN_STEPN = 273,          /* BX_TOKEN_STEPN  */
+    BX_TOKEN_STEP_OVER = 274,      /* BX_TOKEN_STEP_OVER  */
+    BX_TOKEN_SET = 275,            /* BX_TOKEN_SET  */
+    BX_TOKEN_DEBUGGER = 276,       /* BX_TOKEN_DEBUGGER  */
+    BX_TOKEN_LIST_BREAK = 277,     /* BX_TOKEN_LIST_BREAK  */
+    BX_TOKEN_VBREAKPOINT = 278,    /* BX_TOKEN_VBREAKPOINT  */
+    BX_TOKEN_LBREAKPOINT = 279,    /* BX_TOKEN_LBREAKPOINT  */
+    BX_TOKEN_PBREAKPOINT = 280,    /* BX_TOKEN_PBREAKPOINT  */
+    BX_TOKEN_DEL_BREAKPOINT = 281, /* BX_TOKEN_DEL_BREAKPOINT  */
+    BX_TOKEN_ENABLE_BREAKPOINT = 282, /* BX_TOKEN_ENABLE_BREAKPOINT  */
+    BX_TOKEN_DISABLE_BREAKPOINT = 283, /* BX_TOKEN_DISABLE_BREAKPOINT  */
+    BX_TOKEN_INFO = 284,           /* BX_TOKEN_INFO  */
+    BX_TOKEN_QUIT = 285,           /* BX_TOKEN_QUIT  */
+    BX_TOKEN_R = 286,              /* BX_TOKEN_R  */
+    BX_TOKEN_REGS = 287,           /* BX_TOKEN_REGS  */
+    BX_TOKEN_CPU = 288,            /* BX_TOKEN_CPU  */
+    BX_TOKEN_FPU = 289,            /* BX_TOKEN_FPU  */
+    BX_TOKEN_MMX = 290,            /* BX_TOKEN_MMX  */
+    BX_TOKEN_SSE = 291,            /* BX_TOKEN_SSE  */
+    BX_TOKEN_AVX = 292,            /* BX_TOKEN_AVX  */
+    BX_TOKEN_IDT = 293,            /* BX_TOKEN_IDT  */
+    BX_TOKEN_IVT = 294,            /* BX_TOKEN_IVT  */
+    BX_TOKEN_GDT = 295,            /* BX_TOKEN_GDT  */
+    BX_TOKEN_LDT = 296,            /* BX_TOKEN_LDT  */
+    BX_TOKEN_TSS = 297,            /* BX_TOKEN_TSS  */
+    BX_TOKEN_TAB = 298,            /* BX_TOKEN_TAB  */
+    BX_TOKEN_ALL = 299,            /* BX_TOKEN_ALL  */
+    BX_TOKEN_LINUX = 300,          /* BX_TOKEN_LINUX  */
+    BX_TOKEN_DEBUG_REGS = 301,     /* BX_TOKEN_DEBUG_REGS  */
+    BX_TOKEN_CONTROL_REGS = 302,   /* BX_TOKEN_CONTROL_REGS  */
+    BX_TOKEN_SEGMENT_REGS = 303,   /* BX_TOKEN_SEGMENT_REGS  */
+    BX_TOKEN_EXAMINE = 304,        /* BX_TOKEN_EXAMINE  */
+    BX_TOKEN_XFORMAT = 305,        /* BX_TOKEN_XFORMAT  */
+    BX_TOKEN_DISFORMAT = 306,      /* BX_TOKEN_DISFORMAT  */
+    BX_TOKEN_RESTORE = 307,        /* BX_TOKEN_RESTORE  */
+    BX_TOKEN_WRITEMEM = 308,       /* BX_TOKEN_WRITEMEM  */
+    BX_TOKEN_SETPMEM = 309,        /* BX_TOKEN_SETPMEM  */
+    BX_TOKEN_SYMBOLNAME = 310,     /* BX_TOKEN_SYMBOLNAME  */
+    BX_TOKEN_QUERY = 311,          /* BX_TOKEN_QUERY  */
+    BX_TOKEN_PENDING = 312,        /* BX_TOKEN_PENDING  */
+    BX_TOKEN_TAKE = 313,           /* BX_TOKEN_TAKE  */
+    BX_TOKEN_DMA = 314,            /* BX_TOKEN_DMA  */
+    BX_TOKEN_IRQ = 315,            /* BX_TOKEN_IRQ  */
+    BX_TOKEN_TLB = 316,            /* BX_TOKEN_TLB  */
+    BX_TOKEN_HEX = 317,            /* BX_TOKEN_HEX  */
+    BX_TOKEN_DISASM = 318,         /* BX_TOKEN_DISASM  */
+    BX_TOKEN_INSTRUMENT = 319,     /* BX_TOKEN_INSTRUMENT  */
+    BX_TOKEN_STRING = 320,         /* BX_TOKEN_STRING  */
+    BX_TOKEN_STOP = 321,           /* BX_TOKEN_STOP  */
+    BX_TOKEN_DOIT = 322,           /* BX_TOKEN_DOIT  */
+    BX_TOKEN_CRC = 323,            /* BX_TOKEN_CRC  */
+    BX_TOKEN_TRACE = 324,          /* BX_TOKEN_TRACE  */
+    BX_TOKEN_TRACEREG = 325,       /* BX_TOKEN_TRACEREG  */
+    BX_TOKEN_TRACEMEM = 326,       /* BX_TOKEN_TRACEMEM  */
+    BX_TOKEN_SWITCH_MODE = 327,    /* BX_TOKEN_SWITCH_MODE  */
+    BX_TOKEN_SIZE = 328,           /* BX_TOKEN_SIZE  */
+    BX_TOKEN_PTIME = 329,          /* BX_TOKEN_PTIME  */
+    BX_TOKEN_TIMEBP_ABSOLUTE = 330, /* BX_TOKEN_TIMEBP_ABSOLUTE  */
+    BX_TOKEN_TIMEBP = 331,         /* BX_TOKEN_TIMEBP  */
+    BX_TOKEN_MODEBP = 332,         /* BX_TOKEN_MODEBP  */
+    BX_TOKEN_VMEXITBP = 333,       /* BX_TOKEN_VMEXITBP  */
+    BX_TOKEN_PRINT_STACK = 334,    /* BX_TOKEN_PRINT_STACK  */
+    BX_TOKEN_WATCH = 335,          /* BX_TOKEN_WATCH  */
+    BX_TOKEN_UNWATCH = 336,        /* BX_TOKEN_UNWATCH  */
+    BX_TOKEN_READ = 337,           /* BX_TOKEN_READ  */
+    BX_TOKEN_WRITE = 338,          /* BX_TOKEN_WRITE  */
+    BX_TOKEN_SHOW = 339,           /* BX_TOKEN_SHOW  */
+    BX_TOKEN_LOAD_SYMBOLS = 340,   /* BX_TOKEN_LOAD_SYMBOLS  */
+    BX_TOKEN_SYMBOLS = 341,        /* BX_TOKEN_SYMBOLS  */
+    BX_TOKEN_LIST_SYMBOLS = 342,   /* BX_TOKEN_LIST_SYMBOLS  */
+    BX_TOKEN_GLOBAL = 343,         /* BX_TOKEN_GLOBAL  */
+    BX_TOKEN_WHERE = 344,          /* BX_TOKEN_WHERE  */
+    BX_TOKEN_PRINT_STRING = 345,   /* BX_TOKEN_PRINT_STRING  */
+    BX_TOKEN_NUMERIC = 346,        /* BX_TOKEN_NUMERIC  */
+    BX_TOKEN_PAGE = 347,           /* BX_TOKEN_PAGE  */
+    BX_TOKEN_HELP = 348,           /* BX_TOKEN_HELP  */
+    BX_TOKEN_CALC = 349,           /* BX_TOKEN_CALC  */
+    BX_TOKEN_VGA = 350,            /* BX_TOKEN_VGA  */
+    BX_TOKEN_DEVICE = 351,         /* BX_TOKEN_DEVICE  */
+    BX_TOKEN_COMMAND = 352,        /* BX_TOKEN_COMMAND  */
+    BX_TOKEN_GENERIC = 353,        /* BX_TOKEN_GENERIC  */
+    BX_TOKEN_RSHIFT = 354,         /* BX_TOKEN_RSHIFT  */
+    BX_TOKEN_LSHIFT = 355,         /* BX_TOKEN_LSHIFT  */
+    BX_TOKEN_REG_IP = 356,         /* BX_TOKEN_REG_IP  */
+    BX_TOKEN_REG_EIP = 357,        /* BX_TOKEN_REG_EIP  */
+    BX_TOKEN_REG_RIP = 358,        /* BX_TOKEN_REG_RIP  */
+    NOT = 359,                     /* NOT  */
+    NEG = 360,                     /* NEG  */
+    INDIRECT = 361                 /* INDIRECT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define BX_TOKEN_8BH_REG 258
 #define BX_TOKEN_8BL_REG 259
 #define BX_TOKEN_16B_REG 260
@@ -254,45 +267,33 @@ extern int bxdebug;
 #define BX_TOKEN_REG_IP 356
 #define BX_TOKEN_REG_EIP 357
 #define BX_TOKEN_REG_RIP 358
-#define INDIRECT 359
+#define NOT 359
 #define NEG 360
-#define NOT 361
-
-
+#define INDIRECT 361
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-/* Line 2053 of yacc.c  */
 #line 13 "parser.y"
 
   char    *sval;
   Bit64u   uval;
   bx_bool  bval;
 
+#line 285 "y.tab.h"
 
-/* Line 2053 of yacc.c  */
-#line 276 "y.tab.h"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
+
 extern YYSTYPE bxlval;
 
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int bxparse (void *YYPARSE_PARAM);
-#else
-int bxparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
+
 int bxparse (void);
-#else
-int bxparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
+
 
 #endif /* !YY_BX_Y_TAB_H_INCLUDED  */
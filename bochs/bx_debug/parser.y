@@ -344,6 +344,11 @@ watch_point_command:
           bx_dbg_print_watchpoints();
           free($1);
       }
+    | BX_TOKEN_WATCH BX_TOKEN_VGA BX_TOKEN_STRING '\n'
+      {
+          bx_dbg_text_watch($3);
+          free($1); free($2); free($3);
+      }
     | BX_TOKEN_WATCH BX_TOKEN_R expression '\n'
       {
           bx_dbg_watch(0, $3, 1); /* BX_READ */
@@ -384,6 +389,11 @@ watch_point_command:
           bx_dbg_unwatch($2);
           free($1);
       }
+    | BX_TOKEN_UNWATCH BX_TOKEN_VGA BX_TOKEN_STRING '\n'
+      {
+          bx_dbg_unwatch_text($3);
+          free($1); free($2); free($3);
+      }
     ;
 
 symbol_command:
@@ -1098,12 +1108,14 @@ help_command:
          dbg_printf("watch w|write addr - insert a write watch point at physical address addr\n");
          dbg_printf("watch r|read addr <len> - insert a read watch point at physical address addr with range <len>\n");
          dbg_printf("watch w|write addr <len> - insert a write watch point at physical address addr with range <len>\n");
+         dbg_printf("watch vga \"text\" - stop simulation when text appears on the VGA text screen\n");
          free($1);free($2);
        }
      | BX_TOKEN_HELP BX_TOKEN_UNWATCH '\n'
        {
          dbg_printf("unwatch      - remove all watch points\n");
          dbg_printf("unwatch addr - remove a watch point\n");
+         dbg_printf("unwatch vga \"text\" - remove a text watch\n");
          free($1);free($2);
        }
      | BX_TOKEN_HELP BX_TOKEN_EXAMINE '\n'
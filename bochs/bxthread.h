@@ -0,0 +1,74 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+// Portable wrappers for the helper threads used by devices and image code
+
+#ifndef BX_THREAD_H
+#define BX_THREAD_H
+
+#ifdef WIN32
+#include <windows.h>
+
+#define BX_THREAD_ID(id) HANDLE id
+#define BX_THREAD_FUNC(name,arg) DWORD WINAPI name(LPVOID arg)
+#define BX_THREAD_EXIT return 0
+#define BX_THREAD_CREATE(name,arg,id) \
+  ((id = CreateThread(NULL, 0, name, arg, 0, NULL)) != NULL)
+#define BX_THREAD_JOIN(id) \
+  do { WaitForSingleObject(id, INFINITE); CloseHandle(id); } while (0)
+#define BX_MUTEX(mutex) CRITICAL_SECTION mutex
+#define BX_INIT_MUTEX(mutex) InitializeCriticalSection(&(mutex))
+#define BX_FINI_MUTEX(mutex) DeleteCriticalSection(&(mutex))
+#define BX_LOCK(mutex) EnterCriticalSection(&(mutex))
+#define BX_UNLOCK(mutex) LeaveCriticalSection(&(mutex))
+#define BX_COND(cond) CONDITION_VARIABLE cond
+#define BX_INIT_COND(cond) InitializeConditionVariable(&(cond))
+#define BX_FINI_COND(cond)
+#define BX_COND_WAIT(cond,mutex) SleepConditionVariableCS(&(cond), &(mutex), INFINITE)
+#define BX_COND_SIGNAL(cond) WakeConditionVariable(&(cond))
+#define BX_MSLEEP(val) Sleep(val)
+#define BX_MEMORY_BARRIER() MemoryBarrier()
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+#define BX_THREAD_ID(id) pthread_t id
+#define BX_THREAD_FUNC(name,arg) void *name(void *arg)
+#define BX_THREAD_EXIT return NULL
+#define BX_THREAD_CREATE(name,arg,id) \
+  (pthread_create(&(id), NULL, name, arg) == 0)
+#define BX_THREAD_JOIN(id) pthread_join(id, NULL)
+#define BX_MUTEX(mutex) pthread_mutex_t mutex
+#define BX_INIT_MUTEX(mutex) pthread_mutex_init(&(mutex), NULL)
+#define BX_FINI_MUTEX(mutex) pthread_mutex_destroy(&(mutex))
+#define BX_LOCK(mutex) pthread_mutex_lock(&(mutex))
+#define BX_UNLOCK(mutex) pthread_mutex_unlock(&(mutex))
+#define BX_COND(cond) pthread_cond_t cond
+#define BX_INIT_COND(cond) pthread_cond_init(&(cond), NULL)
+#define BX_FINI_COND(cond) pthread_cond_destroy(&(cond))
+#define BX_COND_WAIT(cond,mutex) pthread_cond_wait(&(cond), &(mutex))
+#define BX_COND_SIGNAL(cond) pthread_cond_signal(&(cond))
+#define BX_MSLEEP(val) usleep((val) * 1000)
+#define BX_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+#endif
@@ -169,7 +169,7 @@ void bx_init_std_nic_options(const char *name, bx_list_c *menu)
 
   bx_param_enum_c *ethmod;
   bx_param_string_c *macaddr;
-  bx_param_filename_c *path, *bootrom;
+  bx_param_filename_c *path, *bootrom, *capture;
   char descr[120];
 
   sprintf(descr, "MAC address of the %s device. Don't use an address of a machine on your net.", name);
@@ -207,6 +207,24 @@ void bx_init_std_nic_options(const char *name, bx_list_c *menu)
     "Pathname of network boot ROM image to load",
     "", BX_PATHNAME_LEN);
   bootrom->set_format("Name of boot ROM image: %s");
+  capture = new bx_param_filename_c(menu,
+    "capture",
+    "Packet capture file",
+    "Pathname of a pcap-ng file that receives a copy of the sent and received frames (optional)",
+    "none", BX_PATHNAME_LEN);
+  capture->set_ask_format("Enter new capture file name, or 'none': [%s] ");
+  new bx_param_num_c(menu,
+    "snaplen",
+    "Capture snapshot length",
+    "Number of bytes of each frame stored in the capture file",
+    64, 65535,
+    2048);
+  new bx_param_num_c(menu,
+    "sampling",
+    "Capture sampling",
+    "Store only one of N frames in the capture file",
+    1, 65536,
+    1);
 }
 
 void bx_init_usb_options(const char *usb_name, const char *pname, int maxports)
@@ -907,6 +925,9 @@ void bx_init_options()
 #endif
 #if BX_WITH_NOGUI
     "nogui",
+#endif
+#if BX_WITH_CAPTURE
+    "capture",
 #endif
     NULL
   };
@@ -951,6 +972,31 @@ void bx_init_options()
       5);
   vga_update_freq->set_ask_format ("Type a new value for VGA update frequency: [%d] ");
 
+  new bx_param_bool_c(display,
+      "vga_display_thread",
+      "VGA display thread",
+      "Serialize the video memory of the standard VGA graphics modes in a separate thread",
+      0);
+
+  new bx_param_bool_c(display,
+      "vga_blt_thread",
+      "Cirrus BitBLT thread",
+      "Run the video-to-video BitBLTs of the Cirrus SVGA in a separate thread",
+      0);
+
+  new bx_param_num_c(display,
+      "voodoo_threads",
+      "Voodoo rasterizer threads",
+      "Number of threads rasterizing the triangles of the 3dfx Voodoo (0 = emulation thread)",
+      0, 16,
+      0);
+
+  new bx_param_filename_c(display,
+      "voodoo_profile",
+      "Voodoo rasterizer profile",
+      "File to write the 3dfx Voodoo rasterizer configurations used by the guest to at exit",
+      "", BX_PATHNAME_LEN);
+
   bx_param_string_c *vga_extension = new bx_param_string_c(display,
                 "vga_extension",
                 "VGA Extension",
@@ -1596,6 +1642,14 @@ void bx_init_options()
   path->set_extension("log");
   path->set_enabled(BX_DEBUGGER);
 
+  path = new bx_param_filename_c(menu,
+      "disk_trace_filename",
+      "Disk trace filename",
+      "Pathname of the binary disk I/O trace file",
+      "-", BX_PATHNAME_LEN);
+  path->set_ask_format("Enter disk trace filename: [%s] ");
+  path->set_extension("trc");
+
   // runtime options
   menu = new bx_list_c(special_menus, "runtime", "Runtime options");
   bx_list_c *cdrom = new bx_list_c(menu, "cdrom", "CD-ROM options");
@@ -2519,6 +2573,11 @@ static int parse_line_formatted(const char *context, int num_params, char *param
       PARSE_ERR(("%s: debugger_log directive has wrong # args.", context));
     }
     SIM->get_param_string(BXPN_DEBUGGER_LOG_FILENAME)->set(params[1]);
+  } else if (!strcmp(params[0], "disk_trace")) {
+    if (num_params != 2) {
+      PARSE_ERR(("%s: disk_trace directive has wrong # args.", context));
+    }
+    SIM->get_param_string(BXPN_DISK_TRACE_FILENAME)->set(params[1]);
   } else if (!strcmp(params[0], "panic")) {
     if (num_params < 2) {
       PARSE_ERR(("%s: panic directive malformed.", context));
@@ -2681,6 +2740,14 @@ static int parse_line_formatted(const char *context, int num_params, char *param
         SIM->get_param_string(BXPN_VGA_EXTENSION)->set(&params[i][10]);
       } else if (!strncmp(params[i], "update_freq=", 12)) {
         SIM->get_param_num(BXPN_VGA_UPDATE_FREQUENCY)->set(atol(&params[i][12]));
+      } else if (!strncmp(params[i], "display_thread=", 15)) {
+        SIM->get_param_bool(BXPN_VGA_DISPLAY_THREAD)->set(atol(&params[i][15]));
+      } else if (!strncmp(params[i], "blt_thread=", 11)) {
+        SIM->get_param_bool(BXPN_VGA_BLT_THREAD)->set(atol(&params[i][11]));
+      } else if (!strncmp(params[i], "voodoo_threads=", 15)) {
+        SIM->get_param_num(BXPN_VOODOO_THREADS)->set(atol(&params[i][15]));
+      } else if (!strncmp(params[i], "voodoo_profile=", 15)) {
+        SIM->get_param_string(BXPN_VOODOO_PROFILE)->set(&params[i][15]);
       } else {
         PARSE_ERR(("%s: vga directive malformed.", context));
       }
@@ -3222,6 +3289,7 @@ int bx_write_log_options(FILE *fp, bx_list_c *base)
 
   fprintf(fp, "log: %s\n", SIM->get_param_string("filename", base)->getptr());
   fprintf(fp, "logprefix: %s\n", SIM->get_param_string("prefix", base)->getptr());
+  fprintf(fp, "disk_trace: %s\n", SIM->get_param_string("disk_trace_filename", base)->getptr());
 
   strcpy(pname, "general.logfn");
   logfn = (bx_list_c*) SIM->get_param(pname);
@@ -3379,9 +3447,16 @@ int bx_write_configuration(const char *rc, int overwrite)
     }
   }
   fprintf(fp, "\n");
-  fprintf(fp, "vga: extension=%s, update_freq=%u\n",
+  fprintf(fp, "vga: extension=%s, update_freq=%u, display_thread=%d, blt_thread=%d, voodoo_threads=%u",
     SIM->get_param_string(BXPN_VGA_EXTENSION)->getptr(),
-    SIM->get_param_num(BXPN_VGA_UPDATE_FREQUENCY)->get());
+    SIM->get_param_num(BXPN_VGA_UPDATE_FREQUENCY)->get(),
+    SIM->get_param_bool(BXPN_VGA_DISPLAY_THREAD)->get(),
+    SIM->get_param_bool(BXPN_VGA_BLT_THREAD)->get(),
+    SIM->get_param_num(BXPN_VOODOO_THREADS)->get());
+  if (!SIM->get_param_string(BXPN_VOODOO_PROFILE)->isempty()) {
+    fprintf(fp, ", voodoo_profile=%s", SIM->get_param_string(BXPN_VOODOO_PROFILE)->getptr());
+  }
+  fprintf(fp, "\n");
 #if BX_SUPPORT_SMP
   fprintf(fp, "cpu: count=%u:%u:%u, ips=%u, quantum=%d, ",
     SIM->get_param_num(BXPN_CPU_NPROCESSORS)->get(), SIM->get_param_num(BXPN_CPU_NCORES)->get(),
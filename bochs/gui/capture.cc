@@ -0,0 +1,1184 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+
+// Headless display library for automated runs. The guest screen is kept
+// in a 32 bpp in-memory framebuffer. Screenshots are written as PNG files
+// on request (signal) or at a fixed interval, and the screen can be recorded
+// as YUV4MPEG2 video
+// at a fixed frame rate in host time. Both are encoded by a worker thread,
+// so the emulation thread only copies the framebuffer into a free slot of
+// a small queue. If no slot is free, the frame is dropped.
+//
+// display_library options:
+//   shot=<basename>   screenshot file name prefix (<basename>-NNNN.png)
+//   shot_interval=<n> save a screenshot every <n> seconds of host time
+//   signal=<sig>      screenshot signal: usr1 (default), usr2 or none
+//   video=<file>      record the screen to a .y4m file
+//   fps=<n>           video frame rate (default 5)
+
+// Define BX_PLUGGABLE in files that can be compiled into plugins.  For
+// platforms that require a special tag on exported symbols, BX_PLUGGABLE
+// is used to know when we are exporting symbols and when we are importing.
+#define BX_PLUGGABLE
+
+#include "bochs.h"
+#include "plugin.h"
+#include "param_names.h"
+#include "bxthread.h"
+
+#if BX_WITH_CAPTURE
+#include "icon_bochs.h"
+#include "font/vga.bitmap.h"
+#include "pixconv.h"
+
+#include <signal.h>
+
+class bx_capture_gui_c : public bx_gui_c {
+public:
+  bx_capture_gui_c (void) {}
+  DECLARE_GUI_VIRTUAL_METHODS()
+  DECLARE_GUI_NEW_VIRTUAL_METHODS()
+  void get_capabilities(Bit16u *xres, Bit16u *yres, Bit16u *bpp);
+};
+
+// declare one instance of the gui object and call macro to insert the
+// plugin code
+static bx_capture_gui_c *theGui = NULL;
+IMPLEMENT_GUI_PLUGIN_CODE(capture)
+
+#define LOG_THIS theGui->
+
+#define BX_CAPTURE_MAX_XRES 2560
+#define BX_CAPTURE_MAX_YRES 1600
+#define BX_CAPTURE_QUEUE    4
+
+enum {
+  BX_CAPTURE_PNG,
+  BX_CAPTURE_VIDEO
+};
+
+// results of the encoder thread, logged by the emulation thread
+enum {
+  BX_CAPTURE_OK,
+  BX_CAPTURE_SHOT_SAVED,
+  BX_CAPTURE_SHOT_FAILED,
+  BX_CAPTURE_VIDEO_STARTED,
+  BX_CAPTURE_VIDEO_FAILED
+};
+
+// room for the file name suffixes added to the shot and video names
+#define BX_CAPTURE_NAME_LEN (BX_PATHNAME_LEN - 16)
+#define BX_CAPTURE_REPORTS  (BX_CAPTURE_QUEUE * 2)
+
+// one entry of the encoder queue
+typedef struct {
+  Bit8u type;
+  unsigned width, height;
+  unsigned repeat;       // number of video frame periods covered
+  Bit32u *pixels;
+  size_t size;           // allocated pixels
+  char filename[BX_PATHNAME_LEN];
+} capture_frame_t;
+
+typedef struct {
+  Bit8u status;
+  unsigned width, height;
+  char filename[BX_PATHNAME_LEN];
+} capture_report_t;
+
+static Bit32u *capScreen = NULL;
+static unsigned capWidth, capHeight;
+static Bit32u capPalette[256];
+static unsigned capCursorX = 0, capCursorY = 0;
+static unsigned int text_rows = 25, text_cols = 80;
+static unsigned int font_height = 16, font_width = 8;
+
+static char capShotBase[BX_CAPTURE_NAME_LEN];
+static unsigned capShotCount = 0;
+static volatile sig_atomic_t capShotRequest = 0;
+static unsigned capShotInterval = 0;
+static Bit64u capNextShot;
+#if defined(SIGUSR1) && !defined(WIN32)
+static int capSignal = SIGUSR1;
+static bx_bool capSignalInstalled = 0;
+static struct sigaction capOldAction;
+#endif
+
+static char capVideoName[BX_CAPTURE_NAME_LEN];
+static bx_bool capVideo = 0;
+static unsigned capFps = 5;
+static Bit64u capFrameUsec, capNextFrame;
+static unsigned capLostFrames = 0;
+static Bit32u capDropped = 0;
+
+// state owned by the encoder thread
+static FILE *capVideoFile = NULL;
+static unsigned capVideoWidth = 0, capVideoHeight = 0;
+static unsigned capVideoSegment = 0;
+static Bit8u *capYuv = NULL;
+static size_t capYuvSize = 0;
+
+static capture_frame_t capQueue[BX_CAPTURE_QUEUE];
+static unsigned capHead = 0, capQueued = 0;
+static bx_bool capQuit = 0;
+static bx_bool capThreadStarted = 0;
+static BX_THREAD_ID(capThread);
+static BX_MUTEX(capLock);
+static BX_COND(capCond);
+static capture_report_t capReport[BX_CAPTURE_REPORTS];
+static unsigned capReports = 0;
+static Bit32u capReportsLost = 0;
+
+static void capture_encode(capture_frame_t *frame, capture_report_t *report);
+
+#if defined(SIGUSR1) && !defined(WIN32)
+static void capture_sighandler(int sig)
+{
+  UNUSED(sig);
+  capShotRequest = 1;
+}
+
+// The screenshot signal is only taken if nobody else (e.g. pcidev, which
+// uses SIGUSR1 for host interrupts) has installed a handler for it.
+static void capture_signal_init(void)
+{
+  struct sigaction sa;
+
+  if (capSignal == 0) return;
+  if ((sigaction(capSignal, NULL, &capOldAction) < 0) ||
+      (capOldAction.sa_handler != SIG_DFL)) {
+    BX_ERROR(("SIG%s already in use, screenshot signal disabled",
+              (capSignal == SIGUSR1) ? "USR1" : "USR2"));
+    return;
+  }
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = capture_sighandler;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_flags = SA_RESTART;
+  if (sigaction(capSignal, &sa, NULL) == 0) {
+    capSignalInstalled = 1;
+    BX_INFO(("send SIG%s to save a screenshot to '%s-NNNN.png'",
+             (capSignal == SIGUSR1) ? "USR1" : "USR2", capShotBase));
+  }
+}
+
+// Restores the previous handler, unless another one has replaced ours.
+static void capture_signal_exit(void)
+{
+  struct sigaction sa;
+
+  if (!capSignalInstalled) return;
+  if ((sigaction(capSignal, NULL, &sa) == 0) &&
+      (sa.sa_handler == capture_sighandler)) {
+    sigaction(capSignal, &capOldAction, NULL);
+  }
+  capSignalInstalled = 0;
+}
+#endif
+
+BX_THREAD_FUNC(capture_thread, arg)
+{
+  capture_frame_t *frame;
+  capture_report_t report;
+
+  UNUSED(arg);
+  while (1) {
+    BX_LOCK(capLock);
+    while (!capQueued && !capQuit) {
+      BX_COND_WAIT(capCond, capLock);
+    }
+    if (!capQueued) {
+      BX_UNLOCK(capLock);
+      break;
+    }
+    frame = &capQueue[capHead];
+    BX_UNLOCK(capLock);
+    report.status = BX_CAPTURE_OK;
+    capture_encode(frame, &report);
+    BX_LOCK(capLock);
+    capHead = (capHead + 1) % BX_CAPTURE_QUEUE;
+    capQueued--;
+    if (report.status != BX_CAPTURE_OK) {
+      if (capReports < BX_CAPTURE_REPORTS) {
+        capReport[capReports++] = report;
+      } else {
+        capReportsLost++;
+      }
+    }
+    BX_UNLOCK(capLock);
+  }
+  BX_THREAD_EXIT;
+}
+
+// Copies the current screen into a free queue slot and passes it to the
+// encoder thread. Returns 0 if all slots are busy.
+static bx_bool capture_post(Bit8u type, unsigned repeat, const char *filename)
+{
+  capture_frame_t *frame;
+  size_t size = capWidth * capHeight;
+
+  BX_LOCK(capLock);
+  if (capQueued == BX_CAPTURE_QUEUE) {
+    BX_UNLOCK(capLock);
+    return 0;
+  }
+  // the slot is not visible to the encoder until capQueued is incremented
+  frame = &capQueue[(capHead + capQueued) % BX_CAPTURE_QUEUE];
+  BX_UNLOCK(capLock);
+
+  if (frame->size < size) {
+    delete [] frame->pixels;
+    frame->pixels = new Bit32u[size];
+    frame->size = size;
+  }
+  memcpy(frame->pixels, capScreen, size * 4);
+  frame->type = type;
+  frame->width = capWidth;
+  frame->height = capHeight;
+  frame->repeat = repeat;
+  if (filename != NULL) {
+    strcpy(frame->filename, filename);
+  }
+
+  BX_LOCK(capLock);
+  capQueued++;
+  BX_COND_SIGNAL(capCond);
+  BX_UNLOCK(capLock);
+  return 1;
+}
+
+// Logs the results of the encoder thread (emulation thread only)
+static void capture_report(void)
+{
+  capture_report_t report[BX_CAPTURE_REPORTS];
+  unsigned i, count;
+  Bit32u lost;
+
+  BX_LOCK(capLock);
+  count = capReports;
+  memcpy(report, capReport, count * sizeof(capture_report_t));
+  capReports = 0;
+  lost = capReportsLost;
+  capReportsLost = 0;
+  BX_UNLOCK(capLock);
+  for (i = 0; i < count; i++) {
+    switch (report[i].status) {
+      case BX_CAPTURE_SHOT_SAVED:
+        BX_INFO(("screenshot saved to '%s'", report[i].filename));
+        break;
+      case BX_CAPTURE_SHOT_FAILED:
+        BX_ERROR(("cannot create screenshot file '%s'", report[i].filename));
+        break;
+      case BX_CAPTURE_VIDEO_STARTED:
+        BX_INFO(("recording %ux%u video to '%s'", report[i].width, report[i].height,
+                 report[i].filename));
+        break;
+      case BX_CAPTURE_VIDEO_FAILED:
+        BX_ERROR(("cannot create video file '%s'", report[i].filename));
+        break;
+    }
+  }
+  if (lost > 0) {
+    BX_ERROR(("%u encoder messages lost", lost));
+  }
+}
+
+// PNG encoder: RGB image data compressed into a single deflate block with
+// the fixed Huffman codes. The LZ77 matcher is greedy and only remembers the
+// last position for each hash value, which is enough for screen contents.
+
+static Bit32u crc_table[256];
+
+static void png_init_crc(void)
+{
+  for (unsigned n = 0; n < 256; n++) {
+    Bit32u c = n;
+    for (int k = 0; k < 8; k++) {
+      c = (c & 1) ? (0xedb88320 ^ (c >> 1)) : (c >> 1);
+    }
+    crc_table[n] = c;
+  }
+}
+
+static Bit32u png_crc(Bit32u crc, const Bit8u *buf, size_t len)
+{
+  crc ^= 0xffffffff;
+  while (len--) {
+    crc = crc_table[(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+  }
+  return crc ^ 0xffffffff;
+}
+
+static Bit32u png_adler(const Bit8u *buf, size_t len)
+{
+  Bit32u a = 1, b = 0;
+
+  while (len > 0) {
+    size_t n = (len < 5552) ? len : 5552;
+    len -= n;
+    while (n--) {
+      a += *buf++;
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+  return (b << 16) | a;
+}
+
+typedef struct {
+  Bit8u *out;
+  size_t pos;
+  Bit32u bitbuf;
+  unsigned bitcnt;
+} deflate_state_t;
+
+static const Bit16u len_base[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const Bit8u len_extra[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const Bit16u dist_base[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const Bit8u dist_extra[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static void deflate_bits(deflate_state_t *s, Bit32u value, unsigned n)
+{
+  s->bitbuf |= value << s->bitcnt;
+  s->bitcnt += n;
+  while (s->bitcnt >= 8) {
+    s->out[s->pos++] = (Bit8u)s->bitbuf;
+    s->bitbuf >>= 8;
+    s->bitcnt -= 8;
+  }
+}
+
+// Huffman codes are stored starting with the most significant bit
+static void deflate_code(deflate_state_t *s, Bit32u code, unsigned n)
+{
+  Bit32u rev = 0;
+
+  for (unsigned i = 0; i < n; i++) {
+    rev = (rev << 1) | ((code >> i) & 1);
+  }
+  deflate_bits(s, rev, n);
+}
+
+static void deflate_symbol(deflate_state_t *s, unsigned sym)
+{
+  if (sym < 144) {
+    deflate_code(s, 0x30 + sym, 8);
+  } else if (sym < 256) {
+    deflate_code(s, 0x190 + sym - 144, 9);
+  } else if (sym < 280) {
+    deflate_code(s, sym - 256, 7);
+  } else {
+    deflate_code(s, 0xc0 + sym - 280, 8);
+  }
+}
+
+static void deflate_match(deflate_state_t *s, unsigned len, unsigned dist)
+{
+  int i = 28, j = 29;
+
+  while (len_base[i] > len) i--;
+  deflate_symbol(s, 257 + i);
+  deflate_bits(s, len - len_base[i], len_extra[i]);
+  while (dist_base[j] > dist) j--;
+  deflate_code(s, j, 5);
+  deflate_bits(s, dist - dist_base[j], dist_extra[j]);
+}
+
+#define DEFLATE_HASH_BITS 15
+#define DEFLATE_HASH(p) ((((p)[0] << 10) ^ ((p)[1] << 5) ^ (p)[2]) & ((1 << DEFLATE_HASH_BITS) - 1))
+
+// Returns the length of the zlib stream written to out. The output buffer
+// must hold at least len * 9 / 8 + 16 bytes.
+static size_t png_deflate(Bit8u *out, const Bit8u *src, size_t len)
+{
+  deflate_state_t s;
+  Bit32s *head = new Bit32s[1 << DEFLATE_HASH_BITS];
+  Bit32u adler = png_adler(src, len);
+  size_t i = 0;
+
+  for (i = 0; i < (1 << DEFLATE_HASH_BITS); i++) {
+    head[i] = -1;
+  }
+  out[0] = 0x78;
+  out[1] = 0x01;
+  s.out = out;
+  s.pos = 2;
+  s.bitbuf = 0;
+  s.bitcnt = 0;
+  deflate_bits(&s, 1, 1); // final block
+  deflate_bits(&s, 1, 2); // fixed Huffman codes
+  i = 0;
+  while (i < len) {
+    unsigned best = 0;
+    size_t cand = 0;
+    if ((i + 3) <= len) {
+      unsigned h = DEFLATE_HASH(&src[i]);
+      if ((head[h] >= 0) && ((i - head[h]) <= 32768)) {
+        cand = head[h];
+        size_t max = len - i;
+        if (max > 258) max = 258;
+        while ((best < max) && (src[cand + best] == src[i + best])) best++;
+      }
+      head[h] = (Bit32s)i;
+    }
+    if (best >= 3) {
+      deflate_match(&s, best, (unsigned)(i - cand));
+      for (unsigned k = 1; k < best; k++) {
+        if ((i + k + 3) <= len) {
+          head[DEFLATE_HASH(&src[i + k])] = (Bit32s)(i + k);
+        }
+      }
+      i += best;
+    } else {
+      deflate_symbol(&s, src[i++]);
+    }
+  }
+  deflate_symbol(&s, 256);
+  if (s.bitcnt > 0) {
+    deflate_bits(&s, 0, 8 - s.bitcnt);
+  }
+  out[s.pos++] = (Bit8u)(adler >> 24);
+  out[s.pos++] = (Bit8u)(adler >> 16);
+  out[s.pos++] = (Bit8u)(adler >> 8);
+  out[s.pos++] = (Bit8u)adler;
+  delete [] head;
+  return s.pos;
+}
+
+static void png_put32(Bit8u *buf, Bit32u value)
+{
+  buf[0] = (Bit8u)(value >> 24);
+  buf[1] = (Bit8u)(value >> 16);
+  buf[2] = (Bit8u)(value >> 8);
+  buf[3] = (Bit8u)value;
+}
+
+static void png_chunk(FILE *fp, const char *type, const Bit8u *data, size_t len)
+{
+  Bit8u buf[8];
+  Bit32u crc;
+
+  png_put32(buf, (Bit32u)len);
+  memcpy(&buf[4], type, 4);
+  fwrite(buf, 1, 8, fp);
+  fwrite(data, 1, len, fp);
+  crc = png_crc(0, &buf[4], 4);
+  crc = png_crc(crc, data, len);
+  png_put32(buf, crc);
+  fwrite(buf, 1, 4, fp);
+}
+
+static void capture_write_png(capture_frame_t *frame, capture_report_t *report)
+{
+  static const Bit8u signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+  unsigned x, y, w = frame->width, h = frame->height;
+  size_t rawlen = (w * 3 + 1) * h;
+  Bit8u ihdr[13], *raw, *zbuf, *dst;
+  Bit32u *src = frame->pixels;
+  FILE *fp;
+
+  strcpy(report->filename, frame->filename);
+  fp = fopen(frame->filename, "wb");
+  if (fp == NULL) {
+    report->status = BX_CAPTURE_SHOT_FAILED;
+    return;
+  }
+  raw = new Bit8u[rawlen];
+  dst = raw;
+  for (y = 0; y < h; y++) {
+    *dst++ = 0; // filter type none
+    for (x = 0; x < w; x++) {
+      Bit32u pixel = *src++;
+      *dst++ = (Bit8u)(pixel >> 16);
+      *dst++ = (Bit8u)(pixel >> 8);
+      *dst++ = (Bit8u)pixel;
+    }
+  }
+  zbuf = new Bit8u[rawlen / 8 * 9 + 16];
+  png_put32(&ihdr[0], w);
+  png_put32(&ihdr[4], h);
+  ihdr[8] = 8;  // bit depth
+  ihdr[9] = 2;  // truecolor
+  ihdr[10] = 0; // deflate
+  ihdr[11] = 0; // adaptive filtering
+  ihdr[12] = 0; // no interlace
+  fwrite(signature, 1, 8, fp);
+  png_chunk(fp, "IHDR", ihdr, 13);
+  png_chunk(fp, "IDAT", zbuf, png_deflate(zbuf, raw, rawlen));
+  png_chunk(fp, "IEND", NULL, 0);
+  fclose(fp);
+  delete [] zbuf;
+  delete [] raw;
+  report->status = BX_CAPTURE_SHOT_SAVED;
+}
+
+// Video encoder: YUV4MPEG2 stream with 4:2:0 chroma subsampling. A change
+// of the screen size closes the current file and starts a new segment
+// named <name>-<n><ext>.
+
+static void capture_open_video(unsigned width, unsigned height, capture_report_t *report)
+{
+  char *filename = report->filename;
+
+  if (capVideoFile != NULL) {
+    fclose(capVideoFile);
+    capVideoFile = NULL;
+  }
+  report->width = width;
+  report->height = height;
+  if (capVideoSegment == 0) {
+    strcpy(filename, capVideoName);
+  } else {
+    const char *ext = strrchr(capVideoName, '.');
+    const char *sep = strrchr(capVideoName, '/');
+    if ((ext == NULL) || ((sep != NULL) && (ext < sep))) {
+      ext = capVideoName + strlen(capVideoName);
+    }
+    if (snprintf(filename, BX_PATHNAME_LEN, "%.*s-%u%s", (int)(ext - capVideoName),
+                 capVideoName, capVideoSegment, ext) >= BX_PATHNAME_LEN) {
+      report->status = BX_CAPTURE_VIDEO_FAILED;
+      return;
+    }
+  }
+  capVideoSegment++;
+  capVideoFile = fopen(filename, "wb");
+  if (capVideoFile == NULL) {
+    report->status = BX_CAPTURE_VIDEO_FAILED;
+    return;
+  }
+  fprintf(capVideoFile, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n", width, height, capFps);
+  capVideoWidth = width;
+  capVideoHeight = height;
+  report->status = BX_CAPTURE_VIDEO_STARTED;
+}
+
+static void capture_write_video(capture_frame_t *frame, capture_report_t *report)
+{
+  unsigned x, y, w = frame->width, h = frame->height;
+  unsigned cw = (w + 1) >> 1, ch = (h + 1) >> 1;
+  size_t size = w * h + 2 * cw * ch;
+  Bit8u *py, *pu, *pv;
+
+  if ((capVideoFile == NULL) || (w != capVideoWidth) || (h != capVideoHeight)) {
+    capture_open_video(w, h, report);
+    if (capVideoFile == NULL) return;
+  }
+  if (capYuvSize < size) {
+    delete [] capYuv;
+    capYuv = new Bit8u[size];
+    capYuvSize = size;
+  }
+  py = capYuv;
+  pu = py + w * h;
+  pv = pu + cw * ch;
+  // BT.601 limited range
+  for (x = 0; x < w * h; x++) {
+    Bit32u p = frame->pixels[x];
+    int r = (p >> 16) & 0xff, g = (p >> 8) & 0xff, b = p & 0xff;
+    py[x] = (Bit8u)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+  }
+  for (y = 0; y < h; y += 2) {
+    const Bit32u *row0 = &frame->pixels[y * w];
+    const Bit32u *row1 = (y + 1 < h) ? row0 + w : row0;
+    for (x = 0; x < w; x += 2) {
+      unsigned x1 = (x + 1 < w) ? x + 1 : x;
+      Bit32u p[4] = {row0[x], row0[x1], row1[x], row1[x1]};
+      int r = 0, g = 0, b = 0;
+      for (int i = 0; i < 4; i++) {
+        r += (p[i] >> 16) & 0xff;
+        g += (p[i] >> 8) & 0xff;
+        b += p[i] & 0xff;
+      }
+      r = (r + 2) >> 2;
+      g = (g + 2) >> 2;
+      b = (b + 2) >> 2;
+      *pu++ = (Bit8u)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      *pv++ = (Bit8u)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+  }
+  for (unsigned i = 0; i < frame->repeat; i++) {
+    fputs("FRAME\n", capVideoFile);
+    fwrite(capYuv, 1, size, capVideoFile);
+  }
+}
+
+static void capture_encode(capture_frame_t *frame, capture_report_t *report)
+{
+  if (frame->type == BX_CAPTURE_PNG) {
+    capture_write_png(frame, report);
+  } else {
+    capture_write_video(frame, report);
+  }
+}
+
+// ::SPECIFIC_INIT()
+//
+// Called from gui.cc, once upon program startup, to allow for the
+// specific GUI code (X11, Win32, ...) to be initialized.
+//
+// argc, argv: used to pass display library options
+// headerbar_y: not used, there is no headerbar
+
+void bx_capture_gui_c::specific_init(int argc, char **argv, unsigned headerbar_y)
+{
+  unsigned i, j;
+  Bit8u fc, vc;
+
+  put("CAPT");
+  UNUSED(headerbar_y);
+  UNUSED(bochs_icon_bits);  // global variable
+
+  strcpy(capShotBase, "screenshot");
+  if (argc > 1) {
+    for (i = 1; i < (unsigned)argc; i++) {
+      if (!strncmp(argv[i], "shot=", 5)) {
+        strncpy(capShotBase, &argv[i][5], BX_CAPTURE_NAME_LEN - 1);
+        capShotBase[BX_CAPTURE_NAME_LEN - 1] = 0;
+      } else if (!strncmp(argv[i], "video=", 6)) {
+        strncpy(capVideoName, &argv[i][6], BX_CAPTURE_NAME_LEN - 1);
+        capVideoName[BX_CAPTURE_NAME_LEN - 1] = 0;
+        capVideo = 1;
+      } else if (!strncmp(argv[i], "fps=", 4)) {
+        capFps = atoi(&argv[i][4]);
+        if ((capFps < 1) || (capFps > 60)) {
+          BX_PANIC(("invalid video frame rate: %s", &argv[i][4]));
+          capFps = 5;
+        }
+      } else if (!strncmp(argv[i], "shot_interval=", 14)) {
+        capShotInterval = atoi(&argv[i][14]);
+      } else if (!strncmp(argv[i], "signal=", 7)) {
+#if defined(SIGUSR1) && !defined(WIN32)
+        if (!strcmp(&argv[i][7], "usr1")) {
+          capSignal = SIGUSR1;
+        } else if (!strcmp(&argv[i][7], "usr2")) {
+          capSignal = SIGUSR2;
+        } else if (!strcmp(&argv[i][7], "none")) {
+          capSignal = 0;
+        } else {
+          BX_PANIC(("invalid screenshot signal: %s", &argv[i][7]));
+        }
+#else
+        BX_INFO(("signal option ignored, no signals on this host"));
+#endif
+      } else {
+        BX_PANIC(("Unknown capture option '%s'", argv[i]));
+      }
+    }
+  }
+
+  if (SIM->get_param_bool(BXPN_PRIVATE_COLORMAP)->get()) {
+    BX_INFO(("private_colormap option ignored."));
+  }
+
+  for (i = 0; i < 256; i++) {
+    for (j = 0; j < 16; j++) {
+      vc = bx_vgafont[i].data[j];
+      fc = 0;
+      for (int b = 0; b < 8; b++) {
+        fc |= (vc & 0x01) << (7 - b);
+        vc >>= 1;
+      }
+      vga_charmap[i * 32 + j] = fc;
+    }
+  }
+
+  capWidth = 640;
+  capHeight = 480;
+  capScreen = new Bit32u[capWidth * capHeight];
+  memset(capScreen, 0, capWidth * capHeight * 4);
+  new_gfx_api = 1;
+
+  png_init_crc();
+  memset(capQueue, 0, sizeof(capQueue));
+  BX_INIT_MUTEX(capLock);
+  BX_INIT_COND(capCond);
+  capThreadStarted = BX_THREAD_CREATE(capture_thread, NULL, capThread);
+  if (!capThreadStarted) {
+    BX_PANIC(("cannot create capture encoder thread"));
+  }
+  if (capVideo) {
+    capFrameUsec = 1000000 / capFps;
+    capNextFrame = 0;
+    BX_INFO(("recording video at %u fps to '%s'", capFps, capVideoName));
+  }
+  if (capShotInterval > 0) {
+    capNextShot = bx_get_realtime64_usec() + (Bit64u)capShotInterval * 1000000;
+    BX_INFO(("saving a screenshot every %u second(s) to '%s-NNNN.png'",
+             capShotInterval, capShotBase));
+  }
+#if defined(SIGUSR1) && !defined(WIN32)
+  capture_signal_init();
+#endif
+}
+
+
+// ::HANDLE_EVENTS()
+//
+// Called periodically (vga_update_interval in .bochsrc). Logs the results
+// of the encoder thread, then posts pending or periodic screenshot requests
+// and the video frames due since the last call. Frames lost while the
+// encoder was busy repeat the next posted one, so the video keeps the host
+// time base.
+
+void bx_capture_gui_c::handle_events(void)
+{
+  char filename[BX_PATHNAME_LEN];
+
+  capture_report();
+  if (capShotInterval > 0) {
+    Bit64u now = bx_get_realtime64_usec();
+    if (now >= capNextShot) {
+      capShotRequest = 1;
+      capNextShot = now + (Bit64u)capShotInterval * 1000000;
+    }
+  }
+  if (capShotRequest) {
+    snprintf(filename, BX_PATHNAME_LEN, "%s-%04u.png", capShotBase, capShotCount);
+    // if the encoder is busy, the request is retried on the next call
+    if (capture_post(BX_CAPTURE_PNG, 0, filename)) {
+      capShotRequest = 0;
+      capShotCount++;
+    }
+  }
+  if (capVideo) {
+    Bit64u now = bx_get_realtime64_usec();
+    if (now >= capNextFrame) {
+      Bit64u frames = (now - capNextFrame) / capFrameUsec + 1;
+      if (frames > capFps) {
+        // the simulation was stopped, don't fill the gap
+        frames = 1;
+        capNextFrame = now;
+      }
+      capNextFrame += frames * capFrameUsec;
+      if (capture_post(BX_CAPTURE_VIDEO, (unsigned)frames + capLostFrames, NULL)) {
+        capLostFrames = 0;
+      } else {
+        capLostFrames += (unsigned)frames;
+        capDropped++;
+      }
+    }
+  }
+}
+
+
+// ::FLUSH()
+//
+// Called periodically, requesting that the gui code flush all pending
+// screen update requests.
+
+void bx_capture_gui_c::flush(void)
+{
+}
+
+
+// ::CLEAR_SCREEN()
+//
+// Called to request that the VGA region is cleared.
+
+void bx_capture_gui_c::clear_screen(void)
+{
+  memset(capScreen, 0, capWidth * capHeight * 4);
+}
+
+
+static void capture_draw_char(unsigned x, unsigned y, unsigned width, unsigned height,
+                              unsigned fonty, const Bit8u *bmap, Bit32u fg, Bit32u bg,
+                              bx_bool gfxchar)
+{
+  for (unsigned i = 0; (i < height) && (y + i < capHeight); i++) {
+    Bit32u *dst = &capScreen[(y + i) * capWidth + x];
+    Bit8u mask = bmap[fonty + i];
+    for (unsigned j = 0; (j < width) && (x + j < capWidth); j++) {
+      bx_bool on;
+      if (j < 8) {
+        on = (mask >> (7 - j)) & 1;
+      } else {
+        on = gfxchar && (mask & 1);
+      }
+      dst[j] = on ? fg : bg;
+    }
+  }
+}
+
+
+// ::TEXT_UPDATE()
+//
+// Called in a VGA text mode, to update the screen with
+// new content.
+//
+// old_text: array of character/attributes making up the contents
+//           of the screen from the last call.  See below
+// new_text: array of character/attributes making up the current
+//           contents, which should now be displayed.  See below
+//
+// format of old_text & new_text: each is tm_info->line_offset*text_rows
+//     bytes long. Each character consists of 2 bytes.  The first by is
+//     the character value, the second is the attribute byte.
+//
+// cursor_x: new x location of cursor
+// cursor_y: new y location of cursor
+// tm_info:  this structure contains information for additional
+//           features in text mode (cursor shape, line offset,...)
+
+void bx_capture_gui_c::text_update(Bit8u *old_text, Bit8u *new_text,
+                      unsigned long cursor_x, unsigned long cursor_y,
+                      bx_vga_tminfo_t *tm_info)
+{
+  Bit8u *old_line, *new_line;
+  Bit8u cAttr, cChar;
+  unsigned int curs, hchars, offset, rows, x, y, xc, yc, i;
+  bx_bool force_update = 0, gfxchar, blink_state, blink_mode;
+  Bit32u text_palette[16];
+
+  for (i = 0; i < 16; i++) {
+    text_palette[i] = capPalette[tm_info->actl_palette[i]];
+  }
+
+  blink_mode = (tm_info->blink_flags & BX_TEXT_BLINK_MODE) > 0;
+  blink_state = (tm_info->blink_flags & BX_TEXT_BLINK_STATE) > 0;
+  if (blink_mode) {
+    if (tm_info->blink_flags & BX_TEXT_BLINK_TOGGLE)
+      force_update = 1;
+  }
+  if (charmap_updated) {
+    force_update = 1;
+    charmap_updated = 0;
+  }
+
+  // first invalidate character at previous and new cursor location
+  if ((capCursorY < text_rows) && (capCursorX < text_cols)) {
+    curs = capCursorY * tm_info->line_offset + capCursorX * 2;
+    old_text[curs] = ~new_text[curs];
+  }
+  if ((tm_info->cs_start <= tm_info->cs_end) && (tm_info->cs_start < font_height)
+      && (cursor_y < text_rows) && (cursor_x < text_cols)) {
+    curs = cursor_y * tm_info->line_offset + cursor_x * 2;
+    old_text[curs] = ~new_text[curs];
+  } else {
+    curs = 0xffff;
+  }
+
+  rows = text_rows;
+  y = 0;
+  do {
+    hchars = text_cols;
+    new_line = new_text;
+    old_line = old_text;
+    offset = y * tm_info->line_offset;
+    yc = y * font_height;
+    x = 0;
+    do {
+      if (force_update || (old_text[0] != new_text[0])
+          || (old_text[1] != new_text[1])) {
+        cChar = new_text[0];
+        if (blink_mode) {
+          cAttr = new_text[1] & 0x7F;
+          if (!blink_state && (new_text[1] & 0x80))
+            cAttr = (cAttr & 0x70) | (cAttr >> 4);
+        } else {
+          cAttr = new_text[1];
+        }
+        gfxchar = tm_info->line_graphics && ((cChar & 0xE0) == 0xC0);
+        xc = x * font_width;
+        capture_draw_char(xc, yc, font_width, font_height, 0, &vga_charmap[cChar<<5],
+                          text_palette[cAttr & 0x0F], text_palette[cAttr >> 4], gfxchar);
+        if (offset == curs) {
+          capture_draw_char(xc, yc + tm_info->cs_start, font_width,
+                            tm_info->cs_end - tm_info->cs_start + 1, tm_info->cs_start,
+                            &vga_charmap[cChar<<5], text_palette[cAttr >> 4],
+                            text_palette[cAttr & 0x0F], gfxchar);
+        }
+      }
+      x++;
+      new_text += 2;
+      old_text += 2;
+      offset += 2;
+    } while (--hchars);
+    y++;
+    new_text = new_line + tm_info->line_offset;
+    old_text = old_line + tm_info->line_offset;
+  } while (--rows);
+
+  capCursorX = cursor_x;
+  capCursorY = cursor_y;
+}
+
+// ::GET_CLIPBOARD_TEXT()
+//
+// Called to get text from the GUI clipboard. Returns 1 if successful.
+
+int bx_capture_gui_c::get_clipboard_text(Bit8u **bytes, Bit32s *nbytes)
+{
+  UNUSED(bytes);
+  UNUSED(nbytes);
+  return 0;
+}
+
+// ::SET_CLIPBOARD_TEXT()
+//
+// Called to copy the text screen contents to the GUI clipboard.
+// Returns 1 if successful.
+
+int bx_capture_gui_c::set_clipboard_text(char *text_snapshot, Bit32u len)
+{
+  UNUSED(text_snapshot);
+  UNUSED(len);
+  return 0;
+}
+
+
+// ::PALETTE_CHANGE()
+//
+// Stores the color in the palette used by 8 bpp tiles and text modes.
+// returns: 0=no screen update needed (color map change has direct effect)
+//          1=screen updated needed (redraw using current colormap)
+
+bx_bool bx_capture_gui_c::palette_change(Bit8u index, Bit8u red, Bit8u green, Bit8u blue)
+{
+  capPalette[index] = (red << 16) | (green << 8) | blue;
+  return 1;
+}
+
+
+// ::GRAPHICS_TILE_UPDATE()
+//
+// Called to request that a tile of graphics be drawn to the
+// screen, since info in this region has changed.
+//
+// tile: array of 8bit values representing a block of pixels with
+//       dimension equal to the 'x_tilesize' & 'y_tilesize' members.
+//       Each value specifies an index into the
+//       array of colors you allocated for ::palette_change()
+// x0: x origin of tile
+// y0: y origin of tile
+
+void bx_capture_gui_c::graphics_tile_update(Bit8u *tile, unsigned x0, unsigned y0)
+{
+  unsigned y, y_size, x_size;
+
+  if ((x0 >= capWidth) || (y0 >= capHeight)) return;
+  x_size = (x0 + x_tilesize > capWidth) ? (capWidth - x0) : x_tilesize;
+  y_size = (y0 + y_tilesize > capHeight) ? (capHeight - y0) : y_tilesize;
+  for (y = 0; y < y_size; y++) {
+    Bit32u *dst = &capScreen[(y0 + y) * capWidth + x0];
+#ifdef BX_LITTLE_ENDIAN
+    bx_pixconv.index8_to_32(dst, tile, capPalette, x_size);
+#else
+    for (unsigned x = 0; x < x_size; x++) {
+      dst[x] = capPalette[tile[x]];
+    }
+#endif
+    tile += x_tilesize;
+  }
+}
+
+bx_svga_tileinfo_t *bx_capture_gui_c::graphics_tile_info(bx_svga_tileinfo_t *info)
+{
+  info->bpp = 32;
+  info->pitch = capWidth * 4;
+  info->red_shift = 24;
+  info->green_shift = 16;
+  info->blue_shift = 8;
+  info->red_mask = 0xff0000;
+  info->green_mask = 0x00ff00;
+  info->blue_mask = 0x0000ff;
+  info->is_indexed = 0;
+#ifdef BX_LITTLE_ENDIAN
+  info->is_little_endian = 1;
+#else
+  info->is_little_endian = 0;
+#endif
+  return info;
+}
+
+Bit8u *bx_capture_gui_c::graphics_tile_get(unsigned x0, unsigned y0,
+                                           unsigned *w, unsigned *h)
+{
+  *w = (x0 + x_tilesize > capWidth) ? (capWidth - x0) : x_tilesize;
+  *h = (y0 + y_tilesize > capHeight) ? (capHeight - y0) : y_tilesize;
+  return (Bit8u *)&capScreen[y0 * capWidth + x0];
+}
+
+void bx_capture_gui_c::graphics_tile_update_in_place(unsigned x0, unsigned y0,
+                                                     unsigned w, unsigned h)
+{
+  // the tile has been rendered directly into the framebuffer
+  UNUSED(x0);
+  UNUSED(y0);
+  UNUSED(w);
+  UNUSED(h);
+}
+
+
+// ::DIMENSION_UPDATE()
+//
+// Called when the VGA mode changes it's X,Y dimensions.
+// The framebuffer is resized and cleared.
+//
+// x: new VGA x size
+// y: new VGA y size
+// fheight: new VGA character height in text mode
+// fwidth : new VGA character width in text mode
+// bpp : bits per pixel in graphics mode
+
+void bx_capture_gui_c::dimension_update(unsigned x, unsigned y, unsigned fheight, unsigned fwidth, unsigned bpp)
+{
+  if ((bpp == 8) || (bpp == 15) || (bpp == 16) || (bpp == 24) || (bpp == 32)) {
+    guest_bpp = bpp;
+  } else {
+    BX_PANIC(("%d bpp graphics mode not supported", bpp));
+  }
+  guest_textmode = (fheight > 0);
+  guest_xres = x;
+  guest_yres = y;
+  if (guest_textmode) {
+    font_height = fheight;
+    font_width = fwidth;
+    text_cols = x / fwidth;
+    text_rows = y / fheight;
+  }
+  if ((x > BX_CAPTURE_MAX_XRES) || (y > BX_CAPTURE_MAX_YRES)) {
+    BX_PANIC(("dimension_update(): capture doesn't support graphics mode %dx%d", x, y));
+    return;
+  }
+  if ((x != capWidth) || (y != capHeight)) {
+    delete [] capScreen;
+    capWidth = x;
+    capHeight = y;
+    capScreen = new Bit32u[capWidth * capHeight];
+    memset(capScreen, 0, capWidth * capHeight * 4);
+  }
+}
+
+
+// ::CREATE_BITMAP()
+//
+// There is no headerbar, so bitmaps are not stored.
+
+unsigned bx_capture_gui_c::create_bitmap(const unsigned char *bmap, unsigned xdim, unsigned ydim)
+{
+  UNUSED(bmap);
+  UNUSED(xdim);
+  UNUSED(ydim);
+  return(0);
+}
+
+
+// ::HEADERBAR_BITMAP()
+//
+// There is no headerbar, so nothing is registered.
+
+unsigned bx_capture_gui_c::headerbar_bitmap(unsigned bmap_id, unsigned alignment, void (*f)(void))
+{
+  UNUSED(bmap_id);
+  UNUSED(alignment);
+  UNUSED(f);
+  return(0);
+}
+
+
+// ::SHOW_HEADERBAR()
+//
+// There is no headerbar.
+
+void bx_capture_gui_c::show_headerbar(void)
+{
+}
+
+
+// ::REPLACE_BITMAP()
+//
+// There is no headerbar.
+
+void bx_capture_gui_c::replace_bitmap(unsigned hbar_id, unsigned bmap_id)
+{
+  UNUSED(hbar_id);
+  UNUSED(bmap_id);
+}
+
+
+// ::EXIT()
+//
+// Called before bochs terminates. Waits for the encoder thread to write
+// the queued frames and closes the video file.
+
+void bx_capture_gui_c::exit(void)
+{
+#if defined(SIGUSR1) && !defined(WIN32)
+  capture_signal_exit();
+#endif
+  if (capThreadStarted) {
+    BX_LOCK(capLock);
+    capQuit = 1;
+    BX_COND_SIGNAL(capCond);
+    BX_UNLOCK(capLock);
+    BX_THREAD_JOIN(capThread);
+    capThreadStarted = 0;
+    capture_report();
+    BX_FINI_COND(capCond);
+    BX_FINI_MUTEX(capLock);
+  }
+  if (capVideoFile != NULL) {
+    fclose(capVideoFile);
+    capVideoFile = NULL;
+  }
+  if (capDropped > 0) {
+    BX_INFO(("%u video frames dropped while the encoder was busy", capDropped));
+  }
+  for (unsigned i = 0; i < BX_CAPTURE_QUEUE; i++) {
+    delete [] capQueue[i].pixels;
+    capQueue[i].pixels = NULL;
+    capQueue[i].size = 0;
+  }
+  delete [] capYuv;
+  capYuv = NULL;
+  capYuvSize = 0;
+  delete [] capScreen;
+  capScreen = NULL;
+}
+
+
+void bx_capture_gui_c::mouse_enabled_changed_specific(bx_bool val)
+{
+  UNUSED(val);
+}
+
+
+void bx_capture_gui_c::get_capabilities(Bit16u *xres, Bit16u *yres, Bit16u *bpp)
+{
+  *xres = BX_CAPTURE_MAX_XRES;
+  *yres = BX_CAPTURE_MAX_YRES;
+  *bpp = 32;
+}
+
+#endif /* if BX_WITH_CAPTURE */
@@ -22,6 +22,7 @@
 #include <signal.h>
 #include "iodev.h"
 #include "keymap.h"
+#include "pixconv.h"
 #include "gui/bitmaps/floppya.h"
 #include "gui/bitmaps/floppyb.h"
 #include "gui/bitmaps/mouse.h"
@@ -145,6 +146,8 @@ void bx_gui_c::init(int argc, char **argv, unsigned max_xres, unsigned max_yres,
       break;
   }
 
+  BX_INFO(("pixel conversion: using %s kernels", bx_pixconv_init()));
+
   specific_init(argc, argv, BX_HEADER_BAR_Y);
 
   // Define some bitmaps to use in the headerbar
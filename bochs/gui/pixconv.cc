@@ -0,0 +1,307 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+#include "bochs.h"
+#include "pixconv.h"
+
+// The SIMD kernels are compiled with per-function target attributes, so
+// the rest of Bochs does not depend on the instruction set of the build
+// host. They are only enabled if the CPU reports the feature at runtime.
+#if (defined(__i386__) || defined(__x86_64__)) && \
+    (defined(__clang__) || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define BX_PIXCONV_X86 1
+#include <immintrin.h>
+#define BX_TARGET(isa) __attribute__((target(isa)))
+#else
+#define BX_PIXCONV_X86 0
+#endif
+
+/////////////////////////////////////////////////////////////////////////
+// generic versions
+/////////////////////////////////////////////////////////////////////////
+
+static void index8_to_32_c(Bit32u *dst, const Bit8u *src, const Bit32u *lut, unsigned n)
+{
+  for (unsigned i = 0; i < n; i++) {
+    WriteHostDWordToLittleEndian(&dst[i], lut[src[i]]);
+  }
+}
+
+BX_CPP_INLINE Bit32u rgb16_pixel(Bit32u c, const bx_pixconv_rgb16_t *fmt)
+{
+  Bit32u colour = 0;
+
+  for (int i = 0; i < 3; i++) {
+    if (fmt->shift[i] > 0) {
+      colour |= ((c & fmt->src_mask[i]) << fmt->shift[i]) & fmt->dst_mask[i];
+    } else {
+      colour |= ((c & fmt->src_mask[i]) >> -fmt->shift[i]) & fmt->dst_mask[i];
+    }
+  }
+  return colour;
+}
+
+static void rgb16_to_32_c(Bit32u *dst, const Bit8u *src, unsigned n, const bx_pixconv_rgb16_t *fmt)
+{
+  for (unsigned i = 0; i < n; i++) {
+    WriteHostDWordToLittleEndian(&dst[i], rgb16_pixel(src[0] | (src[1] << 8), fmt));
+    src += 2;
+  }
+}
+
+static void planar_to_index_c(Bit8u *dst, Bit8u **plane, Bit32u offset, unsigned nbytes, const Bit8u *map)
+{
+  Bit8u b0, b1, b2, b3, attribute;
+
+  for (unsigned i = 0; i < nbytes; i++) {
+    b0 = plane[0][offset + i];
+    b1 = plane[1][offset + i];
+    b2 = plane[2][offset + i];
+    b3 = plane[3][offset + i];
+    for (int bit_no = 7; bit_no >= 0; bit_no--) {
+      attribute = ((b0 >> bit_no) & 0x01) |
+                  (((b1 >> bit_no) & 0x01) << 1) |
+                  (((b2 >> bit_no) & 0x01) << 2) |
+                  (((b3 >> bit_no) & 0x01) << 3);
+      *(dst++) = map[attribute];
+    }
+  }
+}
+
+#if BX_PIXCONV_X86
+
+/////////////////////////////////////////////////////////////////////////
+// SSE2 / SSSE3 versions
+/////////////////////////////////////////////////////////////////////////
+
+BX_TARGET("sse2")
+static inline __m128i rgb16_pixels_sse2(__m128i v, const __m128i *src_mask,
+                                        const __m128i *dst_mask, const __m128i *count,
+                                        const bx_pixconv_rgb16_t *fmt)
+{
+  __m128i t, colour = _mm_setzero_si128();
+
+  for (int i = 0; i < 3; i++) {
+    t = _mm_and_si128(v, src_mask[i]);
+    if (fmt->shift[i] > 0) {
+      t = _mm_sll_epi32(t, count[i]);
+    } else {
+      t = _mm_srl_epi32(t, count[i]);
+    }
+    colour = _mm_or_si128(colour, _mm_and_si128(t, dst_mask[i]));
+  }
+  return colour;
+}
+
+BX_TARGET("sse2")
+static void rgb16_to_32_sse2(Bit32u *dst, const Bit8u *src, unsigned n, const bx_pixconv_rgb16_t *fmt)
+{
+  __m128i src_mask[3], dst_mask[3], count[3];
+  __m128i p, zero = _mm_setzero_si128();
+  unsigned i;
+
+  for (i = 0; i < 3; i++) {
+    src_mask[i] = _mm_set1_epi32(fmt->src_mask[i]);
+    dst_mask[i] = _mm_set1_epi32(fmt->dst_mask[i]);
+    count[i] = _mm_cvtsi32_si128((fmt->shift[i] > 0) ? fmt->shift[i] : -fmt->shift[i]);
+  }
+  for (i = 0; (i + 8) <= n; i += 8) {
+    p = _mm_loadu_si128((const __m128i *)(src + 2*i));
+    _mm_storeu_si128((__m128i *)(dst + i),
+      rgb16_pixels_sse2(_mm_unpacklo_epi16(p, zero), src_mask, dst_mask, count, fmt));
+    _mm_storeu_si128((__m128i *)(dst + i + 4),
+      rgb16_pixels_sse2(_mm_unpackhi_epi16(p, zero), src_mask, dst_mask, count, fmt));
+  }
+  rgb16_to_32_c(dst + i, src + 2*i, n - i, fmt);
+}
+
+// spread the bits of two bytes of one plane to 16 lanes (0xff = bit set),
+// most significant bit first like the VGA shift register
+BX_TARGET("sse2")
+static inline __m128i plane_bits_sse2(const Bit8u *p, __m128i bit_sel)
+{
+  __m128i v = _mm_cvtsi32_si128(p[0] | (p[1] << 8));
+
+  v = _mm_unpacklo_epi8(v, v);
+  v = _mm_unpacklo_epi16(v, v);
+  v = _mm_unpacklo_epi32(v, v);
+  return _mm_cmpeq_epi8(_mm_and_si128(v, bit_sel), bit_sel);
+}
+
+BX_TARGET("sse2")
+static inline __m128i planar_attr_sse2(Bit8u **plane, Bit32u offset)
+{
+  const __m128i bit_sel = _mm_set_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80,
+                                       0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80);
+  __m128i attr;
+
+  attr = _mm_and_si128(plane_bits_sse2(&plane[0][offset], bit_sel), _mm_set1_epi8(0x01));
+  attr = _mm_or_si128(attr, _mm_and_si128(plane_bits_sse2(&plane[1][offset], bit_sel), _mm_set1_epi8(0x02)));
+  attr = _mm_or_si128(attr, _mm_and_si128(plane_bits_sse2(&plane[2][offset], bit_sel), _mm_set1_epi8(0x04)));
+  attr = _mm_or_si128(attr, _mm_and_si128(plane_bits_sse2(&plane[3][offset], bit_sel), _mm_set1_epi8(0x08)));
+  return attr;
+}
+
+BX_TARGET("sse2")
+static void planar_to_index_sse2(Bit8u *dst, Bit8u **plane, Bit32u offset, unsigned nbytes, const Bit8u *map)
+{
+  Bit8u attr[16];
+  unsigned i, j;
+
+  for (i = 0; (i + 2) <= nbytes; i += 2) {
+    _mm_storeu_si128((__m128i *)attr, planar_attr_sse2(plane, offset + i));
+    for (j = 0; j < 16; j++) {
+      *(dst++) = map[attr[j]];
+    }
+  }
+  planar_to_index_c(dst, plane, offset + i, nbytes - i, map);
+}
+
+BX_TARGET("ssse3")
+static void planar_to_index_ssse3(Bit8u *dst, Bit8u **plane, Bit32u offset, unsigned nbytes, const Bit8u *map)
+{
+  __m128i lut = _mm_loadu_si128((const __m128i *)map);
+  unsigned i;
+
+  for (i = 0; (i + 2) <= nbytes; i += 2) {
+    _mm_storeu_si128((__m128i *)dst, _mm_shuffle_epi8(lut, planar_attr_sse2(plane, offset + i)));
+    dst += 16;
+  }
+  planar_to_index_c(dst, plane, offset + i, nbytes - i, map);
+}
+
+/////////////////////////////////////////////////////////////////////////
+// AVX2 versions
+/////////////////////////////////////////////////////////////////////////
+
+BX_TARGET("avx2")
+static void index8_to_32_avx2(Bit32u *dst, const Bit8u *src, const Bit32u *lut, unsigned n)
+{
+  __m256i idx;
+  unsigned i;
+
+  for (i = 0; (i + 8) <= n; i += 8) {
+    idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_i32gather_epi32((const int *)lut, idx, 4));
+  }
+  index8_to_32_c(dst + i, src + i, lut, n - i);
+}
+
+BX_TARGET("avx2")
+static void rgb16_to_32_avx2(Bit32u *dst, const Bit8u *src, unsigned n, const bx_pixconv_rgb16_t *fmt)
+{
+  __m256i src_mask[3], dst_mask[3], v, t, colour;
+  __m128i count[3];
+  unsigned i;
+  int c;
+
+  for (c = 0; c < 3; c++) {
+    src_mask[c] = _mm256_set1_epi32(fmt->src_mask[c]);
+    dst_mask[c] = _mm256_set1_epi32(fmt->dst_mask[c]);
+    count[c] = _mm_cvtsi32_si128((fmt->shift[c] > 0) ? fmt->shift[c] : -fmt->shift[c]);
+  }
+  for (i = 0; (i + 8) <= n; i += 8) {
+    v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + 2*i)));
+    colour = _mm256_setzero_si256();
+    for (c = 0; c < 3; c++) {
+      t = _mm256_and_si256(v, src_mask[c]);
+      if (fmt->shift[c] > 0) {
+        t = _mm256_sll_epi32(t, count[c]);
+      } else {
+        t = _mm256_srl_epi32(t, count[c]);
+      }
+      colour = _mm256_or_si256(colour, _mm256_and_si256(t, dst_mask[c]));
+    }
+    _mm256_storeu_si256((__m256i *)(dst + i), colour);
+  }
+  rgb16_to_32_c(dst + i, src + 2*i, n - i, fmt);
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////
+// kernel selection
+/////////////////////////////////////////////////////////////////////////
+
+bx_pixconv_t bx_pixconv = {
+  "generic", index8_to_32_c, rgb16_to_32_c, planar_to_index_c
+};
+
+unsigned bx_pixconv_variants(bx_pixconv_t *set, unsigned max)
+{
+  bx_pixconv_t conv = {
+    "generic", index8_to_32_c, rgb16_to_32_c, planar_to_index_c
+  };
+  unsigned count = 0;
+
+  if (count < max) set[count++] = conv;
+#if BX_PIXCONV_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2")) {
+    // a 256-entry lookup has no SSE form faster than the scalar loop
+    conv.name = "SSE2";
+    conv.rgb16_to_32 = rgb16_to_32_sse2;
+    conv.planar_to_index = planar_to_index_sse2;
+    if (count < max) set[count++] = conv;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    conv.name = "SSSE3";
+    conv.planar_to_index = planar_to_index_ssse3;
+    if (count < max) set[count++] = conv;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    conv.name = "AVX2";
+    conv.index8_to_32 = index8_to_32_avx2;
+    conv.rgb16_to_32 = rgb16_to_32_avx2;
+    if (count < max) set[count++] = conv;
+  }
+#endif
+  return count;
+}
+
+const char *bx_pixconv_init(void)
+{
+  bx_pixconv_t set[BX_PIXCONV_MAX_VARIANTS];
+
+  bx_pixconv = set[bx_pixconv_variants(set, BX_PIXCONV_MAX_VARIANTS) - 1];
+  return bx_pixconv.name;
+}
+
+void bx_pixconv_rgb16_init(bx_pixconv_rgb16_t *fmt, unsigned bpp, const bx_svga_tileinfo_t *info)
+{
+  if (bpp == 15) {
+    fmt->src_mask[0] = 0x7c00;
+    fmt->shift[0] = info->red_shift - 15;
+    fmt->src_mask[1] = 0x03e0;
+    fmt->shift[1] = info->green_shift - 10;
+  } else {
+    fmt->src_mask[0] = 0xf800;
+    fmt->shift[0] = info->red_shift - 16;
+    fmt->src_mask[1] = 0x07e0;
+    fmt->shift[1] = info->green_shift - 11;
+  }
+  fmt->src_mask[2] = 0x001f;
+  fmt->shift[2] = info->blue_shift - 5;
+  fmt->dst_mask[0] = (Bit32u)info->red_mask;
+  fmt->dst_mask[1] = (Bit32u)info->green_mask;
+  fmt->dst_mask[2] = (Bit32u)info->blue_mask;
+}
@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+/////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////
+//
+// Pixel format conversion kernels used by the display adapters and the
+// gui modules. All kernels convert one row of pixels. The 32 bpp output
+// is written in little endian byte order, the 15/16 bpp input is read in
+// little endian byte order (guest video memory).
+//
+// - index8_to_32(dst, src, lut, n)
+//   looks up n 8-bit palette indices in a table of 256 host pixels
+//
+// - rgb16_to_32(dst, src, n, fmt)
+//   expands n 15 or 16 bpp pixels to the host format described by fmt
+//
+// - planar_to_index(dst, plane, offset, nbytes, map)
+//   combines nbytes of the 4 VGA bit planes to 8*nbytes pixels and maps
+//   the 4-bit attributes through the 16-entry table map
+//
+// The best set of kernels for the host CPU is selected by bx_pixconv_init()
+// at gui init time. Until then the generic C versions are used.
+// bx_pixconv_variants() returns all sets the host CPU supports, generic
+// first and best last (used by misc/bxpixbench).
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef BX_GUI_PIXCONV_H
+#define BX_GUI_PIXCONV_H
+
+// 15/16 bpp source format mapped to a host display format (see MAKE_COLOUR)
+typedef struct {
+  Bit32u src_mask[3];  // red, green, blue
+  int    shift[3];     // > 0: shift left, < 0: shift right
+  Bit32u dst_mask[3];
+} bx_pixconv_rgb16_t;
+
+typedef struct {
+  const char *name;
+  void (*index8_to_32)(Bit32u *dst, const Bit8u *src, const Bit32u *lut, unsigned n);
+  void (*rgb16_to_32)(Bit32u *dst, const Bit8u *src, unsigned n, const bx_pixconv_rgb16_t *fmt);
+  void (*planar_to_index)(Bit8u *dst, Bit8u **plane, Bit32u offset, unsigned nbytes, const Bit8u *map);
+} bx_pixconv_t;
+
+#define BX_PIXCONV_MAX_VARIANTS 4
+
+BOCHSAPI extern bx_pixconv_t bx_pixconv;
+
+BOCHSAPI const char *bx_pixconv_init(void);
+BOCHSAPI unsigned bx_pixconv_variants(bx_pixconv_t *set, unsigned max);
+BOCHSAPI void bx_pixconv_rgb16_init(bx_pixconv_rgb16_t *fmt, unsigned bpp,
+                                    const bx_svga_tileinfo_t *info);
+
+#endif
@@ -49,6 +49,7 @@ extern unsigned char sdl_font8x8[256][8];
 
 #include "rfb.h"
 #include "rfbkeys.h"
+#include "bxthread.h"
 
 class bx_rfb_gui_c : public bx_gui_c {
 public:
@@ -137,14 +138,37 @@ static struct _rfbKeyboardEvent {
 static unsigned long rfbKeyboardEvents = 0;
 static bx_bool bKeyboardInUse = 0;
 
-// Misc Stuff
-static struct _rfbUpdateRegion {
+// Dirty rectangle tracking: changes are recorded in a map of
+// BX_RFB_BLOCK x BX_RFB_BLOCK blocks and coalesced into rectangles when
+// the update is sent
+#define BX_RFB_BLOCK_SHIFT 4
+#define BX_RFB_BLOCK (1 << BX_RFB_BLOCK_SHIFT)
+#define BX_RFB_MAX_RECTS 256
+
+typedef struct {
     unsigned int x;
     unsigned int y;
     unsigned int width;
     unsigned int height;
-    bx_bool updated;
-} rfbUpdateRegion;
+} rfbRect;
+
+static Bit8u *rfbDirty = NULL;
+static unsigned rfbDirtyX, rfbDirtyY;
+static bx_bool rfbDirtyAny = 0;
+static bx_bool rfbFullUpdate = 0;
+
+// screen contents as last sent to the client (source for CopyRect)
+static char *rfbClientScreen = NULL;
+static bx_bool rfbClientScreenValid = 0;
+
+// encodings negotiated with the client, set by the server thread and
+// read by the emulation thread once per update (rfbEncodingLock)
+static Bit32u rfbEncoding = rfbEncodingRaw;
+static bx_bool rfbUseCopyRect = 0;
+static BX_MUTEX(rfbEncodingLock);
+
+static char *rfbSendBuf = NULL;
+static unsigned rfbSendBufSize = 0;
 
 #define BX_RFB_MAX_XDIM 1280
 #define BX_RFB_MAX_YDIM 1024
@@ -198,7 +222,9 @@ void DrawChar(int x, int y, int width, int height, int fonty, char *bmap,
 void UpdateScreen(unsigned char *newBits, int x, int y, int width, int height,
         bx_bool update_client);
 void SendUpdate(int x, int y, int width, int height, Bit32u encoding);
+void rfbInitDirty(void);
 void rfbAddUpdateRegion(unsigned x0, unsigned y0, unsigned w, unsigned h);
+void rfbSendUpdates(void);
 void rfbSetStatusText(int element, const char *text, bx_bool active, bx_bool w = 0);
 static Bit32u convertStringToRfbKey(const char *string);
 void rfbKeyPressed(Bit32u key, int press_release);
@@ -288,18 +314,17 @@ void bx_rfb_gui_c::specific_init(int argc, char **argv, unsigned headerbar_y)
   rfbPalette[7] = (char)0xAD;
   rfbPalette[63] = (char)0xFF;
 
-  rfbUpdateRegion.x = rfbWindowX;
-  rfbUpdateRegion.y = rfbWindowY;
-  rfbUpdateRegion.width  = 0;
-  rfbUpdateRegion.height = 0;
-  rfbUpdateRegion.updated = 0;
+  rfbInitDirty();
 
   clientEncodingsCount=0;
   clientEncodings=NULL;
 
+  sGlobal = INVALID_SOCKET;
   keep_alive = 1;
   client_connected = 0;
   desktop_resizable = 0;
+  // not destroyed in exit(), the server thread is not joined
+  BX_INIT_MUTEX(rfbEncodingLock);
   rfbStartThread();
 
 #ifdef BX_RFB_WIN32
@@ -365,21 +390,13 @@ void bx_rfb_gui_c::handle_events(void)
   }
   bKeyboardInUse = 0;
 
-  if (rfbUpdateRegion.updated) {
-    SendUpdate(rfbUpdateRegion.x, rfbUpdateRegion.y, rfbUpdateRegion.width,
-               rfbUpdateRegion.height, rfbEncodingRaw);
-    rfbUpdateRegion.x = rfbWindowX;
-    rfbUpdateRegion.y = rfbWindowY;
-    rfbUpdateRegion.width  = 0;
-    rfbUpdateRegion.height = 0;
-    rfbUpdateRegion.updated = 0;
-  }
 #if BX_SHOW_IPS
   if (rfbIPSupdate) {
     rfbIPSupdate = 0;
     rfbSetStatusText(0, rfbIPStext, 1);
   }
 #endif
+  rfbSendUpdates();
 }
 
 // ::FLUSH()
@@ -607,6 +624,7 @@ void bx_rfb_gui_c::dimension_update(unsigned x, unsigned y, unsigned fheight, un
       rfbWindowX = rfbDimensionX;
       rfbWindowY = rfbDimensionY + rfbHeaderbarY + rfbStatusbarY;
       rfbScreen = (char *)realloc(rfbScreen, rfbWindowX * rfbWindowY);
+      rfbInitDirty();
       SendUpdate(0, 0, rfbWindowX, rfbWindowY, rfbEncodingDesktopSize);
       bx_gui->show_headerbar();
     } else {
@@ -614,7 +632,7 @@ void bx_rfb_gui_c::dimension_update(unsigned x, unsigned y, unsigned fheight, un
         BX_PANIC(("dimension_update(): RFB doesn't support graphics mode %dx%d", x, y));
       }
       clear_screen();
-      SendUpdate(0, rfbHeaderbarY, rfbDimensionX, rfbDimensionY, rfbEncodingRaw);
+      rfbAddUpdateRegion(0, rfbHeaderbarY, rfbDimensionX, rfbDimensionY);
       rfbDimensionX = x;
       rfbDimensionY = y;
     }
@@ -771,6 +789,9 @@ void bx_rfb_gui_c::exit(void)
   StopWinsock();
 #endif
   free(rfbScreen);
+  free(rfbClientScreen);
+  free(rfbDirty);
+  free(rfbSendBuf);
   for(i = 0; i < rfbBitmapCount; i++) {
     free(rfbBitmaps[i].bmap);
   }
@@ -1021,6 +1042,10 @@ void HandleRfbClient(SOCKET sClient)
     return;
   }
 
+  BX_LOCK(rfbEncodingLock);
+  rfbEncoding = rfbEncodingRaw;
+  rfbUseCopyRect = 0;
+  BX_UNLOCK(rfbEncodingLock);
   client_connected = 1;
   sGlobal = sClient;
   while (keep_alive) {
@@ -1072,6 +1097,7 @@ void HandleRfbClient(SOCKET sClient)
           rfbSetEncodingsMessage se;
           Bit32u                 i;
           U32                    enc;
+          bx_bool                picked, copyrect;
 
           // free previously registered encodings
           if (clientEncodings != NULL) {
@@ -1098,8 +1124,11 @@ void HandleRfbClient(SOCKET sClient)
             clientEncodings[i]=ntohl(enc);
           }
 
-          // print supported encodings
+          // print supported encodings and pick the first one we can send
           BX_INFO(("rfbSetEncodings : client supported encodings:"));
+          enc = rfbEncodingRaw;
+          picked = 0;
+          copyrect = 0;
           for (i = 0; i < clientEncodingsCount; i++) {
             Bit32u j;
             bx_bool found = 0;
@@ -1109,12 +1138,24 @@ void HandleRfbClient(SOCKET sClient)
                 found=1;
                 if (clientEncodings[i] == rfbEncodingDesktopSize) {
                   desktop_resizable = 1;
+                } else if (clientEncodings[i] == rfbEncodingCopyRect) {
+                  copyrect = 1;
+                } else if (((clientEncodings[i] == rfbEncodingHextile) ||
+                            (clientEncodings[i] == rfbEncodingRaw)) && !picked) {
+                  enc = clientEncodings[i];
+                  picked = 1;
                 }
                 break;
               }
             }
             if (!found) BX_INFO(("%08x Unknown", clientEncodings[i]));
           }
+          BX_LOCK(rfbEncodingLock);
+          rfbEncoding = enc;
+          rfbUseCopyRect = copyrect;
+          BX_UNLOCK(rfbEncodingLock);
+          BX_INFO(("using %s encoding%s", (enc == rfbEncodingHextile) ? "Hextile" : "Raw",
+                   copyrect ? " and CopyRect" : ""));
           break;
         }
       case rfbFramebufferUpdateRequest:
@@ -1123,18 +1164,9 @@ void HandleRfbClient(SOCKET sClient)
 
           ReadExact(sClient, (char *)&fur, sizeof(rfbFramebufferUpdateRequestMessage));
           if(!fur.incremental) {
-            rfbUpdateRegion.x = 0;
-            rfbUpdateRegion.y = 0;
-            rfbUpdateRegion.width  = rfbWindowX;
-            rfbUpdateRegion.height = rfbWindowY;
-            rfbUpdateRegion.updated = 1;
-          } //else {
-          //    if(fur.x < rfbUpdateRegion.x) rfbUpdateRegion.x = fur.x;
-          //    if(fur.y < rfbUpdateRegion.x) rfbUpdateRegion.y = fur.y;
-          //    if(((fur.x + fur.w) - rfbUpdateRegion.x) > rfbUpdateRegion.width) rfbUpdateRegion.width = ((fur.x + fur.w) - rfbUpdateRegion.x);
-          //    if(((fur.y + fur.h) - rfbUpdateRegion.y) > rfbUpdateRegion.height) rfbUpdateRegion.height = ((fur.y + fur.h) - rfbUpdateRegion.y);
-          //}
-          //rfbUpdateRegion.updated = 1;
+            // the emulation thread resends the whole screen
+            rfbFullUpdate = 1;
+          }
           break;
         }
       case rfbKeyEvent:
@@ -1302,19 +1334,7 @@ void UpdateScreen(unsigned char *newBits, int x, int y, int width, int height,
     y++;
   }
   if (update_client) {
-    if(sGlobal == INVALID_SOCKET) return;
-    rfbFramebufferUpdateMessage fum;
-    rfbFramebufferUpdateRectHeader furh;
-    fum.messageType = rfbFramebufferUpdate;
-    fum.numberOfRectangles = htons(1);
-    WriteExact(sGlobal, (char *)&fum, rfbFramebufferUpdateMessageSize);
-    furh.r.xPosition = htons(x0);
-    furh.r.yPosition = htons(y0);
-    furh.r.width = htons((short)width);
-    furh.r.height = htons((short)height);
-    furh.r.encodingType = htonl(rfbEncodingRaw);
-    WriteExact(sGlobal, (char *)&furh, rfbFramebufferUpdateRectHeaderSize);
-    WriteExact(sGlobal, (char *)newBits, width * height);
+    rfbAddUpdateRegion(x0, y0, width, height);
   }
 }
 
@@ -1353,20 +1373,369 @@ void SendUpdate(int x, int y, int width, int height, Bit32u encoding)
     }
 }
 
+// (re)allocate the dirty map and the client's copy of the screen for the
+// current window size and mark everything for update
+void rfbInitDirty(void)
+{
+  rfbDirtyX = (rfbWindowX + BX_RFB_BLOCK - 1) >> BX_RFB_BLOCK_SHIFT;
+  rfbDirtyY = (rfbWindowY + BX_RFB_BLOCK - 1) >> BX_RFB_BLOCK_SHIFT;
+  rfbDirty = (Bit8u *)realloc(rfbDirty, rfbDirtyX * rfbDirtyY);
+  rfbClientScreen = (char *)realloc(rfbClientScreen, rfbWindowX * rfbWindowY);
+  memset(rfbDirty, 1, rfbDirtyX * rfbDirtyY);
+  rfbDirtyAny = 1;
+  rfbClientScreenValid = 0;
+}
+
 void rfbAddUpdateRegion(unsigned x0, unsigned y0, unsigned w, unsigned h)
 {
-  if (x0 < rfbUpdateRegion.x) rfbUpdateRegion.x = x0;
-  if (y0 < rfbUpdateRegion.y) rfbUpdateRegion.y = y0;
-  if ((y0 + h - rfbUpdateRegion.y) > rfbUpdateRegion.height) {
-    rfbUpdateRegion.height = y0 + h - rfbUpdateRegion.y;
+  unsigned x1, y1, bx0, bx1, by;
+
+  if ((x0 >= rfbWindowX) || (y0 >= rfbWindowY) || (w == 0) || (h == 0)) return;
+  x1 = (x0 + w > rfbWindowX) ? rfbWindowX : x0 + w;
+  y1 = (y0 + h > rfbWindowY) ? rfbWindowY : y0 + h;
+  bx0 = x0 >> BX_RFB_BLOCK_SHIFT;
+  bx1 = (x1 - 1) >> BX_RFB_BLOCK_SHIFT;
+  for (by = y0 >> BX_RFB_BLOCK_SHIFT; by <= ((y1 - 1) >> BX_RFB_BLOCK_SHIFT); by++) {
+    memset(&rfbDirty[by * rfbDirtyX + bx0], 1, bx1 - bx0 + 1);
+  }
+  rfbDirtyAny = 1;
+}
+
+static Bit32u rfbRowHash(const char *row, unsigned len)
+{
+  Bit32u hash = 2166136261U;
+
+  for (unsigned i = 0; i < len; i++) {
+    hash = (hash ^ (Bit8u)row[i]) * 16777619U;
+  }
+  return hash;
+}
+
+// Look for a vertical scroll of the guest display between the client's
+// copy of the screen and the current one in the rows y0 .. y1-1. Returns
+// the number of rows the client can copy from *src_y to *dst_y.
+static unsigned rfbFindScroll(unsigned y0, unsigned y1, unsigned *src_y, unsigned *dst_y)
+{
+  unsigned h = y1 - y0, width = rfbDimensionX, rows = 0, best = 0;
+  unsigned run, useful, y, ystart, yend;
+  Bit32u *hnew, *hold;
+  int dy;
+
+  hnew = new Bit32u[h * 2];
+  hold = hnew + h;
+  for (y = 0; y < h; y++) {
+    hnew[y] = rfbRowHash(&rfbScreen[(y0 + y) * rfbWindowX], width);
+    hold[y] = rfbRowHash(&rfbClientScreen[(y0 + y) * rfbWindowX], width);
+  }
+  // find the offset with the longest run of matching rows that the
+  // client doesn't show at their new position yet
+  for (dy = 1 - (int)h; dy < (int)h; dy++) {
+    if (dy == 0) continue;
+    ystart = (dy < 0) ? -dy : 0;
+    yend = (dy > 0) ? h - dy : h;
+    run = useful = 0;
+    for (y = ystart; y < yend; y++) {
+      if (hnew[y] == hold[y + dy]) {
+        run++;
+        if (hnew[y] != hold[y]) useful++;
+        if (useful > best) {
+          best = useful;
+          rows = run;
+          *dst_y = y0 + y + 1 - run;
+          *src_y = *dst_y + dy;
+        }
+      } else {
+        run = useful = 0;
+      }
+    }
+  }
+  delete [] hnew;
+  if (best < BX_RFB_BLOCK) return 0;
+  // don't trust the hashes
+  for (y = 0; y < rows; y++) {
+    if (memcmp(&rfbScreen[(*dst_y + y) * rfbWindowX],
+               &rfbClientScreen[(*src_y + y) * rfbWindowX], width)) return 0;
+  }
+  return rows;
+}
+
+// drop the dirty blocks the client already shows
+static void rfbFilterDirty(void)
+{
+  unsigned bx, by, x, y, w, h, i;
+
+  for (by = 0; by < rfbDirtyY; by++) {
+    y = by << BX_RFB_BLOCK_SHIFT;
+    h = (y + BX_RFB_BLOCK > rfbWindowY) ? rfbWindowY - y : BX_RFB_BLOCK;
+    for (bx = 0; bx < rfbDirtyX; bx++) {
+      if (!rfbDirty[by * rfbDirtyX + bx]) continue;
+      x = bx << BX_RFB_BLOCK_SHIFT;
+      w = (x + BX_RFB_BLOCK > rfbWindowX) ? rfbWindowX - x : BX_RFB_BLOCK;
+      for (i = 0; i < h; i++) {
+        if (memcmp(&rfbScreen[(y + i) * rfbWindowX + x],
+                   &rfbClientScreen[(y + i) * rfbWindowX + x], w)) break;
+      }
+      if (i == h) rfbDirty[by * rfbDirtyX + bx] = 0;
+    }
+  }
+}
+
+// Coalesce the dirty blocks into rectangles: runs of blocks in a row are
+// merged with a run of the same span in the row above. The map is cleared.
+static unsigned rfbGetDirtyRects(rfbRect *rects)
+{
+  unsigned n = 0, bx, by, x0, i;
+
+  for (by = 0; by < rfbDirtyY; by++) {
+    Bit8u *dirty = &rfbDirty[by * rfbDirtyX];
+    bx = 0;
+    while (bx < rfbDirtyX) {
+      if (!dirty[bx]) {
+        bx++;
+        continue;
+      }
+      x0 = bx;
+      while ((bx < rfbDirtyX) && dirty[bx]) {
+        dirty[bx++] = 0;
+      }
+      for (i = 0; i < n; i++) {
+        if ((rects[i].x == x0) && (rects[i].width == (bx - x0)) &&
+            ((rects[i].y + rects[i].height) == by)) break;
+      }
+      if (i < n) {
+        rects[i].height++;
+      } else if (n < BX_RFB_MAX_RECTS) {
+        rects[n].x = x0;
+        rects[n].y = by;
+        rects[n].width = bx - x0;
+        rects[n].height = 1;
+        n++;
+      } else {
+        // too many rectangles: grow the last one
+        rfbRect *r = &rects[n - 1];
+        unsigned x1 = ((r->x + r->width) > bx) ? (r->x + r->width) : bx;
+        if (x0 < r->x) r->x = x0;
+        r->width = x1 - r->x;
+        r->height = by - r->y + 1;
+      }
+    }
   }
-  if ((x0 + w - rfbUpdateRegion.x) > rfbUpdateRegion.width) {
-    rfbUpdateRegion.width = x0 + w - rfbUpdateRegion.x;
+  // convert to pixels
+  for (i = 0; i < n; i++) {
+    rects[i].x <<= BX_RFB_BLOCK_SHIFT;
+    rects[i].y <<= BX_RFB_BLOCK_SHIFT;
+    rects[i].width <<= BX_RFB_BLOCK_SHIFT;
+    rects[i].height <<= BX_RFB_BLOCK_SHIFT;
+    if ((rects[i].x + rects[i].width) > rfbWindowX) rects[i].width = rfbWindowX - rects[i].x;
+    if ((rects[i].y + rects[i].height) > rfbWindowY) rects[i].height = rfbWindowY - rects[i].y;
   }
-  if ((rfbUpdateRegion.x + rfbUpdateRegion.width) > rfbWindowX) {
-    rfbUpdateRegion.width = rfbWindowX - rfbUpdateRegion.x;
+  return n;
+}
+
+// Hextile encoding of an area of the screen (8 bpp), returns the size
+static unsigned rfbEncodeHextile(const rfbRect *r, Bit8u *dst)
+{
+  Bit8u tile[256], used[256];
+  Bit16u count[256];
+  Bit8u *out = dst, *hdr, *nsub, *limit;
+  Bit8u bg = 0, fg = 0, c;
+  bx_bool validBg = 0, validFg = 0, raw;
+  unsigned tx, ty, tw, th, x, y, i, j, cw, ch, ncolors;
+
+  for (ty = 0; ty < r->height; ty += 16) {
+    th = ((r->height - ty) > 16) ? 16 : r->height - ty;
+    for (tx = 0; tx < r->width; tx += 16) {
+      tw = ((r->width - tx) > 16) ? 16 : r->width - tx;
+      memset(count, 0, sizeof(count));
+      ncolors = 0;
+      for (y = 0; y < th; y++) {
+        memcpy(&tile[y * tw], &rfbScreen[(r->y + ty + y) * rfbWindowX + r->x + tx], tw);
+        for (x = 0; x < tw; x++) {
+          if (count[tile[y * tw + x]]++ == 0) ncolors++;
+        }
+      }
+      // the most frequent colour is the background
+      c = tile[0];
+      for (i = 1; i < (tw * th); i++) {
+        if (count[tile[i]] > count[c]) c = tile[i];
+      }
+      hdr = out++;
+      *hdr = 0;
+      if (!validBg || (c != bg)) {
+        *hdr |= rfbHextileBackgroundSpecified;
+        *out++ = c;
+        bg = c;
+        validBg = 1;
+      }
+      if (ncolors == 1) continue;
+      if (ncolors == 2) {
+        for (i = 0; tile[i] == bg; i++);
+        if (!validFg || (tile[i] != fg)) {
+          *hdr |= rfbHextileForegroundSpecified;
+          *out++ = tile[i];
+          fg = tile[i];
+          validFg = 1;
+        }
+      } else {
+        *hdr |= rfbHextileSubrectsColoured;
+        validFg = 0;
+      }
+      *hdr |= rfbHextileAnySubrects;
+      nsub = out++;
+      *nsub = 0;
+      // fall back to a raw tile if the subrectangles don't save anything
+      limit = hdr + 1 + tw * th;
+      raw = 0;
+      memset(used, 0, tw * th);
+      for (y = 0; (y < th) && !raw; y++) {
+        for (x = 0; x < tw; x++) {
+          i = y * tw + x;
+          if (used[i] || (tile[i] == bg)) continue;
+          c = tile[i];
+          for (cw = 1; ((x + cw) < tw) && (tile[i + cw] == c) && !used[i + cw]; cw++);
+          for (ch = 1; (y + ch) < th; ch++) {
+            for (j = 0; j < cw; j++) {
+              if ((tile[i + ch * tw + j] != c) || used[i + ch * tw + j]) break;
+            }
+            if (j < cw) break;
+          }
+          if ((out + ((ncolors > 2) ? 3 : 2)) > limit) {
+            raw = 1;
+            break;
+          }
+          for (j = 0; j < ch; j++) {
+            memset(&used[i + j * tw], 1, cw);
+          }
+          if (ncolors > 2) *out++ = c;
+          *out++ = rfbHextilePackXY(x, y);
+          *out++ = rfbHextilePackWH(cw, ch);
+          (*nsub)++;
+        }
+      }
+      if (raw) {
+        out = hdr;
+        *out++ = rfbHextileRaw;
+        memcpy(out, tile, tw * th);
+        out += tw * th;
+        validBg = validFg = 0;
+      }
+    }
+  }
+  return out - dst;
+}
+
+static Bit8u *rfbPutRectHeader(Bit8u *out, unsigned x, unsigned y, unsigned w, unsigned h, Bit32u encoding)
+{
+  rfbFramebufferUpdateRectHeader furh;
+
+  furh.r.xPosition = htons(x);
+  furh.r.yPosition = htons(y);
+  furh.r.width = htons((short)w);
+  furh.r.height = htons((short)h);
+  furh.r.encodingType = htonl(encoding);
+  memcpy(out, &furh, rfbFramebufferUpdateRectHeaderSize);
+  return out + rfbFramebufferUpdateRectHeaderSize;
+}
+
+// Send the dirty parts of the screen to the client in one update message:
+// a CopyRect for a scrolled display area first, then the remaining dirty
+// rectangles with the encoding negotiated with the client.
+void rfbSendUpdates(void)
+{
+  rfbRect rects[BX_RFB_MAX_RECTS];
+  rfbFramebufferUpdateMessage fum;
+  rfbCopyRect cr;
+  unsigned nrects, copy_rows = 0, src_y = 0, dst_y = 0, by0, by1, y0, y1, i, y;
+  Bit32u size, encoding;
+  bx_bool use_copyrect;
+  Bit8u *out;
+
+  if (rfbFullUpdate) {
+    rfbFullUpdate = 0;
+    memset(rfbDirty, 1, rfbDirtyX * rfbDirtyY);
+    rfbDirtyAny = 1;
+    rfbClientScreenValid = 0;
+  }
+  if (!rfbDirtyAny) return;
+  rfbDirtyAny = 0;
+  if (sGlobal == INVALID_SOCKET) {
+    memset(rfbDirty, 0, rfbDirtyX * rfbDirtyY);
+    return;
+  }
+
+  // the client may change the encodings while the update is built
+  BX_LOCK(rfbEncodingLock);
+  encoding = rfbEncoding;
+  use_copyrect = rfbUseCopyRect;
+  BX_UNLOCK(rfbEncodingLock);
+
+  if (rfbClientScreenValid) {
+    if (use_copyrect) {
+      // rows of the guest display with changes
+      for (by0 = 0; (by0 < rfbDirtyY) &&
+           !memchr(&rfbDirty[by0 * rfbDirtyX], 1, rfbDirtyX); by0++);
+      for (by1 = rfbDirtyY; (by1 > by0) &&
+           !memchr(&rfbDirty[(by1 - 1) * rfbDirtyX], 1, rfbDirtyX); by1--);
+      y0 = by0 << BX_RFB_BLOCK_SHIFT;
+      y1 = by1 << BX_RFB_BLOCK_SHIFT;
+      if (y0 < (unsigned)rfbHeaderbarY) y0 = rfbHeaderbarY;
+      if (y1 > (rfbHeaderbarY + rfbDimensionY)) y1 = rfbHeaderbarY + rfbDimensionY;
+      if (y1 > (y0 + BX_RFB_BLOCK)) {
+        copy_rows = rfbFindScroll(y0, y1, &src_y, &dst_y);
+      }
+      if (copy_rows > 0) {
+        for (i = 0; i < copy_rows; i++) {
+          y = (src_y > dst_y) ? i : copy_rows - 1 - i;
+          memcpy(&rfbClientScreen[(dst_y + y) * rfbWindowX],
+                 &rfbClientScreen[(src_y + y) * rfbWindowX], rfbDimensionX);
+        }
+      }
+    }
+    rfbFilterDirty();
+  }
+  nrects = rfbGetDirtyRects(rects);
+  if ((nrects == 0) && (copy_rows == 0)) return;
+
+  // worst case: raw Hextile tiles
+  size = rfbFramebufferUpdateMessageSize + rfbFramebufferUpdateRectHeaderSize + rfbCopyRectSize;
+  for (i = 0; i < nrects; i++) {
+    size += rfbFramebufferUpdateRectHeaderSize + rects[i].width * rects[i].height +
+            ((rects[i].width + 15) >> 4) * ((rects[i].height + 15) >> 4);
+  }
+  if (size > rfbSendBufSize) {
+    rfbSendBuf = (char *)realloc(rfbSendBuf, size);
+    rfbSendBufSize = size;
+  }
+
+  out = (Bit8u *)rfbSendBuf;
+  fum.messageType = rfbFramebufferUpdate;
+  fum.padding = 0;
+  fum.numberOfRectangles = htons(nrects + (copy_rows > 0));
+  memcpy(out, &fum, rfbFramebufferUpdateMessageSize);
+  out += rfbFramebufferUpdateMessageSize;
+  if (copy_rows > 0) {
+    out = rfbPutRectHeader(out, 0, dst_y, rfbDimensionX, copy_rows, rfbEncodingCopyRect);
+    cr.srcXPosition = htons(0);
+    cr.srcYPosition = htons(src_y);
+    memcpy(out, &cr, rfbCopyRectSize);
+    out += rfbCopyRectSize;
+  }
+  for (i = 0; i < nrects; i++) {
+    const rfbRect *r = &rects[i];
+    out = rfbPutRectHeader(out, r->x, r->y, r->width, r->height, encoding);
+    if (encoding == rfbEncodingHextile) {
+      out += rfbEncodeHextile(r, out);
+    }
+    for (y = r->y; y < (r->y + r->height); y++) {
+      if (encoding == rfbEncodingRaw) {
+        memcpy(out, &rfbScreen[y * rfbWindowX + r->x], r->width);
+        out += r->width;
+      }
+      memcpy(&rfbClientScreen[y * rfbWindowX + r->x], &rfbScreen[y * rfbWindowX + r->x], r->width);
+    }
   }
-  rfbUpdateRegion.updated = 1;
+  WriteExact(sGlobal, rfbSendBuf, out - (Bit8u *)rfbSendBuf);
+  rfbClientScreenValid = 1;
 }
 
 void rfbSetStatusText(int element, const char *text, bx_bool active, bx_bool w)
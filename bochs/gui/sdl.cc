@@ -30,6 +30,7 @@
 #include "param_names.h"
 #include "keymap.h"
 #include "iodev.h"
+#include "pixconv.h"
 #if BX_WITH_SDL
 
 #include <stdlib.h>
@@ -682,8 +683,7 @@ int bx_sdl_gui_c::set_clipboard_text(char *text_snapshot, Bit32u len)
 void bx_sdl_gui_c::graphics_tile_update(Bit8u *snapshot, unsigned x, unsigned y)
 {
   Uint32 *buf, disp;
-  Uint32 *buf_row;
-  int i,j;
+  int i;
 
   if(sdl_screen)
   {
@@ -705,12 +705,18 @@ void bx_sdl_gui_c::graphics_tile_update(Bit8u *snapshot, unsigned x, unsigned y)
   switch (disp_bpp) {
     case 8: /* 8 bpp */
       do {
-        buf_row = buf;
-        j = x_tilesize;
+#ifdef BX_LITTLE_ENDIAN
+        bx_pixconv.index8_to_32((Bit32u *)buf, snapshot, (Bit32u *)sdl_palette, x_tilesize);
+        snapshot += x_tilesize;
+        buf += disp;
+#else
+        Uint32 *buf_row = buf;
+        int j = x_tilesize;
         do {
           *buf++ = sdl_palette[*snapshot++];
         } while(--j);
         buf = buf_row + disp;
+#endif
       } while(--i);
       break;
     default:
@@ -52,6 +52,16 @@ typedef struct _rt_conf_entry_t {
   struct _rt_conf_entry_t *next;
 } rt_conf_entry_t;
 
+typedef struct _text_watch_t {
+  int id;
+  char *pattern;
+  unsigned len;
+  unsigned col; // position of the match
+  void *device;
+  text_watch_handler_t handler;
+  struct _text_watch_t *next;
+} text_watch_t;
+
 typedef struct _addon_option_t {
   const char *name;
   addon_option_parser_t parser;
@@ -66,6 +76,9 @@ class bx_real_sim_c : public bx_simulator_interface_c {
   config_interface_callback_t ci_callback;
   void *ci_callback_data;
   rt_conf_entry_t *rt_conf_entries;
+  text_watch_t *text_watches;
+  int text_watch_id;
+  bx_bool text_watch_rescan;
   addon_option_t *addon_options;
   int init_done;
   int enabled;
@@ -163,6 +176,10 @@ public:
   virtual int begin_simulation(int argc, char *argv[]);
   virtual bx_bool register_runtime_config_handler(void *dev, rt_conf_handler_t handler);
   virtual void update_runtime_options();
+  virtual int  register_text_watch(const char *pattern, void *dev, text_watch_handler_t handler);
+  virtual bx_bool unregister_text_watch(int id);
+  virtual int  text_watch_check();
+  virtual void text_row_changed(const Bit8u *text, unsigned row, unsigned cols);
   virtual void set_sim_thread_func(is_sim_thread_func_t func) {}
   virtual bx_bool is_sim_thread();
   virtual void set_debug_gui(bx_bool val) { bx_debug_gui = val; }
@@ -339,6 +356,9 @@ bx_real_sim_c::bx_real_sim_c()
   exit_code = 0;
   param_id = BXP_NEW_PARAM_ID;
   rt_conf_entries = NULL;
+  text_watches = NULL;
+  text_watch_id = 0;
+  text_watch_rescan = 0;
   addon_options = NULL;
 }
 
@@ -887,6 +907,120 @@ void bx_real_sim_c::update_runtime_options()
   bx_virt_timer.set_realtime_delay();
 }
 
+int bx_real_sim_c::register_text_watch(const char *pattern, void *dev, text_watch_handler_t handler)
+{
+  text_watch_t *text_watch;
+
+  if ((pattern == NULL) || (*pattern == 0)) {
+    return -1;
+  }
+  text_watch = (text_watch_t *)malloc(sizeof(text_watch_t));
+  if (text_watch == NULL) {
+    BX_PANIC(("can't allocate text_watch_t"));
+    return -1;
+  }
+  text_watch->id = ++text_watch_id;
+  text_watch->pattern = strdup(pattern);
+  text_watch->len = strlen(pattern);
+  text_watch->device = dev;
+  text_watch->handler = handler;
+  text_watch->next = NULL;
+
+  if (text_watches == NULL) {
+    text_watches = text_watch;
+  } else {
+    text_watch_t *temp = text_watches;
+
+    while (temp->next) {
+      temp = temp->next;
+    }
+    temp->next = text_watch;
+  }
+  // the pattern may already be on the screen
+  text_watch_rescan = 1;
+  return text_watch->id;
+}
+
+bx_bool bx_real_sim_c::unregister_text_watch(int id)
+{
+  text_watch_t *temp = text_watches, *prev = NULL;
+
+  while (temp != NULL) {
+    if (temp->id == id) {
+      if (prev == NULL) {
+        text_watches = temp->next;
+      } else {
+        prev->next = temp->next;
+      }
+      free(temp->pattern);
+      free(temp);
+      return 1;
+    }
+    prev = temp;
+    temp = temp->next;
+  }
+  return 0;
+}
+
+int bx_real_sim_c::text_watch_check()
+{
+  if (text_watches == NULL) {
+    return 0;
+  } else if (text_watch_rescan) {
+    text_watch_rescan = 0;
+    return 2;
+  }
+  return 1;
+}
+
+// text: one row of character / attribute pairs in VGA memory format
+void bx_real_sim_c::text_row_changed(const Bit8u *text, unsigned row, unsigned cols)
+{
+  text_watch_t *temp = text_watches, *prev = NULL, *found = NULL, *last = NULL;
+  unsigned col, i;
+  Bit8u c;
+
+  while (temp != NULL) {
+    for (col = 0; (col + temp->len) <= cols; col++) {
+      for (i = 0; i < temp->len; i++) {
+        c = text[(col + i) * 2];
+        if (c == 0) c = ' ';
+        if (c != (Bit8u)temp->pattern[i]) break;
+      }
+      if (i == temp->len) break;
+    }
+    if ((col + temp->len) <= cols) {
+      // move the watch to the list of matches, they are only reported once
+      text_watch_t *next = temp->next;
+      if (prev == NULL) {
+        text_watches = next;
+      } else {
+        prev->next = next;
+      }
+      temp->col = col;
+      temp->next = NULL;
+      if (last == NULL) {
+        found = temp;
+      } else {
+        last->next = temp;
+      }
+      last = temp;
+      temp = next;
+    } else {
+      prev = temp;
+      temp = temp->next;
+    }
+  }
+  // the handlers may add or remove watches
+  while (found != NULL) {
+    temp = found;
+    found = found->next;
+    temp->handler(temp->device, temp->id, row, temp->col);
+    free(temp->pattern);
+    free(temp);
+  }
+}
+
 bx_bool bx_real_sim_c::is_sim_thread()
 {
   if (is_sim_thread_func == NULL) return 1;
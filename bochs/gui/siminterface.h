@@ -613,6 +613,7 @@ enum ci_return_t {
 typedef int (*config_interface_callback_t)(void *userdata, ci_command_t command);
 typedef BxEvent* (*bxevent_handler)(void *theclass, BxEvent *event);
 typedef void (*rt_conf_handler_t)(void *this_ptr);
+typedef void (*text_watch_handler_t)(void *this_ptr, int id, unsigned row, unsigned col);
 typedef Bit32s (*addon_option_parser_t)(const char *context, int num_params, char *params[]);
 typedef Bit32s (*addon_option_save_t)(FILE *fp);
 
@@ -739,6 +740,14 @@ public:
   virtual int begin_simulation(int argc, char *argv[]) {return -1;}
   virtual bx_bool register_runtime_config_handler(void *dev, rt_conf_handler_t handler) {return 0;}
   virtual void update_runtime_options() {}
+  // text screen watch: the handler is called once when the pattern appears
+  // in a row of the VGA text screen. The display adapter calls
+  // text_watch_check() on each text update and passes the rows that have
+  // changed (or all rows if it returns 2) to text_row_changed().
+  virtual int  register_text_watch(const char *pattern, void *dev, text_watch_handler_t handler) {return -1;}
+  virtual bx_bool unregister_text_watch(int id) {return 0;}
+  virtual int  text_watch_check() {return 0;}
+  virtual void text_row_changed(const Bit8u *text, unsigned row, unsigned cols) {}
   typedef bx_bool (*is_sim_thread_func_t)();
   is_sim_thread_func_t is_sim_thread_func;
   virtual void set_sim_thread_func(is_sim_thread_func_t func) {
@@ -30,6 +30,7 @@
 #include "param_names.h"
 #include "keymap.h"
 #include "iodev.h"
+#include "pixconv.h"
 #include "enh_dbg.h"
 #if BX_WITH_X11
 
@@ -310,6 +311,7 @@ static void xkeypress(KeySym keysym, int press_release);
 #define MAX_VGA_COLORS 256
 
 unsigned long col_vals[MAX_VGA_COLORS]; // 256 VGA colors
+Bit32u col_vals32[MAX_VGA_COLORS];      // same for the 32 bpp conversion kernel
 unsigned curr_foreground, curr_background;
 
 BxEvent *x11_notify_callback (void *unused, BxEvent *event);
@@ -471,6 +473,9 @@ void bx_x_gui_c::specific_init(int argc, char **argv, unsigned headerbar_y)
   // convenience variables which hold the black & white color indeces
   black_pixel = col_vals[0];
   white_pixel = col_vals[15];
+  for (i = 0; i < MAX_VGA_COLORS; i++) {
+    col_vals32[i] = (Bit32u)col_vals[i];
+  }
 
   BX_INFO(("font %u wide x %u high, display depth = %d",
                 (unsigned) font_width, (unsigned) font_height, default_depth));
@@ -1489,6 +1494,13 @@ void bx_x_gui_c::graphics_tile_update(Bit8u *tile, unsigned x0, unsigned y0)
   }
   switch (guest_bpp) {
     case 8:  // 8 bits per pixel
+      if ((imBPP == 32) && (ximage->byte_order == LSBFirst)) {
+        for (y=0; y<y_size; y++) {
+          bx_pixconv.index8_to_32((Bit32u *)&ximage->data[imWide*y], &tile[y*x_tilesize],
+                                  col_vals32, x_tilesize);
+        }
+        break;
+      }
       for (y=0; y<y_size; y++) {
         for (x=0; x<x_tilesize; x++) {
           color = col_vals[tile[y*x_tilesize + x]];
@@ -1677,6 +1689,7 @@ bx_bool bx_x_gui_c::palette_change(Bit8u index, Bit8u red, Bit8u green, Bit8u bl
     XAllocColor(bx_x_display, DefaultColormap(bx_x_display, bx_x_screen_num),
                 &color);
     col_vals[index] = color.pixel;
+    col_vals32[index] = (Bit32u)color.pixel;
     return(1); // screen update needed
   }
 }
@@ -0,0 +1,1580 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+/////////////////////////////////////////////////////////////////////////
+
+// ICH9 style AHCI SATA controller with Native Command Queuing. Each port
+// with a disk image attached has its own I/O thread, since the image
+// backends cannot be entered concurrently. Read / write / flush / trim
+// requests are queued to it and the guest keeps running while the host
+// I/O is in progress. A timer collects the finished requests and reports
+// all NCQ commands completed meanwhile with a single Set Device Bits FIS.
+// Guest memory is only accessed from the emulation thread.
+
+// Define BX_PLUGGABLE in files that can be compiled into plugins.  For
+// platforms that require a special tag on exported symbols, BX_PLUGGABLE
+// is used to know when we are exporting symbols and when we are importing.
+#define BX_PLUGGABLE
+
+#include "iodev.h"
+#if BX_SUPPORT_PCI && BX_SUPPORT_AHCI
+
+#include "pci.h"
+#include "ahci.h"
+#include "hdimage/hdimage.h"
+
+#define LOG_THIS theAhciDevice->
+
+bx_ahci_c* theAhciDevice = NULL;
+
+// HBA registers
+#define AHCI_CAP        0x00
+#define AHCI_GHC        0x04
+#define AHCI_IS         0x08
+#define AHCI_PI         0x0c
+#define AHCI_VS         0x10
+#define AHCI_PORT_BASE  0x100
+#define AHCI_PORT_SIZE  0x80
+#define AHCI_MEM_SIZE   0x1000
+
+#define AHCI_CAP_VALUE  (0xc1240000 | ((BX_AHCI_MAX_SLOTS - 1) << 8) | (BX_AHCI_MAX_PORTS - 1))
+#define AHCI_VS_VALUE   0x00010100
+
+#define AHCI_GHC_HR     0x00000001
+#define AHCI_GHC_IE     0x00000002
+#define AHCI_GHC_AE     0x80000000
+
+// port registers
+#define PORT_CLB        0x00
+#define PORT_CLBU       0x04
+#define PORT_FB         0x08
+#define PORT_FBU        0x0c
+#define PORT_IS         0x10
+#define PORT_IE         0x14
+#define PORT_CMD        0x18
+#define PORT_TFD        0x20
+#define PORT_SIG        0x24
+#define PORT_SSTS       0x28
+#define PORT_SCTL       0x2c
+#define PORT_SERR       0x30
+#define PORT_SACT       0x34
+#define PORT_CI         0x38
+#define PORT_SNTF       0x3c
+
+#define PORT_CMD_ST     0x00000001
+#define PORT_CMD_SUD    0x00000002
+#define PORT_CMD_POD    0x00000004
+#define PORT_CMD_CLO    0x00000008
+#define PORT_CMD_FRE    0x00000010
+#define PORT_CMD_CCS    0x00001f00
+#define PORT_CMD_FR     0x00004000
+#define PORT_CMD_CR     0x00008000
+#define PORT_CMD_ICC    0xf0000000
+#define PORT_CMD_RW     0x0f00001f
+
+#define PORT_IRQ_DHRS   0x00000001
+#define PORT_IRQ_PSS    0x00000002
+#define PORT_IRQ_SDBS   0x00000008
+#define PORT_IRQ_TFES   0x40000000
+#define PORT_IRQ_MASK   0xfdc000ff
+
+#define PORT_SSTS_PRESENT 0x00000123 // device present, Gen2 speed, active
+#define PORT_SIG_ATA    0x00000101
+
+// received FIS area
+#define AHCI_RX_FIS_PIO 0x20
+#define AHCI_RX_FIS_D2H 0x40
+#define AHCI_RX_FIS_SDB 0x58
+
+#define AHCI_FIS_H2D    0x27
+#define AHCI_FIS_D2H    0x34
+#define AHCI_FIS_SDB    0xa1
+#define AHCI_FIS_PIO    0x5f
+
+// ATA status / error bits
+#define ATA_STAT_BSY    0x80
+#define ATA_STAT_DRDY   0x40
+#define ATA_STAT_DSC    0x10
+#define ATA_STAT_DRQ    0x08
+#define ATA_STAT_ERR    0x01
+#define ATA_STAT_READY  (ATA_STAT_DRDY | ATA_STAT_DSC)
+#define ATA_ERR_ABRT    0x04
+#define ATA_ERR_IDNF    0x10
+#define ATA_ERR_UNC     0x40
+
+// requests handled by the I/O thread
+#define AHCI_OP_READ    0
+#define AHCI_OP_WRITE   1
+#define AHCI_OP_FLUSH   2
+#define AHCI_OP_TRIM    3
+
+#define AHCI_NCQ_DEPTH  BX_AHCI_MAX_SLOTS
+#define AHCI_TRIM_BLOCKS 8
+#define AHCI_TIMER_USEC 100
+
+#define AHCI_ADDR(hi, lo) ((bx_phy_address)(((Bit64u)(hi) << 32) | (lo)))
+
+// 64-bit address in a command header or PRD entry
+static bx_phy_address ahci_read_addr(Bit8u *ptr)
+{
+  Bit32u lo, hi;
+
+  ReadHostDWordFromLittleEndian(ptr, lo);
+  ReadHostDWordFromLittleEndian(ptr + 4, hi);
+  return AHCI_ADDR(hi, lo);
+}
+
+// builtin configuration handling functions
+
+void ahci_init_options(void)
+{
+  char name[16], label[40];
+
+  bx_param_c *ata = SIM->get_param("ata");
+  bx_list_c *menu = new bx_list_c(ata, "ahci", "AHCI SATA controller");
+  menu->set_options(menu->SHOW_PARENT);
+  bx_param_bool_c *enabled = new bx_param_bool_c(menu,
+    "enabled",
+    "Enable AHCI emulation",
+    "Enables the AHCI SATA controller emulation",
+    0);
+  new bx_param_bool_c(menu,
+    "async",
+    "Asynchronous disk I/O",
+    "Run the disk image accesses in a separate thread per port",
+    1);
+  for (int p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    sprintf(name, "port%d", p);
+    sprintf(label, "Port %d disk image", p);
+    bx_param_filename_c *path = new bx_param_filename_c(menu,
+      name,
+      label,
+      "Pathname of the disk image connected to this port",
+      "", BX_PATHNAME_LEN);
+    path->set_extension("img");
+    sprintf(name, "mode%d", p);
+    sprintf(label, "Port %d type of disk image", p);
+    bx_param_enum_c *mode = new bx_param_enum_c(menu,
+      name,
+      label,
+      "Mode of the disk image",
+      hdimage_mode_names,
+      BX_HDIMAGE_MODE_FLAT,
+      BX_HDIMAGE_MODE_FLAT);
+    sprintf(name, "journal%d", p);
+    sprintf(label, "Port %d journal file", p);
+    bx_param_filename_c *journal = new bx_param_filename_c(menu,
+      name,
+      label,
+      "Pathname of the journal file",
+      "", BX_PATHNAME_LEN);
+    bx_list_c *deplist = new bx_list_c(NULL);
+    deplist->add(journal);
+    mode->set_dependent_list(deplist, 0);
+    mode->set_dependent_bitmap(BX_HDIMAGE_MODE_UNDOABLE, 1);
+    mode->set_dependent_bitmap(BX_HDIMAGE_MODE_VOLATILE, 1);
+    mode->set_dependent_bitmap(BX_HDIMAGE_MODE_VVFAT, 1);
+  }
+  enabled->set_dependent_list(menu->clone());
+}
+
+Bit32s ahci_options_parser(const char *context, int num_params, char *params[])
+{
+  if (!strcmp(params[0], "ahci")) {
+    bx_list_c *base = (bx_list_c*) SIM->get_param(BXPN_AHCI);
+    for (int i = 1; i < num_params; i++) {
+      if (SIM->parse_param_from_list(context, params[i], base) < 0) {
+        BX_ERROR(("%s: unknown parameter for ahci ignored.", context));
+      }
+    }
+  } else {
+    BX_PANIC(("%s: unknown directive '%s'", context, params[0]));
+  }
+  return 0;
+}
+
+Bit32s ahci_options_save(FILE *fp)
+{
+  return SIM->write_param_list(fp, (bx_list_c*) SIM->get_param(BXPN_AHCI), NULL, 1);
+}
+
+// device plugin entry points
+
+int libahci_LTX_plugin_init(plugin_t *plugin, plugintype_t type, int argc, char *argv[])
+{
+  theAhciDevice = new bx_ahci_c();
+  BX_REGISTER_DEVICE_DEVMODEL(plugin, type, theAhciDevice, BX_PLUGIN_AHCI);
+  // add new configuration parameter for the config interface
+  ahci_init_options();
+  // register add-on option for bochsrc and command line
+  SIM->register_addon_option("ahci", ahci_options_parser, ahci_options_save);
+  return 0; // Success
+}
+
+void libahci_LTX_plugin_fini(void)
+{
+  SIM->unregister_addon_option("ahci");
+  bx_list_c *menu = (bx_list_c*)SIM->get_param("ata");
+  menu->remove("ahci");
+  delete theAhciDevice;
+}
+
+// the device object
+
+bx_ahci_c::bx_ahci_c()
+{
+  put("AHCI");
+  memset(port, 0, sizeof(port));
+  ghc = AHCI_GHC_AE;
+  is = 0;
+  async = 0;
+  timer_id = BX_NULL_TIMER_HANDLE;
+  timer_active = 0;
+  statusbar_id = -1;
+}
+
+bx_ahci_c::~bx_ahci_c()
+{
+  for (unsigned p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    stop_thread(p);
+    if (port[p].hdimage != NULL) {
+      port[p].hdimage->close();
+      delete port[p].hdimage;
+    }
+    for (unsigned s = 0; s < BX_AHCI_MAX_SLOTS; s++) {
+      if (port[p].req[s].buf != NULL) {
+        delete [] port[p].req[s].buf;
+      }
+    }
+  }
+  SIM->get_bochs_root()->remove("ahci");
+  BX_DEBUG(("Exit"));
+}
+
+void bx_ahci_c::init(void)
+{
+  char pname[16];
+  const char *path;
+  int mode;
+  unsigned p, disks = 0;
+
+  bx_list_c *base = (bx_list_c*) SIM->get_param(BXPN_AHCI);
+  // Check if the device is disabled or not configured
+  if (!SIM->get_param_bool("enabled", base)->get()) {
+    BX_INFO(("AHCI disabled"));
+    // mark unused plugin for removal
+    ((bx_param_bool_c*)((bx_list_c*)SIM->get_param(BXPN_PLUGIN_CTRL))->get_by_name("ahci"))->set(0);
+    return;
+  }
+  async = SIM->get_param_bool("async", base)->get();
+
+  for (p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    port[p].ahci = this;
+    port[p].num = p;
+    sprintf(pname, "port%d", p);
+    path = SIM->get_param_string(pname, base)->getptr();
+    if ((strlen(path) == 0) || !strcmp(path, "none")) {
+      continue;
+    }
+    sprintf(pname, "mode%d", p);
+    mode = SIM->get_param_enum(pname, base)->get();
+    sprintf(pname, "journal%d", p);
+    port[p].hdimage = DEV_hdimage_init_image(mode, 0, SIM->get_param_string(pname, base)->getptr());
+    if (port[p].hdimage == NULL) {
+      continue;
+    }
+    if (port[p].hdimage->open(path) < 0) {
+      BX_PANIC(("port %d: could not open disk image file '%s'", p, path));
+      delete port[p].hdimage;
+      port[p].hdimage = NULL;
+      continue;
+    }
+    port[p].sectors = port[p].hdimage->hd_size / 512;
+    port[p].read_only = (port[p].hdimage->get_capabilities() & HDIMAGE_READONLY) != 0;
+    // the other backends expect sector sized transfers
+    port[p].multi_sector = (mode == BX_HDIMAGE_MODE_FLAT);
+    // only the flat image I/O is free of logging calls and safe to run
+    // on the I/O thread
+    if (async && (mode == BX_HDIMAGE_MODE_FLAT)) {
+      start_thread(p);
+    } else if (async) {
+      BX_INFO(("port %d: synchronous I/O for '%s' mode images", p,
+               hdimage_mode_names[mode]));
+    }
+    BX_INFO(("port %d: '%s', '%s' mode, " FMT_LL "u sectors", p, path,
+             hdimage_mode_names[mode], port[p].sectors));
+    disks++;
+  }
+
+  devfunc = 0x00;
+  DEV_register_pci_handlers(this, &devfunc, BX_PLUGIN_AHCI, "ICH9 AHCI SATA controller");
+
+  for (unsigned i = 0; i < 256; i++) {
+    pci_conf[i] = 0x0;
+  }
+  pci_base_address[5] = 0;
+  pci_conf[0x00] = 0x86;
+  pci_conf[0x01] = 0x80;
+  pci_conf[0x02] = 0x22;
+  pci_conf[0x03] = 0x29;
+  pci_conf[0x08] = 0x02;
+  pci_conf[0x09] = 0x01; // AHCI 1.0 interface
+  pci_conf[0x0a] = 0x06; // SATA
+  pci_conf[0x0b] = 0x01; // mass storage
+  pci_conf[0x3d] = BX_PCI_INTA;
+  pci_conf[0x90] = 0x40; // MAP: AHCI mode
+  pci_conf[0x92] = (1 << BX_AHCI_MAX_PORTS) - 1; // PCS: ports enabled
+  for (p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    if (port[p].hdimage != NULL) {
+      pci_conf[0x93] |= (1 << p); // PCS: device present
+    }
+  }
+
+  if (timer_id == BX_NULL_TIMER_HANDLE) {
+    timer_id = bx_pc_system.register_timer(this, timer_handler, AHCI_TIMER_USEC,
+                                           1, 0, "ahci"); // continuous, inactive
+  }
+  statusbar_id = bx_gui->register_statusitem("AHCI", 1);
+
+  BX_INFO(("AHCI initialized: %d port%s, %d disk%s, %s I/O", BX_AHCI_MAX_PORTS,
+           (BX_AHCI_MAX_PORTS > 1) ? "s" : "", disks, (disks != 1) ? "s" : "",
+           async ? "asynchronous" : "synchronous"));
+}
+
+void bx_ahci_c::reset(unsigned type)
+{
+  pci_conf[0x04] = 0x00;
+  pci_conf[0x05] = 0x00;
+  hba_reset();
+}
+
+void bx_ahci_c::register_state(void)
+{
+  char pname[8];
+
+  bx_list_c *list = new bx_list_c(SIM->get_bochs_root(), "ahci", "AHCI State");
+  // the I/O threads must not touch the images while they are saved
+  bx_param_bool_c *idle = new bx_param_bool_c(list, "io_idle", NULL, NULL, 0);
+  idle->set_sr_handlers(this, param_save_handler, (param_restore_handler)NULL);
+  BXRS_HEX_PARAM_FIELD(list, ghc, ghc);
+  BXRS_HEX_PARAM_FIELD(list, is, is);
+  for (unsigned p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    sprintf(pname, "port%d", p);
+    bx_list_c *pl = new bx_list_c(list, pname, "");
+    BXRS_HEX_PARAM_FIELD(pl, clb, port[p].clb);
+    BXRS_HEX_PARAM_FIELD(pl, clbu, port[p].clbu);
+    BXRS_HEX_PARAM_FIELD(pl, fb, port[p].fb);
+    BXRS_HEX_PARAM_FIELD(pl, fbu, port[p].fbu);
+    BXRS_HEX_PARAM_FIELD(pl, is, port[p].is);
+    BXRS_HEX_PARAM_FIELD(pl, ie, port[p].ie);
+    BXRS_HEX_PARAM_FIELD(pl, cmd, port[p].cmd);
+    BXRS_HEX_PARAM_FIELD(pl, tfd, port[p].tfd);
+    BXRS_HEX_PARAM_FIELD(pl, sig, port[p].sig);
+    BXRS_HEX_PARAM_FIELD(pl, ssts, port[p].ssts);
+    BXRS_HEX_PARAM_FIELD(pl, sctl, port[p].sctl);
+    BXRS_HEX_PARAM_FIELD(pl, serr, port[p].serr);
+    BXRS_HEX_PARAM_FIELD(pl, sact, port[p].sact);
+    BXRS_HEX_PARAM_FIELD(pl, ci, port[p].ci);
+    BXRS_HEX_PARAM_FIELD(pl, sntf, port[p].sntf);
+    BXRS_HEX_PARAM_FIELD(pl, issued, port[p].issued);
+    BXRS_PARAM_BOOL(pl, stopped, port[p].stopped);
+    BXRS_PARAM_BOOL(pl, srst, port[p].srst);
+    BXRS_DEC_PARAM_FIELD(pl, multiple, port[p].multiple);
+    BXRS_DEC_PARAM_FIELD(pl, udma_mode, port[p].udma_mode);
+    BXRS_PARAM_BOOL(pl, write_cache, port[p].write_cache);
+    bx_list_c *log = new bx_list_c(pl, "err_log", "");
+    BXRS_PARAM_BOOL(log, valid, port[p].err_log.valid);
+    BXRS_PARAM_BOOL(log, nq, port[p].err_log.nq);
+    BXRS_DEC_PARAM_FIELD(log, tag, port[p].err_log.tag);
+    BXRS_HEX_PARAM_FIELD(log, status, port[p].err_log.status);
+    BXRS_HEX_PARAM_FIELD(log, error, port[p].err_log.error);
+    if (port[p].hdimage != NULL) {
+      port[p].hdimage->register_state(pl);
+    }
+  }
+  register_pci_state(list);
+}
+
+void bx_ahci_c::after_restore_state(void)
+{
+  Bit32u slots;
+
+  if (DEV_pci_set_base_mem(this, mem_read_handler, mem_write_handler,
+                           &pci_base_address[5], &pci_conf[0x24], AHCI_MEM_SIZE)) {
+    BX_INFO(("new ABAR address: 0x%08x", pci_base_address[5]));
+  }
+  // the results of requests in flight are not part of the saved state:
+  // execute them again
+  for (unsigned p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    drop_requests(p);
+    slots = port[p].issued;
+    port[p].issued = 0;
+    for (unsigned s = 0; s < BX_AHCI_MAX_SLOTS; s++) {
+      if (slots & (1U << s)) {
+        execute_slot(p, s);
+      }
+    }
+    if (!port[p].thread_started) {
+      process_completions(p);
+    }
+  }
+  update_irq();
+}
+
+Bit64s bx_ahci_c::param_save_handler(void *devptr, bx_param_c *param)
+{
+  bx_ahci_c *class_ptr = (bx_ahci_c *) devptr;
+
+  for (unsigned p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    class_ptr->wait_idle(p);
+  }
+  return 1;
+}
+
+void bx_ahci_c::hba_reset(void)
+{
+  ghc = AHCI_GHC_AE;
+  is = 0;
+  for (unsigned p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    port_reset(p);
+  }
+  update_irq();
+}
+
+void bx_ahci_c::port_reset(unsigned p)
+{
+  drop_requests(p);
+  port[p].is = 0;
+  port[p].ie = 0;
+  port[p].cmd = PORT_CMD_SUD | PORT_CMD_POD;
+  port[p].sctl = 0;
+  port[p].serr = 0;
+  port[p].sact = 0;
+  port[p].ci = 0;
+  port[p].sntf = 0;
+  port[p].issued = 0;
+  port[p].stopped = 0;
+  device_reset(p);
+}
+
+// device reset (COMRESET or power on): the device reports its signature
+void bx_ahci_c::device_reset(unsigned p)
+{
+  port[p].srst = 0;
+  port[p].multiple = 16;
+  port[p].udma_mode = 5;
+  port[p].write_cache = 1;
+  port[p].err_log.valid = 0;
+  if (port[p].hdimage != NULL) {
+    port[p].ssts = PORT_SSTS_PRESENT;
+    port[p].sig = PORT_SIG_ATA;
+    port[p].tfd = ATA_STAT_READY;
+  } else {
+    port[p].ssts = 0;
+    port[p].sig = 0xffffffff;
+    port[p].tfd = 0x7f;
+  }
+}
+
+void bx_ahci_c::update_irq(void)
+{
+  bx_bool level;
+
+  for (unsigned p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    if (port[p].is & port[p].ie) {
+      is |= (1 << p);
+    }
+  }
+  level = (ghc & AHCI_GHC_IE) && (is != 0) && !(pci_conf[0x05] & 0x04);
+  DEV_pci_set_irq(devfunc, pci_conf[0x3d], level);
+}
+
+// HBA memory register access
+
+bx_bool bx_ahci_c::mem_read_handler(bx_phy_address addr, unsigned len,
+                                    void *data, void *param)
+{
+  bx_ahci_c *class_ptr = (bx_ahci_c *) param;
+
+  return class_ptr->mem_read(addr, len, data);
+}
+
+bx_bool bx_ahci_c::mem_read(bx_phy_address addr, unsigned len, void *data)
+{
+  Bit8u *data8_ptr = (Bit8u *) data;
+  Bit32u offset, value;
+  unsigned i, shift;
+
+  if (len > 4) {
+    // 64-bit access: split into two 32-bit accesses
+    mem_read(addr, 4, data8_ptr);
+    mem_read(addr + 4, len - 4, data8_ptr + 4);
+    return 1;
+  }
+  offset = (Bit32u)(addr - pci_base_address[5]) & (AHCI_MEM_SIZE - 1);
+  shift = (offset & 3) * 8;
+  value = read_reg(offset & ~3) >> shift;
+  for (i = 0; i < len; i++) {
+    data8_ptr[i] = (Bit8u)(value >> (i * 8));
+  }
+  BX_DEBUG(("mem read from offset 0x%03x len %d value 0x%08x", offset, len, value));
+  return 1;
+}
+
+bx_bool bx_ahci_c::mem_write_handler(bx_phy_address addr, unsigned len,
+                                     void *data, void *param)
+{
+  bx_ahci_c *class_ptr = (bx_ahci_c *) param;
+
+  return class_ptr->mem_write(addr, len, data);
+}
+
+bx_bool bx_ahci_c::mem_write(bx_phy_address addr, unsigned len, void *data)
+{
+  Bit8u *data8_ptr = (Bit8u *) data;
+  Bit32u offset, value = 0, mask = 0;
+  unsigned i, shift;
+
+  if (len > 4) {
+    mem_write(addr, 4, data8_ptr);
+    mem_write(addr + 4, len - 4, data8_ptr + 4);
+    return 1;
+  }
+  offset = (Bit32u)(addr - pci_base_address[5]) & (AHCI_MEM_SIZE - 1);
+  shift = (offset & 3) * 8;
+  for (i = 0; i < len; i++) {
+    value |= (data8_ptr[i] << (i * 8));
+    mask |= (0xff << (i * 8));
+  }
+  BX_DEBUG(("mem write to offset 0x%03x len %d value 0x%08x", offset, len, value));
+  write_reg(offset & ~3, value << shift, mask << shift);
+  return 1;
+}
+
+Bit32u bx_ahci_c::read_reg(Bit32u offset)
+{
+  unsigned p;
+
+  if (offset >= AHCI_PORT_BASE) {
+    p = (offset - AHCI_PORT_BASE) / AHCI_PORT_SIZE;
+    if (p < BX_AHCI_MAX_PORTS) {
+      return port_read(p, (offset - AHCI_PORT_BASE) % AHCI_PORT_SIZE);
+    }
+    return 0;
+  }
+  switch (offset) {
+    case AHCI_CAP:
+      return AHCI_CAP_VALUE;
+    case AHCI_GHC:
+      return ghc;
+    case AHCI_IS:
+      return is;
+    case AHCI_PI:
+      return (1 << BX_AHCI_MAX_PORTS) - 1;
+    case AHCI_VS:
+      return AHCI_VS_VALUE;
+    default:
+      return 0;
+  }
+}
+
+void bx_ahci_c::write_reg(Bit32u offset, Bit32u value, Bit32u mask)
+{
+  unsigned p;
+
+  if (offset >= AHCI_PORT_BASE) {
+    p = (offset - AHCI_PORT_BASE) / AHCI_PORT_SIZE;
+    if (p < BX_AHCI_MAX_PORTS) {
+      port_write(p, (offset - AHCI_PORT_BASE) % AHCI_PORT_SIZE, value, mask);
+    }
+    return;
+  }
+  switch (offset) {
+    case AHCI_GHC:
+      value = (ghc & ~mask) | (value & mask);
+      if (value & AHCI_GHC_HR) {
+        BX_DEBUG(("HBA reset"));
+        hba_reset();
+        return;
+      }
+      ghc = AHCI_GHC_AE | (value & AHCI_GHC_IE);
+      update_irq();
+      break;
+    case AHCI_IS:
+      is &= ~(value & mask);
+      update_irq();
+      break;
+    default:
+      BX_DEBUG(("write to read-only register 0x%02x ignored", offset));
+  }
+}
+
+Bit32u bx_ahci_c::port_read(unsigned p, Bit32u reg)
+{
+  bx_ahci_port_t *pp = &port[p];
+
+  switch (reg) {
+    case PORT_CLB:  return pp->clb;
+    case PORT_CLBU: return pp->clbu;
+    case PORT_FB:   return pp->fb;
+    case PORT_FBU:  return pp->fbu;
+    case PORT_IS:   return pp->is;
+    case PORT_IE:   return pp->ie;
+    case PORT_CMD:
+      return pp->cmd | ((pp->cmd & PORT_CMD_ST) ? PORT_CMD_CR : 0) |
+             ((pp->cmd & PORT_CMD_FRE) ? PORT_CMD_FR : 0);
+    case PORT_TFD:  return pp->tfd;
+    case PORT_SIG:  return pp->sig;
+    case PORT_SSTS: return pp->ssts;
+    case PORT_SCTL: return pp->sctl;
+    case PORT_SERR: return pp->serr;
+    case PORT_SACT: return pp->sact;
+    case PORT_CI:   return pp->ci;
+    case PORT_SNTF: return pp->sntf;
+    default:
+      return 0;
+  }
+}
+
+void bx_ahci_c::port_write(unsigned p, Bit32u reg, Bit32u value, Bit32u mask)
+{
+  bx_ahci_port_t *pp = &port[p];
+  Bit32u old;
+
+  switch (reg) {
+    case PORT_CLB:
+      pp->clb = ((pp->clb & ~mask) | (value & mask)) & ~0x3ff;
+      break;
+    case PORT_CLBU:
+      pp->clbu = (pp->clbu & ~mask) | (value & mask);
+      break;
+    case PORT_FB:
+      pp->fb = ((pp->fb & ~mask) | (value & mask)) & ~0xff;
+      break;
+    case PORT_FBU:
+      pp->fbu = (pp->fbu & ~mask) | (value & mask);
+      break;
+    case PORT_IS:
+      pp->is &= ~(value & mask);
+      update_irq();
+      break;
+    case PORT_IE:
+      pp->ie = ((pp->ie & ~mask) | (value & mask)) & PORT_IRQ_MASK;
+      update_irq();
+      break;
+    case PORT_CMD:
+      old = pp->cmd;
+      value = (old & ~mask) | (value & mask);
+      pp->cmd = (old & ~PORT_CMD_RW) | (value & PORT_CMD_RW);
+      if (pp->cmd & PORT_CMD_CLO) {
+        pp->tfd &= ~(ATA_STAT_BSY | ATA_STAT_DRQ);
+        pp->cmd &= ~PORT_CMD_CLO;
+      }
+      if ((old & PORT_CMD_ST) && !(pp->cmd & PORT_CMD_ST)) {
+        // stop command list processing: outstanding commands are aborted
+        drop_requests(p);
+        pp->ci = 0;
+        pp->sact = 0;
+        pp->issued = 0;
+        pp->stopped = 0;
+        pp->cmd &= ~PORT_CMD_CCS;
+      }
+      break;
+    case PORT_SCTL:
+      old = pp->sctl;
+      pp->sctl = ((old & ~mask) | (value & mask)) & 0xfff;
+      if ((pp->sctl & 0x0f) == 1) {
+        // COMRESET asserted
+        drop_requests(p);
+        pp->ssts = 0;
+        pp->tfd = 0x7f | ATA_STAT_BSY;
+      } else if ((old & 0x0f) == 1) {
+        // COMRESET released: the device sends its signature
+        pp->ci = 0;
+        pp->sact = 0;
+        pp->issued = 0;
+        pp->stopped = 0;
+        device_reset(p);
+        if (pp->hdimage != NULL) {
+          d2h_fis(p, ATA_STAT_READY, 0x01, 1, 1);
+          update_irq();
+        }
+      }
+      break;
+    case PORT_SERR:
+      pp->serr &= ~(value & mask);
+      break;
+    case PORT_SACT:
+      if (pp->cmd & PORT_CMD_ST) {
+        pp->sact |= (value & mask);
+      }
+      break;
+    case PORT_CI:
+      if (pp->cmd & PORT_CMD_ST) {
+        pp->ci |= (value & mask);
+        issue_commands(p);
+      }
+      break;
+    case PORT_SNTF:
+      pp->sntf &= ~(value & mask);
+      break;
+    default:
+      BX_DEBUG(("port %d: write to read-only register 0x%02x ignored", p, reg));
+  }
+}
+
+// FIS handling
+
+void bx_ahci_c::write_fis(unsigned p, unsigned offset, Bit8u *fis, unsigned len)
+{
+  bx_phy_address addr;
+
+  if (port[p].cmd & PORT_CMD_FRE) {
+    addr = AHCI_ADDR(port[p].fbu, port[p].fb);
+    DEV_MEM_WRITE_PHYSICAL_DMA(addr + offset, len, fis);
+  }
+}
+
+void bx_ahci_c::d2h_fis(unsigned p, Bit8u status, Bit8u error, bx_bool irq, bx_bool sig)
+{
+  Bit8u fis[20];
+
+  memset(fis, 0, sizeof(fis));
+  fis[0] = AHCI_FIS_D2H;
+  fis[1] = irq ? 0x40 : 0x00;
+  fis[2] = status;
+  fis[3] = error;
+  if (sig) {
+    fis[4] = PORT_SIG_ATA >> 8;
+    fis[12] = PORT_SIG_ATA & 0xff;
+  }
+  write_fis(p, AHCI_RX_FIS_D2H, fis, sizeof(fis));
+  port[p].tfd = (error << 8) | status;
+  if (irq) {
+    port[p].is |= PORT_IRQ_DHRS;
+  }
+}
+
+void bx_ahci_c::pio_setup_fis(unsigned p, Bit8u status, bx_bool to_host, Bit16u len)
+{
+  Bit8u fis[20];
+
+  memset(fis, 0, sizeof(fis));
+  fis[0] = AHCI_FIS_PIO;
+  fis[1] = 0x40 | (to_host ? 0x20 : 0x00);
+  fis[2] = status | ATA_STAT_DRQ;
+  fis[15] = status; // E_Status
+  fis[16] = len & 0xff;
+  fis[17] = len >> 8;
+  write_fis(p, AHCI_RX_FIS_PIO, fis, sizeof(fis));
+  port[p].is |= PORT_IRQ_PSS;
+}
+
+void bx_ahci_c::sdb_fis(unsigned p, Bit8u status, Bit8u error, Bit32u tags)
+{
+  Bit8u fis[8];
+
+  fis[0] = AHCI_FIS_SDB;
+  fis[1] = 0x40;
+  fis[2] = status & 0x77;
+  fis[3] = error;
+  WriteHostDWordToLittleEndian(&fis[4], tags);
+  write_fis(p, AHCI_RX_FIS_SDB, fis, sizeof(fis));
+  port[p].tfd = (error << 8) | (port[p].tfd & 0x88) | (status & 0x77);
+  port[p].sact &= ~tags;
+  port[p].is |= PORT_IRQ_SDBS;
+}
+
+// command processing
+
+void bx_ahci_c::issue_commands(unsigned p)
+{
+  Bit32u slots;
+
+  if (port[p].stopped || (port[p].hdimage == NULL)) {
+    return;
+  }
+  slots = port[p].ci & ~port[p].issued;
+  for (unsigned s = 0; (s < BX_AHCI_MAX_SLOTS) && (slots != 0); s++) {
+    if (slots & (1U << s)) {
+      slots &= ~(1U << s);
+      execute_slot(p, s);
+      if (port[p].stopped) break;
+    }
+  }
+  if (!port[p].thread_started) {
+    process_completions(p);
+  }
+  update_irq();
+}
+
+void bx_ahci_c::execute_slot(unsigned p, unsigned slot)
+{
+  bx_ahci_port_t *pp = &port[p];
+  Bit8u hdr[16], fis[20];
+  bx_phy_address addr;
+
+  pp->issued |= (1U << slot);
+  pp->cmd = (pp->cmd & ~PORT_CMD_CCS) | (slot << 8);
+  addr = AHCI_ADDR(pp->clbu, pp->clb);
+  DEV_MEM_READ_PHYSICAL_DMA(addr + slot * 32, 16, hdr);
+  addr = ahci_read_addr(&hdr[8]) & ~0x7f;
+  DEV_MEM_READ_PHYSICAL_DMA(addr, 20, fis);
+  set_prdbc(p, slot, 0);
+  pp->req[slot].ncq = 0;
+
+  if (fis[0] != AHCI_FIS_H2D) {
+    BX_ERROR(("port %d: unsupported FIS type 0x%02x in slot %d", p, fis[0], slot));
+    command_error(p, slot, ATA_STAT_READY | ATA_STAT_ERR, ATA_ERR_ABRT);
+    return;
+  }
+  if (!(fis[1] & 0x80)) {
+    // device control register update
+    if (fis[15] & 0x04) {
+      pp->srst = 1;
+      pp->tfd = ATA_STAT_BSY;
+    } else if (pp->srst) {
+      pp->srst = 0;
+      device_reset(p);
+      d2h_fis(p, ATA_STAT_READY, 0x01, 1, 1);
+    }
+    pp->ci &= ~(1U << slot);
+    pp->issued &= ~(1U << slot);
+    return;
+  }
+  BX_DEBUG(("port %d: slot %d command 0x%02x", p, slot, fis[2]));
+  if (!prepare_rw(p, slot, fis)) {
+    execute_sync(p, slot, fis);
+  }
+}
+
+// set up read / write / flush / trim requests for the I/O thread
+bx_bool bx_ahci_c::prepare_rw(unsigned p, unsigned slot, Bit8u *fis)
+{
+  bx_ahci_port_t *pp = &port[p];
+  bx_ahci_req_t *req = &pp->req[slot];
+  bx_bool lba48 = 0;
+
+  req->cmd = fis[2];
+  req->ncq = 0;
+  req->pio = 0;
+  req->tag = slot;
+  req->lba = 0;
+  req->count = 0;
+  switch (req->cmd) {
+    case 0x60: // READ FPDMA QUEUED
+    case 0x61: // WRITE FPDMA QUEUED
+      req->ncq = 1;
+      req->op = (req->cmd == 0x61) ? AHCI_OP_WRITE : AHCI_OP_READ;
+      req->tag = fis[12] >> 3;
+      req->count = fis[3] | (fis[11] << 8);
+      if (req->count == 0) req->count = 65536;
+      lba48 = 1;
+      break;
+    case 0x20: // READ SECTORS
+    case 0xc4: // READ MULTIPLE
+    case 0x30: // WRITE SECTORS
+    case 0xc5: // WRITE MULTIPLE
+      req->pio = 1;
+    case 0xc8: // READ DMA
+    case 0xca: // WRITE DMA
+      req->op = ((req->cmd == 0x30) || (req->cmd == 0xc5) || (req->cmd == 0xca)) ?
+                AHCI_OP_WRITE : AHCI_OP_READ;
+      req->count = fis[12];
+      if (req->count == 0) req->count = 256;
+      break;
+    case 0x24: // READ SECTORS EXT
+    case 0x29: // READ MULTIPLE EXT
+    case 0x34: // WRITE SECTORS EXT
+    case 0x39: // WRITE MULTIPLE EXT
+    case 0xce: // WRITE MULTIPLE FUA EXT
+      req->pio = 1;
+    case 0x25: // READ DMA EXT
+    case 0x35: // WRITE DMA EXT
+    case 0x3d: // WRITE DMA FUA EXT
+      req->op = ((req->cmd == 0x24) || (req->cmd == 0x25) || (req->cmd == 0x29)) ?
+                AHCI_OP_READ : AHCI_OP_WRITE;
+      req->count = fis[12] | (fis[13] << 8);
+      if (req->count == 0) req->count = 65536;
+      lba48 = 1;
+      break;
+    case 0xe7: // FLUSH CACHE
+    case 0xea: // FLUSH CACHE EXT
+      req->op = AHCI_OP_FLUSH;
+      break;
+    case 0x06: // DATA SET MANAGEMENT
+      if (!(fis[3] & 0x01) || pp->read_only) {
+        return 0;
+      }
+      req->op = AHCI_OP_TRIM;
+      req->count = fis[12] | (fis[13] << 8);
+      if ((req->count == 0) || (req->count > AHCI_TRIM_BLOCKS)) {
+        return 0;
+      }
+      break;
+    default:
+      return 0;
+  }
+
+  if ((req->op == AHCI_OP_READ) || (req->op == AHCI_OP_WRITE)) {
+    if (!(fis[7] & 0x40)) {
+      BX_ERROR(("port %d: CHS addressing not supported", p));
+      return 0;
+    }
+    req->lba = fis[4] | (fis[5] << 8) | (fis[6] << 16);
+    if (lba48) {
+      req->lba |= ((Bit64u)fis[8] << 24) | ((Bit64u)fis[9] << 32) | ((Bit64u)fis[10] << 40);
+    } else {
+      req->lba |= (fis[7] & 0x0f) << 24;
+    }
+    if ((req->lba > pp->sectors) || (req->count > (pp->sectors - req->lba))) {
+      BX_ERROR(("port %d: request beyond end of disk (sector " FMT_LL "u, count %d)",
+                p, req->lba, req->count));
+      command_error(p, slot, ATA_STAT_READY | ATA_STAT_ERR, ATA_ERR_IDNF | ATA_ERR_ABRT);
+      return 1;
+    }
+    if ((req->op == AHCI_OP_WRITE) && pp->read_only) {
+      BX_ERROR(("port %d: write to read-only disk image", p));
+      command_error(p, slot, ATA_STAT_READY | ATA_STAT_ERR, ATA_ERR_ABRT);
+      return 1;
+    }
+  }
+  req->len = req->count * 512;
+  if (!alloc_buffer(req, req->len)) {
+    command_error(p, slot, ATA_STAT_READY | ATA_STAT_ERR, ATA_ERR_ABRT);
+    return 1;
+  }
+  if ((req->op == AHCI_OP_WRITE) || (req->op == AHCI_OP_TRIM)) {
+    if (dma_transfer(p, slot, 0, req->buf, req->len) < req->len) {
+      BX_ERROR(("port %d: PRD table too short for %d bytes", p, req->len));
+      command_error(p, slot, ATA_STAT_READY | ATA_STAT_ERR, ATA_ERR_ABRT);
+      return 1;
+    }
+  }
+  if (req->ncq) {
+    // the device accepts the command and releases the task file
+    d2h_fis(p, ATA_STAT_READY, 0, 0, 0);
+    pp->ci &= ~(1U << slot);
+  }
+  submit(p, slot);
+  return 1;
+}
+
+// commands without disk image access are completed immediately
+void bx_ahci_c::execute_sync(unsigned p, unsigned slot, Bit8u *fis)
+{
+  bx_ahci_port_t *pp = &port[p];
+  Bit8u buf[512], sum = 0;
+  Bit16u count = fis[12] | (fis[13] << 8);
+
+  switch (fis[2]) {
+    case 0xec: // IDENTIFY DEVICE
+      identify(p, buf);
+      set_prdbc(p, slot, dma_transfer(p, slot, 1, buf, 512));
+      command_done(p, slot, 1, 512);
+      return;
+    case 0x2f: // READ LOG EXT
+      if ((fis[4] != 0x10) || (count == 0)) {
+        break;
+      }
+      memset(buf, 0, sizeof(buf));
+      if (pp->err_log.valid) {
+        buf[0] = pp->err_log.tag | (pp->err_log.nq ? 0x80 : 0x00);
+        buf[2] = pp->err_log.status;
+        buf[3] = pp->err_log.error;
+        pp->err_log.valid = 0;
+      }
+      for (int i = 0; i < 511; i++) sum += buf[i];
+      buf[511] = -sum;
+      set_prdbc(p, slot, dma_transfer(p, slot, 1, buf, 512));
+      command_done(p, slot, 1, 512);
+      return;
+    case 0xef: // SET FEATURES
+      switch (fis[3]) {
+        case 0x03:
+          if ((fis[12] & 0xf8) == 0x40) {
+            pp->udma_mode = fis[12] & 0x07;
+          }
+          break;
+        case 0x02:
+        case 0x82:
+          pp->write_cache = (fis[3] == 0x02);
+          break;
+        case 0x10:
+        case 0x90:
+        case 0x55:
+        case 0xaa:
+        case 0x66:
+        case 0xcc:
+          break;
+        default:
+          BX_DEBUG(("port %d: SET FEATURES subcommand 0x%02x not supported", p, fis[3]));
+          command_error(p, slot, ATA_STAT_READY | ATA_STAT_ERR, ATA_ERR_ABRT);
+          return;
+      }
+      command_done(p, slot, 0, 0);
+      return;
+    case 0xc6: // SET MULTIPLE MODE
+      if ((fis[12] > 16) || (fis[12] & (fis[12] - 1))) {
+        break;
+      }
+      pp->multiple = fis[12];
+      command_done(p, slot, 0, 0);
+      return;
+    case 0x90: // EXECUTE DEVICE DIAGNOSTIC
+      d2h_fis(p, ATA_STAT_READY, 0x01, 1, 1);
+      pp->ci &= ~(1U << slot);
+      pp->issued &= ~(1U << slot);
+      return;
+    case 0x91: // INITIALIZE DEVICE PARAMETERS
+    case 0x40: // READ VERIFY SECTORS
+    case 0x42: // READ VERIFY SECTORS EXT
+    case 0xe0: // STANDBY IMMEDIATE
+    case 0xe1: // IDLE IMMEDIATE
+    case 0xe2: // STANDBY
+    case 0xe3: // IDLE
+    case 0xe5: // CHECK POWER MODE
+    case 0xe6: // SLEEP
+      command_done(p, slot, 0, 0);
+      return;
+    default:
+      break;
+  }
+  BX_DEBUG(("port %d: command 0x%02x aborted", p, fis[2]));
+  command_error(p, slot, ATA_STAT_READY | ATA_STAT_ERR, ATA_ERR_ABRT);
+}
+
+void bx_ahci_c::command_done(unsigned p, unsigned slot, bx_bool pio, Bit16u pio_len)
+{
+  if (pio) {
+    pio_setup_fis(p, ATA_STAT_READY, 1, pio_len);
+  }
+  d2h_fis(p, ATA_STAT_READY, 0, 1, 0);
+  port[p].ci &= ~(1U << slot);
+  port[p].issued &= ~(1U << slot);
+}
+
+// the device reports an error: command list processing stops until
+// the driver restarts the port
+void bx_ahci_c::command_error(unsigned p, unsigned slot, Bit8u status, Bit8u error)
+{
+  bx_ahci_port_t *pp = &port[p];
+
+  if (pp->req[slot].ncq) {
+    pp->err_log.valid = 1;
+    pp->err_log.nq = 0;
+    pp->err_log.tag = pp->req[slot].tag;
+    pp->err_log.status = status;
+    pp->err_log.error = error;
+    pp->ci &= ~(1U << slot);
+    sdb_fis(p, status, error, 0);
+  } else {
+    d2h_fis(p, status, error, 1, 0);
+  }
+  pp->issued &= ~(1U << slot);
+  pp->cmd = (pp->cmd & ~PORT_CMD_CCS) | (slot << 8);
+  pp->is |= PORT_IRQ_TFES;
+  pp->stopped = 1;
+}
+
+bx_bool bx_ahci_c::alloc_buffer(bx_ahci_req_t *req, Bit32u len)
+{
+  if (req->buf_size < len) {
+    if (req->buf != NULL) {
+      delete [] req->buf;
+    }
+    req->buf = new Bit8u[len];
+    req->buf_size = len;
+  }
+  return 1;
+}
+
+// copy data between the buffer and the memory described by the PRD table
+Bit32u bx_ahci_c::dma_transfer(unsigned p, unsigned slot, bx_bool to_guest, Bit8u *buf, Bit32u len)
+{
+  bx_ahci_port_t *pp = &port[p];
+  Bit8u hdr[16], prd[16 * 16];
+  bx_phy_address addr, table;
+  Bit32u done = 0, chunk;
+  unsigned i, n, prdtl;
+
+  addr = AHCI_ADDR(pp->clbu, pp->clb);
+  DEV_MEM_READ_PHYSICAL_DMA(addr + slot * 32, 16, hdr);
+  prdtl = hdr[2] | (hdr[3] << 8);
+  table = (ahci_read_addr(&hdr[8]) & ~0x7f) + 0x80;
+  for (i = 0; (i < prdtl) && (done < len); i += n) {
+    n = prdtl - i;
+    if (n > 16) n = 16;
+    DEV_MEM_READ_PHYSICAL_DMA(table + i * 16, n * 16, prd);
+    for (unsigned j = 0; (j < n) && (done < len); j++) {
+      addr = ahci_read_addr(&prd[j * 16]) & ~1;
+      ReadHostDWordFromLittleEndian(&prd[j * 16 + 12], chunk);
+      chunk = (chunk & 0x3fffff) + 1;
+      if (chunk > (len - done)) chunk = len - done;
+      if (to_guest) {
+        DEV_MEM_WRITE_PHYSICAL_DMA(addr, chunk, buf + done);
+      } else {
+        DEV_MEM_READ_PHYSICAL_DMA(addr, chunk, buf + done);
+      }
+      done += chunk;
+    }
+  }
+  return done;
+}
+
+void bx_ahci_c::set_prdbc(unsigned p, unsigned slot, Bit32u count)
+{
+  Bit8u buf[4];
+  bx_phy_address addr = AHCI_ADDR(port[p].clbu, port[p].clb);
+
+  WriteHostDWordToLittleEndian(buf, count);
+  DEV_MEM_WRITE_PHYSICAL_DMA(addr + slot * 32 + 4, 4, buf);
+}
+
+void bx_ahci_c::identify(unsigned p, Bit8u *buf)
+{
+  bx_ahci_port_t *pp = &port[p];
+  Bit16u id[256];
+  Bit8u sum = 0;
+  Bit32u cyl;
+  char serial[21], model[41];
+  unsigned i;
+
+  memset(id, 0, sizeof(id));
+  cyl = (Bit32u)(pp->sectors / (16 * 63));
+  if (cyl > 16383) cyl = 16383;
+  sprintf(serial, "BXAHCI%014d", p);
+  sprintf(model, "%-40s", "BOCHS AHCI HARDDISK");
+  id[0] = 0x0040;
+  id[1] = cyl;
+  id[3] = 16;
+  id[6] = 63;
+  for (i = 0; i < 10; i++) {
+    id[10 + i] = (serial[i * 2] << 8) | serial[i * 2 + 1];
+  }
+  id[23] = ('1' << 8) | '.';
+  id[24] = ('0' << 8) | ' ';
+  id[25] = (' ' << 8) | ' ';
+  id[26] = (' ' << 8) | ' ';
+  for (i = 0; i < 20; i++) {
+    id[27 + i] = (model[i * 2] << 8) | model[i * 2 + 1];
+  }
+  id[47] = 0x8000 | 16;
+  id[49] = 0x0f00; // LBA, DMA, IORDY
+  id[50] = 0x4000;
+  id[53] = 0x0006;
+  id[54] = cyl;
+  id[55] = 16;
+  id[56] = 63;
+  id[57] = (Bit16u)(cyl * 16 * 63);
+  id[58] = (Bit16u)((cyl * 16 * 63) >> 16);
+  id[59] = pp->multiple ? (0x0100 | pp->multiple) : 0;
+  if (pp->sectors < 0x0fffffff) {
+    id[60] = (Bit16u)pp->sectors;
+    id[61] = (Bit16u)(pp->sectors >> 16);
+  } else {
+    id[60] = 0xffff;
+    id[61] = 0x0fff;
+  }
+  id[63] = 0x0007;
+  id[64] = 0x0003;
+  id[65] = 120;
+  id[66] = 120;
+  id[67] = 120;
+  id[68] = 120;
+  id[75] = AHCI_NCQ_DEPTH - 1;
+  id[76] = 0x0106; // NCQ, SATA Gen1 / Gen2
+  id[80] = 0x01f0; // ATA/ATAPI-4 ... ATA8-ACS
+  id[82] = 0x4020; // NOP, write cache
+  id[83] = 0x7400; // LBA48, FLUSH CACHE (EXT)
+  id[84] = 0x4000;
+  id[85] = 0x4000 | (pp->write_cache ? 0x0020 : 0x0000);
+  id[86] = 0x3400;
+  id[87] = 0x4000;
+  id[88] = 0x007f | (1 << (pp->udma_mode + 8));
+  id[100] = (Bit16u)pp->sectors;
+  id[101] = (Bit16u)(pp->sectors >> 16);
+  id[102] = (Bit16u)(pp->sectors >> 32);
+  id[103] = (Bit16u)(pp->sectors >> 48);
+  if (!pp->read_only) {
+    id[105] = AHCI_TRIM_BLOCKS;
+    id[169] = 0x0001; // DATA SET MANAGEMENT / TRIM
+  }
+  id[255] = 0x00a5;
+  for (i = 0; i < 256; i++) {
+    WriteHostWordToLittleEndian(&buf[i * 2], id[i]);
+  }
+  for (i = 0; i < 511; i++) sum += buf[i];
+  buf[511] = -sum;
+}
+
+// request execution
+
+void bx_ahci_c::submit(unsigned p, unsigned slot)
+{
+  bx_ahci_port_t *pp = &port[p];
+  bx_ahci_req_t *req = &pp->req[slot];
+
+  req->start_time = DISK_TRACE_TIME();
+  pp->async_mask |= (1U << slot);
+  if (!pp->thread_started) {
+    do_request(p, req);
+    pp->done |= (1U << slot);
+    return;
+  }
+  BX_LOCK(pp->lock);
+  pp->queue[(pp->q_head + pp->q_count) % BX_AHCI_MAX_SLOTS] = slot;
+  pp->q_count++;
+  BX_COND_SIGNAL(pp->cond);
+  BX_UNLOCK(pp->lock);
+  if (!timer_active) {
+    bx_pc_system.activate_timer(timer_id, AHCI_TIMER_USEC, 1);
+    timer_active = 1;
+  }
+}
+
+// called from the I/O thread (or the emulation thread in synchronous mode)
+void bx_ahci_c::do_request(unsigned p, bx_ahci_req_t *req)
+{
+  bx_ahci_port_t *pp = &port[p];
+  Bit64u lba;
+  Bit16u count;
+
+  req->status = ATA_STAT_READY;
+  req->error = 0;
+  switch (req->op) {
+    case AHCI_OP_READ:
+    case AHCI_OP_WRITE:
+      if ((pp->hdimage->lseek(req->lba * 512, SEEK_SET) < 0) ||
+          !image_io(p, req->op == AHCI_OP_WRITE, req->buf, req->len)) {
+        req->status |= ATA_STAT_ERR;
+        req->error = (req->op == AHCI_OP_READ) ? ATA_ERR_UNC : ATA_ERR_ABRT;
+      }
+      break;
+    case AHCI_OP_FLUSH:
+      if (pp->hdimage->flush() < 0) {
+        req->status |= ATA_STAT_ERR;
+        req->error = ATA_ERR_ABRT;
+      }
+      break;
+    case AHCI_OP_TRIM:
+      for (Bit32u i = 0; i < req->len; i += 8) {
+        ReadHostQWordFromLittleEndian(&req->buf[i], lba);
+        count = (Bit16u)(lba >> 48);
+        lba &= BX_CONST64(0xffffffffffff);
+        if (count == 0) continue;
+        if ((lba > pp->sectors) || (count > (pp->sectors - lba)) ||
+            (pp->hdimage->discard(lba * 512, (Bit64u)count * 512) < 0)) {
+          req->status |= ATA_STAT_ERR;
+          req->error = ATA_ERR_ABRT;
+          break;
+        }
+      }
+      break;
+  }
+  req->end_time = DISK_TRACE_TIME();
+}
+
+bx_bool bx_ahci_c::image_io(unsigned p, bx_bool write, Bit8u *buf, Bit32u len)
+{
+  unsigned n = port[p].multi_sector ? len : 512;
+  ssize_t ret;
+
+  for (Bit32u i = 0; i < len; i += n) {
+    if (write) {
+      ret = port[p].hdimage->write(buf + i, n);
+    } else {
+      ret = port[p].hdimage->read(buf + i, n);
+    }
+    if (ret < (ssize_t)n) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// report the requests finished by the I/O thread to the guest
+void bx_ahci_c::process_completions(unsigned p)
+{
+  bx_ahci_port_t *pp = &port[p];
+  bx_ahci_req_t *req;
+  Bit32u done, tags = 0;
+  bx_bool write = 0;
+  int err_slot = -1;
+
+  if (pp->thread_started) {
+    BX_LOCK(pp->lock);
+    done = pp->done;
+    pp->done = 0;
+    BX_UNLOCK(pp->lock);
+  } else {
+    done = pp->done;
+    pp->done = 0;
+  }
+  done &= pp->async_mask;
+  if (done == 0) return;
+  pp->async_mask &= ~done;
+
+  for (unsigned s = 0; s < BX_AHCI_MAX_SLOTS; s++) {
+    if (!(done & (1U << s))) continue;
+    req = &pp->req[s];
+    trace(p, req);
+    if (req->op == AHCI_OP_WRITE) write = 1;
+    if (req->status & ATA_STAT_ERR) {
+      BX_ERROR(("port %d: %s of sector " FMT_LL "u (count %d) failed", p,
+                (req->op == AHCI_OP_READ) ? "read" : "write", req->lba, req->count));
+      if (err_slot < 0) {
+        err_slot = s;
+      } else {
+        pp->issued &= ~(1U << s);
+      }
+      continue;
+    }
+    if (req->op == AHCI_OP_READ) {
+      set_prdbc(p, s, dma_transfer(p, s, 1, req->buf, req->len));
+    } else if (req->op != AHCI_OP_FLUSH) {
+      set_prdbc(p, s, req->len);
+    }
+    if (req->ncq) {
+      tags |= (1U << req->tag);
+      pp->issued &= ~(1U << s);
+    } else {
+      command_done(p, s, req->pio, (Bit16u)req->len);
+    }
+  }
+  if (tags != 0) {
+    sdb_fis(p, ATA_STAT_READY, 0, tags);
+  }
+  if (err_slot >= 0) {
+    command_error(p, err_slot, pp->req[err_slot].status, pp->req[err_slot].error);
+  }
+  bx_gui->statusbar_setitem(statusbar_id, 1, write);
+  update_irq();
+}
+
+void bx_ahci_c::trace(unsigned p, bx_ahci_req_t *req)
+{
+  Bit32u depth = 0;
+
+  if (DEV_hdimage_trace_enabled() && (req->op != AHCI_OP_TRIM)) {
+    for (Bit32u m = port[p].issued; m != 0; m &= (m - 1)) depth++;
+    DEV_hdimage_trace_request(DISK_TRACE_DEV_AHCI + p,
+                              (req->op == AHCI_OP_READ) ? DISK_TRACE_READ :
+                              (req->op == AHCI_OP_WRITE) ? DISK_TRACE_WRITE : DISK_TRACE_FLUSH,
+                              req->lba, req->count, (Bit32u)(req->end_time - req->start_time),
+                              (depth < 255) ? (Bit8u)depth : 255);
+  }
+}
+
+void bx_ahci_c::timer_handler(void *this_ptr)
+{
+  ((bx_ahci_c *) this_ptr)->timer();
+}
+
+void bx_ahci_c::timer(void)
+{
+  bx_bool pending = 0;
+
+  for (unsigned p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    if (port[p].async_mask != 0) {
+      process_completions(p);
+    }
+  }
+  for (unsigned p = 0; p < BX_AHCI_MAX_PORTS; p++) {
+    pending |= (port[p].async_mask != 0);
+  }
+  if (!pending) {
+    bx_pc_system.deactivate_timer(timer_id);
+    timer_active = 0;
+  }
+}
+
+// I/O thread handling
+
+void bx_ahci_c::start_thread(unsigned p)
+{
+  bx_ahci_port_t *pp = &port[p];
+
+  BX_INIT_MUTEX(pp->lock);
+  BX_INIT_COND(pp->cond);
+  BX_INIT_COND(pp->idle_cond);
+  pp->q_head = 0;
+  pp->q_count = 0;
+  pp->busy = 0;
+  pp->quit = 0;
+  pp->done = 0;
+  if (!BX_THREAD_CREATE(io_thread, pp, pp->tid)) {
+    BX_PANIC(("port %d: cannot create I/O thread", p));
+    return;
+  }
+  pp->thread_started = 1;
+}
+
+void bx_ahci_c::stop_thread(unsigned p)
+{
+  bx_ahci_port_t *pp = &port[p];
+
+  if (!pp->thread_started) return;
+  BX_LOCK(pp->lock);
+  pp->quit = 1;
+  BX_COND_SIGNAL(pp->cond);
+  BX_UNLOCK(pp->lock);
+  BX_THREAD_JOIN(pp->tid);
+  BX_FINI_COND(pp->cond);
+  BX_FINI_COND(pp->idle_cond);
+  BX_FINI_MUTEX(pp->lock);
+  pp->thread_started = 0;
+}
+
+// wait until the I/O thread has finished all queued requests
+void bx_ahci_c::wait_idle(unsigned p)
+{
+  bx_ahci_port_t *pp = &port[p];
+
+  if (!pp->thread_started) return;
+  BX_LOCK(pp->lock);
+  while ((pp->q_count > 0) || pp->busy) {
+    BX_COND_WAIT(pp->idle_cond, pp->lock);
+  }
+  BX_UNLOCK(pp->lock);
+}
+
+// forget all outstanding requests (port stopped or reset)
+void bx_ahci_c::drop_requests(unsigned p)
+{
+  bx_ahci_port_t *pp = &port[p];
+
+  if (pp->thread_started) {
+    BX_LOCK(pp->lock);
+    pp->q_count = 0;
+    BX_UNLOCK(pp->lock);
+    wait_idle(p);
+  }
+  pp->done = 0;
+  pp->async_mask = 0;
+}
+
+BX_THREAD_FUNC(bx_ahci_c::io_thread, indata)
+{
+  bx_ahci_port_t *pp = (bx_ahci_port_t *) indata;
+
+  pp->ahci->io_loop(pp);
+  BX_THREAD_EXIT;
+}
+
+void bx_ahci_c::io_loop(bx_ahci_port_t *pp)
+{
+  unsigned slot;
+
+  BX_LOCK(pp->lock);
+  while (!pp->quit) {
+    if (pp->q_count == 0) {
+      BX_COND_WAIT(pp->cond, pp->lock);
+      continue;
+    }
+    slot = pp->queue[pp->q_head];
+    pp->q_head = (pp->q_head + 1) % BX_AHCI_MAX_SLOTS;
+    pp->q_count--;
+    pp->busy = 1;
+    BX_UNLOCK(pp->lock);
+    do_request(pp->num, &pp->req[slot]);
+    BX_LOCK(pp->lock);
+    pp->busy = 0;
+    pp->done |= (1U << slot);
+    if (pp->q_count == 0) {
+      BX_COND_SIGNAL(pp->idle_cond);
+    }
+  }
+  BX_UNLOCK(pp->lock);
+}
+
+// pci configuration space read callback handler
+Bit32u bx_ahci_c::pci_read_handler(Bit8u address, unsigned io_len)
+{
+  Bit32u value = 0;
+
+  for (unsigned i=0; i<io_len; i++) {
+    value |= (pci_conf[address+i] << (i*8));
+  }
+
+  if (io_len == 1)
+    BX_DEBUG(("read  PCI register 0x%02x value 0x%02x", address, value));
+  else if (io_len == 2)
+    BX_DEBUG(("read  PCI register 0x%02x value 0x%04x", address, value));
+  else if (io_len == 4)
+    BX_DEBUG(("read  PCI register 0x%02x value 0x%08x", address, value));
+
+  return value;
+}
+
+// pci configuration space write callback handler
+void bx_ahci_c::pci_write_handler(Bit8u address, Bit32u value, unsigned io_len)
+{
+  Bit8u value8, oldval;
+  bx_bool baseaddr5_change = 0;
+
+  for (unsigned i=0; i<io_len; i++) {
+    value8 = (value >> (i*8)) & 0xFF;
+    oldval = pci_conf[address+i];
+    switch (address+i) {
+      case 0x04:
+        value8 &= 0x07;
+        break;
+      case 0x05:
+        value8 &= 0x04; // interrupt disable
+        break;
+      case 0x3c:
+        if (value8 != oldval) {
+          BX_INFO(("new irq line = %d", value8));
+        }
+        break;
+      case 0x24:
+        value8 = (value8 & 0xf0) | (oldval & 0x0f);
+      case 0x25:
+      case 0x26:
+      case 0x27:
+        baseaddr5_change |= (value8 != oldval);
+        break;
+      case 0x92:
+        value8 &= (1 << BX_AHCI_MAX_PORTS) - 1;
+        break;
+      default:
+        value8 = oldval;
+    }
+    pci_conf[address+i] = value8;
+  }
+  if (baseaddr5_change) {
+    if (DEV_pci_set_base_mem(this, mem_read_handler, mem_write_handler,
+                             &pci_base_address[5], &pci_conf[0x24], AHCI_MEM_SIZE)) {
+      BX_INFO(("new ABAR address: 0x%08x", pci_base_address[5]));
+    }
+  }
+  if ((address <= 0x05) && ((address + io_len) > 0x05)) {
+    update_irq();
+  }
+
+  if (io_len == 1)
+    BX_DEBUG(("write PCI register 0x%02x value 0x%02x", address, value));
+  else if (io_len == 2)
+    BX_DEBUG(("write PCI register 0x%02x value 0x%04x", address, value));
+  else if (io_len == 4)
+    BX_DEBUG(("write PCI register 0x%02x value 0x%08x", address, value));
+}
+
+#endif // BX_SUPPORT_PCI && BX_SUPPORT_AHCI
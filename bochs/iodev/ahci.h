@@ -0,0 +1,178 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef BX_IODEV_AHCI_H
+#define BX_IODEV_AHCI_H
+
+#include "bxthread.h"
+
+#define BX_AHCI_MAX_PORTS 6
+#define BX_AHCI_MAX_SLOTS 32
+
+class device_image_t;
+class bx_ahci_c;
+
+// request handed to the I/O thread of a port
+typedef struct {
+  Bit8u   op;         // AHCI_OP_xxx
+  Bit8u   cmd;        // ATA command code
+  Bit8u   tag;        // NCQ tag
+  bx_bool ncq;
+  bx_bool pio;        // PIO data command (completed with a PIO Setup FIS)
+  Bit64u  lba;
+  Bit32u  count;      // sectors
+  Bit32u  len;        // bytes
+  Bit8u   *buf;       // data buffer (reallocated if too small)
+  Bit32u  buf_size;
+  Bit8u   status;     // ATA status / error set by the I/O thread
+  Bit8u   error;
+  Bit64u  start_time;
+  Bit64u  end_time;
+} bx_ahci_req_t;
+
+typedef struct {
+  // port registers
+  Bit32u clb;
+  Bit32u clbu;
+  Bit32u fb;
+  Bit32u fbu;
+  Bit32u is;
+  Bit32u ie;
+  Bit32u cmd;
+  Bit32u tfd;
+  Bit32u sig;
+  Bit32u ssts;
+  Bit32u sctl;
+  Bit32u serr;
+  Bit32u sact;
+  Bit32u ci;
+  Bit32u sntf;
+
+  Bit32u  issued;      // slots fetched from the command list, not completed yet
+  Bit32u  async_mask;  // slots handed to the I/O thread
+  bx_bool stopped;     // task file error: command list processing halted
+  bx_bool srst;        // software reset asserted
+  Bit8u   multiple;
+  Bit8u   udma_mode;
+  bx_bool write_cache;
+  struct {             // NCQ command error log (log page 10h)
+    bx_bool valid;
+    bx_bool nq;
+    Bit8u   tag;
+    Bit8u   status;
+    Bit8u   error;
+  } err_log;
+
+  // attached disk
+  device_image_t *hdimage;
+  Bit64u  sectors;
+  bx_bool read_only;
+  bx_bool multi_sector;
+  bx_ahci_req_t req[BX_AHCI_MAX_SLOTS];
+
+  // I/O thread: executes the queued slots in order and reports them
+  // back in the done mask
+  bx_ahci_c *ahci;
+  unsigned num;
+  bx_bool thread_started;
+  BX_THREAD_ID(tid);
+  BX_MUTEX(lock);
+  BX_COND(cond);
+  BX_COND(idle_cond);
+  Bit8u   queue[BX_AHCI_MAX_SLOTS];
+  unsigned q_head;
+  unsigned q_count;
+  bx_bool busy;
+  bx_bool quit;
+  Bit32u  done;
+} bx_ahci_port_t;
+
+class bx_ahci_c : public bx_devmodel_c, bx_pci_device_stub_c {
+public:
+  bx_ahci_c();
+  virtual ~bx_ahci_c();
+  virtual void init(void);
+  virtual void reset(unsigned type);
+  virtual void register_state(void);
+  virtual void after_restore_state(void);
+
+  virtual Bit32u pci_read_handler(Bit8u address, unsigned io_len);
+  virtual void   pci_write_handler(Bit8u address, Bit32u value, unsigned io_len);
+
+private:
+  void   hba_reset(void);
+  void   port_reset(unsigned p);
+  void   device_reset(unsigned p);
+  void   update_irq(void);
+
+  Bit32u read_reg(Bit32u offset);
+  void   write_reg(Bit32u offset, Bit32u value, Bit32u mask);
+  Bit32u port_read(unsigned p, Bit32u reg);
+  void   port_write(unsigned p, Bit32u reg, Bit32u value, Bit32u mask);
+
+  void   write_fis(unsigned p, unsigned offset, Bit8u *fis, unsigned len);
+  void   d2h_fis(unsigned p, Bit8u status, Bit8u error, bx_bool irq, bx_bool sig);
+  void   pio_setup_fis(unsigned p, Bit8u status, bx_bool to_host, Bit16u len);
+  void   sdb_fis(unsigned p, Bit8u status, Bit8u error, Bit32u tags);
+
+  void   issue_commands(unsigned p);
+  void   execute_slot(unsigned p, unsigned slot);
+  void   execute_sync(unsigned p, unsigned slot, Bit8u *fis);
+  bx_bool prepare_rw(unsigned p, unsigned slot, Bit8u *fis);
+  void   submit(unsigned p, unsigned slot);
+  void   do_request(unsigned p, bx_ahci_req_t *req);
+  bx_bool image_io(unsigned p, bx_bool write, Bit8u *buf, Bit32u len);
+  void   process_completions(unsigned p);
+  void   command_done(unsigned p, unsigned slot, bx_bool pio, Bit16u pio_len);
+  void   command_error(unsigned p, unsigned slot, Bit8u status, Bit8u error);
+  Bit32u dma_transfer(unsigned p, unsigned slot, bx_bool to_guest, Bit8u *buf, Bit32u len);
+  void   set_prdbc(unsigned p, unsigned slot, Bit32u count);
+  bx_bool alloc_buffer(bx_ahci_req_t *req, Bit32u len);
+  void   identify(unsigned p, Bit8u *buf);
+  void   trace(unsigned p, bx_ahci_req_t *req);
+
+  void   start_thread(unsigned p);
+  void   stop_thread(unsigned p);
+  void   wait_idle(unsigned p);
+  void   drop_requests(unsigned p);
+  static BX_THREAD_FUNC(io_thread, indata);
+  void   io_loop(bx_ahci_port_t *port);
+
+  static void timer_handler(void *this_ptr);
+  void   timer(void);
+  static Bit64s param_save_handler(void *devptr, bx_param_c *param);
+
+  static bx_bool mem_read_handler(bx_phy_address addr, unsigned len, void *data, void *param);
+  static bx_bool mem_write_handler(bx_phy_address addr, unsigned len, void *data, void *param);
+  bx_bool mem_read(bx_phy_address addr, unsigned len, void *data);
+  bx_bool mem_write(bx_phy_address addr, unsigned len, void *data);
+
+  Bit8u  devfunc;
+  Bit32u ghc;
+  Bit32u is;
+  bx_bool async;
+  int    timer_id;
+  bx_bool timer_active;
+  int    statusbar_id;
+  bx_ahci_port_t port[BX_AHCI_MAX_PORTS];
+};
+
+#endif
@@ -1023,7 +1023,8 @@ bx_bool bx_devices_c::is_network_enabled(void)
 {
   if (PLUG_device_present("e1000") ||
       PLUG_device_present("ne2k") ||
-      PLUG_device_present("pcipnic")) {
+      PLUG_device_present("pcipnic") ||
+      PLUG_device_present("virtio_net")) {
     return 1;
   }
   return 0;
@@ -1265,7 +1266,8 @@ bx_bool bx_devices_c::register_pci_handlers(bx_pci_device_stub_c *dev,
 }
 
 bx_bool bx_devices_c::pci_set_base_mem(void *this_ptr, memory_handler_t f1, memory_handler_t f2,
-                                       Bit32u *addr, Bit8u *pci_conf, unsigned size)
+                                       Bit32u *addr, Bit8u *pci_conf, unsigned size,
+                                       memory_direct_access_handler_t f3)
 {
   Bit32u newbase;
 
@@ -1287,7 +1289,7 @@ bx_bool bx_devices_c::pci_set_base_mem(void *this_ptr, memory_handler_t f1, memo
       DEV_unregister_memory_handlers(this_ptr, oldbase, oldbase + size - 1);
     }
     if (newbase > 0) {
-      DEV_register_memory_handlers(this_ptr, f1, f2, newbase, newbase + size - 1);
+      DEV_register_memory_handlers_da(this_ptr, f1, f2, f3, newbase, newbase + size - 1);
     }
     *addr = newbase;
     return 1;
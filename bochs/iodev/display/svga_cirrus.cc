@@ -37,6 +37,7 @@
 #define BX_PLUGGABLE
 
 #include "iodev.h"
+#include "gui/pixconv.h"
 #include "vgacore.h"
 #include "svga_cirrus.h"
 #include "virt_timer.h"
@@ -132,6 +133,11 @@
 #define CIRRUS_BLT_FIFOUSED             0x10
 #define CIRRUS_BLT_AUTOSTART            0x80
 
+// state of the BLT thread
+#define CIRRUS_BLT_THREAD_IDLE          0
+#define CIRRUS_BLT_THREAD_RUN           1 // posted, owned by the BLT thread
+#define CIRRUS_BLT_THREAD_DONE          2 // finished, not yet completed
+
 // control 0x32
 #define CIRRUS_ROP_0                    0x00
 #define CIRRUS_ROP_SRC_AND_DST          0x05
@@ -242,11 +248,13 @@ void libsvga_cirrus_LTX_plugin_fini(void)
 
 bx_svga_cirrus_c::bx_svga_cirrus_c() : bx_vgacore_c()
 {
-  // nothing else to do
+  blt_thread.started = 0;
+  blt_thread.posted = 0;
 }
 
 bx_svga_cirrus_c::~bx_svga_cirrus_c()
 {
+  svga_blt_thread_stop();
   SIM->get_bochs_root()->remove("svga_cirrus");
   BX_DEBUG(("Exit"));
 }
@@ -274,6 +282,9 @@ void bx_svga_cirrus_c::init_vga_extension(void)
     BX_CIRRUS_THIS s.max_xres = 1600;
     BX_CIRRUS_THIS s.max_yres = 1200;
     BX_CIRRUS_THIS extension_init = 1;
+    if (SIM->get_param_bool(BXPN_VGA_BLT_THREAD)->get()) {
+      BX_CIRRUS_THIS svga_blt_thread_start();
+    }
   } else {
     BX_CIRRUS_THIS sequencer.reg[0x07] = 0x00; // Cirrus extension disabled
     // initialize VGA extension, read/write handlers and timer
@@ -326,7 +337,7 @@ void bx_svga_cirrus_c::svga_init_members()
 
   // memory allocation.
   if (BX_CIRRUS_THIS s.memory == NULL)
-    BX_CIRRUS_THIS s.memory = new Bit8u[CIRRUS_VIDEO_MEMORY_BYTES];
+    BX_CIRRUS_THIS alloc_memory(CIRRUS_VIDEO_MEMORY_BYTES);
 
   // set some registers.
 
@@ -367,6 +378,7 @@ void bx_svga_cirrus_c::reset(unsigned type)
 
   if (!strcmp(SIM->get_param_string(BXPN_VGA_EXTENSION)->getptr(), "cirrus")) {
     // reset SVGA stuffs.
+    BX_CIRRUS_THIS svga_blt_finish(1);
     BX_CIRRUS_THIS svga_init_members();
   }
 }
@@ -440,11 +452,11 @@ void bx_svga_cirrus_c::after_restore_state(void)
   } else {
 #if BX_SUPPORT_PCI
     if (BX_CIRRUS_THIS pci_enabled) {
-      if (DEV_pci_set_base_mem(BX_CIRRUS_THIS_PTR, cirrus_mem_read_handler,
-                               cirrus_mem_write_handler,
-                               &BX_CIRRUS_THIS pci_base_address[0],
-                               &BX_CIRRUS_THIS pci_conf[0x10],
-                               0x2000000)) {
+      if (DEV_pci_set_base_mem_da(BX_CIRRUS_THIS_PTR, cirrus_mem_read_handler,
+                                  cirrus_mem_write_handler,
+                                  &BX_CIRRUS_THIS pci_base_address[0],
+                                  &BX_CIRRUS_THIS pci_conf[0x10],
+                                  0x2000000, cirrus_mem_da_handler)) {
         BX_INFO(("new pci_memaddr: 0x%04x", BX_CIRRUS_THIS pci_base_address[0]));
       }
       if (DEV_pci_set_base_mem(BX_CIRRUS_THIS_PTR, cirrus_mem_read_handler,
@@ -573,6 +585,33 @@ bx_bool bx_svga_cirrus_c::cirrus_mem_read_handler(bx_phy_address addr, unsigned
   }
   return 1;
 }
+
+// Hands out pages of the linear framebuffer to the CPU as long as an
+// access is a plain read or write of the video memory. Whenever one of
+// the conditions checked here changes, the pages are revoked again.
+Bit8u *bx_svga_cirrus_c::cirrus_mem_da_handler(bx_phy_address addr, unsigned rw, void *param)
+{
+  Bit32u offset;
+
+  if (((BX_CIRRUS_THIS sequencer.reg[0x07] & 0x01) == CIRRUS_SR7_BPP_VGA) ||
+      (addr < BX_CIRRUS_THIS pci_base_address[0]) ||
+      (addr >= (BX_CIRRUS_THIS pci_base_address[0] + CIRRUS_PNPMEM_SIZE))) {
+    return NULL;
+  }
+  // address shifting, extended write modes and BLTs in progress
+  if ((BX_CIRRUS_THIS control.reg[0x0b] & 0x06) || BX_CIRRUS_THIS blt_thread.posted ||
+      (BX_CIRRUS_THIS bitblt.memsrc_needed > 0) ||
+      (BX_CIRRUS_THIS bitblt.memdst_needed > 0)) {
+    return NULL;
+  }
+  offset = (Bit32u)addr & (BX_CIRRUS_THIS s.memsize - 1);
+  // BLT registers mapped at the end of the video memory
+  if (((BX_CIRRUS_THIS sequencer.reg[0x17] & 0x44) == 0x44) &&
+      ((offset | ((1 << BX_VGA_DIRTY_PAGE_SHIFT) - 1)) >= (BX_CIRRUS_THIS s.memsize - 256))) {
+    return NULL;
+  }
+  return BX_CIRRUS_THIS get_direct_ptr(offset, rw);
+}
 #endif
 
 Bit8u bx_svga_cirrus_c::mem_read(bx_phy_address addr)
@@ -590,6 +629,8 @@ Bit8u bx_svga_cirrus_c::mem_read(bx_phy_address addr)
   }
 #endif
 
+  BX_CIRRUS_THIS svga_blt_finish(1);
+
   if ((BX_CIRRUS_THIS sequencer.reg[0x07] & 0x01) == CIRRUS_SR7_BPP_VGA) {
     return BX_CIRRUS_THIS bx_vgacore_c::mem_read(addr);
   }
@@ -716,6 +757,8 @@ bx_bool bx_svga_cirrus_c::cirrus_mem_write_handler(bx_phy_address addr, unsigned
 
 void bx_svga_cirrus_c::mem_write(bx_phy_address addr, Bit8u value)
 {
+  BX_CIRRUS_THIS svga_blt_finish(1);
+
   if ((BX_CIRRUS_THIS sequencer.reg[0x07] & 0x01) == CIRRUS_SR7_BPP_VGA) {
     BX_CIRRUS_THIS bx_vgacore_c::mem_write(addr,value);
     return;
@@ -865,6 +908,9 @@ Bit32u bx_svga_cirrus_c::svga_read(Bit32u address, unsigned io_len)
   UNUSED(this_ptr);
 #endif // !BX_USE_CIRRUS_SMF
 
+  // the BLT status reports busy until the BLT thread has finished
+  BX_CIRRUS_THIS svga_blt_finish(0);
+
   if ((io_len == 2) && ((address & 1) == 0)) {
     Bit32u value;
     value = (Bit32u)SVGA_READ(address,1);
@@ -956,6 +1002,8 @@ void bx_svga_cirrus_c::svga_write(Bit32u address, Bit32u value, unsigned io_len)
   UNUSED(this_ptr);
 #endif // !BX_USE_CIRRUS_SMF
 
+  BX_CIRRUS_THIS svga_blt_finish(1);
+
   if ((io_len == 2) && ((address & 1) == 0)) {
     SVGA_WRITE(address,value & 0xff,1);
     SVGA_WRITE(address+1,value >> 8,1);
@@ -1243,6 +1291,9 @@ void bx_svga_cirrus_c::svga_update(void)
 {
   unsigned width, height, pitch;
 
+  // pick up the result of a BLT finished by the BLT thread
+  BX_CIRRUS_THIS svga_blt_finish(0);
+
   /* skip screen update when the sequencer is in reset mode or video is disabled */
   if (! BX_CIRRUS_THIS s.sequencer.reset1 ||
       ! BX_CIRRUS_THIS s.sequencer.reset2 ||
@@ -1282,6 +1333,11 @@ void bx_svga_cirrus_c::svga_update(void)
     BX_CIRRUS_THIS svga_needs_update_dispentire = 0;
   }
 
+  if (BX_CIRRUS_THIS lfb_dirty_scan((Bit32u)(BX_CIRRUS_THIS disp_ptr - BX_CIRRUS_THIS s.memory),
+                                    pitch, BX_CIRRUS_THIS svga_bpp >> 3, width, height)) {
+    BX_CIRRUS_THIS svga_needs_update_tile = 1;
+  }
+
   if (!BX_CIRRUS_THIS svga_needs_update_tile) {
     return;
   }
@@ -1295,6 +1351,9 @@ void bx_svga_cirrus_c::svga_update(void)
   Bit8u * vid_ptr, * vid_ptr2;
   Bit8u * tile_ptr, * tile_ptr2;
   bx_svga_tileinfo_t info;
+  Bit32u lut[256];
+  bx_pixconv_rgb16_t fmt;
+  bx_bool pixconv;
 
   if (bx_gui->graphics_tile_info_common(&info)) {
     if (info.snapshot_mode) {
@@ -1355,33 +1414,47 @@ void bx_svga_cirrus_c::svga_update(void)
       }
     }
     else {
+      // the common 32 bpp host formats use the row conversion kernels
+      pixconv = (info.bpp == 32) && info.is_little_endian;
       switch (BX_CIRRUS_THIS svga_dispbpp) {
         case 4:
           BX_ERROR(("cannot draw 4bpp SVGA"));
           break;
         case 8:
+          if (pixconv) {
+            for (i=0; i<256; i++) {
+              lut[i] = MAKE_COLOUR(
+                BX_CIRRUS_THIS s.pel.data[i].red, 6, info.red_shift, info.red_mask,
+                BX_CIRRUS_THIS s.pel.data[i].green, 6, info.green_shift, info.green_mask,
+                BX_CIRRUS_THIS s.pel.data[i].blue, 6, info.blue_shift, info.blue_mask);
+            }
+          }
           for (yc=0, yti = 0; yc<height; yc+=Y_TILESIZE, yti++) {
             for (xc=0, xti = 0; xc<width; xc+=X_TILESIZE, xti++) {
               if (GET_TILE_UPDATED (xti, yti)) {
                 vid_ptr = BX_CIRRUS_THIS disp_ptr + (yc * pitch + xc);
                 tile_ptr = bx_gui->graphics_tile_get(xc, yc, &w, &h);
                 for (r=0; r<h; r++) {
-                  vid_ptr2  = vid_ptr;
-                  tile_ptr2 = tile_ptr;
-                  for (c=0; c<w; c++) {
-                    colour = *(vid_ptr2++);
-                    colour = MAKE_COLOUR(
-                      BX_CIRRUS_THIS s.pel.data[colour].red, 6, info.red_shift, info.red_mask,
-                      BX_CIRRUS_THIS s.pel.data[colour].green, 6, info.green_shift, info.green_mask,
-                      BX_CIRRUS_THIS s.pel.data[colour].blue, 6, info.blue_shift, info.blue_mask);
-                    if (info.is_little_endian) {
-                      for (i=0; i<info.bpp; i+=8) {
-                        *(tile_ptr2++) = colour >> i;
+                  if (pixconv) {
+                    bx_pixconv.index8_to_32((Bit32u *)tile_ptr, vid_ptr, lut, w);
+                  } else {
+                    vid_ptr2  = vid_ptr;
+                    tile_ptr2 = tile_ptr;
+                    for (c=0; c<w; c++) {
+                      colour = *(vid_ptr2++);
+                      colour = MAKE_COLOUR(
+                        BX_CIRRUS_THIS s.pel.data[colour].red, 6, info.red_shift, info.red_mask,
+                        BX_CIRRUS_THIS s.pel.data[colour].green, 6, info.green_shift, info.green_mask,
+                        BX_CIRRUS_THIS s.pel.data[colour].blue, 6, info.blue_shift, info.blue_mask);
+                      if (info.is_little_endian) {
+                        for (i=0; i<info.bpp; i+=8) {
+                          *(tile_ptr2++) = colour >> i;
+                        }
                       }
-                    }
-                    else {
-                      for (i=info.bpp-8; i>-8; i-=8) {
-                        *(tile_ptr2++) = colour >> i;
+                      else {
+                        for (i=info.bpp-8; i>-8; i-=8) {
+                          *(tile_ptr2++) = colour >> i;
+                        }
                       }
                     }
                   }
@@ -1396,29 +1469,34 @@ void bx_svga_cirrus_c::svga_update(void)
           }
           break;
         case 15:
+          if (pixconv) bx_pixconv_rgb16_init(&fmt, 15, &info);
           for (yc=0, yti = 0; yc<height; yc+=Y_TILESIZE, yti++) {
             for (xc=0, xti = 0; xc<width; xc+=X_TILESIZE, xti++) {
               if (GET_TILE_UPDATED (xti, yti)) {
                 vid_ptr = BX_CIRRUS_THIS disp_ptr + (yc * pitch + (xc<<1));
                 tile_ptr = bx_gui->graphics_tile_get(xc, yc, &w, &h);
                 for (r=0; r<h; r++) {
-                  vid_ptr2  = vid_ptr;
-                  tile_ptr2 = tile_ptr;
-                  for (c=0; c<w; c++) {
-                    colour = *(vid_ptr2++);
-                    colour |= *(vid_ptr2++) << 8;
-                    colour = MAKE_COLOUR(
-                      colour & 0x001f, 5, info.blue_shift, info.blue_mask,
-                      colour & 0x03e0, 10, info.green_shift, info.green_mask,
-                      colour & 0x7c00, 15, info.red_shift, info.red_mask);
-                    if (info.is_little_endian) {
-                      for (i=0; i<info.bpp; i+=8) {
-                        *(tile_ptr2++) = colour >> i;
+                  if (pixconv) {
+                    bx_pixconv.rgb16_to_32((Bit32u *)tile_ptr, vid_ptr, w, &fmt);
+                  } else {
+                    vid_ptr2  = vid_ptr;
+                    tile_ptr2 = tile_ptr;
+                    for (c=0; c<w; c++) {
+                      colour = *(vid_ptr2++);
+                      colour |= *(vid_ptr2++) << 8;
+                      colour = MAKE_COLOUR(
+                        colour & 0x001f, 5, info.blue_shift, info.blue_mask,
+                        colour & 0x03e0, 10, info.green_shift, info.green_mask,
+                        colour & 0x7c00, 15, info.red_shift, info.red_mask);
+                      if (info.is_little_endian) {
+                        for (i=0; i<info.bpp; i+=8) {
+                          *(tile_ptr2++) = colour >> i;
+                        }
                       }
-                    }
-                    else {
-                      for (i=info.bpp-8; i>-8; i-=8) {
-                        *(tile_ptr2++) = colour >> i;
+                      else {
+                        for (i=info.bpp-8; i>-8; i-=8) {
+                          *(tile_ptr2++) = colour >> i;
+                        }
                       }
                     }
                   }
@@ -1433,29 +1511,34 @@ void bx_svga_cirrus_c::svga_update(void)
           }
           break;
         case 16:
+          if (pixconv) bx_pixconv_rgb16_init(&fmt, 16, &info);
           for (yc=0, yti = 0; yc<height; yc+=Y_TILESIZE, yti++) {
             for (xc=0, xti = 0; xc<width; xc+=X_TILESIZE, xti++) {
               if (GET_TILE_UPDATED (xti, yti)) {
                 vid_ptr = BX_CIRRUS_THIS disp_ptr + (yc * pitch + (xc<<1));
                 tile_ptr = bx_gui->graphics_tile_get(xc, yc, &w, &h);
                 for (r=0; r<h; r++) {
-                  vid_ptr2  = vid_ptr;
-                  tile_ptr2 = tile_ptr;
-                  for (c=0; c<w; c++) {
-                    colour = *(vid_ptr2++);
-                    colour |= *(vid_ptr2++) << 8;
-                    colour = MAKE_COLOUR(
-                      colour & 0x001f, 5, info.blue_shift, info.blue_mask,
-                      colour & 0x07e0, 11, info.green_shift, info.green_mask,
-                      colour & 0xf800, 16, info.red_shift, info.red_mask);
-                    if (info.is_little_endian) {
-                      for (i=0; i<info.bpp; i+=8) {
-                        *(tile_ptr2++) = colour >> i;
+                  if (pixconv) {
+                    bx_pixconv.rgb16_to_32((Bit32u *)tile_ptr, vid_ptr, w, &fmt);
+                  } else {
+                    vid_ptr2  = vid_ptr;
+                    tile_ptr2 = tile_ptr;
+                    for (c=0; c<w; c++) {
+                      colour = *(vid_ptr2++);
+                      colour |= *(vid_ptr2++) << 8;
+                      colour = MAKE_COLOUR(
+                        colour & 0x001f, 5, info.blue_shift, info.blue_mask,
+                        colour & 0x07e0, 11, info.green_shift, info.green_mask,
+                        colour & 0xf800, 16, info.red_shift, info.red_mask);
+                      if (info.is_little_endian) {
+                        for (i=0; i<info.bpp; i+=8) {
+                          *(tile_ptr2++) = colour >> i;
+                        }
                       }
-                    }
-                    else {
-                      for (i=info.bpp-8; i>-8; i-=8) {
-                        *(tile_ptr2++) = colour >> i;
+                      else {
+                        for (i=info.bpp-8; i>-8; i-=8) {
+                          *(tile_ptr2++) = colour >> i;
+                        }
                       }
                     }
                   }
@@ -1805,6 +1888,9 @@ void bx_svga_cirrus_c::svga_write_sequencer(Bit32u address, unsigned index, Bit8
     case 0x7: // cirrus extended sequencer mode
       if (value != BX_CIRRUS_THIS sequencer.reg[0x7]) {
         BX_CIRRUS_THIS svga_needs_update_mode = 1;
+        if ((value ^ BX_CIRRUS_THIS sequencer.reg[0x7]) & 0x01) {
+          BX_CIRRUS_THIS lfb_revoke();
+        }
       }
       break;
     case 0x08:
@@ -1867,6 +1953,9 @@ void bx_svga_cirrus_c::svga_write_sequencer(Bit32u address, unsigned index, Bit8
       break;
     case 0x17:
       value = (BX_CIRRUS_THIS sequencer.reg[0x17] & 0x38) | (value & 0xc7);
+      if ((value ^ BX_CIRRUS_THIS sequencer.reg[0x17]) & 0x44) {
+        BX_CIRRUS_THIS lfb_revoke();
+      }
       break;
     default:
       BX_DEBUG(("sequencer index 0x%02x is unknown(write 0x%02x)", index, (unsigned)value));
@@ -1982,6 +2071,9 @@ void bx_svga_cirrus_c::svga_write_control(Bit32u address, unsigned index, Bit8u
     case 0x09: // bank offset #0
     case 0x0A: // bank offset #1
     case 0x0B:
+      if ((index == 0x0b) && ((value ^ BX_CIRRUS_THIS control.reg[0x0b]) & 0x06)) {
+        BX_CIRRUS_THIS lfb_revoke();
+      }
       BX_CIRRUS_THIS control.reg[index] = value;
       update_bank_ptr(0);
       update_bank_ptr(1);
@@ -2481,11 +2573,11 @@ void bx_svga_cirrus_c::pci_write_handler(Bit8u address, Bit32u value, unsigned i
     value >>= 8;
   }
   if (baseaddr0_change) {
-    if (DEV_pci_set_base_mem(BX_CIRRUS_THIS_PTR, cirrus_mem_read_handler,
-                             cirrus_mem_write_handler,
-                             &BX_CIRRUS_THIS pci_base_address[0],
-                             &BX_CIRRUS_THIS pci_conf[0x10],
-                             0x2000000)) {
+    if (DEV_pci_set_base_mem_da(BX_CIRRUS_THIS_PTR, cirrus_mem_read_handler,
+                                cirrus_mem_write_handler,
+                                &BX_CIRRUS_THIS pci_base_address[0],
+                                &BX_CIRRUS_THIS pci_conf[0x10],
+                                0x2000000, cirrus_mem_da_handler)) {
       BX_INFO(("new pci_memaddr: 0x%04x", BX_CIRRUS_THIS pci_base_address[0]));
     }
   }
@@ -2517,6 +2609,22 @@ void bx_svga_cirrus_c::pci_write_handler(Bit8u address, Bit32u value, unsigned i
 //
 /////////////////////////////////////////////////////////////////////////
 
+// returns 0 for the bltmode flag combinations the pattern copy or simple BLT
+// functions do not support. The video-to-video functions may run on the BLT
+// thread, so the mode is checked and reported before they are started.
+static bx_bool cirrus_bltmode_supported(Bit8u bltmode, bx_bool patterncopy)
+{
+  if (bltmode & CIRRUS_BLTMODE_COLOREXPAND) {
+    if (!patterncopy || (bltmode & CIRRUS_BLTMODE_TRANSPARENTCOMP))
+      return 1;
+    return (bltmode & ~(CIRRUS_BLTMODE_PATTERNCOPY | CIRRUS_BLTMODE_COLOREXPAND)) == 0;
+  }
+  if (patterncopy) {
+    return (bltmode & ~CIRRUS_BLTMODE_PATTERNCOPY) == 0;
+  }
+  return (bltmode & ~CIRRUS_BLTMODE_BACKWARDS) == 0;
+}
+
 void bx_svga_cirrus_c::svga_reset_bitblt(void)
 {
   BX_CIRRUS_THIS control.reg[0x31] &= ~(CIRRUS_BLT_START|CIRRUS_BLT_BUSY|CIRRUS_BLT_FIFOUSED);
@@ -2531,6 +2639,106 @@ void bx_svga_cirrus_c::svga_reset_bitblt(void)
   BX_CIRRUS_THIS bitblt.memdst_needed = 0;
 }
 
+// runs a video-to-video BLT or solid fill set up in bitblt.bitblt_ptr, or
+// hands it to the BLT thread. The BUSY bit stays set until it is finished.
+void bx_svga_cirrus_c::svga_blt_run(void)
+{
+  if (BX_CIRRUS_THIS blt_thread.started) {
+    // no direct CPU access to the video memory while the BLT is running
+    BX_CIRRUS_THIS lfb_revoke();
+    BX_CIRRUS_THIS blt_thread.posted = 1;
+    BX_LOCK(BX_CIRRUS_THIS blt_thread.lock);
+    BX_CIRRUS_THIS blt_thread.state = CIRRUS_BLT_THREAD_RUN;
+    BX_COND_SIGNAL(BX_CIRRUS_THIS blt_thread.cond);
+    BX_UNLOCK(BX_CIRRUS_THIS blt_thread.lock);
+    return;
+  }
+  (*BX_CIRRUS_THIS bitblt.bitblt_ptr)();
+  svga_blt_done();
+}
+
+void bx_svga_cirrus_c::svga_blt_done(void)
+{
+  svga_reset_bitblt();
+  BX_CIRRUS_THIS redraw_area(BX_CIRRUS_THIS redraw.x, BX_CIRRUS_THIS redraw.y,
+                             BX_CIRRUS_THIS redraw.w, BX_CIRRUS_THIS redraw.h);
+}
+
+// completes a BLT posted to the BLT thread. Returns 0 if it is still
+// running and wait is not set.
+bx_bool bx_svga_cirrus_c::svga_blt_finish(bx_bool wait)
+{
+  if (!BX_CIRRUS_THIS blt_thread.posted) return 1;
+  BX_LOCK(BX_CIRRUS_THIS blt_thread.lock);
+  while (BX_CIRRUS_THIS blt_thread.state == CIRRUS_BLT_THREAD_RUN) {
+    if (!wait) {
+      BX_UNLOCK(BX_CIRRUS_THIS blt_thread.lock);
+      return 0;
+    }
+    BX_COND_WAIT(BX_CIRRUS_THIS blt_thread.done, BX_CIRRUS_THIS blt_thread.lock);
+  }
+  BX_CIRRUS_THIS blt_thread.state = CIRRUS_BLT_THREAD_IDLE;
+  BX_UNLOCK(BX_CIRRUS_THIS blt_thread.lock);
+  BX_CIRRUS_THIS blt_thread.posted = 0;
+  svga_blt_done();
+  return 1;
+}
+
+void bx_svga_cirrus_c::svga_blt_thread_start(void)
+{
+  BX_CIRRUS_THIS blt_thread.state = CIRRUS_BLT_THREAD_IDLE;
+  BX_CIRRUS_THIS blt_thread.quit = 0;
+  BX_INIT_MUTEX(BX_CIRRUS_THIS blt_thread.lock);
+  BX_INIT_COND(BX_CIRRUS_THIS blt_thread.cond);
+  BX_INIT_COND(BX_CIRRUS_THIS blt_thread.done);
+  BX_CIRRUS_THIS blt_thread.started = BX_THREAD_CREATE(svga_blt_thread, BX_CIRRUS_THIS_PTR,
+                                                       BX_CIRRUS_THIS blt_thread.tid);
+  if (BX_CIRRUS_THIS blt_thread.started) {
+    BX_INFO(("using BitBLT thread"));
+  } else {
+    BX_ERROR(("cannot create BitBLT thread"));
+  }
+}
+
+void bx_svga_cirrus_c::svga_blt_thread_stop(void)
+{
+  if (BX_CIRRUS_THIS blt_thread.started) {
+    BX_LOCK(BX_CIRRUS_THIS blt_thread.lock);
+    BX_CIRRUS_THIS blt_thread.quit = 1;
+    BX_COND_SIGNAL(BX_CIRRUS_THIS blt_thread.cond);
+    BX_UNLOCK(BX_CIRRUS_THIS blt_thread.lock);
+    BX_THREAD_JOIN(BX_CIRRUS_THIS blt_thread.tid);
+    BX_FINI_COND(BX_CIRRUS_THIS blt_thread.done);
+    BX_FINI_COND(BX_CIRRUS_THIS blt_thread.cond);
+    BX_FINI_MUTEX(BX_CIRRUS_THIS blt_thread.lock);
+    BX_CIRRUS_THIS blt_thread.started = 0;
+    BX_CIRRUS_THIS blt_thread.posted = 0;
+  }
+}
+
+BX_THREAD_FUNC(bx_svga_cirrus_c::svga_blt_thread, indata)
+{
+  ((bx_svga_cirrus_c *) indata)->svga_blt_loop();
+  BX_THREAD_EXIT;
+}
+
+void bx_svga_cirrus_c::svga_blt_loop(void)
+{
+  BX_LOCK(BX_CIRRUS_THIS blt_thread.lock);
+  while (!BX_CIRRUS_THIS blt_thread.quit) {
+    if (BX_CIRRUS_THIS blt_thread.state != CIRRUS_BLT_THREAD_RUN) {
+      BX_COND_WAIT(BX_CIRRUS_THIS blt_thread.cond, BX_CIRRUS_THIS blt_thread.lock);
+      continue;
+    }
+    BX_UNLOCK(BX_CIRRUS_THIS blt_thread.lock);
+    (*BX_CIRRUS_THIS bitblt.bitblt_ptr)();
+    BX_LOCK(BX_CIRRUS_THIS blt_thread.lock);
+    BX_CIRRUS_THIS blt_thread.state = CIRRUS_BLT_THREAD_DONE;
+    BX_COND_SIGNAL(BX_CIRRUS_THIS blt_thread.done);
+  }
+  BX_UNLOCK(BX_CIRRUS_THIS blt_thread.lock);
+}
+
 void bx_svga_cirrus_c::svga_bitblt()
 {
   Bit16u tmp16;
@@ -2606,7 +2814,10 @@ void bx_svga_cirrus_c::svga_bitblt()
       (CIRRUS_BLTMODE_PATTERNCOPY | CIRRUS_BLTMODE_COLOREXPAND)) {
     BX_CIRRUS_THIS bitblt.rop_handler = svga_get_fwd_rop_handler(BX_CIRRUS_THIS bitblt.bltrop);
     BX_CIRRUS_THIS bitblt.dst = BX_CIRRUS_THIS s.memory + dstaddr;
-    svga_solidfill();
+    BX_CIRRUS_THIS bitblt.bitblt_ptr = svga_solidfill_static;
+    BX_DEBUG(("BLT: SOLIDFILL"));
+    svga_blt_run();
+    return;
   } else {
 
     if (BX_CIRRUS_THIS bitblt.bltmode & CIRRUS_BLTMODE_BACKWARDS) {
@@ -2680,6 +2891,8 @@ void bx_svga_cirrus_c::svga_setup_bitblt_cputovideo(Bit32u dstaddr,Bit32u srcadd
         BX_CIRRUS_THIS bitblt.srcpitch * BX_CIRRUS_THIS bitblt.bltheight;
   }
   BX_CIRRUS_THIS bitblt.memsrc_endptr += BX_CIRRUS_THIS bitblt.srcpitch;
+  // the source data is written to the LFB
+  BX_CIRRUS_THIS lfb_revoke();
 }
 
 void bx_svga_cirrus_c::svga_setup_bitblt_videotocpu(Bit32u dstaddr,Bit32u srcaddr)
@@ -2713,23 +2926,33 @@ void bx_svga_cirrus_c::svga_setup_bitblt_videotovideo(Bit32u dstaddr,Bit32u srca
   BX_CIRRUS_THIS bitblt.dst = BX_CIRRUS_THIS s.memory + dstaddr;
 
   if (BX_CIRRUS_THIS bitblt.bltmode & CIRRUS_BLTMODE_PATTERNCOPY) {
+    if (!cirrus_bltmode_supported(BX_CIRRUS_THIS bitblt.bltmode, 1)) {
+      BX_ERROR(("PATTERNCOPY: unknown bltmode %02x",BX_CIRRUS_THIS bitblt.bltmode));
+      svga_reset_bitblt();
+      return;
+    }
+    BX_DEBUG(("svga_cirrus: PATTERN COPY%s",
+      (BX_CIRRUS_THIS bitblt.bltmode & CIRRUS_BLTMODE_COLOREXPAND) ? ", COLOR EXPAND" : ""));
     BX_CIRRUS_THIS bitblt.bitblt_ptr = svga_patterncopy_static;
     BX_CIRRUS_THIS bitblt.src = BX_CIRRUS_THIS s.memory + (srcaddr & ~0x07);
   } else {
+    if (!cirrus_bltmode_supported(BX_CIRRUS_THIS bitblt.bltmode, 0)) {
+      BX_ERROR(("SIMPLE BLT: unknown bltmode %02x",BX_CIRRUS_THIS bitblt.bltmode));
+      svga_reset_bitblt();
+      return;
+    }
+    BX_DEBUG(("svga_cirrus: BITBLT%s",
+      (BX_CIRRUS_THIS bitblt.bltmode & CIRRUS_BLTMODE_COLOREXPAND) ? ", COLOR EXPAND" : ""));
     BX_CIRRUS_THIS bitblt.bitblt_ptr = svga_simplebitblt_static;
     BX_CIRRUS_THIS bitblt.src = BX_CIRRUS_THIS s.memory + srcaddr;
   }
 
-  (*BX_CIRRUS_THIS bitblt.bitblt_ptr)();
-  svga_reset_bitblt();
-  BX_CIRRUS_THIS redraw_area(BX_CIRRUS_THIS redraw.x, BX_CIRRUS_THIS redraw.y,
-                             BX_CIRRUS_THIS redraw.w, BX_CIRRUS_THIS redraw.h);
+  svga_blt_run();
 }
 
+// may run on the BLT thread: no logging here
 void bx_svga_cirrus_c::svga_colorexpand(Bit8u *dst,const Bit8u *src,int count,int pixelwidth)
 {
-  BX_DEBUG(("svga_cirrus: COLOR EXPAND"));
-
   switch (pixelwidth) {
     case 1:
       svga_colorexpand_8(dst,src,count);
@@ -2740,12 +2963,9 @@ void bx_svga_cirrus_c::svga_colorexpand(Bit8u *dst,const Bit8u *src,int count,in
     case 3:
       svga_colorexpand_24(dst,src,count);
       break;
-    case 4:
+    default: // the pixel width is checked in svga_bitblt()
       svga_colorexpand_32(dst,src,count);
       break;
-    default:
-      BX_PANIC(("COLOREXPAND: unknown pixelwidth %u",(unsigned)pixelwidth));
-      break;
   }
 }
 
@@ -2917,13 +3137,13 @@ void bx_svga_cirrus_c::svga_patterncopy()
 {
   Bit8u color[4];
   Bit8u work_colorexp[256];
-  Bit8u *src, *dst;
+  Bit8u *src, *dst, *dst_end;
   Bit8u *dstc, *srcc, *src2;
-  int x, y, pattern_x, pattern_y, srcskipleft;
+  int x, y, pw, rowbytes, pattern_x, pattern_y, srcskipleft;
   int patternbytes = 8 * BX_CIRRUS_THIS bitblt.pixelwidth;
   int pattern_pitch = patternbytes;
   int bltbytes = BX_CIRRUS_THIS bitblt.bltwidth;
-  unsigned bits, bits_xor, bitmask;
+  unsigned bits_xor;
 
   if (BX_CIRRUS_THIS bitblt.pixelwidth == 3) {
     pattern_x = BX_CIRRUS_THIS control.reg[0x2f] & 0x1f;
@@ -2946,26 +3166,16 @@ void bx_svga_cirrus_c::svga_patterncopy()
 
       pattern_y = BX_CIRRUS_THIS bitblt.srcaddr & 0x07;
       for (y = 0; y < BX_CIRRUS_THIS bitblt.bltheight; y++) {
-        dst = BX_CIRRUS_THIS bitblt.dst + pattern_x;
-        bitmask = 0x80 >> srcskipleft;
-        bits = BX_CIRRUS_THIS bitblt.src[pattern_y] ^ bits_xor;
-        for (x = pattern_x; x < BX_CIRRUS_THIS bitblt.bltwidth; x+=BX_CIRRUS_THIS bitblt.pixelwidth) {
-          if ((bitmask & 0xff) == 0) {
-            bitmask = 0x80;
-            bits = BX_CIRRUS_THIS bitblt.src[pattern_y] ^ bits_xor;
-          }
-          if (bits & bitmask) {
-            (*BX_CIRRUS_THIS bitblt.rop_handler)(
-              dst, &color[0], 0, 0, BX_CIRRUS_THIS bitblt.pixelwidth, 1);
-          }
-          dst += BX_CIRRUS_THIS bitblt.pixelwidth;
-          bitmask >>= 1;
-        }
+        svga_colorexpand_transp_line(BX_CIRRUS_THIS bitblt.dst + pattern_x,
+          &BX_CIRRUS_THIS bitblt.src[pattern_y], 0, pattern_x, srcskipleft,
+          bits_xor, color);
         pattern_y = (pattern_y + 1) & 7;
         BX_CIRRUS_THIS bitblt.dst += BX_CIRRUS_THIS bitblt.dstpitch;
       }
       return;
     } else {
+      // an unaligned 24 bpp pattern reads past the last expanded pixel
+      memset(work_colorexp, 0, sizeof(work_colorexp));
       svga_colorexpand(work_colorexp,BX_CIRRUS_THIS bitblt.src,8*8,BX_CIRRUS_THIS bitblt.pixelwidth);
       BX_CIRRUS_THIS bitblt.src = work_colorexp;
       BX_CIRRUS_THIS bitblt.bltmode &= ~CIRRUS_BLTMODE_COLOREXPAND;
@@ -2976,22 +3186,44 @@ void bx_svga_cirrus_c::svga_patterncopy()
     }
   }
   if (BX_CIRRUS_THIS bitblt.bltmode & ~CIRRUS_BLTMODE_PATTERNCOPY) {
-    BX_ERROR(("PATTERNCOPY: unknown bltmode %02x",BX_CIRRUS_THIS bitblt.bltmode));
+    // rejected by the caller
     return;
   }
 
-  BX_DEBUG(("svga_cirrus: PATTERN COPY"));
   dst = BX_CIRRUS_THIS bitblt.dst;
   pattern_y = BX_CIRRUS_THIS bitblt.srcaddr & 0x07;
   src = (Bit8u *)BX_CIRRUS_THIS bitblt.src;
+  pw = BX_CIRRUS_THIS bitblt.pixelwidth;
+  // Unless the destination overwrites the pattern itself, the pattern lines
+  // are unrolled to the width of the blt once and applied a line at a time.
+  dst_end = dst + (BX_CIRRUS_THIS bitblt.bltheight - 1) * BX_CIRRUS_THIS bitblt.dstpitch + bltbytes + pw;
+  if ((dst_end <= src) || (dst >= (src + 8 * pattern_pitch))) {
+    rowbytes = 0;
+    if (pattern_x < bltbytes) {
+      rowbytes = ((bltbytes - pattern_x + pw - 1) / pw) * pw;
+    }
+    for (y = 0; (y < 8) && (y < BX_CIRRUS_THIS bitblt.bltheight); y++) {
+      srcc = src + ((pattern_y + y) & 7) * pattern_pitch;
+      dstc = BX_CIRRUS_THIS bitblt.pattern[y];
+      for (x = pattern_x; x < bltbytes; x += pw) {
+        memcpy(dstc, srcc + (x % patternbytes), pw);
+        dstc += pw;
+      }
+    }
+    for (y = 0; y < BX_CIRRUS_THIS bitblt.bltheight; y++) {
+      (*BX_CIRRUS_THIS bitblt.rop_handler)(
+        dst + pattern_x, BX_CIRRUS_THIS bitblt.pattern[y & 7], 0, 0, rowbytes, 1);
+      dst += BX_CIRRUS_THIS bitblt.dstpitch;
+    }
+    return;
+  }
   for (y = 0; y < BX_CIRRUS_THIS bitblt.bltheight; y++) {
     srcc = src + pattern_y * pattern_pitch;
     dstc = dst + pattern_x;
-    for (x = pattern_x; x < bltbytes; x += BX_CIRRUS_THIS bitblt.pixelwidth) {
+    for (x = pattern_x; x < bltbytes; x += pw) {
       src2 = srcc + (x % patternbytes);
-      (*BX_CIRRUS_THIS bitblt.rop_handler)(
-        dstc, src2, 0, 0, BX_CIRRUS_THIS bitblt.pixelwidth, 1);
-      dstc += BX_CIRRUS_THIS bitblt.pixelwidth;
+      (*BX_CIRRUS_THIS bitblt.rop_handler)(dstc, src2, 0, 0, pw, 1);
+      dstc += pw;
     }
     pattern_y = (pattern_y + 1) & 7;
     dst += BX_CIRRUS_THIS bitblt.dstpitch;
@@ -3001,10 +3233,10 @@ void bx_svga_cirrus_c::svga_patterncopy()
 void bx_svga_cirrus_c::svga_simplebitblt()
 {
   Bit8u color[4];
-  Bit8u work_colorexp[2048];
-  Bit16u w, x, y;
+  Bit8u work_colorexp[CIRRUS_BLT_MAXWIDTH];
+  Bit16u w, y;
   Bit8u *dst;
-  unsigned bits, bits_xor, bitmask;
+  unsigned bits_xor;
   int pattern_x, srcskipleft;
 
   if (BX_CIRRUS_THIS bitblt.pixelwidth == 3) {
@@ -3027,26 +3259,16 @@ void bx_svga_cirrus_c::svga_simplebitblt()
       }
 
       for (y = 0; y < BX_CIRRUS_THIS bitblt.bltheight; y++) {
-        dst = BX_CIRRUS_THIS bitblt.dst + pattern_x;
-        bitmask = 0x80 >> srcskipleft;
-        bits = *BX_CIRRUS_THIS bitblt.src++ ^ bits_xor;
-        for (x = pattern_x; x < BX_CIRRUS_THIS bitblt.bltwidth; x+=BX_CIRRUS_THIS bitblt.pixelwidth) {
-          if ((bitmask & 0xff) == 0) {
-            bitmask = 0x80;
-            bits = *BX_CIRRUS_THIS bitblt.src++ ^ bits_xor;
-          }
-          if (bits & bitmask) {
-            (*BX_CIRRUS_THIS bitblt.rop_handler)(
-              dst, &color[0], 0, 0, BX_CIRRUS_THIS bitblt.pixelwidth, 1);
-          }
-          dst += BX_CIRRUS_THIS bitblt.pixelwidth;
-          bitmask >>= 1;
-        }
+        BX_CIRRUS_THIS bitblt.src = svga_colorexpand_transp_line(
+          BX_CIRRUS_THIS bitblt.dst + pattern_x, BX_CIRRUS_THIS bitblt.src, 1,
+          pattern_x, srcskipleft, bits_xor, color);
         BX_CIRRUS_THIS bitblt.dst += BX_CIRRUS_THIS bitblt.dstpitch;
       }
       return;
     } else {
       w = BX_CIRRUS_THIS bitblt.bltwidth / BX_CIRRUS_THIS bitblt.pixelwidth;
+      // bytes of a partial last pixel are not expanded
+      memset(work_colorexp + w * BX_CIRRUS_THIS bitblt.pixelwidth, 0, BX_CIRRUS_THIS bitblt.pixelwidth);
       for (y = 0; y < BX_CIRRUS_THIS bitblt.bltheight; y++) {
         svga_colorexpand(work_colorexp,BX_CIRRUS_THIS bitblt.src, w,
                          BX_CIRRUS_THIS bitblt.pixelwidth);
@@ -3061,11 +3283,10 @@ void bx_svga_cirrus_c::svga_simplebitblt()
     }
   }
   if (BX_CIRRUS_THIS bitblt.bltmode & ~CIRRUS_BLTMODE_BACKWARDS) {
-    BX_ERROR(("SIMPLE BLT: unknown bltmode %02x",BX_CIRRUS_THIS bitblt.bltmode));
+    // rejected in svga_setup_bitblt_videotovideo()
     return;
   }
 
-  BX_DEBUG(("svga_cirrus: BITBLT"));
   (*BX_CIRRUS_THIS bitblt.rop_handler)(
     BX_CIRRUS_THIS bitblt.dst, BX_CIRRUS_THIS bitblt.src,
     BX_CIRRUS_THIS bitblt.dstpitch, BX_CIRRUS_THIS bitblt.srcpitch,
@@ -3074,34 +3295,29 @@ void bx_svga_cirrus_c::svga_simplebitblt()
 
 void bx_svga_cirrus_c::svga_solidfill()
 {
-  Bit8u color[4];
-  int x, y;
-  Bit8u *dst;
-
-  BX_DEBUG(("BLT: SOLIDFILL"));
+  int x, pw = BX_CIRRUS_THIS bitblt.pixelwidth;
+  int rowbytes = ((BX_CIRRUS_THIS bitblt.bltwidth + pw - 1) / pw) * pw;
+  Bit8u *row = BX_CIRRUS_THIS bitblt.pattern[0];
 
-  color[0] = BX_CIRRUS_THIS control.shadow_reg1;
-  color[1] = BX_CIRRUS_THIS control.reg[0x11];
-  color[2] = BX_CIRRUS_THIS control.reg[0x13];
-  color[3] = BX_CIRRUS_THIS control.reg[0x15];
-
-  for (y = 0; y < BX_CIRRUS_THIS bitblt.bltheight; y++) {
-    dst = BX_CIRRUS_THIS bitblt.dst;
-    for (x = 0; x < BX_CIRRUS_THIS bitblt.bltwidth; x+=BX_CIRRUS_THIS bitblt.pixelwidth) {
-      (*BX_CIRRUS_THIS bitblt.rop_handler)(
-        dst, &color[0], 0, 0, BX_CIRRUS_THIS bitblt.pixelwidth, 1);
-        dst += BX_CIRRUS_THIS bitblt.pixelwidth;
-    }
-    BX_CIRRUS_THIS bitblt.dst += BX_CIRRUS_THIS bitblt.dstpitch;
+  row[0] = BX_CIRRUS_THIS control.shadow_reg1;
+  row[1] = BX_CIRRUS_THIS control.reg[0x11];
+  row[2] = BX_CIRRUS_THIS control.reg[0x13];
+  row[3] = BX_CIRRUS_THIS control.reg[0x15];
+  for (x = pw; x < rowbytes; x++) {
+    row[x] = row[x - pw];
   }
-  BX_CIRRUS_THIS redraw_area(BX_CIRRUS_THIS redraw.x, BX_CIRRUS_THIS redraw.y,
-                             BX_CIRRUS_THIS redraw.w, BX_CIRRUS_THIS redraw.h);
+  (*BX_CIRRUS_THIS bitblt.rop_handler)(
+    BX_CIRRUS_THIS bitblt.dst, row, BX_CIRRUS_THIS bitblt.dstpitch, 0,
+    rowbytes, BX_CIRRUS_THIS bitblt.bltheight);
 }
 
 void bx_svga_cirrus_c::svga_patterncopy_memsrc()
 {
   BX_INFO(("svga_patterncopy_memsrc() - not tested"));
 
+  if (!cirrus_bltmode_supported(BX_CIRRUS_THIS bitblt.bltmode, 1)) {
+    BX_ERROR(("PATTERNCOPY: unknown bltmode %02x",BX_CIRRUS_THIS bitblt.bltmode));
+  }
   BX_CIRRUS_THIS bitblt.src = &BX_CIRRUS_THIS bitblt.memsrc[0];
   svga_patterncopy();
   BX_CIRRUS_THIS bitblt.memsrc_needed = 0;
@@ -3112,7 +3328,7 @@ void bx_svga_cirrus_c::svga_patterncopy_memsrc()
 void bx_svga_cirrus_c::svga_simplebitblt_memsrc()
 {
   Bit8u *srcptr = &BX_CIRRUS_THIS bitblt.memsrc[0];
-  Bit8u work_colorexp[2048];
+  Bit8u work_colorexp[CIRRUS_BLT_MAXWIDTH];
   Bit16u w;
   int pattern_x;
 
@@ -3130,6 +3346,7 @@ void bx_svga_cirrus_c::svga_simplebitblt_memsrc()
     }
 
     w = BX_CIRRUS_THIS bitblt.bltwidth / BX_CIRRUS_THIS bitblt.pixelwidth;
+    memset(work_colorexp + w * BX_CIRRUS_THIS bitblt.pixelwidth, 0, BX_CIRRUS_THIS bitblt.pixelwidth);
     svga_colorexpand(work_colorexp,srcptr,w,BX_CIRRUS_THIS bitblt.pixelwidth);
     (*BX_CIRRUS_THIS bitblt.rop_handler)(
         BX_CIRRUS_THIS bitblt.dst + pattern_x, work_colorexp + pattern_x, 0, 0,
@@ -3149,9 +3366,8 @@ void bx_svga_cirrus_c::svga_colorexpand_transp_memsrc()
 {
   Bit8u *src = &BX_CIRRUS_THIS bitblt.memsrc[0];
   Bit8u color[4];
-  int x, pattern_x, srcskipleft;
-  Bit8u *dst;
-  unsigned bits, bits_xor, bitmask;
+  int pattern_x, srcskipleft;
+  unsigned bits_xor;
 
   BX_DEBUG(("BLT, cpu-to-video, transparent"));
 
@@ -3172,21 +3388,52 @@ void bx_svga_cirrus_c::svga_colorexpand_transp_memsrc()
     bits_xor = 0x00;
   }
 
-  dst = BX_CIRRUS_THIS bitblt.dst + pattern_x;
+  svga_colorexpand_transp_line(BX_CIRRUS_THIS bitblt.dst + pattern_x, src, 1,
+                               pattern_x, srcskipleft, bits_xor, color);
+}
+
+// draws one line of a transparent color expansion: only the pixels with a
+// set source bit are written. The source pointer is advanced by srcinc for
+// each byte of bits consumed and returned.
+const Bit8u *bx_svga_cirrus_c::svga_colorexpand_transp_line(Bit8u *dst, const Bit8u *src,
+  int srcinc, int pattern_x, int srcskipleft, unsigned bits_xor, const Bit8u *color)
+{
+  int x, pw = BX_CIRRUS_THIS bitblt.pixelwidth;
+  bx_bool ropsrc = (BX_CIRRUS_THIS bitblt.bltrop == CIRRUS_ROP_SRC);
+  unsigned bits, bitmask;
+
   bitmask = 0x80 >> srcskipleft;
-  bits = *src++ ^ bits_xor;
-  for (x = pattern_x; x < BX_CIRRUS_THIS bitblt.bltwidth; x+=BX_CIRRUS_THIS bitblt.pixelwidth) {
+  bits = *src ^ bits_xor;
+  src += srcinc;
+  for (x = pattern_x; x < BX_CIRRUS_THIS bitblt.bltwidth; x += pw) {
     if ((bitmask & 0xff) == 0) {
       bitmask = 0x80;
-      bits = *src++ ^ bits_xor;
+      bits = *src ^ bits_xor;
+      src += srcinc;
     }
     if (bits & bitmask) {
-      (*BX_CIRRUS_THIS bitblt.rop_handler)(
-          dst, &color[0], 0, 0, BX_CIRRUS_THIS bitblt.pixelwidth, 1);
+      if (ropsrc) {
+        switch (pw) {
+          case 1:
+            dst[0] = color[0];
+            break;
+          case 2:
+            memcpy(dst, color, 2);
+            break;
+          case 3:
+            memcpy(dst, color, 3);
+            break;
+          default:
+            memcpy(dst, color, 4);
+        }
+      } else {
+        (*BX_CIRRUS_THIS bitblt.rop_handler)(dst, color, 0, 0, pw, 1);
+      }
     }
-    dst += BX_CIRRUS_THIS bitblt.pixelwidth;
+    dst += pw;
     bitmask >>= 1;
   }
+  return src;
 }
 
   bx_bool // 1 if finished, 0 otherwise
@@ -3243,6 +3490,16 @@ cleanup:
 //
 /////////////////////////////////////////////////////////////////////////
 
+// The raster operations combine the source (s) and destination (d) of a
+// row in chunks of the vector type, unless the destination overlaps the
+// part of the source row that has not been read yet. The remaining bytes
+// are done one at a time.
+#if defined(__GNUC__)
+typedef Bit64u bx_rop_vec_t __attribute__((vector_size(16)));
+#else
+typedef Bit64u bx_rop_vec_t;
+#endif
+
 #define IMPLEMENT_FORWARD_BITBLT(name,opline) \
   static void bitblt_rop_fwd_##name( \
     Bit8u *dst,const Bit8u *src, \
@@ -3250,13 +3507,22 @@ cleanup:
     int bltwidth,int bltheight) \
   { \
     int x,y; \
-    dstpitch -= bltwidth; \
-    srcpitch -= bltwidth; \
     for (y = 0; y < bltheight; y++) { \
-      for (x = 0; x < bltwidth; x++) { \
+      x = 0; \
+      if ((dst <= src) || (dst >= (src + bltwidth))) { \
+        for (; (x + (int)sizeof(bx_rop_vec_t)) <= bltwidth; x += sizeof(bx_rop_vec_t)) { \
+          bx_rop_vec_t s, d; \
+          memcpy(&s, src + x, sizeof(s)); \
+          memcpy(&d, dst + x, sizeof(d)); \
+          opline; \
+          memcpy(dst + x, &d, sizeof(d)); \
+        } \
+      } \
+      for (; x < bltwidth; x++) { \
+        Bit8u s = src[x], d = dst[x]; \
+        (void)s; \
         opline; \
-        dst++; \
-        src++; \
+        dst[x] = d; \
       } \
       dst += dstpitch; \
       src += srcpitch; \
@@ -3270,52 +3536,62 @@ cleanup:
     int bltwidth,int bltheight) \
   { \
     int x,y; \
-    dstpitch += bltwidth; \
-    srcpitch += bltwidth; \
+    const int vsize = sizeof(bx_rop_vec_t); \
     for (y = 0; y < bltheight; y++) { \
-      for (x = 0; x < bltwidth; x++) { \
+      x = 0; \
+      if ((dst >= src) || ((dst + bltwidth) <= src)) { \
+        for (; (x + vsize) <= bltwidth; x += vsize) { \
+          bx_rop_vec_t s, d; \
+          memcpy(&s, src - x - (vsize - 1), sizeof(s)); \
+          memcpy(&d, dst - x - (vsize - 1), sizeof(d)); \
+          opline; \
+          memcpy(dst - x - (vsize - 1), &d, sizeof(d)); \
+        } \
+      } \
+      for (; x < bltwidth; x++) { \
+        Bit8u s = *(src - x), d = *(dst - x); \
+        (void)s; \
         opline; \
-        dst--; \
-        src--; \
+        *(dst - x) = d; \
       } \
       dst += dstpitch; \
       src += srcpitch; \
     } \
   }
 
-IMPLEMENT_FORWARD_BITBLT(0, *dst = 0)
-IMPLEMENT_FORWARD_BITBLT(src_and_dst, *dst = (*src) & (*dst))
-IMPLEMENT_FORWARD_BITBLT(nop, (void)0)
-IMPLEMENT_FORWARD_BITBLT(src_and_notdst, *dst = (*src) & (~(*dst)))
-IMPLEMENT_FORWARD_BITBLT(notdst, *dst = ~(*dst))
-IMPLEMENT_FORWARD_BITBLT(src, *dst = *src)
-IMPLEMENT_FORWARD_BITBLT(1, *dst = 0xff)
-IMPLEMENT_FORWARD_BITBLT(notsrc_and_dst, *dst = (~(*src)) & (*dst))
-IMPLEMENT_FORWARD_BITBLT(src_xor_dst, *dst = (*src) ^ (*dst))
-IMPLEMENT_FORWARD_BITBLT(src_or_dst, *dst = (*src) | (*dst))
-IMPLEMENT_FORWARD_BITBLT(notsrc_or_notdst, *dst = (~(*src)) | (~(*dst)))
-IMPLEMENT_FORWARD_BITBLT(src_notxor_dst, *dst = ~((*src) ^ (*dst)))
-IMPLEMENT_FORWARD_BITBLT(src_or_notdst, *dst = (*src) | (~(*dst)))
-IMPLEMENT_FORWARD_BITBLT(notsrc, *dst = (~(*src)))
-IMPLEMENT_FORWARD_BITBLT(notsrc_or_dst, *dst = (~(*src)) | (*dst))
-IMPLEMENT_FORWARD_BITBLT(notsrc_and_notdst, *dst = (~(*src)) & (~(*dst)))
-
-IMPLEMENT_BACKWARD_BITBLT(0, *dst = 0)
-IMPLEMENT_BACKWARD_BITBLT(src_and_dst, *dst = (*src) & (*dst))
-IMPLEMENT_BACKWARD_BITBLT(nop, (void)0)
-IMPLEMENT_BACKWARD_BITBLT(src_and_notdst, *dst = (*src) & (~(*dst)))
-IMPLEMENT_BACKWARD_BITBLT(notdst, *dst = ~(*dst))
-IMPLEMENT_BACKWARD_BITBLT(src, *dst = *src)
-IMPLEMENT_BACKWARD_BITBLT(1, *dst = 0xff)
-IMPLEMENT_BACKWARD_BITBLT(notsrc_and_dst, *dst = (~(*src)) & (*dst))
-IMPLEMENT_BACKWARD_BITBLT(src_xor_dst, *dst = (*src) ^ (*dst))
-IMPLEMENT_BACKWARD_BITBLT(src_or_dst, *dst = (*src) | (*dst))
-IMPLEMENT_BACKWARD_BITBLT(notsrc_or_notdst, *dst = (~(*src)) | (~(*dst)))
-IMPLEMENT_BACKWARD_BITBLT(src_notxor_dst, *dst = ~((*src) ^ (*dst)))
-IMPLEMENT_BACKWARD_BITBLT(src_or_notdst, *dst = (*src) | (~(*dst)))
-IMPLEMENT_BACKWARD_BITBLT(notsrc, *dst = (~(*src)))
-IMPLEMENT_BACKWARD_BITBLT(notsrc_or_dst, *dst = (~(*src)) | (*dst))
-IMPLEMENT_BACKWARD_BITBLT(notsrc_and_notdst, *dst = (~(*src)) & (~(*dst)))
+IMPLEMENT_FORWARD_BITBLT(0, d = d ^ d)
+IMPLEMENT_FORWARD_BITBLT(src_and_dst, d = s & d)
+IMPLEMENT_FORWARD_BITBLT(nop, (void)s)
+IMPLEMENT_FORWARD_BITBLT(src_and_notdst, d = s & ~d)
+IMPLEMENT_FORWARD_BITBLT(notdst, d = ~d)
+IMPLEMENT_FORWARD_BITBLT(src, d = s)
+IMPLEMENT_FORWARD_BITBLT(1, d = d | ~d)
+IMPLEMENT_FORWARD_BITBLT(notsrc_and_dst, d = ~s & d)
+IMPLEMENT_FORWARD_BITBLT(src_xor_dst, d = s ^ d)
+IMPLEMENT_FORWARD_BITBLT(src_or_dst, d = s | d)
+IMPLEMENT_FORWARD_BITBLT(notsrc_or_notdst, d = ~s | ~d)
+IMPLEMENT_FORWARD_BITBLT(src_notxor_dst, d = ~(s ^ d))
+IMPLEMENT_FORWARD_BITBLT(src_or_notdst, d = s | ~d)
+IMPLEMENT_FORWARD_BITBLT(notsrc, d = ~s)
+IMPLEMENT_FORWARD_BITBLT(notsrc_or_dst, d = ~s | d)
+IMPLEMENT_FORWARD_BITBLT(notsrc_and_notdst, d = ~s & ~d)
+
+IMPLEMENT_BACKWARD_BITBLT(0, d = d ^ d)
+IMPLEMENT_BACKWARD_BITBLT(src_and_dst, d = s & d)
+IMPLEMENT_BACKWARD_BITBLT(nop, (void)s)
+IMPLEMENT_BACKWARD_BITBLT(src_and_notdst, d = s & ~d)
+IMPLEMENT_BACKWARD_BITBLT(notdst, d = ~d)
+IMPLEMENT_BACKWARD_BITBLT(src, d = s)
+IMPLEMENT_BACKWARD_BITBLT(1, d = d | ~d)
+IMPLEMENT_BACKWARD_BITBLT(notsrc_and_dst, d = ~s & d)
+IMPLEMENT_BACKWARD_BITBLT(src_xor_dst, d = s ^ d)
+IMPLEMENT_BACKWARD_BITBLT(src_or_dst, d = s | d)
+IMPLEMENT_BACKWARD_BITBLT(notsrc_or_notdst, d = ~s | ~d)
+IMPLEMENT_BACKWARD_BITBLT(src_notxor_dst, d = ~(s ^ d))
+IMPLEMENT_BACKWARD_BITBLT(src_or_notdst, d = s | ~d)
+IMPLEMENT_BACKWARD_BITBLT(notsrc, d = ~s)
+IMPLEMENT_BACKWARD_BITBLT(notsrc_or_dst, d = ~s | d)
+IMPLEMENT_BACKWARD_BITBLT(notsrc_and_notdst, d = ~s & ~d)
 
 bx_cirrus_bitblt_rop_t bx_svga_cirrus_c::svga_get_fwd_rop_handler(Bit8u rop)
 {
@@ -3444,6 +3720,14 @@ bx_cirrus_bitblt_rop_t bx_svga_cirrus_c::svga_get_bkwd_rop_handler(Bit8u rop)
 #if BX_DEBUGGER
 void bx_svga_cirrus_c::debug_dump(int argc, char **argv)
 {
+  if ((argc == 1) && !strcmp(argv[0], "text")) {
+    if ((BX_CIRRUS_THIS sequencer.reg[0x07] & 0x01) == CIRRUS_SR7_BPP_SVGA) {
+      dbg_printf("not in text mode\n");
+    } else {
+      bx_vgacore_c::debug_dump_text();
+    }
+    return;
+  }
   if ((BX_CIRRUS_THIS sequencer.reg[0x07] & 0x01) == CIRRUS_SR7_BPP_SVGA) {
 #if BX_SUPPORT_PCI
     if (BX_CIRRUS_THIS pci_enabled)
@@ -46,6 +46,7 @@
 
 // Size of internal cache memory for bitblt. (must be >= 256 and 4-byte aligned)
 #define CIRRUS_BLT_CACHESIZE (2048 * 4)
+#define CIRRUS_BLT_MAXWIDTH (0x2000 + 4)
 
 #if BX_SUPPORT_PCI
 #define CIRRUS_VIDEO_MEMORY_MB    4
@@ -172,8 +173,17 @@ private:
   BX_CIRRUS_SMF void svga_patterncopy_memsrc();
   BX_CIRRUS_SMF void svga_simplebitblt_memsrc();
   BX_CIRRUS_SMF void svga_colorexpand_transp_memsrc();
+  BX_CIRRUS_SMF const Bit8u *svga_colorexpand_transp_line(Bit8u *dst, const Bit8u *src,
+    int srcinc, int pattern_x, int srcskipleft, unsigned bits_xor, const Bit8u *color);
 
   BX_CIRRUS_SMF bx_bool svga_asyncbitblt_next();
+  BX_CIRRUS_SMF void svga_blt_run(void);
+  BX_CIRRUS_SMF void svga_blt_done(void);
+  BX_CIRRUS_SMF bx_bool svga_blt_finish(bx_bool wait);
+  BX_CIRRUS_SMF void svga_blt_thread_start(void);
+  BX_CIRRUS_SMF void svga_blt_thread_stop(void);
+  static BX_THREAD_FUNC(svga_blt_thread, indata);
+  BX_CIRRUS_SMF void svga_blt_loop(void);
   BX_CIRRUS_SMF bx_cirrus_bitblt_rop_t svga_get_fwd_rop_handler(Bit8u rop);
   BX_CIRRUS_SMF bx_cirrus_bitblt_rop_t svga_get_bkwd_rop_handler(Bit8u rop);
 
@@ -239,8 +249,22 @@ private:
     int memdst_needed;
     Bit8u memsrc[CIRRUS_BLT_CACHESIZE];
     Bit8u memdst[CIRRUS_BLT_CACHESIZE];
+    Bit8u pattern[8][CIRRUS_BLT_MAXWIDTH]; // pattern / fill lines
   } bitblt;
 
+  // BitBLT thread: runs the video-to-video BLTs and solid fills while the
+  // emulation continues
+  struct {
+    bx_bool started;
+    bx_bool posted;     // BLT handed to the thread, not yet completed
+    BX_THREAD_ID(tid);
+    BX_MUTEX(lock);
+    BX_COND(cond);
+    BX_COND(done);
+    Bit8u   state;      // CIRRUS_BLT_THREAD_xxx
+    bx_bool quit;
+  } blt_thread;
+
   struct {
     Bit16u x, y, size;
   } hw_cursor;
@@ -259,6 +283,7 @@ private:
 
   BX_CIRRUS_SMF bx_bool cirrus_mem_read_handler(bx_phy_address addr, unsigned len, void *data, void *param);
   BX_CIRRUS_SMF bx_bool cirrus_mem_write_handler(bx_phy_address addr, unsigned len, void *data, void *param);
+  BX_CIRRUS_SMF Bit8u *cirrus_mem_da_handler(bx_phy_address addr, unsigned rw, void *param);
 #endif
 };
 
@@ -35,6 +35,7 @@
 #define BX_PLUGGABLE
 
 #include "iodev.h"
+#include "gui/pixconv.h"
 #include "vgacore.h"
 #include "vga.h"
 #include "virt_timer.h"
@@ -108,12 +109,12 @@ void bx_vga_c::init_vga_extension(void)
     }
     if (!BX_VGA_THIS pci_enabled) {
       BX_VGA_THIS vbe.base_address = VBE_DISPI_LFB_PHYSICAL_ADDRESS;
-      DEV_register_memory_handlers(theVga, mem_read_handler, mem_write_handler,
-                                   BX_VGA_THIS vbe.base_address,
+      DEV_register_memory_handlers_da(theVga, mem_read_handler, mem_write_handler,
+                                      mem_da_handler, BX_VGA_THIS vbe.base_address,
                                    BX_VGA_THIS vbe.base_address + VBE_DISPI_TOTAL_VIDEO_MEMORY_BYTES - 1);
     }
     if (BX_VGA_THIS s.memory == NULL)
-      BX_VGA_THIS s.memory = new Bit8u[VBE_DISPI_TOTAL_VIDEO_MEMORY_BYTES];
+      BX_VGA_THIS alloc_memory(VBE_DISPI_TOTAL_VIDEO_MEMORY_BYTES);
     memset(BX_VGA_THIS s.memory, 0, VBE_DISPI_TOTAL_VIDEO_MEMORY_BYTES);
     BX_VGA_THIS s.memsize = VBE_DISPI_TOTAL_VIDEO_MEMORY_BYTES;
     BX_VGA_THIS vbe.cur_dispi=VBE_DISPI_ID0;
@@ -392,6 +393,11 @@ void bx_vga_c::update(void)
   unsigned iHeight, iWidth;
 
   if (BX_VGA_THIS vbe.enabled) {
+    if (BX_VGA_THIS vbe.bpp != VBE_DISPI_BPP_4) {
+      BX_VGA_THIS lfb_dirty_scan(BX_VGA_THIS vbe.virtual_start, BX_VGA_THIS s.line_offset,
+                                 BX_VGA_THIS vbe.bpp_multiplier, BX_VGA_THIS vbe.xres,
+                                 BX_VGA_THIS vbe.yres);
+    }
     /* no screen update necessary */
     if ((BX_VGA_THIS s.vga_mem_updated==0) && BX_VGA_THIS s.graphics_ctrl.graphics_alpha)
       return;
@@ -417,6 +423,9 @@ void bx_vga_c::update(void)
       Bit8u * vid_ptr, * vid_ptr2;
       Bit8u * tile_ptr, * tile_ptr2;
       bx_svga_tileinfo_t info;
+      Bit32u lut[256];
+      bx_pixconv_rgb16_t fmt;
+      bx_bool pixconv;
       Bit8u dac_size = BX_VGA_THIS vbe.dac_8bit ? 8 : 6;
 
       iWidth=BX_VGA_THIS vbe.xres;
@@ -479,32 +488,46 @@ void bx_vga_c::update(void)
               break;
           }
         } else {
+          // the common 32 bpp host formats use the row conversion kernels
+          pixconv = (info.bpp == 32) && info.is_little_endian;
           switch (BX_VGA_THIS vbe.bpp) {
             case 4:
               BX_ERROR(("cannot draw 4bpp SVGA"));
               break;
             case 8:
+              if (pixconv) {
+                for (i=0; i<256; i++) {
+                  lut[i] = MAKE_COLOUR(
+                    BX_VGA_THIS s.pel.data[i].red, dac_size, info.red_shift, info.red_mask,
+                    BX_VGA_THIS s.pel.data[i].green, dac_size, info.green_shift, info.green_mask,
+                    BX_VGA_THIS s.pel.data[i].blue, dac_size, info.blue_shift, info.blue_mask);
+                }
+              }
               for (yc=0, yti = 0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
                 for (xc=0, xti = 0; xc<iWidth; xc+=X_TILESIZE, xti++) {
                   if (GET_TILE_UPDATED (xti, yti)) {
                     vid_ptr = disp_ptr + (yc * pitch + xc);
                     tile_ptr = bx_gui->graphics_tile_get(xc, yc, &w, &h);
                     for (r=0; r<h; r++) {
-                      vid_ptr2  = vid_ptr;
-                      tile_ptr2 = tile_ptr;
-                      for (c=0; c<w; c++) {
-                        colour = *(vid_ptr2++);
-                        colour = MAKE_COLOUR(
-                          BX_VGA_THIS s.pel.data[colour].red, dac_size, info.red_shift, info.red_mask,
-                          BX_VGA_THIS s.pel.data[colour].green, dac_size, info.green_shift, info.green_mask,
-                          BX_VGA_THIS s.pel.data[colour].blue, dac_size, info.blue_shift, info.blue_mask);
-                        if (info.is_little_endian) {
-                          for (i=0; i<info.bpp; i+=8) {
-                            *(tile_ptr2++) = (Bit8u)(colour >> i);
-                          }
-                        } else {
-                          for (i=info.bpp-8; i>-8; i-=8) {
-                            *(tile_ptr2++) = (Bit8u)(colour >> i);
+                      if (pixconv) {
+                        bx_pixconv.index8_to_32((Bit32u *)tile_ptr, vid_ptr, lut, w);
+                      } else {
+                        vid_ptr2  = vid_ptr;
+                        tile_ptr2 = tile_ptr;
+                        for (c=0; c<w; c++) {
+                          colour = *(vid_ptr2++);
+                          colour = MAKE_COLOUR(
+                            BX_VGA_THIS s.pel.data[colour].red, dac_size, info.red_shift, info.red_mask,
+                            BX_VGA_THIS s.pel.data[colour].green, dac_size, info.green_shift, info.green_mask,
+                            BX_VGA_THIS s.pel.data[colour].blue, dac_size, info.blue_shift, info.blue_mask);
+                          if (info.is_little_endian) {
+                            for (i=0; i<info.bpp; i+=8) {
+                              *(tile_ptr2++) = (Bit8u)(colour >> i);
+                            }
+                          } else {
+                            for (i=info.bpp-8; i>-8; i-=8) {
+                              *(tile_ptr2++) = (Bit8u)(colour >> i);
+                            }
                           }
                         }
                       }
@@ -518,28 +541,33 @@ void bx_vga_c::update(void)
               }
               break;
             case 15:
+              if (pixconv) bx_pixconv_rgb16_init(&fmt, 15, &info);
               for (yc=0, yti = 0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
                 for (xc=0, xti = 0; xc<iWidth; xc+=X_TILESIZE, xti++) {
                   if (GET_TILE_UPDATED (xti, yti)) {
                     vid_ptr = disp_ptr + (yc * pitch + (xc<<1));
                     tile_ptr = bx_gui->graphics_tile_get(xc, yc, &w, &h);
                     for (r=0; r<h; r++) {
-                      vid_ptr2  = vid_ptr;
-                      tile_ptr2 = tile_ptr;
-                      for (c=0; c<w; c++) {
-                        colour = *(vid_ptr2++);
-                        colour |= *(vid_ptr2++) << 8;
-                        colour = MAKE_COLOUR(
-                          colour & 0x001f, 5, info.blue_shift, info.blue_mask,
-                          colour & 0x03e0, 10, info.green_shift, info.green_mask,
-                          colour & 0x7c00, 15, info.red_shift, info.red_mask);
-                        if (info.is_little_endian) {
-                          for (i=0; i<info.bpp; i+=8) {
-                            *(tile_ptr2++) = (Bit8u)(colour >> i);
-                          }
-                        } else {
-                          for (i=info.bpp-8; i>-8; i-=8) {
-                            *(tile_ptr2++) = (Bit8u)(colour >> i);
+                      if (pixconv) {
+                        bx_pixconv.rgb16_to_32((Bit32u *)tile_ptr, vid_ptr, w, &fmt);
+                      } else {
+                        vid_ptr2  = vid_ptr;
+                        tile_ptr2 = tile_ptr;
+                        for (c=0; c<w; c++) {
+                          colour = *(vid_ptr2++);
+                          colour |= *(vid_ptr2++) << 8;
+                          colour = MAKE_COLOUR(
+                            colour & 0x001f, 5, info.blue_shift, info.blue_mask,
+                            colour & 0x03e0, 10, info.green_shift, info.green_mask,
+                            colour & 0x7c00, 15, info.red_shift, info.red_mask);
+                          if (info.is_little_endian) {
+                            for (i=0; i<info.bpp; i+=8) {
+                              *(tile_ptr2++) = (Bit8u)(colour >> i);
+                            }
+                          } else {
+                            for (i=info.bpp-8; i>-8; i-=8) {
+                              *(tile_ptr2++) = (Bit8u)(colour >> i);
+                            }
                           }
                         }
                       }
@@ -553,28 +581,33 @@ void bx_vga_c::update(void)
               }
               break;
             case 16:
+              if (pixconv) bx_pixconv_rgb16_init(&fmt, 16, &info);
               for (yc=0, yti = 0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
                 for (xc=0, xti = 0; xc<iWidth; xc+=X_TILESIZE, xti++) {
                   if (GET_TILE_UPDATED (xti, yti)) {
                     vid_ptr = disp_ptr + (yc * pitch + (xc<<1));
                     tile_ptr = bx_gui->graphics_tile_get(xc, yc, &w, &h);
                     for (r=0; r<h; r++) {
-                      vid_ptr2  = vid_ptr;
-                      tile_ptr2 = tile_ptr;
-                      for (c=0; c<w; c++) {
-                        colour = *(vid_ptr2++);
-                        colour |= *(vid_ptr2++) << 8;
-                        colour = MAKE_COLOUR(
-                          colour & 0x001f, 5, info.blue_shift, info.blue_mask,
-                          colour & 0x07e0, 11, info.green_shift, info.green_mask,
-                          colour & 0xf800, 16, info.red_shift, info.red_mask);
-                        if (info.is_little_endian) {
-                          for (i=0; i<info.bpp; i+=8) {
-                            *(tile_ptr2++) = (Bit8u)(colour >> i);
-                          }
-                        } else {
-                          for (i=info.bpp-8; i>-8; i-=8) {
-                            *(tile_ptr2++) = (Bit8u)(colour >> i);
+                      if (pixconv) {
+                        bx_pixconv.rgb16_to_32((Bit32u *)tile_ptr, vid_ptr, w, &fmt);
+                      } else {
+                        vid_ptr2  = vid_ptr;
+                        tile_ptr2 = tile_ptr;
+                        for (c=0; c<w; c++) {
+                          colour = *(vid_ptr2++);
+                          colour |= *(vid_ptr2++) << 8;
+                          colour = MAKE_COLOUR(
+                            colour & 0x001f, 5, info.blue_shift, info.blue_mask,
+                            colour & 0x07e0, 11, info.green_shift, info.green_mask,
+                            colour & 0xf800, 16, info.red_shift, info.red_mask);
+                          if (info.is_little_endian) {
+                            for (i=0; i<info.bpp; i+=8) {
+                              *(tile_ptr2++) = (Bit8u)(colour >> i);
+                            }
+                          } else {
+                            for (i=info.bpp-8; i>-8; i-=8) {
+                              *(tile_ptr2++) = (Bit8u)(colour >> i);
+                            }
                           }
                         }
                       }
@@ -671,7 +704,8 @@ void bx_vga_c::update(void)
     } else {
       unsigned r, c, x, y;
       unsigned xc, yc, xti, yti;
-      Bit8u *plane[4];
+      Bit8u *plane[4], map[16];
+      bx_vga_render_t rs;
 
       BX_VGA_THIS determine_screen_dimensions(&iHeight, &iWidth);
       if ((iWidth != BX_VGA_THIS s.last_xres) || (iHeight != BX_VGA_THIS s.last_yres) ||
@@ -682,10 +716,14 @@ void bx_vga_c::update(void)
         BX_VGA_THIS s.last_bpp = 8;
       }
 
+      BX_VGA_THIS get_render_state(&rs);
       plane[0] = &BX_VGA_THIS s.memory[0<<VBE_DISPI_4BPP_PLANE_SHIFT];
       plane[1] = &BX_VGA_THIS s.memory[1<<VBE_DISPI_4BPP_PLANE_SHIFT];
       plane[2] = &BX_VGA_THIS s.memory[2<<VBE_DISPI_4BPP_PLANE_SHIFT];
       plane[3] = &BX_VGA_THIS s.memory[3<<VBE_DISPI_4BPP_PLANE_SHIFT];
+      for (c=0; c<16; c++) {
+        map[c] = BX_VGA_THIS get_vga_dac_regno(&rs, c, 0);
+      }
 
       for (yc=0, yti=0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
         for (xc=0, xti=0; xc<iWidth; xc+=X_TILESIZE, xti++) {
@@ -693,10 +731,15 @@ void bx_vga_c::update(void)
             for (r=0; r<Y_TILESIZE; r++) {
               y = yc + r;
               if (BX_VGA_THIS s.y_doublescan) y >>= 1;
+              if (!rs.x_dotclockdiv2) {
+                BX_VGA_THIS get_vga_row(&rs, &BX_VGA_THIS s.tile[r*X_TILESIZE], xc, y,
+                                        BX_VGA_THIS vbe.virtual_start, 0xffff, map, plane);
+                continue;
+              }
               for (c=0; c<X_TILESIZE; c++) {
                 x = xc + c;
                 BX_VGA_THIS s.tile[r*X_TILESIZE + c] =
-                  BX_VGA_THIS get_vga_pixel(x, y, BX_VGA_THIS vbe.virtual_start, 0xffff, 0, plane);
+                  BX_VGA_THIS get_vga_pixel(&rs, x, y, BX_VGA_THIS vbe.virtual_start, 0xffff, 0, plane);
               }
             }
             SET_TILE_UPDATED (xti, yti, 0);
@@ -774,6 +817,18 @@ bx_bool bx_vga_c::mem_write_handler(bx_phy_address addr, unsigned len, void *dat
   return 1;
 }
 
+// The LFB of the packed pixel modes is accessed by the CPU through host
+// pointers. Written pages are found with the dirty map at update time.
+Bit8u *bx_vga_c::mem_da_handler(bx_phy_address addr, unsigned rw, void *param)
+{
+  if (!theVga->vbe.enabled || !theVga->vbe.lfb_enabled ||
+      (theVga->vbe.bpp == VBE_DISPI_BPP_4) ||
+      (addr < theVga->vbe.base_address)) {
+    return NULL;
+  }
+  return theVga->get_direct_ptr((Bit32u)(addr - theVga->vbe.base_address), rw);
+}
+
 void bx_vga_c::mem_write(bx_phy_address addr, Bit8u value)
 {
   // if in a vbe enabled mode, write to the vbe_memory
@@ -830,9 +885,9 @@ void bx_vga_c::redraw_area(unsigned x0, unsigned y0, unsigned width,
 #if BX_SUPPORT_PCI
 bx_bool bx_vga_c::vbe_set_base_addr(Bit32u *addr, Bit8u *pci_conf)
 {
-  if (DEV_pci_set_base_mem(BX_VGA_THIS_PTR, mem_read_handler,
-                           mem_write_handler,
-                           addr, pci_conf, VBE_DISPI_TOTAL_VIDEO_MEMORY_BYTES)) {
+  if (DEV_pci_set_base_mem_da(BX_VGA_THIS_PTR, mem_read_handler,
+                              mem_write_handler, addr, pci_conf,
+                              VBE_DISPI_TOTAL_VIDEO_MEMORY_BYTES, mem_da_handler)) {
     BX_VGA_THIS vbe.base_address = *addr;
     return 1;
   }
@@ -1234,6 +1289,8 @@ Bit32u bx_vga_c::vbe_write(Bit32u address, Bit32u value, unsigned io_len)
             BX_VGA_THIS s.plane_offset = 0;
           }
           BX_VGA_THIS vbe.enabled = (bx_bool)((value & VBE_DISPI_ENABLED) != 0);
+          // the LFB direct access depends on the mode
+          BX_VGA_THIS lfb_revoke();
           BX_VGA_THIS vbe.get_capabilities = (bx_bool)((value & VBE_DISPI_GETCAPS) != 0);
           new_vbe_8bit_dac = (bx_bool)((value & VBE_DISPI_8BIT_DAC) != 0);
           if (new_vbe_8bit_dac != BX_VGA_THIS vbe.dac_8bit) {
@@ -1452,6 +1509,14 @@ void bx_vga_c::pci_write_handler(Bit8u address, Bit32u value, unsigned io_len)
 #if BX_DEBUGGER
 void bx_vga_c::debug_dump(int argc, char **argv)
 {
+  if ((argc == 1) && !strcmp(argv[0], "text")) {
+    if (BX_VGA_THIS vbe.enabled) {
+      dbg_printf("not in text mode\n");
+    } else {
+      bx_vgacore_c::debug_dump_text();
+    }
+    return;
+  }
   if (BX_VGA_THIS vbe.enabled) {
     dbg_printf("Bochs VGA/VBE adapter\n\n");
     dbg_printf("current mode : %u x %u x %u\n", BX_VGA_THIS vbe.xres,
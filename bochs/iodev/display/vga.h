@@ -96,6 +96,7 @@ public:
   virtual void   reset(unsigned type);
   BX_VGA_SMF bx_bool mem_read_handler(bx_phy_address addr, unsigned len, void *data, void *param);
   BX_VGA_SMF bx_bool mem_write_handler(bx_phy_address addr, unsigned len, void *data, void *param);
+  BX_VGA_SMF Bit8u *mem_da_handler(bx_phy_address addr, unsigned rw, void *param);
   virtual Bit8u  mem_read(bx_phy_address addr);
   virtual void   mem_write(bx_phy_address addr, Bit8u value);
   virtual void   register_state(void);
@@ -27,6 +27,7 @@
 
 #include "iodev.h"
 #include "param_names.h"
+#include "gui/pixconv.h"
 #include "vgacore.h"
 #include "virt_timer.h"
 
@@ -37,6 +38,11 @@
 
 #define VGA_TRACE_FEATURE
 
+// display thread frame states
+#define BX_VGA_FRAME_IDLE   0
+#define BX_VGA_FRAME_RENDER 1 // posted, owned by the display thread
+#define BX_VGA_FRAME_DONE   2 // serialized, not yet passed to the gui
+
 // Only reference the array if the tile numbers are within the bounds
 // of the array.  If out of bounds, do nothing.
 #define SET_TILE_UPDATED(xtile, ytile, value)                   \
@@ -81,18 +87,32 @@ bx_vgacore_c::bx_vgacore_c()
 {
   memset(&s, 0, sizeof(s));
   timer_id = BX_NULL_TIMER_HANDLE;
+  display.started = 0;
+  display.dirty = NULL;
+  display.tiles = NULL;
+  lfb_dirty.map = NULL;
+  lfb_dirty.npages = 0;
+  lfb_dirty.any = 0;
+  lfb_dirty.mapped = 0;
+  actual_memory = NULL;
 }
 
 bx_vgacore_c::~bx_vgacore_c()
 {
-  if (s.memory != NULL) {
-    delete [] s.memory;
+  display_stop();
+  if (actual_memory != NULL) {
+    delete [] actual_memory;
+    actual_memory = NULL;
     s.memory = NULL;
   }
   if (s.vga_tile_updated != NULL) {
     delete [] s.vga_tile_updated;
     s.vga_tile_updated = NULL;
   }
+  if (lfb_dirty.map != NULL) {
+    delete [] lfb_dirty.map;
+    lfb_dirty.map = NULL;
+  }
   SIM->get_param_num(BXPN_VGA_UPDATE_FREQUENCY)->set_handler(NULL);
 }
 
@@ -115,6 +135,12 @@ void bx_vgacore_c::init(void)
   for (y = 0; y < BX_VGA_THIS s.num_y_tiles; y++)
     for (x = 0; x < BX_VGA_THIS s.num_x_tiles; x++)
       SET_TILE_UPDATED(x, y, 0);
+  BX_VGA_THIS lfb_dirty.npages = BX_VGA_THIS s.memsize >> BX_VGA_DIRTY_PAGE_SHIFT;
+  BX_VGA_THIS lfb_dirty.map = new Bit8u[(BX_VGA_THIS lfb_dirty.npages + 7) >> 3];
+  memset(BX_VGA_THIS lfb_dirty.map, 0, (BX_VGA_THIS lfb_dirty.npages + 7) >> 3);
+  if (SIM->get_param_bool(BXPN_VGA_DISPLAY_THREAD)->get()) {
+    BX_VGA_THIS display_start();
+  }
 
   char *strptr = SIM->get_param_string(BXPN_VGA_EXTENSION)->getptr();
   if (!BX_VGA_THIS extension_init &&
@@ -169,7 +195,7 @@ void bx_vgacore_c::init_standard_vga(void)
   if ((strlen(extname) == 0) || (!strcmp(extname, "none"))) {
     BX_VGA_THIS s.memsize = 0x40000;
     if (BX_VGA_THIS s.memory == NULL)
-      BX_VGA_THIS s.memory = new Bit8u[BX_VGA_THIS s.memsize];
+      BX_VGA_THIS alloc_memory(BX_VGA_THIS s.memsize);
     memset(BX_VGA_THIS s.memory, 0, BX_VGA_THIS s.memsize);
   }
   DEV_register_memory_handlers(BX_VGA_THIS_PTR, mem_read_handler, mem_write_handler,
@@ -1309,6 +1335,7 @@ void bx_vgacore_c::write(Bit32u address, Bit32u value, unsigned io_len, bx_bool
 
 void bx_vgacore_c::set_override(bx_bool enabled, void *dev)
 {
+  BX_VGA_THIS display_wait();
   BX_VGA_THIS s.vga_override = enabled;
   BX_VGA_THIS s.nvgadev = (bx_nonvga_device_c*)dev;
   if (enabled) {
@@ -1333,19 +1360,41 @@ void bx_vgacore_c::timer(void)
   bx_gui->flush();
 }
 
-Bit8u bx_vgacore_c::get_vga_pixel(Bit16u x, Bit16u y, Bit16u saddr, Bit16u lc, bx_bool bs, Bit8u **plane)
+void bx_vgacore_c::get_render_state(bx_vga_render_t *rs)
 {
-  Bit8u attribute, bit_no, palette_reg_val, DAC_regno;
+  rs->shift_reg = BX_VGA_THIS s.graphics_ctrl.shift_reg;
+  rs->crtc_reg14 = BX_VGA_THIS s.CRTC.reg[0x14];
+  rs->crtc_reg17 = BX_VGA_THIS s.CRTC.reg[0x17];
+  rs->select_high_bank = BX_VGA_THIS s.misc_output.select_high_bank;
+  rs->x_dotclockdiv2 = BX_VGA_THIS s.x_dotclockdiv2;
+  rs->y_doublescan = BX_VGA_THIS s.y_doublescan;
+  rs->start_addr = (BX_VGA_THIS s.CRTC.reg[0x0c] << 8) | BX_VGA_THIS s.CRTC.reg[0x0d];
+  rs->line_offset = BX_VGA_THIS s.line_offset;
+  rs->line_compare = BX_VGA_THIS s.line_compare;
+  rs->plane_shift = BX_VGA_THIS s.plane_shift;
+  memcpy(rs->palette_reg, BX_VGA_THIS s.attribute_ctrl.palette_reg, 16);
+  rs->color_plane_enable = BX_VGA_THIS s.attribute_ctrl.color_plane_enable;
+  rs->color_select = BX_VGA_THIS s.attribute_ctrl.color_select;
+  rs->blink_intensity = BX_VGA_THIS s.attribute_ctrl.mode_ctrl.blink_intensity;
+  rs->internal_palette_size = BX_VGA_THIS s.attribute_ctrl.mode_ctrl.internal_palette_size;
+  rs->width = BX_VGA_THIS s.last_xres;
+  rs->height = BX_VGA_THIS s.last_yres;
+  rs->cs_visible = 0;
+}
+
+Bit8u bx_vgacore_c::get_vga_pixel(const bx_vga_render_t *rs, Bit16u x, Bit16u y, Bit16u saddr, Bit16u lc, bx_bool bs, Bit8u **plane)
+{
+  Bit8u attribute, bit_no;
   Bit32u byte_offset;
 
-  if (BX_VGA_THIS s.x_dotclockdiv2) x >>= 1;
+  if (rs->x_dotclockdiv2) x >>= 1;
   bit_no = 7 - (x % 8);
   if (y > lc) {
     byte_offset = x / 8 +
-      ((y - lc - 1) * BX_VGA_THIS s.line_offset);
+      ((y - lc - 1) * rs->line_offset);
   } else {
     byte_offset = saddr + x / 8 +
-      (y * BX_VGA_THIS s.line_offset);
+      (y * rs->line_offset);
   }
   attribute =
     (((plane[0][byte_offset] >> bit_no) & 0x01) << 0) |
@@ -1353,33 +1402,57 @@ Bit8u bx_vgacore_c::get_vga_pixel(Bit16u x, Bit16u y, Bit16u saddr, Bit16u lc, b
     (((plane[2][byte_offset] >> bit_no) & 0x01) << 2) |
     (((plane[3][byte_offset] >> bit_no) & 0x01) << 3);
 
-  attribute &= BX_VGA_THIS s.attribute_ctrl.color_plane_enable;
+  return get_vga_dac_regno(rs, attribute, bs);
+}
+
+Bit8u bx_vgacore_c::get_vga_dac_regno(const bx_vga_render_t *rs, Bit8u attribute, bx_bool bs)
+{
+  Bit8u palette_reg_val, DAC_regno;
+
+  attribute &= rs->color_plane_enable;
   // undocumented feature ???: colors 0..7 high intensity, colors 8..15 blinking
-  if (BX_VGA_THIS s.attribute_ctrl.mode_ctrl.blink_intensity) {
+  if (rs->blink_intensity) {
     if (bs) {
       attribute |= 0x08;
     } else {
       attribute ^= 0x08;
     }
   }
-  palette_reg_val = BX_VGA_THIS s.attribute_ctrl.palette_reg[attribute];
-  if (BX_VGA_THIS s.attribute_ctrl.mode_ctrl.internal_palette_size) {
+  palette_reg_val = rs->palette_reg[attribute];
+  if (rs->internal_palette_size) {
     // use 4 lower bits from palette register
     // use 4 higher bits from color select register
     // 16 banks of 16-color registers
     DAC_regno = (palette_reg_val & 0x0f) |
-                (BX_VGA_THIS s.attribute_ctrl.color_select << 4);
+                (rs->color_select << 4);
   } else {
     // use 6 lower bits from palette register
     // use 2 higher bits from color select register
     // 4 banks of 64-color registers
     DAC_regno = (palette_reg_val & 0x3f) |
-                ((BX_VGA_THIS s.attribute_ctrl.color_select & 0x0c) << 4);
+                ((rs->color_select & 0x0c) << 4);
   }
   // DAC_regno &= video DAC mask register ???
   return DAC_regno;
 }
 
+// converts the X_TILESIZE pixels of a planar mode row starting at x (a
+// multiple of 8) using the attribute to DAC register table map
+void bx_vgacore_c::get_vga_row(const bx_vga_render_t *rs, Bit8u *dst, Bit16u x, Bit16u y, Bit16u saddr, Bit16u lc,
+                               const Bit8u *map, Bit8u **plane)
+{
+  Bit32u byte_offset;
+
+  if (y > lc) {
+    byte_offset = x / 8 +
+      ((y - lc - 1) * rs->line_offset);
+  } else {
+    byte_offset = saddr + x / 8 +
+      (y * rs->line_offset);
+  }
+  bx_pixconv.planar_to_index(dst, plane, byte_offset, X_TILESIZE / 8, map);
+}
+
 bx_bool bx_vgacore_c::skip_update(void)
 {
   Bit64u display_usec;
@@ -1405,6 +1478,116 @@ bx_bool bx_vgacore_c::skip_update(void)
   return 0;
 }
 
+// serializes one tile of a standard VGA graphics mode (also called by the
+// display thread: only the video memory and the passed state are used)
+void bx_vgacore_c::render_tile(const bx_vga_render_t *rs, unsigned xc, unsigned yc, Bit8u *tile)
+{
+  Bit8u *mem = BX_VGA_THIS s.memory;
+  Bit8u attribute, palette_reg_val, DAC_regno;
+  Bit16u x, y, line_compare;
+  unsigned bit_no, r, c;
+  unsigned long byte_offset, pixely, pixelx, plane;
+  Bit8u *planes[4], map[16];
+
+  switch (rs->shift_reg) {
+    case 0: // interleaved shift
+      if ((rs->crtc_reg17 & 1) == 0) { // CGA 640x200x2
+        for (r=0; r<Y_TILESIZE; r++) {
+          y = yc + r;
+          if (rs->y_doublescan) y >>= 1;
+          for (c=0; c<X_TILESIZE; c++) {
+            x = xc + c;
+            /* 0 or 0x2000 */
+            byte_offset = rs->start_addr + ((y & 1) << 13);
+            /* to the start of the line */
+            byte_offset += (320 / 4) * (y / 2);
+            /* to the byte start */
+            byte_offset += (x / 8);
+
+            bit_no = 7 - (x % 8);
+            palette_reg_val = ((mem[byte_offset] >> bit_no) & 1);
+            DAC_regno = rs->palette_reg[palette_reg_val];
+            tile[r*X_TILESIZE + c] = DAC_regno;
+          }
+        }
+      } else { // output data in serial fashion with each display plane
+               // output on its associated serial output.  Standard EGA/VGA format
+        planes[0] = &mem[0 << rs->plane_shift];
+        planes[1] = &mem[1 << rs->plane_shift];
+        planes[2] = &mem[2 << rs->plane_shift];
+        planes[3] = &mem[3 << rs->plane_shift];
+        line_compare = rs->line_compare;
+        if (rs->y_doublescan) line_compare >>= 1;
+        for (c=0; c<16; c++) {
+          map[c] = BX_VGA_THIS get_vga_dac_regno(rs, c, rs->cs_visible);
+        }
+
+        for (r=0; r<Y_TILESIZE; r++) {
+          y = yc + r;
+          if (rs->y_doublescan) y >>= 1;
+          if (!rs->x_dotclockdiv2) {
+            BX_VGA_THIS get_vga_row(rs, &tile[r*X_TILESIZE], xc, y, rs->start_addr, line_compare, map, planes);
+            continue;
+          }
+          for (c=0; c<X_TILESIZE; c++) {
+            x = xc + c;
+            tile[r*X_TILESIZE + c] =
+              BX_VGA_THIS get_vga_pixel(rs, x, y, rs->start_addr, line_compare, rs->cs_visible, planes);
+          }
+        }
+      }
+      break; // case 0
+
+    case 1: // output the data in a CGA-compatible 320x200 4 color graphics
+            // mode.  (planar shift, modes 4 & 5)
+      for (r=0; r<Y_TILESIZE; r++) {
+        y = yc + r;
+        if (rs->y_doublescan) y >>= 1;
+        for (c=0; c<X_TILESIZE; c++) {
+          x = xc + c;
+          if (rs->x_dotclockdiv2) x >>= 1;
+          /* 0 or 0x2000 */
+          byte_offset = rs->start_addr + ((y & 1) << 13);
+          /* to the start of the line */
+          byte_offset += (320 / 4) * (y / 2);
+          /* to the byte start */
+          byte_offset += (x / 4);
+
+          attribute = 6 - 2*(x % 4);
+          palette_reg_val = mem[byte_offset] >> attribute;
+          palette_reg_val &= 3;
+          DAC_regno = rs->palette_reg[palette_reg_val];
+          tile[r*X_TILESIZE + c] = DAC_regno;
+        }
+      }
+      break; // case 1
+
+    case 2: // output the data eight bits at a time from the 4 bit plane
+            // (format for VGA mode 13 hex)
+    case 3: // FIXME: is this really the same ???
+      for (r=0; r<Y_TILESIZE; r++) {
+        pixely = yc + r;
+        if (rs->y_doublescan) pixely >>= 1;
+        for (c=0; c<X_TILESIZE; c++) {
+          pixelx = (xc + c) >> 1;
+          plane  = (pixelx % 4);
+          if (rs->crtc_reg14 & 0x40) { // DW set: doubleword mode
+            byte_offset = rs->start_addr + (plane * 65536) +
+                          (pixely * rs->line_offset) + (pixelx & ~0x03);
+          } else if (rs->crtc_reg17 & 0x40) { // B/W set: byte mode, modeX
+            byte_offset = rs->start_addr + (plane * 65536) +
+                          (pixely * rs->line_offset) + (pixelx >> 2);
+          } else { // word mode
+            byte_offset = rs->start_addr + (plane * 65536) +
+                          (pixely * rs->line_offset) + ((pixelx >> 1) & ~0x01);
+          }
+          tile[r*X_TILESIZE + c] = mem[byte_offset];
+        }
+      }
+      break; // case 2
+  }
+}
+
 void bx_vgacore_c::update(void)
 {
   unsigned iHeight, iWidth;
@@ -1444,13 +1627,9 @@ void bx_vgacore_c::update(void)
 
   if (BX_VGA_THIS s.graphics_ctrl.graphics_alpha) {
     // Graphics mode
-    Bit8u color;
-    Bit16u x, y, start_addr;
-    unsigned bit_no, r, c;
-    unsigned long byte_offset;
+    bx_vga_render_t rs;
     unsigned xc, yc, xti, yti;
-
-    start_addr = (BX_VGA_THIS s.CRTC.reg[0x0c] << 8) | BX_VGA_THIS s.CRTC.reg[0x0d];
+    bx_bool all;
 
     determine_screen_dimensions(&iHeight, &iWidth);
     if((iWidth != BX_VGA_THIS s.last_xres) || (iHeight != BX_VGA_THIS s.last_yres) ||
@@ -1464,193 +1643,39 @@ void bx_vgacore_c::update(void)
 
     if (skip_update()) return;
 
-    switch (BX_VGA_THIS s.graphics_ctrl.shift_reg) {
-      case 0: // interleaved shift
-        Bit8u attribute, palette_reg_val, DAC_regno;
-        Bit16u line_compare;
-        Bit8u *plane[4];
-
-        if ((BX_VGA_THIS s.CRTC.reg[0x17] & 1) == 0) { // CGA 640x200x2
-
-          for (yc=0, yti=0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
-            for (xc=0, xti=0; xc<iWidth; xc+=X_TILESIZE, xti++) {
-              if (GET_TILE_UPDATED (xti, yti)) {
-                for (r=0; r<Y_TILESIZE; r++) {
-                  y = yc + r;
-                  if (BX_VGA_THIS s.y_doublescan) y >>= 1;
-                  for (c=0; c<X_TILESIZE; c++) {
-
-                    x = xc + c;
-                    /* 0 or 0x2000 */
-                    byte_offset = start_addr + ((y & 1) << 13);
-                    /* to the start of the line */
-                    byte_offset += (320 / 4) * (y / 2);
-                    /* to the byte start */
-                    byte_offset += (x / 8);
-
-                    bit_no = 7 - (x % 8);
-                    palette_reg_val = (((BX_VGA_THIS s.memory[byte_offset]) >> bit_no) & 1);
-                    DAC_regno = BX_VGA_THIS s.attribute_ctrl.palette_reg[palette_reg_val];
-                    BX_VGA_THIS s.tile[r*X_TILESIZE + c] = DAC_regno;
-                  }
-                }
-                SET_TILE_UPDATED (xti, yti, 0);
-                bx_gui->graphics_tile_update_common(BX_VGA_THIS s.tile, xc, yc);
-              }
-            }
-          }
-        } else { // output data in serial fashion with each display plane
-                 // output on its associated serial output.  Standard EGA/VGA format
-
-          plane[0] = &BX_VGA_THIS s.memory[0 << BX_VGA_THIS s.plane_shift];
-          plane[1] = &BX_VGA_THIS s.memory[1 << BX_VGA_THIS s.plane_shift];
-          plane[2] = &BX_VGA_THIS s.memory[2 << BX_VGA_THIS s.plane_shift];
-          plane[3] = &BX_VGA_THIS s.memory[3 << BX_VGA_THIS s.plane_shift];
-          line_compare = BX_VGA_THIS s.line_compare;
-          if (BX_VGA_THIS s.y_doublescan) line_compare >>= 1;
-
-          for (yc=0, yti=0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
-            for (xc=0, xti=0; xc<iWidth; xc+=X_TILESIZE, xti++) {
-              if (cs_toggle || GET_TILE_UPDATED (xti, yti)) {
-                for (r=0; r<Y_TILESIZE; r++) {
-                  y = yc + r;
-                  if (BX_VGA_THIS s.y_doublescan) y >>= 1;
-                  for (c=0; c<X_TILESIZE; c++) {
-                    x = xc + c;
-                    BX_VGA_THIS s.tile[r*X_TILESIZE + c] =
-                      BX_VGA_THIS get_vga_pixel(x, y, start_addr, line_compare, cs_visible, plane);
-                  }
-                }
-                SET_TILE_UPDATED (xti, yti, 0);
-                bx_gui->graphics_tile_update_common(BX_VGA_THIS s.tile, xc, yc);
-              }
-            }
-          }
-        }
-        break; // case 0
-
-      case 1: // output the data in a CGA-compatible 320x200 4 color graphics
-              // mode.  (planar shift, modes 4 & 5)
-
-        /* CGA 320x200x4 start */
-
-        for (yc=0, yti=0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
-          for (xc=0, xti=0; xc<iWidth; xc+=X_TILESIZE, xti++) {
-            if (GET_TILE_UPDATED (xti, yti)) {
-              for (r=0; r<Y_TILESIZE; r++) {
-                y = yc + r;
-                if (BX_VGA_THIS s.y_doublescan) y >>= 1;
-                for (c=0; c<X_TILESIZE; c++) {
-
-                  x = xc + c;
-                  if (BX_VGA_THIS s.x_dotclockdiv2) x >>= 1;
-                  /* 0 or 0x2000 */
-                  byte_offset = start_addr + ((y & 1) << 13);
-                  /* to the start of the line */
-                  byte_offset += (320 / 4) * (y / 2);
-                  /* to the byte start */
-                  byte_offset += (x / 4);
-
-                  attribute = 6 - 2*(x % 4);
-                  palette_reg_val = (BX_VGA_THIS s.memory[byte_offset]) >> attribute;
-                  palette_reg_val &= 3;
-                  DAC_regno = BX_VGA_THIS s.attribute_ctrl.palette_reg[palette_reg_val];
-                  BX_VGA_THIS s.tile[r*X_TILESIZE + c] = DAC_regno;
-                }
-              }
-              SET_TILE_UPDATED (xti, yti, 0);
-              bx_gui->graphics_tile_update_common(BX_VGA_THIS s.tile, xc, yc);
-            }
-          }
-        }
-        /* CGA 320x200x4 end */
-
-        break; // case 1
-
-      case 2: // output the data eight bits at a time from the 4 bit plane
-              // (format for VGA mode 13 hex)
-      case 3: // FIXME: is this really the same ???
-
-        if (BX_VGA_THIS s.CRTC.reg[0x14] & 0x40) { // DW set: doubleword mode
-          unsigned long pixely, pixelx, plane;
-
-          if (BX_VGA_THIS s.misc_output.select_high_bank != 1)
-            BX_PANIC(("update: select_high_bank != 1"));
-
-          for (yc=0, yti=0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
-            for (xc=0, xti=0; xc<iWidth; xc+=X_TILESIZE, xti++) {
-              if (GET_TILE_UPDATED (xti, yti)) {
-                for (r=0; r<Y_TILESIZE; r++) {
-                  pixely = yc + r;
-                  if (BX_VGA_THIS s.y_doublescan) pixely >>= 1;
-                  for (c=0; c<X_TILESIZE; c++) {
-                    pixelx = (xc + c) >> 1;
-                    plane  = (pixelx % 4);
-                    byte_offset = start_addr + (plane * 65536) +
-                                  (pixely * BX_VGA_THIS s.line_offset) + (pixelx & ~0x03);
-                    color = BX_VGA_THIS s.memory[byte_offset];
-                    BX_VGA_THIS s.tile[r*X_TILESIZE + c] = color;
-                  }
-                }
-                SET_TILE_UPDATED (xti, yti, 0);
-                bx_gui->graphics_tile_update_common(BX_VGA_THIS s.tile, xc, yc);
-              }
-            }
-          }
-        } else if (BX_VGA_THIS s.CRTC.reg[0x17] & 0x40) { // B/W set: byte mode, modeX
-          unsigned long pixely, pixelx, plane;
-
-          for (yc=0, yti=0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
-            for (xc=0, xti=0; xc<iWidth; xc+=X_TILESIZE, xti++) {
-              if (GET_TILE_UPDATED (xti, yti)) {
-                for (r=0; r<Y_TILESIZE; r++) {
-                  pixely = yc + r;
-                  if (BX_VGA_THIS s.y_doublescan) pixely >>= 1;
-                  for (c=0; c<X_TILESIZE; c++) {
-                    pixelx = (xc + c) >> 1;
-                    plane  = (pixelx % 4);
-                    byte_offset = (plane * 65536) +
-                                  (pixely * BX_VGA_THIS s.line_offset)
-                                  + (pixelx >> 2);
-                    color = BX_VGA_THIS s.memory[start_addr + byte_offset];
-                    BX_VGA_THIS s.tile[r*X_TILESIZE + c] = color;
-                  }
-                }
-                SET_TILE_UPDATED (xti, yti, 0);
-                bx_gui->graphics_tile_update_common(BX_VGA_THIS s.tile, xc, yc);
-              }
-            }
-          }
-        } else { // word mode
-          unsigned long pixely, pixelx, plane;
-
-          for (yc=0, yti=0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
-            for (xc=0, xti=0; xc<iWidth; xc+=X_TILESIZE, xti++) {
-              if (GET_TILE_UPDATED (xti, yti)) {
-                for (r=0; r<Y_TILESIZE; r++) {
-                  pixely = yc + r;
-                  if (BX_VGA_THIS s.y_doublescan) pixely >>= 1;
-                  for (c=0; c<X_TILESIZE; c++) {
-                    pixelx = (xc + c) >> 1;
-                    plane  = (pixelx % 4);
-                    byte_offset = (plane * 65536) +
-                                  (pixely * BX_VGA_THIS s.line_offset)
-                                  + ((pixelx >> 1) & ~0x01);
-                    color = BX_VGA_THIS s.memory[start_addr + byte_offset];
-                    BX_VGA_THIS s.tile[r*X_TILESIZE + c] = color;
-                  }
-                }
-                SET_TILE_UPDATED (xti, yti, 0);
-                bx_gui->graphics_tile_update_common(BX_VGA_THIS s.tile, xc, yc);
-              }
-            }
+    if (BX_VGA_THIS s.graphics_ctrl.shift_reg > 3) {
+      BX_PANIC(("update: shift_reg == %u", (unsigned)
+        BX_VGA_THIS s.graphics_ctrl.shift_reg));
+    }
+    if (((BX_VGA_THIS s.graphics_ctrl.shift_reg & 2) != 0) &&
+        ((BX_VGA_THIS s.CRTC.reg[0x14] & 0x40) != 0) &&
+        (BX_VGA_THIS s.misc_output.select_high_bank != 1)) {
+      BX_PANIC(("update: select_high_bank != 1"));
+    }
+    BX_VGA_THIS get_render_state(&rs);
+    rs.width = iWidth;
+    rs.height = iHeight;
+    rs.cs_visible = cs_visible;
+    // the blink state changes the colors of all tiles in the planar modes
+    all = cs_toggle && (rs.shift_reg == 0) && ((rs.crtc_reg17 & 1) != 0);
+
+    if (BX_VGA_THIS display.started && (bx_gui->get_snapshot_buffer() == NULL)) {
+      if (!BX_VGA_THIS display_collect()) {
+        // the display thread is still busy with the previous frame
+        return;
+      }
+      BX_VGA_THIS display_post(&rs, all);
+    } else {
+      BX_VGA_THIS display_wait();
+      for (yc=0, yti=0; yc<iHeight; yc+=Y_TILESIZE, yti++) {
+        for (xc=0, xti=0; xc<iWidth; xc+=X_TILESIZE, xti++) {
+          if (all || GET_TILE_UPDATED (xti, yti)) {
+            BX_VGA_THIS render_tile(&rs, xc, yc, BX_VGA_THIS s.tile);
+            SET_TILE_UPDATED (xti, yti, 0);
+            bx_gui->graphics_tile_update_common(BX_VGA_THIS s.tile, xc, yc);
           }
         }
-        break; // case 2
-
-      default:
-        BX_PANIC(("update: shift_reg == %u", (unsigned)
-          BX_VGA_THIS s.graphics_ctrl.shift_reg));
+      }
     }
 
     BX_VGA_THIS s.vga_mem_updated = 0;
@@ -1740,6 +1765,17 @@ void bx_vgacore_c::update(void)
       cursor_x = ((cursor_address - start_address)/2) % (iWidth/cWidth);
       cursor_y = ((cursor_address - start_address)/2) / (iWidth/cWidth);
     }
+    // report changed rows to the text screen watches (the gui may modify
+    // the snapshot, so compare it before calling text_update())
+    int watch = SIM->text_watch_check();
+    if ((watch == 2) || ((watch == 1) && BX_VGA_THIS s.vga_mem_updated)) {
+      for (unsigned y = 0; y < rows; y++) {
+        Bit8u *row = &BX_VGA_THIS s.memory[start_address + y * tm_info.line_offset];
+        if ((watch == 2) || memcmp(row, &BX_VGA_THIS s.text_snapshot[y * tm_info.line_offset], cols * 2)) {
+          SIM->text_row_changed(row, y, cols);
+        }
+      }
+    }
     bx_gui->text_update(BX_VGA_THIS s.text_snapshot,
                         &BX_VGA_THIS s.memory[start_address],
                         cursor_x, cursor_y, &tm_info);
@@ -1753,6 +1789,170 @@ void bx_vgacore_c::update(void)
   }
 }
 
+void bx_vgacore_c::display_start(void)
+{
+  unsigned ntiles = BX_VGA_THIS s.num_x_tiles * BX_VGA_THIS s.num_y_tiles;
+
+  BX_VGA_THIS display.dirty = new bx_bool[ntiles];
+  BX_VGA_THIS display.tiles = new Bit8u[ntiles * X_TILESIZE * Y_TILESIZE];
+  BX_VGA_THIS display.state = BX_VGA_FRAME_IDLE;
+  BX_VGA_THIS display.quit = 0;
+  BX_INIT_MUTEX(BX_VGA_THIS display.lock);
+  BX_INIT_COND(BX_VGA_THIS display.cond);
+  BX_VGA_THIS display.timer_id = bx_virt_timer.register_timer(this, display_timer_handler,
+    BX_VGA_DISPLAY_POLL, 0, 0, "vga display");
+  BX_VGA_THIS display.started = BX_THREAD_CREATE(display_thread, this, BX_VGA_THIS display.tid);
+  if (BX_VGA_THIS display.started) {
+    BX_INFO(("using display thread"));
+  } else {
+    BX_ERROR(("cannot create display thread"));
+  }
+}
+
+void bx_vgacore_c::display_stop(void)
+{
+  if (BX_VGA_THIS display.started) {
+    BX_LOCK(BX_VGA_THIS display.lock);
+    BX_VGA_THIS display.quit = 1;
+    BX_COND_SIGNAL(BX_VGA_THIS display.cond);
+    BX_UNLOCK(BX_VGA_THIS display.lock);
+    BX_THREAD_JOIN(BX_VGA_THIS display.tid);
+    BX_FINI_COND(BX_VGA_THIS display.cond);
+    BX_FINI_MUTEX(BX_VGA_THIS display.lock);
+    BX_VGA_THIS display.started = 0;
+  }
+  if (BX_VGA_THIS display.dirty != NULL) {
+    delete [] BX_VGA_THIS display.dirty;
+    delete [] BX_VGA_THIS display.tiles;
+    BX_VGA_THIS display.dirty = NULL;
+    BX_VGA_THIS display.tiles = NULL;
+  }
+}
+
+// moves the dirty tiles of the current frame to the display thread
+void bx_vgacore_c::display_post(const bx_vga_render_t *rs, bx_bool all)
+{
+  unsigned xc, yc, xti, yti, i;
+  bx_bool posted = 0;
+
+  BX_VGA_THIS display.rs = *rs;
+  for (yc=0, yti=0; yc<rs->height; yc+=Y_TILESIZE, yti++) {
+    for (xc=0, xti=0; xc<rs->width; xc+=X_TILESIZE, xti++) {
+      if ((xti >= BX_VGA_THIS s.num_x_tiles) || (yti >= BX_VGA_THIS s.num_y_tiles))
+        continue;
+      i = xti + yti * BX_VGA_THIS s.num_x_tiles;
+      BX_VGA_THIS display.dirty[i] = all || GET_TILE_UPDATED(xti, yti);
+      if (BX_VGA_THIS display.dirty[i]) {
+        SET_TILE_UPDATED(xti, yti, 0);
+        posted = 1;
+      }
+    }
+  }
+  if (posted) {
+    BX_LOCK(BX_VGA_THIS display.lock);
+    BX_VGA_THIS display.state = BX_VGA_FRAME_RENDER;
+    BX_COND_SIGNAL(BX_VGA_THIS display.cond);
+    BX_UNLOCK(BX_VGA_THIS display.lock);
+    bx_virt_timer.activate_timer(BX_VGA_THIS display.timer_id, BX_VGA_DISPLAY_POLL, 0);
+  }
+}
+
+// passes a completed frame to the gui. Returns 0 if the display thread is
+// still busy.
+bx_bool bx_vgacore_c::display_collect(void)
+{
+  const bx_vga_render_t *rs = &BX_VGA_THIS display.rs;
+  unsigned xc, yc, xti, yti, i;
+  Bit8u state;
+  bx_bool valid;
+
+  if (!BX_VGA_THIS display.started) return 1;
+  BX_LOCK(BX_VGA_THIS display.lock);
+  state = BX_VGA_THIS display.state;
+  BX_UNLOCK(BX_VGA_THIS display.lock);
+  if (state == BX_VGA_FRAME_RENDER) {
+    return 0;
+  } else if (state == BX_VGA_FRAME_DONE) {
+    // drop the frame if the display mode has changed in the meantime
+    valid = !BX_VGA_THIS s.vga_override && BX_VGA_THIS s.graphics_ctrl.graphics_alpha &&
+            (rs->width == BX_VGA_THIS s.last_xres) && (rs->height == BX_VGA_THIS s.last_yres) &&
+            (BX_VGA_THIS s.last_bpp == 8);
+    for (yc=0, yti=0; yc<rs->height; yc+=Y_TILESIZE, yti++) {
+      for (xc=0, xti=0; xc<rs->width; xc+=X_TILESIZE, xti++) {
+        if ((xti >= BX_VGA_THIS s.num_x_tiles) || (yti >= BX_VGA_THIS s.num_y_tiles))
+          continue;
+        i = xti + yti * BX_VGA_THIS s.num_x_tiles;
+        if (BX_VGA_THIS display.dirty[i]) {
+          if (valid) {
+            bx_gui->graphics_tile_update_common(&BX_VGA_THIS display.tiles[i * X_TILESIZE * Y_TILESIZE], xc, yc);
+          } else {
+            SET_TILE_UPDATED(xti, yti, 1);
+          }
+        }
+      }
+    }
+    if (valid) {
+      bx_gui->flush();
+    }
+    BX_LOCK(BX_VGA_THIS display.lock);
+    BX_VGA_THIS display.state = BX_VGA_FRAME_IDLE;
+    BX_UNLOCK(BX_VGA_THIS display.lock);
+  }
+  return 1;
+}
+
+void bx_vgacore_c::display_wait(void)
+{
+  while (!BX_VGA_THIS display_collect()) {
+    BX_MSLEEP(1);
+  }
+}
+
+BX_THREAD_FUNC(bx_vgacore_c::display_thread, indata)
+{
+  ((bx_vgacore_c *) indata)->display_loop();
+  BX_THREAD_EXIT;
+}
+
+void bx_vgacore_c::display_loop(void)
+{
+  const bx_vga_render_t *rs = &BX_VGA_THIS display.rs;
+  unsigned xc, yc, xti, yti, i;
+
+  BX_LOCK(BX_VGA_THIS display.lock);
+  while (!BX_VGA_THIS display.quit) {
+    if (BX_VGA_THIS display.state != BX_VGA_FRAME_RENDER) {
+      BX_COND_WAIT(BX_VGA_THIS display.cond, BX_VGA_THIS display.lock);
+      continue;
+    }
+    BX_UNLOCK(BX_VGA_THIS display.lock);
+    // the guest may write to the video memory meanwhile: the written tiles
+    // are marked again and serialized with the next frame
+    for (yc=0, yti=0; yc<rs->height; yc+=Y_TILESIZE, yti++) {
+      for (xc=0, xti=0; xc<rs->width; xc+=X_TILESIZE, xti++) {
+        if ((xti >= BX_VGA_THIS s.num_x_tiles) || (yti >= BX_VGA_THIS s.num_y_tiles))
+          continue;
+        i = xti + yti * BX_VGA_THIS s.num_x_tiles;
+        if (BX_VGA_THIS display.dirty[i]) {
+          BX_VGA_THIS render_tile(rs, xc, yc, &BX_VGA_THIS display.tiles[i * X_TILESIZE * Y_TILESIZE]);
+        }
+      }
+    }
+    BX_LOCK(BX_VGA_THIS display.lock);
+    BX_VGA_THIS display.state = BX_VGA_FRAME_DONE;
+  }
+  BX_UNLOCK(BX_VGA_THIS display.lock);
+}
+
+void bx_vgacore_c::display_timer_handler(void *this_ptr)
+{
+  bx_vgacore_c *class_ptr = (bx_vgacore_c *) this_ptr;
+
+  if (!class_ptr->display_collect()) {
+    bx_virt_timer.activate_timer(class_ptr->display.timer_id, BX_VGA_DISPLAY_POLL, 0);
+  }
+}
+
 bx_bool bx_vgacore_c::mem_read_handler(bx_phy_address addr, unsigned len, void *data, void *param)
 {
   bx_vgacore_c *class_ptr = (bx_vgacore_c *) param;
@@ -2282,6 +2482,99 @@ void bx_vgacore_c::mem_write(bx_phy_address addr, Bit8u value)
   }
 }
 
+// Returns a host pointer into the video memory for direct CPU access (TLB).
+// Pages handed out for writing are recorded in the dirty map, so the
+// display update only has to look at these pages.
+// The video memory is page aligned, since the CPU accesses a page handed
+// out by get_direct_ptr() as (host page address | page offset).
+void bx_vgacore_c::alloc_memory(Bit32u size)
+{
+  Bit32u mask = (1 << BX_VGA_DIRTY_PAGE_SHIFT) - 1;
+
+  BX_VGA_THIS actual_memory = new Bit8u[size + mask];
+  BX_VGA_THIS s.memory = (Bit8u*)(((bx_ptr_equiv_t)BX_VGA_THIS actual_memory + mask) & ~(bx_ptr_equiv_t)mask);
+}
+
+Bit8u *bx_vgacore_c::get_direct_ptr(Bit32u offset, unsigned rw)
+{
+  Bit32u page = offset >> BX_VGA_DIRTY_PAGE_SHIFT;
+
+  if ((rw == BX_EXECUTE) || (page >= BX_VGA_THIS lfb_dirty.npages))
+    return NULL;
+  if (rw & 1) {
+    BX_VGA_THIS lfb_dirty.map[page >> 3] |= (1 << (page & 7));
+    BX_VGA_THIS lfb_dirty.any = 1;
+  }
+  BX_VGA_THIS lfb_dirty.mapped = 1;
+  return &BX_VGA_THIS s.memory[offset];
+}
+
+// Takes back all pages handed out by get_direct_ptr(). Called when the
+// device starts to intercept accesses to its framebuffer again.
+void bx_vgacore_c::lfb_revoke(void)
+{
+  if (BX_VGA_THIS lfb_dirty.mapped) {
+    BX_VGA_THIS lfb_dirty.mapped = 0;
+    bx_pc_system.MemoryMappingChanged();
+  }
+}
+
+// Marks the tiles covered by the dirty pages of a packed pixel mode and
+// revokes the direct write access, so the next write to a page marks it
+// again.
+bx_bool bx_vgacore_c::lfb_dirty_scan(Bit32u start, Bit32u pitch, unsigned bypp, unsigned width, unsigned height)
+{
+  Bit32u page, pstart, pend, end;
+  unsigned x0, x1, y0, y1, xti, yti;
+  bx_bool updated = 0;
+
+  if (!BX_VGA_THIS lfb_dirty.any)
+    return 0;
+  if ((pitch == 0) || (bypp == 0))
+    height = 0;
+  end = start + pitch * height;
+  for (page = 0; page < BX_VGA_THIS lfb_dirty.npages; page++) {
+    if (BX_VGA_THIS lfb_dirty.map[page >> 3] == 0) {
+      page |= 7;
+      continue;
+    }
+    if ((BX_VGA_THIS lfb_dirty.map[page >> 3] & (1 << (page & 7))) == 0)
+      continue;
+    pstart = page << BX_VGA_DIRTY_PAGE_SHIFT;
+    pend = pstart + (1 << BX_VGA_DIRTY_PAGE_SHIFT);
+    if ((pend <= start) || (pstart >= end))
+      continue;
+    if (pstart < start) pstart = start;
+    if (pend > end) pend = end;
+    pstart -= start;
+    pend -= start + 1;
+    y0 = pstart / pitch;
+    y1 = pend / pitch;
+    if (y0 == y1) {
+      x0 = (pstart % pitch) / bypp;
+      x1 = (pend % pitch) / bypp;
+      if (x0 >= width)
+        continue;
+      if (x1 >= width) x1 = width - 1;
+    } else {
+      x0 = 0;
+      x1 = width - 1;
+    }
+    for (yti = y0 / Y_TILESIZE; yti <= y1 / Y_TILESIZE; yti++) {
+      for (xti = x0 / X_TILESIZE; xti <= x1 / X_TILESIZE; xti++) {
+        SET_TILE_UPDATED(xti, yti, 1);
+      }
+    }
+    BX_VGA_THIS s.vga_mem_updated = 1;
+    updated = 1;
+  }
+  memset(BX_VGA_THIS lfb_dirty.map, 0, (BX_VGA_THIS lfb_dirty.npages + 7) >> 3);
+  BX_VGA_THIS lfb_dirty.any = 0;
+  BX_VGA_THIS lfb_dirty.mapped = 0;
+  bx_pc_system.MemoryMappingChanged();
+  return updated;
+}
+
 void bx_vgacore_c::get_text_snapshot(Bit8u **text_snapshot, unsigned *txHeight,
                                                    unsigned *txWidth)
 {
@@ -2362,6 +2655,34 @@ void bx_vgacore_c::debug_dump(void)
   dbg_printf("s.attribute_ctrl.mode_ctrl.pixel_clock_select = %u\n",
             (unsigned) BX_VGA_THIS s.attribute_ctrl.mode_ctrl.pixel_clock_select);
 }
+
+// print the characters of the current text screen, one line per row
+void bx_vgacore_c::debug_dump_text(void)
+{
+  unsigned start_address, line_offset, rows, cols, x, y, len;
+  char line[256];
+  Bit8u *row;
+
+  if (BX_VGA_THIS s.graphics_ctrl.graphics_alpha) {
+    dbg_printf("not in text mode\n");
+    return;
+  }
+  start_address = 2*((BX_VGA_THIS s.CRTC.reg[12] << 8) + BX_VGA_THIS s.CRTC.reg[13]);
+  line_offset = BX_VGA_THIS s.CRTC.reg[0x13] << 2;
+  rows = (BX_VGA_THIS s.vertical_display_end + 1) / ((BX_VGA_THIS s.CRTC.reg[0x09] & 0x1f) + 1);
+  cols = BX_VGA_THIS s.CRTC.reg[1] + 1;
+  for (y = 0; y < rows; y++) {
+    if ((start_address + y * line_offset + cols * 2) > BX_VGA_THIS s.memsize) break;
+    row = &BX_VGA_THIS s.memory[start_address + y * line_offset];
+    len = 0;
+    for (x = 0; (x < cols) && (x < sizeof(line) - 1); x++) {
+      line[x] = row[x * 2] ? row[x * 2] : ' ';
+      if (line[x] != ' ') len = x + 1;
+    }
+    line[len] = 0;
+    dbg_printf("%s\n", line);
+  }
+}
 #endif
 
 void bx_vgacore_c::redraw_area(unsigned x0, unsigned y0, unsigned width,
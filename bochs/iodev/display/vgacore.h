@@ -23,6 +23,8 @@
 #ifndef BX_IODEV_VGACORE_H
 #define BX_IODEV_VGACORE_H
 
+#include "bxthread.h"
+
 // Make colour
 #define MAKE_COLOUR(red, red_shiftfrom, red_shiftto, red_mask, \
                     green, green_shiftfrom, green_shiftto, green_mask, \
@@ -45,6 +47,35 @@
 #define X_TILESIZE 16
 #define Y_TILESIZE 24
 
+// usecs between checks for a frame completed by the display thread
+#define BX_VGA_DISPLAY_POLL 1000
+
+// granularity of the video memory dirty map (host page = CPU TLB page)
+#define BX_VGA_DIRTY_PAGE_SHIFT 12
+
+// registers that control how the video memory of a standard VGA graphics
+// mode is serialized into tiles (copied for the display thread)
+typedef struct {
+  Bit16u   width;
+  Bit16u   height;
+  Bit8u    shift_reg;
+  Bit8u    crtc_reg14;       // underline location (doubleword mode)
+  Bit8u    crtc_reg17;       // mode control (CGA compatibility, byte mode)
+  bx_bool  select_high_bank;
+  bx_bool  x_dotclockdiv2;
+  bx_bool  y_doublescan;
+  Bit16u   start_addr;
+  unsigned line_offset;
+  unsigned line_compare;
+  Bit8u    plane_shift;
+  Bit8u    palette_reg[16];
+  Bit8u    color_plane_enable;
+  Bit8u    color_select;
+  bx_bool  blink_intensity;
+  bx_bool  internal_palette_size;
+  bx_bool  cs_visible;
+} bx_vga_render_t;
+
 class bx_nonvga_device_c : public bx_devmodel_c {
 public:
   virtual void redraw_area(unsigned x0, unsigned y0,
@@ -72,6 +103,7 @@ public:
   virtual void   after_restore_state(void);
 #if BX_DEBUGGER
   virtual void   debug_dump(void);
+  void           debug_dump_text(void);
 #endif
 
   virtual void   redraw_area(unsigned x0, unsigned y0,
@@ -96,12 +128,31 @@ protected:
   Bit32u read(Bit32u address, unsigned io_len);
   void   write(Bit32u address, Bit32u value, unsigned io_len, bx_bool no_log);
 
-  Bit8u get_vga_pixel(Bit16u x, Bit16u y, Bit16u saddr, Bit16u lc, bx_bool bs, Bit8u **plane);
+  void get_render_state(bx_vga_render_t *rs);
+  Bit8u get_vga_pixel(const bx_vga_render_t *rs, Bit16u x, Bit16u y, Bit16u saddr, Bit16u lc, bx_bool bs, Bit8u **plane);
+  Bit8u get_vga_dac_regno(const bx_vga_render_t *rs, Bit8u attribute, bx_bool bs);
+  void get_vga_row(const bx_vga_render_t *rs, Bit8u *dst, Bit16u x, Bit16u y, Bit16u saddr, Bit16u lc,
+                   const Bit8u *map, Bit8u **plane);
+  void render_tile(const bx_vga_render_t *rs, unsigned xc, unsigned yc, Bit8u *tile);
   void update(void);
   void determine_screen_dimensions(unsigned *piHeight, unsigned *piWidth);
   void calculate_retrace_timing(void);
   bx_bool skip_update(void);
 
+  void alloc_memory(Bit32u size);
+  Bit8u *get_direct_ptr(Bit32u offset, unsigned rw);
+  bx_bool lfb_dirty_scan(Bit32u start, Bit32u pitch, unsigned bypp, unsigned width, unsigned height);
+  void lfb_revoke(void);
+
+  void display_start(void);
+  void display_stop(void);
+  void display_post(const bx_vga_render_t *rs, bx_bool all);
+  bx_bool display_collect(void);
+  void display_wait(void);
+  static BX_THREAD_FUNC(display_thread, indata);
+  void display_loop(void);
+  static void display_timer_handler(void *this_ptr);
+
   struct {
     struct {
       bx_bool color_emulation;  // 1=color emulation, base address = 3Dx
@@ -237,6 +288,31 @@ protected:
     bx_nonvga_device_c *nvgadev;
   } s;  // state information
 
+  // display thread: serializes the dirty tiles of a standard VGA graphics
+  // mode frame while the emulation thread keeps running
+  struct {
+    bx_bool  started;
+    BX_THREAD_ID(tid);
+    BX_MUTEX(lock);
+    BX_COND(cond);
+    bx_vga_render_t rs;
+    bx_bool  *dirty;    // tiles of the posted frame
+    Bit8u    *tiles;    // serialized tiles (8 bpp)
+    Bit8u    state;     // BX_VGA_FRAME_xxx
+    bx_bool  quit;
+    int      timer_id;
+  } display;
+
+  // video memory pages handed out to the CPU for direct writes since the
+  // last display update (one bit per page)
+  struct {
+    Bit8u    *map;
+    Bit32u   npages;
+    bx_bool  any;
+    bx_bool  mapped;   // any page handed out since the last TLB flush
+  } lfb_dirty;
+  Bit8u *actual_memory; // allocation holding the page aligned s.memory
+
   int timer_id;
   Bit32u update_interval;
   bx_bool extension_init;
@@ -106,6 +106,13 @@ bx_voodoo_c::bx_voodoo_c()
 
 bx_voodoo_c::~bx_voodoo_c()
 {
+  // the rasterizer threads must be done before the hits are summed up
+  poly_free(v->poly);
+  if (!SIM->get_param_string(BXPN_VOODOO_PROFILE)->isempty()) {
+    write_rasterizer_profile(v, SIM->get_param_string(BXPN_VOODOO_PROFILE)->getptr());
+  } else {
+    dump_rasterizer_stats(v, NULL);
+  }
   free(v->fbi.ram);
   free(v->tmu[0].ram);
   free(v->tmu[1].ram);
@@ -323,6 +330,7 @@ void bx_voodoo_c::register_state(void)
 
 void bx_voodoo_c::after_restore_state(void)
 {
+  poly_wait(v->poly, "after_restore_state");
   if (DEV_pci_set_base_mem(BX_VOODOO_THIS_PTR, mem_read_handler, mem_write_handler,
                            &BX_VOODOO_THIS pci_base_address[0],
                            &BX_VOODOO_THIS pci_conf[0x10],
@@ -433,6 +441,11 @@ void bx_voodoo_c::update(void)
     swap_buffers(v);
   }
 
+  // polygons drawn to the front buffer may still be in the rasterizer threads
+  if (v->fbi.video_changed) {
+    poly_wait(v->poly, "update");
+  }
+
   rectangle re;
   re.min_x = re.min_y = 0;
   re.max_x = v->fbi.width;
@@ -1653,6 +1653,7 @@ struct _raster_info
   Bit32u  eff_fbz_mode;   /* effective fbzMode value */
   Bit32u  eff_tex_mode_0; /* effective textureMode value for TMU #0 */
   Bit32u  eff_tex_mode_1; /* effective textureMode value for TMU #1 */
+  Bit32u  thread_hits[WORK_MAX_THREADS]; /* hits of the rasterizer threads */
 };
 
 
@@ -1692,6 +1693,53 @@ struct _poly_extra_data
 };
 
 
+/* polygons queued for the rasterizer threads */
+#define POLY_MAX_ITEMS      256     /* size of the work item ring */
+#define POLY_BAND_SHIFT     3       /* each thread owns bands of 8 scanlines */
+
+typedef struct _poly_work_item poly_work_item;
+struct _poly_work_item
+{
+  void *        dest;         /* destination buffer */
+  poly_draw_scanline_func callback; /* scanline rasterizer */
+  Bit32s        miny, maxy;   /* scanline range (maxy exclusive) */
+  bx_bool       custom;       /* constant extent instead of a triangle */
+  poly_extent   extent;       /* extent of all scanlines if custom */
+  bx_bool       clip;         /* cliprect valid */
+  rectangle     cliprect;     /* clipping rectangle */
+  poly_vertex   v1, v2;       /* top and middle vertex (sorted by Y) */
+  float         dxdy_v1v2, dxdy_v1v3, dxdy_v2v3; /* edge slopes */
+  poly_extra_data extra;      /* copy of the triangle parameters */
+};
+
+typedef struct _poly_manager poly_manager;
+
+typedef struct _poly_thread_info poly_thread_info;
+struct _poly_thread_info
+{
+  poly_manager *poly;         /* pointer back to the polygon manager */
+  int           index;        /* thread index, selects the scanline bands */
+  bx_bool       started;
+  BX_THREAD_ID(tid);
+  BX_COND(cond);              /* signalled when new items are queued */
+  Bit32u        tail;         /* items finished by this thread */
+  bx_bool       waiting;      /* thread waits on 'cond' */
+};
+
+struct _poly_manager
+{
+  int           nthreads;     /* number of rasterizer threads */
+  poly_work_item *item;       /* work item ring */
+  Bit32u        head;         /* items queued so far */
+  Bit32u        fenced;       /* value of head at the last completed wait */
+  BX_MUTEX(lock);
+  BX_COND(done);              /* signalled when a thread made progress */
+  bx_bool       waiting;      /* emulation thread waits on 'done' */
+  bx_bool       quit;
+  poly_thread_info thread[WORK_MAX_THREADS];
+};
+
+
 typedef struct _banshee_info banshee_info;
 struct _banshee_info
 {
@@ -1736,7 +1784,7 @@ struct _voodoo_state
   Bit32u      send_config;
   Bit32u      tmu_config;
 
-//  poly_manager*   poly;         /* polygon manager */
+  poly_manager*   poly;         /* polygon manager */
   stats_block *   thread_stats; /* per-thread statistics */
 
   voodoo_stats    stats;        /* internal statistics */
@@ -3071,7 +3119,7 @@ do
       (VV)->reg[stipple].u = ((VV)->reg[stipple].u << 1) | ((VV)->reg[stipple].u >> 31); \
       if (((VV)->reg[stipple].u & 0x80000000) == 0)                              \
       {                                                                          \
-        (VV)->stats.total_stippled++;                                            \
+        (STATS)->stipple_count++;                                                \
         goto skipdrawdepth;                                                      \
       }                                                                          \
     }                                                                            \
@@ -3082,7 +3130,7 @@ do
       int stipple_index = (((YY) & 3) << 3) | (~(XX) & 7);                       \
       if ((((VV)->reg[stipple].u >> stipple_index) & 1) == 0)                    \
       {                                                                          \
-        (VV)->stats.total_stippled++;                                            \
+        (STATS)->stipple_count++;                                                \
         goto skipdrawdepth;                                                      \
       }                                                                          \
     }                                                                            \
@@ -3593,14 +3641,14 @@ void raster_##name(void *destbase, Bit32s y, const poly_extent *extent, const vo
     if (startx < tempclip)                                                       \
     {                                                                            \
       stats->pixels_in += tempclip - startx;                                     \
-      v->stats.total_clipped += tempclip - startx;                               \
+      stats->clip_fail += tempclip - startx;                                     \
       startx = tempclip;                                                         \
     }                                                                            \
     tempclip = v->reg[clipLeftRight].u & 0x3ff;                                  \
     if (stopx >= tempclip)                                                       \
     {                                                                            \
       stats->pixels_in += stopx - tempclip;                                      \
-      v->stats.total_clipped += stopx - tempclip;                                \
+      stats->clip_fail += stopx - tempclip;                                      \
       stopx = tempclip - 1;                                                      \
     }                                                                            \
   }                                                                              \
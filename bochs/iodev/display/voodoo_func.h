@@ -41,7 +41,6 @@
 Bit32u voodoo_last_msg = 255;
 
 
-#define poly_wait(x,y)
 #define cpu_eat_cycles(x,y)
 
 #define DEBUG_DEPTH     (0)
@@ -106,6 +105,7 @@ RASTERIZER(generic_2tmu, 2, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[al
   RASTERIZER(fbzcp##_##alpha##_##fog##_##fbz##_##tex0##_##tex1, (((tex0) == 0xffffffff) ? 0 : ((tex1) == 0xffffffff) ? 1 : 2), fbzcp, fbz, alpha, fog, tex0, tex1)
 
 #include "voodoo_raster.h"
+#include "voodoo_raster_profile.h"
 
 #undef RASTERIZER_ENTRY
 
@@ -126,6 +126,13 @@ static const raster_info predef_raster_table[] =
   { 0 }
 };
 
+/* entries of a rasterizer profile written with vga: voodoo_profile=<file> */
+static const raster_info predef_profile_table[] =
+{
+#include "voodoo_raster_profile.h"
+  { 0 }
+};
+
 #undef RASTERIZER_ENTRY
 
 
@@ -153,6 +160,7 @@ static raster_info *add_rasterizer(voodoo_state *v, const raster_info *cinfo)
   /* fill in the data */
   info->hits = 0;
   info->polys = 0;
+  memset(info->thread_hits, 0, sizeof(info->thread_hits));
 
   /* hook us into the hash table */
   info->next = v->raster_hash[hash];
@@ -164,21 +172,149 @@ static raster_info *add_rasterizer(voodoo_state *v, const raster_info *cinfo)
         info->eff_color_path, info->eff_alpha_mode, info->eff_fog_mode, info->eff_fbz_mode,
         info->eff_tex_mode_0, info->eff_tex_mode_1, hash);
 
-    printf("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X)\n",
+    printf("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) /* %c */\n",
       info->eff_color_path,
       info->eff_alpha_mode,
       info->eff_fog_mode,
       info->eff_fbz_mode,
       info->eff_tex_mode_0,
       info->eff_tex_mode_1,
-      info->is_generic ? '*' : ' ',
-      info->polys,
-      info->hits);
+      info->is_generic ? '*' : ' ');
   }
   return info;
 }
 
 
+/*-------------------------------------------------
+    raster_hits - pixels drawn with a rasterizer
+    on the emulation thread and the rasterizer
+    threads (the threads must be idle)
+-------------------------------------------------*/
+
+static Bit32u raster_hits(const raster_info *info)
+{
+  Bit32u hits = info->hits;
+
+  for (int i = 0; i < WORK_MAX_THREADS; i++)
+    hits += info->thread_hits[i];
+  return hits;
+}
+
+
+/*-------------------------------------------------
+    raster_in_profile - true if the rasterizer
+    was built from voodoo_raster_profile.h
+-------------------------------------------------*/
+
+static bx_bool raster_in_profile(const raster_info *info)
+{
+  const raster_info *entry;
+
+  for (entry = predef_profile_table; entry->callback; entry++)
+    if (entry->callback == info->callback)
+      return 1;
+  return 0;
+}
+
+
+/*-------------------------------------------------
+    dump_rasterizer_stats - log the rasterizers
+    used so far ordered by pixel count; the lines
+    marked with '*' went through the generic
+    rasterizer. If profile is not NULL, these and
+    the entries of the current profile are written
+    to it as a new voodoo_raster_profile.h
+-------------------------------------------------*/
+
+static int dump_rasterizer_stats(voodoo_state *v, FILE *profile)
+{
+  static Bit8u display_index;
+  raster_info *cur, *best;
+  Bit32u hits, best_hits;
+  int hash, entries = 0;
+
+  display_index++;
+
+  /* loop until we've displayed everything */
+  while (1)
+  {
+    best = NULL;
+    best_hits = 0;
+
+    /* find the highest entry */
+    for (hash = 0; hash < RASTER_HASH_SIZE; hash++)
+      for (cur = v->raster_hash[hash]; cur; cur = cur->next)
+      {
+        if (cur->display == display_index)
+          continue;
+        hits = raster_hits(cur);
+        if (best == NULL || hits > best_hits)
+        {
+          best = cur;
+          best_hits = hits;
+        }
+      }
+
+    /* if we're done, we're done */
+    if (best == NULL)
+      break;
+    best->display = display_index;
+
+    if (best_hits > 0)
+      BX_DEBUG(("RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) /* %c %8u %10u */",
+        best->eff_color_path,
+        best->eff_alpha_mode,
+        best->eff_fog_mode,
+        best->eff_fbz_mode,
+        best->eff_tex_mode_0,
+        best->eff_tex_mode_1,
+        best->is_generic ? '*' : ' ',
+        best->polys,
+        best_hits));
+
+    if ((profile != NULL) && ((best->is_generic && (best_hits > 0)) || raster_in_profile(best)))
+    {
+      fprintf(profile, "RASTERIZER_ENTRY( 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) /* %8u %10u */\n",
+        best->eff_color_path,
+        best->eff_alpha_mode,
+        best->eff_fog_mode,
+        best->eff_fbz_mode,
+        best->eff_tex_mode_0,
+        best->eff_tex_mode_1,
+        best->polys,
+        best_hits);
+      entries++;
+    }
+  }
+  return entries;
+}
+
+
+/*-------------------------------------------------
+    write_rasterizer_profile - write the profile
+    header selected with vga: voodoo_profile=<file>
+-------------------------------------------------*/
+
+static void write_rasterizer_profile(voodoo_state *v, const char *filename)
+{
+  FILE *fp = fopen(filename, "w");
+  int entries;
+
+  if (fp == NULL)
+  {
+    BX_ERROR(("cannot create rasterizer profile '%s'", filename));
+    return;
+  }
+  fprintf(fp, "// Rasterizer profile written by the 3dfx Voodoo emulation. Each line is a\n");
+  fprintf(fp, "// configuration that was drawn with a generic rasterizer or that comes from\n");
+  fprintf(fp, "// the previous profile (polygons, pixels). Replace voodoo_raster_profile.h\n");
+  fprintf(fp, "// in iodev/display with this file and rebuild Bochs to specialize them.\n\n");
+  entries = dump_rasterizer_stats(v, fp);
+  fclose(fp);
+  BX_INFO(("rasterizer profile with %d entries written to '%s'", entries, filename));
+}
+
+
 /*-------------------------------------------------
     find_rasterizer - find a rasterizer that
     matches  our current parameters and return
@@ -470,16 +606,304 @@ BX_CPP_INLINE Bit32s round_coordinate(float value)
   return result + (value - (float)result > 0.5f);
 }
 
-Bit32u poly_render_triangle(void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3, poly_extra_data *extra)
+/*************************************
+ *
+ *  Polygon rasterizer threads
+ *
+ *************************************/
+
+/* compute the X extent of a triangle scanline */
+BX_CPP_INLINE Bit32s poly_triangle_extent(const poly_work_item *item, Bit32s curscan, poly_extent *extent)
+{
+  float fully = (float)curscan + 0.5f;
+  float startx = item->v1.x + (fully - item->v1.y) * item->dxdy_v1v3;
+  float stopx;
+  Bit32s istartx, istopx;
+
+  /* compute the ending X based on which part of the triangle we're in */
+  if (fully < item->v2.y)
+    stopx = item->v1.x + (fully - item->v1.y) * item->dxdy_v1v2;
+  else
+    stopx = item->v2.x + (fully - item->v2.y) * item->dxdy_v2v3;
+
+  /* clamp to full pixels */
+  istartx = round_coordinate(startx);
+  istopx = round_coordinate(stopx);
+
+  /* force start < stop */
+  if (istartx > istopx)
+  {
+    Bit32s temp = istartx;
+    istartx = istopx;
+    istopx = temp;
+  }
+
+  /* apply left/right clipping */
+  if (item->clip)
+  {
+    if (istartx < item->cliprect.min_x)
+      istartx = item->cliprect.min_x;
+    if (istopx > item->cliprect.max_x)
+      istopx = item->cliprect.max_x + 1;
+  }
+
+  /* set the extent and return the pixel count */
+  if (istartx >= istopx)
+    istartx = istopx = 0;
+  extent->startx = istartx;
+  extent->stopx = istopx;
+  return istopx - istartx;
+}
+
+/* number of pixels in each scanline of a custom item */
+BX_CPP_INLINE Bit32s poly_custom_width(const poly_work_item *item)
+{
+  Bit32s istartx = item->extent.startx, istopx = item->extent.stopx;
+
+  /* force start < stop */
+  if (istartx > istopx)
+  {
+    Bit32s temp = istartx;
+    istartx = istopx;
+    istopx = temp;
+  }
+
+  /* apply left/right clipping */
+  if (item->clip)
+  {
+    if (istartx < item->cliprect.min_x)
+      istartx = item->cliprect.min_x;
+    if (istopx > item->cliprect.max_x)
+      istopx = item->cliprect.max_x + 1;
+  }
+
+  return (istartx < istopx) ? (istopx - istartx) : 0;
+}
+
+/* render the scanlines of a work item; a rasterizer thread only renders the */
+/* bands it owns, so each scanline is always drawn by the same thread in order */
+static Bit32u poly_render_item(const poly_work_item *item, const poly_extra_data *extra, int threadid, int nthreads)
+{
+  poly_extent extent;
+  Bit32s curscan;
+  Bit32u pixels = 0;
+
+  for (curscan = item->miny; curscan < item->maxy; curscan++)
+  {
+    if ((nthreads > 1) && ((int)(((Bit32u)curscan >> POLY_BAND_SHIFT) % nthreads) != threadid))
+      continue;
+
+    if (item->custom)
+    {
+      (item->callback)(item->dest, curscan, &item->extent, extra, threadid);
+      pixels += poly_custom_width(item);
+    }
+    else
+    {
+      pixels += poly_triangle_extent(item, curscan, &extent);
+      (item->callback)(item->dest, curscan, &extent, extra, threadid);
+    }
+  }
+  return pixels;
+}
+
+/* number of items not yet finished by the slowest thread (lock held) */
+static Bit32u poly_pending(poly_manager *poly)
+{
+  Bit32u pending = 0;
+
+  for (int i = 0; i < poly->nthreads; i++)
+  {
+    if (poly->head - poly->thread[i].tail > pending)
+      pending = poly->head - poly->thread[i].tail;
+  }
+  return pending;
+}
+
+/* return the item to fill in: a free slot of the ring, or 'local' if the */
+/* polygon is rendered on the emulation thread */
+static poly_work_item *poly_get_item(poly_manager *poly, poly_work_item *local)
+{
+  if (poly == NULL)
+    return local;
+
+  BX_LOCK(poly->lock);
+  while (poly_pending(poly) >= POLY_MAX_ITEMS)
+  {
+    poly->waiting = 1;
+    BX_COND_WAIT(poly->done, poly->lock);
+  }
+  BX_UNLOCK(poly->lock);
+  return &poly->item[poly->head % POLY_MAX_ITEMS];
+}
+
+/* hand the item returned by poly_get_item() to the threads */
+static void poly_queue_item(poly_manager *poly)
+{
+  BX_LOCK(poly->lock);
+  poly->head++;
+  for (int i = 0; i < poly->nthreads; i++)
+  {
+    if (poly->thread[i].waiting)
+    {
+      poly->thread[i].waiting = 0;
+      BX_COND_SIGNAL(poly->thread[i].cond);
+    }
+  }
+  BX_UNLOCK(poly->lock);
+}
+
+/* wait until all queued polygons are rendered */
+void poly_wait(poly_manager *poly, const char *debug_reason)
+{
+  if ((poly == NULL) || (poly->fenced == poly->head))
+    return;
+
+  if (LOG_WAITS) BX_DEBUG(("poly_wait: %s", debug_reason));
+  BX_LOCK(poly->lock);
+  while (poly_pending(poly) > 0)
+  {
+    poly->waiting = 1;
+    BX_COND_WAIT(poly->done, poly->lock);
+  }
+  BX_UNLOCK(poly->lock);
+  poly->fenced = poly->head;
+}
+
+static void poly_thread_loop(poly_thread_info *t)
+{
+  poly_manager *poly = t->poly;
+  Bit32u tail, head;
+
+  BX_LOCK(poly->lock);
+  while (1)
+  {
+    while ((t->tail == poly->head) && !poly->quit)
+    {
+      t->waiting = 1;
+      BX_COND_WAIT(t->cond, poly->lock);
+    }
+    if (t->tail == poly->head)
+      break;
+
+    /* report progress in steps so that a full ring drains early */
+    tail = t->tail;
+    head = poly->head;
+    if (head - tail > POLY_MAX_ITEMS / 4)
+      head = tail + POLY_MAX_ITEMS / 4;
+    BX_UNLOCK(poly->lock);
+
+    for (; tail != head; tail++)
+    {
+      const poly_work_item *item = &poly->item[tail % POLY_MAX_ITEMS];
+      Bit32u pixels = poly_render_item(item, &item->extra, t->index, poly->nthreads);
+      /* fast fills have no rasterizer info */
+      if (!item->custom)
+        item->extra.info->thread_hits[t->index] += pixels;
+    }
+
+    BX_LOCK(poly->lock);
+    t->tail = tail;
+    if (poly->waiting)
+    {
+      poly->waiting = 0;
+      BX_COND_SIGNAL(poly->done);
+    }
+  }
+  BX_UNLOCK(poly->lock);
+}
+
+static BX_THREAD_FUNC(poly_thread, indata)
+{
+  poly_thread_loop((poly_thread_info*)indata);
+  BX_THREAD_EXIT;
+}
+
+/* start the rasterizer threads; returns NULL to render on the emulation thread */
+poly_manager *poly_alloc(int nthreads)
+{
+  poly_manager *poly;
+  int i;
+
+  if (nthreads <= 0)
+    return NULL;
+  if (nthreads > WORK_MAX_THREADS)
+    nthreads = WORK_MAX_THREADS;
+
+  poly = new poly_manager;
+  poly->item = new poly_work_item[POLY_MAX_ITEMS];
+  poly->nthreads = 0;
+  poly->head = 0;
+  poly->fenced = 0;
+  poly->waiting = 0;
+  poly->quit = 0;
+  BX_INIT_MUTEX(poly->lock);
+  BX_INIT_COND(poly->done);
+
+  /* the threads only look at nthreads after taking the lock */
+  BX_LOCK(poly->lock);
+  for (i = 0; i < nthreads; i++)
+  {
+    poly_thread_info *t = &poly->thread[i];
+
+    t->poly = poly;
+    t->index = i;
+    t->tail = 0;
+    t->waiting = 0;
+    BX_INIT_COND(t->cond);
+    t->started = BX_THREAD_CREATE(poly_thread, t, t->tid);
+    if (!t->started)
+    {
+      BX_FINI_COND(t->cond);
+      BX_ERROR(("failed to create rasterizer thread %d", i));
+      break;
+    }
+  }
+  poly->nthreads = i;
+  BX_UNLOCK(poly->lock);
+
+  if (poly->nthreads == 0)
+  {
+    BX_FINI_COND(poly->done);
+    BX_FINI_MUTEX(poly->lock);
+    delete [] poly->item;
+    delete poly;
+    return NULL;
+  }
+  BX_INFO(("rasterizing with %d threads", poly->nthreads));
+  return poly;
+}
+
+void poly_free(poly_manager *poly)
+{
+  int i;
+
+  if (poly == NULL)
+    return;
+
+  BX_LOCK(poly->lock);
+  poly->quit = 1;
+  for (i = 0; i < poly->nthreads; i++)
+    BX_COND_SIGNAL(poly->thread[i].cond);
+  BX_UNLOCK(poly->lock);
+  for (i = 0; i < poly->nthreads; i++)
+  {
+    BX_THREAD_JOIN(poly->thread[i].tid);
+    BX_FINI_COND(poly->thread[i].cond);
+  }
+  BX_FINI_COND(poly->done);
+  BX_FINI_MUTEX(poly->lock);
+  delete [] poly->item;
+  delete poly;
+}
+
+Bit32u poly_render_triangle(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int paramcount, const poly_vertex *v1, const poly_vertex *v2, const poly_vertex *v3, poly_extra_data *extra)
 {
-  float dxdy_v1v2, dxdy_v1v3, dxdy_v2v3;
   const poly_vertex *tv;
-  Bit32s curscan, scaninc=1;
+  poly_work_item local, *item;
 
   Bit32s v1yclip, v3yclip;
-  Bit32s v1y, v3y /*, v1x */;
-  Bit32s pixels = 0;
-//  Bit32u startunit;
+  Bit32s v1y, v3y;
 
   /* first sort by Y */
   if (v2->y < v1->y)
@@ -502,7 +926,6 @@ Bit32u poly_render_triangle(void *dest, const rectangle *cliprect, poly_draw_sca
   }
 
   /* compute some integral X/Y vertex values */
-//  v1x = round_coordinate(v1->x);
   v1y = round_coordinate(v1->y);
   v3y = round_coordinate(v3->y);
 
@@ -517,107 +940,32 @@ Bit32u poly_render_triangle(void *dest, const rectangle *cliprect, poly_draw_sca
   if (v3yclip - v1yclip <= 0)
     return 0;
 
-  /* allocate a new polygon */
-//  polygon = allocate_polygon(poly, v1yclip, v3yclip);
-
   /* fill in the polygon information */
-  //polygon->poly = poly;
-  //polygon->dest = dest;
-  //polygon->callback = callback;
-  //polygon->extra = poly->extra[poly->extra_next - 1];
-  //polygon->numparams = paramcount;
-  //polygon->numverts = 3;
-
-  /* set the start X/Y coordinates */
-  //polygon->xorigin = v1x;
-  //polygon->yorigin = v1y;
+  item = poly_get_item(poly, &local);
+  item->dest = dest;
+  item->callback = callback;
+  item->miny = v1yclip;
+  item->maxy = v3yclip;
+  item->custom = 0;
+  item->clip = (cliprect != NULL);
+  if (cliprect != NULL)
+    item->cliprect = *cliprect;
+  item->v1 = *v1;
+  item->v2 = *v2;
 
   /* compute the slopes for each portion of the triangle */
-  dxdy_v1v2 = (v2->y == v1->y) ? 0.0f : (v2->x - v1->x) / (v2->y - v1->y);
-  dxdy_v1v3 = (v3->y == v1->y) ? 0.0f : (v3->x - v1->x) / (v3->y - v1->y);
-  dxdy_v2v3 = (v3->y == v2->y) ? 0.0f : (v3->x - v2->x) / (v3->y - v2->y);
-
-  /* compute the X extents for each scanline */
-//  startunit = poly->unit_next;
-
-//  tri_work_unit *unit = new tri_work_unit;
-  poly_extent extent;
-  int extnum=0;
-  for (curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
-  {
-//    Bit32u bucketnum = ((Bit32u)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
-//    Bit32u unit_index = poly->unit_next++;
-//    tri_work_unit *unit = &poly->unit[unit_index]->tri;
-
-
-    /* determine how much to advance to hit the next bucket */
-//    scaninc = SCANLINES_PER_BUCKET - (Bit32u)curscan % SCANLINES_PER_BUCKET;
-
-    /* fill in the work unit basics */
-//    unit->shared.polygon = polygon;
-//    unit->shared.count_next = MIN(v3yclip - curscan, scaninc);
-//    unit->shared.scanline = curscan;
-//    unit->shared.previtem = poly->unit_bucket[bucketnum];
-//    poly->unit_bucket[bucketnum] = unit_index;
-
-    /* iterate over extents */
-//    for (extnum = 0; extnum < unit->shared.count_next; extnum++)
-    {
-      float fully = (float)(curscan + extnum) + 0.5f;
-      float startx = v1->x + (fully - v1->y) * dxdy_v1v3;
-      float stopx;
-      Bit32s istartx, istopx;
-
-      /* compute the ending X based on which part of the triangle we're in */
-      if (fully < v2->y)
-        stopx = v1->x + (fully - v1->y) * dxdy_v1v2;
-      else
-        stopx = v2->x + (fully - v2->y) * dxdy_v2v3;
-
-      /* clamp to full pixels */
-      istartx = round_coordinate(startx);
-      istopx = round_coordinate(stopx);
-
-      /* force start < stop */
-      if (istartx > istopx)
-      {
-        Bit32s temp = istartx;
-        istartx = istopx;
-        istopx = temp;
-      }
+  item->dxdy_v1v2 = (v2->y == v1->y) ? 0.0f : (v2->x - v1->x) / (v2->y - v1->y);
+  item->dxdy_v1v3 = (v3->y == v1->y) ? 0.0f : (v3->x - v1->x) / (v3->y - v1->y);
+  item->dxdy_v2v3 = (v3->y == v2->y) ? 0.0f : (v3->x - v2->x) / (v3->y - v2->y);
 
-      /* include the right edge if requested */
-//      if (poly->flags & POLYFLAG_INCLUDE_RIGHT_EDGE)
-//        istopx++;
+  /* render it here and return the total number of pixels in the triangle */
+  if (item == &local)
+    return poly_render_item(item, extra, 0, 1);
 
-      /* apply left/right clipping */
-      if (cliprect != NULL)
-      {
-        if (istartx < cliprect->min_x)
-          istartx = cliprect->min_x;
-        if (istopx > cliprect->max_x)
-          istopx = cliprect->max_x + 1;
-      }
-
-      /* set the extent and update the total pixel count */
-      if (istartx >= istopx)
-        istartx = istopx = 0;
-//      unit->extent[extnum].startx = istartx;
-//      unit->extent[extnum].stopx = istopx;
-      extent.startx = istartx;
-      extent.stopx = istopx;
-      (callback)(dest,curscan,&extent,extra,0);
-
-      pixels += istopx - istartx;
-    }
-  }
-
-//  delete unit;
-
-  /* return the total number of pixels in the triangle */
-//  poly->triangles++;
-//  poly->pixels += pixels;
-  return pixels;
+  /* farm it out; the threads count the pixels in info->thread_hits */
+  item->extra = *extra;
+  poly_queue_item(poly);
+  return 0;
 }
 
 Bit32s triangle_create_work_item(/*voodoo_state *v,*/ Bit16u *drawbuf, int texcount)
@@ -695,9 +1043,19 @@ Bit32s triangle_create_work_item(/*voodoo_state *v,*/ Bit16u *drawbuf, int texco
     }
   }
 
+  /* the rotating stipple pattern advances with every pixel in drawing order, */
+  /* so these triangles are rasterized on this thread after the queued ones */
+  poly_manager *poly = v->poly;
+  if (FBZMODE_ENABLE_STIPPLE(v->reg[fbzMode].u) && !FBZMODE_STIPPLE_PATTERN(v->reg[fbzMode].u))
+  {
+    poly_wait(poly, "rotating stipple");
+    poly = NULL;
+  }
+
   /* farm the rasterization out to other threads */
   info->polys++;
-  retval = poly_render_triangle(drawbuf, NULL, info->callback, 0, &vert[0], &vert[1], &vert[2], &extra);
+  retval = poly_render_triangle(poly, drawbuf, NULL, info->callback, 0, &vert[0], &vert[1], &vert[2], &extra);
+  info->hits += retval;
 
 //  delete info;
 
@@ -914,13 +1272,11 @@ static void raster_fastfill(void *destbase, Bit32s y, const poly_extent *extent,
 }
 
 
-Bit32u poly_render_triangle_custom(/*poly_manager *poly, */void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int startscanline, int numscanlines, const poly_extent *extents, poly_extra_data *extra)
+/* render numscanlines scanlines that all share the same extent */
+Bit32u poly_render_triangle_custom(poly_manager *poly, void *dest, const rectangle *cliprect, poly_draw_scanline_func callback, int startscanline, int numscanlines, const poly_extent *extent, poly_extra_data *extra)
 {
-  Bit32s curscan, scaninc;
-//  polygon_info *polygon;
+  poly_work_item local, *item;
   Bit32s v1yclip, v3yclip;
-  Bit32s pixels = 0;
-//  Bit32u startunit;
 
   /* clip coordinates */
   if (cliprect != NULL)
@@ -936,83 +1292,25 @@ Bit32u poly_render_triangle_custom(/*poly_manager *poly, */void *dest, const rec
   if (v3yclip - v1yclip <= 0)
     return 0;
 
-  /* allocate a new polygon */
-//  polygon = allocate_polygon(poly, v1yclip, v3yclip);
-
   /* fill in the polygon information */
-  //polygon->poly = poly;
-  //polygon->dest = dest;
-  //polygon->callback = callback;
-  //polygon->extra = poly->extra[poly->extra_next - 1];
-  //polygon->numparams = 0;
-  //polygon->numverts = 3;
-
-  /* compute the X extents for each scanline */
-//  startunit = poly->unit_next;
-  for (curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
-  {
-//    Bit32u bucketnum = ((Bit32u)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
-//    Bit32u unit_index = poly->unit_next++;
-//    tri_work_unit *unit = &poly->unit[unit_index]->tri;
-//    tri_work_unit unit;
-
-    int extnum=0;
-
-    /* determine how much to advance to hit the next bucket */
-//    scaninc = SCANLINES_PER_BUCKET - (Bit32u)curscan % SCANLINES_PER_BUCKET;
-    scaninc = 1;
-
-    /* fill in the work unit basics */
-    //unit->shared.polygon = polygon;
-    //unit->shared.count_next = MIN(v3yclip - curscan, scaninc);
-    //unit->shared.scanline = curscan;
-    //unit->shared.previtem = poly->unit_bucket[bucketnum];
-    //poly->unit_bucket[bucketnum] = unit_index;
-
-    /* iterate over extents */
-//    for (extnum = 0; extnum < unit->shared.count_next; extnum++)
-    {
-      const poly_extent *extent = &extents[(curscan + extnum) - startscanline];
-      Bit32s istartx = extent->startx, istopx = extent->stopx;
-
-      /* force start < stop */
-      if (istartx > istopx)
-      {
-        Bit32s temp = istartx;
-        istartx = istopx;
-        istopx = temp;
-      }
-
-      /* apply left/right clipping */
-      if (cliprect != NULL)
-      {
-        if (istartx < cliprect->min_x)
-          istartx = cliprect->min_x;
-        if (istopx > cliprect->max_x)
-          istopx = cliprect->max_x + 1;
-      }
-
-      /* set the extent and update the total pixel count */
-//      unit.extent[extnum].startx = istartx;
-//      unit.extent[extnum].stopx = istopx;
-      (callback)(dest,curscan,extent,extra,0);
-      if (istartx < istopx)
-        pixels += istopx - istartx;
-    }
-  }
-#if KEEP_STATISTICS
-  poly->unit_max = MAX(poly->unit_max, poly->unit_next);
-#endif
-
+  item = poly_get_item(poly, &local);
+  item->dest = dest;
+  item->callback = callback;
+  item->miny = v1yclip;
+  item->maxy = v3yclip;
+  item->custom = 1;
+  item->extent = *extent;
+  item->clip = (cliprect != NULL);
+  if (cliprect != NULL)
+    item->cliprect = *cliprect;
 
-  /* enqueue the work items */
-//  if (poly->queue != NULL)
-//    osd_work_item_queue_multiple(poly->queue, poly_item_callback, poly->unit_next - startunit, poly->unit[startunit], poly->unit_size, WORK_ITEM_FLAG_AUTO_RELEASE);
+  /* render it here and return the total number of pixels in the object */
+  if (item == &local)
+    return poly_render_item(item, extra, 0, 1);
 
-  /* return the total number of pixels in the object */
-//  poly->triangles++;
-//  poly->pixels += pixels;
-  return pixels;
+  item->extra = *extra;
+  poly_queue_item(poly);
+  return poly_custom_width(item) * (v3yclip - v1yclip);
 }
 
 Bit32s fastfill(voodoo_state *v)
@@ -1021,11 +1319,11 @@ Bit32s fastfill(voodoo_state *v)
   int ex = (v->reg[clipLeftRight].u >> 0) & 0x3ff;
   int sy = (v->reg[clipLowYHighY].u >> 16) & 0x3ff;
   int ey = (v->reg[clipLowYHighY].u >> 0) & 0x3ff;
-  poly_extent extents[64];
+  poly_extent extent;
   Bit16u dithermatrix[16];
   Bit16u *drawbuf = NULL;
   Bit32u pixels = 0;
-  int extnum, x, y;
+  int x, y;
 
   /* if we're not clearing either, take no time */
   if (!FBZMODE_RGB_BUFFER_MASK(v->reg[fbzMode].u) && !FBZMODE_AUX_BUFFER_MASK(v->reg[fbzMode].u))
@@ -1068,23 +1366,15 @@ Bit32s fastfill(voodoo_state *v)
     }
   }
 
-  /* fill in a block of extents */
-  extents[0].startx = sx;
-  extents[0].stopx = ex;
-  for (extnum = 1; extnum < (int)ARRAY_LENGTH(extents); extnum++)
-    extents[extnum] = extents[0];
+  /* all scanlines share the same extent */
+  extent.startx = sx;
+  extent.stopx = ex;
 
   poly_extra_data extra; //(poly_extra_data *)poly_get_extra_data(v->poly);
-  /* iterate over blocks of extents */
-  for (y = sy; y < ey; y += ARRAY_LENGTH(extents))
-  {
-    int count = MIN(ey - y, (int) ARRAY_LENGTH(extents));
-
-    extra.state = v;
-    memcpy(extra.dither, dithermatrix, sizeof(extra.dither));
+  extra.state = v;
+  memcpy(extra.dither, dithermatrix, sizeof(extra.dither));
 
-    pixels += poly_render_triangle_custom(drawbuf, NULL, raster_fastfill, y, count, extents, &extra);
-  }
+  pixels = poly_render_triangle_custom(v->poly, drawbuf, NULL, raster_fastfill, sy, ey - sy, &extent, &extra);
 
   /* 2 pixels per clock */
   return pixels / 2;
@@ -1095,6 +1385,9 @@ void swap_buffers(voodoo_state *v)
   int count;
 //  if (LOG_VBLANK_SWAP) BX_DEBUG(("--- swap_buffers @ %d", video_screen_get_vpos(v->screen)));
 
+  /* the back buffer must be complete before it is displayed */
+  poly_wait(v->poly, "swap_buffers");
+
   /* force a partial update */
 //  video_screen_update_partial(v->screen, video_screen_get_vpos(v->screen));
   v->fbi.video_changed = 1;
@@ -1144,8 +1437,8 @@ void swap_buffers(voodoo_state *v)
 
   /* periodically log rasterizer info */
   v->stats.swaps++;
-//  if (LOG_RASTERIZERS && v->stats.swaps % 100 == 0)
-//    dump_rasterizer_stats(v);
+  if (LOG_RASTERIZERS && v->stats.swaps % 100 == 0)
+    dump_rasterizer_stats(v, NULL);
 
   /* update the statistics (debug) */
   if (v->stats.display)
@@ -2023,6 +2316,7 @@ void register_w(Bit32u offset, Bit32u data) {
       break;
 
     case trexInit1:
+      poly_wait(v->poly, v->regnames[regnum]);
       /* send tmu config data to the frame buffer */
       v->send_config = TREXINIT_SEND_TMU_CONFIG(data);
       goto default_case;
@@ -2862,6 +3156,8 @@ void voodoo_init()
   /* build the rasterizer table */
   for (info = predef_raster_table; info->callback; info++)
     add_rasterizer(v, info);
+  for (info = predef_profile_table; info->callback; info++)
+    add_rasterizer(v, info);
 
   /* create dithering tables */
   for (int val = 0; val < 256*16*2; val++)
@@ -2921,7 +3217,8 @@ void voodoo_init()
 
   v->tmu_config = 64;
 
-  v->thread_stats = new stats_block[16];
+  v->thread_stats = new stats_block[WORK_MAX_THREADS];
+  v->poly = poly_alloc(SIM->get_param_num(BXPN_VOODOO_THREADS)->get());
 
   soft_reset(v);
 }
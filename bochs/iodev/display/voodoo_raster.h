@@ -2,6 +2,11 @@
 // $Id$
 /////////////////////////////////////////////////////////////////////////
 
+// Specialized rasterizers, expanded at build time with the register values
+// below as constants. Configurations missing here fall back to the generic
+// rasterizers. Guest specific ones are added with voodoo_raster_profile.h,
+// which is written by 'vga: voodoo_profile=<file>' at exit.
+
 RASTERIZER_ENTRY( 0x00000001, 0x00000000, 0x00000000, 0x00000200, 0x00000000, 0x08241A00 ) 
 RASTERIZER_ENTRY( 0x00000001, 0x00000000, 0x00000000, 0x00000200, 0x08241A00, 0x08241A00 ) 
 RASTERIZER_ENTRY( 0x00000001, 0x00000000, 0x00000000, 0x00000300, 0x00000800, 0x00000800 ) 
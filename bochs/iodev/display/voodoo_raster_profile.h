@@ -0,0 +1,8 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+
+// Rasterizer profile: additional specialized rasterizers in the same form
+// as voodoo_raster.h. This file is replaced by the one written with
+// 'vga: voodoo_profile=<file>', which lists the configurations a guest drew
+// with the generic rasterizers. The default profile is empty.
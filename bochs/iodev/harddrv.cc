@@ -135,6 +135,7 @@ bx_hard_drive_c::~bx_hard_drive_c()
 {
   char  ata_name[20];
   bx_list_c *base;
+  bx_list_c *misc_rt = (bx_list_c*)SIM->get_param(BXPN_MENU_RUNTIME_MISC);
 
   for (Bit8u channel=0; channel<BX_MAX_ATA_CHANNEL; channel++) {
     for (Bit8u device=0; device<2; device ++) {
@@ -151,8 +152,11 @@ bx_hard_drive_c::~bx_hard_drive_c()
       base = (bx_list_c*) SIM->get_param(ata_name);
       SIM->get_param_string("path", base)->set_handler(NULL);
       SIM->get_param_enum("status", base)->set_handler(NULL);
+      sprintf(ata_name, "commit_ata%d_%s", channel, (device==0)?"master":"slave");
+      misc_rt->remove(ata_name);
     }
   }
+  misc_rt->remove("commit_rate");
   SIM->get_bochs_root()->remove("hard_drive");
   BX_DEBUG(("Exit"));
 }
@@ -310,6 +314,25 @@ void bx_hard_drive_c::init(void)
           BX_PANIC(("ata%d-%d: could not open hard drive image file '%s'", channel, device, SIM->get_param_string("path", base)->getptr()));
           return;
         }
+        if (image_mode == BX_HDIMAGE_MODE_UNDOABLE) {
+          // runtime options for merging the redolog into the base image
+          bx_list_c *misc_rt = (bx_list_c*)SIM->get_param(BXPN_MENU_RUNTIME_MISC);
+          if (misc_rt->get_by_name("commit_rate") == NULL) {
+            bx_param_num_c *rate = new bx_param_num_c(misc_rt,
+              "commit_rate",
+              "Redolog commit rate (KB/s)",
+              "Bandwidth limit for committing redologs (0 = unlimited)",
+              0, BX_MAX_BIT32U / 1024,
+              0);
+            rate->set_runtime_param(1);
+          }
+          char pname[20], label[48];
+          sprintf(pname, "commit_ata%d_%s", channel, device?"slave":"master");
+          sprintf(label, "Commit redolog of ata%d-%s", channel, device?"slave":"master");
+          bx_param_bool_c *commit = new bx_param_bool_c(misc_rt, pname, label,
+            "Merge the redolog into the base image while the simulation is running", 0);
+          commit->set_runtime_param(1);
+        }
         Bit32u image_caps = BX_HD_THIS channels[channel].drives[device].hdimage->get_capabilities();
 
         if ((image_caps & HDIMAGE_HAS_GEOMETRY) != 0) {
@@ -647,9 +670,11 @@ void bx_hard_drive_c::runtime_config_handler(void *this_ptr)
 
 void bx_hard_drive_c::runtime_config(void)
 {
-  char pname[16];
+  char pname[20];
   int handle;
   bx_bool status;
+  Bit32u rate;
+  bx_list_c *misc_rt = (bx_list_c*)SIM->get_param(BXPN_MENU_RUNTIME_MISC);
 
   for (Bit8u channel=0; channel<BX_MAX_ATA_CHANNEL; channel++) {
     for (Bit8u device=0; device<2; device++) {
@@ -664,6 +689,13 @@ void bx_hard_drive_c::runtime_config(void)
         }
         BX_HD_THIS channels[channel].drives[device].status_changed = 0;
       }
+      sprintf(pname, "commit_ata%d_%s", channel, device ? "slave":"master");
+      bx_param_bool_c *commit = (bx_param_bool_c*)misc_rt->get_by_name(pname);
+      if ((commit != NULL) && commit->get()) {
+        commit->set(0);
+        rate = SIM->get_param_num("commit_rate", misc_rt)->get();
+        BX_HD_THIS channels[channel].drives[device].hdimage->start_commit(rate * 1024);
+      }
     }
   }
 }
@@ -884,16 +916,36 @@ Bit32u bx_hard_drive_c::read(Bit32u address, unsigned io_len)
               }
             }
 
-            value32 = controller->buffer[index+increment];
-            increment++;
-            if (io_len >= 2) {
-              value32 |= (controller->buffer[index+increment] << 8);
-              increment++;
+#if BX_SUPPORT_REPEAT_SPEEDUPS
+            // Transfer the rest of the block, but not more than the current
+            // DRQ data block, at once
+            unsigned quantumsMax = controller->buffer_size - index;
+            if (quantumsMax > (BX_SELECTED_DRIVE(channel).atapi.drq_bytes - controller->drq_index))
+              quantumsMax = BX_SELECTED_DRIVE(channel).atapi.drq_bytes - controller->drq_index;
+            quantumsMax /= io_len;
+            if (DEV_bulk_io_quantum_requested() && (quantumsMax > 0)) {
+              DEV_bulk_io_quantum_transferred() = DEV_bulk_io_quantum_requested();
+              if (quantumsMax < DEV_bulk_io_quantum_transferred())
+                DEV_bulk_io_quantum_transferred() = quantumsMax;
+              increment = io_len * DEV_bulk_io_quantum_transferred();
+              memcpy((Bit8u*) DEV_bulk_io_host_addr(), &controller->buffer[index], increment);
+              DEV_bulk_io_host_addr() += increment;
+              value32 = 0; // Value returned not important;
             }
-            if (io_len == 4) {
-              value32 |= (controller->buffer[index+increment] << 16);
-              value32 |= (controller->buffer[index+increment+1] << 24);
-              increment += 2;
+            else
+#endif
+            {
+              value32 = controller->buffer[index+increment];
+              increment++;
+              if (io_len >= 2) {
+                value32 |= (controller->buffer[index+increment] << 8);
+                increment++;
+              }
+              if (io_len == 4) {
+                value32 |= (controller->buffer[index+increment] << 16);
+                value32 |= (controller->buffer[index+increment+1] << 24);
+                increment += 2;
+              }
             }
             controller->buffer_index = index + increment;
             controller->drq_index += increment;
@@ -2266,11 +2318,31 @@ void bx_hard_drive_c::write(Bit32u address, Bit32u value, unsigned io_len)
           }
           break;
 
-        // power management & flush cache stubs
-        case 0xE0: // STANDBY NOW
-        case 0xE1: // IDLE IMMEDIATE
         case 0xE7: // FLUSH CACHE
         case 0xEA: // FLUSH CACHE EXT
+          if (BX_SELECTED_IS_HD(channel)) {
+            Bit64u start_time = DISK_TRACE_TIME();
+            if (BX_SELECTED_DRIVE(channel).hdimage->flush() < 0) {
+              BX_ERROR(("could not flush hard drive image file"));
+              command_aborted(channel, value);
+              break;
+            }
+            if (DEV_hdimage_trace_enabled()) {
+              DEV_hdimage_trace_request((channel << 1) | BX_SLAVE_SELECTED(channel),
+                                        DISK_TRACE_FLUSH, 0, 0,
+                                        (Bit32u)(DISK_TRACE_TIME() - start_time), 1);
+            }
+          }
+          controller->status.busy = 0;
+          controller->status.drive_ready = 1;
+          controller->status.write_fault = 0;
+          controller->status.drq = 0;
+          raise_interrupt(channel);
+          break;
+
+        // power management stubs
+        case 0xE0: // STANDBY NOW
+        case 0xE1: // IDLE IMMEDIATE
           controller->status.busy = 0;
           controller->status.drive_ready = 1;
           controller->status.write_fault = 0;
@@ -3284,16 +3356,21 @@ bx_bool bx_hard_drive_c::ide_read_sector(Bit8u channel, Bit8u *buffer, Bit32u bu
   controller_t *controller = &BX_SELECTED_CONTROLLER(channel);
 
   Bit64s logical_sector = 0;
+  Bit64s first_sector = -1;
   Bit64s ret;
+  Bit64u start_time = 0;
+  bx_bool trace = DEV_hdimage_trace_enabled();
 
   int sector_count = (buffer_size / 512);
   Bit8u *bufptr = buffer;
+  if (trace) start_time = DISK_TRACE_TIME();
   do {
     if (!calculate_logical_address(channel, &logical_sector)) {
       BX_ERROR(("ide_read_sector() reached invalid sector %lu, aborting", (unsigned long)logical_sector));
       command_aborted(channel, controller->current_command);
       return 0;
     }
+    if (first_sector < 0) first_sector = logical_sector;
     ret = BX_SELECTED_DRIVE(channel).hdimage->lseek(logical_sector * 512, SEEK_SET);
     if (ret < 0) {
       BX_ERROR(("could not lseek() hard drive image file"));
@@ -3311,6 +3388,11 @@ bx_bool bx_hard_drive_c::ide_read_sector(Bit8u channel, Bit8u *buffer, Bit32u bu
     increment_address(channel, &logical_sector);
     bufptr += 512;
   } while (--sector_count > 0);
+  if (trace) {
+    DEV_hdimage_trace_request((channel << 1) | BX_SLAVE_SELECTED(channel),
+                              DISK_TRACE_READ, first_sector, buffer_size / 512,
+                              (Bit32u)(DISK_TRACE_TIME() - start_time), 1);
+  }
 
   return 1;
 }
@@ -3320,16 +3402,21 @@ bx_bool bx_hard_drive_c::ide_write_sector(Bit8u channel, Bit8u *buffer, Bit32u b
   controller_t *controller = &BX_SELECTED_CONTROLLER(channel);
 
   Bit64s logical_sector = 0;
+  Bit64s first_sector = -1;
   Bit64s ret;
+  Bit64u start_time = 0;
+  bx_bool trace = DEV_hdimage_trace_enabled();
 
   int sector_count = (buffer_size / 512);
   Bit8u *bufptr = buffer;
+  if (trace) start_time = DISK_TRACE_TIME();
   do {
     if (!calculate_logical_address(channel, &logical_sector)) {
       BX_ERROR(("ide_write_sector() reached invalid sector %lu, aborting", (unsigned long)logical_sector));
       command_aborted(channel, controller->current_command);
       return 0;
     }
+    if (first_sector < 0) first_sector = logical_sector;
     ret = BX_SELECTED_DRIVE(channel).hdimage->lseek(logical_sector * 512, SEEK_SET);
     if (ret < 0) {
       BX_ERROR(("could not lseek() hard drive image file at byte %lu", (unsigned long)logical_sector * 512));
@@ -3347,6 +3434,11 @@ bx_bool bx_hard_drive_c::ide_write_sector(Bit8u channel, Bit8u *buffer, Bit32u b
     increment_address(channel, &logical_sector);
     bufptr += 512;
   } while (--sector_count > 0);
+  if (trace) {
+    DEV_hdimage_trace_request((channel << 1) | BX_SLAVE_SELECTED(channel),
+                              DISK_TRACE_WRITE, first_sector, buffer_size / 512,
+                              (Bit32u)(DISK_TRACE_TIME() - start_time), 1);
+  }
 
   return 1;
 }
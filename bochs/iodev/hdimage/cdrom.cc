@@ -34,6 +34,8 @@
 #define LOG_THIS /* no SMF tricks here, not needed */
 
 #define BX_CD_FRAMESIZE 2048
+// number of frames read from the host at once
+#define BX_CD_CACHE_BLOCKS 32
 
 unsigned int bx_cdrom_count = 0;
 
@@ -51,6 +53,9 @@ cdrom_base_c::cdrom_base_c(const char *dev)
     path = strdup(dev);
   }
   using_file = 0;
+  read_cache = NULL;
+  cache_lba = 0;
+  cache_blocks = 0;
 }
 
 cdrom_base_c::~cdrom_base_c(void)
@@ -59,6 +64,8 @@ cdrom_base_c::~cdrom_base_c(void)
     close(fd);
   if (path)
     free(path);
+  if (read_cache)
+    delete [] read_cache;
   BX_DEBUG(("Exit"));
 }
 
@@ -70,6 +77,7 @@ bx_bool cdrom_base_c::insert_cdrom(const char *dev)
   // Load CD-ROM. Returns 0 if CD is not ready.
   if (dev != NULL) path = strdup(dev);
   BX_INFO(("load cdrom with path=%s", path));
+  cache_blocks = 0;
   // all platforms except win32
   fd = open(path, O_RDONLY);
   if (fd < 0) {
@@ -237,6 +245,7 @@ bx_bool BX_CPP_AttrRegparmN(3) cdrom_base_c::read_block(Bit8u* buf, Bit32u lba,
 
   off_t pos;
   ssize_t n = 0;
+  size_t count;
   Bit8u try_count = 3;
   Bit8u* buf1;
 
@@ -252,16 +261,33 @@ bx_bool BX_CPP_AttrRegparmN(3) cdrom_base_c::read_block(Bit8u* buf, Bit32u lba,
   } else {
     buf1 = buf;
   }
-  do {
-    pos = lseek(fd, (off_t) lba * BX_CD_FRAMESIZE, SEEK_SET);
-    if (pos < 0) {
-      BX_PANIC(("cdrom: read_block: lseek returned error."));
-    } else {
-      n = read(fd, (char*) buf1, BX_CD_FRAMESIZE);
+  if ((lba < cache_lba) || (lba >= (cache_lba + cache_blocks))) {
+    // Sequential reads are served from the cache, so read ahead a couple
+    // of frames with a single host request
+    if (read_cache == NULL) {
+      read_cache = new Bit8u[BX_CD_CACHE_BLOCKS * BX_CD_FRAMESIZE];
     }
-  } while ((n != BX_CD_FRAMESIZE) && (--try_count > 0));
+    cache_blocks = 0;
+    count = BX_CD_CACHE_BLOCKS * BX_CD_FRAMESIZE;
+    do {
+      pos = lseek(fd, (off_t) lba * BX_CD_FRAMESIZE, SEEK_SET);
+      if (pos < 0) {
+        BX_PANIC(("cdrom: read_block: lseek returned error."));
+      } else {
+        n = read(fd, (char*) read_cache, count);
+      }
+      // a device may fail reading beyond the last frame, so retry with one
+      count = BX_CD_FRAMESIZE;
+    } while ((n < BX_CD_FRAMESIZE) && (--try_count > 0));
+    if (n < BX_CD_FRAMESIZE) {
+      return 0;
+    }
+    cache_lba = lba;
+    cache_blocks = (Bit32u)(n / BX_CD_FRAMESIZE);
+  }
+  memcpy(buf1, read_cache + (lba - cache_lba) * BX_CD_FRAMESIZE, BX_CD_FRAMESIZE);
 
-  return (n == BX_CD_FRAMESIZE);
+  return 1;
 }
 
 Bit32u cdrom_base_c::capacity()
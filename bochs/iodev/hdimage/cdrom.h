@@ -26,7 +26,7 @@ extern unsigned int bx_cdrom_count;
 
 class cdrom_base_c : public logfunctions {
 public:
-  cdrom_base_c() {}
+  cdrom_base_c() : read_cache(NULL), cache_lba(0), cache_blocks(0) {}
   cdrom_base_c(const char *dev);
   virtual ~cdrom_base_c(void);
 
@@ -55,4 +55,8 @@ protected:
   int fd;
   char *path;
   bx_bool using_file;
+  // read-ahead cache for sequential access (cache_blocks = 0 means empty)
+  Bit8u *read_cache;
+  Bit32u cache_lba;
+  Bit32u cache_blocks;
 };
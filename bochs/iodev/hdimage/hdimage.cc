@@ -75,7 +75,65 @@ void libhdimage_LTX_plugin_fini(void)
 
 bx_hdimage_ctl_c::bx_hdimage_ctl_c()
 {
+  disk_trace_header_t header;
+
   put("hdimage", "IMG");
+  trace_fp = NULL;
+  trace_buffer = NULL;
+  trace_count = 0;
+  const char *fname = SIM->get_param_string(BXPN_DISK_TRACE_FILENAME)->getptr();
+  if ((strlen(fname) > 0) && (strcmp(fname, "-") != 0)) {
+    trace_fp = fopen(fname, "wb");
+    if (trace_fp == NULL) {
+      BX_PANIC(("Can not open disk trace file '%s'", fname));
+      return;
+    }
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DISK_TRACE_MAGIC, 8);
+    header.version = htod32(DISK_TRACE_VERSION);
+    header.record_size = htod32(sizeof(disk_trace_record_t));
+    fwrite(&header, sizeof(header), 1, trace_fp);
+    trace_buffer = new disk_trace_record_t[DISK_TRACE_ENTRIES];
+    BX_INFO(("Using disk trace file %s", fname));
+  }
+}
+
+bx_hdimage_ctl_c::~bx_hdimage_ctl_c()
+{
+  if (trace_fp != NULL) {
+    trace_flush();
+    fclose(trace_fp);
+    delete [] trace_buffer;
+  }
+}
+
+void bx_hdimage_ctl_c::trace_request(Bit8u device, Bit8u type, Bit64u lba, Bit32u sectors,
+                                     Bit32u latency, Bit8u queue_depth)
+{
+  if (trace_fp == NULL) return;
+
+  disk_trace_record_t *rec = &trace_buffer[trace_count];
+  rec->time = htod64(bx_pc_system.time_usec());
+  rec->lba = htod64(lba);
+  rec->sectors = htod32(sectors);
+  rec->latency = htod32(latency);
+  rec->device = device;
+  rec->type = type;
+  rec->queue_depth = queue_depth;
+  memset(rec->reserved, 0, sizeof(rec->reserved));
+  if (++trace_count == DISK_TRACE_ENTRIES) {
+    trace_flush();
+  }
+}
+
+void bx_hdimage_ctl_c::trace_flush()
+{
+  if (trace_count > 0) {
+    if (fwrite(trace_buffer, sizeof(disk_trace_record_t), trace_count, trace_fp) != trace_count) {
+      BX_ERROR(("failed to write disk trace records"));
+    }
+    trace_count = 0;
+  }
 }
 
 device_image_t* bx_hdimage_ctl_c::init_image(Bit8u image_mode, Bit64u disk_size, const char *journal)
@@ -172,6 +230,15 @@ int bx_write_image(int fd, Bit64s offset, void *buf, int count)
   return write(fd, buf, count);
 }
 
+int bx_sync_image(int fd)
+{
+#ifdef WIN32
+  return _commit(fd);
+#else
+  return fsync(fd);
+#endif
+}
+
 #ifndef WIN32
 int hdimage_open_file(const char *pathname, int flags, Bit64u *fsize, time_t *mtime)
 #else
@@ -496,6 +563,24 @@ ssize_t default_image_t::write(const void* buf, size_t count)
   return ::write(fd, (char*) buf, count);
 }
 
+int default_image_t::flush()
+{
+  return bx_sync_image(fd);
+}
+
+int default_image_t::discard(Bit64u offset, Bit64u count)
+{
+#if defined(linux) && defined(FALLOC_FL_PUNCH_HOLE)
+  if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)count) < 0) {
+    // the host file system may not support it
+    if ((errno != EOPNOTSUPP) && (errno != ENOSYS)) {
+      return -1;
+    }
+  }
+#endif
+  return 0;
+}
+
 int default_image_t::check_format(int fd, Bit64u imgsize)
 {
   char buffer[512];
@@ -682,6 +767,15 @@ ssize_t concat_image_t::write(const void* buf, size_t count)
   return ::write(fd, (char*) buf, count);
 }
 
+int concat_image_t::flush()
+{
+  for (int index = 0; index < maxfd; index++) {
+    if (bx_sync_image(fd_table[index]) < 0)
+      return -1;
+  }
+  return 0;
+}
+
 #ifndef BXIMAGE
 bx_bool concat_image_t::save_state(const char *backup_fname)
 {
@@ -1224,6 +1318,16 @@ ssize_t sparse_image_t::write(const void* buf, size_t count)
   return total_written;
 }
 
+int sparse_image_t::flush()
+{
+#ifdef _POSIX_MAPPED_FILES
+  // the page table updates in the mapping are only scheduled by write()
+  if ((mmap_header != NULL) && (msync(mmap_header, mmap_length, MS_SYNC) != 0))
+    return -1;
+#endif
+  return bx_sync_image(fd);
+}
+
 int sparse_image_t::check_format(int fd, Bit64u imgsize)
 {
   sparse_header_t temp_header;
@@ -1383,6 +1487,12 @@ redolog_t::redolog_t()
   extent_index = (Bit32u)0;
   extent_offset = (Bit32u)0;
   extent_next = (Bit32u)0;
+  bitmap_update = 1;
+  bitmap_dirty = 0;
+  bitmap_pos = -1;
+  catalog_dirty_min = 0xffffffff;
+  catalog_dirty_max = 0;
+  sync_needed = 0;
 }
 
 void redolog_t::print_header()
@@ -1461,6 +1571,14 @@ int redolog_t::make_header(const char* type, Bit64u size)
   BX_DEBUG(("redolog : each bitmap is %d blocks", bitmap_blocks));
   BX_DEBUG(("redolog : each extent is %d blocks", extent_blocks));
 
+  imagepos = 0;
+  bitmap_update = 1;
+  bitmap_dirty = 0;
+  bitmap_pos = -1;
+  catalog_dirty_min = 0xffffffff;
+  catalog_dirty_max = 0;
+  sync_needed = 0;
+
   return 0;
 }
 
@@ -1591,20 +1709,32 @@ int redolog_t::open(const char* filename, const char *type, int flags)
 
   imagepos = 0;
   bitmap_update = 1;
+  bitmap_dirty = 0;
+  bitmap_pos = -1;
+  catalog_dirty_min = 0xffffffff;
+  catalog_dirty_max = 0;
+  sync_needed = 0;
 
   return 0;
 }
 
 void redolog_t::close()
 {
-  if (fd >= 0)
+  if (fd >= 0) {
+    flush();
     ::close(fd);
+    fd = -1;
+  }
 
-  if (catalog != NULL)
+  if (catalog != NULL) {
     free(catalog);
+    catalog = NULL;
+  }
 
-  if (bitmap != NULL)
+  if (bitmap != NULL) {
     free(bitmap);
+    bitmap = NULL;
+  }
 }
 
 Bit64u redolog_t::get_size()
@@ -1673,19 +1803,17 @@ ssize_t redolog_t::read(void* buf, size_t count)
     return 0;
   }
 
-  bitmap_offset  = (Bit64s)STANDARD_HEADER_SIZE + (dtoh32(header.specific.catalog) * sizeof(Bit32u));
-  bitmap_offset += (Bit64s)512 * dtoh32(catalog[extent_index]) * (extent_blocks + bitmap_blocks);
-  block_offset    = bitmap_offset + ((Bit64s)512 * (bitmap_blocks + extent_offset));
+  bitmap_offset = get_bitmap_offset(dtoh32(catalog[extent_index]));
+  block_offset  = bitmap_offset + ((Bit64s)512 * (bitmap_blocks + extent_offset));
 
   BX_DEBUG(("redolog : bitmap offset is %x", (Bit32u)bitmap_offset));
   BX_DEBUG(("redolog : block offset is %x", (Bit32u)block_offset));
 
   if (bitmap_update) {
-    if (bx_read_image(fd, (off_t)bitmap_offset, bitmap,  dtoh32(header.specific.bitmap)) != (ssize_t)dtoh32(header.specific.bitmap)) {
+    if (!load_bitmap(bitmap_offset)) {
       BX_PANIC(("redolog : failed to read bitmap for extent %d", extent_index));
       return -1;
     }
-    bitmap_update = 0;
   }
 
   if (((bitmap[extent_offset/8] >> (extent_offset%8)) & 0x01) == 0x00) {
@@ -1703,10 +1831,8 @@ ssize_t redolog_t::read(void* buf, size_t count)
 
 ssize_t redolog_t::write(const void* buf, size_t count)
 {
-  Bit32u i;
-  Bit64s block_offset, bitmap_offset, catalog_offset;
+  Bit64s block_offset, bitmap_offset;
   ssize_t written;
-  bx_bool update_catalog = 0;
 
   if (count != 512) {
     BX_PANIC(("redolog : write() with count not 512"));
@@ -1723,69 +1849,131 @@ ssize_t redolog_t::write(const void* buf, size_t count)
 
     BX_DEBUG(("redolog : allocating new extent at %d", extent_next));
 
+    // The bitmap of the previous extent must reach the disk before the
+    // cached one is reused for the new extent
+    if (!flush_bitmap()) {
+      BX_PANIC(("redolog : failed to write bitmap"));
+      return -1;
+    }
+
     // Extent not allocated, allocate new
     catalog[extent_index] = htod32(extent_next);
+    if (extent_index < catalog_dirty_min) catalog_dirty_min = extent_index;
+    if (extent_index > catalog_dirty_max) catalog_dirty_max = extent_index;
 
     extent_next += 1;
 
-    char *zerobuffer = (char*)malloc(512);
-    memset(zerobuffer, 0, 512);
-
-    // Write bitmap
-    bitmap_offset  = (Bit64s)STANDARD_HEADER_SIZE + (dtoh32(header.specific.catalog) * sizeof(Bit32u));
-    bitmap_offset += (Bit64s)512 * dtoh32(catalog[extent_index]) * (extent_blocks + bitmap_blocks);
-    ::lseek(fd, (off_t)bitmap_offset, SEEK_SET);
-    for (i=0; i<bitmap_blocks; i++) {
-      ::write(fd, zerobuffer, 512);
-    }
-    // Write extent
-    for (i=0; i<extent_blocks; i++) {
-      ::write(fd, zerobuffer, 512);
-    }
-
-    free(zerobuffer);
-
-    update_catalog = 1;
+    // The new extent starts with an empty bitmap. It is written together
+    // with the catalog entry on the next flush, so there's no need to
+    // zero-fill the extent in the file.
+    memset(bitmap, 0, dtoh32(header.specific.bitmap));
+    bitmap_pos = get_bitmap_offset(dtoh32(catalog[extent_index]));
+    bitmap_dirty = 1;
+    bitmap_update = 0;
   }
 
-  bitmap_offset  = (Bit64s)STANDARD_HEADER_SIZE + (dtoh32(header.specific.catalog) * sizeof(Bit32u));
-  bitmap_offset += (Bit64s)512 * dtoh32(catalog[extent_index]) * (extent_blocks + bitmap_blocks);
-  block_offset    = bitmap_offset + ((Bit64s)512 * (bitmap_blocks + extent_offset));
+  bitmap_offset = get_bitmap_offset(dtoh32(catalog[extent_index]));
+  block_offset  = bitmap_offset + ((Bit64s)512 * (bitmap_blocks + extent_offset));
 
   BX_DEBUG(("redolog : bitmap offset is %x", (Bit32u)bitmap_offset));
   BX_DEBUG(("redolog : block offset is %x", (Bit32u)block_offset));
 
   // Write block
   written = bx_write_image(fd, (off_t)block_offset, (void*)buf, count);
+  sync_needed = 1;
 
-  // Write bitmap
+  // Update bitmap
   if (bitmap_update) {
-    if (bx_read_image(fd, (off_t)bitmap_offset, bitmap,  dtoh32(header.specific.bitmap)) != (ssize_t)dtoh32(header.specific.bitmap)) {
+    if (!load_bitmap(bitmap_offset)) {
       BX_PANIC(("redolog : failed to read bitmap for extent %d", extent_index));
       return 0;
     }
-    bitmap_update = 0;
   }
 
   // If bloc does not belong to extent yet
   if (((bitmap[extent_offset/8] >> (extent_offset%8)) & 0x01) == 0x00) {
     bitmap[extent_offset/8] |= 1 << (extent_offset%8);
-    bx_write_image(fd, (off_t)bitmap_offset, bitmap,  dtoh32(header.specific.bitmap));
+    bitmap_dirty = 1;
   }
 
-  // Write catalog
-  if (update_catalog) {
-    // FIXME if mmap
-    catalog_offset  = (Bit64s)STANDARD_HEADER_SIZE + (extent_index * sizeof(Bit32u));
+  if (written >= 0) lseek(512, SEEK_CUR);
 
-    BX_DEBUG(("redolog : writing catalog at offset %x", (Bit32u)catalog_offset));
+  return written;
+}
 
-    bx_write_image(fd, (off_t)catalog_offset, &catalog[extent_index], sizeof(Bit32u));
+Bit64s redolog_t::get_bitmap_offset(Bit32u index)
+{
+  Bit64s bitmap_offset;
+
+  bitmap_offset  = (Bit64s)STANDARD_HEADER_SIZE + (dtoh32(header.specific.catalog) * sizeof(Bit32u));
+  bitmap_offset += (Bit64s)512 * index * (extent_blocks + bitmap_blocks);
+  return bitmap_offset;
+}
+
+bx_bool redolog_t::load_bitmap(Bit64s bitmap_offset)
+{
+  if (bitmap_offset != bitmap_pos) {
+    if (!flush_bitmap()) {
+      return 0;
+    }
+    if (bx_read_image(fd, (off_t)bitmap_offset, bitmap, dtoh32(header.specific.bitmap)) != (ssize_t)dtoh32(header.specific.bitmap)) {
+      bitmap_pos = -1;
+      return 0;
+    }
+    bitmap_pos = bitmap_offset;
   }
+  bitmap_update = 0;
+  return 1;
+}
 
-  if (written >= 0) lseek(512, SEEK_CUR);
+bx_bool redolog_t::flush_bitmap()
+{
+  if (bitmap_dirty) {
+    BX_DEBUG(("redolog : writing bitmap at offset %x", (Bit32u)bitmap_pos));
+    if (bx_write_image(fd, (off_t)bitmap_pos, bitmap, dtoh32(header.specific.bitmap)) != (ssize_t)dtoh32(header.specific.bitmap)) {
+      return 0;
+    }
+    bitmap_dirty = 0;
+    sync_needed = 1;
+  }
+  return 1;
+}
 
-  return written;
+int redolog_t::flush()
+{
+  Bit64s catalog_offset;
+  Bit32u count;
+
+  if (fd < 0) {
+    return 0;
+  }
+  if (!flush_bitmap()) {
+    BX_ERROR(("redolog : failed to write bitmap"));
+    return -1;
+  }
+  if (catalog_dirty_min <= catalog_dirty_max) {
+    // extent data and bitmaps must be stable before the catalog refers to them
+    bx_sync_image(fd);
+
+    catalog_offset = (Bit64s)STANDARD_HEADER_SIZE + (catalog_dirty_min * sizeof(Bit32u));
+    count = (catalog_dirty_max - catalog_dirty_min + 1) * sizeof(Bit32u);
+
+    BX_DEBUG(("redolog : writing catalog at offset %x", (Bit32u)catalog_offset));
+
+    if (bx_write_image(fd, (off_t)catalog_offset, &catalog[catalog_dirty_min], count) != (ssize_t)count) {
+      BX_ERROR(("redolog : failed to write catalog"));
+      return -1;
+    }
+    catalog_dirty_min = 0xffffffff;
+    catalog_dirty_max = 0;
+    sync_needed = 1;
+  }
+  if (sync_needed) {
+    // the flush is complete when the metadata has reached the disk
+    bx_sync_image(fd);
+    sync_needed = 0;
+  }
+  return 0;
 }
 
 int redolog_t::check_format(int fd, const char *subtype)
@@ -1815,6 +2003,11 @@ int redolog_t::check_format(int fd, const char *subtype)
   return HDIMAGE_FORMAT_OK;
 }
 
+bx_bool redolog_t::extent_allocated(Bit32u index)
+{
+  return (dtoh32(catalog[index]) != REDOLOG_PAGE_NOT_ALLOCATED);
+}
+
 #ifdef BXIMAGE
 int redolog_t::commit(device_image_t *base_image)
 {
@@ -1822,6 +2015,13 @@ int redolog_t::commit(device_image_t *base_image)
   Bit32u i;
   Bit8u buffer[512];
 
+  // the bitmap buffer is used for scanning all extents below
+  if (flush() < 0) {
+    return -1;
+  }
+  bitmap_pos = -1;
+  bitmap_update = 1;
+
   printf("\nCommitting changes to base image file: [  0%%]");
 
   for (i = 0; i < dtoh32(header.specific.catalog); i++) {
@@ -1832,8 +2032,7 @@ int redolog_t::commit(device_image_t *base_image)
       Bit64s bitmap_offset;
       Bit32u bitmap_size, j;
 
-      bitmap_offset  = (Bit64s)STANDARD_HEADER_SIZE + (dtoh32(header.specific.catalog) * sizeof(Bit32u));
-      bitmap_offset += (Bit64s)512 * dtoh32(catalog[i]) * (extent_blocks + bitmap_blocks);
+      bitmap_offset = get_bitmap_offset(dtoh32(catalog[i]));
 
       // Read bitmap
       bitmap_size = dtoh32(header.specific.bitmap);
@@ -1879,8 +2078,36 @@ int redolog_t::commit(device_image_t *base_image)
 #ifndef BXIMAGE
 bx_bool redolog_t::save_state(const char *backup_fname)
 {
+  if (flush() < 0) {
+    return 0;
+  }
   return hdimage_backup_file(fd, backup_fname);
 }
+
+int redolog_t::clear()
+{
+  Bit32u i;
+
+  for (i = 0; i < dtoh32(header.specific.catalog); i++) {
+    catalog[i] = htod32(REDOLOG_PAGE_NOT_ALLOCATED);
+  }
+  catalog_dirty_min = 0;
+  catalog_dirty_max = dtoh32(header.specific.catalog) - 1;
+  extent_next = 0;
+  bitmap_dirty = 0;
+  bitmap_pos = -1;
+  bitmap_update = 1;
+  if (flush() < 0) {
+    return -1;
+  }
+#ifndef WIN32
+  // drop the extents
+  if (ftruncate(fd, (off_t)STANDARD_HEADER_SIZE + (dtoh32(header.specific.catalog) * sizeof(Bit32u))) < 0) {
+    BX_ERROR(("redolog : failed to truncate file"));
+  }
+#endif
+  return 0;
+}
 #endif
 
 /*** growing_image_t function definitions ***/
@@ -1941,6 +2168,11 @@ ssize_t growing_image_t::write(const void* buf, size_t count)
   return (ret < 0) ? ret : count;
 }
 
+int growing_image_t::flush()
+{
+  return redolog->flush();
+}
+
 int growing_image_t::check_format(int fd, Bit64u imgsize)
 {
   return redolog_t::check_format(fd, REDOLOG_SUBTYPE_GROWING);
@@ -2018,12 +2250,28 @@ undoable_image_t::undoable_image_t(const char* _redolog_name)
       redolog_name = strdup(_redolog_name);
     }
   }
+  position = 0;
+#ifndef BXIMAGE
+  base_name = NULL;
+  commit_pending = NULL;
+  commit_started = 0;
+  commit_running = 0;
+  commit_abort = 0;
+  commit_through = 0;
+  commit_status = 0;
+  commit_rate = 0;
+  commit_timer = BX_NULL_TIMER_HANDLE;
+  BX_INIT_MUTEX(commit_mutex);
+#endif
 }
 
 undoable_image_t::~undoable_image_t()
 {
   delete redolog;
   delete ro_disk;
+#ifndef BXIMAGE
+  BX_FINI_MUTEX(commit_mutex);
+#endif
 }
 
 int undoable_image_t::open(const char* pathname, int flags)
@@ -2040,6 +2288,11 @@ int undoable_image_t::open(const char* pathname, int flags)
   if (ro_disk == NULL) {
     return -1;
   }
+#ifndef BXIMAGE
+  // the base image may be reopened for a live commit
+  base_name = strdup(pathname);
+  pathname = base_name;
+#endif
   if (ro_disk->open(pathname, O_RDONLY) < 0)
     return -1;
 
@@ -2068,31 +2321,71 @@ int undoable_image_t::open(const char* pathname, int flags)
 
 void undoable_image_t::close()
 {
+#ifndef BXIMAGE
+  stop_commit();
+  if (commit_timer != BX_NULL_TIMER_HANDLE) {
+    bx_pc_system.unregisterTimer(commit_timer);
+    commit_timer = BX_NULL_TIMER_HANDLE;
+  }
+#endif
   redolog->close();
   ro_disk->close();
 
   if (redolog_name != NULL)
     free(redolog_name);
+#ifndef BXIMAGE
+  if (base_name != NULL) {
+    free(base_name);
+    base_name = NULL;
+  }
+#endif
 }
 
 Bit64s undoable_image_t::lseek(Bit64s offset, int whence)
 {
+  Bit64s ret;
+
+#ifndef BXIMAGE
+  BX_LOCK(commit_mutex);
+#endif
   redolog->lseek(offset, whence);
-  return ro_disk->lseek(offset, whence);
+  ret = ro_disk->lseek(offset, whence);
+  if (ret >= 0) position = ret;
+#ifndef BXIMAGE
+  BX_UNLOCK(commit_mutex);
+#endif
+  return ret;
 }
 
 ssize_t undoable_image_t::read(void* buf, size_t count)
 {
   size_t n = 0;
   ssize_t ret = 0;
+  bx_bool resync = 0;
 
+#ifndef BXIMAGE
+  BX_LOCK(commit_mutex);
+#endif
   while (n < count) {
-    if ((size_t)redolog->read((char*) buf, 512) != 512) {
-      ret = ro_disk->read((char*) buf, 512);
+    // only one of the images advances here, so keep the other one in sync
+    redolog->lseek(position, SEEK_SET);
+    if ((size_t)redolog->read((char*) buf + n, 512) != 512) {
+      if (resync) {
+        ro_disk->lseek(position, SEEK_SET);
+        resync = 0;
+      }
+      ret = ro_disk->read((char*) buf + n, 512);
       if (ret < 0) break;
+    } else {
+      resync = 1;
     }
+    position += 512;
     n += 512;
   }
+  if (resync) ro_disk->lseek(position, SEEK_SET);
+#ifndef BXIMAGE
+  BX_UNLOCK(commit_mutex);
+#endif
   return (ret < 0) ? ret : count;
 }
 
@@ -2101,22 +2394,63 @@ ssize_t undoable_image_t::write(const void* buf, size_t count)
   size_t n = 0;
   ssize_t ret = 0;
 
+#ifndef BXIMAGE
+  BX_LOCK(commit_mutex);
+#endif
+  redolog->lseek(position, SEEK_SET);
   while (n < count) {
-    ret = redolog->write((char*) buf, 512);
+#ifndef BXIMAGE
+    if (commit_through) {
+      // final commit pass: the base image is updated directly
+      if ((ro_disk->lseek(position, SEEK_SET) < 0) ||
+          (ro_disk->write((char*) buf + n, 512) != 512)) {
+        ret = -1;
+        break;
+      }
+    } else if (commit_pending != NULL) {
+      commit_pending[position / redolog->get_extent_size()] = 1;
+    }
+#endif
+    ret = redolog->write((char*) buf + n, 512);
     if (ret < 0) break;
+    position += 512;
     n += 512;
   }
+  ro_disk->lseek(position, SEEK_SET);
+#ifndef BXIMAGE
+  BX_UNLOCK(commit_mutex);
+#endif
   return (ret < 0) ? ret : count;
 }
 
+int undoable_image_t::flush()
+{
+  int ret;
+
+#ifndef BXIMAGE
+  BX_LOCK(commit_mutex);
+#endif
+  ret = redolog->flush();
+#ifndef BXIMAGE
+  BX_UNLOCK(commit_mutex);
+#endif
+  return ret;
+}
+
 #ifndef BXIMAGE
 bx_bool undoable_image_t::save_state(const char *backup_fname)
 {
-  return redolog->save_state(backup_fname);
+  bx_bool ret;
+
+  BX_LOCK(commit_mutex);
+  ret = redolog->save_state(backup_fname);
+  BX_UNLOCK(commit_mutex);
+  return ret;
 }
 
 void undoable_image_t::restore_state(const char *backup_fname)
 {
+  stop_commit();
   redolog_t *temp_redolog = new redolog_t();
   if (temp_redolog->open(backup_fname, REDOLOG_SUBTYPE_UNDOABLE, O_RDONLY) < 0) {
     delete temp_redolog;
@@ -2138,6 +2472,239 @@ void undoable_image_t::restore_state(const char *backup_fname)
     }
   }
 }
+
+bx_bool undoable_image_t::reopen_base(int flags)
+{
+  ro_disk->close();
+  if (ro_disk->open(base_name, flags) < 0) {
+    return 0;
+  }
+  ro_disk->lseek(position, SEEK_SET);
+  return 1;
+}
+
+// Result of the commit thread
+#define BX_COMMIT_RUNNING   0
+#define BX_COMMIT_FINISHED  1
+#define BX_COMMIT_FAILED    2
+#define BX_COMMIT_ABORTED   3
+
+bx_bool undoable_image_t::start_commit(Bit32u rate)
+{
+  Bit32u i, n;
+
+  if (commit_running) {
+    BX_ERROR(("commit of redolog '%s' already running", redolog_name));
+    return 0;
+  }
+  stop_commit();
+  if (commit_timer == BX_NULL_TIMER_HANDLE) {
+    commit_timer = bx_pc_system.register_timer(this, commit_timer_handler, 100000,
+                                               1, 0, "hdimage commit");
+  }
+  BX_LOCK(commit_mutex);
+  if (!reopen_base(O_RDWR)) {
+    BX_ERROR(("cannot open base image '%s' for writing", base_name));
+    if (!reopen_base(O_RDONLY)) {
+      BX_PANIC(("cannot reopen base image '%s'", base_name));
+    }
+    BX_UNLOCK(commit_mutex);
+    return 0;
+  }
+  // The base image and the redolog don't match until the job has finished.
+  // Reading through the redolog is still coherent at any time, so the check
+  // is disabled for the case that the simulation is interrupted.
+  redolog->set_timestamp(0);
+  n = redolog->get_catalog_size();
+  commit_pending = new Bit8u[n];
+  for (i = 0; i < n; i++) {
+    commit_pending[i] = redolog->extent_allocated(i);
+  }
+  commit_rate = rate;
+  commit_abort = 0;
+  commit_through = 0;
+  commit_status = BX_COMMIT_RUNNING;
+  commit_running = 1;
+  if (!BX_THREAD_CREATE(commit_thread, this, commit_tid)) {
+    BX_ERROR(("failed to create commit thread"));
+    delete [] commit_pending;
+    commit_pending = NULL;
+    commit_running = 0;
+    reopen_base(O_RDONLY);
+    BX_UNLOCK(commit_mutex);
+    return 0;
+  }
+  commit_started = 1;
+  BX_UNLOCK(commit_mutex);
+  bx_pc_system.activate_timer(commit_timer, 100000, 1);
+  BX_INFO(("started commit of redolog '%s' to '%s'", redolog_name, base_name));
+  return 1;
+}
+
+void undoable_image_t::stop_commit()
+{
+  if (commit_started) {
+    commit_abort = 1;
+    BX_THREAD_JOIN(commit_tid);
+    commit_done();
+  }
+}
+
+// Called on the emulation thread when the commit thread has terminated:
+// report the result and switch the base image back to read-only mode.
+void undoable_image_t::commit_done()
+{
+  bx_pc_system.deactivate_timer(commit_timer);
+  BX_LOCK(commit_mutex);
+  switch (commit_status) {
+    case BX_COMMIT_FINISHED:
+      BX_INFO(("commit of redolog '%s' finished", redolog_name));
+      break;
+    case BX_COMMIT_ABORTED:
+      BX_INFO(("commit of redolog '%s' aborted", redolog_name));
+      break;
+    default:
+      BX_ERROR(("commit of redolog '%s' failed", redolog_name));
+  }
+  commit_through = 0;
+  if (!reopen_base(O_RDONLY)) {
+    BX_PANIC(("cannot reopen base image '%s'", base_name));
+  } else if (commit_status == BX_COMMIT_FINISHED) {
+    redolog->set_timestamp(ro_disk->get_timestamp());
+  }
+  delete [] commit_pending;
+  commit_pending = NULL;
+  commit_started = 0;
+  BX_UNLOCK(commit_mutex);
+}
+
+void undoable_image_t::commit_timer_handler(void *this_ptr)
+{
+  undoable_image_t *class_ptr = (undoable_image_t*)this_ptr;
+
+  if (class_ptr->commit_started && !class_ptr->commit_running) {
+    BX_THREAD_JOIN(class_ptr->commit_tid);
+    class_ptr->commit_done();
+  }
+}
+
+BX_THREAD_FUNC(undoable_image_t::commit_thread, indata)
+{
+  ((undoable_image_t*)indata)->commit_worker();
+  BX_THREAD_EXIT;
+}
+
+// Number of blocks copied per lock hold
+#define BX_COMMIT_CHUNK     128
+// From this pass on guest writes go to the base image, too
+#define BX_COMMIT_PASSES    8
+
+// Copy up to BX_COMMIT_CHUNK blocks of an extent starting at *block to the
+// base image. Must be called with the mutex held.
+bx_bool undoable_image_t::commit_blocks(Bit32u index, Bit32u *block, Bit32u *bytes)
+{
+  Bit8u buffer[512];
+  Bit32u count = 0;
+  Bit32u blocks = redolog->get_extent_size() / 512;
+  Bit64s offset;
+
+  *bytes = 0;
+  while ((*block < blocks) && (count < BX_COMMIT_CHUNK)) {
+    offset = (Bit64s)index * redolog->get_extent_size() + (Bit64s)512 * *block;
+    if (offset >= (Bit64s)hd_size) {
+      // last extent may exceed the disk size
+      *block = blocks;
+      break;
+    }
+    redolog->lseek(offset, SEEK_SET);
+    if (redolog->read(buffer, 512) == 512) {
+      if ((ro_disk->lseek(offset, SEEK_SET) < 0) ||
+          (ro_disk->write(buffer, 512) != 512)) {
+        return 0;
+      }
+      *bytes += 512;
+    }
+    (*block)++;
+    count++;
+  }
+  redolog->lseek(position, SEEK_SET);
+  ro_disk->lseek(position, SEEK_SET);
+  return 1;
+}
+
+// Wait for the time the transfer of 'bytes' takes at the configured rate.
+// The sleep is split into short slices to react on an abort request.
+void undoable_image_t::commit_throttle(Bit32u bytes)
+{
+  Bit64u msec, slice;
+
+  if ((commit_rate == 0) || (bytes == 0)) return;
+  msec = (Bit64u)bytes * 1000 / commit_rate;
+  while ((msec > 0) && !commit_abort) {
+    slice = (msec > 10) ? 10 : msec;
+    BX_MSLEEP((Bit32u)slice);
+    msec -= slice;
+  }
+}
+
+// The commit thread must not log: the result is stored in commit_status and
+// reported by commit_done() on the emulation thread.
+void undoable_image_t::commit_worker()
+{
+  Bit32u i, n, block, bytes, pass = 0;
+  bx_bool pending, okay = 1;
+
+  n = redolog->get_catalog_size();
+  do {
+    if (++pass == BX_COMMIT_PASSES) {
+      // Don't let a guest writing all the time delay the job forever: from
+      // now on guest writes don't mark their extent pending again
+      BX_LOCK(commit_mutex);
+      commit_through = 1;
+      BX_UNLOCK(commit_mutex);
+    }
+    for (i = 0; (i < n) && okay && !commit_abort; i++) {
+      BX_LOCK(commit_mutex);
+      if (commit_pending[i] && redolog->extent_allocated(i)) {
+        commit_pending[i] = 0;
+        block = 0;
+        do {
+          okay = commit_blocks(i, &block, &bytes);
+          BX_UNLOCK(commit_mutex);
+          commit_throttle(bytes);
+          BX_LOCK(commit_mutex);
+        } while (okay && !commit_abort && (block < (redolog->get_extent_size() / 512)));
+      }
+      BX_UNLOCK(commit_mutex);
+    }
+    BX_LOCK(commit_mutex);
+    // extents written while the lock was released need another pass
+    pending = 0;
+    for (i = 0; (i < n) && !pending; i++) {
+      pending = commit_pending[i] && redolog->extent_allocated(i);
+    }
+    if (okay && !commit_abort && !pending) {
+      // Everything is in the base image now: make it stable before the
+      // redolog is emptied
+      if ((ro_disk->flush() < 0) || (redolog->clear() < 0)) {
+        okay = 0;
+      }
+      break;
+    }
+    if (!okay || commit_abort) break;
+    BX_UNLOCK(commit_mutex);
+  } while (1);
+  // the mutex is held here
+  if (!okay) {
+    commit_status = BX_COMMIT_FAILED;
+  } else if (commit_abort) {
+    commit_status = BX_COMMIT_ABORTED;
+  } else {
+    commit_status = BX_COMMIT_FINISHED;
+  }
+  commit_running = 0;
+  BX_UNLOCK(commit_mutex);
+}
 #endif
 
 /*** volatile_image_t function definitions ***/
@@ -2265,6 +2832,11 @@ ssize_t volatile_image_t::write(const void* buf, size_t count)
   return (ret < 0) ? ret : count;
 }
 
+int volatile_image_t::flush()
+{
+  return redolog->flush();
+}
+
 #ifndef BXIMAGE
 bx_bool volatile_image_t::save_state(const char *backup_fname)
 {
@@ -115,6 +115,40 @@
    Bit8u padding[STANDARD_HEADER_SIZE - (sizeof (standard_header_t) + sizeof (redolog_specific_header_v1_t))];
  } redolog_header_v1_t;
 
+// DISK I/O TRACE FILE
+#define DISK_TRACE_MAGIC      "BXDTRACE"
+#define DISK_TRACE_VERSION    (0x00010000)
+
+// request types
+#define DISK_TRACE_READ       0
+#define DISK_TRACE_WRITE      1
+#define DISK_TRACE_FLUSH      2
+
+// device numbers (ATA devices use channel * 2 + drive)
+#define DISK_TRACE_DEV_SCSI   0x80
+#define DISK_TRACE_DEV_VIRTIO 0x81
+#define DISK_TRACE_DEV_AHCI   0x90 // + port number
+
+ // WARNING : trace records are kept in x86 (little) endianness
+ typedef struct
+ {
+   Bit8u   magic[8];
+   Bit32u  version;
+   Bit32u  record_size;
+ } disk_trace_header_t;
+
+ typedef struct
+ {
+   Bit64u  time;         // emulated time in usec
+   Bit64u  lba;          // first sector
+   Bit32u  sectors;      // number of sectors
+   Bit32u  latency;      // host time spent in the image code in usec
+   Bit8u   device;       // device number
+   Bit8u   type;         // request type
+   Bit8u   queue_depth;  // outstanding requests including this one
+   Bit8u   reserved[5];
+ } disk_trace_record_t;
+
 // htod : convert host to disk (little) endianness
 // dtoh : convert disk (little) to host endianness
 #if defined (BX_LITTLE_ENDIAN)
@@ -135,11 +169,16 @@
 
 #ifndef HDIMAGE_HEADERS_ONLY
 
+#ifndef BXIMAGE
+#include "bxthread.h"
+#endif
+
 class device_image_t;
 class redolog_t;
 
 int bx_read_image(int fd, Bit64s offset, void *buf, int count);
 int bx_write_image(int fd, Bit64s offset, void *buf, int count);
+int bx_sync_image(int fd);
 #ifndef WIN32
 int hdimage_open_file(const char *pathname, int flags, Bit64u *fsize, time_t *mtime);
 #else
@@ -187,6 +226,15 @@ class device_image_t
       // Get image capabilities
       virtual Bit32u get_capabilities();
 
+      // Write back cached data / metadata to the image file. Returns
+      // non-negative if successful.
+      virtual int flush() {return 0;}
+
+      // The guest no longer needs count bytes at offset. The data may be
+      // deallocated (reads return undefined data). Returns non-negative if
+      // successful.
+      virtual int discard(Bit64u offset, Bit64u count) {return 0;}
+
       // Get modification time in FAT format
       Bit32u get_timestamp();
 
@@ -198,6 +246,11 @@ class device_image_t
       virtual void register_state(bx_list_c *parent);
       virtual bx_bool save_state(const char *backup_fname) {return 0;}
       virtual void restore_state(const char *backup_fname) {}
+
+      // Start merging pending changes into the base image while the guest
+      // keeps running (rate in bytes per second, 0 = unlimited). Returns
+      // non-zero if the job has been started.
+      virtual bx_bool start_commit(Bit32u rate) {return 0;}
 #endif
 
       unsigned cylinders;
@@ -234,6 +287,12 @@ class default_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Write back cached data to the image file
+      int flush();
+
+      // Punch a hole into the image file (if supported by the host)
+      int discard(Bit64u offset, Bit64u count);
+
       // Check image format
       static int check_format(int fd, Bit64u imgsize);
 
@@ -273,6 +332,9 @@ class concat_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Write back cached data to all image files
+      int flush();
+
 #ifndef BXIMAGE
       // Save/restore support
       bx_bool save_state(const char *backup_fname);
@@ -332,6 +394,9 @@ class sparse_image_t : public device_image_t
     // written (count).
     ssize_t write(const void* buf, size_t count);
 
+    // Write back the page table and cached data to the image file
+    int flush();
+
     // Check image format
     static int check_format(int fd, Bit64u imgsize);
 
@@ -437,22 +502,40 @@ class redolog_t
       Bit64s lseek(Bit64s offset, int whence);
       ssize_t read(void* buf, size_t count);
       ssize_t write(const void* buf, size_t count);
+      int flush();
 
       static int check_format(int fd, const char *subtype);
 
+      Bit32u get_catalog_size() {return dtoh32(header.specific.catalog);}
+      Bit32u get_extent_size() {return dtoh32(header.specific.extent);}
+      bx_bool extent_allocated(Bit32u index);
+
 #ifdef BXIMAGE
       int commit(device_image_t *base_image);
 #else
       bx_bool save_state(const char *backup_fname);
+      int clear();
 #endif
 
   private:
       void             print_header();
+      Bit64s           get_bitmap_offset(Bit32u index);
+      bx_bool          load_bitmap(Bit64s bitmap_offset);
+      bx_bool          flush_bitmap();
       int              fd;
       redolog_header_t header;     // Header is kept in x86 (little) endianness
       Bit32u          *catalog;
       Bit8u           *bitmap;
       bx_bool          bitmap_update;
+      // The catalog and the bitmap of the current extent are written back
+      // lazily (write-back). On flush the bitmap is stored before the dirty
+      // part of the catalog, so that the catalog on disk never refers to an
+      // extent without a valid bitmap.
+      bx_bool          bitmap_dirty;
+      Bit64s           bitmap_pos;  // file offset of the cached bitmap (-1 = none)
+      Bit32u           catalog_dirty_min;
+      Bit32u           catalog_dirty_max;
+      bx_bool          sync_needed; // data or metadata written since the last sync
       Bit32u           extent_index;
       Bit32u           extent_offset;
       Bit32u           extent_next;
@@ -489,6 +572,9 @@ class growing_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Write back the redolog metadata
+      int flush();
+
       // Check image format
       static int check_format(int fd, Bit64u imgsize);
 
@@ -529,16 +615,51 @@ class undoable_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Write back the redolog metadata
+      int flush();
+
 #ifndef BXIMAGE
       // Save/restore support
       bx_bool save_state(const char *backup_fname);
       void restore_state(const char *backup_fname);
+
+      // Live commit of the redolog into the base image
+      bx_bool start_commit(Bit32u rate);
 #endif
 
   private:
       redolog_t       *redolog;       // Redolog instance
       device_image_t  *ro_disk;       // Read-only base disk instance
       char            *redolog_name;  // Redolog name
+      Bit64s           position;      // Current image position
+#ifndef BXIMAGE
+      static BX_THREAD_FUNC(commit_thread, indata);
+      static void commit_timer_handler(void *this_ptr);
+      void commit_worker();
+      void commit_throttle(Bit32u bytes);
+      void commit_done();
+      bx_bool commit_blocks(Bit32u index, Bit32u *block, Bit32u *bytes);
+      bx_bool reopen_base(int flags);
+      void stop_commit();
+
+      char            *base_name;     // Base image path name
+      // The commit thread copies the extents marked pending to the base image
+      // and clears the redolog when a full pass finds nothing left to do.
+      // Guest writes mark their extent pending again, in the final pass they
+      // are written to the base image directly. All accesses to the redolog
+      // and the base image are serialized with the mutex. A timer checks for
+      // the end of the job and reports it on the emulation thread.
+      BX_MUTEX(commit_mutex);
+      BX_THREAD_ID(commit_tid);
+      Bit8u           *commit_pending;
+      bx_bool          commit_started;
+      volatile bx_bool commit_running;
+      volatile bx_bool commit_abort;
+      bx_bool          commit_through;
+      Bit8u            commit_status;
+      Bit32u           commit_rate;
+      int              commit_timer;
+#endif
 };
 
 
@@ -568,6 +689,9 @@ class volatile_image_t : public device_image_t
       // written (count).
       ssize_t write(const void* buf, size_t count);
 
+      // Write back the redolog metadata
+      int flush();
+
 #ifndef BXIMAGE
       // Save/restore support
       bx_bool save_state(const char *backup_fname);
@@ -583,12 +707,31 @@ class volatile_image_t : public device_image_t
 
 
 #ifndef BXIMAGE
+// number of trace records buffered before they are written to the file
+#define DISK_TRACE_ENTRIES 4096
+
+// host time stamp for measuring the backend latency
+#if BX_HAVE_REALTIME_USEC
+#define DISK_TRACE_TIME() bx_get_realtime64_usec()
+#else
+#define DISK_TRACE_TIME() 0
+#endif
+
 class bx_hdimage_ctl_c : public bx_hdimage_ctl_stub_c {
 public:
   bx_hdimage_ctl_c();
-  virtual ~bx_hdimage_ctl_c() {}
+  virtual ~bx_hdimage_ctl_c();
   virtual device_image_t *init_image(Bit8u image_mode, Bit64u disk_size, const char *journal);
   virtual cdrom_base_c *init_cdrom(const char *dev);
+  virtual bx_bool trace_enabled() {return (trace_fp != NULL);}
+  virtual void trace_request(Bit8u device, Bit8u type, Bit64u lba, Bit32u sectors,
+                             Bit32u latency, Bit8u queue_depth);
+private:
+  void trace_flush();
+
+  FILE *trace_fp;
+  disk_trace_record_t *trace_buffer;
+  unsigned trace_count;
 };
 #endif // BXIMAGE
 
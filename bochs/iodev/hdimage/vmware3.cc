@@ -522,6 +522,22 @@ void vmware3_image_t::close()
     current = 0;
 }
 
+int vmware3_image_t::flush()
+{
+    if(current == 0)
+        return 0;
+    if(!sync())
+        return -1;
+    unsigned count = current->header.number_of_chains;
+    if (count < 1) count = 1;
+    for(unsigned i = 0; i < count; ++i)
+    {
+        if(bx_sync_image(images[i].fd) < 0)
+            return -1;
+    }
+    return 0;
+}
+
 Bit32u vmware3_image_t::get_capabilities(void)
 {
   return HDIMAGE_HAS_GEOMETRY;
@@ -39,6 +39,7 @@ class vmware3_image_t : public device_image_t
       Bit64s lseek(Bit64s offset, int whence);
       ssize_t read(void* buf, size_t count);
       ssize_t write(const void* buf, size_t count);
+      int flush();
 
       Bit32u get_capabilities();
       static int check_format(int fd, Bit64u imgsize);
@@ -108,7 +108,7 @@ void vmware4_image_t::close()
   if (file_descriptor == -1)
     return;
 
-  flush();
+  write_tlb();
   delete [] tlb; tlb = 0;
 
   ::close(file_descriptor);
@@ -265,7 +265,7 @@ off_t vmware4_image_t::perform_seek()
   if (tlb_offset / (header.tlb_size_sectors * SECTOR_SIZE) == current_offset / (header.tlb_size_sectors * SECTOR_SIZE))
     return (header.tlb_size_sectors * SECTOR_SIZE) - (current_offset - tlb_offset);
 
-  flush();
+  write_tlb();
 
   Bit64u index = current_offset / (header.tlb_size_sectors * SECTOR_SIZE);
   Bit32u slb_index = (Bit32u)(index % header.slb_count);
@@ -310,17 +310,30 @@ off_t vmware4_image_t::perform_seek()
   return (header.tlb_size_sectors * SECTOR_SIZE) - (current_offset - tlb_offset);
 }
 
-void vmware4_image_t::flush()
+int vmware4_image_t::flush()
+{
+  if (write_tlb() < 0)
+    return -1;
+  return bx_sync_image(file_descriptor);
+}
+
+int vmware4_image_t::write_tlb()
 {
   if (!is_dirty)
-    return;
+    return 0;
 
   //
   // Write dirty sectors to disk first. Assume that the file is already at the
-  // position for the current tlb.
+  // position for the current tlb and keep it there, since the same tlb may
+  // be flushed again later.
   //
-  ::write(file_descriptor, tlb, (unsigned)header.tlb_size_sectors * SECTOR_SIZE);
+  off_t pos = ::lseek(file_descriptor, 0, SEEK_CUR);
+  unsigned size = (unsigned)header.tlb_size_sectors * SECTOR_SIZE;
+  if (::write(file_descriptor, tlb, size) != (ssize_t)size)
+    return -1;
+  ::lseek(file_descriptor, pos, SEEK_SET);
   is_dirty = 0;
+  return 0;
 }
 
 Bit32u vmware4_image_t::read_block_index(Bit64u sector, Bit32u index)
@@ -349,6 +362,8 @@ Bit32u vmware4_image_t::get_capabilities(void)
 #ifndef BXIMAGE
 bx_bool vmware4_image_t::save_state(const char *backup_fname)
 {
+  if (write_tlb() < 0)
+    return 0;
   return hdimage_backup_file(file_descriptor, backup_fname);
 }
 
@@ -77,6 +77,8 @@ class vmware4_image_t : public device_image_t
         Bit32u get_capabilities();
         static int check_format(int fd, Bit64u imgsize);
 
+        int flush();
+
 #ifndef BXIMAGE
         bx_bool save_state(const char *backup_fname);
         void restore_state(const char *backup_fname);
@@ -90,7 +92,7 @@ class vmware4_image_t : public device_image_t
 
         bx_bool read_header();
         off_t perform_seek();
-        void flush();
+        int write_tlb();
         Bit32u read_block_index(Bit64u sector, Bit32u index);
         void write_block_index(Bit64u sector, Bit32u index, Bit32u block_sector);
 
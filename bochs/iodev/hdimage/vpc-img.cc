@@ -283,6 +283,12 @@ ssize_t vpc_image_t::write(const void* buf, size_t count)
   return count;
 }
 
+int vpc_image_t::flush()
+{
+  // the block allocation table and footer are written immediately
+  return bx_sync_image(fd);
+}
+
 Bit32u vpc_image_t::get_capabilities(void)
 {
   return HDIMAGE_HAS_GEOMETRY;
@@ -109,6 +109,9 @@ static inline int array_ensure_allocated(array_t* array, int index)
 {
   if ((index + 1) * array->item_size > array->size) {
     int new_size = (index + 32) * array->item_size;
+    // grow geometrically to keep scanning of large directory trees linear
+    if (new_size < (int)(array->size * 2))
+      new_size = array->size * 2;
     array->pointer = (char*)realloc(array->pointer, new_size);
     if (!array->pointer)
       return -1;
@@ -351,6 +354,10 @@ vvfat_image_t::vvfat_image_t(Bit64u size, const char* _redolog_name)
   memset(&first_sectors[0], 0, 0xc000);
 
   hd_size = size;
+  short_names = NULL;
+  short_names_size = 0;
+  short_names_count = 0;
+  short_names_start = 0;
   redolog = new redolog_t();
   redolog_temp = NULL;
   redolog_name = NULL;
@@ -531,6 +538,73 @@ void vvfat_image_t::init_fat(void)
   }
 }
 
+static inline Bit32u short_name_hash(const Bit8u *name)
+{
+  Bit32u hash = 2166136261U;
+
+  for (int i = 0; i < 11; i++) {
+    hash = (hash ^ name[i]) * 16777619U;
+  }
+  return hash;
+}
+
+void vvfat_image_t::short_names_reset(unsigned int directory_start)
+{
+  short_names_start = directory_start;
+  short_names_count = 0;
+  if (short_names != NULL) {
+    memset(short_names, 0, short_names_size * sizeof(Bit32u));
+  }
+  // add the entries already present (e.g. the volume label)
+  for (unsigned int i = directory_start; i < directory.next; i++) {
+    if (!is_long_name((direntry_t*)array_get(&directory, i)))
+      short_names_insert(i);
+  }
+}
+
+void vvfat_image_t::short_names_insert(unsigned int index)
+{
+  Bit32u i, slot;
+
+  if ((short_names_count + 1) * 2 > short_names_size) {
+    Bit32u *old_names = short_names;
+    Bit32u old_size = short_names_size;
+
+    short_names_size = (old_size > 0) ? (old_size * 2) : 256;
+    short_names = (Bit32u*)calloc(short_names_size, sizeof(Bit32u));
+    short_names_count = 0;
+    for (i = 0; i < old_size; i++) {
+      if (old_names[i] != 0)
+        short_names_insert(old_names[i] - 1);
+    }
+    if (old_names != NULL)
+      free(old_names);
+  }
+  direntry_t* entry = (direntry_t*)array_get(&directory, index);
+  slot = short_name_hash(entry->name) & (short_names_size - 1);
+  while (short_names[slot] != 0) {
+    slot = (slot + 1) & (short_names_size - 1);
+  }
+  short_names[slot] = index + 1;
+  short_names_count++;
+}
+
+bx_bool vvfat_image_t::short_names_lookup(const direntry_t *entry)
+{
+  Bit32u slot;
+
+  if (short_names_size == 0)
+    return 0;
+  slot = short_name_hash(entry->name) & (short_names_size - 1);
+  while (short_names[slot] != 0) {
+    direntry_t* entry1 = (direntry_t*)array_get(&directory, short_names[slot] - 1);
+    if (!memcmp(entry1->name, entry->name, 11))
+      return 1;
+    slot = (slot + 1) & (short_names_size - 1);
+  }
+  return 0;
+}
+
 direntry_t* vvfat_image_t::create_short_and_long_name(
   unsigned int directory_start, const char* filename, int is_dot)
 {
@@ -539,10 +613,15 @@ direntry_t* vvfat_image_t::create_short_and_long_name(
   direntry_t* entry_long = NULL;
   char tempfn[BX_PATHNAME_LEN];
 
+  if ((short_names_size == 0) || (directory_start != short_names_start)) {
+    short_names_reset(directory_start);
+  }
+
   if (is_dot) {
     entry = (direntry_t*)array_get_next(&directory);
     memset(entry->name,0x20,11);
     memcpy(entry->name,filename,strlen(filename));
+    short_names_insert(directory.next - 1);
     return entry;
   }
 
@@ -583,16 +662,9 @@ direntry_t* vvfat_image_t::create_short_and_long_name(
   if (entry->name[0] == 0xe5) entry->name[0] = 0x05;
 
   // mangle duplicates
-  while (1) {
-    direntry_t* entry1 = (direntry_t*)array_get(&directory, directory_start);
+  while (short_names_lookup(entry)) {
     int j;
 
-    for (;entry1<entry;entry1++)
-      if (!is_long_name(entry1) && !memcmp(entry1->name,entry->name,11))
-        break; // found dupe
-    if (entry1==entry) // no dupe found
-      break;
-
     // use all 8 characters of name
     if (entry->name[7]==' ') {
       int j;
@@ -610,6 +682,7 @@ direntry_t* vvfat_image_t::create_short_and_long_name(
         entry->name[j]++;
     }
   }
+  short_names_insert(directory.next - 1);
 
   // calculate checksum; propagate to long name
   if (entry_long) {
@@ -972,6 +1045,7 @@ int vvfat_image_t::init_directories(const char* dirname)
     if (mapping->mode & MODE_DIRECTORY) {
       mapping->begin = cluster;
       if (read_directory(i)) {
+        mapping = (mapping_t*)array_get(&this->mapping, i);
         BX_PANIC(("Could not read directory '%s'", mapping->path));
         return -1;
       }
@@ -1100,8 +1174,8 @@ bx_bool vvfat_image_t::read_sector_from_file(const char *path, Bit8u *buffer, Bi
     return 0;
   int offset = sector * 0x200;
   if (::lseek(fd, offset, SEEK_SET) != offset) {
-    return 0;
     ::close(fd);
+    return 0;
   }
   int result = ::read(fd, buffer, 0x200);
   ::close(fd);
@@ -1732,6 +1806,11 @@ void vvfat_image_t::close(void)
   array_free(&this->mapping);
   if (cluster_buffer != NULL)
     delete [] cluster_buffer;
+  if (short_names != NULL) {
+    free(short_names);
+    short_names = NULL;
+    short_names_size = 0;
+  }
 
   redolog->close();
 
@@ -1886,14 +1965,22 @@ read_cluster_directory:
     assert(current_fd);
 
     offset = cluster_size * (cluster_num - current_mapping->begin) + current_mapping->info.file.offset;
+    cluster = cluster_buffer;
+#ifndef WIN32
+    // one syscall per cluster
+    result = ::pread(current_fd, cluster, cluster_size, offset);
+#else
     if (::lseek(current_fd, offset, SEEK_SET) != offset)
       return -3;
-    cluster = cluster_buffer;
     result = ::read(current_fd, cluster, cluster_size);
+#endif
     if (result < 0) {
       current_cluster = 0xffff;
       return -1;
     }
+    // last cluster of the file or file truncated by the host
+    if (result < (int)cluster_size)
+      memset(cluster + result, 0, cluster_size - result);
     current_cluster = cluster_num;
   }
   return 0;
@@ -135,6 +135,9 @@ class vvfat_image_t : public device_image_t
     void init_fat();
     direntry_t* create_short_and_long_name(unsigned int directory_start,
       const char* filename, int is_dot);
+    void short_names_reset(unsigned int directory_start);
+    void short_names_insert(unsigned int index);
+    bx_bool short_names_lookup(const direntry_t *entry);
     int read_directory(int mapping_index);
     Bit32u sector2cluster(off_t sector_num);
     off_t cluster2sector(Bit32u cluster_num);
@@ -178,6 +181,13 @@ class vvfat_image_t : public device_image_t
     Bit8u  *cluster_buffer; // points to a buffer to hold temp data
     Bit16u current_cluster;
 
+    // hash table of the short names in the directory currently being read
+    // (directory entry index + 1, 0 = free slot)
+    Bit32u *short_names;
+    Bit32u short_names_size;
+    Bit32u short_names_count;
+    unsigned int short_names_start;
+
     const char *vvfat_path;
     Bit32u sector_num;
 
@@ -341,6 +341,9 @@ public:
   virtual cdrom_base_c* init_cdrom(const char *dev) {
     STUBFUNC(hdimage_ctl, init_cdrom); return NULL;
   }
+  virtual bx_bool trace_enabled() {return 0;}
+  virtual void trace_request(Bit8u device, Bit8u type, Bit64u lba, Bit32u sectors,
+                             Bit32u latency, Bit8u queue_depth) {}
 };
 
 #if BX_SUPPORT_SOUNDLOW
@@ -429,7 +432,8 @@ public:
   bx_bool register_pci_handlers(bx_pci_device_stub_c *device, Bit8u *devfunc,
                                 const char *name, const char *descr);
   bx_bool pci_set_base_mem(void *this_ptr, memory_handler_t f1, memory_handler_t f2,
-                           Bit32u *addr, Bit8u *pci_conf, unsigned size);
+                           Bit32u *addr, Bit8u *pci_conf, unsigned size,
+                           memory_direct_access_handler_t f3 = NULL);
   bx_bool pci_set_base_io(void *this_ptr, bx_read_handler_t f1, bx_write_handler_t f2,
                           Bit32u *addr, Bit8u *pci_conf, unsigned size,
                           const Bit8u *iomask, const char *name);
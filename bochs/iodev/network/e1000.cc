@@ -57,6 +57,7 @@ const Bit8u e1000_iomask[64] = {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
 #define E1000_MDIC     0x00020  // MDI Control - RW
 #define E1000_VET      0x00038  // VLAN Ether Type - RW
 #define E1000_ICR      0x000C0  // Interrupt Cause Read - R/clr
+#define E1000_ITR      0x000C4  // Interrupt Throttling Rate - RW
 #define E1000_ICS      0x000C8  // Interrupt Cause Set - WO
 #define E1000_IMS      0x000D0  // Interrupt Mask Set - RW
 #define E1000_IMC      0x000D8  // Interrupt Mask Clear - WO
@@ -69,12 +70,16 @@ const Bit8u e1000_iomask[64] = {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
 #define E1000_RDLEN    0x02808  // RX Descriptor Length - RW
 #define E1000_RDH      0x02810  // RX Descriptor Head - RW
 #define E1000_RDT      0x02818  // RX Descriptor Tail - RW
+#define E1000_RDTR     0x02820  // RX Delay Timer - RW
+#define E1000_RADV     0x0282C  // RX Interrupt Absolute Delay Timer - RW
 #define E1000_TDBAL    0x03800  // TX Descriptor Base Address Low - RW
 #define E1000_TDBAH    0x03804  // TX Descriptor Base Address High - RW
 #define E1000_TDLEN    0x03808  // TX Descriptor Length - RW
 #define E1000_TDH      0x03810  // TX Descriptor Head - RW
 #define E1000_TDT      0x03818  // TX Descripotr Tail - RW
+#define E1000_TIDV     0x03820  // TX Interrupt Delay Value - RW
 #define E1000_TXDCTL   0x03828  // TX Descriptor Control - RW
+#define E1000_TADV     0x0382C  // TX Interrupt Absolute Delay Val - RW
 #define E1000_CRCERRS  0x04000  // CRC Error Count - R/clr
 #define E1000_MPC      0x04010  // Missed Packet Count - R/clr
 #define E1000_GPRC     0x04074  // Good Packets RX Count - R/clr
@@ -193,6 +198,9 @@ const Bit8u e1000_iomask[64] = {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
 #define E1000_TXD_CMD_TCP    0x01000000 // TCP packet
 #define E1000_TXD_CMD_IP     0x02000000 // IP packet
 #define E1000_TXD_CMD_TSE    0x04000000 // TCP Seg enable
+#define E1000_TXD_CMD_IDE    0x80000000 // Enable Tidv register
+
+#define E1000_DELAY_FPD      0x80000000 // RDTR / TIDV: flush partial descriptor block
 
 #define E1000_TCTL_EN     0x00000002    // enable tx
 
@@ -251,6 +259,11 @@ struct e1000_context_desc {
 
 #define MIN_BUF_SIZE 60
 
+// the interrupt moderation registers count in units of 256ns (ITR)
+// and 1.024us (RDTR, RADV, TIDV, TADV)
+#define E1000_ITR_USEC(v)   (((Bit64u)(v) * 256 + 999) / 1000)
+#define E1000_DELAY_USEC(v) (((Bit64u)(v) * 1024 + 999) / 1000)
+
 #define	defreg(x) x = (E1000_##x>>2)
 enum {
   defreg(CTRL),  defreg(EECD),  defreg(EERD),   defreg(GPRC),
@@ -263,7 +276,8 @@ enum {
   defreg(TORH),  defreg(TORL),  defreg(TOTH),   defreg(TOTL),
   defreg(TPR),   defreg(TPT),   defreg(TXDCTL), defreg(WUFC),
   defreg(RA),    defreg(MTA),   defreg(CRCERRS),defreg(VFTA),
-  defreg(VET),
+  defreg(VET),   defreg(ITR),   defreg(RDTR),   defreg(RADV),
+  defreg(TIDV),  defreg(TADV),
 };
 
 enum { PHY_R = 1, PHY_W = 2, PHY_RW = PHY_R | PHY_W };
@@ -418,6 +432,9 @@ bx_e1000_c::bx_e1000_c()
   put("E1000");
   memset(&s, 0, sizeof(bx_e1000_t));
   s.tx_timer_index = BX_NULL_TIMER_HANDLE;
+  s.rx_delay.timer_index = BX_NULL_TIMER_HANDLE;
+  s.tx_delay.timer_index = BX_NULL_TIMER_HANDLE;
+  s.itr_timer_index = BX_NULL_TIMER_HANDLE;
   ethdev = NULL;
 }
 
@@ -429,6 +446,9 @@ bx_e1000_c::~bx_e1000_c()
   if (s.tx.vlan != NULL) {
     delete [] s.tx.vlan;
   }
+  if (s.tx_batch.buf != NULL) {
+    delete [] s.tx_batch.buf;
+  }
   if (ethdev != NULL) {
     delete ethdev;
   }
@@ -486,10 +506,31 @@ void bx_e1000_c::init(void)
       bx_pc_system.register_timer(this, tx_timer_handler, 0,
                                   0, 0, "e1000"); // one-shot, inactive
   }
+  if (BX_E1000_THIS s.rx_delay.timer_index == BX_NULL_TIMER_HANDLE) {
+    BX_E1000_THIS s.rx_delay.timer_index =
+      bx_pc_system.register_timer(this, rx_delay_timer_handler, 1,
+                                  0, 0, "e1000 rx delay");
+  }
+  if (BX_E1000_THIS s.tx_delay.timer_index == BX_NULL_TIMER_HANDLE) {
+    BX_E1000_THIS s.tx_delay.timer_index =
+      bx_pc_system.register_timer(this, tx_delay_timer_handler, 1,
+                                  0, 0, "e1000 tx delay");
+  }
+  if (BX_E1000_THIS s.itr_timer_index == BX_NULL_TIMER_HANDLE) {
+    BX_E1000_THIS s.itr_timer_index =
+      bx_pc_system.register_timer(this, itr_timer_handler, 1,
+                                  0, 0, "e1000 itr");
+  }
   BX_E1000_THIS s.statusbar_id = bx_gui->register_statusitem("E1000", 1);
 
   // Attach to the selected ethernet module
   BX_E1000_THIS ethdev = DEV_net_init_module(base, rx_handler, rx_status_handler, this);
+  BX_E1000_THIS ethdev->set_rx_batch_handler(rx_batch_handler);
+  BX_E1000_THIS s.tx_offload = BX_E1000_THIS ethdev->offload_caps();
+  if (BX_E1000_THIS ethdev->tx_batching()) {
+    BX_E1000_THIS s.tx_batch.buf = new Bit8u[BX_E1000_TX_BATCH * BX_PACKET_BUFSIZE];
+  }
+  BX_E1000_THIS s.tx_batch.count = 0;
 
   BX_INFO(("E1000 initialized"));
 }
@@ -557,7 +598,18 @@ void bx_e1000_c::reset(unsigned type)
   BX_E1000_THIS s.tx.vlan = saved_ptr;
   BX_E1000_THIS s.tx.data = BX_E1000_THIS s.tx.vlan + 4;
 
+  bx_pc_system.deactivate_timer(BX_E1000_THIS s.rx_delay.timer_index);
+  bx_pc_system.deactivate_timer(BX_E1000_THIS s.tx_delay.timer_index);
+  bx_pc_system.deactivate_timer(BX_E1000_THIS s.itr_timer_index);
+  BX_E1000_THIS s.rx_delay.pending = 0;
+  BX_E1000_THIS s.tx_delay.pending = 0;
+  BX_E1000_THIS s.itr_active = 0;
+  BX_E1000_THIS s.itr_pending = 0;
+  BX_E1000_THIS s.rx_cache.count = 0;
+  BX_E1000_THIS s.tx_cache.count = 0;
+
   // Deassert IRQ
+  BX_E1000_THIS s.int_level = 1;
   set_irq_level(0);
 }
 
@@ -617,6 +669,11 @@ void bx_e1000_c::register_state(void)
   BXRS_DEC_PARAM_FIELD(eecds, bitnum_out, BX_E1000_THIS s.eecd_state.bitnum_out);
   BXRS_PARAM_BOOL(eecds, reading, BX_E1000_THIS s.eecd_state.reading);
   BXRS_HEX_PARAM_FIELD(eecds, old_eecd, BX_E1000_THIS s.eecd_state.old_eecd);
+  bx_list_c *intmod = new bx_list_c(list, "int_moderation", "");
+  BXRS_HEX_PARAM_FIELD(intmod, rx_pending, BX_E1000_THIS s.rx_delay.pending);
+  BXRS_HEX_PARAM_FIELD(intmod, tx_pending, BX_E1000_THIS s.tx_delay.pending);
+  BXRS_PARAM_BOOL(intmod, int_level, BX_E1000_THIS s.int_level);
+  BXRS_PARAM_BOOL(intmod, itr_pending, BX_E1000_THIS s.itr_pending);
 
   register_pci_state(list);
 }
@@ -644,6 +701,11 @@ void bx_e1000_c::after_restore_state(void)
       BX_INFO(("new ROM address: 0x%08x", BX_E1000_THIS pci_rom_address));
     }
   }
+  // the moderation timers are not saved: deliver the delayed interrupts now
+  BX_E1000_THIS s.itr_active = 1;
+  itr_timer();
+  flush_delayed_int(1);
+  flush_delayed_int(0);
 }
 
 bx_bool bx_e1000_c::mem_read_handler(bx_phy_address addr, unsigned len,
@@ -710,6 +772,11 @@ bx_bool bx_e1000_c::mem_read_handler(bx_phy_address addr, unsigned len,
       case E1000_RDBAL:
       case E1000_TDLEN:
       case E1000_RDLEN:
+      case E1000_ITR:
+      case E1000_RDTR:
+      case E1000_RADV:
+      case E1000_TIDV:
+      case E1000_TADV:
         value = BX_E1000_THIS s.mac_reg[index];
         break;
       case E1000_TOTH:
@@ -806,6 +873,25 @@ bx_bool bx_e1000_c::mem_write_handler(bx_phy_address addr, unsigned len,
       case E1000_ICS:
         set_ics(value);
         break;
+      case E1000_ITR:
+        BX_E1000_THIS s.mac_reg[index] = value & 0xffff;
+        if ((value & 0xffff) == 0) {
+          // throttling disabled: release a held back interrupt
+          bx_pc_system.deactivate_timer(BX_E1000_THIS s.itr_timer_index);
+          itr_timer();
+        }
+        break;
+      case E1000_RADV:
+      case E1000_TADV:
+        BX_E1000_THIS s.mac_reg[index] = value & 0xffff;
+        break;
+      case E1000_RDTR:
+      case E1000_TIDV:
+        BX_E1000_THIS s.mac_reg[index] = value & 0xffff;
+        if (value & E1000_DELAY_FPD) {
+          flush_delayed_int(offset == E1000_RDTR);
+        }
+        break;
       case E1000_TDH:
       case E1000_RDH:
         BX_E1000_THIS s.mac_reg[index] = value & 0xffff;
@@ -900,9 +986,43 @@ void bx_e1000_c::write(Bit32u address, Bit32u value, unsigned io_len)
 
 void bx_e1000_c::set_irq_level(bx_bool level)
 {
+  if (level == BX_E1000_THIS s.int_level)
+    return;
+  if (level) {
+    // ITR: the interrupt is held back until the throttling interval
+    // started by the previous assertion has expired
+    if (BX_E1000_THIS s.itr_active) {
+      BX_E1000_THIS s.itr_pending = 1;
+      return;
+    }
+    Bit32u itr = BX_E1000_THIS s.mac_reg[ITR] & 0xffff;
+    if (itr != 0) {
+      BX_E1000_THIS s.itr_active = 1;
+      bx_pc_system.activate_timer(BX_E1000_THIS s.itr_timer_index,
+                                  (Bit32u)E1000_ITR_USEC(itr), 0);
+    }
+  } else {
+    BX_E1000_THIS s.itr_pending = 0;
+  }
+  BX_E1000_THIS s.int_level = level;
   DEV_pci_set_irq(BX_E1000_THIS s.devfunc, BX_E1000_THIS pci_conf[0x3d], level);
 }
 
+void bx_e1000_c::itr_timer_handler(void *this_ptr)
+{
+  bx_e1000_c *class_ptr = (bx_e1000_c *) this_ptr;
+  class_ptr->itr_timer();
+}
+
+void bx_e1000_c::itr_timer(void)
+{
+  BX_E1000_THIS s.itr_active = 0;
+  if (BX_E1000_THIS s.itr_pending) {
+    BX_E1000_THIS s.itr_pending = 0;
+    set_irq_level((BX_E1000_THIS s.mac_reg[IMS] & BX_E1000_THIS s.mac_reg[ICR]) != 0);
+  }
+}
+
 void bx_e1000_c::set_interrupt_cause(Bit32u value)
 {
   if (value != 0)
@@ -919,6 +1039,74 @@ void bx_e1000_c::set_ics(Bit32u value)
   set_interrupt_cause(value | BX_E1000_THIS s.mac_reg[ICR]);
 }
 
+// RXT0 / TXDW are delayed by the packet timer (RDTR / TIDV, restarted
+// with every packet) and the absolute timer (RADV / TADV, started with
+// the first packet), whichever expires first
+void bx_e1000_c::delay_int(bx_bool rx, Bit32u cause)
+{
+  Bit32u pkt_delay = BX_E1000_THIS s.mac_reg[rx ? RDTR : TIDV] & 0xffff;
+  Bit32u abs_delay = BX_E1000_THIS s.mac_reg[rx ? RADV : TADV] & 0xffff;
+  Bit64u now, expire;
+
+  if (pkt_delay == 0) {
+    flush_delayed_int(rx);
+    set_ics(cause);
+    return;
+  }
+  if (rx) {
+    BX_E1000_THIS s.rx_delay.pending |= cause;
+  } else {
+    BX_E1000_THIS s.tx_delay.pending |= cause;
+  }
+  now = bx_pc_system.time_usec();
+  Bit64u *deadline = rx ? &BX_E1000_THIS s.rx_delay.deadline : &BX_E1000_THIS s.tx_delay.deadline;
+  if ((*deadline == 0) && (abs_delay != 0)) {
+    *deadline = now + E1000_DELAY_USEC(abs_delay);
+  }
+  expire = now + E1000_DELAY_USEC(pkt_delay);
+  if ((*deadline != 0) && (*deadline < expire)) {
+    expire = *deadline;
+  }
+  if (expire <= now) {
+    flush_delayed_int(rx);
+  } else {
+    bx_pc_system.activate_timer(rx ? BX_E1000_THIS s.rx_delay.timer_index : BX_E1000_THIS s.tx_delay.timer_index,
+                                (Bit32u)(expire - now), 0);
+  }
+}
+
+void bx_e1000_c::flush_delayed_int(bx_bool rx)
+{
+  Bit32u cause;
+
+  if (rx) {
+    bx_pc_system.deactivate_timer(BX_E1000_THIS s.rx_delay.timer_index);
+    cause = BX_E1000_THIS s.rx_delay.pending;
+    BX_E1000_THIS s.rx_delay.pending = 0;
+    BX_E1000_THIS s.rx_delay.deadline = 0;
+  } else {
+    bx_pc_system.deactivate_timer(BX_E1000_THIS s.tx_delay.timer_index);
+    cause = BX_E1000_THIS s.tx_delay.pending;
+    BX_E1000_THIS s.tx_delay.pending = 0;
+    BX_E1000_THIS s.tx_delay.deadline = 0;
+  }
+  if (cause != 0) {
+    set_ics(cause);
+  }
+}
+
+void bx_e1000_c::rx_delay_timer_handler(void *this_ptr)
+{
+  bx_e1000_c *class_ptr = (bx_e1000_c *) this_ptr;
+  class_ptr->flush_delayed_int(1);
+}
+
+void bx_e1000_c::tx_delay_timer_handler(void *this_ptr)
+{
+  bx_e1000_c *class_ptr = (bx_e1000_c *) this_ptr;
+  class_ptr->flush_delayed_int(0);
+}
+
 int bx_e1000_c::rxbufsize(Bit32u v)
 {
   v &= E1000_RCTL_BSEX | E1000_RCTL_SZ_16384 | E1000_RCTL_SZ_8192 |
@@ -1075,14 +1263,57 @@ int bx_e1000_c::fcs_len()
   return (BX_E1000_THIS s.mac_reg[RCTL] & E1000_RCTL_SECRC) ? 0 : 4;
 }
 
+// TCP segmentation can be left to the host if the pktmover supports it
+bx_bool bx_e1000_c::tso_passthrough()
+{
+  e1000_tx *tp = &BX_E1000_THIS s.tx;
+  Bit32u cap = tp->ip ? BX_NETDEV_OFFLOAD_TSO4 : BX_NETDEV_OFFLOAD_TSO6;
+
+  return (tp->tse && tp->cptse && tp->tcp && (tp->mss > 0) &&
+          ((BX_E1000_THIS s.tx_offload & cap) != 0) &&
+          ((tp->sum_needed & E1000_TXD_POPTS_TXSM) != 0) &&
+          (tp->tucss < tp->tucso) && (tp->tucss >= tp->ipcss) &&
+          ((tp->hdr_len + tp->paylen) < 0x10000));
+}
+
 void bx_e1000_c::xmit_seg()
 {
   Bit16u len;
   Bit8u *sp;
   unsigned int frames = BX_E1000_THIS s.tx.tso_frames, css, sofar, n;
+  unsigned int segs = 1;
+  Bit8u sum_needed = BX_E1000_THIS s.tx.sum_needed;
   e1000_tx *tp = &BX_E1000_THIS s.tx;
+  eth_offload_t offload;
 
-  if (tp->tse && tp->cptse) {
+  memset(&offload, 0, sizeof(offload));
+  if (tso_passthrough()) {
+    // the whole TSO frame is sent at once, the host splits it up
+    css = tp->ipcss;
+    BX_DEBUG(("TSO passthrough size %d ipcss %d mss %d", tp->size, css, tp->mss));
+    if (tp->ip) { // IPv4
+      put_net2(tp->data+css+2, tp->size - css);
+    } else // IPv6
+      put_net2(tp->data+css+4, tp->size - css - 40);
+    len = tp->size - tp->tucss;
+    if (sum_needed & E1000_TXD_POPTS_TXSM) {
+      unsigned int phsum;
+      // add pseudo-header length, the host completes the checksum
+      sp = tp->data + tp->tucso;
+      phsum = get_net2(sp) + len;
+      phsum = (phsum >> 16) + (phsum & 0xffff);
+      put_net2(sp, phsum);
+      sum_needed &= ~E1000_TXD_POPTS_TXSM;
+    }
+    offload.flags = BX_NETDEV_OFFLOAD_NEEDS_CSUM;
+    offload.gso_type = tp->ip ? BX_NETDEV_GSO_TCPV4 : BX_NETDEV_GSO_TCPV6;
+    offload.hdr_len = tp->hdr_len;
+    offload.gso_size = tp->mss;
+    offload.csum_start = tp->tucss;
+    offload.csum_offset = tp->tucso - tp->tucss;
+    if (tp->size > tp->hdr_len)
+      segs = (tp->size - tp->hdr_len + tp->mss - 1) / tp->mss;
+  } else if (tp->tse && tp->cptse) {
     css = tp->ipcss;
     BX_DEBUG(("frames %d size %d ipcss %d", frames, tp->size, css));
     if (tp->ip) { // IPv4
@@ -1110,26 +1341,85 @@ void bx_e1000_c::xmit_seg()
       put_net2(sp, phsum);
     }
     tp->tso_frames++;
+  } else if ((sum_needed & E1000_TXD_POPTS_TXSM) && (tp->tucse == 0) &&
+             (BX_E1000_THIS s.tx_offload & BX_NETDEV_OFFLOAD_CSUM) &&
+             (tp->tucss < tp->tucso) && ((tp->tucso + 2U) <= tp->size)) {
+    // let the host complete the TCP / UDP checksum
+    offload.flags = BX_NETDEV_OFFLOAD_NEEDS_CSUM;
+    offload.csum_start = tp->tucss;
+    offload.csum_offset = tp->tucso - tp->tucss;
+    sum_needed &= ~E1000_TXD_POPTS_TXSM;
   }
 
-  if (tp->sum_needed & E1000_TXD_POPTS_TXSM)
+  if (sum_needed & E1000_TXD_POPTS_TXSM)
     putsum(tp->data, tp->size, tp->tucso, tp->tucss, tp->tucse);
-  if (tp->sum_needed & E1000_TXD_POPTS_IXSM)
+  if (sum_needed & E1000_TXD_POPTS_IXSM)
     putsum(tp->data, tp->size, tp->ipcso, tp->ipcss, tp->ipcse);
   if (tp->vlan_needed) {
     memmove(tp->vlan, tp->data, 4);
     memmove(tp->data, tp->data + 4, 8);
     memcpy(tp->data + 8, tp->vlan_header, 4);
-    BX_E1000_THIS ethdev->sendpkt(tp->vlan, tp->size + 4);
+    if (offload.flags != 0) {
+      offload.csum_start += 4;
+      if (offload.gso_type != BX_NETDEV_GSO_NONE)
+        offload.hdr_len += 4;
+    }
+    tx_queue(tp->vlan, tp->size + 4, &offload);
   } else
-    BX_E1000_THIS ethdev->sendpkt(tp->data, tp->size);
-  BX_E1000_THIS s.mac_reg[TPT]++;
-  BX_E1000_THIS s.mac_reg[GPTC]++;
+    tx_queue(tp->data, tp->size, &offload);
+  BX_E1000_THIS s.mac_reg[TPT] += segs;
+  BX_E1000_THIS s.mac_reg[GPTC] += segs;
   n = BX_E1000_THIS s.mac_reg[TOTL];
   if ((BX_E1000_THIS s.mac_reg[TOTL] += BX_E1000_THIS s.tx.size) < n)
     BX_E1000_THIS s.mac_reg[TOTH]++;
 }
 
+void bx_e1000_c::tx_queue(const Bit8u *buf, unsigned len, const eth_offload_t *offload)
+{
+  unsigned n = BX_E1000_THIS s.tx_batch.count;
+  Bit8u *slot;
+
+  if ((BX_E1000_THIS s.tx_batch.buf == NULL) || (len > BX_PACKET_BUFSIZE)) {
+    // pktmover without batch support or frame does not fit into a batch slot
+    tx_flush();
+    if (offload->flags != 0) {
+      eth_packet_t pkt;
+      pkt.iovcnt = 1;
+      pkt.iov[0].base = buf;
+      pkt.iov[0].len = len;
+      pkt.offload = *offload;
+      if (BX_E1000_THIS ethdev->sendpkts(&pkt, 1) > 0) {
+        BX_ERROR(("TX: frame could not be sent"));
+      }
+    } else {
+      BX_E1000_THIS ethdev->sendpkt((void*)buf, len);
+    }
+    return;
+  }
+  slot = BX_E1000_THIS s.tx_batch.buf + n * BX_PACKET_BUFSIZE;
+  memcpy(slot, buf, len);
+  BX_E1000_THIS s.tx_batch.pkt[n].iovcnt = 1;
+  BX_E1000_THIS s.tx_batch.pkt[n].iov[0].base = slot;
+  BX_E1000_THIS s.tx_batch.pkt[n].iov[0].len = len;
+  BX_E1000_THIS s.tx_batch.pkt[n].offload = *offload;
+  if (++BX_E1000_THIS s.tx_batch.count == BX_E1000_TX_BATCH) {
+    tx_flush();
+  }
+}
+
+void bx_e1000_c::tx_flush()
+{
+  unsigned failed;
+
+  if (BX_E1000_THIS s.tx_batch.count > 0) {
+    failed = BX_E1000_THIS ethdev->sendpkts(BX_E1000_THIS s.tx_batch.pkt, BX_E1000_THIS s.tx_batch.count);
+    if (failed > 0) {
+      BX_ERROR(("TX: %d frame(s) could not be sent", failed));
+    }
+    BX_E1000_THIS s.tx_batch.count = 0;
+  }
+}
+
 void bx_e1000_c::process_tx_desc(struct e1000_tx_desc *dp)
 {
   Bit32u txd_lower = le32_to_cpu(dp->lower.data);
@@ -1179,7 +1469,7 @@ void bx_e1000_c::process_tx_desc(struct e1000_tx_desc *dp)
   }
 
   addr = le64_to_cpu(dp->buffer_addr);
-  if (tp->tse && tp->cptse) {
+  if (tp->tse && tp->cptse && !tso_passthrough()) {
     hdr = tp->hdr_len;
     msh = hdr + tp->mss;
     do {
@@ -1201,6 +1491,10 @@ void bx_e1000_c::process_tx_desc(struct e1000_tx_desc *dp)
     // context descriptor TSE is not set, while data descriptor TSE is set
     BX_DEBUG(("TCP segmentaion Error"));
   } else {
+    if ((tp->size + split_size) > 0xffff) {
+      BX_ERROR(("TX frame too large, truncated"));
+      split_size = 0xffff - tp->size;
+    }
     DEV_MEM_READ_PHYSICAL_DMA(addr, split_size, tp->data + tp->size);
     tp->size += split_size;
   }
@@ -1216,7 +1510,9 @@ void bx_e1000_c::process_tx_desc(struct e1000_tx_desc *dp)
   tp->cptse = 0;
 }
 
-Bit32u bx_e1000_c::txdesc_writeback(bx_phy_address base, struct e1000_tx_desc *dp)
+// updates the status of the descriptor (the copy in the descriptor cache
+// is written back to memory later)
+Bit32u bx_e1000_c::txdesc_writeback(struct e1000_tx_desc *dp)
 {
   Bit32u txd_upper, txd_lower = le32_to_cpu(dp->lower.data);
 
@@ -1225,8 +1521,6 @@ Bit32u bx_e1000_c::txdesc_writeback(bx_phy_address base, struct e1000_tx_desc *d
   txd_upper = (le32_to_cpu(dp->upper.data) | E1000_TXD_STAT_DD) &
               ~(E1000_TXD_STAT_EC | E1000_TXD_STAT_LC | E1000_TXD_STAT_TU);
   dp->upper.data = cpu_to_le32(txd_upper);
-  DEV_MEM_WRITE_PHYSICAL_DMA(base + ((char *)&dp->upper - (char *)dp),
-                             sizeof(dp->upper), (Bit8u *)&dp->upper);
   return E1000_ICR_TXDW;
 }
 
@@ -1238,11 +1532,95 @@ Bit64u bx_e1000_c::tx_desc_base()
   return (bah << 32) + bal;
 }
 
+/*
+ * Descriptor cache: the descriptors owned by the hardware are read in blocks
+ * of up to BX_E1000_DESC_BATCH entries and written back in one go when the
+ * block is exhausted or the caller is done with the ring. The cache never
+ * outlives a single start_xmit() / receive callback, so the guest always
+ * finds the descriptors up to date.
+ */
+Bit8u* bx_e1000_c::desc_fetch(bx_bool rx, Bit32u index)
+{
+  Bit32u head, tail, ring, avail, n;
+  Bit64u base;
+
+  if (rx) {
+    if ((BX_E1000_THIS s.rx_cache.used < BX_E1000_THIS s.rx_cache.count) &&
+        ((BX_E1000_THIS s.rx_cache.head + BX_E1000_THIS s.rx_cache.used) == index)) {
+      return &BX_E1000_THIS s.rx_cache.desc[16 * BX_E1000_THIS s.rx_cache.used++];
+    }
+  } else {
+    if ((BX_E1000_THIS s.tx_cache.used < BX_E1000_THIS s.tx_cache.count) &&
+        ((BX_E1000_THIS s.tx_cache.head + BX_E1000_THIS s.tx_cache.used) == index)) {
+      return &BX_E1000_THIS s.tx_cache.desc[16 * BX_E1000_THIS s.tx_cache.used++];
+    }
+  }
+  desc_writeback(rx);
+  if (rx) {
+    tail = BX_E1000_THIS s.mac_reg[RDT];
+    ring = BX_E1000_THIS s.mac_reg[RDLEN] / 16;
+    base = rx_desc_base();
+  } else {
+    tail = BX_E1000_THIS s.mac_reg[TDT];
+    ring = BX_E1000_THIS s.mac_reg[TDLEN] / 16;
+    base = tx_desc_base();
+  }
+  head = index;
+  n = 1;
+  if (head < ring) {
+    // up to the end of the ring and not beyond the tail
+    n = ring - head;
+    if (tail != head) {
+      avail = (tail > head) ? (tail - head) : (ring - head + tail);
+      if (n > avail) n = avail;
+    } else {
+      n = 1;
+    }
+    if (n > BX_E1000_DESC_BATCH) n = BX_E1000_DESC_BATCH;
+  }
+  if (rx) {
+    DEV_MEM_READ_PHYSICAL_DMA(base + head * 16, n * 16, BX_E1000_THIS s.rx_cache.desc);
+    BX_E1000_THIS s.rx_cache.head = head;
+    BX_E1000_THIS s.rx_cache.count = n;
+    BX_E1000_THIS s.rx_cache.used = 1;
+    return BX_E1000_THIS s.rx_cache.desc;
+  } else {
+    DEV_MEM_READ_PHYSICAL_DMA(base + head * 16, n * 16, BX_E1000_THIS s.tx_cache.desc);
+    BX_E1000_THIS s.tx_cache.head = head;
+    BX_E1000_THIS s.tx_cache.count = n;
+    BX_E1000_THIS s.tx_cache.used = 1;
+    return BX_E1000_THIS s.tx_cache.desc;
+  }
+}
+
+void bx_e1000_c::desc_writeback(bx_bool rx)
+{
+  if (rx) {
+    if (BX_E1000_THIS s.rx_cache.used > 0) {
+      DEV_MEM_WRITE_PHYSICAL_DMA(rx_desc_base() + BX_E1000_THIS s.rx_cache.head * 16,
+                                 BX_E1000_THIS s.rx_cache.used * 16,
+                                 BX_E1000_THIS s.rx_cache.desc);
+    }
+    BX_E1000_THIS s.rx_cache.count = 0;
+    BX_E1000_THIS s.rx_cache.used = 0;
+  } else {
+    if (BX_E1000_THIS s.tx_cache.used > 0) {
+      DEV_MEM_WRITE_PHYSICAL_DMA(tx_desc_base() + BX_E1000_THIS s.tx_cache.head * 16,
+                                 BX_E1000_THIS s.tx_cache.used * 16,
+                                 BX_E1000_THIS s.tx_cache.desc);
+    }
+    BX_E1000_THIS s.tx_cache.count = 0;
+    BX_E1000_THIS s.tx_cache.used = 0;
+  }
+}
+
 void bx_e1000_c::start_xmit()
 {
-  bx_phy_address base;
   struct e1000_tx_desc desc;
+  Bit8u *dp;
   Bit32u tdh_start = BX_E1000_THIS s.mac_reg[TDH], cause = E1000_ICS_TXQE;
+  Bit32u txdw = 0, txd_lower;
+  bx_bool delayed = 1;
 
   if (!(BX_E1000_THIS s.mac_reg[TCTL] & E1000_TCTL_EN)) {
     BX_DEBUG(("tx disabled"));
@@ -1250,15 +1628,21 @@ void bx_e1000_c::start_xmit()
   }
 
   while (BX_E1000_THIS s.mac_reg[TDH] != BX_E1000_THIS s.mac_reg[TDT]) {
-    base = tx_desc_base() +
-           sizeof(struct e1000_tx_desc) * BX_E1000_THIS s.mac_reg[TDH];
-    DEV_MEM_READ_PHYSICAL_DMA(base, sizeof(struct e1000_tx_desc), (Bit8u *)&desc);
+    dp = desc_fetch(0, BX_E1000_THIS s.mac_reg[TDH]);
+    memcpy(&desc, dp, sizeof(desc));
     BX_DEBUG(("index %d: %p : %x %x", BX_E1000_THIS s.mac_reg[TDH],
               (void *)desc.buffer_addr, desc.lower.data,
                desc.upper.data));
 
     process_tx_desc(&desc);
-    cause |= txdesc_writeback(base, &desc);
+    if (txdesc_writeback(&desc)) {
+      memcpy(dp, &desc, sizeof(desc));
+      txd_lower = le32_to_cpu(desc.lower.data);
+      // TXDW is only delayed if all the reporting descriptors ask for it
+      if (!(txd_lower & E1000_TXD_CMD_IDE))
+        delayed = 0;
+      txdw = E1000_ICR_TXDW;
+    }
 
     if (++BX_E1000_THIS s.mac_reg[TDH] * sizeof(desc) >= BX_E1000_THIS s.mac_reg[TDLEN])
         BX_E1000_THIS s.mac_reg[TDH] = 0;
@@ -1273,6 +1657,13 @@ void bx_e1000_c::start_xmit()
       break;
     }
   }
+  desc_writeback(0);
+  tx_flush();
+  if (txdw && delayed && (BX_E1000_THIS s.mac_reg[TIDV] & 0xffff)) {
+    delay_int(0, txdw);
+  } else {
+    cause |= txdw;
+  }
   BX_E1000_THIS s.tx.int_cause = cause;
   bx_pc_system.activate_timer(BX_E1000_THIS s.tx_timer_index, 10, 0); // not continuous
   bx_gui->statusbar_setitem(BX_E1000_THIS s.statusbar_id, 1, 1);
@@ -1390,13 +1781,51 @@ Bit32u bx_e1000_c::rx_status()
 void bx_e1000_c::rx_handler(void *arg, const void *buf, unsigned len)
 {
   bx_e1000_c *class_ptr = (bx_e1000_c *) arg;
-  class_ptr->rx_frame(buf, len);
+  Bit32u cause = class_ptr->rx_frame(buf, len);
+  class_ptr->desc_writeback(1);
+  if (cause & E1000_ICS_RXT0) {
+    class_ptr->delay_int(1, E1000_ICS_RXT0);
+  }
+  if (cause & ~E1000_ICS_RXT0) {
+    class_ptr->set_ics(cause & ~E1000_ICS_RXT0);
+  }
+  if (cause & E1000_ICS_RXT0) {
+    bx_gui->statusbar_setitem(class_ptr->s.statusbar_id, 1);
+  }
+}
+
+/*
+ * Callback from the eth system driver with several frames: the descriptors
+ * are written back and the interrupt causes raised once for the whole batch
+ */
+unsigned bx_e1000_c::rx_batch_handler(void *arg, const eth_rx_frame_t *frames, unsigned count)
+{
+  bx_e1000_c *class_ptr = (bx_e1000_c *) arg;
+  Bit32u cause = 0;
+  unsigned i;
+
+  for (i = 0; i < count; i++) {
+    if (!(class_ptr->rx_status() & BX_NETDEV_RXREADY)) break;
+    cause |= class_ptr->rx_frame(frames[i].buf, frames[i].len);
+  }
+  class_ptr->desc_writeback(1);
+  if (cause & E1000_ICS_RXT0) {
+    class_ptr->delay_int(1, E1000_ICS_RXT0);
+  }
+  if (cause & ~E1000_ICS_RXT0) {
+    class_ptr->set_ics(cause & ~E1000_ICS_RXT0);
+  }
+  if (cause & E1000_ICS_RXT0) {
+    bx_gui->statusbar_setitem(class_ptr->s.statusbar_id, 1);
+  }
+  return i;
 }
 
-void bx_e1000_c::rx_frame(const void *buf, unsigned buf_size)
+// returns the interrupt causes to raise for the frame
+Bit32u bx_e1000_c::rx_frame(const void *buf, unsigned buf_size)
 {
   struct e1000_rx_desc desc;
-  bx_phy_address base;
+  Bit8u *dp;
   unsigned int n, rdt;
   Bit32u rdh_start;
   Bit16u vlan_special = 0;
@@ -1407,7 +1836,7 @@ void bx_e1000_c::rx_frame(const void *buf, unsigned buf_size)
   size_t total_size;
 
   if (!(BX_E1000_THIS s.mac_reg[RCTL] & E1000_RCTL_EN))
-    return;
+    return 0;
 
   // Pad to minimum Ethernet frame length
   if (buf_size < sizeof(min_buf)) {
@@ -1418,7 +1847,7 @@ void bx_e1000_c::rx_frame(const void *buf, unsigned buf_size)
   }
 
   if (!receive_filter((Bit8u *)buf, buf_size))
-    return;
+    return 0;
 
   if (vlan_enabled() && is_vlan_packet((Bit8u *)buf)) {
     vlan_special = cpu_to_le16(get_net2(((Bit8u *)(buf) + 14)));
@@ -1432,16 +1861,15 @@ void bx_e1000_c::rx_frame(const void *buf, unsigned buf_size)
   desc_offset = 0;
   total_size = buf_size + fcs_len();
   if (!e1000_has_rxbufs(total_size)) {
-    set_ics(E1000_ICS_RXO);
-    return;
+    return E1000_ICS_RXO;
   }
   do {
     desc_size = total_size - desc_offset;
     if (desc_size > BX_E1000_THIS s.rxbuf_size) {
         desc_size = BX_E1000_THIS s.rxbuf_size;
     }
-    base = rx_desc_base() + sizeof(desc) * BX_E1000_THIS s.mac_reg[RDH];
-    DEV_MEM_READ_PHYSICAL_DMA(base, sizeof(desc), (Bit8u *)&desc);
+    dp = desc_fetch(1, BX_E1000_THIS s.mac_reg[RDH]);
+    memcpy(&desc, dp, sizeof(desc));
     desc.special = vlan_special;
     desc.status |= (vlan_status | E1000_RXD_STAT_DD);
     if (desc.buffer_addr) {
@@ -1465,7 +1893,7 @@ void bx_e1000_c::rx_frame(const void *buf, unsigned buf_size)
     } else { // as per intel docs; skip descriptors with null buf addr
       BX_ERROR(("Null RX descriptor!!"));
     }
-    DEV_MEM_WRITE_PHYSICAL_DMA(base, sizeof(desc), (Bit8u *)&desc);
+    memcpy(dp, &desc, sizeof(desc));
     if (++BX_E1000_THIS s.mac_reg[RDH] * sizeof(desc) >= BX_E1000_THIS s.mac_reg[RDLEN])
         BX_E1000_THIS s.mac_reg[RDH] = 0;
     BX_E1000_THIS s.check_rxov = 1;
@@ -1473,8 +1901,7 @@ void bx_e1000_c::rx_frame(const void *buf, unsigned buf_size)
     if (BX_E1000_THIS s.mac_reg[RDH] == rdh_start) {
         BX_DEBUG(("RDH wraparound @%x, RDT %x, RDLEN %x",
                   rdh_start, BX_E1000_THIS s.mac_reg[RDT], BX_E1000_THIS s.mac_reg[RDLEN]));
-        set_ics(E1000_ICS_RXO);
-        return;
+        return E1000_ICS_RXO;
     }
   } while (desc_offset < total_size);
 
@@ -1496,9 +1923,7 @@ void bx_e1000_c::rx_frame(const void *buf, unsigned buf_size)
       BX_E1000_THIS s.rxbuf_min_shift)
     n |= E1000_ICS_RXDMT0;
 
-  set_ics(n);
-
-  bx_gui->statusbar_setitem(BX_E1000_THIS s.statusbar_id, 1);
+  return n;
 }
 
 
@@ -42,6 +42,9 @@
 #  define BX_E1000_THIS_PTR this
 #endif
 
+#define BX_E1000_TX_BATCH 16 // frames passed to the pktmover at once
+#define BX_E1000_DESC_BATCH 32 // descriptors fetched / written back at once
+
 struct e1000_tx_desc {
   Bit64u buffer_addr;   // Address of the descriptor's data buffer
   union {
@@ -98,6 +101,33 @@ typedef struct {
 
   e1000_tx tx;
 
+  struct {
+    Bit8u   *buf;
+    unsigned count;
+    eth_packet_t pkt[BX_E1000_TX_BATCH];
+  } tx_batch;
+  Bit32u tx_offload; // offload capabilities of the pktmover
+
+  // descriptors prefetched from the ring: modified in place and written
+  // back with a single DMA access
+  struct {
+    Bit32u   head;   // ring index of desc[0]
+    unsigned count;  // descriptors fetched
+    unsigned used;   // descriptors consumed (to be written back)
+    Bit8u    desc[BX_E1000_DESC_BATCH * 16];
+  } rx_cache, tx_cache;
+
+  // interrupt moderation (ITR, RDTR/RADV, TIDV/TADV)
+  struct {
+    Bit32u  pending;   // delayed interrupt causes
+    Bit64u  deadline;  // absolute delay timer expiration (usec)
+    int     timer_index;
+  } rx_delay, tx_delay;
+  bx_bool int_level;   // INTx pin asserted
+  bx_bool itr_active;  // throttling interval running
+  bx_bool itr_pending; // interrupt held back by the throttling interval
+  int     itr_timer_index;
+
   struct {
     Bit32u  val_in; // shifted in from guest driver
     Bit16u  bitnum_in;
@@ -133,6 +163,8 @@ private:
   BX_E1000_SMF void    set_irq_level(bx_bool level);
   BX_E1000_SMF void    set_interrupt_cause(Bit32u val);
   BX_E1000_SMF void    set_ics(Bit32u value);
+  BX_E1000_SMF void    delay_int(bx_bool rx, Bit32u cause);
+  BX_E1000_SMF void    flush_delayed_int(bx_bool rx);
   BX_E1000_SMF int     rxbufsize(Bit32u v);
   BX_E1000_SMF void    set_rx_control(Bit32u value);
   BX_E1000_SMF void    set_mdic(Bit32u value);
@@ -145,14 +177,24 @@ private:
   BX_E1000_SMF bx_bool is_vlan_packet(const Bit8u *buf);
   BX_E1000_SMF bx_bool is_vlan_txd(Bit32u txd_lower);
   BX_E1000_SMF int     fcs_len(void);
+  BX_E1000_SMF bx_bool tso_passthrough(void);
   BX_E1000_SMF void    xmit_seg(void);
   BX_E1000_SMF void    process_tx_desc(struct e1000_tx_desc *dp);
-  BX_E1000_SMF Bit32u  txdesc_writeback(bx_phy_address base, struct e1000_tx_desc *dp);
+  BX_E1000_SMF Bit32u  txdesc_writeback(struct e1000_tx_desc *dp);
   BX_E1000_SMF Bit64u  tx_desc_base(void);
   BX_E1000_SMF void    start_xmit(void);
+  BX_E1000_SMF void    tx_queue(const Bit8u *buf, unsigned len, const eth_offload_t *offload);
+  BX_E1000_SMF void    tx_flush(void);
 
   static void tx_timer_handler(void *);
   void tx_timer(void);
+  static void rx_delay_timer_handler(void *);
+  static void tx_delay_timer_handler(void *);
+  static void itr_timer_handler(void *);
+  BX_E1000_SMF void itr_timer(void);
+
+  BX_E1000_SMF Bit8u*  desc_fetch(bx_bool rx, Bit32u index);
+  BX_E1000_SMF void    desc_writeback(bx_bool rx);
 
   BX_E1000_SMF int     receive_filter(const Bit8u *buf, int size);
   BX_E1000_SMF bx_bool e1000_has_rxbufs(size_t total_size);
@@ -161,7 +203,8 @@ private:
   static Bit32u rx_status_handler(void *arg);
   BX_E1000_SMF Bit32u rx_status(void);
   static void rx_handler(void *arg, const void *buf, unsigned len);
-  BX_E1000_SMF void rx_frame(const void *buf, unsigned io_len);
+  static unsigned rx_batch_handler(void *arg, const eth_rx_frame_t *frames, unsigned count);
+  BX_E1000_SMF Bit32u rx_frame(const void *buf, unsigned io_len);
 
   BX_E1000_SMF bx_bool mem_read_handler(bx_phy_address addr, unsigned len, void *data, void *param);
   BX_E1000_SMF bx_bool mem_write_handler(bx_phy_address addr, unsigned len, void *data, void *param);
@@ -61,7 +61,14 @@ extern "C" {
 #include <linux/filter.h>
 };
 
-#define BX_PACKET_POLL  1000    // Poll for a frame every 1000 usecs
+// recvmmsg() / sendmmsg() read and write several frames with one syscall
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 14))
+#define BX_LINUX_MMSG 1
+#else
+#define BX_LINUX_MMSG 0
+#endif
+
+#define BX_LINUX_BATCH 16 // frames per recvmmsg() / sendmmsg() call
 
 // template filter for a unicast mac address and all
 // multicast/broadcast frames
@@ -95,15 +102,24 @@ public:
                       eth_rx_status_t rxstat,
                       bx_devmodel_c *dev,
                       const char *script);
+  virtual ~bx_linux_pktmover_c();
   void sendpkt(void *buf, unsigned io_len);
+#if BX_LINUX_MMSG
+  unsigned sendpkts(const eth_packet_t *pkts, unsigned count);
+  bx_bool tx_batching() {return 1;}
+  bx_bool tx_thread_safe() {return 1;}
+#endif
+
+protected:
+  int rx_frame(Bit8u *buf, unsigned size);
+#if BX_LINUX_MMSG
+  int rx_frames(eth_rx_frame_t *frames, unsigned count);
+#endif
 
 private:
   unsigned char *linux_macaddr[6];
   int fd;
   int ifindex;
-  static void rx_timer_handler(void *);
-  void rx_timer(void);
-  int rx_timer_index;
   struct sock_filter filter[BX_LSF_ICNT];
 };
 
@@ -222,16 +238,22 @@ bx_linux_pktmover_c::bx_linux_pktmover_c(const char *netif,
     return;
   }
 
-  // Start the rx poll
-  this->rx_timer_index =
-    bx_pc_system.register_timer(this, this->rx_timer_handler, BX_PACKET_POLL,
-                                1, 1, "eth_linux"); // continuous, active
-
   this->rxh    = rxh;
   this->rxstat = rxstat;
+
+  // Start receiving in the network I/O thread
+  rx_thread_start(this->fd);
   BX_INFO(("linux network driver initialized: using interface %s", netif));
 }
 
+bx_linux_pktmover_c::~bx_linux_pktmover_c()
+{
+  rx_thread_stop();
+  if (this->fd != -1) {
+    close(this->fd);
+  }
+}
+
 // the output routine - called with pre-formatted ethernet frame.
 void
 bx_linux_pktmover_c::sendpkt(void *buf, unsigned io_len)
@@ -245,47 +267,116 @@ bx_linux_pktmover_c::sendpkt(void *buf, unsigned io_len)
   }
 }
 
-// The receive poll process
-void
-bx_linux_pktmover_c::rx_timer_handler(void *this_ptr)
+#if BX_LINUX_MMSG
+unsigned
+bx_linux_pktmover_c::sendpkts(const eth_packet_t *pkts, unsigned count)
 {
-  bx_linux_pktmover_c *class_ptr = (bx_linux_pktmover_c *) this_ptr;
+  struct mmsghdr msgs[BX_LINUX_BATCH];
+  struct iovec iov[BX_LINUX_BATCH][BX_PACKET_MAX_IOV];
+  unsigned i, j, n, failed = 0;
+  int ret;
 
-  class_ptr->rx_timer();
+  if (this->fd == -1)
+    return 0;
+
+  while (count > 0) {
+    n = (count > BX_LINUX_BATCH) ? BX_LINUX_BATCH : count;
+    memset(msgs, 0, n * sizeof(struct mmsghdr));
+    for (i = 0; i < n; i++) {
+      for (j = 0; j < pkts[i].iovcnt; j++) {
+        iov[i][j].iov_base = (void*)pkts[i].iov[j].base;
+        iov[i][j].iov_len = pkts[i].iov[j].len;
+      }
+      msgs[i].msg_hdr.msg_iov = iov[i];
+      msgs[i].msg_hdr.msg_iovlen = pkts[i].iovcnt;
+    }
+    for (i = 0; i < n; i += ret) {
+      ret = sendmmsg(this->fd, &msgs[i], n - i, 0);
+      if (ret <= 0) {
+        failed += n - i;
+        break;
+      }
+    }
+    pkts += n;
+    count -= n;
+  }
+  return failed;
 }
+#endif
 
-void
-bx_linux_pktmover_c::rx_timer(void)
+// The receive process - called by the network I/O thread
+int
+bx_linux_pktmover_c::rx_frame(Bit8u *rxbuf, unsigned size)
 {
   int nbytes = 0;
-  Bit8u rxbuf[BX_PACKET_BUFSIZE];
   struct sockaddr_ll sll;
   socklen_t fromlen;
 
   if (this->fd == -1)
-    return;
+    return -1;
 
   fromlen = sizeof(sll);
-  nbytes = recvfrom(this->fd, rxbuf, sizeof(rxbuf), 0, (struct sockaddr *)&sll, &fromlen);
+  nbytes = recvfrom(this->fd, rxbuf, size, 0, (struct sockaddr *)&sll, &fromlen);
 
-  if (nbytes == -1) {
-    if (errno != EAGAIN)
-      BX_INFO(("eth_linux: error receiving packet: %s\n", strerror(errno)));
-    return;
+  if (nbytes <= 0) {
+    if ((nbytes == -1) && (errno != EAGAIN)) {
+      rx_stats.errors++;
+      rx_stats.last_errno = errno;
+    }
+    return -1;
   }
 
   // this should be done with LSF someday
   // filter out packets sourced by us
   if (memcmp(sll.sll_addr, this->linux_macaddr, 6) == 0)
-    return;
+    return 0;
   // let through broadcast, multicast, and our mac address
-//  if ((memcmp(rxbuf, broadcast_macaddr, 6) == 0) || (memcmp(rxbuf, this->linux_macaddr, 6) == 0) || rxbuf[0] & 0x01) {
-    BX_DEBUG(("eth_linux: got packet: %d bytes, dst=%x:%x:%x:%x:%x:%x, src=%x:%x:%x:%x:%x:%x\n", nbytes, rxbuf[0], rxbuf[1], rxbuf[2], rxbuf[3], rxbuf[4], rxbuf[5], rxbuf[6], rxbuf[7], rxbuf[8], rxbuf[9], rxbuf[10], rxbuf[11]));
-    if (this->rxstat(this->netdev) & BX_NETDEV_RXREADY) {
-      this->rxh(this->netdev, rxbuf, nbytes);
-    } else {
-      BX_ERROR(("device not ready to receive data"));
+  return nbytes;
+}
+
+#if BX_LINUX_MMSG
+int
+bx_linux_pktmover_c::rx_frames(eth_rx_frame_t *frames, unsigned count)
+{
+  struct mmsghdr msgs[BX_LINUX_BATCH];
+  struct iovec iov[BX_LINUX_BATCH];
+  struct sockaddr_ll sll[BX_LINUX_BATCH];
+  unsigned i, n = 0;
+  int ret;
+
+  if (this->fd == -1)
+    return -1;
+
+  if (count > BX_LINUX_BATCH)
+    count = BX_LINUX_BATCH;
+  memset(msgs, 0, count * sizeof(struct mmsghdr));
+  for (i = 0; i < count; i++) {
+    iov[i].iov_base = frames[i].buf;
+    iov[i].iov_len = BX_PACKET_BUFSIZE;
+    msgs[i].msg_hdr.msg_iov = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_name = &sll[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(sll[i]);
+  }
+  ret = recvmmsg(this->fd, msgs, count, MSG_DONTWAIT, NULL);
+  if (ret <= 0) {
+    if ((ret == -1) && (errno != EAGAIN)) {
+      rx_stats.errors++;
+      rx_stats.last_errno = errno;
     }
-//  }
+    return -1;
+  }
+  for (i = 0; i < (unsigned)ret; i++) {
+    // filter out packets sourced by us
+    if (memcmp(sll[i].sll_addr, this->linux_macaddr, 6) == 0)
+      continue;
+    if (n != i) {
+      memcpy(frames[n].buf, frames[i].buf, msgs[i].msg_len);
+    }
+    frames[n++].len = msgs[i].msg_len;
+  }
+  return n;
 }
+#endif
+
 #endif /* if BX_NETWORKING && BX_NETMOD_LINUX */
@@ -127,12 +127,16 @@ public:
   bx_tap_pktmover_c(const char *netif, const char *macaddr,
                     eth_rx_handler_t rxh, eth_rx_status_t rxstat,
                     bx_devmodel_c *dev, const char *script);
+  virtual ~bx_tap_pktmover_c();
   void sendpkt(void *buf, unsigned io_len);
+#if !defined(__sun__) && !BX_ETH_TAP_LOGGING
+  unsigned sendpkts(const eth_packet_t *pkts, unsigned count);
+  bx_bool tx_thread_safe() {return 1;}
+#endif
+protected:
+  int rx_frame(Bit8u *buf, unsigned size);
 private:
   int fd;
-  int rx_timer_index;
-  static void rx_timer_handler(void *);
-  void rx_timer ();
   Bit8u guest_macaddr[6];
 #if BX_ETH_TAP_LOGGING
   FILE *txlog, *txlog_txt, *rxlog, *rxlog_txt;
@@ -262,13 +266,11 @@ bx_tap_pktmover_c::bx_tap_pktmover_c(const char *netif,
       BX_ERROR(("execute script '%s' on %s failed", script, intname));
   }
 
-  // Start the rx poll
-  this->rx_timer_index =
-    bx_pc_system.register_timer(this, this->rx_timer_handler, 1000,
-                                1, 1, "eth_tap"); // continuous, active
   this->rxh    = rxh;
   this->rxstat = rxstat;
   memcpy(&guest_macaddr[0], macaddr, 6);
+  // Start receiving in the network I/O thread
+  rx_thread_start(fd);
 #if BX_ETH_TAP_LOGGING
   // eventually Bryce wants txlog to dump in pcap format so that
   // tcpdump -r FILE can read it and interpret packets.
@@ -299,6 +301,14 @@ bx_tap_pktmover_c::bx_tap_pktmover_c(const char *netif,
 #endif
 }
 
+bx_tap_pktmover_c::~bx_tap_pktmover_c()
+{
+  rx_thread_stop();
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
 void bx_tap_pktmover_c::sendpkt(void *buf, unsigned io_len)
 {
   Bit8u txbuf[BX_PACKET_BUFSIZE];
@@ -346,18 +356,42 @@ void bx_tap_pktmover_c::sendpkt(void *buf, unsigned io_len)
 #endif
 }
 
-void bx_tap_pktmover_c::rx_timer_handler(void *this_ptr)
+#if !defined(__sun__) && !BX_ETH_TAP_LOGGING
+// send scattered frames without copying them into a single buffer
+unsigned bx_tap_pktmover_c::sendpkts(const eth_packet_t *pkts, unsigned count)
 {
-  bx_tap_pktmover_c *class_ptr = (bx_tap_pktmover_c *) this_ptr;
-  class_ptr->rx_timer();
+  struct iovec iov[BX_PACKET_MAX_IOV + 1];
+  static const Bit8u pad[2] = {0, 0};
+  unsigned i, j, n, len, failed = 0;
+
+  for (i = 0; i < count; i++) {
+    n = 0;
+    len = 0;
+#if !defined(__FreeBSD__) && !defined(__FreeBSD_kernel__) && \
+    !defined(__APPLE__) && !defined(__OpenBSD__) // Should be fixed for other *BSD
+    iov[n].iov_base = (void*)pad;
+    iov[n++].iov_len = 2;
+    len += 2;
+#endif
+    for (j = 0; j < pkts[i].iovcnt; j++) {
+      iov[n].iov_base = (void*)pkts[i].iov[j].base;
+      iov[n++].iov_len = pkts[i].iov[j].len;
+      len += pkts[i].iov[j].len;
+    }
+    if ((unsigned)writev(fd, iov, n) != len) {
+      failed++;
+    }
+  }
+  return failed;
 }
+#endif
 
-void bx_tap_pktmover_c::rx_timer()
+// called by the network I/O thread
+int bx_tap_pktmover_c::rx_frame(Bit8u *rxbuf, unsigned size)
 {
   int nbytes;
   Bit8u buf[BX_PACKET_BUFSIZE];
-  Bit8u *rxbuf;
-  if (fd<0) return;
+  if (fd<0) return -1;
 #if defined(__sun__)
   struct strbuf sbuf;
   int f = 0;
@@ -368,12 +402,21 @@ void bx_tap_pktmover_c::rx_timer()
   nbytes = read (fd, buf, sizeof(buf));
 #endif
 
+  if (nbytes<=0) {
+    if ((nbytes<0) && (errno != EAGAIN)) {
+      rx_stats.errors++;
+      rx_stats.last_errno = errno;
+    }
+    return -1;
+  }
+
   // hack: discard first two bytes
 #if defined(__FreeBSD__) || defined(__FreeBSD_kernel__) || defined(__APPLE__) || defined(__sun__) // Should be fixed for other *BSD
-  rxbuf = buf;
+  memcpy(rxbuf, buf, nbytes);
 #else
-  rxbuf = buf+2;
   nbytes-=2;
+  if (nbytes<=0) return 0;
+  memcpy(rxbuf, buf+2, nbytes);
 #endif
 
 #if defined(__linux__)
@@ -385,36 +428,21 @@ void bx_tap_pktmover_c::rx_timer()
   }
 #endif
 
-  if (nbytes>0)
-    BX_DEBUG(("tap read returned %d bytes", nbytes));
-  if (nbytes<0) {
-    if (errno != EAGAIN)
-      BX_ERROR(("tap read error: %s", strerror(errno)));
-    return;
-  }
 #if BX_ETH_TAP_LOGGING
-  if (nbytes > 0) {
-    BX_DEBUG(("receive packet length %u", nbytes));
-    // dump raw bytes to a file, eventually dump in pcap format so that
-    // tcpdump -r FILE can interpret them for us.
-    int n = fwrite(rxbuf, nbytes, 1, rxlog);
-    if (n != 1) BX_ERROR(("fwrite to rxlog failed, nbytes = %d", nbytes));
-    // dump packet in hex into an ascii log file
-    write_pktlog_txt(rxlog_txt, rxbuf, nbytes, 1);
-    // flush log so that we see the packets as they arrive w/o buffering
-    fflush(rxlog);
-  }
+  // dump raw bytes to a file, eventually dump in pcap format so that
+  // tcpdump -r FILE can interpret them for us.
+  int n = fwrite(rxbuf, nbytes, 1, rxlog);
+  if (n != 1) rx_stats.log_errors++;
+  // dump packet in hex into an ascii log file
+  write_pktlog_txt(rxlog_txt, rxbuf, nbytes, 1);
+  // flush log so that we see the packets as they arrive w/o buffering
+  fflush(rxlog);
 #endif
-  BX_DEBUG(("eth_tap: got packet: %d bytes, dst=%x:%x:%x:%x:%x:%x, src=%x:%x:%x:%x:%x:%x\n", nbytes, rxbuf[0], rxbuf[1], rxbuf[2], rxbuf[3], rxbuf[4], rxbuf[5], rxbuf[6], rxbuf[7], rxbuf[8], rxbuf[9], rxbuf[10], rxbuf[11]));
   if (nbytes < 60) {
-    BX_INFO(("packet too short (%d), padding to 60", nbytes));
+    rx_stats.short_frames++;
     nbytes = 60;
   }
-  if (this->rxstat(this->netdev) & BX_NETDEV_RXREADY) {
-    this->rxh(this->netdev, rxbuf, nbytes);
-  } else {
-    BX_ERROR(("device not ready to receive data"));
-  }
+  return nbytes;
 }
 
 #endif /* if BX_NETWORKING && BX_NETMOD_TAP */
@@ -66,7 +66,14 @@
 
 #define BX_ETH_TUNTAP_LOGGING 0
 
-int tun_alloc(char *dev);
+// The vnet header passes TSO frames and partial checksums to the host
+#if defined(__linux__) && defined(IFF_VNET_HDR) && !BX_ETH_TUNTAP_LOGGING
+#define BX_TUNTAP_VNET_HDR 1
+#else
+#define BX_TUNTAP_VNET_HDR 0
+#endif
+
+int tun_alloc(char *dev, bx_bool *vnet_hdr);
 
 //
 //  Define the class. This is private to this module
@@ -76,12 +83,18 @@ public:
   bx_tuntap_pktmover_c(const char *netif, const char *macaddr,
                        eth_rx_handler_t rxh, eth_rx_status_t rxstat,
                        bx_devmodel_c *dev, const char *script);
+  virtual ~bx_tuntap_pktmover_c();
   void sendpkt(void *buf, unsigned io_len);
+#if !defined(__APPLE__) && !defined(NEVERDEF) && !BX_ETH_TUNTAP_LOGGING
+  unsigned sendpkts(const eth_packet_t *pkts, unsigned count);
+  bx_bool tx_thread_safe() {return 1;}
+#endif
+  Bit32u offload_caps();
+protected:
+  int rx_frame(Bit8u *buf, unsigned size);
 private:
   int fd;
-  int rx_timer_index;
-  static void rx_timer_handler(void *);
-  void rx_timer ();
+  bx_bool vnet_hdr;
   Bit8u guest_macaddr[6];
 #if BX_ETH_TUNTAP_LOGGING
   FILE *txlog, *txlog_txt, *rxlog, *rxlog_txt;
@@ -162,7 +175,7 @@ bx_tuntap_pktmover_c::bx_tuntap_pktmover_c(const char *netif,
 #endif
   char intname[IFNAMSIZ];
   strcpy(intname,netif);
-  fd=tun_alloc(intname);
+  fd=tun_alloc(intname, &vnet_hdr);
   if (fd < 0) {
     BX_PANIC(("open failed on %s: %s", netif, strerror (errno)));
     return;
@@ -177,7 +190,8 @@ bx_tuntap_pktmover_c::bx_tuntap_pktmover_c(const char *netif,
     BX_PANIC(("set tun device flags: %s", strerror (errno)));
   }
 
-  BX_INFO(("tuntap network driver: opened %s device", netif));
+  BX_INFO(("tuntap network driver: opened %s device%s", netif,
+           vnet_hdr ? " (TSO / checksum offload)" : ""));
 
   /* Execute the configuration script */
   if((script != NULL) && (strcmp(script, "") != 0) && (strcmp(script, "none") != 0))
@@ -186,13 +200,11 @@ bx_tuntap_pktmover_c::bx_tuntap_pktmover_c(const char *netif,
       BX_ERROR(("execute script '%s' on %s failed", script, intname));
   }
 
-  // Start the rx poll
-  this->rx_timer_index =
-    bx_pc_system.register_timer(this, this->rx_timer_handler, 1000,
-                                1, 1, "eth_tuntap"); // continuous, active
   this->rxh    = rxh;
   this->rxstat = rxstat;
   memcpy(&guest_macaddr[0], macaddr, 6);
+  // Start receiving in the network I/O thread
+  rx_thread_start(fd);
 #if BX_ETH_TUNTAP_LOGGING
   // eventually Bryce wants txlog to dump in pcap format so that
   // tcpdump -r FILE can read it and interpret packets.
@@ -223,6 +235,14 @@ bx_tuntap_pktmover_c::bx_tuntap_pktmover_c(const char *netif,
 #endif
 }
 
+bx_tuntap_pktmover_c::~bx_tuntap_pktmover_c()
+{
+  rx_thread_stop();
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
 void bx_tuntap_pktmover_c::sendpkt(void *buf, unsigned io_len)
 {
 #ifdef __APPLE__ //FIXME
@@ -244,7 +264,21 @@ void bx_tuntap_pktmover_c::sendpkt(void *buf, unsigned io_len)
     BX_DEBUG(("wrote %d bytes + 2 byte pad on tuntap", io_len));
   }
 #else
-  unsigned int size = write (fd, buf, io_len);
+  unsigned int size;
+#if BX_TUNTAP_VNET_HDR
+  if (vnet_hdr) {
+    eth_packet_t pkt;
+    memset(&pkt, 0, sizeof(pkt));
+    pkt.iovcnt = 1;
+    pkt.iov[0].base = buf;
+    pkt.iov[0].len = io_len;
+    if (sendpkts(&pkt, 1) > 0) {
+      BX_PANIC(("write on tuntap device: %s", strerror (errno)));
+    }
+    return;
+  }
+#endif
+  size = write (fd, buf, io_len);
   if (size != io_len) {
     BX_PANIC(("write on tuntap device: %s", strerror (errno)));
   } else {
@@ -264,18 +298,49 @@ void bx_tuntap_pktmover_c::sendpkt(void *buf, unsigned io_len)
 #endif
 }
 
-void bx_tuntap_pktmover_c::rx_timer_handler (void *this_ptr)
+#if !defined(__APPLE__) && !defined(NEVERDEF) && !BX_ETH_TUNTAP_LOGGING
+// send scattered frames without copying them into a single buffer
+unsigned bx_tuntap_pktmover_c::sendpkts(const eth_packet_t *pkts, unsigned count)
+{
+  struct iovec iov[BX_PACKET_MAX_IOV + 1];
+  unsigned i, j, n, len, failed = 0;
+
+  for (i = 0; i < count; i++) {
+    n = 0;
+    len = 0;
+    if (vnet_hdr) {
+      // the offload request has the layout of the vnet header
+      iov[n].iov_base = (void*)&pkts[i].offload;
+      iov[n++].iov_len = sizeof(eth_offload_t);
+      len += sizeof(eth_offload_t);
+    }
+    for (j = 0; j < pkts[i].iovcnt; j++) {
+      iov[n].iov_base = (void*)pkts[i].iov[j].base;
+      iov[n++].iov_len = pkts[i].iov[j].len;
+      len += pkts[i].iov[j].len;
+    }
+    if ((unsigned)writev(fd, iov, n) != len) {
+      failed++;
+    }
+  }
+  return failed;
+}
+#endif
+
+Bit32u bx_tuntap_pktmover_c::offload_caps()
 {
-  bx_tuntap_pktmover_c *class_ptr = (bx_tuntap_pktmover_c *) this_ptr;
-  class_ptr->rx_timer();
+  if (vnet_hdr) {
+    return BX_NETDEV_OFFLOAD_CSUM | BX_NETDEV_OFFLOAD_TSO4 | BX_NETDEV_OFFLOAD_TSO6;
+  }
+  return 0;
 }
 
-void bx_tuntap_pktmover_c::rx_timer()
+// called by the network I/O thread
+int bx_tuntap_pktmover_c::rx_frame(Bit8u *buf, unsigned size)
 {
-  int nbytes;
-  Bit8u buf[BX_PACKET_BUFSIZE];
-  Bit8u *rxbuf;
-  if (fd<0) return;
+  int nbytes, ret;
+  Bit8u *rxbuf = buf;
+  if (fd<0) return -1;
 
 #ifdef __APPLE__ //FIXME:hack
   nbytes = 14;
@@ -283,17 +348,46 @@ void bx_tuntap_pktmover_c::rx_timer()
   buf[0] = buf[6] = 0xFE;
   buf[1] = buf[7] = 0xFD;
   buf[12] = 8;
-  nbytes += read (fd, buf+nbytes, sizeof(buf)-nbytes);
-  rxbuf=buf;
+  ret = read (fd, buf+nbytes, size-nbytes);
+  nbytes += ret;
 #elif NEVERDEF
-  nbytes = read (fd, buf, sizeof(buf));
+  ret = read (fd, buf, size);
   // hack: discard first two bytes
-  rxbuf = buf+2;
-  nbytes-=2;
+  nbytes = ret-2;
+  if (nbytes > 0) memmove(buf, buf+2, nbytes);
 #else
-  nbytes = read (fd, buf, sizeof(buf));
-  rxbuf=buf;
+#if BX_TUNTAP_VNET_HDR
+  if (vnet_hdr) {
+    eth_offload_t hdr;
+    struct iovec iov[2];
+    iov[0].iov_base = &hdr;
+    iov[0].iov_len = sizeof(hdr);
+    iov[1].iov_base = buf;
+    iov[1].iov_len = size;
+    ret = readv(fd, iov, 2);
+    if (ret > (int)sizeof(hdr)) {
+      ret -= sizeof(hdr);
+      // the host offload features are disabled, but be safe
+      if ((hdr.flags & BX_NETDEV_OFFLOAD_NEEDS_CSUM) &&
+          ((unsigned)(hdr.csum_start + hdr.csum_offset + 2) <= (unsigned)ret)) {
+        put_net2(buf + hdr.csum_start + hdr.csum_offset,
+                 ip_checksum(buf + hdr.csum_start, ret - hdr.csum_start) ^ (Bit16u)0xffff);
+      }
+    } else if (ret >= 0) {
+      ret = 0;
+    }
+  } else
 #endif
+  ret = read (fd, buf, size);
+  nbytes = ret;
+#endif
+  if (ret <= 0) {
+    if ((ret < 0) && (errno != EAGAIN)) {
+      rx_stats.errors++;
+      rx_stats.last_errno = errno;
+    }
+    return -1;
+  }
 
   // hack: TUN/TAP device likes to create an ethernet header which has
   // the same source and destination address FE:FD:00:00:00:00.
@@ -301,48 +395,26 @@ void bx_tuntap_pktmover_c::rx_timer()
   if (!memcmp(&rxbuf[0], &rxbuf[6], 6)) {
     rxbuf[5] = guest_macaddr[5];
   }
-
-#ifdef __APPLE__ //FIXME:hack
-  if (nbytes>14)
-#else
-  if (nbytes>0)
-#endif
-    BX_DEBUG(("tuntap read returned %d bytes", nbytes));
-#ifdef __APPLE__ //FIXME:hack
-  if (nbytes<14) {
-#else
-  if (nbytes<0) {
-#endif
-    if (errno != EAGAIN)
-      BX_ERROR(("tuntap read error: %s", strerror(errno)));
-    return;
-  }
 #if BX_ETH_TUNTAP_LOGGING
   if (nbytes > 0) {
-    BX_DEBUG(("receive packet length %u", nbytes));
     // dump raw bytes to a file, eventually dump in pcap format so that
     // tcpdump -r FILE can interpret them for us.
     int n = fwrite(rxbuf, nbytes, 1, rxlog);
-    if (n != 1) BX_ERROR (("fwrite to rxlog failed"));
+    if (n != 1) rx_stats.log_errors++;
     // dump packet in hex into an ascii log file
     write_pktlog_txt(rxlog_txt, rxbuf, nbytes, 1);
     // flush log so that we see the packets as they arrive w/o buffering
     fflush(rxlog);
   }
 #endif
-  BX_DEBUG(("eth_tuntap: got packet: %d bytes, dst=%02x:%02x:%02x:%02x:%02x:%02x, src=%02x:%02x:%02x:%02x:%02x:%02x", nbytes, rxbuf[0], rxbuf[1], rxbuf[2], rxbuf[3], rxbuf[4], rxbuf[5], rxbuf[6], rxbuf[7], rxbuf[8], rxbuf[9], rxbuf[10], rxbuf[11]));
   if (nbytes < 60) {
-    BX_INFO(("packet too short (%d), padding to 60", nbytes));
+    rx_stats.short_frames++;
     nbytes = 60;
   }
-  if (this->rxstat(this->netdev) & BX_NETDEV_RXREADY) {
-    this->rxh(this->netdev, rxbuf, nbytes);
-  } else {
-    BX_ERROR(("device not ready to receive data"));
-  }
+  return nbytes;
 }
 
-int tun_alloc(char *dev)
+int tun_alloc(char *dev, bx_bool *vnet_hdr)
 {
   struct ifreq ifr;
   char *ifname;
@@ -356,6 +428,7 @@ int tun_alloc(char *dev)
         break;
     }
   }
+  *vnet_hdr = 0;
   if ((fd = open(dev, O_RDWR)) < 0)
     return -1;
 #ifdef __linux__
@@ -367,6 +440,12 @@ int tun_alloc(char *dev)
    *        IFF_NO_PI - Do not provide packet information
    */
   ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+#if BX_TUNTAP_VNET_HDR
+  unsigned int features = 0;
+  if ((ioctl(fd, TUNGETFEATURES, &features) == 0) && (features & IFF_VNET_HDR)) {
+    ifr.ifr_flags |= IFF_VNET_HDR;
+  }
+#endif
   strncpy(ifr.ifr_name, ifname, IFNAMSIZ);
   if ((err = ioctl(fd, TUNSETIFF, (void *) &ifr)) < 0) {
     close(fd);
@@ -376,6 +455,9 @@ int tun_alloc(char *dev)
   dev[IFNAMSIZ-1]=0;
 
   ioctl(fd, TUNSETNOCSUM, 1);
+#if BX_TUNTAP_VNET_HDR
+  *vnet_hdr = ((ifr.ifr_flags & IFF_VNET_HDR) != 0);
+#endif
 #endif
 
   return fd;
@@ -72,12 +72,12 @@ public:
   bx_vde_pktmover_c(const char *netif, const char *macaddr,
                     eth_rx_handler_t rxh, eth_rx_status_t rxstat,
                     bx_devmodel_c *dev, const char *script);
+  virtual ~bx_vde_pktmover_c();
   void sendpkt(void *buf, unsigned io_len);
+protected:
+  int rx_frame(Bit8u *buf, unsigned size);
 private:
   int fd;
-  int rx_timer_index;
-  static void rx_timer_handler(void *);
-  void rx_timer();
   FILE *txlog, *txlog_txt, *rxlog, *rxlog_txt;
   int fddata;
   struct sockaddr_un dataout;
@@ -147,12 +147,10 @@ bx_vde_pktmover_c::bx_vde_pktmover_c(const char *netif,
       BX_ERROR(("execute script '%s' on %s failed", script, intname));
   }
 
-  // Start the rx poll
-  this->rx_timer_index =
-    bx_pc_system.register_timer(this, this->rx_timer_handler, 1000,
-                                1, 1, "eth_vde"); // continuous, active
   this->rxh    = rxh;
   this->rxstat = rxstat;
+  // Start receiving in the network I/O thread
+  rx_thread_start(fddata);
 #if BX_ETH_VDE_LOGGING
   // eventually Bryce wants txlog to dump in pcap format so that
   // tcpdump -r FILE can read it and interpret packets.
@@ -183,6 +181,11 @@ bx_vde_pktmover_c::bx_vde_pktmover_c(const char *netif,
 #endif
 }
 
+bx_vde_pktmover_c::~bx_vde_pktmover_c()
+{
+  rx_thread_stop();
+}
+
 void bx_vde_pktmover_c::sendpkt(void *buf, unsigned io_len)
 {
   unsigned int size;
@@ -207,57 +210,43 @@ void bx_vde_pktmover_c::sendpkt(void *buf, unsigned io_len)
 #endif
 }
 
-void bx_vde_pktmover_c::rx_timer_handler(void *this_ptr)
-{
-  bx_vde_pktmover_c *class_ptr = (bx_vde_pktmover_c *) this_ptr;
-  class_ptr->rx_timer();
-}
-
-void bx_vde_pktmover_c::rx_timer()
+// called by the network I/O thread
+int bx_vde_pktmover_c::rx_frame(Bit8u *buf, unsigned size)
 {
   int nbytes;
-  Bit8u buf[BX_PACKET_BUFSIZE];
   Bit8u *rxbuf;
   struct sockaddr_un datain;
-  socklen_t datainsize;
+  socklen_t datainsize = sizeof(datain);
 
-  if (fd<0) return;
+  if (fd<0) return -1;
   //nbytes = read (fd, buf, sizeof(buf));
-  nbytes=recvfrom(fddata,buf,sizeof(buf),MSG_DONTWAIT|MSG_WAITALL,(struct sockaddr *) &datain, &datainsize);
+  nbytes=recvfrom(fddata,buf,size,MSG_DONTWAIT|MSG_WAITALL,(struct sockaddr *) &datain, &datainsize);
 
   rxbuf=buf;
 
-  if (nbytes>0)
-    BX_INFO(("vde read returned %d bytes", nbytes));
-  if (nbytes<0) {
-    if (errno != EAGAIN)
-      BX_ERROR(("vde read error: %s", strerror(errno)));
-    return;
+  if (nbytes<=0) {
+    if ((nbytes<0) && (errno != EAGAIN)) {
+      rx_stats.errors++;
+      rx_stats.last_errno = errno;
+    }
+    return -1;
   }
 #if BX_ETH_VDE_LOGGING
-  if (nbytes > 0) {
-    BX_DEBUG(("receive packet length %u", nbytes));
-    // dump raw bytes to a file, eventually dump in pcap format so that
-    // tcpdump -r FILE can interpret them for us.
-    int n = fwrite(rxbuf, nbytes, 1, rxlog);
-    if (n != 1) BX_ERROR(("fwrite to rxlog failed"));
-    // dump packet in hex into an ascii log file
-    write_pktlog_txt(rxlog_txt, rxbuf, nbytes, 1);
-
-    // flush log so that we see the packets as they arrive w/o buffering
-    fflush(rxlog);
-  }
+  // dump raw bytes to a file, eventually dump in pcap format so that
+  // tcpdump -r FILE can interpret them for us.
+  int n = fwrite(rxbuf, nbytes, 1, rxlog);
+  if (n != 1) rx_stats.log_errors++;
+  // dump packet in hex into an ascii log file
+  write_pktlog_txt(rxlog_txt, rxbuf, nbytes, 1);
+
+  // flush log so that we see the packets as they arrive w/o buffering
+  fflush(rxlog);
 #endif
-  BX_DEBUG(("eth_vde: got packet: %d bytes, dst=%x:%x:%x:%x:%x:%x, src=%x:%x:%x:%x:%x:%x\n", nbytes, rxbuf[0], rxbuf[1], rxbuf[2], rxbuf[3], rxbuf[4], rxbuf[5], rxbuf[6], rxbuf[7], rxbuf[8], rxbuf[9], rxbuf[10], rxbuf[11]));
   if (nbytes < 60) {
-    BX_INFO(("packet too short (%d), padding to 60", nbytes));
+    rx_stats.short_frames++;
     nbytes = 60;
   }
-  if (this->rxstat(this->netdev) & BX_NETDEV_RXREADY) {
-    this->rxh(this->netdev, rxbuf, nbytes);
-  } else {
-    BX_ERROR(("device not ready to receive data"));
-  }
+  return nbytes;
 }
 
 //enum request_type { REQ_NEW_CONTROL };
@@ -675,6 +675,21 @@ bx_ne2k_c::asic_read(Bit32u offset, unsigned int io_len)
     }
 
     //BX_INFO(("ne2k read DMA: addr=%4x remote_bytes=%d",BX_NE2K_THIS s.remote_dma,BX_NE2K_THIS s.remote_bytes));
+#if BX_SUPPORT_REPEAT_SPEEDUPS
+    // REP INSW: copy as many words as possible straight from the buffer memory
+    if (DEV_bulk_io_quantum_requested()) {
+      unsigned quantums = bulk_dma_quantums(io_len);
+      if (quantums > 0) {
+        unsigned transferLen = io_len * quantums;
+        memcpy((Bit8u*) DEV_bulk_io_host_addr(),
+               &BX_NE2K_THIS s.mem[BX_NE2K_THIS s.remote_dma - BX_NE2K_MEMSTART], transferLen);
+        DEV_bulk_io_host_addr() += transferLen;
+        DEV_bulk_io_quantum_transferred() = quantums;
+        bulk_dma_done(transferLen);
+        return 0; // value returned not important
+      }
+    }
+#endif
     retval = chipmem_read(BX_NE2K_THIS s.remote_dma, io_len);
     //
     // The 8390 bumps the address and decreases the byte count
@@ -734,6 +749,21 @@ void bx_ne2k_c::asic_write(Bit32u offset, Bit32u value, unsigned io_len)
       BX_ERROR(("ne2K: dma write, byte count 0"));
     }
 
+#if BX_SUPPORT_REPEAT_SPEEDUPS
+    // REP OUTSW: copy as many words as possible straight into the buffer memory
+    if (DEV_bulk_io_quantum_requested()) {
+      unsigned quantums = bulk_dma_quantums(io_len);
+      if (quantums > 0) {
+        unsigned transferLen = io_len * quantums;
+        memcpy(&BX_NE2K_THIS s.mem[BX_NE2K_THIS s.remote_dma - BX_NE2K_MEMSTART],
+               (Bit8u*) DEV_bulk_io_host_addr(), transferLen);
+        DEV_bulk_io_host_addr() += transferLen;
+        DEV_bulk_io_quantum_transferred() = quantums;
+        bulk_dma_done(transferLen);
+        break;
+      }
+    }
+#endif
     chipmem_write(BX_NE2K_THIS s.remote_dma, value, io_len);
     if (io_len == 4) {
       BX_NE2K_THIS s.remote_dma += io_len;
@@ -771,6 +801,51 @@ void bx_ne2k_c::asic_write(Bit32u offset, Bit32u value, unsigned io_len)
   }
 }
 
+#if BX_SUPPORT_REPEAT_SPEEDUPS
+//
+// bulk_dma_quantums/bulk_dma_done - remote DMA fast path for the
+// repeated string i/o instructions. Only word transfers in word mode
+// are handled: the transfer must stay inside the buffer memory and
+// must not cross the end of the receive ring or the remote byte count.
+// Everything else falls back to the data port emulation above.
+//
+unsigned bx_ne2k_c::bulk_dma_quantums(unsigned io_len)
+{
+  Bit32u start = BX_NE2K_THIS s.remote_dma, end = BX_NE2K_MEMEND;
+  unsigned quantums;
+
+  if ((io_len != 2) || (BX_NE2K_THIS s.DCR.wdsize == 0) || (start & 1) ||
+      (start < BX_NE2K_MEMSTART) || (start >= BX_NE2K_MEMEND))
+    return 0;
+  if ((start < (Bit32u)(BX_NE2K_THIS s.page_stop << 8)) &&
+      (end > (Bit32u)(BX_NE2K_THIS s.page_stop << 8)))
+    end = BX_NE2K_THIS s.page_stop << 8;
+  quantums = (end - start) / io_len;
+  if (quantums > (unsigned)(BX_NE2K_THIS s.remote_bytes / io_len))
+    quantums = BX_NE2K_THIS s.remote_bytes / io_len;
+  if (quantums > DEV_bulk_io_quantum_requested())
+    quantums = DEV_bulk_io_quantum_requested();
+  return quantums;
+}
+
+void bx_ne2k_c::bulk_dma_done(unsigned len)
+{
+  BX_NE2K_THIS s.remote_dma += len;
+  if (BX_NE2K_THIS s.remote_dma == BX_NE2K_THIS s.page_stop << 8) {
+    BX_NE2K_THIS s.remote_dma = BX_NE2K_THIS s.page_start << 8;
+  }
+  BX_NE2K_THIS s.remote_bytes -= len;
+
+  // If all bytes have been transferred, signal remote-DMA complete
+  if (BX_NE2K_THIS s.remote_bytes == 0) {
+    BX_NE2K_THIS s.ISR.rdma_done = 1;
+    if (BX_NE2K_THIS s.IMR.rdma_inte) {
+      set_irq_level(1);
+    }
+  }
+}
+#endif
+
 //
 // page0_read/page0_write - These routines handle reads/writes to
 // the 'zeroth' page of the DS8390 register file
@@ -238,6 +238,10 @@ private:
 
   BX_NE2K_SMF void chipmem_write(Bit32u address, Bit32u value, unsigned io_len) BX_CPP_AttrRegparmN(3);
   BX_NE2K_SMF void asic_write(Bit32u address, Bit32u value, unsigned io_len);
+#if BX_SUPPORT_REPEAT_SPEEDUPS
+  BX_NE2K_SMF unsigned bulk_dma_quantums(unsigned io_len);
+  BX_NE2K_SMF void bulk_dma_done(unsigned len);
+#endif
   BX_NE2K_SMF void page0_write(Bit32u address, Bit32u value, unsigned io_len);
   BX_NE2K_SMF void page1_write(Bit32u address, Bit32u value, unsigned io_len);
   BX_NE2K_SMF void page2_write(Bit32u address, Bit32u value, unsigned io_len);
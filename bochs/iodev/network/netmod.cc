@@ -34,6 +34,8 @@
 #if BX_NETWORKING
 
 #include "netmod.h"
+#include "bxthread.h"
+#include "bxversion.h"
 
 #if !defined(WIN32) || defined(__CYGWIN__)
 #include <arpa/inet.h> /* ntohs, htons */
@@ -45,6 +47,65 @@
 
 bx_netmod_ctl_c* theNetModCtl = NULL;
 
+//
+// Packet capture: the pktmover of a device with the 'capture' option set
+// is wrapped by this class. The frames passed in both directions are copied
+// (up to 'snaplen' bytes, one of 'sampling' frames) into a ring and a
+// writer thread stores them in a pcap-ng file. The ring has a single
+// producer (the emulation thread) and a single consumer, so queueing a
+// frame costs one copy and no lock or syscall. If the writer cannot keep
+// up, frames are counted as dropped instead of stalling the guest.
+//
+typedef struct {
+  Bit64u   timestamp;
+  unsigned len;     // original frame length
+  unsigned caplen;  // bytes stored in the ring
+  bx_bool  inbound; // host to guest
+} bx_netcap_frame_t;
+
+class bx_capture_pktmover_c : public eth_pktmover_c {
+public:
+  bx_capture_pktmover_c(eth_pktmover_c *ethmod, bx_list_c *base,
+                        eth_rx_handler_t rxh, eth_rx_status_t rxstat,
+                        bx_devmodel_c *dev);
+  virtual ~bx_capture_pktmover_c();
+  void sendpkt(void *buf, unsigned io_len);
+  unsigned sendpkts(const eth_packet_t *pkts, unsigned count);
+  Bit32u offload_caps() {return ethmod->offload_caps();}
+  // transmit from the emulation thread only: the ring has one producer
+  bx_bool tx_thread_safe() {return 0;}
+  bx_bool tx_batching() {return ethmod->tx_batching();}
+  void set_rx_batch_handler(eth_rx_batch_handler_t rxh_batch);
+private:
+  static bx_capture_pktmover_c *lookup(void *netdev);
+  static void rx_handler(void *arg, const void *buf, unsigned len);
+  static unsigned rx_batch_handler(void *arg, const eth_rx_frame_t *frames, unsigned count);
+  Bit8u *capture_slot(unsigned len, bx_bool inbound);
+  void capture(const void *buf, unsigned len, bx_bool inbound);
+  static BX_THREAD_FUNC(writer_thread, indata);
+  void writer_loop();
+  void write_frames();
+  void write_block(Bit32u type, const Bit8u *body, unsigned len);
+
+  eth_pktmover_c *ethmod;
+  bx_capture_pktmover_c *next;
+  FILE *fp;
+  unsigned snaplen;
+  unsigned sampling;
+  unsigned sample_count;
+  Bit64u start_time;
+  Bit64u frames_seen;
+  Bit64u frames_dropped;
+  bx_netcap_frame_t *ring;
+  Bit8u *ring_data;
+  volatile unsigned head, tail;
+  volatile bx_bool stop;
+  BX_THREAD_ID(tid);
+  bx_bool thread_started;
+};
+
+static bx_capture_pktmover_c *captures = NULL;
+
 int libnetmod_LTX_plugin_init(plugin_t *plugin, plugintype_t type, int argc, char *argv[])
 {
   if (type == PLUGTYPE_CORE) {
@@ -84,6 +145,11 @@ void* bx_netmod_ctl_c::init_module(bx_list_c *base, void *rxh, void *rxstat, bx_
     if (ethmod == NULL)
       BX_PANIC(("could not locate null module"));
   }
+  const char *capture = SIM->get_param_string("capture", base)->getptr();
+  if ((strlen(capture) > 0) && strcmp(capture, "none")) {
+    ethmod = new bx_capture_pktmover_c(ethmod, base, (eth_rx_handler_t)rxh,
+                                       (eth_rx_status_t)rxstat, netdev);
+  }
   return ethmod;
 }
 
@@ -198,6 +264,761 @@ eth_locator_c::create(const char *type, const char *netif,
   return (NULL);
 }
 
+eth_pktmover_c::eth_pktmover_c()
+{
+  rxh_batch = NULL;
+#if BX_NETMOD_RX_THREAD
+  rx_ring = NULL;
+#endif
+}
+
+// default batch transmit: gather each frame and send it with sendpkt()
+unsigned eth_pktmover_c::sendpkts(const eth_packet_t *pkts, unsigned count)
+{
+  Bit8u txbuf[BX_PACKET_BUFSIZE], *buf;
+  unsigned i, j, len;
+
+  for (i = 0; i < count; i++) {
+    if (pkts[i].iovcnt == 1) {
+      sendpkt((void*)pkts[i].iov[0].base, pkts[i].iov[0].len);
+      continue;
+    }
+    len = 0;
+    for (j = 0; j < pkts[i].iovcnt; j++) {
+      len += pkts[i].iov[j].len;
+    }
+    buf = (len > sizeof(txbuf)) ? new Bit8u[len] : txbuf;
+    len = 0;
+    for (j = 0; j < pkts[i].iovcnt; j++) {
+      memcpy(buf + len, pkts[i].iov[j].base, pkts[i].iov[j].len);
+      len += pkts[i].iov[j].len;
+    }
+    sendpkt(buf, len);
+    if (buf != txbuf) delete [] buf;
+  }
+  return 0;
+}
+
+// pcap-ng block types and options
+#define PCAPNG_SHB        0x0a0d0d0a
+#define PCAPNG_IDB        0x00000001
+#define PCAPNG_ISB        0x00000005
+#define PCAPNG_EPB        0x00000006
+#define PCAPNG_BYTE_ORDER 0x1a2b3c4d
+#define PCAPNG_LINKTYPE_ETHERNET 1
+
+#define PCAPNG_OPT_END       0
+#define PCAPNG_SHB_USERAPPL  4
+#define PCAPNG_IF_NAME       2
+#define PCAPNG_EPB_FLAGS     2
+#define PCAPNG_ISB_IFRECV    4
+#define PCAPNG_ISB_IFDROP    5
+
+#define PCAPNG_EPB_INBOUND   1
+#define PCAPNG_EPB_OUTBOUND  2
+
+// appends an option to a block body and returns the new body length
+static unsigned pcapng_option(Bit8u *body, unsigned len, Bit16u code, const void *data, Bit16u size)
+{
+  memcpy(body + len, &code, 2);
+  memcpy(body + len + 2, &size, 2);
+  if (size > 0) {
+    memcpy(body + len + 4, data, size);
+  }
+  len += 4 + size;
+  while (len & 3) body[len++] = 0;
+  return len;
+}
+
+bx_capture_pktmover_c::bx_capture_pktmover_c(eth_pktmover_c *ethmod, bx_list_c *base,
+                                             eth_rx_handler_t rxh, eth_rx_status_t rxstat,
+                                             bx_devmodel_c *dev)
+{
+  Bit8u body[128];
+  unsigned len;
+  Bit32u val32;
+  Bit16u val16;
+  const char *path = SIM->get_param_string("capture", base)->getptr();
+
+  this->ethmod = ethmod;
+  this->netdev = dev;
+  this->rxh = rxh;
+  this->rxstat = rxstat;
+  snaplen = SIM->get_param_num("snaplen", base)->get();
+  sampling = SIM->get_param_num("sampling", base)->get();
+  sample_count = 0;
+  frames_seen = 0;
+  frames_dropped = 0;
+  head = 0;
+  tail = 0;
+  stop = 0;
+  thread_started = 0;
+  ring = NULL;
+  ring_data = NULL;
+  // the frames are passed through this object
+  next = captures;
+  captures = this;
+  ethmod->set_rx_handler(rx_handler);
+
+  fp = fopen(path, "wb");
+  if (fp == NULL) {
+    BX_PANIC(("could not open capture file '%s'", path));
+    return;
+  }
+  setvbuf(fp, NULL, _IOFBF, 0x10000);
+  // the timestamps are the emulated time, counted from the host time of
+  // the capture start
+  start_time = (Bit64u)time(NULL) * 1000000;
+  // section header block
+  val32 = PCAPNG_BYTE_ORDER;
+  memcpy(body, &val32, 4);
+  val16 = 1;
+  memcpy(body + 4, &val16, 2);
+  val16 = 0;
+  memcpy(body + 6, &val16, 2);
+  memset(body + 8, 0xff, 8); // section length not specified
+  len = pcapng_option(body, 16, PCAPNG_SHB_USERAPPL, "Bochs " VER_STRING, strlen("Bochs " VER_STRING));
+  len = pcapng_option(body, len, PCAPNG_OPT_END, NULL, 0);
+  write_block(PCAPNG_SHB, body, len);
+  // interface description block
+  val16 = PCAPNG_LINKTYPE_ETHERNET;
+  memcpy(body, &val16, 2);
+  val16 = 0;
+  memcpy(body + 2, &val16, 2);
+  val32 = snaplen;
+  memcpy(body + 4, &val32, 4);
+  len = pcapng_option(body, 8, PCAPNG_IF_NAME, base->get_name(), strlen(base->get_name()));
+  len = pcapng_option(body, len, PCAPNG_OPT_END, NULL, 0);
+  write_block(PCAPNG_IDB, body, len);
+
+  ring = new bx_netcap_frame_t[BX_NETMOD_CAPTURE_RING];
+  ring_data = new Bit8u[BX_NETMOD_CAPTURE_RING * snaplen];
+  thread_started = BX_THREAD_CREATE(writer_thread, this, tid);
+  if (!thread_started) {
+    BX_PANIC(("could not create packet capture thread"));
+  }
+  BX_INFO(("capturing frames to '%s' (snaplen=%d, sampling=1/%d)", path, snaplen, sampling));
+}
+
+bx_capture_pktmover_c::~bx_capture_pktmover_c()
+{
+  Bit8u body[64];
+  Bit64u ts;
+  Bit32u val32;
+  unsigned len;
+
+  // stop the pktmover first: no more frames are received
+  delete ethmod;
+  if (thread_started) {
+    stop = 1;
+    BX_THREAD_JOIN(tid);
+  }
+  if (fp != NULL) {
+    write_frames();
+    // interface statistics block with the frame counters
+    ts = start_time + bx_pc_system.time_usec();
+    val32 = 0;
+    memcpy(body, &val32, 4);
+    val32 = (Bit32u)(ts >> 32);
+    memcpy(body + 4, &val32, 4);
+    val32 = (Bit32u)ts;
+    memcpy(body + 8, &val32, 4);
+    len = pcapng_option(body, 12, PCAPNG_ISB_IFRECV, &frames_seen, 8);
+    len = pcapng_option(body, len, PCAPNG_ISB_IFDROP, &frames_dropped, 8);
+    len = pcapng_option(body, len, PCAPNG_OPT_END, NULL, 0);
+    write_block(PCAPNG_ISB, body, len);
+    fclose(fp);
+    BX_INFO(("packet capture: " FMT_LL "u frames, " FMT_LL "u dropped",
+             frames_seen, frames_dropped));
+  }
+  if (ring != NULL) {
+    delete [] ring;
+    delete [] ring_data;
+  }
+  bx_capture_pktmover_c **p = &captures;
+  while (*p != NULL) {
+    if (*p == this) {
+      *p = next;
+      break;
+    }
+    p = &(*p)->next;
+  }
+}
+
+// returns the ring buffer for the next captured frame or NULL if the frame
+// is skipped (sampling) or the ring is full
+Bit8u *bx_capture_pktmover_c::capture_slot(unsigned len, bx_bool inbound)
+{
+  bx_netcap_frame_t *frame;
+
+  if (ring == NULL) return NULL;
+  frames_seen++;
+  if (++sample_count < sampling) return NULL;
+  sample_count = 0;
+  if ((head - tail) >= BX_NETMOD_CAPTURE_RING) {
+    frames_dropped++;
+    return NULL;
+  }
+  frame = &ring[head % BX_NETMOD_CAPTURE_RING];
+  frame->timestamp = bx_pc_system.time_usec();
+  frame->len = len;
+  frame->caplen = (len < snaplen) ? len : snaplen;
+  frame->inbound = inbound;
+  return ring_data + (head % BX_NETMOD_CAPTURE_RING) * snaplen;
+}
+
+void bx_capture_pktmover_c::capture(const void *buf, unsigned len, bx_bool inbound)
+{
+  Bit8u *data = capture_slot(len, inbound);
+
+  if (data != NULL) {
+    memcpy(data, buf, ring[head % BX_NETMOD_CAPTURE_RING].caplen);
+    BX_MEMORY_BARRIER();
+    head++;
+  }
+}
+
+void bx_capture_pktmover_c::sendpkt(void *buf, unsigned io_len)
+{
+  capture(buf, io_len, 0);
+  ethmod->sendpkt(buf, io_len);
+}
+
+unsigned bx_capture_pktmover_c::sendpkts(const eth_packet_t *pkts, unsigned count)
+{
+  unsigned i, j, len, caplen, n;
+  Bit8u *data;
+
+  for (i = 0; i < count; i++) {
+    len = 0;
+    for (j = 0; j < pkts[i].iovcnt; j++) {
+      len += pkts[i].iov[j].len;
+    }
+    data = capture_slot(len, 0);
+    if (data == NULL) continue;
+    // gather the fragments up to the snapshot length
+    caplen = ring[head % BX_NETMOD_CAPTURE_RING].caplen;
+    for (j = 0; (j < pkts[i].iovcnt) && (caplen > 0); j++) {
+      n = (pkts[i].iov[j].len < caplen) ? pkts[i].iov[j].len : caplen;
+      memcpy(data, pkts[i].iov[j].base, n);
+      data += n;
+      caplen -= n;
+    }
+    BX_MEMORY_BARRIER();
+    head++;
+  }
+  return ethmod->sendpkts(pkts, count);
+}
+
+void bx_capture_pktmover_c::set_rx_batch_handler(eth_rx_batch_handler_t rxh_batch)
+{
+  this->rxh_batch = rxh_batch;
+  ethmod->set_rx_batch_handler((rxh_batch != NULL) ? rx_batch_handler : NULL);
+}
+
+// the pktmover passes the device pointer to the receive callbacks
+bx_capture_pktmover_c *bx_capture_pktmover_c::lookup(void *netdev)
+{
+  bx_capture_pktmover_c *p;
+
+  for (p = captures; p != NULL; p = p->next) {
+    if (p->netdev == netdev) break;
+  }
+  return p;
+}
+
+void bx_capture_pktmover_c::rx_handler(void *arg, const void *buf, unsigned len)
+{
+  bx_capture_pktmover_c *p = lookup(arg);
+
+  p->capture(buf, len, 1);
+  p->rxh(arg, buf, len);
+}
+
+unsigned bx_capture_pktmover_c::rx_batch_handler(void *arg, const eth_rx_frame_t *frames, unsigned count)
+{
+  bx_capture_pktmover_c *p = lookup(arg);
+  unsigned n = p->rxh_batch(arg, frames, count);
+
+  // only the frames accepted by the device have been received
+  for (unsigned i = 0; i < n; i++) {
+    p->capture(frames[i].buf, frames[i].len, 1);
+  }
+  return n;
+}
+
+BX_THREAD_FUNC(bx_capture_pktmover_c::writer_thread, indata)
+{
+  ((bx_capture_pktmover_c *) indata)->writer_loop();
+  BX_THREAD_EXIT;
+}
+
+void bx_capture_pktmover_c::writer_loop()
+{
+  while (!stop) {
+    if (head != tail) {
+      write_frames();
+      fflush(fp);
+    } else {
+      BX_MSLEEP(10);
+    }
+  }
+}
+
+// stores the queued frames as enhanced packet blocks
+void bx_capture_pktmover_c::write_frames()
+{
+  bx_netcap_frame_t *frame;
+  Bit8u hdr[28], opt[12];
+  Bit32u val32, total;
+  Bit64u ts;
+  unsigned optlen, pad;
+  static const Bit8u zero[4] = {0, 0, 0, 0};
+
+  while (tail != head) {
+    BX_MEMORY_BARRIER();
+    frame = &ring[tail % BX_NETMOD_CAPTURE_RING];
+    ts = start_time + frame->timestamp;
+    pad = (4 - (frame->caplen & 3)) & 3;
+    val32 = frame->inbound ? PCAPNG_EPB_INBOUND : PCAPNG_EPB_OUTBOUND;
+    optlen = pcapng_option(opt, 0, PCAPNG_EPB_FLAGS, &val32, 4);
+    optlen = pcapng_option(opt, optlen, PCAPNG_OPT_END, NULL, 0);
+    total = 32 + frame->caplen + pad + optlen;
+    val32 = PCAPNG_EPB;
+    memcpy(hdr, &val32, 4);
+    memcpy(hdr + 4, &total, 4);
+    val32 = 0; // interface id
+    memcpy(hdr + 8, &val32, 4);
+    val32 = (Bit32u)(ts >> 32);
+    memcpy(hdr + 12, &val32, 4);
+    val32 = (Bit32u)ts;
+    memcpy(hdr + 16, &val32, 4);
+    memcpy(hdr + 20, &frame->caplen, 4);
+    memcpy(hdr + 24, &frame->len, 4);
+    fwrite(hdr, 1, 28, fp);
+    fwrite(ring_data + (tail % BX_NETMOD_CAPTURE_RING) * snaplen, 1, frame->caplen, fp);
+    fwrite(zero, 1, pad, fp);
+    fwrite(opt, 1, optlen, fp);
+    fwrite(&total, 1, 4, fp);
+    BX_MEMORY_BARRIER();
+    tail++;
+  }
+}
+
+void bx_capture_pktmover_c::write_block(Bit32u type, const Bit8u *body, unsigned len)
+{
+  Bit32u total = len + 12;
+
+  fwrite(&type, 1, 4, fp);
+  fwrite(&total, 1, 4, fp);
+  fwrite(body, 1, len, fp);
+  fwrite(&total, 1, 4, fp);
+}
+
+#if BX_NETMOD_RX_THREAD
+
+extern "C" {
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+};
+
+#define BX_NETIO_MAX_EVENTS 16
+
+//
+// The network I/O thread sleeps until one of the host fds of the active
+// pktmovers becomes readable and moves the frames into their receive rings.
+// A single timer on the emulation thread only checks a flag and passes the
+// queued frames to the devices, so an idle network costs no syscalls.
+//
+class bx_netio_thread_c {
+public:
+  bx_netio_thread_c(bx_devmodel_c *netdev);
+  ~bx_netio_thread_c();
+  void add(eth_pktmover_c *mover);
+  bx_bool remove(eth_pktmover_c *mover);
+  void watch(eth_pktmover_c *mover, bx_bool enable);
+  bx_bool empty() {return movers == NULL;}
+private:
+  static BX_THREAD_FUNC(io_thread, indata);
+  void io_loop();
+  static void rx_timer_handler(void *this_ptr);
+  void rx_timer();
+  void rx_report_stats();
+  void wakeup();
+  bx_bool is_active(eth_pktmover_c *mover);
+
+  eth_pktmover_c *movers;
+  BX_MUTEX(lock);
+  BX_THREAD_ID(tid);
+  volatile bx_bool stop;
+  volatile bx_bool rx_pending;
+  volatile bx_bool rx_report;
+  int wake_fds[2];
+#ifdef __linux__
+  int epoll_fd;
+#endif
+  int rx_timer_index;
+};
+
+static bx_netio_thread_c *netio = NULL;
+
+bx_netio_thread_c::bx_netio_thread_c(bx_devmodel_c *netdev)
+{
+  movers = NULL;
+  stop = 0;
+  rx_pending = 0;
+  rx_report = 0;
+  BX_INIT_MUTEX(lock);
+  if (pipe(wake_fds) < 0) {
+    BX_PANIC(("network I/O thread: cannot create pipe: %s", strerror(errno)));
+  }
+  fcntl(wake_fds[0], F_SETFL, fcntl(wake_fds[0], F_GETFL) | O_NONBLOCK);
+#ifdef __linux__
+  epoll_fd = epoll_create(BX_NETIO_MAX_EVENTS);
+  if (epoll_fd < 0) {
+    BX_PANIC(("network I/O thread: epoll_create failed: %s", strerror(errno)));
+  }
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.ptr = NULL;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fds[0], &ev);
+#endif
+  if (!BX_THREAD_CREATE(io_thread, this, tid)) {
+    BX_PANIC(("network I/O thread: cannot create thread"));
+  }
+  rx_timer_index =
+    bx_pc_system.register_timer(this, rx_timer_handler, BX_NETMOD_RX_POLL,
+                                1, 1, "netio"); // continuous, active
+}
+
+bx_netio_thread_c::~bx_netio_thread_c()
+{
+  stop = 1;
+  wakeup();
+  BX_THREAD_JOIN(tid);
+  bx_pc_system.deactivate_timer(rx_timer_index);
+  bx_pc_system.unregisterTimer(rx_timer_index);
+#ifdef __linux__
+  close(epoll_fd);
+#endif
+  close(wake_fds[0]);
+  close(wake_fds[1]);
+  BX_FINI_MUTEX(lock);
+}
+
+void bx_netio_thread_c::add(eth_pktmover_c *mover)
+{
+  bx_devmodel_c *netdev = mover->netdev;
+
+  BX_LOCK(lock);
+  mover->rx_next = movers;
+  movers = mover;
+#ifdef __linux__
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.ptr = mover;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, mover->rx_fd, &ev) < 0) {
+    BX_PANIC(("network I/O thread: cannot watch fd %d: %s", mover->rx_fd, strerror(errno)));
+  }
+#endif
+  BX_UNLOCK(lock);
+  wakeup();
+}
+
+// stop watching the fd of a pktmover while its ring is full
+void bx_netio_thread_c::watch(eth_pktmover_c *mover, bx_bool enable)
+{
+#ifdef __linux__
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = enable ? EPOLLIN : 0;
+  ev.data.ptr = mover;
+  epoll_ctl(epoll_fd, EPOLL_CTL_MOD, mover->rx_fd, &ev);
+#else
+  if (enable) wakeup();
+#endif
+}
+
+bx_bool bx_netio_thread_c::remove(eth_pktmover_c *mover)
+{
+  eth_pktmover_c **ptr;
+  bx_bool found = 0;
+
+  BX_LOCK(lock);
+  for (ptr = &movers; *ptr != NULL; ptr = &(*ptr)->rx_next) {
+    if (*ptr == mover) {
+      *ptr = mover->rx_next;
+      found = 1;
+      break;
+    }
+  }
+#ifdef __linux__
+  if (found) {
+    struct epoll_event ev;
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, mover->rx_fd, &ev);
+  }
+#endif
+  BX_UNLOCK(lock);
+  wakeup();
+  return found;
+}
+
+bx_bool bx_netio_thread_c::is_active(eth_pktmover_c *mover)
+{
+  for (eth_pktmover_c *m = movers; m != NULL; m = m->rx_next) {
+    if (m == mover) return 1;
+  }
+  return 0;
+}
+
+void bx_netio_thread_c::wakeup()
+{
+  char c = 0;
+
+  if (write(wake_fds[1], &c, 1) < 0) {
+    // pipe full: the thread is woken up anyway
+  }
+}
+
+BX_THREAD_FUNC(bx_netio_thread_c::io_thread, indata)
+{
+  ((bx_netio_thread_c*)indata)->io_loop();
+  BX_THREAD_EXIT;
+}
+
+void bx_netio_thread_c::io_loop()
+{
+  eth_pktmover_c *ready[BX_NETIO_MAX_EVENTS];
+  char dummy[64];
+  int i, n, count;
+  bx_bool report;
+
+  while (!stop) {
+#ifdef __linux__
+    struct epoll_event events[BX_NETIO_MAX_EVENTS];
+    n = epoll_wait(epoll_fd, events, BX_NETIO_MAX_EVENTS, -1);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    for (i = 0; i < n; i++) {
+      ready[i] = (eth_pktmover_c*)events[i].data.ptr;
+    }
+#else
+    struct pollfd fds[BX_NETIO_MAX_EVENTS + 1];
+    eth_pktmover_c *polled[BX_NETIO_MAX_EVENTS + 1];
+    int nfds = 1;
+    fds[0].fd = wake_fds[0];
+    fds[0].events = POLLIN;
+    polled[0] = NULL;
+    BX_LOCK(lock);
+    for (eth_pktmover_c *m = movers; (m != NULL) && (nfds <= BX_NETIO_MAX_EVENTS); m = m->rx_next) {
+      if (m->rx_full) continue;
+      fds[nfds].fd = m->rx_fd;
+      fds[nfds].events = POLLIN;
+      polled[nfds++] = m;
+    }
+    BX_UNLOCK(lock);
+    if (poll(fds, nfds, -1) < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    n = 0;
+    for (i = 0; (i < nfds) && (n < BX_NETIO_MAX_EVENTS); i++) {
+      if (fds[i].revents != 0) ready[n++] = polled[i];
+    }
+#endif
+    count = 0;
+    report = 0;
+    BX_LOCK(lock);
+    for (i = 0; i < n; i++) {
+      if (ready[i] == NULL) {
+        while (read(wake_fds[0], dummy, sizeof(dummy)) > 0);
+      } else if (is_active(ready[i])) {
+        count += ready[i]->rx_thread_read();
+        eth_rx_stats_t *stats = &ready[i]->rx_stats;
+        report |= ((stats->errors | stats->short_frames | stats->log_errors) != 0);
+      }
+    }
+    BX_UNLOCK(lock);
+    if (report) {
+      rx_report = 1;
+    }
+    if (count > 0) {
+      rx_pending = 1;
+    }
+  }
+}
+
+void bx_netio_thread_c::rx_timer_handler(void *this_ptr)
+{
+  ((bx_netio_thread_c*)this_ptr)->rx_timer();
+}
+
+void bx_netio_thread_c::rx_timer()
+{
+  if (rx_report) {
+    rx_report = 0;
+    rx_report_stats();
+  }
+  if (!rx_pending) return;
+  rx_pending = 0;
+  BX_MEMORY_BARRIER();
+  // the list is only modified by the emulation thread
+  for (eth_pktmover_c *m = movers; m != NULL; m = m->rx_next) {
+    if (m->rx_thread_deliver()) {
+      // device not ready: retry on the next timer tick
+      rx_pending = 1;
+    }
+  }
+}
+
+// log the receive problems counted by the I/O thread since the last call
+void bx_netio_thread_c::rx_report_stats()
+{
+  eth_rx_stats_t stats;
+
+  for (eth_pktmover_c *m = movers; m != NULL; m = m->rx_next) {
+    BX_LOCK(lock);
+    stats = m->rx_stats;
+    memset(&m->rx_stats, 0, sizeof(m->rx_stats));
+    BX_UNLOCK(lock);
+    m->rx_thread_report(&stats);
+  }
+}
+
+void eth_pktmover_c::rx_thread_start(int fd)
+{
+  rx_fd = fd;
+  rx_ring = new eth_rx_frame_t[BX_NETMOD_RX_RING];
+  rx_head = 0;
+  rx_tail = 0;
+  rx_full = 0;
+  memset(&rx_stats, 0, sizeof(rx_stats));
+  if (netio == NULL) {
+    netio = new bx_netio_thread_c(netdev);
+  }
+  netio->add(this);
+}
+
+void eth_pktmover_c::rx_thread_stop()
+{
+  if (rx_ring == NULL) return;
+  if (netio != NULL) {
+    netio->remove(this);
+    if (netio->empty()) {
+      delete netio;
+      netio = NULL;
+    }
+  }
+  delete [] rx_ring;
+  rx_ring = NULL;
+}
+
+int eth_pktmover_c::rx_frames(eth_rx_frame_t *frames, unsigned count)
+{
+  unsigned n = 0;
+  int len;
+
+  while (n < count) {
+    len = rx_frame(frames[n].buf, BX_PACKET_BUFSIZE);
+    if (len < 0) break;
+    if (len > 0) {
+      frames[n++].len = len;
+    }
+  }
+  return (n > 0) ? (int)n : -1;
+}
+
+// I/O thread: move the pending frames from the host fd into the ring and
+// return the number of frames (or 1 if the ring needs to be drained)
+int eth_pktmover_c::rx_thread_read()
+{
+  unsigned head, space;
+  int n, count = 0;
+
+  while (1) {
+    head = rx_head;
+    space = BX_NETMOD_RX_RING - (head - rx_tail);
+    if (space == 0) {
+      // leave the frames in the host queue until the ring is drained
+      netio->watch(this, 0);
+      BX_MEMORY_BARRIER();
+      rx_full = 1;
+      return 1;
+    }
+    // contiguous free slots up to the end of the ring
+    if (space > (BX_NETMOD_RX_RING - (head % BX_NETMOD_RX_RING)))
+      space = BX_NETMOD_RX_RING - (head % BX_NETMOD_RX_RING);
+    n = rx_frames(&rx_ring[head % BX_NETMOD_RX_RING], space);
+    if (n < 0) break;
+    BX_MEMORY_BARRIER();
+    rx_head = head + n;
+    count += n;
+  }
+  return count;
+}
+
+// emulation thread: log the receive problems of the module
+void eth_pktmover_c::rx_thread_report(const eth_rx_stats_t *stats)
+{
+  if (stats->errors > 0) {
+    BX_ERROR(("host read error: %s (%u times)", strerror(stats->last_errno), stats->errors));
+  }
+  if (stats->short_frames > 0) {
+    BX_INFO(("%u packet(s) too short, padded to 60 bytes", stats->short_frames));
+  }
+  if (stats->log_errors > 0) {
+    BX_ERROR(("fwrite to rxlog failed (%u times)", stats->log_errors));
+  }
+}
+
+// emulation thread: pass the queued frames to the device and return 1 if
+// frames are left in the ring because the device is not ready
+bx_bool eth_pktmover_c::rx_thread_deliver()
+{
+  unsigned tail = rx_tail, count, n;
+
+  if (rxh_batch != NULL) {
+    while ((count = rx_head - tail) > 0) {
+      BX_MEMORY_BARRIER();
+      if (count > (BX_NETMOD_RX_RING - (tail % BX_NETMOD_RX_RING)))
+        count = BX_NETMOD_RX_RING - (tail % BX_NETMOD_RX_RING);
+      n = this->rxh_batch(this->netdev, &rx_ring[tail % BX_NETMOD_RX_RING], count);
+      BX_MEMORY_BARRIER();
+      tail += n;
+      rx_tail = tail;
+      if (n < count) break;
+    }
+  }
+  while ((rxh_batch == NULL) && (tail != rx_head)) {
+    BX_MEMORY_BARRIER();
+    eth_rx_frame_t *frame = &rx_ring[tail % BX_NETMOD_RX_RING];
+    if (!(this->rxstat(this->netdev) & BX_NETDEV_RXREADY)) {
+      // keep the frame queued, the ring fills up and applies backpressure
+      break;
+    }
+    this->rxh(this->netdev, frame->buf, frame->len);
+    BX_MEMORY_BARRIER();
+    rx_tail = ++tail;
+  }
+  if (rx_full && ((rx_head - tail) < BX_NETMOD_RX_RING)) {
+    rx_full = 0;
+    netio->watch(this, 1);
+  }
+  return (tail != rx_head);
+}
+
+#endif
+
 #if (BX_NETMOD_TAP==1) || (BX_NETMOD_TUNTAP==1) || (BX_NETMOD_VDE==1)
 
 extern "C" {
@@ -37,6 +37,18 @@ public:
 
 #define BX_PACKET_BUFSIZE 2048 // Enough for an ether frame
 
+// The fd based host modules receive frames in a shared network I/O thread
+#if BX_NETMOD_LINUX || BX_NETMOD_TAP || BX_NETMOD_TUNTAP || BX_NETMOD_VDE
+#define BX_NETMOD_RX_THREAD 1
+#else
+#define BX_NETMOD_RX_THREAD 0
+#endif
+
+#define BX_NETMOD_RX_RING 64   // frames buffered per pktmover
+#define BX_NETMOD_RX_POLL 100  // usecs between checks for received frames
+
+#define BX_NETMOD_CAPTURE_RING 256 // frames buffered for the capture file writer
+
 // device receive status definitions
 #define BX_NETDEV_RXREADY  0x0001
 #define BX_NETDEV_SPEED    0x000e
@@ -121,6 +133,55 @@ udp_header_t;
 typedef void (*eth_rx_handler_t)(void *arg, const void *buf, unsigned len);
 typedef Bit32u (*eth_rx_status_t)(void *arg);
 
+typedef struct {
+  unsigned len;
+  Bit8u buf[BX_PACKET_BUFSIZE];
+} eth_rx_frame_t;
+
+// receive problems counted by the network I/O thread
+typedef struct {
+  Bit32u errors;       // failed reads from the host fd
+  int    last_errno;
+  Bit32u short_frames; // frames padded to the minimum length
+  Bit32u log_errors;   // failed writes to the receive packet log
+} eth_rx_stats_t;
+
+// returns the number of frames accepted, the rest is passed again later
+typedef unsigned (*eth_rx_batch_handler_t)(void *arg, const eth_rx_frame_t *frames, unsigned count);
+
+// offload features of a pktmover (see offload_caps())
+#define BX_NETDEV_OFFLOAD_CSUM 0x0001 // checksum from csum_start to the end
+#define BX_NETDEV_OFFLOAD_TSO4 0x0002 // TCP segmentation for IPv4
+#define BX_NETDEV_OFFLOAD_TSO6 0x0004 // TCP segmentation for IPv6
+
+#define BX_NETDEV_OFFLOAD_NEEDS_CSUM 0x01 // eth_offload_t flags
+
+#define BX_NETDEV_GSO_NONE  0 // eth_offload_t gso_type
+#define BX_NETDEV_GSO_TCPV4 1
+#define BX_NETDEV_GSO_TCPV6 4
+
+// offload request for a transmitted frame (same layout as virtio_net_hdr)
+typedef struct {
+  Bit8u  flags;
+  Bit8u  gso_type;
+  Bit16u hdr_len;     // length of the headers for each segment
+  Bit16u gso_size;    // payload bytes per segment (MSS)
+  Bit16u csum_start;  // checksum is calculated from here to the end
+  Bit16u csum_offset; // and stored at csum_start + csum_offset
+} eth_offload_t;
+
+#define BX_PACKET_MAX_IOV 4
+
+// one frame of a transmit batch, scattered over up to BX_PACKET_MAX_IOV buffers
+typedef struct {
+  unsigned iovcnt;
+  struct {
+    const void *base;
+    unsigned len;
+  } iov[BX_PACKET_MAX_IOV];
+  eth_offload_t offload;
+} eth_packet_t;
+
 typedef struct {
   Bit8u host_macaddr[6];
   Bit8u guest_macaddr[6];
@@ -179,12 +240,60 @@ int process_tftp(bx_devmodel_c *netdev, const Bit8u *data, unsigned data_len, Bi
 //
 class eth_pktmover_c {
 public:
+  eth_pktmover_c();
   virtual void sendpkt(void *buf, unsigned io_len) = 0;
+  // Send a batch of frames. Modules that can write several frames or
+  // scattered frames with one syscall override this. Offload requests
+  // are only passed to modules that report them in offload_caps().
+  // Returns the number of frames that could not be sent.
+  virtual unsigned sendpkts(const eth_packet_t *pkts, unsigned count);
+  virtual Bit32u offload_caps() {return 0;}
+  // Modules with a sendpkts() that only writes to the host file descriptor
+  // and doesn't log return 1 here: it may be called from a transmit thread
+  // of the device (the device serializes the calls and reports the errors).
+  virtual bx_bool tx_thread_safe() {return 0;}
+  // Modules that write several frames with one syscall return 1 here. Only
+  // then it's worth collecting frames for sendpkts() in the device.
+  virtual bx_bool tx_batching() {return 0;}
   virtual ~eth_pktmover_c () {}
+  // Optional receive callback that accepts several frames at once. It stops
+  // at the first frame the device cannot accept, the remaining frames are
+  // passed again later. Modules without batch support keep calling the
+  // single frame callback.
+  virtual void set_rx_batch_handler(eth_rx_batch_handler_t rxh_batch) {this->rxh_batch = rxh_batch;}
+  // used by the packet capture to pass the received frames through
+  void set_rx_handler(eth_rx_handler_t rxh) {this->rxh = rxh;}
 protected:
   bx_devmodel_c *netdev;
   eth_rx_handler_t  rxh;   // receive callback
   eth_rx_status_t  rxstat; // receive status callback
+  eth_rx_batch_handler_t rxh_batch; // batch receive callback
+#if BX_NETMOD_RX_THREAD
+  // The module's host fd is watched by the network I/O thread. It calls
+  // rx_frames() until it returns < 0 or the ring is full and queues the
+  // frames into a ring that is drained on the emulation thread. rx_frame()
+  // returns the frame length or 0 to skip a frame. rx_thread_stop() must be
+  // called by the destructor of the module. rx_frame() must not log: it
+  // counts its problems in rx_stats, which are logged by the emulation thread.
+  void rx_thread_start(int fd);
+  void rx_thread_stop();
+  virtual int rx_frame(Bit8u *buf, unsigned size) {return -1;}
+  // Read up to count frames. Returns the number of frames stored or -1 if
+  // no frame is pending. The default calls rx_frame() for each frame.
+  virtual int rx_frames(eth_rx_frame_t *frames, unsigned count);
+  eth_rx_stats_t rx_stats; // protected by the lock of the I/O thread
+private:
+  int rx_thread_read();
+  bx_bool rx_thread_deliver();
+  void rx_thread_report(const eth_rx_stats_t *stats);
+
+  int rx_fd;
+  eth_rx_frame_t *rx_ring;
+  volatile unsigned rx_head, rx_tail;
+  volatile bx_bool rx_full;
+  eth_pktmover_c *rx_next;
+  friend class bx_netio_thread_c;
+#endif
 };
 
 
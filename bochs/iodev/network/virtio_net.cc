@@ -0,0 +1,980 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+/////////////////////////////////////////////////////////////////////////
+
+// Virtio network adapter (paravirtual NIC supported by Linux, the BSDs and
+// the virtio-win drivers). Frames are passed to the pktmover in batches and
+// checksum / segmentation offload requests are forwarded if the selected
+// ethernet module supports them. With several queue pairs the receive queue
+// is selected by a Toeplitz hash of the flow (receive side scaling), and if
+// the ethernet module allows it, every transmit queue is drained by its own
+// host thread.
+
+// Define BX_PLUGGABLE in files that can be compiled into plugins.  For
+// platforms that require a special tag on exported symbols, BX_PLUGGABLE
+// is used to know when we are exporting symbols and when we are importing.
+#define BX_PLUGGABLE
+
+#include "iodev.h"
+#if BX_SUPPORT_PCI && BX_SUPPORT_VIRTIO_NET
+
+#include "pci.h"
+#include "virtio.h"
+#include "netmod.h"
+#include "virtio_net.h"
+
+#define LOG_THIS theVirtioNetDevice->
+
+bx_virtio_net_c* theVirtioNetDevice = NULL;
+
+// feature bits
+#define VIRTIO_NET_F_CSUM       0
+#define VIRTIO_NET_F_GUEST_CSUM 1
+#define VIRTIO_NET_F_MAC        5
+#define VIRTIO_NET_F_HOST_TSO4  11
+#define VIRTIO_NET_F_HOST_TSO6  12
+#define VIRTIO_NET_F_MRG_RXBUF  15
+#define VIRTIO_NET_F_STATUS     16
+#define VIRTIO_NET_F_CTRL_VQ    17
+#define VIRTIO_NET_F_MQ         22
+#define VIRTIO_NET_F_RSS        60
+
+#define VIRTIO_NET_S_LINK_UP    1
+
+#define VIRTIO_NET_HDR_F_NEEDS_CSUM 1
+#define VIRTIO_NET_HDR_GSO_ECN      0x80
+
+// control queue commands
+#define VIRTIO_NET_OK                   0
+#define VIRTIO_NET_ERR                  1
+#define VIRTIO_NET_CTRL_MQ              4
+#define VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET 0
+#define VIRTIO_NET_CTRL_MQ_RSS_CONFIG   1
+
+// RSS hash types
+#define VIRTIO_NET_RSS_HASH_TYPE_IPv4   0x01
+#define VIRTIO_NET_RSS_HASH_TYPE_TCPv4  0x02
+#define VIRTIO_NET_RSS_HASH_TYPE_UDPv4  0x04
+#define VIRTIO_NET_RSS_HASH_TYPE_IPv6   0x08
+#define VIRTIO_NET_RSS_HASH_TYPE_TCPv6  0x10
+#define VIRTIO_NET_RSS_HASH_TYPE_UDPv6  0x20
+#define VIRTIO_NET_RSS_HASH_TYPES       0x3f
+
+// Toeplitz key used until the driver sets its own one
+static const Bit8u rss_default_key[BX_VIRTIO_NET_RSS_KEY_LEN] = {
+  0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+  0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+  0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+  0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+  0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa
+};
+
+static Bit32u toeplitz_hash(const Bit8u *key, const Bit8u *data, unsigned len)
+{
+  Bit32u hash = 0, v = get_net4(key);
+  unsigned i, b;
+
+  for (i = 0; i < len; i++) {
+    for (b = 0; b < 8; b++) {
+      if (data[i] & (0x80 >> b)) {
+        hash ^= v;
+      }
+      v <<= 1;
+      if (((i + 4) < BX_VIRTIO_NET_RSS_KEY_LEN) && (key[i + 4] & (0x80 >> b))) {
+        v |= 1;
+      }
+    }
+  }
+  return hash;
+}
+
+// builtin configuration handling functions
+
+void virtio_net_init_options(void)
+{
+  bx_param_c *network = SIM->get_param("network");
+  bx_list_c *menu = new bx_list_c(network, "virtio_net", "Virtio network adapter");
+  menu->set_options(menu->SHOW_PARENT);
+  bx_param_bool_c *enabled = new bx_param_bool_c(menu,
+    "enabled",
+    "Enable virtio network adapter emulation",
+    "Enables the paravirtual virtio network adapter emulation",
+    0);
+  new bx_param_num_c(menu,
+    "queues",
+    "Queue pairs",
+    "Number of receive / transmit queue pairs",
+    1, BX_VIRTIO_NET_MAX_PAIRS,
+    1);
+  SIM->init_std_nic_options("Virtio network adapter", menu);
+  enabled->set_dependent_list(menu->clone());
+}
+
+Bit32s virtio_net_options_parser(const char *context, int num_params, char *params[])
+{
+  int ret, valid = 0;
+
+  if (!strcmp(params[0], "virtio_net")) {
+    bx_list_c *base = (bx_list_c*) SIM->get_param(BXPN_VIRTIO_NET);
+    if (!SIM->get_param_bool("enabled", base)->get()) {
+      SIM->get_param_enum("ethmod", base)->set_by_name("null");
+    }
+    for (int i = 1; i < num_params; i++) {
+      ret = SIM->parse_nic_params(context, params[i], base);
+      if (ret > 0) {
+        valid |= ret;
+      }
+    }
+    if (!SIM->get_param_bool("enabled", base)->get()) {
+      if (valid == 0x04) {
+        SIM->get_param_bool("enabled", base)->set(1);
+      }
+    }
+    if (valid < 0x80) {
+      if ((valid & 0x04) == 0) {
+        BX_PANIC(("%s: 'virtio_net' directive incomplete (mac is required)", context));
+      }
+    }
+  } else {
+    BX_PANIC(("%s: unknown directive '%s'", context, params[0]));
+  }
+  return 0;
+}
+
+Bit32s virtio_net_options_save(FILE *fp)
+{
+  return SIM->write_param_list(fp, (bx_list_c*) SIM->get_param(BXPN_VIRTIO_NET), NULL, 0);
+}
+
+// device plugin entry points
+
+int libvirtio_net_LTX_plugin_init(plugin_t *plugin, plugintype_t type, int argc, char *argv[])
+{
+  theVirtioNetDevice = new bx_virtio_net_c();
+  BX_REGISTER_DEVICE_DEVMODEL(plugin, type, theVirtioNetDevice, BX_PLUGIN_VIRTIO_NET);
+  // add new configuration parameter for the config interface
+  virtio_net_init_options();
+  // register add-on option for bochsrc and command line
+  SIM->register_addon_option("virtio_net", virtio_net_options_parser, virtio_net_options_save);
+  return 0; // Success
+}
+
+void libvirtio_net_LTX_plugin_fini(void)
+{
+  SIM->unregister_addon_option("virtio_net");
+  bx_list_c *menu = (bx_list_c*)SIM->get_param("network");
+  menu->remove("virtio_net");
+  delete theVirtioNetDevice;
+}
+
+// the device object
+
+bx_virtio_net_c::bx_virtio_net_c()
+{
+  put("VNET");
+  ethdev = NULL;
+  memset(macaddr, 0, sizeof(macaddr));
+  memset(config, 0, sizeof(config));
+  host_features = 0;
+  tx_offload = 0;
+  max_pairs = 1;
+  cur_pairs = 1;
+  statusbar_id = -1;
+  memset(&tx_batch, 0, sizeof(tx_batch));
+  memset(&rss, 0, sizeof(rss));
+  tx_threads = 0;
+  tx_thread_data = NULL;
+  tx_timer_index = BX_NULL_TIMER_HANDLE;
+}
+
+bx_virtio_net_c::~bx_virtio_net_c()
+{
+  if (tx_thread_data != NULL) {
+    for (unsigned i = 0; i < max_pairs; i++) {
+      tx_thread_stop(i);
+    }
+    delete [] tx_thread_data;
+    BX_FINI_MUTEX(tx_lock);
+  }
+  if (tx_batch.buf != NULL) {
+    delete [] tx_batch.buf;
+  }
+  if (tx_batch.big != NULL) {
+    delete [] tx_batch.big;
+  }
+  if (ethdev != NULL) {
+    delete ethdev;
+  }
+  SIM->get_bochs_root()->remove("virtio_net");
+  BX_DEBUG(("Exit"));
+}
+
+void bx_virtio_net_c::init(void)
+{
+  const char *bootrom;
+
+  // Read in values from config interface
+  bx_list_c *base = (bx_list_c*) SIM->get_param(BXPN_VIRTIO_NET);
+  // Check if the device is disabled or not configured
+  if (!SIM->get_param_bool("enabled", base)->get()) {
+    BX_INFO(("virtio-net disabled"));
+    // mark unused plugin for removal
+    ((bx_param_bool_c*)((bx_list_c*)SIM->get_param(BXPN_PLUGIN_CTRL))->get_by_name("virtio_net"))->set(0);
+    return;
+  }
+  memcpy(macaddr, SIM->get_param_string("mac", base)->getptr(), 6);
+  max_pairs = SIM->get_param_num("queues", base)->get();
+
+  // device configuration: mac, status, max_virtqueue_pairs, ..., and the
+  // RSS limits: rss_max_key_size, rss_max_indirection_table_length and
+  // supported_hash_types
+  memcpy(config, macaddr, 6);
+  WriteHostWordToLittleEndian(&config[6], VIRTIO_NET_S_LINK_UP);
+  WriteHostWordToLittleEndian(&config[8], max_pairs);
+  config[17] = BX_VIRTIO_NET_RSS_KEY_LEN;
+  WriteHostWordToLittleEndian(&config[18], BX_VIRTIO_NET_RSS_TABLE_LEN);
+  WriteHostDWordToLittleEndian(&config[20], VIRTIO_NET_RSS_HASH_TYPES);
+
+  tx_batch.buf = new Bit8u[BX_VIRTIO_NET_TX_BATCH * BX_PACKET_BUFSIZE];
+  tx_batch.big = new Bit8u[BX_VIRTIO_NET_MAX_FRAME];
+  tx_batch.count = 0;
+
+  // queues: rx0, tx0, rx1, tx1, ... and the control queue
+  virtio_init(BX_PLUGIN_VIRTIO_NET, "Virtio network adapter", BX_VIRTIO_ID_NET,
+              0x020000, 2 * max_pairs + ((max_pairs > 1) ? 1 : 0),
+              config, sizeof(config));
+  bootrom = SIM->get_param_string("bootrom", base)->getptr();
+  if ((strlen(bootrom) > 0) && (strcmp(bootrom, "none"))) {
+    load_pci_rom(bootrom);
+  }
+
+  statusbar_id = bx_gui->register_statusitem("VNET", 1);
+
+  // Attach to the selected ethernet module
+  ethdev = DEV_net_init_module(base, rx_handler, rx_status_handler, this);
+  ethdev->set_rx_batch_handler(rx_batch_handler);
+  tx_offload = ethdev->offload_caps();
+
+  host_features = BX_VIRTIO_FEATURE(VIRTIO_NET_F_MAC) |
+                  BX_VIRTIO_FEATURE(VIRTIO_NET_F_STATUS) |
+                  BX_VIRTIO_FEATURE(VIRTIO_NET_F_MRG_RXBUF) |
+                  BX_VIRTIO_FEATURE(VIRTIO_NET_F_CSUM) |
+                  BX_VIRTIO_FEATURE(VIRTIO_F_ANY_LAYOUT) |
+                  BX_VIRTIO_FEATURE(VIRTIO_RING_F_INDIRECT_DESC) |
+                  BX_VIRTIO_FEATURE(VIRTIO_RING_F_EVENT_IDX) |
+                  BX_VIRTIO_FEATURE(VIRTIO_F_VERSION_1);
+  if (tx_offload & BX_NETDEV_OFFLOAD_TSO4) {
+    host_features |= BX_VIRTIO_FEATURE(VIRTIO_NET_F_HOST_TSO4);
+  }
+  if (tx_offload & BX_NETDEV_OFFLOAD_TSO6) {
+    host_features |= BX_VIRTIO_FEATURE(VIRTIO_NET_F_HOST_TSO6);
+  }
+  if (max_pairs > 1) {
+    host_features |= BX_VIRTIO_FEATURE(VIRTIO_NET_F_CTRL_VQ) |
+                     BX_VIRTIO_FEATURE(VIRTIO_NET_F_MQ) |
+                     BX_VIRTIO_FEATURE(VIRTIO_NET_F_RSS);
+  }
+
+  // a transmit thread per queue pair if the module can be called from it
+  tx_threads = ethdev->tx_thread_safe();
+  if (tx_threads) {
+    BX_INIT_MUTEX(tx_lock);
+    tx_thread_data = new bx_vnet_tx_thread_t[max_pairs];
+    for (unsigned i = 0; i < max_pairs; i++) {
+      tx_thread_start(i);
+    }
+    if (tx_timer_index == BX_NULL_TIMER_HANDLE) {
+      tx_timer_index = bx_pc_system.register_timer(this, tx_timer_handler,
+                         BX_VIRTIO_NET_TX_POLL, 1, 0, "virtio-net tx");
+    }
+  }
+
+  BX_INFO(("virtio-net initialized (%d queue pair%s%s)", max_pairs,
+           (max_pairs > 1) ? "s" : "", tx_threads ? ", transmit threads" : ""));
+}
+
+void bx_virtio_net_c::register_state(void)
+{
+  bx_list_c *list = new bx_list_c(SIM->get_bochs_root(), "virtio_net", "Virtio network adapter State");
+  // the transmit threads must have sent all frames before saving
+  bx_param_bool_c *idle = new bx_param_bool_c(list, "tx_idle", NULL, NULL, 0);
+  idle->set_sr_handlers(this, param_save_handler, (param_restore_handler)NULL);
+  virtio_register_state(list);
+  BXRS_DEC_PARAM_FIELD(list, cur_pairs, cur_pairs);
+  bx_list_c *rsslist = new bx_list_c(list, "rss", "");
+  BXRS_PARAM_BOOL(rsslist, enabled, rss.enabled);
+  BXRS_HEX_PARAM_FIELD(rsslist, hash_types, rss.hash_types);
+  BXRS_HEX_PARAM_FIELD(rsslist, table_mask, rss.table_mask);
+  BXRS_DEC_PARAM_FIELD(rsslist, unclassified, rss.unclassified);
+  new bx_shadow_data_c(rsslist, "table", (Bit8u*)rss.table, sizeof(rss.table));
+  new bx_shadow_data_c(rsslist, "key", rss.key, sizeof(rss.key));
+}
+
+Bit64s bx_virtio_net_c::param_save_handler(void *devptr, bx_param_c *param)
+{
+  bx_virtio_net_c *class_ptr = (bx_virtio_net_c *) devptr;
+
+  if (class_ptr->tx_threads) {
+    for (unsigned i = 0; i < class_ptr->max_pairs; i++) {
+      class_ptr->tx_thread_idle(i);
+    }
+  }
+  return 1;
+}
+
+void bx_virtio_net_c::device_reset(void)
+{
+  cur_pairs = 1;
+  tx_batch.count = 0;
+  memset(&rss, 0, sizeof(rss));
+  if (tx_threads) {
+    // the frames are already taken from the queues: let them go out
+    for (unsigned i = 0; i < max_pairs; i++) {
+      tx_thread_idle(i);
+      tx_thread_data[i].stalled = 0;
+    }
+    bx_pc_system.deactivate_timer(tx_timer_index);
+  }
+}
+
+// the header has the num_buffers field with a modern or merging driver
+unsigned bx_virtio_net_c::hdr_len(void)
+{
+  if (has_feature(VIRTIO_NET_F_MRG_RXBUF) || has_feature(VIRTIO_F_VERSION_1)) {
+    return 12;
+  }
+  return 10;
+}
+
+void bx_virtio_net_c::queue_notify(unsigned q)
+{
+  if ((max_pairs > 1) && (q == (2 * max_pairs))) {
+    control(q);
+  } else if (q & 1) {
+    transmit(q);
+  }
+  // new receive buffers are picked up by the next rx_status() poll
+}
+
+void bx_virtio_net_c::control(unsigned q)
+{
+  // class, command and the largest command data (RSS configuration)
+  Bit8u cmd[2 + 10 + 2 * BX_VIRTIO_NET_RSS_TABLE_LEN + 1 + BX_VIRTIO_NET_RSS_KEY_LEN];
+  Bit8u ack;
+  Bit16u pairs;
+  unsigned len, count = 0;
+
+  while (vq_pop(q, &tx_elem)) {
+    ack = VIRTIO_NET_ERR;
+    len = vq_read(&tx_elem, 0, cmd, sizeof(cmd));
+    if (len >= 4) {
+      if ((cmd[0] == VIRTIO_NET_CTRL_MQ) && (cmd[1] == VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET)) {
+        ReadHostWordFromLittleEndian(&cmd[2], pairs);
+        if ((pairs >= 1) && (pairs <= max_pairs)) {
+          if (pairs != cur_pairs) {
+            BX_INFO(("using %d queue pair%s", pairs, (pairs > 1) ? "s" : ""));
+          }
+          cur_pairs = pairs;
+          ack = VIRTIO_NET_OK;
+        }
+      } else if ((cmd[0] == VIRTIO_NET_CTRL_MQ) && (cmd[1] == VIRTIO_NET_CTRL_MQ_RSS_CONFIG) &&
+                 has_feature(VIRTIO_NET_F_RSS)) {
+        ack = rss_config(&cmd[2], len - 2);
+      } else {
+        BX_ERROR(("unsupported control command class=%d cmd=%d", cmd[0], cmd[1]));
+      }
+    }
+    vq_write(&tx_elem, 0, &ack, 1);
+    vq_push(q, tx_elem.index, 1);
+    count++;
+  }
+  if (count > 0) {
+    vq_notify(q);
+  }
+}
+
+// struct virtio_net_rss_config: hash_types, indirection_table_mask,
+// unclassified_queue, indirection_table[], max_tx_vq, hash_key_length
+// and hash_key_data[]
+Bit8u bx_virtio_net_c::rss_config(const Bit8u *data, unsigned len)
+{
+  Bit32u hash_types;
+  Bit16u mask, unclassified, max_tx, entry;
+  Bit16u table[BX_VIRTIO_NET_RSS_TABLE_LEN];
+  unsigned i, entries, key_len;
+
+  if (len < 8) {
+    return VIRTIO_NET_ERR;
+  }
+  ReadHostDWordFromLittleEndian(&data[0], hash_types);
+  ReadHostWordFromLittleEndian(&data[4], mask);
+  ReadHostWordFromLittleEndian(&data[6], unclassified);
+  entries = mask + 1;
+  if ((entries > BX_VIRTIO_NET_RSS_TABLE_LEN) || ((entries & mask) != 0) ||
+      (len < (11 + 2 * entries)) || (unclassified >= max_pairs)) {
+    BX_ERROR(("invalid RSS configuration"));
+    return VIRTIO_NET_ERR;
+  }
+  for (i = 0; i < entries; i++) {
+    ReadHostWordFromLittleEndian(&data[8 + 2 * i], entry);
+    if (entry >= max_pairs) {
+      BX_ERROR(("invalid RSS indirection table entry %d", entry));
+      return VIRTIO_NET_ERR;
+    }
+    table[i] = entry;
+  }
+  ReadHostWordFromLittleEndian(&data[8 + 2 * entries], max_tx);
+  key_len = data[10 + 2 * entries];
+  if ((max_tx < 1) || (max_tx > max_pairs) || (key_len > BX_VIRTIO_NET_RSS_KEY_LEN) ||
+      (len < (11 + 2 * entries + key_len))) {
+    BX_ERROR(("invalid RSS configuration"));
+    return VIRTIO_NET_ERR;
+  }
+  rss.enabled = 1;
+  rss.hash_types = hash_types & VIRTIO_NET_RSS_HASH_TYPES;
+  rss.table_mask = mask;
+  rss.unclassified = unclassified;
+  memcpy(rss.table, table, entries * sizeof(Bit16u));
+  memset(rss.key, 0, sizeof(rss.key));
+  memcpy(rss.key, &data[11 + 2 * entries], key_len);
+  cur_pairs = max_tx;
+  BX_INFO(("RSS enabled: %d table entries, hash types 0x%02x, %d queue pair%s",
+           entries, rss.hash_types, cur_pairs, (cur_pairs > 1) ? "s" : ""));
+  return VIRTIO_NET_OK;
+}
+
+void bx_virtio_net_c::transmit(unsigned q)
+{
+  eth_offload_t offload;
+  Bit8u hdr[12], *buf;
+  unsigned hlen = hdr_len(), len, count = 0, total = 0;
+  bx_vnet_tx_thread_t *tt = tx_threads ? &tx_thread_data[q >> 1] : NULL;
+  bx_vnet_tx_slot_t *slot;
+  bx_bool full;
+
+  if (tt != NULL) {
+    tx_thread_report(q >> 1);
+  }
+  while (1) {
+    if (tt != NULL) {
+      BX_LOCK(tt->lock);
+      full = (tt->count == BX_VIRTIO_NET_TX_RING);
+      BX_UNLOCK(tt->lock);
+      if (full) {
+        // leave the frames in the queue until the thread has made room
+        tt->stalled = 1;
+        bx_pc_system.activate_timer(tx_timer_index, BX_VIRTIO_NET_TX_POLL, 1);
+        break;
+      }
+    }
+    if (!vq_pop(q, &tx_elem)) break;
+    len = tx_elem.out_len - hlen;
+    if ((tx_elem.out_len < hlen) || (len > BX_VIRTIO_NET_MAX_FRAME)) {
+      BX_ERROR(("TX: invalid frame size %d", tx_elem.out_len));
+    } else {
+      vq_read(&tx_elem, 0, hdr, hlen);
+      offload.flags = hdr[0];
+      offload.gso_type = hdr[1] & ~VIRTIO_NET_HDR_GSO_ECN;
+      ReadHostWordFromLittleEndian(&hdr[2], offload.hdr_len);
+      ReadHostWordFromLittleEndian(&hdr[4], offload.gso_size);
+      ReadHostWordFromLittleEndian(&hdr[6], offload.csum_start);
+      ReadHostWordFromLittleEndian(&hdr[8], offload.csum_offset);
+      if (tt != NULL) {
+        // copy the frame into the next free slot of the transmit thread
+        BX_LOCK(tt->lock);
+        slot = &tt->slot[(tt->head + tt->count) % BX_VIRTIO_NET_TX_RING];
+        BX_UNLOCK(tt->lock);
+        if (slot->size < len) {
+          delete [] slot->buf;
+          slot->buf = new Bit8u[len];
+          slot->size = len;
+        }
+        vq_read(&tx_elem, hlen, slot->buf, len);
+        slot->len = len;
+        slot->offload = offload;
+        BX_LOCK(tt->lock);
+        tt->count++;
+        BX_COND_SIGNAL(tt->cond);
+        BX_UNLOCK(tt->lock);
+      } else {
+        if (len <= BX_PACKET_BUFSIZE) {
+          buf = tx_batch.buf + tx_batch.count * BX_PACKET_BUFSIZE;
+        } else {
+          tx_flush();
+          buf = tx_batch.big;
+        }
+        vq_read(&tx_elem, hlen, buf, len);
+        tx_frame(buf, len, &offload);
+      }
+    }
+    vq_fill(q, tx_elem.index, 0, count);
+    total++;
+    if (++count == BX_VIRTIO_QUEUE_SIZE) {
+      vq_flush(q, count);
+      count = 0;
+    }
+  }
+  tx_flush();
+  if (count > 0) {
+    vq_flush(q, count);
+  }
+  if (total > 0) {
+    vq_notify(q);
+    bx_gui->statusbar_setitem(statusbar_id, 1, 1);
+  }
+}
+
+// checks the offload request and calculates the checksum if the pktmover
+// cannot do it. Returns BX_VNET_TX_OK or the reason to drop the frame (also
+// called by the transmit threads, so it must not log).
+unsigned bx_virtio_net_c::tx_checksum(Bit8u *buf, unsigned len, eth_offload_t *offload)
+{
+  unsigned start = offload->csum_start, pos = start + offload->csum_offset;
+
+  if (offload->gso_type != BX_NETDEV_GSO_NONE) {
+    if (!(offload->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) ||
+        ((offload->gso_type == BX_NETDEV_GSO_TCPV4) && !(tx_offload & BX_NETDEV_OFFLOAD_TSO4)) ||
+        ((offload->gso_type == BX_NETDEV_GSO_TCPV6) && !(tx_offload & BX_NETDEV_OFFLOAD_TSO6))) {
+      return BX_VNET_TX_BAD_GSO;
+    }
+  }
+  if (offload->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) {
+    if ((pos + 2) > len) {
+      return BX_VNET_TX_BAD_CSUM;
+    }
+    if (!(tx_offload & BX_NETDEV_OFFLOAD_CSUM)) {
+      // the partial checksum is already stored at the checksum position
+      put_net2(buf + pos, ip_checksum(buf + start, len - start) ^ (Bit16u)0xffff);
+      offload->flags = 0;
+    }
+  }
+  return BX_VNET_TX_OK;
+}
+
+void bx_virtio_net_c::tx_report(unsigned err, unsigned count)
+{
+  switch (err) {
+    case BX_VNET_TX_BAD_GSO:
+      BX_ERROR(("TX: unsupported GSO type, %d frame(s) dropped", count));
+      break;
+    case BX_VNET_TX_BAD_CSUM:
+      BX_ERROR(("TX: invalid checksum offset, %d frame(s) dropped", count));
+      break;
+    case BX_VNET_TX_FAILED:
+      BX_ERROR(("TX: %d frame(s) could not be sent", count));
+      break;
+  }
+}
+
+void bx_virtio_net_c::tx_frame(Bit8u *buf, unsigned len, eth_offload_t *offload)
+{
+  eth_packet_t *pkt;
+  unsigned err;
+
+  err = tx_checksum(buf, len, offload);
+  if (err != BX_VNET_TX_OK) {
+    tx_report(err, 1);
+    return;
+  }
+  if (buf == tx_batch.big) {
+    eth_packet_t big;
+    big.iovcnt = 1;
+    big.iov[0].base = buf;
+    big.iov[0].len = len;
+    big.offload = *offload;
+    if (ethdev->sendpkts(&big, 1) > 0) {
+      tx_report(BX_VNET_TX_FAILED, 1);
+    }
+    return;
+  }
+  pkt = &tx_batch.pkt[tx_batch.count];
+  pkt->iovcnt = 1;
+  pkt->iov[0].base = buf;
+  pkt->iov[0].len = len;
+  pkt->offload = *offload;
+  if (++tx_batch.count == BX_VIRTIO_NET_TX_BATCH) {
+    tx_flush();
+  }
+}
+
+void bx_virtio_net_c::tx_flush(void)
+{
+  unsigned failed;
+
+  if (tx_batch.count > 0) {
+    failed = ethdev->sendpkts(tx_batch.pkt, tx_batch.count);
+    if (failed > 0) {
+      tx_report(BX_VNET_TX_FAILED, failed);
+    }
+    tx_batch.count = 0;
+  }
+}
+
+void bx_virtio_net_c::tx_thread_start(unsigned pair)
+{
+  bx_vnet_tx_thread_t *tt = &tx_thread_data[pair];
+
+  memset(tt->slot, 0, sizeof(tt->slot));
+  tt->dev = this;
+  tt->pair = pair;
+  tt->head = 0;
+  tt->count = 0;
+  tt->busy = 0;
+  tt->quit = 0;
+  tt->stalled = 0;
+  memset(tt->errors, 0, sizeof(tt->errors));
+  BX_INIT_MUTEX(tt->lock);
+  BX_INIT_COND(tt->cond);
+  BX_INIT_COND(tt->idle);
+  tt->started = BX_THREAD_CREATE(tx_thread, tt, tt->tid);
+  if (!tt->started) {
+    BX_PANIC(("cannot create transmit thread for queue pair %d", pair));
+  }
+}
+
+void bx_virtio_net_c::tx_thread_stop(unsigned pair)
+{
+  bx_vnet_tx_thread_t *tt = &tx_thread_data[pair];
+
+  if (tt->started) {
+    tx_thread_idle(pair);
+    BX_LOCK(tt->lock);
+    tt->quit = 1;
+    BX_COND_SIGNAL(tt->cond);
+    BX_UNLOCK(tt->lock);
+    BX_THREAD_JOIN(tt->tid);
+    BX_FINI_COND(tt->idle);
+    BX_FINI_COND(tt->cond);
+    BX_FINI_MUTEX(tt->lock);
+    tt->started = 0;
+  }
+  for (unsigned i = 0; i < BX_VIRTIO_NET_TX_RING; i++) {
+    if (tt->slot[i].buf != NULL) {
+      delete [] tt->slot[i].buf;
+      tt->slot[i].buf = NULL;
+    }
+  }
+}
+
+// wait until the transmit thread has sent all queued frames
+void bx_virtio_net_c::tx_thread_idle(unsigned pair)
+{
+  bx_vnet_tx_thread_t *tt = &tx_thread_data[pair];
+
+  if (!tt->started) return;
+  BX_LOCK(tt->lock);
+  while ((tt->count > 0) || tt->busy) {
+    BX_COND_WAIT(tt->idle, tt->lock);
+  }
+  BX_UNLOCK(tt->lock);
+  tx_thread_report(pair);
+}
+
+// log the errors counted by the transmit thread
+void bx_virtio_net_c::tx_thread_report(unsigned pair)
+{
+  bx_vnet_tx_thread_t *tt = &tx_thread_data[pair];
+  unsigned errors[BX_VNET_TX_ERRORS], i;
+
+  BX_LOCK(tt->lock);
+  memcpy(errors, tt->errors, sizeof(errors));
+  memset(tt->errors, 0, sizeof(tt->errors));
+  BX_UNLOCK(tt->lock);
+  for (i = 0; i < BX_VNET_TX_ERRORS; i++) {
+    if (errors[i] > 0) {
+      tx_report(i, errors[i]);
+    }
+  }
+}
+
+void bx_virtio_net_c::tx_timer_handler(void *this_ptr)
+{
+  ((bx_virtio_net_c *) this_ptr)->tx_timer();
+}
+
+// process the transmit queues again that were left because of a full ring
+void bx_virtio_net_c::tx_timer(void)
+{
+  bx_vnet_tx_thread_t *tt;
+  bx_bool full, stalled = 0;
+
+  for (unsigned i = 0; i < max_pairs; i++) {
+    tt = &tx_thread_data[i];
+    if (tt->stalled) {
+      BX_LOCK(tt->lock);
+      full = (tt->count == BX_VIRTIO_NET_TX_RING);
+      BX_UNLOCK(tt->lock);
+      if (!full) {
+        tt->stalled = 0;
+        transmit(2 * i + 1);
+      }
+      stalled |= tt->stalled;
+    }
+  }
+  if (!stalled) {
+    bx_pc_system.deactivate_timer(tx_timer_index);
+  }
+}
+
+BX_THREAD_FUNC(bx_virtio_net_c::tx_thread, indata)
+{
+  bx_vnet_tx_thread_t *tt = (bx_vnet_tx_thread_t *) indata;
+
+  tt->dev->tx_loop(tt);
+  BX_THREAD_EXIT;
+}
+
+void bx_virtio_net_c::tx_loop(bx_vnet_tx_thread_t *tt)
+{
+  eth_packet_t pkts[BX_VIRTIO_NET_TX_BATCH];
+  bx_vnet_tx_slot_t *slot;
+  unsigned errors[BX_VNET_TX_ERRORS];
+  unsigned i, n, count, err;
+
+  BX_LOCK(tt->lock);
+  while (!tt->quit) {
+    if (tt->count == 0) {
+      BX_COND_WAIT(tt->cond, tt->lock);
+      continue;
+    }
+    n = (tt->count > BX_VIRTIO_NET_TX_BATCH) ? BX_VIRTIO_NET_TX_BATCH : tt->count;
+    tt->busy = 1;
+    BX_UNLOCK(tt->lock);
+    // the slots from head to head + count are owned by this thread
+    memset(errors, 0, sizeof(errors));
+    count = 0;
+    for (i = 0; i < n; i++) {
+      slot = &tt->slot[(tt->head + i) % BX_VIRTIO_NET_TX_RING];
+      err = tx_checksum(slot->buf, slot->len, &slot->offload);
+      if (err == BX_VNET_TX_OK) {
+        pkts[count].iovcnt = 1;
+        pkts[count].iov[0].base = slot->buf;
+        pkts[count].iov[0].len = slot->len;
+        pkts[count].offload = slot->offload;
+        count++;
+      } else {
+        errors[err]++;
+      }
+    }
+    if (count > 0) {
+      BX_LOCK(tx_lock);
+      errors[BX_VNET_TX_FAILED] += ethdev->sendpkts(pkts, count);
+      BX_UNLOCK(tx_lock);
+    }
+    BX_LOCK(tt->lock);
+    for (i = 0; i < BX_VNET_TX_ERRORS; i++) {
+      tt->errors[i] += errors[i];
+    }
+    tt->head = (tt->head + n) % BX_VIRTIO_NET_TX_RING;
+    tt->count -= n;
+    tt->busy = 0;
+    if (tt->count == 0) {
+      BX_COND_SIGNAL(tt->idle);
+    }
+  }
+  BX_UNLOCK(tt->lock);
+}
+
+bx_bool bx_virtio_net_c::rx_filter(const Bit8u *buf, unsigned len)
+{
+  if (len < 14) {
+    return 0;
+  }
+  // accept broadcast / multicast and frames for our MAC address
+  return ((buf[0] & 0x01) != 0) || !memcmp(buf, macaddr, 6);
+}
+
+// receive queue pair selected by the Toeplitz hash of the addresses and
+// ports of the flow: through the indirection table if the driver has
+// configured RSS, otherwise spread over the active queue pairs
+unsigned bx_virtio_net_c::rx_pair(const Bit8u *buf, unsigned len)
+{
+  Bit8u input[36];
+  unsigned n = 0, proto, l4;
+  Bit32u types = rss.enabled ? rss.hash_types : VIRTIO_NET_RSS_HASH_TYPES;
+
+  if (!rss.enabled && (cur_pairs == 1)) {
+    return 0;
+  }
+  if ((get_net2(&buf[12]) == ETHERNET_TYPE_IPV4) && (len >= 34)) {
+    proto = buf[23];
+    if ((get_net2(&buf[20]) & 0x3fff) != 0) {
+      proto = 0; // fragment: use the addresses only
+    }
+    l4 = 14 + (buf[14] & 0x0f) * 4;
+    memcpy(input, &buf[26], 8);
+    if ((((proto == 6) && (types & VIRTIO_NET_RSS_HASH_TYPE_TCPv4)) ||
+         ((proto == 17) && (types & VIRTIO_NET_RSS_HASH_TYPE_UDPv4))) && (len >= (l4 + 4))) {
+      memcpy(&input[8], &buf[l4], 4);
+      n = 12;
+    } else if (types & VIRTIO_NET_RSS_HASH_TYPE_IPv4) {
+      n = 8;
+    }
+  } else if ((get_net2(&buf[12]) == 0x86dd) && (len >= 54)) {
+    proto = buf[20];
+    memcpy(input, &buf[22], 32);
+    if ((((proto == 6) && (types & VIRTIO_NET_RSS_HASH_TYPE_TCPv6)) ||
+         ((proto == 17) && (types & VIRTIO_NET_RSS_HASH_TYPE_UDPv6))) && (len >= 58)) {
+      memcpy(&input[32], &buf[54], 4);
+      n = 36;
+    } else if (types & VIRTIO_NET_RSS_HASH_TYPE_IPv6) {
+      n = 32;
+    }
+  }
+  if (n == 0) {
+    return rss.enabled ? rss.unclassified : 0;
+  }
+  if (rss.enabled) {
+    return rss.table[toeplitz_hash(rss.key, input, n) & rss.table_mask];
+  }
+  return toeplitz_hash(rss_default_key, input, n) % cur_pairs;
+}
+
+// returns a mask of the receive queues used for the frame
+Bit32u bx_virtio_net_c::rx_frame(const Bit8u *buf, unsigned len)
+{
+  Bit8u hdr[12];
+  bx_virtq_elem_t *elem;
+  unsigned q, hlen = hdr_len(), offset = 0, nbuf = 0, skip, chunk, first_len = 0;
+
+  if (!driver_ok() || !rx_filter(buf, len)) {
+    return 0;
+  }
+  q = 2 * rx_pair(buf, len);
+  memset(hdr, 0, sizeof(hdr));
+  if (has_feature(VIRTIO_NET_F_MRG_RXBUF)) {
+    // spread the frame over as many buffers as needed
+    while (offset < len) {
+      elem = &rx_elem[(nbuf > 0) ? 1 : 0];
+      if (!vq_pop(q, elem)) {
+        vq_unpop(q, nbuf);
+        BX_DEBUG(("RX: no receive buffers available, frame dropped"));
+        return 0;
+      }
+      skip = (nbuf > 0) ? 0 : hlen;
+      if (elem->in_len <= skip) {
+        BX_ERROR(("RX: receive buffer too small"));
+        vq_unpop(q, nbuf + 1);
+        return 0;
+      }
+      chunk = elem->in_len - skip;
+      if (chunk > (len - offset)) {
+        chunk = len - offset;
+      }
+      vq_write(elem, skip, buf + offset, chunk);
+      if (nbuf > 0) {
+        vq_fill(q, elem->index, chunk, nbuf);
+      } else {
+        first_len = hlen + chunk;
+      }
+      offset += chunk;
+      nbuf++;
+    }
+    WriteHostWordToLittleEndian(&hdr[10], nbuf);
+    vq_write(&rx_elem[0], 0, hdr, hlen);
+    vq_fill(q, rx_elem[0].index, first_len, 0);
+    vq_flush(q, nbuf);
+  } else {
+    if (!vq_pop(q, &rx_elem[0])) {
+      BX_DEBUG(("RX: no receive buffers available, frame dropped"));
+      return 0;
+    }
+    if (rx_elem[0].in_len < (hlen + len)) {
+      BX_ERROR(("RX: receive buffer too small, frame dropped"));
+      vq_push(q, rx_elem[0].index, 0);
+    } else {
+      hdr[10] = 1;
+      vq_write(&rx_elem[0], 0, hdr, hlen);
+      vq_write(&rx_elem[0], hlen, buf, len);
+      vq_push(q, rx_elem[0].index, hlen + len);
+    }
+  }
+  return 1 << q;
+}
+
+void bx_virtio_net_c::rx_notify(Bit32u queues)
+{
+  for (unsigned q = 0; queues != 0; q++, queues >>= 1) {
+    if (queues & 1) {
+      vq_notify(q);
+    }
+  }
+}
+
+/*
+ * Callback from the eth system driver to check if the device can receive
+ */
+Bit32u bx_virtio_net_c::rx_status_handler(void *arg)
+{
+  bx_virtio_net_c *class_ptr = (bx_virtio_net_c *) arg;
+  return class_ptr->rx_status();
+}
+
+Bit32u bx_virtio_net_c::rx_status()
+{
+  Bit32u status = BX_NETDEV_1GBIT;
+
+  if (driver_ok()) {
+    for (unsigned i = 0; i < cur_pairs; i++) {
+      if (vq_avail(2 * i) == 0) {
+        return status;
+      }
+    }
+    status |= BX_NETDEV_RXREADY;
+  }
+  return status;
+}
+
+/*
+ * Callback from the eth system driver when a frame has arrived
+ */
+void bx_virtio_net_c::rx_handler(void *arg, const void *buf, unsigned len)
+{
+  bx_virtio_net_c *class_ptr = (bx_virtio_net_c *) arg;
+  Bit32u queues = class_ptr->rx_frame((const Bit8u *) buf, len);
+
+  if (queues != 0) {
+    class_ptr->rx_notify(queues);
+    bx_gui->statusbar_setitem(class_ptr->statusbar_id, 1);
+  }
+}
+
+/*
+ * Callback from the eth system driver with several frames: the driver is
+ * notified once per receive queue for the whole batch
+ */
+unsigned bx_virtio_net_c::rx_batch_handler(void *arg, const eth_rx_frame_t *frames, unsigned count)
+{
+  bx_virtio_net_c *class_ptr = (bx_virtio_net_c *) arg;
+  Bit32u queues = 0;
+  unsigned i;
+
+  for (i = 0; i < count; i++) {
+    if (!(class_ptr->rx_status() & BX_NETDEV_RXREADY)) break;
+    queues |= class_ptr->rx_frame(frames[i].buf, frames[i].len);
+  }
+  if (queues != 0) {
+    class_ptr->rx_notify(queues);
+    bx_gui->statusbar_setitem(class_ptr->statusbar_id, 1);
+  }
+  return i;
+}
+
+#endif // BX_SUPPORT_PCI && BX_SUPPORT_VIRTIO_NET
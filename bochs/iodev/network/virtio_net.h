@@ -0,0 +1,152 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef BX_IODEV_VIRTIO_NET_H
+#define BX_IODEV_VIRTIO_NET_H
+
+#include "bxthread.h"
+
+#define BX_VIRTIO_NET_MAX_PAIRS 8
+#define BX_VIRTIO_NET_TX_BATCH  16        // frames passed to the pktmover at once
+#define BX_VIRTIO_NET_MAX_FRAME (65535 + 18) // TSO frame with ethernet header
+#define BX_VIRTIO_NET_TX_RING   64        // frames queued for a transmit thread
+#define BX_VIRTIO_NET_TX_POLL   100       // usec between checks of a full ring
+#define BX_VIRTIO_NET_CONFIG_LEN 24
+#define BX_VIRTIO_NET_RSS_KEY_LEN   40
+#define BX_VIRTIO_NET_RSS_TABLE_LEN 128
+
+class bx_virtio_net_c;
+
+// transmit errors (see tx_checksum() and tx_report())
+#define BX_VNET_TX_OK        0
+#define BX_VNET_TX_BAD_GSO   1 // unsupported GSO type
+#define BX_VNET_TX_BAD_CSUM  2 // invalid checksum offset
+#define BX_VNET_TX_FAILED    3 // pktmover could not send the frame
+#define BX_VNET_TX_ERRORS    4
+
+// frame copied out of a transmit queue, waiting for the host thread
+typedef struct {
+  Bit8u    *buf;
+  unsigned size;  // allocated
+  unsigned len;
+  eth_offload_t offload;
+} bx_vnet_tx_slot_t;
+
+// transmit thread of a queue pair: does the checksum work and passes the
+// frames to the pktmover while the emulation continues. It doesn't log, the
+// errors are counted and reported on the emulation thread.
+typedef struct {
+  bx_virtio_net_c *dev;
+  unsigned pair;
+  bx_bool  started;
+  BX_THREAD_ID(tid);
+  BX_MUTEX(lock);
+  BX_COND(cond);
+  BX_COND(idle);    // signalled when the ring is empty
+  bx_vnet_tx_slot_t slot[BX_VIRTIO_NET_TX_RING];
+  unsigned head;
+  unsigned count;
+  bx_bool  busy;
+  bx_bool  quit;
+  bx_bool  stalled; // ring was full, the queue is processed again by the timer
+  unsigned errors[BX_VNET_TX_ERRORS];
+} bx_vnet_tx_thread_t;
+
+class bx_virtio_net_c : public bx_virtio_pci_c {
+public:
+  bx_virtio_net_c();
+  virtual ~bx_virtio_net_c();
+  virtual void init(void);
+  virtual void register_state(void);
+
+protected:
+  virtual Bit64u get_features(void) {return host_features;}
+  virtual void   queue_notify(unsigned q);
+  virtual void   device_reset(void);
+
+private:
+  unsigned hdr_len(void);
+
+  void transmit(unsigned q);
+  unsigned tx_checksum(Bit8u *buf, unsigned len, eth_offload_t *offload);
+  void tx_frame(Bit8u *buf, unsigned len, eth_offload_t *offload);
+  void tx_report(unsigned err, unsigned count);
+  void tx_flush(void);
+  void control(unsigned q);
+  Bit8u rss_config(const Bit8u *data, unsigned len);
+
+  void tx_thread_start(unsigned pair);
+  void tx_thread_stop(unsigned pair);
+  void tx_thread_idle(unsigned pair);
+  void tx_thread_report(unsigned pair);
+  void tx_loop(bx_vnet_tx_thread_t *tt);
+  static BX_THREAD_FUNC(tx_thread, indata);
+  static void tx_timer_handler(void *this_ptr);
+  void tx_timer(void);
+  static Bit64s param_save_handler(void *devptr, bx_param_c *param);
+
+  bx_bool  rx_filter(const Bit8u *buf, unsigned len);
+  unsigned rx_pair(const Bit8u *buf, unsigned len);
+  Bit32u   rx_frame(const Bit8u *buf, unsigned len);
+  void     rx_notify(Bit32u queues);
+
+  static Bit32u rx_status_handler(void *arg);
+  Bit32u rx_status(void);
+  static void rx_handler(void *arg, const void *buf, unsigned len);
+  static unsigned rx_batch_handler(void *arg, const eth_rx_frame_t *frames, unsigned count);
+
+  eth_pktmover_c *ethdev;
+
+  Bit8u    macaddr[6];
+  Bit8u    config[BX_VIRTIO_NET_CONFIG_LEN];
+  Bit64u   host_features;
+  Bit32u   tx_offload;
+  unsigned max_pairs;
+  unsigned cur_pairs;
+  int      statusbar_id;
+
+  struct {
+    Bit8u *buf; // BX_VIRTIO_NET_TX_BATCH slots of BX_PACKET_BUFSIZE bytes
+    Bit8u *big; // frame that does not fit into a slot
+    eth_packet_t pkt[BX_VIRTIO_NET_TX_BATCH];
+    unsigned count;
+  } tx_batch;
+
+  // receive side scaling (VIRTIO_NET_F_RSS)
+  struct {
+    bx_bool  enabled;
+    Bit32u   hash_types;
+    Bit16u   table_mask;
+    Bit16u   unclassified;
+    Bit16u   table[BX_VIRTIO_NET_RSS_TABLE_LEN];
+    Bit8u    key[BX_VIRTIO_NET_RSS_KEY_LEN];
+  } rss;
+
+  bx_bool  tx_threads;
+  BX_MUTEX(tx_lock); // serializes the pktmover calls of the transmit threads
+  bx_vnet_tx_thread_t *tx_thread_data;
+  int      tx_timer_index;
+
+  bx_virtq_elem_t tx_elem;
+  bx_virtq_elem_t rx_elem[2]; // first and following chains of a merged frame
+};
+
+#endif
@@ -160,6 +160,18 @@ void scsi_device_t::scsi_remove_request(SCSIRequest *r)
   free_requests = r;
 }
 
+void scsi_device_t::trace_request(Bit8u type, Bit64u lba, Bit32u sectors, Bit64u start_time)
+{
+  Bit32u latency = (Bit32u)(DISK_TRACE_TIME() - start_time);
+  unsigned depth = 0;
+
+  for (SCSIRequest *r = requests; r != NULL; r = r->next) {
+    depth++;
+  }
+  if (depth > 255) depth = 255;
+  DEV_hdimage_trace_request(DISK_TRACE_DEV_SCSI, type, lba, sectors, latency, (Bit8u)depth);
+}
+
 SCSIRequest* scsi_device_t::scsi_find_request(Bit32u tag)
 {
   SCSIRequest *r = requests;
@@ -241,12 +253,16 @@ void scsi_device_t::scsi_read_data(Bit32u tag)
       scsi_read_complete((void*)r, 0);
     }
   } else {
+    Bit64u start_time = DISK_TRACE_TIME();
     ret = (int)hdimage->lseek(r->sector * 512, SEEK_SET);
     if (ret < 0) {
       BX_ERROR(("could not lseek() hard drive image file"));
       scsi_command_complete(r, STATUS_CHECK_CONDITION, SENSE_HARDWARE_ERROR);
     }
     ret = hdimage->read((bx_ptr_t)r->dma_buf, r->buf_len);
+    if (DEV_hdimage_trace_enabled()) {
+      trace_request(DISK_TRACE_READ, r->sector, n, start_time);
+    }
     if (ret < r->buf_len) {
       BX_ERROR(("could not read() hard drive image file"));
       scsi_command_complete(r, STATUS_CHECK_CONDITION, SENSE_HARDWARE_ERROR);
@@ -298,12 +314,16 @@ int scsi_device_t::scsi_write_data(Bit32u tag)
   if (type == SCSIDEV_TYPE_DISK) {
     n = r->buf_len / 512;
     if (n) {
+      Bit64u start_time = DISK_TRACE_TIME();
       ret = (int)hdimage->lseek(r->sector * 512, SEEK_SET);
       if (ret < 0) {
         BX_ERROR(("could not lseek() hard drive image file"));
         scsi_command_complete(r, STATUS_CHECK_CONDITION, SENSE_HARDWARE_ERROR);
       }
       ret = hdimage->write((bx_ptr_t)r->dma_buf, r->buf_len);
+      if (DEV_hdimage_trace_enabled()) {
+        trace_request(DISK_TRACE_WRITE, r->sector, n, start_time);
+      }
       r->sector += n;
       r->sector_count -= n;
       if (ret < r->buf_len) {
@@ -686,7 +706,17 @@ Bit32s scsi_device_t::scsi_send_command(Bit32u tag, Bit8u *buf, int lun)
       break;
     case 0x35:
       BX_DEBUG(("Syncronise cache (sector "FMT_LL"d, count %d)", lba, len));
-      // TODO: flush cache
+      if (type == SCSIDEV_TYPE_DISK) {
+        Bit64u start_time = DISK_TRACE_TIME();
+        if (hdimage->flush() < 0) {
+          BX_ERROR(("could not flush disk image"));
+          scsi_command_complete(r, STATUS_CHECK_CONDITION, SENSE_HARDWARE_ERROR);
+          return 0;
+        }
+        if (DEV_hdimage_trace_enabled()) {
+          trace_request(DISK_TRACE_FLUSH, 0, 0, start_time);
+        }
+      }
       break;
     case 0x43:
       {
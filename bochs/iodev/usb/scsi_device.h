@@ -90,6 +90,7 @@ public:
 protected:
   SCSIRequest* scsi_new_request(Bit32u tag);
   void scsi_remove_request(SCSIRequest *r);
+  void trace_request(Bit8u type, Bit64u lba, Bit32u sectors, Bit64u start_time);
   SCSIRequest *scsi_find_request(Bit32u tag);
 
 private:
@@ -0,0 +1,998 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+/////////////////////////////////////////////////////////////////////////
+
+// Virtio PCI transport shared by the virtio devices. Each device is a
+// transitional device: the legacy interface is located in the I/O space
+// (BAR #0) and the modern interface in the memory space (BAR #1). Only
+// INTx interrupts are supported.
+
+// Define BX_PLUGGABLE in files that can be compiled into plugins.  For
+// platforms that require a special tag on exported symbols, BX_PLUGGABLE
+// is used to know when we are exporting symbols and when we are importing.
+#define BX_PLUGGABLE
+
+#include "iodev.h"
+#if BX_SUPPORT_PCI && BX_SUPPORT_VIRTIO
+
+#include "pci.h"
+#include "virtio.h"
+
+#define LOG_THIS this->
+
+// legacy interface registers (I/O space)
+#define VIRTIO_PCI_HOST_FEATURES   0x00
+#define VIRTIO_PCI_GUEST_FEATURES  0x04
+#define VIRTIO_PCI_QUEUE_PFN       0x08
+#define VIRTIO_PCI_QUEUE_NUM       0x0c
+#define VIRTIO_PCI_QUEUE_SEL       0x0e
+#define VIRTIO_PCI_QUEUE_NOTIFY    0x10
+#define VIRTIO_PCI_STATUS          0x12
+#define VIRTIO_PCI_ISR             0x13
+#define VIRTIO_PCI_CONFIG          0x14
+
+#define VIRTIO_PCI_QUEUE_ADDR_SHIFT 12
+#define VIRTIO_PCI_VRING_ALIGN      4096
+
+// modern interface regions (memory space)
+#define VIRTIO_PCI_COMMON_OFFSET   0x0000
+#define VIRTIO_PCI_ISR_OFFSET      0x1000
+#define VIRTIO_PCI_DEVICE_OFFSET   0x2000
+#define VIRTIO_PCI_NOTIFY_OFFSET   0x3000
+#define VIRTIO_PCI_MODERN_SIZE     0x4000
+#define VIRTIO_PCI_NOTIFY_MULT     4
+
+#define VIRTIO_PCI_CAP_COMMON_CFG  1
+#define VIRTIO_PCI_CAP_NOTIFY_CFG  2
+#define VIRTIO_PCI_CAP_ISR_CFG     3
+#define VIRTIO_PCI_CAP_DEVICE_CFG  4
+
+// common configuration structure
+#define VIRTIO_PCI_COMMON_DFSELECT 0x00
+#define VIRTIO_PCI_COMMON_DF       0x04
+#define VIRTIO_PCI_COMMON_GFSELECT 0x08
+#define VIRTIO_PCI_COMMON_GF       0x0c
+#define VIRTIO_PCI_COMMON_MSIX     0x10
+#define VIRTIO_PCI_COMMON_NUMQ     0x12
+#define VIRTIO_PCI_COMMON_STATUS   0x14
+#define VIRTIO_PCI_COMMON_CFGGEN   0x15
+#define VIRTIO_PCI_COMMON_Q_SELECT 0x16
+#define VIRTIO_PCI_COMMON_Q_SIZE   0x18
+#define VIRTIO_PCI_COMMON_Q_MSIX   0x1a
+#define VIRTIO_PCI_COMMON_Q_ENABLE 0x1c
+#define VIRTIO_PCI_COMMON_Q_NOFF   0x1e
+#define VIRTIO_PCI_COMMON_Q_DESCLO 0x20
+#define VIRTIO_PCI_COMMON_Q_DESCHI 0x24
+#define VIRTIO_PCI_COMMON_Q_AVAILLO 0x28
+#define VIRTIO_PCI_COMMON_Q_AVAILHI 0x2c
+#define VIRTIO_PCI_COMMON_Q_USEDLO 0x30
+#define VIRTIO_PCI_COMMON_Q_USEDHI 0x34
+#define VIRTIO_PCI_COMMON_SIZE     0x38
+
+#define VIRTIO_MSI_NO_VECTOR       0xffff
+
+#define VIRTIO_ISR_QUEUE           0x01
+#define VIRTIO_ISR_CONFIG          0x02
+
+// split virtqueue layout
+#define VRING_DESC_F_NEXT          1
+#define VRING_DESC_F_WRITE         2
+#define VRING_DESC_F_INDIRECT      4
+#define VRING_AVAIL_F_NO_INTERRUPT 1
+
+static const Bit8u virtio_iomask[128] = {
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7};
+
+// ring access helpers (the rings are little endian)
+
+static Bit16u vring_read16(bx_phy_address addr)
+{
+  Bit8u buf[2];
+  Bit16u value;
+
+  DEV_MEM_READ_PHYSICAL_DMA(addr, 2, buf);
+  ReadHostWordFromLittleEndian(buf, value);
+  return value;
+}
+
+static void vring_write16(bx_phy_address addr, Bit16u value)
+{
+  Bit8u buf[2];
+
+  WriteHostWordToLittleEndian(buf, value);
+  DEV_MEM_WRITE_PHYSICAL_DMA(addr, 2, buf);
+}
+
+BX_CPP_INLINE bx_bool vring_need_event(Bit16u event_idx, Bit16u new_idx, Bit16u old_idx)
+{
+  return ((Bit16u)(new_idx - event_idx - 1) < (Bit16u)(new_idx - old_idx));
+}
+
+bx_virtio_pci_c::bx_virtio_pci_c()
+{
+  plugname = NULL;
+  devfunc = 0x00;
+  guest_features = 0;
+  status = 0;
+  num_queues = 0;
+  isr = 0;
+  config_generation = 0;
+  queue_sel = 0;
+  dfeature_sel = 0;
+  gfeature_sel = 0;
+  config = NULL;
+  config_len = 0;
+  io_size = 0;
+  memset(vq, 0, sizeof(vq));
+}
+
+bx_virtio_pci_c::~bx_virtio_pci_c()
+{
+}
+
+void bx_virtio_pci_c::virtio_init(const char *name, const char *descr, Bit16u type,
+                                  Bit32u class_code, unsigned queues, Bit8u *cfg,
+                                  unsigned cfg_len)
+{
+  plugname = name;
+  num_queues = queues;
+  config = cfg;
+  config_len = cfg_len;
+  io_size = 32;
+  while (io_size < (VIRTIO_PCI_CONFIG + config_len)) {
+    io_size <<= 1;
+  }
+  if ((num_queues > BX_VIRTIO_MAX_QUEUES) || (io_size > sizeof(virtio_iomask))) {
+    BX_PANIC(("virtio: unsupported device layout"));
+    return;
+  }
+
+  DEV_register_pci_handlers(this, &devfunc, name, descr);
+
+  for (unsigned i = 0; i < 256; i++) {
+    pci_conf[i] = 0x0;
+  }
+  pci_base_address[0] = 0;
+  pci_base_address[1] = 0;
+  pci_rom_address = 0;
+
+  // transitional device: device ID 0x1000 + type - 1, subsystem ID = type
+  pci_conf[0x00] = BX_VIRTIO_VENDOR_ID & 0xff;
+  pci_conf[0x01] = BX_VIRTIO_VENDOR_ID >> 8;
+  pci_conf[0x02] = (0x1000 + type - 1) & 0xff;
+  pci_conf[0x03] = (0x1000 + type - 1) >> 8;
+  pci_conf[0x06] = 0x10; // capabilities list
+  pci_conf[0x09] = class_code & 0xff;
+  pci_conf[0x0a] = (class_code >> 8) & 0xff;
+  pci_conf[0x0b] = (class_code >> 16) & 0xff;
+  pci_conf[0x10] = 0x01; // I/O space (legacy interface)
+  pci_conf[0x2c] = BX_VIRTIO_VENDOR_ID & 0xff;
+  pci_conf[0x2d] = BX_VIRTIO_VENDOR_ID >> 8;
+  pci_conf[0x2e] = type & 0xff;
+  pci_conf[0x2f] = type >> 8;
+  pci_conf[0x34] = 0x40;
+  pci_conf[0x3d] = BX_PCI_INTA;
+
+  add_cap(0x40, 0x50, VIRTIO_PCI_CAP_COMMON_CFG, VIRTIO_PCI_COMMON_OFFSET,
+          VIRTIO_PCI_COMMON_SIZE);
+  add_cap(0x50, 0x60, VIRTIO_PCI_CAP_ISR_CFG, VIRTIO_PCI_ISR_OFFSET, 1);
+  add_cap(0x60, 0x70, VIRTIO_PCI_CAP_DEVICE_CFG, VIRTIO_PCI_DEVICE_OFFSET,
+          config_len);
+  add_cap(0x70, 0x00, VIRTIO_PCI_CAP_NOTIFY_CFG, VIRTIO_PCI_NOTIFY_OFFSET,
+          num_queues * VIRTIO_PCI_NOTIFY_MULT);
+  pci_conf[0x72] = 20;
+  pci_conf[0x80] = VIRTIO_PCI_NOTIFY_MULT;
+}
+
+// vendor specific capability pointing to a region of the modern interface
+void bx_virtio_pci_c::add_cap(Bit8u pos, Bit8u next, Bit8u type, Bit32u offset, Bit32u len)
+{
+  pci_conf[pos] = 0x09;
+  pci_conf[pos + 1] = next;
+  pci_conf[pos + 2] = 16;
+  pci_conf[pos + 3] = type;
+  pci_conf[pos + 4] = 1; // BAR #1
+  WriteHostDWordToLittleEndian(&pci_conf[pos + 8], offset);
+  WriteHostDWordToLittleEndian(&pci_conf[pos + 12], len);
+}
+
+void bx_virtio_pci_c::reset(unsigned type)
+{
+  pci_conf[0x04] = 0x00;
+  pci_conf[0x05] = 0x00;
+  virtio_reset();
+}
+
+void bx_virtio_pci_c::virtio_reset()
+{
+  guest_features = 0;
+  status = 0;
+  isr = 0;
+  queue_sel = 0;
+  dfeature_sel = 0;
+  gfeature_sel = 0;
+  memset(vq, 0, sizeof(vq));
+  for (unsigned q = 0; q < num_queues; q++) {
+    vq[q].num = BX_VIRTIO_QUEUE_SIZE;
+  }
+  update_irq();
+  device_reset();
+}
+
+void bx_virtio_pci_c::virtio_register_state(bx_list_c *list)
+{
+  char name[8];
+
+  BXRS_HEX_PARAM_FIELD(list, guest_features, guest_features);
+  BXRS_HEX_PARAM_FIELD(list, status, status);
+  BXRS_HEX_PARAM_FIELD(list, isr, isr);
+  BXRS_DEC_PARAM_FIELD(list, config_generation, config_generation);
+  BXRS_DEC_PARAM_FIELD(list, queue_sel, queue_sel);
+  BXRS_DEC_PARAM_FIELD(list, dfeature_sel, dfeature_sel);
+  BXRS_DEC_PARAM_FIELD(list, gfeature_sel, gfeature_sel);
+  bx_list_c *queues = new bx_list_c(list, "vq", "");
+  for (unsigned q = 0; q < num_queues; q++) {
+    sprintf(name, "%d", q);
+    bx_list_c *vql = new bx_list_c(queues, name, "");
+    BXRS_DEC_PARAM_FIELD(vql, num, vq[q].num);
+    BXRS_PARAM_BOOL(vql, enabled, vq[q].enabled);
+    BXRS_HEX_PARAM_FIELD(vql, pfn, vq[q].pfn);
+    BXRS_HEX_PARAM_FIELD(vql, desc, vq[q].desc);
+    BXRS_HEX_PARAM_FIELD(vql, avail, vq[q].avail);
+    BXRS_HEX_PARAM_FIELD(vql, used, vq[q].used);
+    BXRS_DEC_PARAM_FIELD(vql, last_avail_idx, vq[q].last_avail_idx);
+    BXRS_DEC_PARAM_FIELD(vql, used_idx, vq[q].used_idx);
+    BXRS_DEC_PARAM_FIELD(vql, signalled_used, vq[q].signalled_used);
+    BXRS_PARAM_BOOL(vql, signalled_used_valid, vq[q].signalled_used_valid);
+  }
+  register_pci_state(list);
+}
+
+void bx_virtio_pci_c::after_restore_state(void)
+{
+  if (DEV_pci_set_base_io(this, read_handler, write_handler,
+                          &pci_base_address[0], &pci_conf[0x10],
+                          io_size, &virtio_iomask[0], plugname)) {
+    BX_INFO(("new i/o base address: 0x%04x", pci_base_address[0]));
+  }
+  if (DEV_pci_set_base_mem(this, mem_read_handler, mem_write_handler,
+                           &pci_base_address[1], &pci_conf[0x14],
+                           VIRTIO_PCI_MODERN_SIZE)) {
+    BX_INFO(("new mem base address: 0x%08x", pci_base_address[1]));
+  }
+  if (pci_rom_size > 0) {
+    if (DEV_pci_set_base_mem(this, mem_read_handler, mem_write_handler,
+                             &pci_rom_address, &pci_conf[0x30], pci_rom_size)) {
+      BX_INFO(("new ROM address: 0x%08x", pci_rom_address));
+    }
+  }
+  update_irq();
+}
+
+void bx_virtio_pci_c::update_irq()
+{
+  bx_bool level = (isr != 0) && ((pci_conf[0x05] & 0x04) == 0);
+
+  DEV_pci_set_irq(devfunc, pci_conf[0x3d], level);
+}
+
+Bit8u bx_virtio_pci_c::read_isr()
+{
+  Bit8u value = isr;
+
+  isr = 0;
+  update_irq();
+  return value;
+}
+
+void bx_virtio_pci_c::config_changed()
+{
+  config_generation++;
+  isr |= VIRTIO_ISR_CONFIG;
+  update_irq();
+}
+
+void bx_virtio_pci_c::set_status(Bit8u value)
+{
+  if (value == 0) {
+    BX_DEBUG(("device reset by the driver"));
+    virtio_reset();
+    return;
+  }
+  if ((value & VIRTIO_STATUS_FEATURES_OK) && !(status & VIRTIO_STATUS_FEATURES_OK)) {
+    if (guest_features & ~get_features()) {
+      BX_ERROR(("driver accepted unsupported features 0x" FMT_LL "x", guest_features));
+      value &= ~VIRTIO_STATUS_FEATURES_OK;
+    }
+  }
+  if ((value & VIRTIO_STATUS_DRIVER_OK) && !(status & VIRTIO_STATUS_DRIVER_OK)) {
+    BX_INFO(("driver ready (%s interface, features 0x" FMT_LL "x)",
+             has_feature(VIRTIO_F_VERSION_1) ? "modern" : "legacy", guest_features));
+  }
+  status = value;
+}
+
+void bx_virtio_pci_c::set_legacy_pfn(unsigned q, Bit32u pfn)
+{
+  bx_virtq_t *v = &vq[q];
+
+  if (pfn == 0) {
+    memset(v, 0, sizeof(bx_virtq_t));
+    v->num = BX_VIRTIO_QUEUE_SIZE;
+    return;
+  }
+  v->pfn = pfn;
+  v->desc = (Bit64u)pfn << VIRTIO_PCI_QUEUE_ADDR_SHIFT;
+  v->avail = v->desc + 16 * v->num;
+  v->used = (v->avail + 6 + 2 * v->num + VIRTIO_PCI_VRING_ALIGN - 1) &
+            ~(Bit64u)(VIRTIO_PCI_VRING_ALIGN - 1);
+  v->last_avail_idx = 0;
+  v->used_idx = 0;
+  v->signalled_used_valid = 0;
+  v->enabled = 1;
+}
+
+// device specific configuration space (little endian)
+
+Bit32u bx_virtio_pci_c::dev_config_read(unsigned offset, unsigned len)
+{
+  Bit32u value = 0;
+
+  for (unsigned i = 0; i < len; i++) {
+    if ((offset + i) < config_len) {
+      value |= (config[offset + i] << (i * 8));
+    }
+  }
+  return value;
+}
+
+void bx_virtio_pci_c::dev_config_write(unsigned offset, Bit32u value, unsigned len)
+{
+  if ((offset + len) > config_len) {
+    BX_ERROR(("write to config offset 0x%02x ignored", offset));
+    return;
+  }
+  for (unsigned i = 0; i < len; i++) {
+    config[offset + i] = (Bit8u)(value >> (i * 8));
+  }
+  config_written(offset, len);
+}
+
+// legacy interface
+
+Bit32u bx_virtio_pci_c::legacy_read(unsigned offset, unsigned len)
+{
+  Bit32u value = 0;
+
+  if (offset >= VIRTIO_PCI_CONFIG) {
+    return dev_config_read(offset - VIRTIO_PCI_CONFIG, len);
+  }
+  switch (offset) {
+    case VIRTIO_PCI_HOST_FEATURES:
+      value = (Bit32u)get_features();
+      break;
+    case VIRTIO_PCI_GUEST_FEATURES:
+      value = (Bit32u)guest_features;
+      break;
+    case VIRTIO_PCI_QUEUE_PFN:
+      value = (queue_sel < num_queues) ? vq[queue_sel].pfn : 0;
+      break;
+    case VIRTIO_PCI_QUEUE_NUM:
+      value = (queue_sel < num_queues) ? vq[queue_sel].num : 0;
+      break;
+    case VIRTIO_PCI_QUEUE_SEL:
+      value = queue_sel;
+      break;
+    case VIRTIO_PCI_STATUS:
+      value = status;
+      break;
+    case VIRTIO_PCI_ISR:
+      value = read_isr();
+      break;
+    default:
+      BX_DEBUG(("legacy read from offset 0x%02x returns 0", offset));
+  }
+  return value;
+}
+
+void bx_virtio_pci_c::legacy_write(unsigned offset, Bit32u value, unsigned len)
+{
+  if (offset >= VIRTIO_PCI_CONFIG) {
+    dev_config_write(offset - VIRTIO_PCI_CONFIG, value, len);
+    return;
+  }
+  switch (offset) {
+    case VIRTIO_PCI_GUEST_FEATURES:
+      guest_features = value & get_features();
+      set_features(guest_features);
+      break;
+    case VIRTIO_PCI_QUEUE_PFN:
+      if (queue_sel < num_queues) {
+        set_legacy_pfn(queue_sel, value);
+      }
+      break;
+    case VIRTIO_PCI_QUEUE_SEL:
+      queue_sel = value;
+      break;
+    case VIRTIO_PCI_QUEUE_NOTIFY:
+      if (value < num_queues) {
+        queue_notify(value);
+      }
+      break;
+    case VIRTIO_PCI_STATUS:
+      set_status(value);
+      break;
+    default:
+      BX_DEBUG(("legacy write to offset 0x%02x ignored", offset));
+  }
+}
+
+Bit32u bx_virtio_pci_c::read_handler(void *this_ptr, Bit32u address, unsigned io_len)
+{
+  bx_virtio_pci_c *class_ptr = (bx_virtio_pci_c *) this_ptr;
+
+  return class_ptr->legacy_read(address - class_ptr->pci_base_address[0], io_len);
+}
+
+void bx_virtio_pci_c::write_handler(void *this_ptr, Bit32u address, Bit32u value, unsigned io_len)
+{
+  bx_virtio_pci_c *class_ptr = (bx_virtio_pci_c *) this_ptr;
+
+  class_ptr->legacy_write(address - class_ptr->pci_base_address[0], value, io_len);
+}
+
+// modern interface
+
+Bit32u bx_virtio_pci_c::common_read(unsigned offset, unsigned len)
+{
+  bx_virtq_t *v = (queue_sel < num_queues) ? &vq[queue_sel] : NULL;
+  Bit32u value = 0;
+
+  switch (offset) {
+    case VIRTIO_PCI_COMMON_DFSELECT:
+      value = dfeature_sel;
+      break;
+    case VIRTIO_PCI_COMMON_DF:
+      if (dfeature_sel < 2) {
+        value = (Bit32u)(get_features() >> (dfeature_sel * 32));
+      }
+      break;
+    case VIRTIO_PCI_COMMON_GFSELECT:
+      value = gfeature_sel;
+      break;
+    case VIRTIO_PCI_COMMON_GF:
+      if (gfeature_sel < 2) {
+        value = (Bit32u)(guest_features >> (gfeature_sel * 32));
+      }
+      break;
+    case VIRTIO_PCI_COMMON_MSIX:
+    case VIRTIO_PCI_COMMON_Q_MSIX:
+      value = VIRTIO_MSI_NO_VECTOR;
+      break;
+    case VIRTIO_PCI_COMMON_NUMQ:
+      value = num_queues;
+      break;
+    case VIRTIO_PCI_COMMON_STATUS:
+      value = status;
+      break;
+    case VIRTIO_PCI_COMMON_CFGGEN:
+      value = config_generation;
+      break;
+    case VIRTIO_PCI_COMMON_Q_SELECT:
+      value = queue_sel;
+      break;
+    case VIRTIO_PCI_COMMON_Q_SIZE:
+      if (v != NULL) value = v->num;
+      break;
+    case VIRTIO_PCI_COMMON_Q_ENABLE:
+      if (v != NULL) value = v->enabled;
+      break;
+    case VIRTIO_PCI_COMMON_Q_NOFF:
+      value = queue_sel;
+      break;
+    case VIRTIO_PCI_COMMON_Q_DESCLO:
+      if (v != NULL) value = (Bit32u)v->desc;
+      break;
+    case VIRTIO_PCI_COMMON_Q_DESCHI:
+      if (v != NULL) value = (Bit32u)(v->desc >> 32);
+      break;
+    case VIRTIO_PCI_COMMON_Q_AVAILLO:
+      if (v != NULL) value = (Bit32u)v->avail;
+      break;
+    case VIRTIO_PCI_COMMON_Q_AVAILHI:
+      if (v != NULL) value = (Bit32u)(v->avail >> 32);
+      break;
+    case VIRTIO_PCI_COMMON_Q_USEDLO:
+      if (v != NULL) value = (Bit32u)v->used;
+      break;
+    case VIRTIO_PCI_COMMON_Q_USEDHI:
+      if (v != NULL) value = (Bit32u)(v->used >> 32);
+      break;
+    default:
+      BX_DEBUG(("common config read from offset 0x%02x returns 0", offset));
+  }
+  return value;
+}
+
+void bx_virtio_pci_c::common_write(unsigned offset, Bit32u value, unsigned len)
+{
+  bx_virtq_t *v = (queue_sel < num_queues) ? &vq[queue_sel] : NULL;
+
+  switch (offset) {
+    case VIRTIO_PCI_COMMON_DFSELECT:
+      dfeature_sel = value;
+      break;
+    case VIRTIO_PCI_COMMON_GFSELECT:
+      gfeature_sel = value;
+      break;
+    case VIRTIO_PCI_COMMON_GF:
+      if (gfeature_sel < 2) {
+        guest_features &= ~((Bit64u)0xffffffff << (gfeature_sel * 32));
+        guest_features |= ((Bit64u)value << (gfeature_sel * 32));
+        set_features(guest_features);
+      }
+      break;
+    case VIRTIO_PCI_COMMON_STATUS:
+      set_status(value);
+      break;
+    case VIRTIO_PCI_COMMON_Q_SELECT:
+      queue_sel = value;
+      break;
+    case VIRTIO_PCI_COMMON_Q_SIZE:
+      if (v != NULL) {
+        if ((value > 0) && (value <= BX_VIRTIO_QUEUE_SIZE) && !(value & (value - 1))) {
+          v->num = value;
+        } else {
+          BX_ERROR(("invalid queue size %d", value));
+        }
+      }
+      break;
+    case VIRTIO_PCI_COMMON_Q_ENABLE:
+      if (v != NULL) {
+        v->enabled = value & 1;
+        v->last_avail_idx = 0;
+        v->used_idx = 0;
+        v->signalled_used_valid = 0;
+      }
+      break;
+    case VIRTIO_PCI_COMMON_Q_DESCLO:
+      if (v != NULL) v->desc = (v->desc & BX_CONST64(0xffffffff00000000)) | value;
+      break;
+    case VIRTIO_PCI_COMMON_Q_DESCHI:
+      if (v != NULL) v->desc = (v->desc & 0xffffffff) | ((Bit64u)value << 32);
+      break;
+    case VIRTIO_PCI_COMMON_Q_AVAILLO:
+      if (v != NULL) v->avail = (v->avail & BX_CONST64(0xffffffff00000000)) | value;
+      break;
+    case VIRTIO_PCI_COMMON_Q_AVAILHI:
+      if (v != NULL) v->avail = (v->avail & 0xffffffff) | ((Bit64u)value << 32);
+      break;
+    case VIRTIO_PCI_COMMON_Q_USEDLO:
+      if (v != NULL) v->used = (v->used & BX_CONST64(0xffffffff00000000)) | value;
+      break;
+    case VIRTIO_PCI_COMMON_Q_USEDHI:
+      if (v != NULL) v->used = (v->used & 0xffffffff) | ((Bit64u)value << 32);
+      break;
+    case VIRTIO_PCI_COMMON_MSIX:
+    case VIRTIO_PCI_COMMON_Q_MSIX:
+      break;
+    default:
+      BX_DEBUG(("common config write to offset 0x%02x ignored", offset));
+  }
+}
+
+bx_bool bx_virtio_pci_c::mem_read_handler(bx_phy_address addr, unsigned len,
+                                          void *data, void *param)
+{
+  bx_virtio_pci_c *class_ptr = (bx_virtio_pci_c *) param;
+
+  return class_ptr->mem_read(addr, len, data);
+}
+
+bx_bool bx_virtio_pci_c::mem_read(bx_phy_address addr, unsigned len, void *data)
+{
+  Bit8u *data8_ptr = (Bit8u *) data;
+  Bit32u offset, value = 0;
+  unsigned i;
+
+  if (pci_rom_size > 0) {
+    Bit32u mask = (pci_rom_size - 1);
+    if ((addr & ~mask) == pci_rom_address) {
+      for (i = 0; i < len; i++) {
+        if (pci_conf[0x30] & 0x01) {
+          data8_ptr[i] = pci_rom[(addr + i) & mask];
+        } else {
+          data8_ptr[i] = 0xff;
+        }
+      }
+      return 1;
+    }
+  }
+
+  if (len > 4) {
+    // 64-bit access: split into two 32-bit accesses
+    mem_read(addr, 4, data8_ptr);
+    mem_read(addr + 4, len - 4, data8_ptr + 4);
+    return 1;
+  }
+  offset = (Bit32u)(addr - pci_base_address[1]);
+  if (offset < VIRTIO_PCI_ISR_OFFSET) {
+    value = common_read(offset, len);
+  } else if (offset < VIRTIO_PCI_DEVICE_OFFSET) {
+    if (offset == VIRTIO_PCI_ISR_OFFSET) {
+      value = read_isr();
+    }
+  } else if (offset < VIRTIO_PCI_NOTIFY_OFFSET) {
+    value = dev_config_read(offset - VIRTIO_PCI_DEVICE_OFFSET, len);
+  }
+  for (i = 0; i < len; i++) {
+    data8_ptr[i] = (Bit8u)(value >> (i * 8));
+  }
+  return 1;
+}
+
+bx_bool bx_virtio_pci_c::mem_write_handler(bx_phy_address addr, unsigned len,
+                                           void *data, void *param)
+{
+  bx_virtio_pci_c *class_ptr = (bx_virtio_pci_c *) param;
+
+  return class_ptr->mem_write(addr, len, data);
+}
+
+bx_bool bx_virtio_pci_c::mem_write(bx_phy_address addr, unsigned len, void *data)
+{
+  Bit8u *data8_ptr = (Bit8u *) data;
+  Bit32u offset, value = 0;
+  unsigned i;
+
+  if (pci_rom_size > 0) {
+    Bit32u mask = (pci_rom_size - 1);
+    if ((addr & ~mask) == pci_rom_address) {
+      BX_INFO(("write to ROM ignored (addr=0x%08x len=%d)", (Bit32u)addr, len));
+      return 1;
+    }
+  }
+
+  if (len > 4) {
+    mem_write(addr, 4, data8_ptr);
+    mem_write(addr + 4, len - 4, data8_ptr + 4);
+    return 1;
+  }
+  for (i = 0; i < len; i++) {
+    value |= (data8_ptr[i] << (i * 8));
+  }
+  offset = (Bit32u)(addr - pci_base_address[1]);
+  if (offset < VIRTIO_PCI_ISR_OFFSET) {
+    common_write(offset, value, len);
+  } else if (offset < VIRTIO_PCI_DEVICE_OFFSET) {
+    BX_DEBUG(("write to ISR ignored"));
+  } else if (offset < VIRTIO_PCI_NOTIFY_OFFSET) {
+    dev_config_write(offset - VIRTIO_PCI_DEVICE_OFFSET, value, len);
+  } else {
+    value &= 0xffff;
+    if (value < num_queues) {
+      queue_notify(value);
+    }
+  }
+  return 1;
+}
+
+// virtqueue access
+
+bx_bool bx_virtio_pci_c::vq_ready(unsigned q)
+{
+  return (q < num_queues) && vq[q].enabled && (vq[q].num > 0) &&
+         ((status & VIRTIO_STATUS_DRIVER_OK) != 0);
+}
+
+unsigned bx_virtio_pci_c::vq_avail(unsigned q)
+{
+  if (!vq_ready(q)) return 0;
+  return (Bit16u)(vring_read16(vq[q].avail + 2) - vq[q].last_avail_idx);
+}
+
+bx_bool bx_virtio_pci_c::vq_pop(unsigned q, bx_virtq_elem_t *elem)
+{
+  bx_virtq_t *v = &vq[q];
+  bx_virtio_sg_t *sg;
+  Bit8u desc[16];
+  Bit64u table, addr;
+  Bit32u len;
+  Bit16u avail_idx, flags, next, i;
+  unsigned max, count = 0;
+
+  if (!vq_ready(q)) return 0;
+  avail_idx = vring_read16(v->avail + 2);
+  if (avail_idx == v->last_avail_idx) return 0;
+  if ((Bit16u)(avail_idx - v->last_avail_idx) > v->num) {
+    BX_ERROR(("queue %d: invalid available index %d", q, avail_idx));
+    return 0;
+  }
+  i = vring_read16(v->avail + 4 + 2 * (v->last_avail_idx % v->num));
+  v->last_avail_idx++;
+  if (has_feature(VIRTIO_RING_F_EVENT_IDX)) {
+    // request a notification for the next buffer
+    vring_write16(v->used + 4 + 8 * v->num, v->last_avail_idx);
+  }
+
+  elem->index = i;
+  elem->out_num = elem->in_num = 0;
+  elem->out_len = elem->in_len = 0;
+  table = v->desc;
+  max = v->num;
+  while (1) {
+    if ((i >= max) || (++count > max)) {
+      BX_ERROR(("queue %d: invalid descriptor chain", q));
+      break;
+    }
+    DEV_MEM_READ_PHYSICAL_DMA(table + 16 * i, 16, desc);
+    ReadHostQWordFromLittleEndian(desc, addr);
+    ReadHostDWordFromLittleEndian(desc + 8, len);
+    ReadHostWordFromLittleEndian(desc + 12, flags);
+    ReadHostWordFromLittleEndian(desc + 14, next);
+    if (flags & VRING_DESC_F_INDIRECT) {
+      if ((table != v->desc) || (len < 16) || (len & 15)) {
+        BX_ERROR(("queue %d: invalid indirect descriptor", q));
+        break;
+      }
+      table = addr;
+      max = len / 16;
+      count = 0;
+      i = 0;
+      continue;
+    }
+    if (flags & VRING_DESC_F_WRITE) {
+      if (elem->in_num == BX_VIRTIO_MAX_SG) break;
+      sg = &elem->in[elem->in_num++];
+      elem->in_len += len;
+    } else {
+      if ((elem->out_num == BX_VIRTIO_MAX_SG) || (elem->in_num > 0)) {
+        BX_ERROR(("queue %d: invalid descriptor order", q));
+        break;
+      }
+      sg = &elem->out[elem->out_num++];
+      elem->out_len += len;
+    }
+    sg->addr = addr;
+    sg->len = len;
+    if (!(flags & VRING_DESC_F_NEXT)) {
+      return 1;
+    }
+    i = next;
+  }
+  // return the broken chain to the driver
+  vq_push(q, elem->index, 0);
+  return 0;
+}
+
+// return the last descriptor chains to the available ring
+void bx_virtio_pci_c::vq_unpop(unsigned q, unsigned count)
+{
+  vq[q].last_avail_idx -= count;
+}
+
+// write a used ring element without publishing it yet
+void bx_virtio_pci_c::vq_fill(unsigned q, Bit16u index, Bit32u len, unsigned pos)
+{
+  bx_virtq_t *v = &vq[q];
+  Bit8u buf[8];
+
+  WriteHostDWordToLittleEndian(buf, (Bit32u)index);
+  WriteHostDWordToLittleEndian(buf + 4, len);
+  DEV_MEM_WRITE_PHYSICAL_DMA(v->used + 4 + 8 * ((Bit16u)(v->used_idx + pos) % v->num), 8, buf);
+}
+
+// publish the filled used ring elements
+void bx_virtio_pci_c::vq_flush(unsigned q, unsigned count)
+{
+  vq[q].used_idx += count;
+  vring_write16(vq[q].used + 2, vq[q].used_idx);
+}
+
+void bx_virtio_pci_c::vq_push(unsigned q, Bit16u index, Bit32u len)
+{
+  vq_fill(q, index, len, 0);
+  vq_flush(q, 1);
+}
+
+// interrupt the driver if it asked for it
+void bx_virtio_pci_c::vq_notify(unsigned q)
+{
+  bx_virtq_t *v = &vq[q];
+  bx_bool need;
+
+  if (!vq_ready(q)) return;
+  if (has_feature(VIRTIO_RING_F_EVENT_IDX)) {
+    Bit16u old_idx = v->signalled_used;
+    bx_bool valid = v->signalled_used_valid;
+    v->signalled_used = v->used_idx;
+    v->signalled_used_valid = 1;
+    need = !valid || vring_need_event(vring_read16(v->avail + 4 + 2 * v->num),
+                                      v->used_idx, old_idx);
+  } else if (has_feature(VIRTIO_F_NOTIFY_ON_EMPTY) && (vq_avail(q) == 0)) {
+    need = 1;
+  } else {
+    need = !(vring_read16(v->avail) & VRING_AVAIL_F_NO_INTERRUPT);
+  }
+  if (need) {
+    isr |= VIRTIO_ISR_QUEUE;
+    update_irq();
+  }
+}
+
+// copy data from the device-readable part of a chain
+unsigned bx_virtio_pci_c::vq_read(const bx_virtq_elem_t *elem, unsigned offset,
+                                  void *buf, unsigned len)
+{
+  Bit8u *ptr = (Bit8u *) buf;
+  unsigned i, chunk, done = 0;
+
+  for (i = 0; (i < elem->out_num) && (done < len); i++) {
+    if (offset >= elem->out[i].len) {
+      offset -= elem->out[i].len;
+      continue;
+    }
+    chunk = elem->out[i].len - offset;
+    if (chunk > (len - done)) chunk = len - done;
+    DEV_MEM_READ_PHYSICAL_DMA(elem->out[i].addr + offset, chunk, ptr + done);
+    done += chunk;
+    offset = 0;
+  }
+  return done;
+}
+
+// copy data to the device-writable part of a chain
+unsigned bx_virtio_pci_c::vq_write_sg(const bx_virtio_sg_t *sg, unsigned num,
+                                      unsigned offset, const void *buf, unsigned len)
+{
+  Bit8u *ptr = (Bit8u *) buf;
+  unsigned i, chunk, done = 0;
+
+  for (i = 0; (i < num) && (done < len); i++) {
+    if (offset >= sg[i].len) {
+      offset -= sg[i].len;
+      continue;
+    }
+    chunk = sg[i].len - offset;
+    if (chunk > (len - done)) chunk = len - done;
+    DEV_MEM_WRITE_PHYSICAL_DMA(sg[i].addr + offset, chunk, ptr + done);
+    done += chunk;
+    offset = 0;
+  }
+  return done;
+}
+
+// pci configuration space read callback handler
+Bit32u bx_virtio_pci_c::pci_read_handler(Bit8u address, unsigned io_len)
+{
+  Bit32u value = 0;
+
+  for (unsigned i=0; i<io_len; i++) {
+    value |= (pci_conf[address+i] << (i*8));
+  }
+
+  if (io_len == 1)
+    BX_DEBUG(("read  PCI register 0x%02x value 0x%02x", address, value));
+  else if (io_len == 2)
+    BX_DEBUG(("read  PCI register 0x%02x value 0x%04x", address, value));
+  else if (io_len == 4)
+    BX_DEBUG(("read  PCI register 0x%02x value 0x%08x", address, value));
+
+  return value;
+}
+
+// pci configuration space write callback handler
+void bx_virtio_pci_c::pci_write_handler(Bit8u address, Bit32u value, unsigned io_len)
+{
+  Bit8u value8, oldval;
+  bx_bool baseaddr0_change = 0;
+  bx_bool baseaddr1_change = 0;
+  bx_bool romaddr_change = 0;
+
+  if ((address >= 0x18) && (address < 0x30))
+    return;
+
+  for (unsigned i=0; i<io_len; i++) {
+    value8 = (value >> (i*8)) & 0xFF;
+    oldval = pci_conf[address+i];
+    switch (address+i) {
+      case 0x04:
+        value8 &= 0x07;
+        break;
+      case 0x05:
+        value8 &= 0x04; // interrupt disable
+        break;
+      case 0x3c:
+        if (value8 != oldval) {
+          BX_INFO(("new irq line = %d", value8));
+        }
+        break;
+      case 0x10:
+        value8 = (value8 & 0xfc) | (oldval & 0x03);
+      case 0x11:
+      case 0x12:
+      case 0x13:
+        baseaddr0_change |= (value8 != oldval);
+        break;
+      case 0x14:
+        value8 = (value8 & 0xf0) | (oldval & 0x0f);
+      case 0x15:
+      case 0x16:
+      case 0x17:
+        baseaddr1_change |= (value8 != oldval);
+        break;
+      case 0x30:
+      case 0x31:
+      case 0x32:
+      case 0x33:
+        if (pci_rom_size > 0) {
+          if ((address+i) == 0x30) {
+            value8 &= 0x01;
+          } else if ((address+i) == 0x31) {
+            value8 &= 0xfc;
+          }
+          romaddr_change = 1;
+          break;
+        }
+      default:
+        value8 = oldval;
+    }
+    pci_conf[address+i] = value8;
+  }
+  if (baseaddr0_change) {
+    if (DEV_pci_set_base_io(this, read_handler, write_handler,
+                            &pci_base_address[0], &pci_conf[0x10],
+                            io_size, &virtio_iomask[0], plugname)) {
+      BX_INFO(("new i/o base address: 0x%04x", pci_base_address[0]));
+    }
+  }
+  if (baseaddr1_change) {
+    if (DEV_pci_set_base_mem(this, mem_read_handler, mem_write_handler,
+                             &pci_base_address[1], &pci_conf[0x14],
+                             VIRTIO_PCI_MODERN_SIZE)) {
+      BX_INFO(("new mem base address: 0x%08x", pci_base_address[1]));
+    }
+  }
+  if (romaddr_change) {
+    if (DEV_pci_set_base_mem(this, mem_read_handler, mem_write_handler,
+                             &pci_rom_address, &pci_conf[0x30], pci_rom_size)) {
+      BX_INFO(("new ROM address: 0x%08x", pci_rom_address));
+    }
+  }
+  if ((address <= 0x05) && ((address + io_len) > 0x05)) {
+    update_irq();
+  }
+
+  if (io_len == 1)
+    BX_DEBUG(("write PCI register 0x%02x value 0x%02x", address, value));
+  else if (io_len == 2)
+    BX_DEBUG(("write PCI register 0x%02x value 0x%04x", address, value));
+  else if (io_len == 4)
+    BX_DEBUG(("write PCI register 0x%02x value 0x%08x", address, value));
+}
+
+#endif // BX_SUPPORT_PCI && BX_SUPPORT_VIRTIO
@@ -0,0 +1,164 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+/////////////////////////////////////////////////////////////////////////
+
+// Virtio PCI transport (legacy and modern interface) and split virtqueues.
+// Specification: http://docs.oasis-open.org/virtio/virtio/v1.0/virtio-v1.0.html
+
+#ifndef BX_IODEV_VIRTIO_H
+#define BX_IODEV_VIRTIO_H
+
+#define BX_VIRTIO_VENDOR_ID   0x1af4
+#define BX_VIRTIO_MAX_QUEUES  17
+#define BX_VIRTIO_QUEUE_SIZE  256
+#define BX_VIRTIO_MAX_SG      BX_VIRTIO_QUEUE_SIZE
+
+// device types (also used as PCI subsystem ID)
+#define BX_VIRTIO_ID_NET    1
+#define BX_VIRTIO_ID_BLOCK  2
+
+// transport feature bits
+#define VIRTIO_F_NOTIFY_ON_EMPTY     24
+#define VIRTIO_F_ANY_LAYOUT          27
+#define VIRTIO_RING_F_INDIRECT_DESC  28
+#define VIRTIO_RING_F_EVENT_IDX      29
+#define VIRTIO_F_VERSION_1           32
+
+#define BX_VIRTIO_FEATURE(bit) ((Bit64u)1 << (bit))
+
+// device status
+#define VIRTIO_STATUS_ACKNOWLEDGE  0x01
+#define VIRTIO_STATUS_DRIVER       0x02
+#define VIRTIO_STATUS_DRIVER_OK    0x04
+#define VIRTIO_STATUS_FEATURES_OK  0x08
+#define VIRTIO_STATUS_FAILED       0x80
+
+// scatter-gather segment in guest memory
+typedef struct {
+  Bit64u addr;
+  Bit32u len;
+} bx_virtio_sg_t;
+
+// descriptor chain taken from the available ring
+typedef struct {
+  Bit16u   index;   // head descriptor
+  unsigned out_num; // device-readable segments
+  unsigned in_num;  // device-writable segments
+  Bit32u   out_len;
+  Bit32u   in_len;
+  bx_virtio_sg_t out[BX_VIRTIO_MAX_SG];
+  bx_virtio_sg_t in[BX_VIRTIO_MAX_SG];
+} bx_virtq_elem_t;
+
+typedef struct {
+  Bit16u  num;
+  bx_bool enabled;
+  Bit32u  pfn;   // legacy interface only
+  Bit64u  desc;
+  Bit64u  avail;
+  Bit64u  used;
+  Bit16u  last_avail_idx;
+  Bit16u  used_idx;
+  Bit16u  signalled_used;
+  bx_bool signalled_used_valid;
+} bx_virtq_t;
+
+class bx_virtio_pci_c : public bx_devmodel_c, public bx_pci_device_stub_c {
+public:
+  bx_virtio_pci_c();
+  virtual ~bx_virtio_pci_c();
+  virtual void reset(unsigned type);
+  virtual void after_restore_state(void);
+
+  virtual Bit32u pci_read_handler(Bit8u address, unsigned io_len);
+  virtual void   pci_write_handler(Bit8u address, Bit32u value, unsigned io_len);
+
+protected:
+  void virtio_init(const char *name, const char *descr, Bit16u type,
+                   Bit32u class_code, unsigned queues, Bit8u *config,
+                   unsigned config_len);
+  void virtio_register_state(bx_list_c *list);
+
+  // device specific part
+  virtual Bit64u get_features(void) = 0;
+  virtual void   set_features(Bit64u features) {}
+  virtual void   queue_notify(unsigned q) = 0;
+  virtual void   config_written(unsigned offset, unsigned len) {}
+  virtual void   device_reset(void) = 0;
+
+  bx_bool  has_feature(unsigned bit) {return (guest_features >> bit) & 1;}
+  bx_bool  driver_ok(void) {return (status & VIRTIO_STATUS_DRIVER_OK) != 0;}
+  void     config_changed(void);
+
+  // virtqueue access
+  bx_bool  vq_ready(unsigned q);
+  unsigned vq_avail(unsigned q);
+  bx_bool  vq_pop(unsigned q, bx_virtq_elem_t *elem);
+  void     vq_unpop(unsigned q, unsigned count);
+  void     vq_fill(unsigned q, Bit16u index, Bit32u len, unsigned pos);
+  void     vq_flush(unsigned q, unsigned count);
+  void     vq_push(unsigned q, Bit16u index, Bit32u len);
+  void     vq_notify(unsigned q);
+  unsigned vq_read(const bx_virtq_elem_t *elem, unsigned offset, void *buf, unsigned len);
+  unsigned vq_write_sg(const bx_virtio_sg_t *sg, unsigned num, unsigned offset,
+                       const void *buf, unsigned len);
+  unsigned vq_write(const bx_virtq_elem_t *elem, unsigned offset, const void *buf, unsigned len) {
+    return vq_write_sg(elem->in, elem->in_num, offset, buf, len);
+  }
+
+  Bit8u  devfunc;
+  Bit64u guest_features;
+  Bit8u  status;
+  unsigned num_queues;
+
+private:
+  void   virtio_reset(void);
+  void   set_status(Bit8u value);
+  void   update_irq(void);
+  void   set_legacy_pfn(unsigned q, Bit32u pfn);
+  Bit8u  read_isr(void);
+  Bit32u dev_config_read(unsigned offset, unsigned len);
+  void   dev_config_write(unsigned offset, Bit32u value, unsigned len);
+  Bit32u common_read(unsigned offset, unsigned len);
+  void   common_write(unsigned offset, Bit32u value, unsigned len);
+  Bit32u legacy_read(unsigned offset, unsigned len);
+  void   legacy_write(unsigned offset, Bit32u value, unsigned len);
+  void   add_cap(Bit8u pos, Bit8u next, Bit8u type, Bit32u offset, Bit32u len);
+
+  static Bit32u read_handler(void *this_ptr, Bit32u address, unsigned io_len);
+  static void   write_handler(void *this_ptr, Bit32u address, Bit32u value, unsigned io_len);
+  static bx_bool mem_read_handler(bx_phy_address addr, unsigned len, void *data, void *param);
+  static bx_bool mem_write_handler(bx_phy_address addr, unsigned len, void *data, void *param);
+  bx_bool mem_read(bx_phy_address addr, unsigned len, void *data);
+  bx_bool mem_write(bx_phy_address addr, unsigned len, void *data);
+
+  const char *plugname;
+  Bit8u  isr;
+  Bit8u  config_generation;
+  Bit16u queue_sel;
+  Bit32u dfeature_sel;
+  Bit32u gfeature_sel;
+  Bit8u  *config;
+  unsigned config_len;
+  unsigned io_size;
+  bx_virtq_t vq[BX_VIRTIO_MAX_QUEUES];
+};
+
+#endif
@@ -0,0 +1,459 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+/////////////////////////////////////////////////////////////////////////
+
+// Virtio block device (paravirtual disk). The disk image is accessed with
+// the same backends as the ATA hard disks. All requests available in a
+// queue are handled at once and completed with a single interrupt.
+
+// Define BX_PLUGGABLE in files that can be compiled into plugins.  For
+// platforms that require a special tag on exported symbols, BX_PLUGGABLE
+// is used to know when we are exporting symbols and when we are importing.
+#define BX_PLUGGABLE
+
+#include "iodev.h"
+#if BX_SUPPORT_PCI && BX_SUPPORT_VIRTIO_BLK
+
+#include "pci.h"
+#include "virtio.h"
+#include "virtio_blk.h"
+#include "hdimage/hdimage.h"
+
+#define LOG_THIS theVirtioBlkDevice->
+
+bx_virtio_blk_c* theVirtioBlkDevice = NULL;
+
+// feature bits
+#define VIRTIO_BLK_F_SEG_MAX   2
+#define VIRTIO_BLK_F_GEOMETRY  4
+#define VIRTIO_BLK_F_RO        5
+#define VIRTIO_BLK_F_BLK_SIZE  6
+#define VIRTIO_BLK_F_FLUSH     9
+#define VIRTIO_BLK_F_MQ        12
+#define VIRTIO_BLK_F_DISCARD   13
+
+// request types
+#define VIRTIO_BLK_T_IN        0
+#define VIRTIO_BLK_T_OUT       1
+#define VIRTIO_BLK_T_FLUSH     4
+#define VIRTIO_BLK_T_GET_ID    8
+#define VIRTIO_BLK_T_DISCARD   11
+
+#define VIRTIO_BLK_S_OK        0
+#define VIRTIO_BLK_S_IOERR     1
+#define VIRTIO_BLK_S_UNSUPP    2
+
+#define VIRTIO_BLK_ID_BYTES    20
+
+#define VIRTIO_BLK_MAX_DISCARD_SECTORS 0x400000
+#define VIRTIO_BLK_MAX_DISCARD_SEG     32
+
+// builtin configuration handling functions
+
+void virtio_blk_init_options(void)
+{
+  bx_param_c *ata = SIM->get_param("ata");
+  bx_list_c *menu = new bx_list_c(ata, "virtio_blk", "Virtio block device");
+  menu->set_options(menu->SHOW_PARENT);
+  bx_param_bool_c *enabled = new bx_param_bool_c(menu,
+    "enabled",
+    "Enable virtio block device emulation",
+    "Enables the paravirtual virtio block device emulation",
+    0);
+  bx_param_filename_c *path = new bx_param_filename_c(menu,
+    "path",
+    "Path of the disk image",
+    "Pathname of the disk image",
+    "", BX_PATHNAME_LEN);
+  path->set_extension("img");
+  bx_param_enum_c *mode = new bx_param_enum_c(menu,
+    "mode",
+    "Type of disk image",
+    "Mode of the disk image",
+    hdimage_mode_names,
+    BX_HDIMAGE_MODE_FLAT,
+    BX_HDIMAGE_MODE_FLAT);
+  bx_param_filename_c *journal = new bx_param_filename_c(menu,
+    "journal",
+    "Path of journal file",
+    "Pathname of the journal file",
+    "", BX_PATHNAME_LEN);
+  bx_list_c *deplist = new bx_list_c(NULL);
+  deplist->add(journal);
+  mode->set_dependent_list(deplist, 0);
+  mode->set_dependent_bitmap(BX_HDIMAGE_MODE_UNDOABLE, 1);
+  mode->set_dependent_bitmap(BX_HDIMAGE_MODE_VOLATILE, 1);
+  mode->set_dependent_bitmap(BX_HDIMAGE_MODE_VVFAT, 1);
+  new bx_param_num_c(menu,
+    "queues",
+    "Request queues",
+    "Number of request queues",
+    1, BX_VIRTIO_BLK_MAX_QUEUES,
+    1);
+  enabled->set_dependent_list(menu->clone());
+}
+
+Bit32s virtio_blk_options_parser(const char *context, int num_params, char *params[])
+{
+  if (!strcmp(params[0], "virtio_blk")) {
+    bx_list_c *base = (bx_list_c*) SIM->get_param(BXPN_VIRTIO_BLK);
+    for (int i = 1; i < num_params; i++) {
+      if (SIM->parse_param_from_list(context, params[i], base) < 0) {
+        BX_ERROR(("%s: unknown parameter for virtio_blk ignored.", context));
+      }
+    }
+  } else {
+    BX_PANIC(("%s: unknown directive '%s'", context, params[0]));
+  }
+  return 0;
+}
+
+Bit32s virtio_blk_options_save(FILE *fp)
+{
+  return SIM->write_param_list(fp, (bx_list_c*) SIM->get_param(BXPN_VIRTIO_BLK), NULL, 0);
+}
+
+// device plugin entry points
+
+int libvirtio_blk_LTX_plugin_init(plugin_t *plugin, plugintype_t type, int argc, char *argv[])
+{
+  theVirtioBlkDevice = new bx_virtio_blk_c();
+  BX_REGISTER_DEVICE_DEVMODEL(plugin, type, theVirtioBlkDevice, BX_PLUGIN_VIRTIO_BLK);
+  // add new configuration parameter for the config interface
+  virtio_blk_init_options();
+  // register add-on option for bochsrc and command line
+  SIM->register_addon_option("virtio_blk", virtio_blk_options_parser, virtio_blk_options_save);
+  return 0; // Success
+}
+
+void libvirtio_blk_LTX_plugin_fini(void)
+{
+  SIM->unregister_addon_option("virtio_blk");
+  bx_list_c *menu = (bx_list_c*)SIM->get_param("ata");
+  menu->remove("virtio_blk");
+  delete theVirtioBlkDevice;
+}
+
+// the device object
+
+bx_virtio_blk_c::bx_virtio_blk_c()
+{
+  put("VBLK");
+  hdimage = NULL;
+  sectors = 0;
+  host_features = 0;
+  read_only = 0;
+  multi_sector = 0;
+  pending = 0;
+  statusbar_id = -1;
+  memset(config, 0, sizeof(config));
+  buffer = NULL;
+}
+
+bx_virtio_blk_c::~bx_virtio_blk_c()
+{
+  if (hdimage != NULL) {
+    hdimage->close();
+    delete hdimage;
+  }
+  if (buffer != NULL) {
+    delete [] buffer;
+  }
+  SIM->get_bochs_root()->remove("virtio_blk");
+  BX_DEBUG(("Exit"));
+}
+
+void bx_virtio_blk_c::init(void)
+{
+  unsigned queues;
+  int mode;
+  const char *path;
+
+  bx_list_c *base = (bx_list_c*) SIM->get_param(BXPN_VIRTIO_BLK);
+  // Check if the device is disabled or not configured
+  if (!SIM->get_param_bool("enabled", base)->get()) {
+    BX_INFO(("virtio-blk disabled"));
+    // mark unused plugin for removal
+    ((bx_param_bool_c*)((bx_list_c*)SIM->get_param(BXPN_PLUGIN_CTRL))->get_by_name("virtio_blk"))->set(0);
+    return;
+  }
+  path = SIM->get_param_string("path", base)->getptr();
+  mode = SIM->get_param_enum("mode", base)->get();
+  queues = SIM->get_param_num("queues", base)->get();
+
+  hdimage = DEV_hdimage_init_image(mode, 0, SIM->get_param_string("journal", base)->getptr());
+  if (hdimage == NULL) {
+    return;
+  }
+  if (hdimage->open(path) < 0) {
+    BX_PANIC(("could not open disk image file '%s'", path));
+    return;
+  }
+  sectors = hdimage->hd_size / 512;
+  read_only = (hdimage->get_capabilities() & HDIMAGE_READONLY) != 0;
+  // the other backends expect sector sized transfers
+  multi_sector = (mode == BX_HDIMAGE_MODE_FLAT);
+  buffer = new Bit8u[BX_VIRTIO_BLK_BUFSIZE];
+
+  host_features = BX_VIRTIO_FEATURE(VIRTIO_BLK_F_SEG_MAX) |
+                  BX_VIRTIO_FEATURE(VIRTIO_BLK_F_BLK_SIZE) |
+                  BX_VIRTIO_FEATURE(VIRTIO_BLK_F_FLUSH) |
+                  BX_VIRTIO_FEATURE(VIRTIO_BLK_F_DISCARD) |
+                  BX_VIRTIO_FEATURE(VIRTIO_F_ANY_LAYOUT) |
+                  BX_VIRTIO_FEATURE(VIRTIO_RING_F_INDIRECT_DESC) |
+                  BX_VIRTIO_FEATURE(VIRTIO_RING_F_EVENT_IDX) |
+                  BX_VIRTIO_FEATURE(VIRTIO_F_VERSION_1);
+  if (read_only) {
+    host_features |= BX_VIRTIO_FEATURE(VIRTIO_BLK_F_RO);
+  }
+  if (queues > 1) {
+    host_features |= BX_VIRTIO_FEATURE(VIRTIO_BLK_F_MQ);
+  }
+
+  // device configuration (struct virtio_blk_config)
+  WriteHostQWordToLittleEndian(&config[0], sectors);
+  WriteHostDWordToLittleEndian(&config[12], BX_VIRTIO_MAX_SG - 2);
+  if ((hdimage->get_capabilities() & HDIMAGE_HAS_GEOMETRY) &&
+      (hdimage->cylinders > 0) && (hdimage->cylinders <= 0xffff)) {
+    host_features |= BX_VIRTIO_FEATURE(VIRTIO_BLK_F_GEOMETRY);
+    WriteHostWordToLittleEndian(&config[16], hdimage->cylinders);
+    config[18] = hdimage->heads;
+    config[19] = hdimage->spt;
+  }
+  WriteHostDWordToLittleEndian(&config[20], 512);
+  WriteHostWordToLittleEndian(&config[34], queues);
+  WriteHostDWordToLittleEndian(&config[36], VIRTIO_BLK_MAX_DISCARD_SECTORS);
+  WriteHostDWordToLittleEndian(&config[40], VIRTIO_BLK_MAX_DISCARD_SEG);
+  WriteHostDWordToLittleEndian(&config[44], 8);
+
+  virtio_init(BX_PLUGIN_VIRTIO_BLK, "Virtio block device", BX_VIRTIO_ID_BLOCK,
+              0x010000, queues, config, sizeof(config));
+
+  statusbar_id = bx_gui->register_statusitem("VBLK", 1);
+
+  BX_INFO(("virtio-blk: '%s', '%s' mode, " FMT_LL "u sectors, %d queue%s", path,
+           hdimage_mode_names[mode], sectors, queues, (queues > 1) ? "s" : ""));
+}
+
+void bx_virtio_blk_c::register_state(void)
+{
+  bx_list_c *list = new bx_list_c(SIM->get_bochs_root(), "virtio_blk", "Virtio block device State");
+  virtio_register_state(list);
+  if (hdimage != NULL) {
+    hdimage->register_state(list);
+  }
+}
+
+void bx_virtio_blk_c::queue_notify(unsigned q)
+{
+  Bit32u len;
+  Bit8u status;
+  unsigned count = 0, total = 0;
+
+  pending = vq_avail(q);
+  while (vq_pop(q, &elem)) {
+    if (pending > 0) pending--;
+    if (elem.in_len == 0) {
+      BX_ERROR(("request without status byte"));
+      len = 0;
+    } else {
+      status = handle_request(&len);
+      vq_write(&elem, elem.in_len - 1, &status, 1);
+    }
+    vq_fill(q, elem.index, len, count);
+    total++;
+    if (++count == BX_VIRTIO_QUEUE_SIZE) {
+      vq_flush(q, count);
+      count = 0;
+    }
+  }
+  if (count > 0) {
+    vq_flush(q, count);
+  }
+  if (total > 0) {
+    vq_notify(q);
+  }
+}
+
+// returns the status and the number of bytes written to the request
+// (including the status byte) in in_len
+Bit8u bx_virtio_blk_c::handle_request(Bit32u *in_len)
+{
+  Bit8u hdr[16], id[VIRTIO_BLK_ID_BYTES];
+  Bit32u type, len;
+  Bit64u sector;
+  Bit8u status;
+
+  *in_len = elem.in_len;
+  if (vq_read(&elem, 0, hdr, 16) < 16) {
+    BX_ERROR(("request header too short"));
+    return VIRTIO_BLK_S_IOERR;
+  }
+  ReadHostDWordFromLittleEndian(&hdr[0], type);
+  ReadHostQWordFromLittleEndian(&hdr[8], sector);
+  switch (type) {
+    case VIRTIO_BLK_T_IN:
+      len = elem.in_len - 1;
+      status = rw_sectors(0, sector, len);
+      if (status != VIRTIO_BLK_S_OK) {
+        *in_len = 1;
+      }
+      break;
+    case VIRTIO_BLK_T_OUT:
+      *in_len = 1;
+      status = rw_sectors(1, sector, elem.out_len - 16);
+      break;
+    case VIRTIO_BLK_T_FLUSH:
+      *in_len = 1;
+      status = flush();
+      break;
+    case VIRTIO_BLK_T_GET_ID:
+      memset(id, 0, sizeof(id));
+      strncpy((char*)id, "BXVIRTIO0001", VIRTIO_BLK_ID_BYTES);
+      len = elem.in_len - 1;
+      if (len > VIRTIO_BLK_ID_BYTES) len = VIRTIO_BLK_ID_BYTES;
+      vq_write(&elem, 0, id, len);
+      *in_len = len + 1;
+      status = VIRTIO_BLK_S_OK;
+      break;
+    case VIRTIO_BLK_T_DISCARD:
+      *in_len = 1;
+      status = discard();
+      break;
+    default:
+      BX_DEBUG(("unsupported request type %d", type));
+      *in_len = 1;
+      status = VIRTIO_BLK_S_UNSUPP;
+  }
+  return status;
+}
+
+Bit8u bx_virtio_blk_c::rw_sectors(bx_bool write, Bit64u sector, Bit32u len)
+{
+  Bit64u start_time = DISK_TRACE_TIME();
+  Bit32u done = 0, chunk, count = len / 512;
+
+  if ((len % 512) != 0) {
+    BX_ERROR(("transfer size %d is not a multiple of 512", len));
+    return VIRTIO_BLK_S_IOERR;
+  }
+  if ((sector > sectors) || (count > (sectors - sector))) {
+    BX_ERROR(("request beyond end of disk (sector " FMT_LL "u, count %d)", sector, count));
+    return VIRTIO_BLK_S_IOERR;
+  }
+  if (write && read_only) {
+    return VIRTIO_BLK_S_IOERR;
+  }
+  if (hdimage->lseek(sector * 512, SEEK_SET) < 0) {
+    BX_ERROR(("could not lseek() disk image file"));
+    return VIRTIO_BLK_S_IOERR;
+  }
+  while (done < len) {
+    chunk = len - done;
+    if (chunk > BX_VIRTIO_BLK_BUFSIZE) chunk = BX_VIRTIO_BLK_BUFSIZE;
+    if (write) {
+      vq_read(&elem, 16 + done, buffer, chunk);
+      if (!image_io(1, buffer, chunk)) {
+        BX_ERROR(("could not write() disk image file"));
+        return VIRTIO_BLK_S_IOERR;
+      }
+    } else {
+      if (!image_io(0, buffer, chunk)) {
+        BX_ERROR(("could not read() disk image file"));
+        return VIRTIO_BLK_S_IOERR;
+      }
+      vq_write(&elem, done, buffer, chunk);
+    }
+    done += chunk;
+  }
+  trace(write ? DISK_TRACE_WRITE : DISK_TRACE_READ, sector, count, start_time);
+  bx_gui->statusbar_setitem(statusbar_id, 1, write);
+  return VIRTIO_BLK_S_OK;
+}
+
+bx_bool bx_virtio_blk_c::image_io(bx_bool write, Bit8u *buf, unsigned len)
+{
+  unsigned n = multi_sector ? len : 512;
+  ssize_t ret;
+
+  for (unsigned i = 0; i < len; i += n) {
+    if (write) {
+      ret = hdimage->write(buf + i, n);
+    } else {
+      ret = hdimage->read(buf + i, n);
+    }
+    if (ret < (ssize_t)n) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+Bit8u bx_virtio_blk_c::flush(void)
+{
+  Bit64u start_time = DISK_TRACE_TIME();
+
+  if (hdimage->flush() < 0) {
+    BX_ERROR(("could not flush disk image file"));
+    return VIRTIO_BLK_S_IOERR;
+  }
+  trace(DISK_TRACE_FLUSH, 0, 0, start_time);
+  return VIRTIO_BLK_S_OK;
+}
+
+Bit8u bx_virtio_blk_c::discard(void)
+{
+  Bit8u seg[16];
+  Bit64u sector;
+  Bit32u count, flags;
+
+  if (read_only) {
+    return VIRTIO_BLK_S_IOERR;
+  }
+  for (Bit32u offset = 16; (offset + 16) <= elem.out_len; offset += 16) {
+    vq_read(&elem, offset, seg, 16);
+    ReadHostQWordFromLittleEndian(&seg[0], sector);
+    ReadHostDWordFromLittleEndian(&seg[8], count);
+    ReadHostDWordFromLittleEndian(&seg[12], flags);
+    if (flags != 0) {
+      return VIRTIO_BLK_S_UNSUPP;
+    }
+    if ((sector > sectors) || (count > (sectors - sector))) {
+      BX_ERROR(("discard beyond end of disk (sector " FMT_LL "u, count %d)", sector, count));
+      return VIRTIO_BLK_S_IOERR;
+    }
+    if (hdimage->discard(sector * 512, (Bit64u)count * 512) < 0) {
+      BX_ERROR(("could not discard sectors of disk image file"));
+      return VIRTIO_BLK_S_IOERR;
+    }
+  }
+  return VIRTIO_BLK_S_OK;
+}
+
+void bx_virtio_blk_c::trace(Bit8u type, Bit64u sector, Bit32u count, Bit64u start_time)
+{
+  if (DEV_hdimage_trace_enabled()) {
+    DEV_hdimage_trace_request(DISK_TRACE_DEV_VIRTIO, type, sector, count,
+                              (Bit32u)(DISK_TRACE_TIME() - start_time),
+                              (pending < 255) ? (Bit8u)(pending + 1) : 255);
+  }
+}
+
+#endif // BX_SUPPORT_PCI && BX_SUPPORT_VIRTIO_BLK
@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////
+// $Id$
+/////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014  The Bochs Project
+//
+//  This library is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU Lesser General Public
+//  License as published by the Free Software Foundation; either
+//  version 2 of the License, or (at your option) any later version.
+//
+//  This library is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//  Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with this library; if not, write to the Free Software
+//  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef BX_IODEV_VIRTIO_BLK_H
+#define BX_IODEV_VIRTIO_BLK_H
+
+#define BX_VIRTIO_BLK_MAX_QUEUES 8
+#define BX_VIRTIO_BLK_BUFSIZE    0x10000 // max. data moved per backend access
+#define BX_VIRTIO_BLK_CONFIG_LEN 60
+
+class device_image_t;
+
+class bx_virtio_blk_c : public bx_virtio_pci_c {
+public:
+  bx_virtio_blk_c();
+  virtual ~bx_virtio_blk_c();
+  virtual void init(void);
+  virtual void register_state(void);
+
+protected:
+  virtual Bit64u get_features(void) {return host_features;}
+  virtual void   queue_notify(unsigned q);
+  virtual void   device_reset(void) {}
+
+private:
+  Bit8u  handle_request(Bit32u *in_len);
+  Bit8u  rw_sectors(bx_bool write, Bit64u sector, Bit32u len);
+  Bit8u  flush(void);
+  Bit8u  discard(void);
+  bx_bool image_io(bx_bool write, Bit8u *buf, unsigned len);
+  void   trace(Bit8u type, Bit64u sector, Bit32u count, Bit64u start_time);
+
+  device_image_t *hdimage;
+  Bit64u   sectors;
+  Bit64u   host_features;
+  bx_bool  read_only;
+  bx_bool  multi_sector; // backend accepts transfers > 512 bytes
+  unsigned pending;      // requests still waiting in the queue
+  int      statusbar_id;
+  Bit8u    config[BX_VIRTIO_BLK_CONFIG_LEN];
+  Bit8u    *buffer;
+
+  bx_virtq_elem_t elem;
+};
+
+#endif
@@ -587,6 +587,15 @@ int bx_init_main(int argc, char *argv[])
 #if BX_SUPPORT_E1000
           fprintf(stderr, "e1000\n");
 #endif
+#if BX_SUPPORT_VIRTIO_NET
+          fprintf(stderr, "virtio_net\n");
+#endif
+#if BX_SUPPORT_VIRTIO_BLK
+          fprintf(stderr, "virtio_blk\n");
+#endif
+#if BX_SUPPORT_AHCI
+          fprintf(stderr, "ahci\n");
+#endif
 #if BX_SUPPORT_SB16
           fprintf(stderr, "sb16\n");
 #endif
@@ -885,6 +894,10 @@ bx_bool load_and_init_display_lib(void)
   if (!strcmp(gui_name, "amigaos"))
     PLUG_load_plugin (amigaos, PLUGTYPE_OPTIONAL);
 #endif
+#if BX_WITH_CAPTURE
+  if (!strcmp(gui_name, "capture"))
+    PLUG_load_plugin (capture, PLUGTYPE_OPTIONAL);
+#endif
 #if BX_WITH_CARBON
   if (!strcmp(gui_name, "carbon"))
     PLUG_load_plugin (carbon, PLUGTYPE_OPTIONAL);
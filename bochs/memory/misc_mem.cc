@@ -858,7 +858,7 @@ BX_MEM_C::registerMemoryHandlers(void *param, memory_handler_t read_handler,
   bx_bool
 BX_MEM_C::unregisterMemoryHandlers(void *param, bx_phy_address begin_addr, bx_phy_address end_addr)
 {
-  bx_bool ret = 1;
+  bx_bool ret = 1, flush = 0;
   BX_INFO(("Memory access handlers unregistered: 0x" FMT_PHY_ADDRX " - 0x" FMT_PHY_ADDRX, begin_addr, end_addr));
   for (Bit32u page_idx = (Bit32u)(begin_addr >> 20); page_idx <= (Bit32u)(end_addr >> 20); page_idx++) {
     struct memory_handler_struct *memory_handler = BX_MEM_THIS memory_handlers[page_idx];
@@ -879,8 +879,13 @@ BX_MEM_C::unregisterMemoryHandlers(void *param, bx_phy_address begin_addr, bx_ph
       prev->next = memory_handler->next;
     else
       BX_MEM_THIS memory_handlers[page_idx] = memory_handler->next;
+    if (memory_handler->da_handler)
+      flush = 1;
     delete memory_handler;
   }
+  // drop the host pointers handed out by the direct access handler
+  if (flush)
+    bx_pc_system.MemoryMappingChanged();
   return ret;
 }
 
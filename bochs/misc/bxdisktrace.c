@@ -0,0 +1,225 @@
+/*
+ * $Id$
+ *
+ *  Copyright (C) 2014  The Bochs Project
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Summarizes a disk I/O trace file written by Bochs (option 'disk_trace'). */
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "config.h"
+
+#include "../osdep.h"
+#include "bswap.h"
+
+#define HDIMAGE_HEADERS_ONLY 1
+#include "../iodev/hdimage/hdimage.h"
+
+#define MAX_DEVICES 256
+#define HIST_SLOTS  24
+
+typedef struct {
+  Bit64u requests[3];
+  Bit64u sectors[3];
+  Bit64u sequential;
+  Bit64u next_lba;
+  Bit64u latency_sum;
+  Bit64u size_hist[HIST_SLOTS];
+  Bit64u latency_hist[HIST_SLOTS];
+  Bit64u depth_hist[HIST_SLOTS];
+  Bit64u first_time;
+  Bit64u last_time;
+} trace_stats_t;
+
+trace_stats_t stats[MAX_DEVICES];
+int bx_device = -1;
+char bx_trace_filename[512];
+
+const char *type_names[3] = {"read", "write", "flush"};
+
+void print_usage()
+{
+  fprintf(stderr,
+    "Usage: bxdisktrace [options] [trace filename]\n\n"
+    "Supported options:\n"
+    "  -d=N    only show device N (ATA: channel * 2 + drive, SCSI: 128, virtio: 129,\n"
+    "          AHCI: 144 + port)\n"
+    "  --help  display this help and exit\n\n");
+}
+
+int parse_cmdline(int argc, char *argv[])
+{
+  int arg = 1;
+  int ret = 1;
+
+  bx_trace_filename[0] = 0;
+  while ((arg < argc) && (ret == 1)) {
+    if (!strcmp("--help", argv[arg]) || !strncmp("/?", argv[arg], 2)) {
+      print_usage();
+      ret = 0;
+    } else if (!strncmp("-d=", argv[arg], 3)) {
+      bx_device = atoi(&argv[arg][3]);
+    } else if (argv[arg][0] == '-') {
+      printf("Unknown option: %s\n\n", argv[arg]);
+      ret = 0;
+    } else {
+      strncpy(bx_trace_filename, argv[arg], sizeof(bx_trace_filename) - 1);
+    }
+    arg++;
+  }
+  if ((ret == 1) && (bx_trace_filename[0] == 0)) {
+    print_usage();
+    ret = 0;
+  }
+  return ret;
+}
+
+/* returns the index of the power of 2 range [2^(i-1), 2^i) containing value */
+int hist_slot(Bit64u value)
+{
+  int slot = 0;
+
+  while ((value > 0) && (slot < (HIST_SLOTS - 1))) {
+    value >>= 1;
+    slot++;
+  }
+  return slot;
+}
+
+void print_hist(const char *title, const char *unit, Bit64u *hist, Bit64u total)
+{
+  int i, j, bar;
+  Bit64u lo, hi;
+
+  if (total == 0) return;
+  printf("  %s:\n", title);
+  for (i = 0; i < HIST_SLOTS; i++) {
+    if (hist[i] == 0) continue;
+    lo = (i > 0) ? ((Bit64u)1 << (i - 1)) : 0;
+    hi = ((Bit64u)1 << i) - 1;
+    bar = (int)(hist[i] * 40 / total);
+    printf("    %8lu - %-8lu %-5s %10lu  %5.1f%% ", (unsigned long)lo,
+           (unsigned long)hi, unit, (unsigned long)hist[i], hist[i] * 100.0 / total);
+    for (j = 0; j < bar; j++) putchar('#');
+    putchar('\n');
+  }
+}
+
+void print_stats(int dev, trace_stats_t *s)
+{
+  Bit64u rw = s->requests[DISK_TRACE_READ] + s->requests[DISK_TRACE_WRITE];
+  Bit64u total = rw + s->requests[DISK_TRACE_FLUSH];
+  int i;
+
+  if (dev == DISK_TRACE_DEV_SCSI) {
+    printf("\nDevice %d (SCSI/USB disk)\n", dev);
+  } else if (dev == DISK_TRACE_DEV_VIRTIO) {
+    printf("\nDevice %d (virtio disk)\n", dev);
+  } else if ((dev >= DISK_TRACE_DEV_AHCI) && (dev < (DISK_TRACE_DEV_AHCI + 32))) {
+    printf("\nDevice %d (AHCI port %d)\n", dev, dev - DISK_TRACE_DEV_AHCI);
+  } else {
+    printf("\nDevice %d (ata%d-%s)\n", dev, dev >> 1, (dev & 1) ? "slave" : "master");
+  }
+  printf("  duration: %.3f s (emulated)\n", (s->last_time - s->first_time) / 1000000.0);
+  for (i = 0; i < 3; i++) {
+    printf("  %-6s %10lu requests", type_names[i], (unsigned long)s->requests[i]);
+    if (i != DISK_TRACE_FLUSH) {
+      printf(", %10lu sectors (%.1f MB)", (unsigned long)s->sectors[i], s->sectors[i] / 2048.0);
+    }
+    putchar('\n');
+  }
+  if (rw > 0) {
+    printf("  sequential: %.1f%%, random: %.1f%%\n", s->sequential * 100.0 / rw,
+           (rw - s->sequential) * 100.0 / rw);
+  }
+  if (total > 0) {
+    printf("  average backend latency: %.1f usec\n", (double)s->latency_sum / total);
+  }
+  print_hist("request size", "sect", s->size_hist, rw);
+  print_hist("backend latency", "usec", s->latency_hist, total);
+  print_hist("queue depth", "", s->depth_hist, total);
+}
+
+int CDECL main(int argc, char *argv[])
+{
+  FILE *fp;
+  disk_trace_header_t header;
+  disk_trace_record_t rec;
+  trace_stats_t *s;
+  Bit64u lba, count = 0;
+  Bit32u sectors, latency;
+  int dev;
+
+  if (!parse_cmdline(argc, argv))
+    exit(1);
+
+  fp = fopen(bx_trace_filename, "rb");
+  if (fp == NULL) {
+    fprintf(stderr, "Cannot open trace file '%s'\n", bx_trace_filename);
+    exit(1);
+  }
+  if ((fread(&header, sizeof(header), 1, fp) != 1) ||
+      (memcmp(header.magic, DISK_TRACE_MAGIC, 8) != 0)) {
+    fprintf(stderr, "'%s' is not a Bochs disk trace file\n", bx_trace_filename);
+    exit(1);
+  }
+  if ((dtoh32(header.version) != DISK_TRACE_VERSION) ||
+      (dtoh32(header.record_size) != sizeof(disk_trace_record_t))) {
+    fprintf(stderr, "Unsupported disk trace file version\n");
+    exit(1);
+  }
+  memset(stats, 0, sizeof(stats));
+  while (fread(&rec, sizeof(rec), 1, fp) == 1) {
+    dev = rec.device;
+    if ((rec.type > DISK_TRACE_FLUSH) || ((bx_device >= 0) && (dev != bx_device)))
+      continue;
+    s = &stats[dev];
+    lba = dtoh64(rec.lba);
+    sectors = dtoh32(rec.sectors);
+    latency = dtoh32(rec.latency);
+    if ((s->requests[0] + s->requests[1] + s->requests[2]) == 0) {
+      s->first_time = dtoh64(rec.time);
+    }
+    s->last_time = dtoh64(rec.time);
+    s->requests[rec.type]++;
+    s->latency_sum += latency;
+    s->latency_hist[hist_slot(latency)]++;
+    s->depth_hist[hist_slot(rec.queue_depth)]++;
+    if (rec.type != DISK_TRACE_FLUSH) {
+      s->sectors[rec.type] += sectors;
+      s->size_hist[hist_slot(sectors)]++;
+      if (lba == s->next_lba) {
+        s->sequential++;
+      }
+      s->next_lba = lba + sectors;
+    }
+    count++;
+  }
+  fclose(fp);
+
+  printf("%lu records in '%s'\n", (unsigned long)count, bx_trace_filename);
+  for (dev = 0; dev < MAX_DEVICES; dev++) {
+    s = &stats[dev];
+    if ((s->requests[0] + s->requests[1] + s->requests[2]) > 0) {
+      print_stats(dev, s);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,216 @@
+/*
+ * $Id$
+ *
+ *  Copyright (C) 2014  The Bochs Project
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/* Checks the pixel conversion kernels (gui/pixconv.cc) supported by the host
+ * CPU against the generic C versions and measures their throughput.
+ * Build with 'make bxpixbench'. */
+
+#include "bochs.h"
+#include "gui/pixconv.h"
+#include <time.h>
+
+#define ROW_PIXELS 1024
+
+Bit8u  src[ROW_PIXELS * 2 + 16];
+Bit32u lut[256];
+Bit8u  planes[4][ROW_PIXELS];
+Bit8u  attr_map[16];
+Bit32u ref32[ROW_PIXELS], out32[ROW_PIXELS];
+Bit8u  ref8[ROW_PIXELS * 8], out8[ROW_PIXELS * 8];
+Bit8u *plane[4] = {planes[0], planes[1], planes[2], planes[3]};
+bx_pixconv_rgb16_t fmt15, fmt16;
+
+int bx_iterations = 20000;
+int bx_check_only = 0;
+
+void print_usage()
+{
+  fprintf(stderr,
+    "Usage: bxpixbench [options]\n\n"
+    "Supported options:\n"
+    "  -n=N     number of row conversions per kernel (default: 20000)\n"
+    "  --check  only check the kernels against the generic versions\n"
+    "  --help   display this help and exit\n\n");
+}
+
+int parse_cmdline(int argc, char *argv[])
+{
+  int arg = 1;
+  int ret = 1;
+
+  while ((arg < argc) && (ret == 1)) {
+    if (!strcmp("--help", argv[arg]) || !strncmp("/?", argv[arg], 2)) {
+      print_usage();
+      ret = 0;
+    } else if (!strncmp("-n=", argv[arg], 3)) {
+      bx_iterations = atoi(&argv[arg][3]);
+      if (bx_iterations < 1) bx_iterations = 1;
+    } else if (!strcmp("--check", argv[arg])) {
+      bx_check_only = 1;
+    } else {
+      printf("Unknown option: %s\n\n", argv[arg]);
+      print_usage();
+      ret = 0;
+    }
+    arg++;
+  }
+  return ret;
+}
+
+/* simple LCG, so that every run converts the same data */
+Bit32u next_random(void)
+{
+  static Bit32u seed = 1;
+
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+void init_data(void)
+{
+  bx_svga_tileinfo_t info;
+  unsigned i;
+
+  for (i = 0; i < sizeof(src); i++) src[i] = (Bit8u)next_random();
+  for (i = 0; i < 256; i++) lut[i] = next_random() ^ (next_random() << 16);
+  for (i = 0; i < ROW_PIXELS; i++) {
+    planes[0][i] = (Bit8u)next_random();
+    planes[1][i] = (Bit8u)next_random();
+    planes[2][i] = (Bit8u)next_random();
+    planes[3][i] = (Bit8u)next_random();
+  }
+  for (i = 0; i < 16; i++) attr_map[i] = (Bit8u)next_random();
+  // 32 bpp xRGB host display
+  memset(&info, 0, sizeof(info));
+  info.red_shift = 24;
+  info.green_shift = 16;
+  info.blue_shift = 8;
+  info.red_mask = 0xff0000;
+  info.green_mask = 0x00ff00;
+  info.blue_mask = 0x0000ff;
+  bx_pixconv_rgb16_init(&fmt15, 15, &info);
+  bx_pixconv_rgb16_init(&fmt16, 16, &info);
+}
+
+/* returns the number of mismatches of 'conv' against the generic set 'ref' */
+int check_kernels(const bx_pixconv_t *conv, const bx_pixconv_t *ref)
+{
+  unsigned n, offset, i;
+  int errors = 0;
+
+  // all row lengths around the vector widths, then a few longer ones,
+  // each at all source alignments
+  for (n = 0; n <= ROW_PIXELS; n += (n < 72) ? 1 : 61) {
+    for (offset = 0; offset < 4; offset++) {
+      ref->index8_to_32(ref32, src + offset, lut, n);
+      conv->index8_to_32(out32, src + offset, lut, n);
+      if (memcmp(ref32, out32, n * 4)) {
+        printf("  index8_to_32: mismatch (n=%u, offset=%u)\n", n, offset);
+        errors++;
+      }
+      ref->rgb16_to_32(ref32, src + offset, n, &fmt15);
+      conv->rgb16_to_32(out32, src + offset, n, &fmt15);
+      if (memcmp(ref32, out32, n * 4)) {
+        printf("  rgb16_to_32 (15 bpp): mismatch (n=%u, offset=%u)\n", n, offset);
+        errors++;
+      }
+      ref->rgb16_to_32(ref32, src + offset, n, &fmt16);
+      conv->rgb16_to_32(out32, src + offset, n, &fmt16);
+      if (memcmp(ref32, out32, n * 4)) {
+        printf("  rgb16_to_32 (16 bpp): mismatch (n=%u, offset=%u)\n", n, offset);
+        errors++;
+      }
+      if ((n + offset) <= ROW_PIXELS) {
+        ref->planar_to_index(ref8, plane, offset, n, attr_map);
+        conv->planar_to_index(out8, plane, offset, n, attr_map);
+        if (memcmp(ref8, out8, n * 8)) {
+          printf("  planar_to_index: mismatch (nbytes=%u, offset=%u)\n", n, offset);
+          errors++;
+        }
+      }
+    }
+  }
+  // the 16 bpp expansion must also match the MAKE_COLOUR() result
+  for (i = 0; i < 65536; i++) {
+    Bit8u pixel[2] = {(Bit8u)i, (Bit8u)(i >> 8)};
+    Bit32u expect = ((i & 0xf800) << 8) | ((i & 0x07e0) << 5) | ((i & 0x001f) << 3);
+    conv->rgb16_to_32(out32, pixel, 1, &fmt16);
+    if (out32[0] != expect) {
+      printf("  rgb16_to_32 (16 bpp): 0x%04x -> 0x%08x, expected 0x%08x\n",
+             i, out32[0], expect);
+      errors++;
+      break;
+    }
+  }
+  return errors;
+}
+
+double mpix_per_sec(clock_t start, Bit64u pixels)
+{
+  double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  if (secs <= 0) secs = 1.0 / CLOCKS_PER_SEC;
+  return pixels / secs / 1000000.0;
+}
+
+void bench_kernels(const bx_pixconv_t *conv)
+{
+  Bit64u pixels = (Bit64u)bx_iterations * ROW_PIXELS;
+  clock_t start;
+  int i;
+
+  start = clock();
+  for (i = 0; i < bx_iterations; i++) {
+    conv->index8_to_32(out32, src + (i & 3), lut, ROW_PIXELS);
+  }
+  printf("  index8_to_32         %8.1f Mpixel/s\n", mpix_per_sec(start, pixels));
+  start = clock();
+  for (i = 0; i < bx_iterations; i++) {
+    conv->rgb16_to_32(out32, src + (i & 3), ROW_PIXELS, &fmt16);
+  }
+  printf("  rgb16_to_32          %8.1f Mpixel/s\n", mpix_per_sec(start, pixels));
+  start = clock();
+  for (i = 0; i < bx_iterations; i++) {
+    conv->planar_to_index(out8, plane, i & 3, ROW_PIXELS / 8, attr_map);
+  }
+  printf("  planar_to_index      %8.1f Mpixel/s\n", mpix_per_sec(start, pixels));
+}
+
+int main(int argc, char *argv[])
+{
+  bx_pixconv_t set[BX_PIXCONV_MAX_VARIANTS];
+  unsigned count, i;
+  int errors = 0, failed;
+
+  if (!parse_cmdline(argc, argv))
+    return 1;
+
+  init_data();
+  count = bx_pixconv_variants(set, BX_PIXCONV_MAX_VARIANTS);
+  for (i = 0; i < count; i++) {
+    printf("%s kernels\n", set[i].name);
+    failed = check_kernels(&set[i], &set[0]);
+    printf("  check: %s\n", failed ? "FAILED" : "ok (bit-exact)");
+    errors += failed;
+    if (!bx_check_only) bench_kernels(&set[i]);
+  }
+  printf("\nbx_pixconv_init() selects the %s kernels\n", set[count - 1].name);
+  return (errors > 0) ? 2 : 0;
+}
@@ -115,6 +115,10 @@
 #define BXPN_SCREENMODE                  "display.screenmode"
 #define BXPN_VGA_EXTENSION               "display.vga_extension"
 #define BXPN_VGA_UPDATE_FREQUENCY        "display.vga_update_frequency"
+#define BXPN_VGA_DISPLAY_THREAD          "display.vga_display_thread"
+#define BXPN_VGA_BLT_THREAD              "display.vga_blt_thread"
+#define BXPN_VOODOO_THREADS              "display.voodoo_threads"
+#define BXPN_VOODOO_PROFILE              "display.voodoo_profile"
 #define BXPN_KEYBOARD                    "keyboard_mouse.keyboard"
 #define BXPN_KBD_TYPE                    "keyboard_mouse.keyboard.type"
 #define BXPN_KBD_SERIAL_DELAY            "keyboard_mouse.keyboard.serial_delay"
@@ -160,6 +164,8 @@
 #define BXPN_ATA1_SLAVE                  "ata.1.slave"
 #define BXPN_ATA2_SLAVE                  "ata.2.slave"
 #define BXPN_ATA3_SLAVE                  "ata.3.slave"
+#define BXPN_VIRTIO_BLK                  "ata.virtio_blk"
+#define BXPN_AHCI                        "ata.ahci"
 #define BXPN_USB_UHCI                    "ports.usb.uhci"
 #define BXPN_UHCI_ENABLED                "ports.usb.uhci.enabled"
 #define BXPN_USB_OHCI                    "ports.usb.ohci"
@@ -172,6 +178,7 @@
 #define BXPN_PNIC_ENABLED                "network.pcipnic.enabled"
 #define BXPN_E1000                       "network.e1000"
 #define BXPN_E1000_ENABLED               "network.e1000.enabled"
+#define BXPN_VIRTIO_NET                  "network.virtio_net"
 #define BXPN_SOUNDLOW                    "sound.lowlevel"
 #define BXPN_SOUND_DRIVER                "sound.lowlevel.driver"
 #define BXPN_SOUND_WAVEOUT               "sound.lowlevel.waveout"
@@ -186,6 +193,7 @@
 #define BXPN_LOG_FILENAME                "log.filename"
 #define BXPN_LOG_PREFIX                  "log.prefix"
 #define BXPN_DEBUGGER_LOG_FILENAME       "log.debugger_filename"
+#define BXPN_DISK_TRACE_FILENAME         "log.disk_trace_filename"
 #define BXPN_MENU_DISK                   "menu.disk"
 #define BXPN_MENU_DISK_WIN32             "menu.disk_win32"
 #define BXPN_MENU_RUNTIME_CDROM          "menu.runtime.cdrom"
@@ -850,6 +850,15 @@ static builtin_plugin_t builtin_opt_plugins[] = {
 #if BX_SUPPORT_E1000
   BUILTIN_PLUGIN_ENTRY(e1000),
 #endif
+#if BX_SUPPORT_VIRTIO_NET
+  BUILTIN_PLUGIN_ENTRY(virtio_net),
+#endif
+#if BX_SUPPORT_VIRTIO_BLK
+  BUILTIN_PLUGIN_ENTRY(virtio_blk),
+#endif
+#if BX_SUPPORT_AHCI
+  BUILTIN_PLUGIN_ENTRY(ahci),
+#endif
 #if BX_SUPPORT_ES1370
   BUILTIN_PLUGIN_ENTRY(es1370),
 #endif
@@ -70,6 +70,9 @@ extern "C" {
 #define BX_PLUGIN_USB_XHCI  "usb_xhci"
 #define BX_PLUGIN_PCIPNIC   "pcipnic"
 #define BX_PLUGIN_E1000     "e1000"
+#define BX_PLUGIN_VIRTIO_NET "virtio_net"
+#define BX_PLUGIN_VIRTIO_BLK "virtio_blk"
+#define BX_PLUGIN_AHCI      "ahci"
 #define BX_PLUGIN_GAMEPORT  "gameport"
 #define BX_PLUGIN_SPEAKER   "speaker"
 #define BX_PLUGIN_ACPI      "acpi"
@@ -182,6 +185,8 @@ extern "C" {
 #define DEV_hd_bmdma_complete(a) bx_devices.pluginHardDrive->bmdma_complete(a)
 #define DEV_hdimage_init_image(a,b,c) bx_devices.pluginHDImageCtl->init_image(a,b,c)
 #define DEV_hdimage_init_cdrom(a) bx_devices.pluginHDImageCtl->init_cdrom(a)
+#define DEV_hdimage_trace_enabled() bx_devices.pluginHDImageCtl->trace_enabled()
+#define DEV_hdimage_trace_request(a,b,c,d,e,f) bx_devices.pluginHDImageCtl->trace_request(a,b,c,d,e,f)
 
 #define DEV_bulk_io_quantum_requested() (bx_devices.bulkIOQuantumsRequested)
 #define DEV_bulk_io_quantum_transferred() (bx_devices.bulkIOQuantumsTransferred)
@@ -228,6 +233,8 @@ extern "C" {
 #define DEV_pci_set_irq(a,b,c) bx_devices.pluginPci2IsaBridge->pci_set_irq(a,b,c)
 #define DEV_pci_set_base_mem(a,b,c,d,e,f) \
   (bx_devices.pci_set_base_mem(a,b,c,d,e,f))
+#define DEV_pci_set_base_mem_da(a,b,c,d,e,f,g) \
+  (bx_devices.pci_set_base_mem(a,b,c,d,e,f,g))
 #define DEV_pci_set_base_io(a,b,c,d,e,f,g,h) \
   (bx_devices.pci_set_base_io(a,b,c,d,e,f,g,h))
 #define DEV_ide_bmdma_present() bx_devices.pluginPciIdeController->bmdma_present()
@@ -241,6 +248,8 @@ extern "C" {
 ///////// Memory macros
 #define DEV_register_memory_handlers(param,rh,wh,b,e) \
     bx_devices.mem->registerMemoryHandlers(param,rh,wh,b,e)
+#define DEV_register_memory_handlers_da(param,rh,wh,dh,b,e) \
+    bx_devices.mem->registerMemoryHandlers(param,rh,wh,dh,b,e)
 #define DEV_unregister_memory_handlers(param,b,e) \
     bx_devices.mem->unregisterMemoryHandlers(param,b,e)
 #define DEV_mem_set_memory_type(a,b,c) \
@@ -406,6 +415,9 @@ DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(netmod)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(ne2k)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(pcipnic)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(e1000)
+DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(virtio_net)
+DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(virtio_blk)
+DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(ahci)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(extfpuirq)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(gameport)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(speaker)
@@ -414,6 +426,7 @@ DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(iodebug)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(ioapic)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(voodoo)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(amigaos)
+DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(capture)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(carbon)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(macintosh)
 DECLARE_PLUGIN_INIT_FINI_FOR_MODULE(nogui)